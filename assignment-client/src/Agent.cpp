@@ -423,6 +423,7 @@ void Agent::executeScript() {
 
         using namespace recording;
         static const FrameType AVATAR_FRAME_TYPE = Frame::registerFrameType(AvatarData::FRAME_NAME);
+        Frame::registerKeyframeTest(AVATAR_FRAME_TYPE, &AvatarData::isKeyframe);
         Frame::registerFrameHandler(AVATAR_FRAME_TYPE, [scriptedAvatar](Frame::ConstPointer frame) {
 
             auto recordingInterface = DependencyManager::get<RecordingScriptingInterface>();
@@ -487,10 +488,15 @@ void Agent::executeScript() {
             audioTransform.setRotation(headOrientation);
 
             QByteArray encodedBuffer;
-            if (_encoder) {
-                _encoder->encode(audio, encodedBuffer);
-            } else {
-                encodedBuffer = audio;
+            if (packetType != PacketType::SilentAudioFrame) {
+                if (_encoder) {
+                    _encoder->encode(audio, encodedBuffer);
+                    if (_encoder->isLastFrameSilent()) {
+                        packetType = PacketType::SilentAudioFrame;
+                    }
+                } else {
+                    encodedBuffer = audio;
+                }
             }
 
             AbstractAudioInterface::emitAudioPacket(encodedBuffer.data(), encodedBuffer.size(), audioSequenceNumber, false,
@@ -26,6 +26,8 @@
 #include <OctreeConstants.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
+#include <ResourceCache.h>
+#include <ResourceManager.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <StDev.h>
@@ -39,6 +41,8 @@
 #include "AudioMixerClientData.h"
 #include "AvatarAudioStream.h"
 #include "InjectedAudioStream.h"
+#include "ResidentInjectedAudioStream.h"
+#include "SoundCache.h"
 #include "crash-handler/CrashHandler.h"
 #include "../AssignmentDynamicFactory.h"
 #include "../entities/AssignmentParentFinder.h"
@@ -60,6 +64,7 @@ float AudioMixer::_attenuationPerDoublingInDistance{ DEFAULT_ATTENUATION_PER_DOU
 map<QString, shared_ptr<CodecPlugin>> AudioMixer::_availableCodecs{ };
 QStringList AudioMixer::_codecPreferenceOrder{};
 unordered_map<QString, AudioMixer::ZoneSettings> AudioMixer::_audioZones;
+ResidentSoundCache AudioMixer::_residentSounds;
 
 AudioMixer::AudioMixer(ReceivedMessage& message) :
     ThreadedAssignment(message)
@@ -68,6 +73,11 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     DependencyManager::registerInheritance<EntityDynamicFactoryInterface, AssignmentDynamicFactory>();
     DependencyManager::set<AssignmentDynamicFactory>();
 
+    // resident injectors play sounds the mixer downloads itself
+    DependencyManager::set<ResourceCacheSharedItems>();
+    DependencyManager::set<ResourceManager>();
+    DependencyManager::set<SoundCache>();
+
     // Always clear settings first
     // This prevents previous assignment settings from sticking around
     clearDomainSettings();
@@ -105,7 +115,8 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
             PacketType::PerAvatarGainSet,
             PacketType::InjectorGainSet,
             PacketType::AudioSoloRequest,
-            PacketType::StopInjector },
+            PacketType::StopInjector,
+            PacketType::ResidentInjector },
             PacketReceiver::makeSourcedListenerReference<AudioMixer>(this, &AudioMixer::queueAudioPacket)
     );
 
@@ -132,6 +143,11 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
 
 void AudioMixer::aboutToFinish() {
     DependencyManager::destroy<PluginManager>();
+
+    _residentSounds.clear();
+    DependencyManager::destroy<SoundCache>();
+    DependencyManager::destroy<ResourceManager>();
+    DependencyManager::destroy<ResourceCacheSharedItems>();
 }
 
 void AudioMixer::queueAudioPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
@@ -298,6 +314,9 @@ void AudioMixer::sendStatsPacket() {
     statsObject["avg_streams_per_frame"] = (float)_stats.sumStreams / (float)_numStatFrames;
     statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
     statsObject["avg_listeners_(silent)_per_frame"] = (float)_stats.sumListenersSilent / (float)_numStatFrames;
+    statsObject["avg_mix_bytes_per_frame"] = (float)_stats.sumMixBytes / (float)_numStatFrames;
+    statsObject["resident_sounds"] = _residentSounds.getNumSounds();
+    statsObject["ambient_beds"] = _workerSharedData.ambientBeds.getNumBeds();
 
     statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
 
@@ -336,6 +355,7 @@ void AudioMixer::sendStatsPacket() {
     mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    mixStats["1_ambient_bed_renders"] = (int)(_stats.ambientBedRenders / (float)_numStatFrames);
 
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
@@ -468,8 +488,13 @@ void AudioMixer::start() {
 
             // since we're a while loop we need to yield to qt's event processing
             QCoreApplication::processEvents();
+
+            // load the sounds resident injectors asked for while processing packets
+            _residentSounds.update();
         }
 
+        prepareAmbientBeds();
+
         int numToRetain = -1;
         assert(_throttlingRatio >= 0.0f && _throttlingRatio <= 1.0f);
         if (_throttlingRatio > EPSILON) {
@@ -562,6 +587,51 @@ void AudioMixer::throttle(chrono::microseconds duration, int frame) {
     }
 }
 
+const pair<const QString, AudioMixer::ZoneSettings>* AudioMixer::findAudioZone(const glm::vec3& position) {
+    static const AABox UNIT_BOX(glm::vec3(-0.5f), glm::vec3(1.0f));
+
+    const pair<const QString, ZoneSettings>* bestZone = nullptr;
+    glm::vec4 zonePosition = glm::vec4(position, 1.0f);
+    for (const auto& zone : _audioZones) {
+        glm::vec4 localPosition = zone.second.inverseTransform * zonePosition;
+        if (UNIT_BOX.contains(localPosition) && (!bestZone || zone.second.volume < bestZone->second.volume)) {
+            bestZone = &zone;
+        }
+    }
+    return bestZone;
+}
+
+void AudioMixer::prepareAmbientBeds() {
+    auto& ambientBeds = _workerSharedData.ambientBeds;
+    ambientBeds.reset();
+
+    // an ambient resident injector in an audio zone is mixed into the zone's bed, rather than for each listener
+    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+        auto clientData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!clientData) {
+            return;
+        }
+
+        for (auto& stream : clientData->getAudioStreams()) {
+            bool isInAmbientBed = false;
+            if (stream->getType() == PositionalAudioStream::Injector) {
+                auto residentStream = dynamic_cast<ResidentInjectedAudioStream*>(stream.get());
+                if (residentStream && residentStream->isAmbient()) {
+                    auto zone = findAudioZone(residentStream->getPosition());
+                    if (zone) {
+                        glm::vec3 center = glm::vec3(glm::inverse(zone->second.inverseTransform)[3]);
+                        ambientBeds.addSource(zone->first, center, *residentStream);
+                        isInAmbientBed = true;
+                    }
+                }
+            }
+            stream->setInAmbientBed(isInAmbientBed);
+        }
+    });
+
+    ambientBeds.finish();
+}
+
 void AudioMixer::clearDomainSettings() {
     _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
     _attenuationPerDoublingInDistance = DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE;
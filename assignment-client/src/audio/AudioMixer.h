@@ -24,6 +24,7 @@
 
 #include "AudioMixerStats.h"
 #include "AudioMixerWorkerPool.h"
+#include "ResidentSoundCache.h"
 
 #include "../entities/EntityTreeHeadlessViewer.h"
 
@@ -54,6 +55,9 @@ public:
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
     static float getAttenuationPerDoublingInDistance() { return _attenuationPerDoublingInDistance; }
     static const std::unordered_map<QString, ZoneSettings>& getAudioZones() { return _audioZones; }
+    // the smallest audio zone that contains the position, or null
+    static const std::pair<const QString, ZoneSettings>* findAudioZone(const glm::vec3& position);
+    static ResidentSoundCache& getResidentSounds() { return _residentSounds; }
     static const std::pair<QString, CodecPluginPointer> negotiateCodec(std::vector<QString> codecs);
 
     static bool shouldReplicateTo(const Node& from, const Node& to) {
@@ -89,6 +93,7 @@ private:
     // mixing helpers
     std::chrono::microseconds timeFrame();
     void throttle(std::chrono::microseconds frameDuration, int frame);
+    void prepareAmbientBeds();
 
     AudioMixerClientData* getOrCreateClientData(Node* node);
 
@@ -148,6 +153,7 @@ private:
     static QStringList _codecPreferenceOrder;
 
     static std::unordered_map<QString, ZoneSettings> _audioZones;
+    static ResidentSoundCache _residentSounds;
 
     float _throttleStartTarget = 0.9f;
     float _throttleBackoffTarget = 0.44f;
@@ -0,0 +1,118 @@
+//
+//  AudioMixerAmbientBeds.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AudioMixerAmbientBeds.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <NumericalConstants.h>
+#include <ResidentInjectedAudioStream.h>
+
+void AudioMixerAmbientBeds::reset() {
+    for (auto& bed : _beds) {
+        bed.second.numSources = 0;
+    }
+}
+
+void AudioMixerAmbientBeds::addSource(const QString& zone, const glm::vec3& center,
+                                      const ResidentInjectedAudioStream& stream) {
+    // nothing to add while the sound loads, or once it has played out
+    if (!stream.lastPopSucceeded()) {
+        return;
+    }
+
+    Bed& bed = _beds[zone];
+    if (bed.numSources == 0) {
+        bed.center = center;
+        memset(bed.mix, 0, sizeof(bed.mix));
+    }
+    ++bed.numSources;
+
+    const float gain = stream.getAttenuationRatio();
+    float* mix = bed.mix;
+
+    const int16_t* ambisonic = stream.getLastAmbisonicFrame();
+    if (ambisonic) {
+        // rotate the sound field by the injector's orientation, converted from Y-up (OpenGL) to Z-up (Ambisonic)
+        glm::quat q = stream.getOrientation();
+        glm::mat3 rotation = glm::mat3_cast(glm::quat(q.w, -q.z, -q.x, q.y));
+
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+            // ACN channel order: W, Y, Z, X
+            const int16_t* input = &ambisonic[AudioConstants::AMBISONIC * i];
+            glm::vec3 xyz = rotation * glm::vec3(input[3], input[1], input[2]);
+
+            mix[0] += gain * input[0];
+            mix[1] += gain * xyz.y;
+            mix[2] += gain * xyz.z;
+            mix[3] += gain * xyz.x;
+            mix += AudioConstants::AMBISONIC;
+        }
+        return;
+    }
+
+    // encode the sound at its direction from the center of the zone; at the center it has no direction
+    glm::vec3 direction = stream.getPosition() - bed.center;
+    float distance = glm::length(direction);
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    if (distance > EPSILON) {
+        direction /= distance;
+
+        // convert from Y-up (OpenGL) to Z-up (Ambisonic)
+        x = -direction.z;
+        y = -direction.x;
+        z = direction.y;
+    }
+
+    int16_t frame[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    AudioRingBuffer::ConstIterator popOutput = stream.getLastPopOutput();
+    popOutput.readSamples(frame, stream.getNumFrameSamples());
+
+    bool isStereo = stream.isStereo();
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+        float sample = isStereo ? 0.5f * (frame[2 * i] + frame[2 * i + 1]) : (float)frame[i];
+        sample *= gain;
+
+        mix[0] += sample;
+        mix[1] += sample * y;
+        mix[2] += sample * z;
+        mix[3] += sample * x;
+        mix += AudioConstants::AMBISONIC;
+    }
+}
+
+void AudioMixerAmbientBeds::finish() {
+    auto it = _beds.begin();
+    while (it != _beds.end()) {
+        Bed& bed = it->second;
+
+        // a zone nothing played in this frame is let go
+        if (bed.numSources == 0) {
+            it = _beds.erase(it);
+            continue;
+        }
+
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC; i++) {
+            float sample = std::max(std::min(bed.mix[i], (float)AudioConstants::MAX_SAMPLE_VALUE),
+                                    (float)AudioConstants::MIN_SAMPLE_VALUE);
+            bed.samples[i] = (int16_t)sample;
+        }
+        ++it;
+    }
+}
+
+const AudioMixerAmbientBeds::Bed* AudioMixerAmbientBeds::getBed(const QString& zone) const {
+    auto it = _beds.find(zone);
+    return it != _beds.end() ? &it->second : nullptr;
+}
@@ -0,0 +1,50 @@
+//
+//  AudioMixerAmbientBeds.h
+//  assignment-client/src/audio
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_AudioMixerAmbientBeds_h
+#define hifi_AudioMixerAmbientBeds_h
+
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include <QtCore/QString>
+
+#include <AudioConstants.h>
+
+class ResidentInjectedAudioStream;
+
+// The ambient sounds of each audio zone, mixed together once a frame into a first-order ambisonic bed, as heard from
+// the zone's center. A listener in the zone hears the bed with a single ambisonic render, however many sounds are in it.
+class AudioMixerAmbientBeds {
+public:
+    struct Bed {
+        glm::vec3 center;
+        int numSources { 0 };
+        float mix[AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
+        int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
+    };
+
+    // called from the mixer thread, after packets are processed and before mixing
+    void reset();
+    void addSource(const QString& zone, const glm::vec3& center, const ResidentInjectedAudioStream& stream);
+    void finish();
+
+    // thread-safe while mixing; null if nothing is playing in the zone
+    const Bed* getBed(const QString& zone) const;
+
+    int getNumBeds() const { return (int)_beds.size(); }
+
+private:
+    std::unordered_map<QString, Bed> _beds;
+};
+
+#endif // hifi_AudioMixerAmbientBeds_h
@@ -22,6 +22,7 @@
 #include <UUID.h>
 
 #include "InjectedAudioStream.h"
+#include "ResidentInjectedAudioStream.h"
 
 #include "AudioLogging.h"
 #include "AudioHelpers.h"
@@ -107,6 +108,9 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
             case PacketType::StopInjector:
                 parseStopInjectorPacket(packet);
                 break;
+            case PacketType::ResidentInjector:
+                parseResidentInjectorPacket(*packet, node, addedStreams);
+                break;
             default:
                 Q_UNREACHABLE();
         }
@@ -392,6 +396,11 @@ int AudioMixerClientData::parseData(ReceivedMessage& message) {
         // read the downstream audio stream stats
         message.readPrimitive(&_downstreamAudioStreamStats);
 
+        // fit the bitrate of the mix to what reaches this listener
+        if (_mixBitrateAdapter.update(_downstreamAudioStreamStats._packetStreamStats) && _encoder) {
+            _encoder->setBitrate(_mixBitrateAdapter.getBitrate());
+        }
+
         return message.getPosition();
     }
 
@@ -558,20 +567,47 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
 }
 
 int AudioMixerClientData::checkBuffersBeforeFrameSend() {
+    quint64 now = usecTimestampNow();
+
     auto it = _audioStreams.begin();
     while (it != _audioStreams.end()) {
         SharedStreamPointer stream = *it;
 
+        ResidentInjectedAudioStream* residentStream = nullptr;
+        if (stream->getType() == PositionalAudioStream::Injector) {
+            residentStream = dynamic_cast<ResidentInjectedAudioStream*>(stream.get());
+        }
+
+        bool isFinished = false;
+        if (residentStream) {
+            // a resident stream is rendered here, from the mixer's own copy of its sound
+            if (!residentStream->hasAudioData()) {
+                bool hasFailed = false;
+                residentStream->setAudioData(AudioMixer::getResidentSounds().getAudioData(residentStream->getSoundURL(),
+                                                                                          hasFailed));
+                isFinished = hasFailed;
+            }
+            residentStream->renderFrame();
+        }
+
         if (stream->popFrames(1, true) > 0) {
             stream->updateLastPopOutputLoudnessAndTrailingLoudness();
         }
 
         static const int INJECTOR_MAX_INACTIVE_BLOCKS = 500;
 
-        // if we don't have new data for an injected stream in the last INJECTOR_MAX_INACTIVE_BLOCKS then
-        // we remove the injector from our streams
-        if (stream->getType() == PositionalAudioStream::Injector
-            && stream->getConsecutiveNotMixedCount() > INJECTOR_MAX_INACTIVE_BLOCKS) {
+        if (residentStream) {
+            // a resident stream is finished once its sound has played out, or its injector has gone away;
+            // it is not starved while its sound loads
+            isFinished = isFinished || residentStream->isPlayedOut() || residentStream->isTimedOut(now);
+        } else {
+            // if we don't have new data for an injected stream in the last INJECTOR_MAX_INACTIVE_BLOCKS then
+            // we remove the injector from our streams
+            isFinished = stream->getType() == PositionalAudioStream::Injector
+                && stream->getConsecutiveNotMixedCount() > INJECTOR_MAX_INACTIVE_BLOCKS;
+        }
+
+        if (isFinished) {
             // this is an inactive injector, pull it from our streams
 
             // first emit that it is finished so that the HRTF objects for this source can be cleaned up
@@ -600,6 +636,65 @@ void AudioMixerClientData::parseStopInjectorPacket(QSharedPointer<ReceivedMessag
     }
 }
 
+// each resident stream has the mixer fetch and decode a sound, so a client may only hold so many at once
+static const int MAX_RESIDENT_STREAMS_PER_NODE = 32;
+
+void AudioMixerClientData::parseResidentInjectorPacket(ReceivedMessage& message, const SharedNodePointer& node,
+                                                       ConcurrentAddedStreams& addedStreams) {
+    // having the mixer fetch a sound is as much as rezzing one, so it takes the same permission
+    if (!node || !(node->getCanRez() || node->getCanRezTmp())) {
+        return;
+    }
+
+    if (message.getBytesLeftToRead() < NUM_BYTES_RFC4122_UUID) {
+        return;
+    }
+    auto streamID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+
+    auto it = std::find_if(std::begin(_audioStreams), std::end(_audioStreams), [&](const SharedStreamPointer& stream) {
+        return streamID == stream->getStreamIdentifier();
+    });
+
+    if (it != std::end(_audioStreams)) {
+        auto residentStream = dynamic_cast<ResidentInjectedAudioStream*>(it->get());
+        if (!residentStream || !residentStream->parseResidentData(message)) {
+            qCDebug(audio) << "Refusing to process resident injector" << streamID << "from" << message.getSourceID();
+        }
+        return;
+    }
+
+    auto numResidentStreams = std::count_if(std::begin(_audioStreams), std::end(_audioStreams),
+                                            [](const SharedStreamPointer& stream) {
+        return dynamic_cast<ResidentInjectedAudioStream*>(stream.get()) != nullptr;
+    });
+    // the domain's own servers, which play its sound entities, are not capped
+    if (numResidentStreams >= MAX_RESIDENT_STREAMS_PER_NODE && !node->getPermissions().isAssignment) {
+        qCDebug(audio) << "Refusing resident injector" << streamID << "from" << message.getSourceID()
+                       << "- already playing" << numResidentStreams;
+        return;
+    }
+
+    auto residentStream = new ResidentInjectedAudioStream(streamID);
+    SharedStreamPointer stream(residentStream);
+    if (!residentStream->parseResidentData(message)) {
+        qCDebug(audio) << "Refusing to process resident injector" << streamID << "from" << message.getSourceID();
+        return;
+    }
+
+    qCDebug(audio) << "creating new resident injector stream..." << residentStream->getSoundURL();
+
+    _audioStreams.push_back(stream);
+    addedStreams.push_back(AddedStream(getNodeID(), getNodeLocalID(), streamID, residentStream));
+}
+
+AudioFOA& AudioMixerClientData::getAmbientBedFOA(const QString& zone) {
+    if (!_ambientBedFOA || zone != _ambientBedZone) {
+        _ambientBedFOA.reset(new AudioFOA);
+        _ambientBedZone = zone;
+    }
+    return *_ambientBedFOA;
+}
+
 bool AudioMixerClientData::shouldSendStats(int frameNumber) {
     return frameNumber == _frameToSendStats;
 }
@@ -672,6 +767,7 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
     downstreamStats["overflows"] = (double) streamStats._overflowCount;
     downstreamStats["lost%"] = streamStats._packetStreamStats.getLostRate() * 100.0f;
     downstreamStats["lost%_30s"] = streamStats._packetStreamWindowStats.getLostRate() * 100.0f;
+    downstreamStats["bitrate"] = _mixBitrateAdapter.getBitrate();
     downstreamStats["min_gap"] = formatUsecTime(streamStats._timeGapMin);
     downstreamStats["max_gap"] = formatUsecTime(streamStats._timeGapMax);
     downstreamStats["avg_gap"] = formatUsecTime(streamStats._timeGapAverage);
@@ -790,8 +886,15 @@ void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& c
     cleanupCodec(); // cleanup any previously allocated coders first
     _codec = codec;
     _selectedCodecName = codecName;
+    _mixBitrateAdapter.reset();
     if (codec) {
         _encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+        if (_encoder) {
+            _encoder->setBitrate(_mixBitrateAdapter.getBitrate());
+            // a quiet mix of rain or wind is what DTX takes for a pause, and the listener would hear silence in its place;
+            // mixes that really are silent are sent as silent packets before they reach the encoder
+            _encoder->setDTX(0);
+        }
         _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
     }
 
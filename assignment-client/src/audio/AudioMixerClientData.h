@@ -23,6 +23,8 @@
 #include <QtCore/QSharedPointer>
 
 #include <AABox.h>
+#include <AudioBitrateAdapter.h>
+#include <AudioFOA.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
 #include <UUIDHasher.h>
@@ -72,6 +74,8 @@ public:
     void parseRadiusIgnoreRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
     void parseSoloRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
     void parseStopInjectorPacket(QSharedPointer<ReceivedMessage> packet);
+    void parseResidentInjectorPacket(ReceivedMessage& message, const SharedNodePointer& node,
+                                     ConcurrentAddedStreams& addedStreams);
 
     // attempt to pop a frame from each audio stream, and return the number of streams from this client
     int checkBuffersBeforeFrameSend();
@@ -163,6 +167,9 @@ public:
     bool getHasReceivedFirstMix() const { return _hasReceivedFirstMix; }
     void setHasReceivedFirstMix(bool hasReceivedFirstMix) { _hasReceivedFirstMix = hasReceivedFirstMix; }
 
+    // the renderer of the ambient bed of the zone this listener is in, reset when the listener changes zones
+    AudioFOA& getAmbientBedFOA(const QString& zone);
+
     // end of methods called non-concurrently from single AudioMixerWorker
 
 signals:
@@ -191,6 +198,7 @@ private:
     quint16 _outgoingMixedAudioSequenceNumber;
 
     AudioStreamStats _downstreamAudioStreamStats;
+    AudioBitrateAdapter _mixBitrateAdapter;
 
     int _frameToSendStats { 0 };
 
@@ -223,6 +231,9 @@ private:
     std::vector<QUuid> _soloedNodes;
 
     bool _hasReceivedFirstMix { false };
+
+    std::unique_ptr<AudioFOA> _ambientBedFOA;
+    QString _ambientBedZone;
 };
 
 #endif // hifi_AudioMixerClientData_h
@@ -15,6 +15,7 @@ void AudioMixerStats::reset() {
     sumStreams = 0;
     sumListeners = 0;
     sumListenersSilent = 0;
+    sumMixBytes = 0;
 
     totalMixes = 0;
 
@@ -22,6 +23,8 @@ void AudioMixerStats::reset() {
     hrtfResets = 0;
     hrtfUpdates = 0;
 
+    ambientBedRenders = 0;
+
     manualStereoMixes = 0;
     manualEchoMixes = 0;
 
@@ -45,6 +48,7 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     sumStreams += otherStats.sumStreams;
     sumListeners += otherStats.sumListeners;
     sumListenersSilent += otherStats.sumListenersSilent;
+    sumMixBytes += otherStats.sumMixBytes;
 
     totalMixes += otherStats.totalMixes;
 
@@ -52,6 +56,8 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     hrtfResets += otherStats.hrtfResets;
     hrtfUpdates += otherStats.hrtfUpdates;
 
+    ambientBedRenders += otherStats.ambientBedRenders;
+
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
 
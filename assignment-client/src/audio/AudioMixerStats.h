@@ -12,14 +12,13 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
 #include <cstdint>
-#endif
 
 struct AudioMixerStats {
     int sumStreams { 0 };
     int sumListeners { 0 };
     int sumListenersSilent { 0 };
+    int64_t sumMixBytes { 0 };
 
     int totalMixes { 0 };
 
@@ -27,6 +26,8 @@ struct AudioMixerStats {
     int hrtfResets { 0 };
     int hrtfUpdates { 0 };
 
+    int ambientBedRenders { 0 };
+
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
@@ -111,6 +111,7 @@ void AudioMixerWorker::mix(const SharedNodePointer& node) {
                 data->encodeFrameOfZeros(encodedBuffer);
             }
 
+            stats.sumMixBytes += encodedBuffer.size();
             sendMixPacket(node, *data, encodedBuffer);
         } else {
             ++stats.sumListenersSilent;
@@ -236,7 +237,8 @@ bool shouldBeRemoved(const MixableStream& stream, const AudioMixerWorker::Shared
 
 bool shouldBeInactive(MixableStream& stream) {
     return (!stream.positionalStream->lastPopSucceeded() ||
-            stream.positionalStream->getLastPopOutputLoudness() == 0.0f);
+            stream.positionalStream->getLastPopOutputLoudness() == 0.0f ||
+            stream.positionalStream->isInAmbientBed());
 };
 
 bool shouldBeSkipped(MixableStream& stream, const Node& listener,
@@ -464,6 +466,10 @@ bool AudioMixerWorker::prepareMix(const SharedNodePointer& listener) {
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
 
+    if (!isSoloing) {
+        addAmbientBed(*listenerAudioStream, *listenerData);
+    }
+
     // clear the newly ignored, un-ignored, ignoring, and un-ignoring streams now that we've processed them
     listenerData->clearStagedIgnoreChanges();
 
@@ -575,6 +581,30 @@ void AudioMixerWorker::addStream(AudioMixerClientData::MixableStream& mixableStr
     }
 }
 
+void AudioMixerWorker::addAmbientBed(AvatarAudioStream& listeningNodeStream, AudioMixerClientData& listenerData) {
+    auto zone = AudioMixer::findAudioZone(listeningNodeStream.getPosition());
+    if (!zone) {
+        return;
+    }
+
+    auto bed = _sharedData.ambientBeds.getBed(zone->first);
+    if (!bed) {
+        return;
+    }
+
+    // the bed is heard from the center of the zone, turned to the listener's orientation,
+    // converted from Y-up (OpenGL) to Z-up (Ambisonic)
+    glm::quat orientation = glm::inverse(listeningNodeStream.getOrientation());
+    const int HRTF_DATASET_INDEX = 1;
+
+    // render only reads its input, which every listener in the zone shares
+    int16_t* samples = const_cast<int16_t*>(bed->samples);
+    listenerData.getAmbientBedFOA(zone->first).render(samples, _mixSamples, HRTF_DATASET_INDEX,
+                                                      orientation.w, -orientation.z, -orientation.x, orientation.y,
+                                                      listenerData.getPrimaryInjectorGain(), FOA_BLOCK);
+    ++stats.ambientBedRenders;
+}
+
 void AudioMixerWorker::updateHRTFParameters(AudioMixerClientData::MixableStream& mixableStream,
                                            AvatarAudioStream& listeningNodeStream,
                                            float primaryAvatarGain,
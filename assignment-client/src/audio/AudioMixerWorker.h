@@ -25,6 +25,7 @@
 #include <NodeList.h>
 #include <PositionalAudioStream.h>
 
+#include "AudioMixerAmbientBeds.h"
 #include "AudioMixerClientData.h"
 #include "AudioMixerStats.h"
 
@@ -39,6 +40,7 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioMixerAmbientBeds ambientBeds;
     };
 
     AudioMixerWorker(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -68,6 +70,7 @@ private:
                               float primaryAvatarGain,
                               float primaryInjectorGain);
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
+    void addAmbientBed(AvatarAudioStream& listeningNodeStream, AudioMixerClientData& listenerData);
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
 
@@ -0,0 +1,119 @@
+//
+//  ResidentSoundCache.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ResidentSoundCache.h"
+
+#include <algorithm>
+
+#include <SharedUtil.h>
+#include <SoundCache.h>
+
+#include "AudioLogging.h"
+
+static const quint64 UNUSED_SOUND_TIMEOUT_USECS = 60 * USECS_PER_SECOND;
+
+// about three minutes of 48kHz stereo
+static const quint64 MAX_SOUND_BYTES = 32ULL << MB_TO_BYTES_SHIFT;
+static const quint64 MAX_CACHE_BYTES = 256ULL << MB_TO_BYTES_SHIFT;
+static const int MAX_SOUNDS = 256;
+
+AudioDataPointer ResidentSoundCache::getAudioData(const QUrl& url, bool& hasFailed) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _sounds.find(url);
+    if (it == _sounds.end()) {
+        if (std::find(_requestedURLs.begin(), _requestedURLs.end(), url) == _requestedURLs.end()) {
+            _requestedURLs.push_back(url);
+        }
+        hasFailed = false;
+        return AudioDataPointer();
+    }
+
+    hasFailed = it->hasFailed;
+    return it->audioData;
+}
+
+void ResidentSoundCache::update() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto soundCache = DependencyManager::get<SoundCache>();
+    for (const auto& url : _requestedURLs) {
+        if (!_sounds.contains(url)) {
+            Entry& entry = _sounds[url];
+            if (_sounds.size() > MAX_SOUNDS) {
+                qCWarning(audio) << "Too many resident sounds, refusing" << url;
+                entry.hasFailed = true;
+                continue;
+            }
+            entry.sound = soundCache->getSound(url);
+            qCDebug(audio) << "Loading resident sound" << url;
+        }
+    }
+    _requestedURLs.clear();
+
+    quint64 now = usecTimestampNow();
+    auto it = _sounds.begin();
+    while (it != _sounds.end()) {
+        Entry& entry = *it;
+
+        if (entry.sound) {
+            if (entry.sound->isReady()) {
+                // keep the decoded audio, and let the resource go back to the SoundCache
+                auto audioData = entry.sound->getAudioData();
+                quint64 numBytes = audioData ? audioData->getNumBytes() : 0;
+                if (numBytes > MAX_SOUND_BYTES || _numBytes + numBytes > MAX_CACHE_BYTES) {
+                    qCWarning(audio) << "Resident sound" << it.key() << "is too large to keep:" << numBytes << "bytes";
+                    entry.hasFailed = true;
+                } else {
+                    entry.audioData = audioData;
+                    _numBytes += numBytes;
+                }
+                entry.sound.reset();
+            } else if (entry.sound->isFailed()) {
+                qCWarning(audio) << "Failed to load resident sound" << it.key();
+                entry.hasFailed = true;
+                entry.sound.reset();
+            }
+        }
+
+        // a sound is in use while an injector holds its audio; failed sounds are retried once they time out
+        bool isUnused = !entry.sound && (entry.hasFailed || entry.audioData.use_count() == 1);
+        if (!isUnused) {
+            entry.unusedSinceUsecs = 0;
+        } else if (entry.unusedSinceUsecs == 0) {
+            entry.unusedSinceUsecs = now;
+        } else if (now - entry.unusedSinceUsecs > UNUSED_SOUND_TIMEOUT_USECS) {
+            if (entry.audioData) {
+                _numBytes -= entry.audioData->getNumBytes();
+            }
+            it = _sounds.erase(it);
+            continue;
+        }
+        ++it;
+    }
+}
+
+void ResidentSoundCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _sounds.clear();
+    _requestedURLs.clear();
+    _numBytes = 0;
+}
+
+int ResidentSoundCache::getNumSounds() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _sounds.size();
+}
+
+quint64 ResidentSoundCache::getNumBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _numBytes;
+}
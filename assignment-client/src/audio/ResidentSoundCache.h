@@ -0,0 +1,53 @@
+//
+//  ResidentSoundCache.h
+//  assignment-client/src/audio
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_ResidentSoundCache_h
+#define hifi_ResidentSoundCache_h
+
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QUrl>
+
+#include <Sound.h>
+
+// The decoded sounds that resident injectors play. Each sound is downloaded and decoded once, by the SoundCache,
+// however many injectors play it; a sound no injector has played for a while is let go. Sounds that decode too large,
+// or that would push the cache over its budget, fail rather than being kept.
+class ResidentSoundCache {
+public:
+    // thread-safe, called from AudioMixerWorker(s) while processing packets
+    // returns null until the sound is decoded, asking for it to be loaded; hasFailed is set if it cannot be
+    AudioDataPointer getAudioData(const QUrl& url, bool& hasFailed);
+
+    // called from the mixer thread, once a frame: starts loading the sounds asked for, and collects decoded ones
+    void update();
+    void clear();
+
+    int getNumSounds() const;
+    quint64 getNumBytes() const;
+
+private:
+    struct Entry {
+        SharedSoundPointer sound; // held only while loading
+        AudioDataPointer audioData;
+        bool hasFailed { false };
+        quint64 unusedSinceUsecs { 0 };
+    };
+
+    mutable std::mutex _mutex;
+    QHash<QUrl, Entry> _sounds;
+    std::vector<QUrl> _requestedURLs;
+    quint64 _numBytes { 0 };
+};
+
+#endif // hifi_ResidentSoundCache_h
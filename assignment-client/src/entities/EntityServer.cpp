@@ -328,6 +328,16 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
     tree->setWantEditLogging(wantEditLogging);
     tree->setWantTerseEditLogging(wantTerseEditLogging);
 
+    bool columnarKinematics = false;
+    readOptionBool(QString("columnarKinematics"), settingsSectionObject, columnarKinematics);
+    if (_entitySimulation) {
+        _entitySimulation->setUseColumnarKinematics(columnarKinematics);
+    }
+
+    bool spatialIndex = true;
+    readOptionBool(QString("spatialIndex"), settingsSectionObject, spatialIndex);
+    tree->setUseSpatialIndex(spatialIndex);
+
     QString entityScriptSourceAllowlist;
     if (readOptionString("entityScriptSourceAllowlist", settingsSectionObject, entityScriptSourceAllowlist)) {
         tree->setEntityScriptSourceAllowlist(entityScriptSourceAllowlist);
@@ -395,6 +405,16 @@ void EntityServer::trackViewerGone(const QUuid& sessionID) {
     }
 }
 
+QJsonObject EntityServer::serverSubclassJsonStats() {
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    QJsonObject stats;
+    if (tree) {
+        stats["1. entityMapLocks"] = tree->getEntityMapLockStats();
+        stats["2. octreeLocks"] = tree->getLockStatsJson();
+    }
+    return stats;
+}
+
 QString EntityServer::serverSubclassStats() {
     QLocale locale(QLocale::English);
     QString statsString;
@@ -405,6 +425,19 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString("       EntityItem size... %1 bytes\r\n").arg(sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    auto appendLockStats = [&](const QString& title, const QJsonObject& lockStats) {
+        statsString += QString("<b>%1</b>\r\n").arg(title);
+        for (auto it = lockStats.constBegin(); it != lockStats.constEnd(); ++it) {
+            QString value = it.value().isArray() ? QString(QJsonDocument(it.value().toArray()).toJson(QJsonDocument::Compact))
+                                                 : locale.toString(it.value().toDouble());
+            statsString += QString("%1... %2\r\n").arg(it.key().mid(3)).arg(value);
+        }
+        statsString += "\r\n\r\n";
+    };
+    appendLockStats("Entity Server Entity Map Lock Statistics", tree ? tree->getEntityMapLockStats() : QJsonObject());
+    appendLockStats("Entity Server Octree Lock Statistics", tree ? tree->getLockStatsJson() : QJsonObject());
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
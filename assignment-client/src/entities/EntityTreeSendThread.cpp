@@ -66,7 +66,7 @@ void EntityTreeSendThread::preDistributionProcessing() {
                     if (includeAncestors) {
                         // we need to include ancestors - recurse up to reach them all and add their IDs
                         // to the set of extra entities to include for this node
-                        entityTree->withReadLock([&]{
+                        entityTree->withMeasuredReadLock([&]{
                             auto filteredEntity = entityTree->findEntityByID(entityID);
                             if (filteredEntity) {
                                 requiresFullScene |= addAncestorsToExtraFlaggedEntities(entityID, *filteredEntity, *nodeData);
@@ -77,7 +77,7 @@ void EntityTreeSendThread::preDistributionProcessing() {
                     if (includeDescendants) {
                         // we need to include descendants - recurse down to reach them all and add their IDs
                         // to the set of extra entities to include for this node
-                        entityTree->withReadLock([&]{
+                        entityTree->withMeasuredReadLock([&]{
                             auto filteredEntity = entityTree->findEntityByID(entityID);
                             if (filteredEntity) {
                                 requiresFullScene |= addDescendantsToExtraFlaggedEntities(entityID, *filteredEntity, *nodeData);
@@ -142,6 +142,12 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
         }
         
         const unsigned char* editData = nullptr;
+
+        // let the tree decode, look up and filter the edits of this packet in parallel, before they're applied one at a
+        // time under the write lock
+        quint64 startPrefilter = usecTimestampNow();
+        _myServer->getOctree()->prefilterEditPacket(*message, sendingNode);
+        quint64 prefilterTime = usecTimestampNow() - startPrefilter;
         
         while (message->getBytesLeftToRead() > 0) {
 
@@ -160,7 +166,7 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
 
             quint64 startProcess, startLock = usecTimestampNow();
             int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
+            _myServer->getOctree()->withMeasuredWriteLock([&] {
                 startProcess = usecTimestampNow();
                 editDataBytesRead =
                     _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
@@ -189,6 +195,9 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
 
         }
 
+        _myServer->getOctree()->clearPrefilteredEdits();
+        processTime += prefilterTime;
+
         if (debugProcessPacket) {
             qDebug("OctreeInboundPacketProcessor::processPacket() DONE LOOPING FOR %hhu "
                    "payload=%p payloadLength=%lld editData=%p payloadPosition=%lld",
@@ -363,7 +363,7 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
 
     quint64 start = usecTimestampNow();
 
-    _myServer->getOctree()->withReadLock([&]{
+    _myServer->getOctree()->withMeasuredReadLock([&]{
         traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
     });
 
@@ -1521,6 +1521,10 @@ void OctreeServer::sendStatsPacket() {
     jsonArray["2. octree"] = octreeStats;
     jsonArray["3. outbound"] = statsObject2;
     jsonArray["4. inbound"] = statsObject3;
+    QJsonObject subclassStats = serverSubclassJsonStats();
+    if (!subclassStats.isEmpty()) {
+        jsonArray["5. " + QString(getMyServerName()).toLower()] = subclassStats;
+    }
 
     QJsonObject statsObject;
     statsObject[QString(getMyServerName()) + "Server"] = jsonArray;
@@ -97,6 +97,12 @@ EntityScriptServer::EntityScriptServer(ReceivedMessage& message) : ThreadedAssig
     timer->setInterval(LOG_INTERVAL);
     connect(timer, &QTimer::timeout, this, &EntityScriptServer::pushLogs);
     timer->start();
+
+    static const int WATCHDOG_INTERVAL = MSECS_PER_SECOND;
+    auto watchdogTimer = new QTimer(this);
+    watchdogTimer->setInterval(WATCHDOG_INTERVAL);
+    connect(watchdogTimer, &QTimer::timeout, this, &EntityScriptServer::runScriptWatchdog);
+    watchdogTimer->start();
 }
 
 EntityScriptServer::~EntityScriptServer() {
@@ -126,7 +132,7 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptManager->getEntityScriptDetails(entityID, details)) {
+        if (_entitiesScriptPool && _entitiesScriptPool->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -171,10 +177,38 @@ void EntityScriptServer::handleSettings() {
 
     qDebug() << QString("Received entity script server settings, Max Entity PPS: %1, Entity PPS Per Entity Script: %2")
                 .arg(_maxEntityPPS).arg(_entityPPSPerScript);
+
+    static const QString SCRIPT_THREADS_OPTION = "script_threads";
+    static const QString SCRIPT_CPU_BUDGET_OPTION = "script_cpu_budget_ms";
+    static const QString SCRIPT_MIGRATION_OPTION = "script_migration";
+
+    // 0 means the default number of threads
+    int scriptThreads = entityScriptServerSettings.value(SCRIPT_THREADS_OPTION).toInt(0);
+    _scriptShardCount = scriptThreads > 0 ? std::min(scriptThreads, EntityScriptServerPool::MAX_SHARD_COUNT)
+                                          : EntityScriptServerPool::getDefaultShardCount();
+    _scriptCPUBudgetMsPerSecond = std::max(1, entityScriptServerSettings.value(SCRIPT_CPU_BUDGET_OPTION).toInt(DEFAULT_SCRIPT_CPU_BUDGET_MS_PER_SECOND));
+    _scriptMigrationEnabled = entityScriptServerSettings.value(SCRIPT_MIGRATION_OPTION).toBool(false);
+
+    if (_entitiesScriptPool) {
+        _entitiesScriptPool->setCPUBudget(std::chrono::milliseconds(_scriptCPUBudgetMsPerSecond));
+        _entitiesScriptPool->setMigrationEnabled(_scriptMigrationEnabled);
+
+        // the pool can only be resized before it has picked up any entity script, including the ones still loading
+        if (_entitiesScriptPool->getShardCount() != _scriptShardCount &&
+            _entitiesScriptPool->getNumRunningEntityScripts() == 0 && _entitiesScriptPool->getNumAssignedEntityScripts() == 0) {
+            resetEntitiesScriptEngine();
+        }
+    }
+
+    qDebug() << QString("Entity script threads: %1, Entity script CPU budget: %2 ms/s, Entity script migration: %3")
+                .arg(_scriptShardCount).arg(_scriptCPUBudgetMsPerSecond).arg(_scriptMigrationEnabled);
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptManager->getNumRunningEntityScripts();
+    if (!_entitiesScriptPool) {
+        return;
+    }
+    int numRunningScripts = _entitiesScriptPool->getNumRunningEntityScripts();
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -246,7 +280,7 @@ void EntityScriptServer::addLogEntry(const QString& message, const QString& file
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptManager && _entityViewer.getTree() && !_shuttingDown) {
+    if (_entitiesScriptPool && _entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -260,7 +294,7 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptManager->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        _entitiesScriptPool->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -341,6 +375,12 @@ void EntityScriptServer::cleanupOldKilledListeners() {
     _killedListeners.erase(it, std::end(_killedListeners));
 }
 
+void EntityScriptServer::runScriptWatchdog() {
+    if (_entitiesScriptPool && !_shuttingDown) {
+        _entitiesScriptPool->runWatchdog();
+    }
+}
+
 void EntityScriptServer::nodeActivated(SharedNodePointer activatedNode) {
     switch (activatedNode->getType()) {
         case NodeType::AudioMixer:
@@ -455,7 +495,7 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
+ScriptManagerPointer EntityScriptServer::createEntitiesScriptManager(int shard) {
     auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
     auto newManager = scriptManagerFactory(ScriptManager::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
     auto newEngine = newManager->engine();
@@ -496,37 +536,64 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
                 addLogEntry(message, fileName, lineNumber, entityID, ScriptMessage::Severity::SEVERITY_WARNING);
             });
 
-    connect(newManager.get(), &ScriptManager::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->preUpdate();
-        _entityViewer.getTree()->update();
-    });
+    // the tree only needs to be driven by one of the shards
+    if (shard == 0) {
+        connect(newManager.get(), &ScriptManager::update, this, [this] {
+            _entityViewer.queryOctree();
+            _entityViewer.getTree()->preUpdate();
+            _entityViewer.getTree()->update();
+        });
+    }
+
+    connect(newManager.get(), &ScriptManager::entityScriptDetailsUpdated,
+            this, &EntityScriptServer::updateEntityPPS);
 
     scriptEngines->runScriptInitializers(newManager);
     newManager->runInThread();
-    std::shared_ptr<EntitiesScriptEngineProvider> newEngineSP = newManager;
+    return newManager;
+}
+
+void EntityScriptServer::resetEntitiesScriptEngine() {
+    if (_entitiesScriptPool) {
+        _entitiesScriptPool->forEachManager([this](const ScriptManagerPointer& manager) {
+            disconnect(manager.get(), &ScriptManager::entityScriptDetailsUpdated,
+                       this, &EntityScriptServer::updateEntityPPS);
+            if (!manager->isStopped()) {
+                manager->unloadAllEntityScripts();
+                manager->stop();
+                manager->waitTillDoneRunning();
+            }
+        });
+    }
+
+    auto newPool = std::make_shared<EntityScriptServerPool>(_scriptShardCount, [this](int shard) {
+        return createEntitiesScriptManager(shard);
+    });
+    newPool->setCPUBudget(std::chrono::milliseconds(_scriptCPUBudgetMsPerSecond));
+    newPool->setMigrationEnabled(_scriptMigrationEnabled);
+    connect(newPool.get(), &EntityScriptServerPool::entityScriptMigrated, this, [this](const EntityItemID& entityID) {
+        checkAndCallPreload(entityID);
+    });
+
     // On the entity script server, these are the same
+    std::shared_ptr<EntitiesScriptEngineProvider> newEngineSP = newPool;
     DependencyManager::get<EntityScriptingInterface>()->setPersistentEntitiesScriptEngine(newEngineSP);
     DependencyManager::get<EntityScriptingInterface>()->setNonPersistentEntitiesScriptEngine(newEngineSP);
 
-    if (_entitiesScriptManager) {
-        disconnect(_entitiesScriptManager.get(), &ScriptManager::entityScriptDetailsUpdated,
-                   this, &EntityScriptServer::updateEntityPPS);
-    }
-
-    _entitiesScriptManager.swap(newManager);
-    connect(_entitiesScriptManager.get(), &ScriptManager::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+    _entitiesScriptPool.swap(newPool);
 }
 
 
 void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptManager) {
+    // unload and stop the engines
+    if (_entitiesScriptPool) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptManager->unloadAllEntityScripts();
-        _entitiesScriptManager->stop();
-        _entitiesScriptManager->waitTillDoneRunning();
+        _entitiesScriptPool->forEachManager([](const ScriptManagerPointer& manager) {
+            manager->unloadAllEntityScripts();
+            manager->stop();
+            manager->waitTillDoneRunning();
+        });
+        _entitiesScriptPool->releaseAllEntities();
     }
 
     _entityViewer.clear();
@@ -538,8 +605,10 @@ void EntityScriptServer::clear() {
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptManager) {
-        _entitiesScriptManager->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    if (_entitiesScriptPool) {
+        _entitiesScriptPool->forEachManager([](const ScriptManagerPointer& manager) {
+            manager->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+        });
     }
     _shuttingDown = true;
 
@@ -548,7 +617,7 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptManager.reset();
+    _entitiesScriptPool.reset();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
@@ -566,9 +635,13 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptManager) {
-        // TODO: Check if this is running on script engine thread, otherwise lambda capturing script engine pointer is needed
-        _entitiesScriptManager->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptPool) {
+        auto manager = _entitiesScriptPool->managerForEntity(entityID);
+        if (manager) {
+            // TODO: Check if this is running on script engine thread, otherwise lambda capturing script engine pointer is needed
+            manager->unloadEntityScript(entityID, true);
+        }
+        _entitiesScriptPool->releaseEntity(entityID);
     }
 }
 
@@ -579,21 +652,25 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptManager) {
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptPool) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptManager->getEntityScriptDetails(entityID, details);
+        bool isRunning = _entitiesScriptPool->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
+            auto manager = _entitiesScriptPool->assignEntity(entityID);
+
             // TODO: Check if this is running on script engine thread, otherwise lambda capturing script engine pointer is needed
             if (isRunning) {
-                _entitiesScriptManager->unloadEntityScript(entityID, true);
+                manager->unloadEntityScript(entityID, true);
             }
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptManager->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                manager->loadEntityScript(entityID, scriptUrl, forceRedownload);
+            } else {
+                _entitiesScriptPool->releaseEntity(entityID);
             }
         }
     }
@@ -610,9 +687,10 @@ void EntityScriptServer::sendStatsPacket() {
 
     QJsonObject scriptEngineStats;
     int numberRunningScripts = 0;
-    const auto scriptManager = _entitiesScriptManager;
-    if (scriptManager) {
-        numberRunningScripts = scriptManager->getNumRunningEntityScripts();
+    const auto scriptPool = _entitiesScriptPool;
+    if (scriptPool) {
+        numberRunningScripts = scriptPool->getNumRunningEntityScripts();
+        scriptEngineStats["pool"] = scriptPool->getStats();
     }
     scriptEngineStats["number_running_scripts"] = numberRunningScripts;
     statsObject["script_engine_stats"] = scriptEngineStats;
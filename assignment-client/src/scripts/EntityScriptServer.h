@@ -31,6 +31,7 @@
 #include <QJsonArray>
 
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "EntityScriptServerPool.h"
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -91,6 +92,7 @@ private:
     void selectAudioFormat(const QString& selectedCodecName);
 
     void resetEntitiesScriptEngine();
+    ScriptManagerPointer createEntitiesScriptManager(int shard);
     void clear();
     void shutdownScriptEngine();
 
@@ -100,11 +102,15 @@ private:
     void checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload = false);
 
     void cleanupOldKilledListeners();
+    void runScriptWatchdog();
 
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptManagerPointer _entitiesScriptManager;
+    EntityScriptServerPoolPointer _entitiesScriptPool;
+    int _scriptShardCount { EntityScriptServerPool::getDefaultShardCount() };
+    int _scriptCPUBudgetMsPerSecond { DEFAULT_SCRIPT_CPU_BUDGET_MS_PER_SECOND };
+    bool _scriptMigrationEnabled { false };
     SimpleEntitySimulationPointer _entitySimulation;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
@@ -0,0 +1,295 @@
+//
+//  EntityScriptServerPool.cpp
+//  assignment-client/src/scripts
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EntityScriptServerPool.h"
+
+#include <algorithm>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QThread>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+
+#include "EntityScriptServerLogging.h"
+
+const int EntityScriptServerPool::MAX_SHARD_COUNT = 16;
+// the assignment shares the machine with the other assignment clients, so don't take a thread per core by default
+const int EntityScriptServerPool::DEFAULT_SHARD_COUNT = 2;
+
+// a shard whose event loop hasn't ticked for this long is reported as stalled
+static const quint64 WATCHDOG_STALL_USECS = 2 * USECS_PER_SECOND;
+// don't bounce a script between shards more often than this
+static const quint64 MIGRATION_COOLDOWN_USECS = 30 * USECS_PER_SECOND;
+static const int NUM_TOP_SCRIPTS_IN_STATS = 5;
+
+int EntityScriptServerPool::getDefaultShardCount() {
+    // leave a core for the assignment's main thread (networking, octree processing)
+    return std::max(1, std::min(QThread::idealThreadCount() - 1, DEFAULT_SHARD_COUNT));
+}
+
+EntityScriptServerPool::EntityScriptServerPool(int shardCount, const ManagerFactory& factory) :
+    _cpuBudgetPerSecond(DEFAULT_SCRIPT_CPU_BUDGET_MS_PER_SECOND * USECS_PER_MSEC)
+{
+    shardCount = std::max(1, std::min(shardCount, MAX_SHARD_COUNT));
+    _shards.resize(shardCount);
+    for (int i = 0; i < shardCount; ++i) {
+        _shards[i].manager = factory(i);
+    }
+}
+
+void EntityScriptServerPool::forEachManager(const std::function<void(const ScriptManagerPointer&)>& operation) const {
+    for (const auto& shard : _shards) {
+        if (shard.manager) {
+            operation(shard.manager);
+        }
+    }
+}
+
+int EntityScriptServerPool::pickShard(const EntityItemID& entityID) const {
+    return (int)(qHash(entityID) % (uint)_shards.size());
+}
+
+ScriptManagerPointer EntityScriptServerPool::managerForEntity(const EntityItemID& entityID) const {
+    std::lock_guard<std::mutex> lock(_assignmentsLock);
+    auto it = _assignments.constFind(entityID);
+    if (it == _assignments.constEnd()) {
+        return nullptr;
+    }
+    return _shards[it.value()].manager;
+}
+
+ScriptManagerPointer EntityScriptServerPool::assignEntity(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_assignmentsLock);
+    auto it = _assignments.constFind(entityID);
+    if (it != _assignments.constEnd()) {
+        return _shards[it.value()].manager;
+    }
+
+    int shard = pickShard(entityID);
+    _assignments.insert(entityID, shard);
+    _shards[shard].assignedScripts++;
+    return _shards[shard].manager;
+}
+
+void EntityScriptServerPool::releaseEntity(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_assignmentsLock);
+    auto it = _assignments.find(entityID);
+    if (it != _assignments.end()) {
+        _shards[it.value()].assignedScripts--;
+        _assignments.erase(it);
+    }
+    _accounting.remove(entityID);
+}
+
+void EntityScriptServerPool::releaseAllEntities() {
+    std::lock_guard<std::mutex> lock(_assignmentsLock);
+    _assignments.clear();
+    _accounting.clear();
+    for (auto& shard : _shards) {
+        shard.assignedScripts = 0;
+    }
+}
+
+void EntityScriptServerPool::migrateEntity(const EntityItemID& entityID, int toShard) {
+    if (toShard < 0 || toShard >= (int)_shards.size()) {
+        return;
+    }
+
+    ScriptManagerPointer fromManager;
+    {
+        std::lock_guard<std::mutex> lock(_assignmentsLock);
+        auto it = _assignments.find(entityID);
+        if (it == _assignments.end() || it.value() == toShard) {
+            return;
+        }
+
+        fromManager = _shards[it.value()].manager;
+        _shards[it.value()].assignedScripts--;
+        _shards[toShard].assignedScripts++;
+        _shards[toShard].migrationsIn++;
+        it.value() = toShard;
+
+        // the execution time totals restart from zero on the new shard
+        auto& accounting = _accounting[entityID];
+        accounting.lastTotal = std::chrono::microseconds(0);
+        accounting.lastMigration = usecTimestampNow();
+        _totalMigrations++;
+    }
+
+    qCDebug(entity_script_server) << "Migrating entity script" << entityID << "to shard" << toShard;
+
+    // the unload is queued on the old shard's thread, the owner reloads the script on the new shard
+    fromManager->unloadEntityScript(entityID, true);
+    emit entityScriptMigrated(entityID);
+}
+
+bool EntityScriptServerPool::getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails& details) const {
+    auto manager = managerForEntity(entityID);
+    return manager && manager->getEntityScriptDetails(entityID, details);
+}
+
+int EntityScriptServerPool::getNumRunningEntityScripts() const {
+    int sum = 0;
+    forEachManager([&](const ScriptManagerPointer& manager) {
+        sum += manager->getNumRunningEntityScripts();
+    });
+    return sum;
+}
+
+int EntityScriptServerPool::getNumAssignedEntityScripts() const {
+    std::lock_guard<std::mutex> lock(_assignmentsLock);
+    return (int)_assignments.size();
+}
+
+void EntityScriptServerPool::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                    const QStringList& params, const QUuid& remoteCallerID) {
+    auto manager = managerForEntity(entityID);
+    if (manager) {
+        manager->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+    }
+}
+
+QFuture<QVariant> EntityScriptServerPool::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    auto manager = managerForEntity(entityID);
+    if (!manager) {
+        // any shard answers consistently for an entity it doesn't know about
+        manager = _shards[0].manager;
+    }
+    return manager->getLocalEntityScriptDetails(entityID);
+}
+
+void EntityScriptServerPool::runWatchdog() {
+    quint64 now = usecTimestampNow();
+    std::chrono::microseconds interval { _lastWatchdogCheck > 0 && now > _lastWatchdogCheck ? now - _lastWatchdogCheck : 0 };
+    _lastWatchdogCheck = now;
+
+    struct OverBudgetScript {
+        EntityItemID entityID;
+        int shard;
+        float load;
+    };
+    std::vector<OverBudgetScript> overBudgetScripts;
+
+    {
+        std::lock_guard<std::mutex> lock(_assignmentsLock);
+        for (int i = 0; i < (int)_shards.size(); ++i) {
+            auto& shard = _shards[i];
+
+            bool wasStalled = shard.stalled;
+            shard.stalled = shard.manager->getUsecsSinceLastHeartbeat() > WATCHDOG_STALL_USECS;
+            if (shard.stalled && !wasStalled) {
+                qCWarning(entity_script_server) << "Entity script shard" << i << "has not run its event loop for"
+                    << shard.manager->getUsecsSinceLastHeartbeat() / USECS_PER_MSEC << "ms";
+            }
+
+            std::chrono::microseconds shardTotal { 0 };
+            auto executionTimes = shard.manager->getEntityScriptExecutionTimes();
+            for (auto it = executionTimes.constBegin(); it != executionTimes.constEnd(); ++it) {
+                auto& accounting = _accounting[it.key()];
+                auto usage = it.value() >= accounting.lastTotal ? it.value() - accounting.lastTotal : it.value();
+                accounting.lastTotal = it.value();
+                accounting.lastInterval = usage;
+                shardTotal += usage;
+
+                if (interval.count() == 0) {
+                    continue;
+                }
+                float load = (float)usage.count() / (float)interval.count();
+                float budget = (float)_cpuBudgetPerSecond.count() / (float)USECS_PER_SECOND;
+                if (load > budget) {
+                    accounting.overBudgetCount++;
+                    _totalOverBudget++;
+                    if (now - accounting.lastMigration > MIGRATION_COOLDOWN_USECS) {
+                        overBudgetScripts.push_back({ it.key(), i, load });
+                    }
+                }
+            }
+            shard.cpuLoad = interval.count() > 0 ? (float)shardTotal.count() / (float)interval.count() : 0.0f;
+        }
+    }
+
+    if (!_migrationEnabled || _shards.size() < 2 || overBudgetScripts.empty()) {
+        return;
+    }
+
+    // move the busiest scripts first, each to the least loaded responsive shard, as long as that improves the balance
+    std::sort(overBudgetScripts.begin(), overBudgetScripts.end(), [](const OverBudgetScript& a, const OverBudgetScript& b) {
+        return a.load > b.load;
+    });
+    for (const auto& script : overBudgetScripts) {
+        auto& fromShard = _shards[script.shard];
+        if (fromShard.stalled) {
+            // the unload couldn't run until the blocking script returns
+            continue;
+        }
+
+        int target = -1;
+        for (int i = 0; i < (int)_shards.size(); ++i) {
+            if (i != script.shard && !_shards[i].stalled && (target == -1 || _shards[i].cpuLoad < _shards[target].cpuLoad)) {
+                target = i;
+            }
+        }
+        if (target == -1 || _shards[target].cpuLoad + script.load >= fromShard.cpuLoad) {
+            continue;
+        }
+
+        qCWarning(entity_script_server) << "Entity script" << script.entityID << "used" << (int)(script.load * 100.0f)
+            << "% of a core, over its budget of" << _cpuBudgetPerSecond.count() / USECS_PER_MSEC << "ms/s";
+        fromShard.cpuLoad -= script.load;
+        _shards[target].cpuLoad += script.load;
+        migrateEntity(script.entityID, target);
+    }
+}
+
+QJsonObject EntityScriptServerPool::getStats() const {
+    QJsonObject stats;
+    stats["shard_count"] = (int)_shards.size();
+    stats["cpu_budget_ms_per_s"] = (double)_cpuBudgetPerSecond.count() / USECS_PER_MSEC;
+    stats["migration_enabled"] = _migrationEnabled;
+
+    std::lock_guard<std::mutex> lock(_assignmentsLock);
+    stats["total_migrations"] = (double)_totalMigrations;
+    stats["total_over_budget"] = (double)_totalOverBudget;
+
+    QJsonArray shards;
+    for (const auto& shard : _shards) {
+        QJsonObject shardStats;
+        shardStats["running_scripts"] = shard.manager->getNumRunningEntityScripts();
+        shardStats["assigned_scripts"] = shard.assignedScripts;
+        shardStats["cpu_load_percent"] = shard.cpuLoad * 100.0f;
+        shardStats["stalled"] = shard.stalled;
+        shardStats["migrations_in"] = (double)shard.migrationsIn;
+        shards.append(shardStats);
+    }
+    stats["shards"] = shards;
+
+    std::vector<std::pair<EntityItemID, ScriptAccounting>> scripts;
+    scripts.reserve(_accounting.size());
+    for (auto it = _accounting.constBegin(); it != _accounting.constEnd(); ++it) {
+        scripts.emplace_back(it.key(), it.value());
+    }
+    int numTopScripts = std::min((int)scripts.size(), NUM_TOP_SCRIPTS_IN_STATS);
+    std::partial_sort(scripts.begin(), scripts.begin() + numTopScripts, scripts.end(), [](const auto& a, const auto& b) {
+        return a.second.lastInterval > b.second.lastInterval;
+    });
+    QJsonObject topScripts;
+    for (int i = 0; i < numTopScripts; ++i) {
+        QJsonObject scriptStats;
+        scriptStats["cpu_ms_last_interval"] = (double)scripts[i].second.lastInterval.count() / USECS_PER_MSEC;
+        scriptStats["over_budget_count"] = scripts[i].second.overBudgetCount;
+        topScripts[uuidStringWithoutCurlyBraces(scripts[i].first)] = scriptStats;
+    }
+    stats["top_scripts"] = topScripts;
+
+    return stats;
+}
@@ -0,0 +1,122 @@
+//
+//  EntityScriptServerPool.h
+//  assignment-client/src/scripts
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_EntityScriptServerPool_h
+#define hifi_EntityScriptServerPool_h
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptManager.h>
+
+static const int DEFAULT_SCRIPT_CPU_BUDGET_MS_PER_SECOND = 100;
+
+/// Runs server entity scripts on several script managers, each with its own engine and thread, so that
+/// a slow entity script only delays the scripts that share its shard.
+///
+/// Entity scripts are assigned to a shard by entity ID the first time they are loaded, and keep that shard
+/// until they are unloaded or migrated. The watchdog accounts the execution time of every entity script
+/// against a per-second budget and reports the scripts that exceed it. If migration is enabled it also moves
+/// them to the least loaded shard; a migration unloads and reloads the script, so it loses its state.
+class EntityScriptServerPool : public QObject, public EntitiesScriptEngineProvider {
+    Q_OBJECT
+
+public:
+    using ManagerFactory = std::function<ScriptManagerPointer(int shard)>;
+
+    static const int MAX_SHARD_COUNT;
+    static const int DEFAULT_SHARD_COUNT;
+    static int getDefaultShardCount();
+
+    EntityScriptServerPool(int shardCount, const ManagerFactory& factory);
+
+    int getShardCount() const { return (int)_shards.size(); }
+    ScriptManagerPointer getManager(int shard) const { return _shards[shard].manager; }
+    void forEachManager(const std::function<void(const ScriptManagerPointer&)>& operation) const;
+
+    /// Returns the manager the entity script runs on, or nullptr if it isn't assigned to a shard yet
+    ScriptManagerPointer managerForEntity(const EntityItemID& entityID) const;
+    /// Returns the manager the entity script runs on, assigning it to a shard if needed
+    ScriptManagerPointer assignEntity(const EntityItemID& entityID);
+    void releaseEntity(const EntityItemID& entityID);
+    void releaseAllEntities();
+
+    /// Unloads the entity script from its current shard and moves it to another one.
+    /// Emits entityScriptMigrated() so the owner can load the script on its new shard. The script starts over
+    /// on the new shard: anything it kept in its closures or on `this` is lost, and unload() and preload() run again.
+    void migrateEntity(const EntityItemID& entityID, int toShard);
+
+    void setMigrationEnabled(bool enabled) { _migrationEnabled = enabled; }
+    bool isMigrationEnabled() const { return _migrationEnabled; }
+
+    bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails& details) const;
+    int getNumRunningEntityScripts() const;
+    /// Returns the number of entity scripts assigned to a shard, including the ones still loading
+    int getNumAssignedEntityScripts() const;
+
+    void setCPUBudget(std::chrono::microseconds budgetPerSecond) { _cpuBudgetPerSecond = budgetPerSecond; }
+    std::chrono::microseconds getCPUBudget() const { return _cpuBudgetPerSecond; }
+
+    /// Samples the execution time of every entity script since the last check, flags the scripts that went over
+    /// budget and the shards whose thread stopped responding, and rebalances over budget scripts if migration is enabled.
+    void runWatchdog();
+
+    QJsonObject getStats() const;
+
+    // EntitiesScriptEngineProvider
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+signals:
+    void entityScriptMigrated(const EntityItemID& entityID);
+
+private:
+    struct Shard {
+        ScriptManagerPointer manager;
+        int assignedScripts { 0 };
+        float cpuLoad { 0.0f };
+        bool stalled { false };
+        quint64 migrationsIn { 0 };
+    };
+
+    struct ScriptAccounting {
+        std::chrono::microseconds lastTotal { 0 };
+        std::chrono::microseconds lastInterval { 0 };
+        quint64 lastMigration { 0 };
+        int overBudgetCount { 0 };
+    };
+
+    int pickShard(const EntityItemID& entityID) const;
+
+    std::vector<Shard> _shards;
+
+    mutable std::mutex _assignmentsLock;
+    QHash<EntityItemID, int> _assignments;
+    QHash<EntityItemID, ScriptAccounting> _accounting;
+
+    std::chrono::microseconds _cpuBudgetPerSecond;
+    bool _migrationEnabled { false };
+    quint64 _lastWatchdogCheck { 0 };
+    quint64 _totalMigrations { 0 };
+    quint64 _totalOverBudget { 0 };
+};
+
+using EntityScriptServerPoolPointer = std::shared_ptr<EntityScriptServerPool>;
+
+#endif // hifi_EntityScriptServerPool_h
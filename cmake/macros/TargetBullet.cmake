@@ -17,6 +17,12 @@ macro(TARGET_BULLET)
         list(APPEND BULLET_LIBRARIES ${LIB_DIR}/libBulletSoftBody.a)
     else()
         find_package(Bullet REQUIRED)
+        # our Bullet port is built with BULLET2_MULTITHREADING, which compiles it with BT_THREADSAFE=1; its headers
+        # must be compiled the same way here, whether or not the multithreaded world is
+        target_compile_definitions(${TARGET_NAME} PRIVATE BT_THREADSAFE=1)
+        if (USE_BULLET_MULTITHREADING)
+            target_compile_definitions(${TARGET_NAME} PRIVATE HIFI_BULLET_MULTITHREADING)
+        endif()
    endif()
     # perform the system include hack for OS X to ignore warnings
     if (APPLE)
@@ -37,6 +37,7 @@ vcpkg_configure_cmake(
         -DUSE_GLUT=0
         -DBUILD_OPENGL3_DEMOS=OFF
         -DBUILD_BULLET3=OFF
+        -DBULLET2_MULTITHREADING=ON
         -DBUILD_BULLET2_DEMOS=OFF
         -DBUILD_CPU_DEMOS=OFF
         -DBUILD_EXTRAS=OFF
@@ -0,0 +1,83 @@
+//
+//  DomainCheckInWorkers.cpp
+//  domain-server/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "DomainCheckInWorkers.h"
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+
+#include <SharedUtil.h>
+#include <ThreadHelpers.h>
+
+DomainCheckInWorkers::DomainCheckInWorkers(int numThreads) {
+    // leave a core for the main thread, which still owns the node list and does the rest of the domain-server's work
+    static const int MAX_THREADS_IF_UNKNOWN = 4;
+    static const int MAX_THREADS = 8;
+    if (numThreads < 1) {
+        numThreads = MAX_THREADS_IF_UNKNOWN;
+    }
+    numThreads = std::min(std::max(1, numThreads - 1), MAX_THREADS);
+
+    for (int i = 0; i < numThreads; ++i) {
+        auto worker = std::make_unique<Worker>();
+        QString name = QString("Domain Check-In Thread %1").arg(i);
+        worker->thread.setObjectName(name);
+        worker->context = std::make_unique<QObject>();
+        worker->context->moveToThread(&worker->thread);
+        QObject::connect(&worker->thread, &QThread::started, [name] { setThreadName(name.toStdString()); });
+        worker->thread.start();
+        _workers.push_back(std::move(worker));
+    }
+
+    qDebug() << "Handling node check-ins on" << numThreads << "threads";
+}
+
+DomainCheckInWorkers::~DomainCheckInWorkers() {
+    // jobs still queued are dropped along with the contexts they were posted to
+    for (auto& worker : _workers) {
+        worker->thread.quit();
+    }
+    for (auto& worker : _workers) {
+        worker->thread.wait();
+        worker->context.reset();
+    }
+}
+
+void DomainCheckInWorkers::post(uint key, std::function<void()> job) {
+    auto& worker = _workers[key % _workers.size()];
+
+    ++_numPending;
+    quint64 postTime = usecTimestampNow();
+    QMetaObject::invokeMethod(worker->context.get(), [this, postTime, job = std::move(job)] {
+        quint64 queuedUsecs = usecTimestampNow() - postTime;
+        _totalQueuedUsecs += queuedUsecs;
+        uint64_t maxQueuedUsecs = _maxQueuedUsecs;
+        while (queuedUsecs > maxQueuedUsecs && !_maxQueuedUsecs.compare_exchange_weak(maxQueuedUsecs, queuedUsecs)) {
+        }
+
+        job();
+
+        ++_numJobs;
+        --_numPending;
+    }, Qt::QueuedConnection);
+}
+
+QJsonObject DomainCheckInWorkers::statsObject() const {
+    QJsonObject stats;
+    uint64_t numJobs = _numJobs;
+    stats["threads"] = numThreads();
+    stats["jobs"] = (qint64)numJobs;
+    stats["pending_jobs"] = _numPending.load();
+    stats["usecs_queued"] = numJobs > 0 ? (double)_totalQueuedUsecs / numJobs : 0.0;
+    stats["max_usecs_queued"] = (qint64)_maxQueuedUsecs.load();
+    return stats;
+}
@@ -0,0 +1,52 @@
+//
+//  DomainCheckInWorkers.h
+//  domain-server/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_DomainCheckInWorkers_h
+#define hifi_DomainCheckInWorkers_h
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QThread>
+
+// A fixed set of threads that connect and list requests are handed to, so that a burst of nodes checking in
+// doesn't queue up behind a single thread. Work is sharded by key, normally a node's UUID: every job posted with
+// the same key runs on the same thread, in the order it was posted.
+//   DomainCheckInWorkers should be created and posted to from the domain-server's main thread.
+class DomainCheckInWorkers {
+public:
+    DomainCheckInWorkers(int numThreads = QThread::idealThreadCount());
+    ~DomainCheckInWorkers();
+
+    void post(uint key, std::function<void()> job);
+
+    int numThreads() const { return (int)_workers.size(); }
+
+    QJsonObject statsObject() const;
+
+private:
+    struct Worker {
+        QThread thread;
+        std::unique_ptr<QObject> context;
+    };
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+
+    std::atomic<int> _numPending { 0 };
+    std::atomic<uint64_t> _numJobs { 0 };
+    std::atomic<uint64_t> _totalQueuedUsecs { 0 };
+    std::atomic<uint64_t> _maxQueuedUsecs { 0 };
+};
+
+#endif // hifi_DomainCheckInWorkers_h
@@ -90,11 +90,11 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
     // check if this connect request matches an assignment in the queue
     auto pendingAssignment = _pendingAssignedNodes.find(nodeConnection.connectUUID);
 
-    SharedNodePointer node;
-    QString username;
     if (pendingAssignment != _pendingAssignedNodes.end()) {
-        node = processAssignmentConnectRequest(nodeConnection, pendingAssignment->second);
+        SharedNodePointer node = processAssignmentConnectRequest(nodeConnection, pendingAssignment->second);
+        finishConnectRequest(node, nodeConnection, QString(), message->getFirstPacketReceiveTime());
     } else if (!STATICALLY_ASSIGNED_NODES.contains(nodeConnection.nodeType)) {
+        QString username;
         QByteArray usernameSignature;
 
         QString domainUsername;
@@ -124,14 +124,19 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
             }
         }
 
-        node = processAgentConnectRequest(nodeConnection, username, usernameSignature,
-                                          domainUsername, domainTokens.value(0), domainTokens.value(1));
+        processAgentConnectRequest(nodeConnection, username, usernameSignature, domainUsername,
+                                   domainTokens.value(0), domainTokens.value(1), message->getFirstPacketReceiveTime());
+    } else {
+        finishConnectRequest(SharedNodePointer(), nodeConnection, QString(), message->getFirstPacketReceiveTime());
     }
+}
 
+void DomainGatekeeper::finishConnectRequest(const SharedNodePointer& node, const NodeConnectionData& nodeConnection,
+                                            const QString& username, quint64 requestReceiveTime) {
     if (node) {
         // set the sending sock addr and node interest set on this node
         DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-        nodeData->setSendingSockAddr(message->getSenderSockAddr());
+        nodeData->setSendingSockAddr(nodeConnection.senderSockAddr);
 
         // guard against patched agents asking to hear about other agents
         auto safeInterestSet = QSet<NodeType_t>(nodeConnection.interestList.begin(), nodeConnection.interestList.end());
@@ -144,7 +149,7 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
 
         QMetaEnum metaEnum = QMetaEnum::fromType<LimitedNodeList::ConnectReason>();
         qDebug() << "Allowed connection from node" << uuidStringWithoutCurlyBraces(node->getUUID())
-            << "on" << message->getSenderSockAddr()
+            << "on" << nodeConnection.senderSockAddr
             << "with MAC" << nodeConnection.hardwareAddress
             << "and machine fingerprint" << nodeConnection.machineFingerprint
             << "user" << username
@@ -154,9 +159,9 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
 
         // signal that we just connected a node so the DomainServer can get it a list
         // and broadcast its presence right away
-        emit connectedNode(node, message->getFirstPacketReceiveTime());
+        emit connectedNode(node, requestReceiveTime);
     } else {
-        qDebug() << "Refusing connection from node at" << message->getSenderSockAddr()
+        qDebug() << "Refusing connection from node at" << nodeConnection.senderSockAddr
             << "with hardware address" << nodeConnection.hardwareAddress
             << "and machine fingerprint" << nodeConnection.machineFingerprint
             << "sysinfo" << nodeConnection.SystemInfo;
@@ -166,164 +171,23 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
 NodePermissions DomainGatekeeper::setPermissionsForUser(bool isLocalUser, QString verifiedUsername,
                                                         QString verifiedDomainUserName, const QHostAddress& senderAddress,
                                                         const QString& hardwareAddress, const QUuid& machineFingerprint) {
-    NodePermissions userPerms;
-
-    userPerms.setAll(false);
-
-    if (isLocalUser) {
-        userPerms |= _server->_settingsManager.getStandardPermissionsForName(NodePermissions::standardNameLocalhost);
-#ifdef WANT_DEBUG
-        qDebug() << "|  user-permissions: is local user, so:" << userPerms;
-#endif
-    }
-
-    // If this user is a known member of a domain group, give them the implied permissions.
-    // Do before processing verifiedUsername in case user is logged into the Directory Services and is a member of a blocklist group.
-    if (!verifiedDomainUserName.isEmpty()) {
-        auto userGroups = _domainGroupMemberships[verifiedDomainUserName];
-        foreach (QString userGroup, userGroups) {
-            // A domain group is signified by a leading special character, "@".
-            // Multiple domain groups may be specified in one domain server setting as a comma- and/or space-separated lists of
-            // domain group names. For example, "@silver @Gold, @platinum".
-            auto domainGroups = _server->_settingsManager.getDomainServerGroupNames()
-                .filter(QRegularExpression("^(.*[\\s,])?" + QRegularExpression::escape(userGroup) + "([\\s,].*)?$",
-                    QRegularExpression::CaseInsensitiveOption));
-            foreach(QString domainGroup, domainGroups) {
-                userPerms |= _server->_settingsManager.getPermissionsForGroup(domainGroup, QUuid()); // No rank for domain groups.
-#ifdef WANT_DEBUG
-                qDebug() << "|  user-permissions: domain user " << verifiedDomainUserName << "is in group:" << domainGroup
-                    << "so:" << userPerms;
-#endif
-            }
-        }
-    }
-
-    if (verifiedUsername.isEmpty()) {
-        userPerms |= _server->_settingsManager.getStandardPermissionsForName(NodePermissions::standardNameAnonymous);
-#ifdef WANT_DEBUG
-        qDebug() << "|  user-permissions: unverified or no username for" << userPerms.getID() << ", so:" << userPerms;
-#endif
-        if (!hardwareAddress.isEmpty() && _server->_settingsManager.hasPermissionsForMAC(hardwareAddress)) {
-            // this user comes from a MAC we have in our permissions table, apply those permissions
-            userPerms = _server->_settingsManager.getPermissionsForMAC(hardwareAddress);
-
-#ifdef WANT_DEBUG
-            qDebug() << "|  user-permissions: specific MAC matches, so:" << userPerms;
-#endif
-        } else if (_server->_settingsManager.hasPermissionsForMachineFingerprint(machineFingerprint)) {
-            userPerms = _server->_settingsManager.getPermissionsForMachineFingerprint(machineFingerprint);
-#ifdef WANT_DEBUG
-            qDebug() << "| user-permissions: specific Machine Fingerprint matches, so: " << userPerms;
-#endif
-        } else if (_server->_settingsManager.hasPermissionsForIP(senderAddress)) {
-            // this user comes from an IP we have in our permissions table, apply those permissions
-            userPerms = _server->_settingsManager.getPermissionsForIP(senderAddress);
-
-#ifdef WANT_DEBUG
-            qDebug() << "|  user-permissions: specific IP matches, so:" << userPerms;
-#endif
-        }
-    } else {
-        if (_server->_settingsManager.havePermissionsForName(verifiedUsername)) {
-            userPerms = _server->_settingsManager.getPermissionsForName(verifiedUsername);
-#ifdef WANT_DEBUG
-            qDebug() << "|  user-permissions: specific user matches, so:" << userPerms;
-#endif
-        } else if (!hardwareAddress.isEmpty() && _server->_settingsManager.hasPermissionsForMAC(hardwareAddress)) {
-            // this user comes from a MAC we have in our permissions table, apply those permissions
-            userPerms = _server->_settingsManager.getPermissionsForMAC(hardwareAddress);
-
-#ifdef WANT_DEBUG
-            qDebug() << "|  user-permissions: specific MAC matches, so:" << userPerms;
-#endif
-        } else if (_server->_settingsManager.hasPermissionsForMachineFingerprint(machineFingerprint)) {
-            userPerms = _server->_settingsManager.getPermissionsForMachineFingerprint(machineFingerprint);
-#ifdef WANT_DEBUG
-            qDebug() << "| user-permissions: specific Machine Fingerprint matches, so: " << userPerms;
-#endif
-        } else if (_server->_settingsManager.hasPermissionsForIP(senderAddress)) {
-            // this user comes from an IP we have in our permissions table, apply those permissions
-            userPerms = _server->_settingsManager.getPermissionsForIP(senderAddress);
-
-#ifdef WANT_DEBUG
-            qDebug() << "|  user-permissions: specific IP matches, so:" << userPerms;
-#endif
-        } else {
-            // they are logged into Directory Services, but we don't have specific permissions for them.
-            userPerms |= _server->_settingsManager.getStandardPermissionsForName(NodePermissions::standardNameLoggedIn);
-#ifdef WANT_DEBUG
-            qDebug() << "|  user-permissions: user is logged-into Directory Services, so:" << userPerms;
-#endif
-
-            // if this user is a friend of the domain-owner, give them friend's permissions
-            if (_domainOwnerFriends.contains(verifiedUsername)) {
-                userPerms |= _server->_settingsManager.getStandardPermissionsForName(NodePermissions::standardNameFriends);
-#ifdef WANT_DEBUG
-                qDebug() << "|  user-permissions: user is friends with domain-owner, so:" << userPerms;
-#endif
-            }
-
-            // if this user is a known member of a group, give them the implied permissions
-            foreach (QUuid groupID, _server->_settingsManager.getGroupIDs()) {
-                QUuid rankID = _server->_settingsManager.isGroupMember(verifiedUsername, groupID);
-                if (rankID != QUuid()) {
-                    userPerms |= _server->_settingsManager.getPermissionsForGroup(groupID, rankID);
-
-                    GroupRank rank = _server->_settingsManager.getGroupRank(groupID, rankID);
-#ifdef WANT_DEBUG
-                    qDebug() << "|  user-permissions: user " << verifiedUsername << "is in group:" << groupID << " rank:"
-                             << rank.name << "so:" << userPerms;
-#endif
-                }
-            }
-
-            // if this user is a known member of a blocklist group, remove the implied permissions
-            foreach (QUuid groupID, _server->_settingsManager.getBlocklistGroupIDs()) {
-                QUuid rankID = _server->_settingsManager.isGroupMember(verifiedUsername, groupID);
-                if (rankID != QUuid()) {
-                    QUuid rankID = _server->_settingsManager.isGroupMember(verifiedUsername, groupID);
-                    if (rankID != QUuid()) {
-                        userPerms &= ~_server->_settingsManager.getForbiddensForGroup(groupID, rankID);
-
-                        GroupRank rank = _server->_settingsManager.getGroupRank(groupID, rankID);
-#ifdef WANT_DEBUG
-                        qDebug() << "|  user-permissions: user is in blocklist group:" << groupID << " rank:" << rank.name
-                                 << "so:" << userPerms;
-#endif
-                    }
-                }
-            }
-        }
+    auto permissions = _server->_settingsManager.getPermissionsSnapshot();
+    return permissions->permissionsForUser(isLocalUser, verifiedUsername, verifiedDomainUserName, senderAddress,
+                                           hardwareAddress, machineFingerprint,
+                                           membershipsForUser(verifiedUsername, verifiedDomainUserName));
+}
 
-        userPerms.setID(verifiedUsername);
-        userPerms.setVerifiedUserName(verifiedUsername);
+DomainPermissionsSnapshot::Memberships DomainGatekeeper::membershipsForUser(const QString& verifiedUsername,
+                                                                            const QString& verifiedDomainUsername) const {
+    DomainPermissionsSnapshot::Memberships memberships;
+    if (!verifiedUsername.isEmpty()) {
+        memberships.groupRanks = _server->_settingsManager.getGroupMemberships(verifiedUsername);
+        memberships.isDomainOwnerFriend = _domainOwnerFriends.contains(verifiedUsername);
     }
-
-    // If this user is a known member of an domain group that is blocklisted, remove the implied permissions.
-    if (!verifiedDomainUserName.isEmpty()) {
-        auto userGroups = _domainGroupMemberships[verifiedDomainUserName];
-        foreach(QString userGroup, userGroups) {
-            // A domain group is signified by a leading special character, "@".
-            // Multiple domain groups may be specified in one domain server setting as a comma- and/or space-separated lists of
-            // domain group names. For example, "@silver @Gold, @platinum".
-            auto domainGroups = _server->_settingsManager.getDomainServerBlocklistGroupNames()
-                .filter(QRegularExpression("^(.*[\\s,])?" + QRegularExpression::escape(userGroup) + "([\\s,].*)?$",
-                    QRegularExpression::CaseInsensitiveOption));
-            foreach(QString domainGroup, domainGroups) {
-                userPerms &= ~_server->_settingsManager.getForbiddensForGroup(domainGroup, QUuid());
-#ifdef WANT_DEBUG
-                qDebug() << "|  user-permissions: domain user is in blocklist group:" << domainGroup << "so:" << userPerms;
-#endif
-            }
-        }
-
-        userPerms.setVerifiedDomainUserName(verifiedDomainUserName);
+    if (!verifiedDomainUsername.isEmpty()) {
+        memberships.domainGroups = _domainGroupMemberships.value(verifiedDomainUsername);
     }
-
-#ifdef WANT_DEBUG
-    qDebug() << "|  user-permissions: final:" << userPerms;
-#endif
-    return userPerms;
+    return memberships;
 }
 
 void DomainGatekeeper::updateNodePermissions() {
@@ -459,27 +323,35 @@ const QString AUTHENTICATION_PLUGIN_CLIENT_ID = "authentication.plugin_client_id
 const QString MAXIMUM_USER_CAPACITY = "security.maximum_user_capacity";
 const QString MAXIMUM_USER_CAPACITY_REDIRECT_LOCATION = "security.maximum_user_capacity_redirect_location";
 
-SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnectionData& nodeConnection,
-                                                               const QString& username,
-                                                               const QByteArray& usernameSignature,
-                                                               const QString& domainUsername,
-                                                               const QString& domainAccessToken,
-                                                               const QString& domainRefreshToken) {
+void DomainGatekeeper::processAgentConnectRequest(const NodeConnectionData& nodeConnection,
+                                                  const QString& username,
+                                                  const QByteArray& usernameSignature,
+                                                  const QString& domainUsername,
+                                                  const QString& domainAccessToken,
+                                                  const QString& domainRefreshToken,
+                                                  quint64 requestReceiveTime) {
+
+    // agents repeat their connect request until they hear back, don't queue up another one behind the first
+    if (_agentConnectRequestsInFlight.contains(nodeConnection.senderSockAddr)) {
+        return;
+    }
 
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
-    // start with empty permissions
-    NodePermissions userPerms(NodePermissionsKey(username, 0));
-    userPerms.setAll(false);
+    auto request = std::make_shared<AgentConnectRequest>();
+    request->nodeConnection = nodeConnection;
+    request->requestReceiveTime = requestReceiveTime;
+    request->username = username;
+    request->domainUsername = domainUsername;
 
     // check if this user is on our local machine - if this is true set permissions to those for a "localhost" connection
     QHostAddress senderHostAddress = nodeConnection.senderSockAddr.getAddress();
-    bool isLocalUser =
+    request->isLocalUser =
         (senderHostAddress == limitedNodeList->getLocalSockAddr().getAddress() || senderHostAddress == QHostAddress::LocalHost);
 
-    QString verifiedUsername; // if this remains empty, consider this an anonymous connection attempt
     if (!username.isEmpty()) {
-        const QUuid& connectionToken = _connectionTokenHash.value(username.toLower());
+        auto lowerUsername = username.toLower();
+        const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
 
         if (usernameSignature.isEmpty() || connectionToken.isNull()) {
             // user is attempting to prove their identity to us, but we don't have enough information
@@ -492,27 +364,21 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
             qDebug() << "stalling login because we have no username-signature:" << username;
 #endif
             if (!domainHasLogin() || domainUsername.isEmpty()) {
-                return SharedNodePointer();
+                finishConnectRequest(SharedNodePointer(), nodeConnection, username, requestReceiveTime);
+                return;
             }
-        } else if (verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr)) {
-            // they sent us a username and the signature verifies it
-            getGroupMemberships(username);
-            verifiedUsername = username.toLower();
         } else {
-            // they sent us a username, but it didn't check out
-            requestUserPublicKey(username);
-#ifdef WANT_DEBUG
-            qDebug() << "stalling login because signature verification failed:" << username;
-#endif
-            if (!domainHasLogin() || domainUsername.isEmpty()) {
-                return SharedNodePointer();
-            }
+            // the signature itself is checked by the worker, with what we know about the user now
+            KeyFlagPair publicKeyPair = _userPublicKeys.value(lowerUsername);
+            request->usernameSignature = usernameSignature;
+            request->publicKey = publicKeyPair.first;
+            request->isOptimisticKey = publicKeyPair.second;
+            request->connectionToken = connectionToken;
+            request->memberships = membershipsForUser(lowerUsername, QString());
         }
     }
 
     // The domain may have its own users and groups.
-    QString verifiedDomainUsername;
-    QStringList verifiedDomainUserGroups;
     if (domainHasLogin() && !domainUsername.isEmpty()) {
 
         if (domainAccessToken.isEmpty()) {
@@ -520,7 +386,7 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
 #ifdef WANT_DEBUG
             qDebug() << "Stalling login because we have no domain OAuth2 tokens:" << domainUsername;
 #endif
-            return SharedNodePointer();
+            request->isStalledForDomainUser = true;
 
         } else if (needToVerifyDomainUserIdentity(domainUsername, domainAccessToken, domainRefreshToken)) {
             // User's domain identity needs to be confirmed.
@@ -532,21 +398,111 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
         } else if (verifyDomainUserIdentity(domainUsername, domainAccessToken, domainRefreshToken,
                                             nodeConnection.senderSockAddr)) {
             // User's domain identity is confirmed.
-            verifiedDomainUsername = domainUsername;
+            request->verifiedDomainUsername = domainUsername;
+            request->memberships.domainGroups = _domainGroupMemberships.value(domainUsername);
 
         } else {
             // User's domain identity didn't check out.
 #ifdef WANT_DEBUG
             qDebug() << "Stalling login because domain user verification failed:" << domainUsername;
 #endif
-            return SharedNodePointer();
+            request->isStalledForDomainUser = true;
+
+        }
+    }
+
+    if (request->isStalledForDomainUser && request->usernameSignature.isEmpty()) {
+        // there's no signature whose result we need to act on, so there's nothing more to do for now
+        finishConnectRequest(SharedNodePointer(), nodeConnection, username, requestReceiveTime);
+        return;
+    }
+
+    // check the signature and resolve the permissions on the worker for this node, then add it back on this thread
+    _agentConnectRequestsInFlight.insert(nodeConnection.senderSockAddr);
+    auto& settingsManager = _server->_settingsManager;
+    uint shardKey = nodeConnection.connectUUID.isNull() ? qHash(nodeConnection.senderSockAddr, 0)
+                                                        : qHash(nodeConnection.connectUUID);
+    _server->_checkInWorkers->post(shardKey, [this, request, &settingsManager] {
+        verifyAgentConnectRequest(*request, *settingsManager.getPermissionsSnapshot());
+        QMetaObject::invokeMethod(this, [this, request] {
+            _agentConnectRequestsInFlight.remove(request->nodeConnection.senderSockAddr);
+            completeAgentConnectRequest(*request);
+        }, Qt::QueuedConnection);
+    });
+}
 
+void DomainGatekeeper::verifyAgentConnectRequest(AgentConnectRequest& request, const DomainPermissionsSnapshot& permissions) {
+    QString verifiedUsername; // if this remains empty, consider this an anonymous connection attempt
+    if (!request.usernameSignature.isEmpty()) {
+        auto lowerUsername = request.username.toLower();
+        request.signatureCheck = checkUserSignature(lowerUsername, request.usernameSignature, request.publicKey,
+                                                    request.connectionToken);
+        if (request.signatureCheck == SignatureCheck::Verified) {
+            verifiedUsername = lowerUsername;
         }
     }
 
-    userPerms = setPermissionsForUser(isLocalUser, verifiedUsername, verifiedDomainUsername,
-                                      nodeConnection.senderSockAddr.getAddress(), nodeConnection.hardwareAddress,
-                                      nodeConnection.machineFingerprint);
+    const NodeConnectionData& nodeConnection = request.nodeConnection;
+    request.permissions = permissions.permissionsForUser(request.isLocalUser, verifiedUsername, request.verifiedDomainUsername,
+                                                         nodeConnection.senderSockAddr.getAddress(),
+                                                         nodeConnection.hardwareAddress,
+                                                         nodeConnection.machineFingerprint, request.memberships);
+}
+
+void DomainGatekeeper::completeAgentConnectRequest(const AgentConnectRequest& request) {
+    const NodeConnectionData& nodeConnection = request.nodeConnection;
+    const QString& username = request.username;
+
+    switch (request.signatureCheck) {
+        case SignatureCheck::NotChecked:
+            break;
+        case SignatureCheck::Verified:
+            // they sent us a username and the signature verifies it
+            qDebug() << "Username signature matches for" << username;
+            _connectionTokenHash.remove(username);
+            getGroupMemberships(username);
+            break;
+        case SignatureCheck::Mismatch:
+            // we only send back a LoginErrorMetaverse if this wasn't an "optimistic" key
+            // (a key that we hoped would work but is probably stale)
+            if (!request.isOptimisticKey) {
+                qDebug() << "Error decrypting directory services username signature for" << username << "- denying connection.";
+                sendConnectionDeniedPacket("Error decrypting username signature.", nodeConnection.senderSockAddr,
+                    DomainHandler::ConnectionRefusedReason::LoginErrorMetaverse);
+            } else {
+                qDebug() << "Error decrypting directory services username signature for" << username << "with optimistic key -"
+                    << "re-requesting public key and delaying connection";
+            }
+            break;
+        case SignatureCheck::BadKey:
+            // we can't let this user in since we couldn't convert their public key to an RSA key we could use
+            qDebug() << "Couldn't convert data to RSA key for" << username << "- denying connection.";
+            sendConnectionDeniedPacket("Couldn't convert data to RSA key.", nodeConnection.senderSockAddr,
+                DomainHandler::ConnectionRefusedReason::LoginErrorMetaverse);
+            break;
+        case SignatureCheck::MissingData:
+            qDebug() << "Insufficient data to decrypt username signature - delaying connection.";
+            break;
+    }
+
+    if (request.signatureCheck != SignatureCheck::NotChecked && request.signatureCheck != SignatureCheck::Verified) {
+        // they sent us a username, but it didn't check out
+        requestUserPublicKey(username); // no joy.  maybe next time?
+#ifdef WANT_DEBUG
+        qDebug() << "stalling login because signature verification failed:" << username;
+#endif
+        if (!domainHasLogin() || request.domainUsername.isEmpty()) {
+            finishConnectRequest(SharedNodePointer(), nodeConnection, username, request.requestReceiveTime);
+            return;
+        }
+    }
+
+    if (request.isStalledForDomainUser) {
+        finishConnectRequest(SharedNodePointer(), nodeConnection, username, request.requestReceiveTime);
+        return;
+    }
+
+    const NodePermissions& userPerms = request.permissions;
 
     if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
         if (domainHasLogin()) {
@@ -571,7 +527,8 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
 #ifdef WANT_DEBUG
         qDebug() << "stalling login due to permissions:" << username;
 #endif
-        return SharedNodePointer();
+        finishConnectRequest(SharedNodePointer(), nodeConnection, username, request.requestReceiveTime);
+        return;
     }
 
     if (!userPerms.can(NodePermissions::Permission::canConnectPastMaxCapacity) && !isWithinMaxCapacity()) {
@@ -590,9 +547,12 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
 #ifdef WANT_DEBUG
         qDebug() << "stalling login due to max capacity:" << username;
 #endif
-        return SharedNodePointer();
+        finishConnectRequest(SharedNodePointer(), nodeConnection, username, request.requestReceiveTime);
+        return;
     }
 
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
     QUuid existingNodeID;
 
     // in case this is a node that's failing to connect
@@ -645,7 +605,7 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
     qDebug() << "accepting login:" << username;
 #endif
 
-    return newNode;
+    finishConnectRequest(newNode, nodeConnection, username, request.requestReceiveTime);
 }
 
 SharedNodePointer DomainGatekeeper::addVerifiedNodeFromConnectRequest(const NodeConnectionData& nodeConnection) {
@@ -686,85 +646,43 @@ void DomainGatekeeper::cleanupICEPeerForNode(const QUuid& nodeID) {
     }
 }
 
-bool DomainGatekeeper::verifyUserSignature(const QString& username,
-                                           const QByteArray& usernameSignature,
-                                           const SockAddr& senderSockAddr) {
+DomainGatekeeper::SignatureCheck DomainGatekeeper::checkUserSignature(const QString& lowerUsername,
+                                                                      const QByteArray& usernameSignature,
+                                                                      const QByteArray& publicKeyArray,
+                                                                      const QUuid& connectionToken) {
     // it's possible this user can be allowed to connect, but we need to check their username signature
-    auto lowerUsername = username.toLower();
-    KeyFlagPair publicKeyPair = _userPublicKeys.value(lowerUsername);
-
-    QByteArray publicKeyArray = publicKeyPair.first;
-    bool isOptimisticKey = publicKeyPair.second;
-
-    const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
-
-    if (!publicKeyArray.isEmpty() && !connectionToken.isNull()) {
-        // if we do have a public key for the user, check for a signature match
-
-        const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
-
-        OVERTE_IGNORE_DEPRECATED_BEGIN
-
-        // first load up the public key into an RSA struct
-        RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
-
-        QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
-        QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
-                                                                QCryptographicHash::Sha256);
+    if (publicKeyArray.isEmpty() || connectionToken.isNull()) {
+        return SignatureCheck::MissingData;
+    }
 
-        if (rsaPublicKey) {
-            int decryptResult = RSA_verify(NID_sha256,
-                                           reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
-                                           usernameWithToken.size(),
-                                           reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
-                                           usernameSignature.size(),
-                                           rsaPublicKey);
+    // if we do have a public key for the user, check for a signature match
+    const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
 
-            if (decryptResult == 1) {
-                qDebug() << "Username signature matches for" << username;
+    OVERTE_IGNORE_DEPRECATED_BEGIN
 
-                // free up the public key and remove connection token before we return
-                RSA_free(rsaPublicKey);
-                _connectionTokenHash.remove(username);
+    // first load up the public key into an RSA struct
+    RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
+    if (!rsaPublicKey) {
+        return SignatureCheck::BadKey;
+    }
 
-                return true;
+    QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
+    QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
+                                                            QCryptographicHash::Sha256);
 
-            } else {
-                // we only send back a LoginErrorMetaverse if this wasn't an "optimistic" key
-                // (a key that we hoped would work but is probably stale)
-
-                if (!senderSockAddr.isNull() && !isOptimisticKey) {
-                    qDebug() << "Error decrypting directory services username signature for" << username << "- denying connection.";
-                    sendConnectionDeniedPacket("Error decrypting username signature.", senderSockAddr,
-                        DomainHandler::ConnectionRefusedReason::LoginErrorMetaverse);
-                } else if (!senderSockAddr.isNull()) {
-                    qDebug() << "Error decrypting directory services username signature for" << username << "with optimistic key -"
-                        << "re-requesting public key and delaying connection";
-                }
+    int decryptResult = RSA_verify(NID_sha256,
+                                   reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
+                                   usernameWithToken.size(),
+                                   reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
+                                   usernameSignature.size(),
+                                   rsaPublicKey);
 
-                // free up the public key, we don't need it anymore
-                RSA_free(rsaPublicKey);
-            }
+    // free up the public key, we don't need it anymore
+    RSA_free(rsaPublicKey);
 
-            OVERTE_IGNORE_DEPRECATED_END
+    OVERTE_IGNORE_DEPRECATED_END
 
-        } else {
-
-            // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-            if (!senderSockAddr.isNull()) {
-                qDebug() << "Couldn't convert data to RSA key for" << username << "- denying connection.";
-                sendConnectionDeniedPacket("Couldn't convert data to RSA key.", senderSockAddr,
-                    DomainHandler::ConnectionRefusedReason::LoginErrorMetaverse);
-            }
-        }
-    } else {
-        if (!senderSockAddr.isNull()) {
-            qDebug() << "Insufficient data to decrypt username signature - delaying connection.";
-        }
-    }
-
-    requestUserPublicKey(username); // no joy.  maybe next time?
-    return false;
+    return decryptResult == 1 ? SignatureCheck::Verified : SignatureCheck::Mismatch;
 }
 
 
@@ -15,6 +15,7 @@
 #ifndef hifi_DomainGatekeeper_h
 #define hifi_DomainGatekeeper_h
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -28,6 +29,7 @@
 #include <Node.h>
 #include <UUIDHasher.h>
 
+#include "DomainPermissionsSnapshot.h"
 #include "NodeConnectionData.h"
 #include "PendingAssignedNodeData.h"
 
@@ -81,16 +83,48 @@ private slots:
 private:
     SharedNodePointer processAssignmentConnectRequest(const NodeConnectionData& nodeConnection,
                                                       const PendingAssignedNodeData& pendingAssignment);
-    SharedNodePointer processAgentConnectRequest(const NodeConnectionData& nodeConnection,
-                                                 const QString& username,
-                                                 const QByteArray& usernameSignature,
-                                                 const QString& domainUsername,
-                                                 const QString& domainAccessToken,
-                                                 const QString& domainRefreshToken);
+    void processAgentConnectRequest(const NodeConnectionData& nodeConnection,
+                                    const QString& username,
+                                    const QByteArray& usernameSignature,
+                                    const QString& domainUsername,
+                                    const QString& domainAccessToken,
+                                    const QString& domainRefreshToken,
+                                    quint64 requestReceiveTime);
     SharedNodePointer addVerifiedNodeFromConnectRequest(const NodeConnectionData& nodeConnection);
-    
-    bool verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
-                             const SockAddr& senderSockAddr);
+    void finishConnectRequest(const SharedNodePointer& node, const NodeConnectionData& nodeConnection,
+                              const QString& username, quint64 requestReceiveTime);
+
+    enum class SignatureCheck { NotChecked, Verified, Mismatch, BadKey, MissingData };
+
+    // An agent's connect request while its username signature is checked and its permissions resolved, which is
+    // done on the check-in worker for the connecting node rather than on the main thread
+    struct AgentConnectRequest {
+        NodeConnectionData nodeConnection;
+        quint64 requestReceiveTime { 0 };
+        QString username;
+        QString domainUsername;
+        bool isLocalUser { false };
+
+        // gathered on the main thread
+        QByteArray usernameSignature;
+        QByteArray publicKey;
+        bool isOptimisticKey { false };
+        QUuid connectionToken;
+        QString verifiedDomainUsername;
+        bool isStalledForDomainUser { false };
+        DomainPermissionsSnapshot::Memberships memberships;
+
+        // filled in by the worker
+        SignatureCheck signatureCheck { SignatureCheck::NotChecked };
+        NodePermissions permissions;
+    };
+    using AgentConnectRequestPointer = std::shared_ptr<AgentConnectRequest>;
+
+    static void verifyAgentConnectRequest(AgentConnectRequest& request, const DomainPermissionsSnapshot& permissions);
+    void completeAgentConnectRequest(const AgentConnectRequest& request);
+
+    static SignatureCheck checkUserSignature(const QString& lowerUsername, const QByteArray& usernameSignature,
+                                             const QByteArray& publicKey, const QUuid& connectionToken);
     
     bool needToVerifyDomainUserIdentity(const QString& username, const QString& accessToken, const QString& refreshToken);
     bool verifyDomainUserIdentity(const QString& username, const QString& accessToken, const QString& refreshToken,
@@ -135,9 +169,14 @@ private:
     QSet<QString> _domainOwnerFriends; // keep track of friends of the domain owner
     QSet<QString> _inFlightGroupMembershipsRequests; // keep track of which we've already asked for
 
+    // agents whose connect request is with a check-in worker, so that their repeated requests aren't queued up behind it
+    QSet<SockAddr> _agentConnectRequestsInFlight;
+
     NodePermissions setPermissionsForUser(bool isLocalUser, QString verifiedUsername, QString verifiedDomainUsername,
                                           const QHostAddress& senderAddress, const QString& hardwareAddress, 
                                           const QUuid& machineFingerprint);
+    DomainPermissionsSnapshot::Memberships membershipsForUser(const QString& verifiedUsername,
+                                                              const QString& verifiedDomainUsername) const;
 
     void getGroupMemberships(const QString& username);
     // void getIsGroupMember(const QString& username, const QUuid groupID);
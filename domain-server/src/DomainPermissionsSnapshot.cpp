@@ -0,0 +1,215 @@
+//
+//  DomainPermissionsSnapshot.cpp
+//  domain-server/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "DomainPermissionsSnapshot.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QRegularExpression>
+
+void DomainPermissionsSnapshot::copyTable(NodePermissionsMap& source, PermissionsTable& destination) {
+    // the keys of a NodePermissionsMap are already lower-case
+    for (const auto& entry : source.get()) {
+        destination.emplace(entry.first, *entry.second);
+    }
+}
+
+const NodePermissions* DomainPermissionsSnapshot::find(const PermissionsTable& table, const QString& name,
+                                                       const QUuid& rankID) {
+    auto itr = table.find(NodePermissionsKey(name.toLower(), rankID));
+    return itr != table.end() ? &itr->second : nullptr;
+}
+
+NodePermissions DomainPermissionsSnapshot::permissionsOrNone(const PermissionsTable& table, const QString& name,
+                                                             const QUuid& rankID) const {
+    auto permissions = find(table, name, rankID);
+    if (permissions) {
+        return *permissions;
+    }
+    NodePermissions nullPermissions;
+    nullPermissions.setAll(false);
+    return nullPermissions;
+}
+
+NodePermissions DomainPermissionsSnapshot::forbiddensForGroup(const QString& groupName, const QUuid& rankID) const {
+    auto forbiddens = find(_groupForbiddens, groupName, rankID);
+    if (forbiddens) {
+        return *forbiddens;
+    }
+    NodePermissions allForbiddens;
+    allForbiddens.setAll(true);
+    return allForbiddens;
+}
+
+NodePermissions DomainPermissionsSnapshot::permissionsForUser(bool isLocalUser, const QString& verifiedUsername,
+                                                              const QString& verifiedDomainUserName,
+                                                              const QHostAddress& senderAddress,
+                                                              const QString& hardwareAddress,
+                                                              const QUuid& machineFingerprint,
+                                                              const Memberships& memberships) const {
+    NodePermissions userPerms;
+
+    userPerms.setAll(false);
+
+    if (isLocalUser) {
+        userPerms |= permissionsOrNone(_standardAgentPermissions, NodePermissions::standardNameLocalhost.first);
+#ifdef WANT_DEBUG
+        qDebug() << "|  user-permissions: is local user, so:" << userPerms;
+#endif
+    }
+
+    // If this user is a known member of a domain group, give them the implied permissions.
+    // Do before processing verifiedUsername in case user is logged into the Directory Services and is a member of a blocklist group.
+    if (!verifiedDomainUserName.isEmpty()) {
+        foreach (QString userGroup, memberships.domainGroups) {
+            // A domain group is signified by a leading special character, "@".
+            // Multiple domain groups may be specified in one domain server setting as a comma- and/or space-separated lists of
+            // domain group names. For example, "@silver @Gold, @platinum".
+            auto domainGroups = _domainServerGroupNames
+                .filter(QRegularExpression("^(.*[\\s,])?" + QRegularExpression::escape(userGroup) + "([\\s,].*)?$",
+                    QRegularExpression::CaseInsensitiveOption));
+            foreach(QString domainGroup, domainGroups) {
+                userPerms |= permissionsOrNone(_groupPermissions, domainGroup); // No rank for domain groups.
+#ifdef WANT_DEBUG
+                qDebug() << "|  user-permissions: domain user " << verifiedDomainUserName << "is in group:" << domainGroup
+                    << "so:" << userPerms;
+#endif
+            }
+        }
+    }
+
+    auto macPermissions = hardwareAddress.isEmpty() ? nullptr : find(_macPermissions, hardwareAddress);
+    auto machineFingerprintPermissions = find(_machineFingerprintPermissions, machineFingerprint.toString());
+    auto ipPermissions = find(_ipPermissions, senderAddress.toString());
+
+    if (verifiedUsername.isEmpty()) {
+        userPerms |= permissionsOrNone(_standardAgentPermissions, NodePermissions::standardNameAnonymous.first);
+#ifdef WANT_DEBUG
+        qDebug() << "|  user-permissions: unverified or no username for" << userPerms.getID() << ", so:" << userPerms;
+#endif
+        if (macPermissions) {
+            // this user comes from a MAC we have in our permissions table, apply those permissions
+            userPerms = *macPermissions;
+#ifdef WANT_DEBUG
+            qDebug() << "|  user-permissions: specific MAC matches, so:" << userPerms;
+#endif
+        } else if (machineFingerprintPermissions) {
+            userPerms = *machineFingerprintPermissions;
+#ifdef WANT_DEBUG
+            qDebug() << "| user-permissions: specific Machine Fingerprint matches, so: " << userPerms;
+#endif
+        } else if (ipPermissions) {
+            // this user comes from an IP we have in our permissions table, apply those permissions
+            userPerms = *ipPermissions;
+#ifdef WANT_DEBUG
+            qDebug() << "|  user-permissions: specific IP matches, so:" << userPerms;
+#endif
+        }
+    } else {
+        auto namePermissions = find(_agentPermissions, verifiedUsername);
+        if (namePermissions) {
+            userPerms = *namePermissions;
+#ifdef WANT_DEBUG
+            qDebug() << "|  user-permissions: specific user matches, so:" << userPerms;
+#endif
+        } else if (macPermissions) {
+            // this user comes from a MAC we have in our permissions table, apply those permissions
+            userPerms = *macPermissions;
+#ifdef WANT_DEBUG
+            qDebug() << "|  user-permissions: specific MAC matches, so:" << userPerms;
+#endif
+        } else if (machineFingerprintPermissions) {
+            userPerms = *machineFingerprintPermissions;
+#ifdef WANT_DEBUG
+            qDebug() << "| user-permissions: specific Machine Fingerprint matches, so: " << userPerms;
+#endif
+        } else if (ipPermissions) {
+            // this user comes from an IP we have in our permissions table, apply those permissions
+            userPerms = *ipPermissions;
+#ifdef WANT_DEBUG
+            qDebug() << "|  user-permissions: specific IP matches, so:" << userPerms;
+#endif
+        } else {
+            // they are logged into Directory Services, but we don't have specific permissions for them.
+            userPerms |= permissionsOrNone(_standardAgentPermissions, NodePermissions::standardNameLoggedIn.first);
+#ifdef WANT_DEBUG
+            qDebug() << "|  user-permissions: user is logged-into Directory Services, so:" << userPerms;
+#endif
+
+            // if this user is a friend of the domain-owner, give them friend's permissions
+            if (memberships.isDomainOwnerFriend) {
+                userPerms |= permissionsOrNone(_standardAgentPermissions, NodePermissions::standardNameFriends.first);
+#ifdef WANT_DEBUG
+                qDebug() << "|  user-permissions: user is friends with domain-owner, so:" << userPerms;
+#endif
+            }
+
+            // if this user is a known member of a group, give them the implied permissions
+            foreach (QUuid groupID, _groupIDs) {
+                QUuid rankID = memberships.groupRanks.value(groupID);
+                if (rankID != QUuid()) {
+                    auto groupPermissions = _groupPermissionsByUUID.find(GroupByUUIDKey(groupID, rankID));
+                    if (groupPermissions != _groupPermissionsByUUID.end()) {
+                        userPerms |= *groupPermissions;
+                    }
+#ifdef WANT_DEBUG
+                    qDebug() << "|  user-permissions: user " << verifiedUsername << "is in group:" << groupID << " rank:"
+                             << rankID << "so:" << userPerms;
+#endif
+                }
+            }
+
+            // if this user is a known member of a blocklist group, remove the implied permissions
+            foreach (QUuid groupID, _blocklistGroupIDs) {
+                QUuid rankID = memberships.groupRanks.value(groupID);
+                if (rankID != QUuid()) {
+                    auto groupForbiddens = _groupForbiddensByUUID.find(GroupByUUIDKey(groupID, rankID));
+                    if (groupForbiddens != _groupForbiddensByUUID.end()) {
+                        userPerms &= ~NodePermissions(*groupForbiddens);
+                    } else {
+                        userPerms.setAll(false);
+                    }
+#ifdef WANT_DEBUG
+                    qDebug() << "|  user-permissions: user is in blocklist group:" << groupID << " rank:" << rankID
+                             << "so:" << userPerms;
+#endif
+                }
+            }
+        }
+
+        userPerms.setID(verifiedUsername);
+        userPerms.setVerifiedUserName(verifiedUsername);
+    }
+
+    // If this user is a known member of an domain group that is blocklisted, remove the implied permissions.
+    if (!verifiedDomainUserName.isEmpty()) {
+        foreach (QString userGroup, memberships.domainGroups) {
+            // A domain group is signified by a leading special character, "@".
+            // Multiple domain groups may be specified in one domain server setting as a comma- and/or space-separated lists of
+            // domain group names. For example, "@silver @Gold, @platinum".
+            auto domainGroups = _domainServerBlocklistGroupNames
+                .filter(QRegularExpression("^(.*[\\s,])?" + QRegularExpression::escape(userGroup) + "([\\s,].*)?$",
+                    QRegularExpression::CaseInsensitiveOption));
+            foreach(QString domainGroup, domainGroups) {
+                userPerms &= ~forbiddensForGroup(domainGroup, QUuid());
+#ifdef WANT_DEBUG
+                qDebug() << "|  user-permissions: domain user is in blocklist group:" << domainGroup << "so:" << userPerms;
+#endif
+            }
+        }
+
+        userPerms.setVerifiedDomainUserName(verifiedDomainUserName);
+    }
+
+#ifdef WANT_DEBUG
+    qDebug() << "|  user-permissions: final:" << userPerms;
+#endif
+    return userPerms;
+}
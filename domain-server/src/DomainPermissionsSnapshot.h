@@ -0,0 +1,72 @@
+//
+//  DomainPermissionsSnapshot.h
+//  domain-server/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_DomainPermissionsSnapshot_h
+#define hifi_DomainPermissionsSnapshot_h
+
+#include <memory>
+#include <unordered_map>
+
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+#include <QtNetwork/QHostAddress>
+
+#include <NodePermissions.h>
+
+using GroupByUUIDKey = QPair<QUuid, QUuid>; // groupID, rankID
+
+// An immutable copy of the permission tables from the domain-server settings, taken whenever they change.
+// Permissions can be resolved against it from any thread, while the settings manager goes on editing its own tables.
+class DomainPermissionsSnapshot {
+public:
+    using Pointer = std::shared_ptr<const DomainPermissionsSnapshot>;
+
+    // what is known about a user's group memberships at the time their permissions are resolved
+    struct Memberships {
+        QHash<QUuid, QUuid> groupRanks; // group-id -> rank-id, for the directory services user
+        QStringList domainGroups; // for the domain user
+        bool isDomainOwnerFriend { false };
+    };
+
+    NodePermissions permissionsForUser(bool isLocalUser, const QString& verifiedUsername,
+                                       const QString& verifiedDomainUserName, const QHostAddress& senderAddress,
+                                       const QString& hardwareAddress, const QUuid& machineFingerprint,
+                                       const Memberships& memberships) const;
+
+private:
+    using PermissionsTable = std::unordered_map<NodePermissionsKey, NodePermissions>;
+
+    static void copyTable(NodePermissionsMap& source, PermissionsTable& destination);
+    static const NodePermissions* find(const PermissionsTable& table, const QString& name, const QUuid& rankID = QUuid());
+
+    NodePermissions permissionsOrNone(const PermissionsTable& table, const QString& name, const QUuid& rankID = QUuid()) const;
+    NodePermissions forbiddensForGroup(const QString& groupName, const QUuid& rankID) const;
+
+    PermissionsTable _standardAgentPermissions;
+    PermissionsTable _agentPermissions;
+    PermissionsTable _ipPermissions;
+    PermissionsTable _macPermissions;
+    PermissionsTable _machineFingerprintPermissions;
+    PermissionsTable _groupPermissions;
+    PermissionsTable _groupForbiddens;
+    QHash<GroupByUUIDKey, NodePermissions> _groupPermissionsByUUID;
+    QHash<GroupByUUIDKey, NodePermissions> _groupForbiddensByUUID;
+
+    // these are worked out once per snapshot, rather than for every user that connects
+    QList<QUuid> _groupIDs;
+    QList<QUuid> _blocklistGroupIDs;
+    QStringList _domainServerGroupNames;
+    QStringList _domainServerBlocklistGroupNames;
+
+    friend class DomainServerSettingsManager;
+};
+
+#endif // hifi_DomainPermissionsSnapshot_h
@@ -13,6 +13,7 @@
 
 #include "DomainServer.h"
 
+#include <algorithm>
 #include <memory>
 #include <random>
 #include <iostream>
@@ -266,6 +267,12 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     // if permissions are updated, relay the changes to the Node datastructures
     connect(&_settingsManager, &DomainServerSettingsManager::updateNodePermissions,
             &_gatekeeper, &DomainGatekeeper::updateNodePermissions);
+    // after the gatekeeper has updated them, let other nodes know about the new permissions with their next domain list
+    connect(&_settingsManager, &DomainServerSettingsManager::updateNodePermissions, this, [this] {
+        DependencyManager::get<LimitedNodeList>()->eachNode([this](const SharedNodePointer& node) {
+            recordNodeListChange(node);
+        });
+    });
     connect(&_settingsManager, &DomainServerSettingsManager::settingsUpdated,
             this, &DomainServer::updateReplicatedNodes);
     connect(&_settingsManager, &DomainServerSettingsManager::settingsUpdated,
@@ -525,6 +532,9 @@ DomainServer::~DomainServer() {
         delete _httpExporterManager;
     }
 
+    // stop the check-in workers before anything their jobs use goes away
+    _checkInWorkers.reset();
+
     DependencyManager::destroy<AccountManager>();
 
     // cleanup the AssetClient thread
@@ -862,6 +872,8 @@ void DomainServer::setupNodeListAndAssignments() {
         DependencyManager::get<LimitedNodeList>()->putLocalPortIntoSharedMemory(DOMAIN_SERVER_LOCAL_PORT_SMEM_KEY, this, localSockAddr.getPort());
     });
 
+    _checkInWorkers = std::make_unique<DomainCheckInWorkers>();
+
     // register as the packet receiver for the types we want
     PacketReceiver& packetReceiver = nodeList->getPacketReceiver();
     packetReceiver.registerListener(PacketType::RequestAssignment,
@@ -1264,8 +1276,13 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
     // update this node's sockets in case they have changed
+    bool socketsChanged = sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr
+        || sendingNode->getLocalSocket() != nodeRequestData.localSockAddr;
     sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
     sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    if (socketsChanged) {
+        recordNodeListChange(sendingNode);
+    }
 
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
 
@@ -1282,8 +1299,11 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
         safeInterestSet.remove(NodeType::Agent);
     }
 
-    // update the NodeInterestSet in case there have been any changes
-    nodeData->setNodeInterestSet(safeInterestSet);
+    // update the NodeInterestSet in case there have been any changes, the node then needs to hear about all of the nodes
+    if (nodeData->getNodeInterestSet() != safeInterestSet) {
+        nodeData->setNodeInterestSet(safeInterestSet);
+        nodeData->setNeedsFullDomainList(true);
+    }
 
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
@@ -1291,7 +1311,8 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
-    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
+    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false,
+                         nodeRequestData.domainListVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1369,67 +1390,155 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
         newNode->setIsReplicated(true);
     }
 
-    // send out this node to our other connected nodes
+    // send out this node to our other connected nodes, now and with their next domain lists in case they miss it
+    recordNodeListChange(newNode);
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr &senderSockAddr, bool newConnection) {
+void DomainServer::recordNodeListChange(const SharedNodePointer& node, bool isRemoved) {
+    static const size_t MAX_NODE_LIST_CHANGES = 1024;
+
+    _nodeListChanges.push_back({ ++_nodeListVersion, node->getUUID(), node->getType(), isRemoved });
+    if (_nodeListChanges.size() > MAX_NODE_LIST_CHANGES) {
+        _nodeListChanges.pop_front();
+    }
+}
+
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr &senderSockAddr, bool newConnection,
+                                        quint32 domainListVersion) {
+    quint64 startTime = usecTimestampNow();
+
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
         NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
 
-    // setup the extended header for the domain list packets
-    // this data is at the beginning of each of the domain list packets
-    QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
-    QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
-    extendedHeaderStream << limitedNodeList->getSessionUUID();
-    extendedHeaderStream << limitedNodeList->getSessionLocalID();
-    extendedHeaderStream << node->getUUID();
-    extendedHeaderStream << node->getLocalID();
-    extendedHeaderStream << node->getPermissions();
-    extendedHeaderStream << limitedNodeList->getAuthenticatePackets();
-    extendedHeaderStream << nodeData->getLastDomainCheckinTimestamp();
-    extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
-    extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
-    extendedHeaderStream << newConnection;
-    auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
-
-    // always send the node their own UUID back
-    QDataStream domainListStream(domainListPackets.get());
+    // Send the whole list when the node doesn't have one yet, or when the changes since its version are no longer known
+    bool isFullList = newConnection || nodeData->needsFullDomainList() || domainListVersion == 0 ||
+        domainListVersion > _nodeListVersion ||
+        (!_nodeListChanges.empty() && domainListVersion + 1 < _nodeListChanges.front().version);
+    nodeData->setNeedsFullDomainList(false);
+
+    // the nodes to add or update, and the IDs of those to remove
+    std::vector<std::pair<SharedNodePointer, QUuid>> entries;
 
     // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
     auto& nodeInterestSet = nodeData->getNodeInterestSet();
 
-    if (nodeInterestSet.size() > 0) {
-
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
+    // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+    if (nodeInterestSet.size() > 0 && nodeData->isAuthenticated()) {
+        if (isFullList) {
             // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
+            limitedNodeList->eachNode([this, node, &entries](const SharedNodePointer& otherNode) {
                 if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+                    entries.emplace_back(otherNode, otherNode->getUUID());
+                }
+            });
+        } else {
+            // only the last change to each node since the node's version matters
+            QHash<QUuid, const NodeListChange*> lastChanges;
+            auto firstChange = std::upper_bound(_nodeListChanges.begin(), _nodeListChanges.end(), domainListVersion,
+                [](quint32 version, const NodeListChange& change) {
+                    return version < change.version;
+                });
+            for (auto itr = firstChange; itr != _nodeListChanges.end(); ++itr) {
+                lastChanges[itr->nodeUUID] = &(*itr);
+            }
+            for (const auto change : lastChanges) {
+                if (change->nodeUUID == node->getUUID() || !nodeInterestSet.contains(change->nodeType)) {
+                    continue;
+                }
+                auto otherNode = change->isRemoved ? SharedNodePointer() : limitedNodeList->nodeWithUUID(change->nodeUUID);
+                entries.emplace_back(otherNode, change->nodeUUID);
+            }
+        }
+    }
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+    // pack the entries here, where the node list and the connection secrets can be read safely, and leave breaking them
+    // into packets and sending them to the check-in worker for this node
+    std::vector<QByteArray> packedEntries;
+    packedEntries.reserve(entries.size());
+    quint32 entryIndex = 0;
+    for (const auto& entry : entries) {
+        QByteArray packedEntry;
+        QDataStream entryStream(&packedEntry, QIODevice::WriteOnly);
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // entries are numbered so the node can tell when it has all of them, even if they came in separate packets
+        entryStream << entryIndex++;
+        if (entry.first) {
+            // don't send avatar nodes to other avatars, that will come from avatar mixer
+            entryStream << false << *entry.first.data();
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
+            // pack the secret that these two nodes will use to communicate with each other
+            entryStream << connectionSecretForNodes(node, entry.first);
+        } else {
+            entryStream << true << entry.second;
         }
+        packedEntries.push_back(packedEntry);
     }
 
-    // send an empty list to the node, in case there were no other nodes
-    domainListPackets->closeCurrentPacket(true);
+    quint32 nodeListVersion = _nodeListVersion;
+    quint32 baseVersion = isFullList ? (quint32)0 : domainListVersion;
+    NodePermissions permissions = node->getPermissions();
+    quint64 lastDomainCheckinTimestamp = nodeData->getLastDomainCheckinTimestamp();
 
-    // write the PacketList to this node
-    limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
+    // the node's sockets are only written here, on the main thread, so read where to send the list before handing it off
+    if (!node->getActiveSocket()) {
+        qCDebug(domain_server) << "Not sending domain list to" << node->getUUID() << "without an active socket";
+        return;
+    }
+    SockAddr destinationSocket = *node->getActiveSocket();
+    quint64 usecs = usecTimestampNow() - startTime;
+
+    _checkInWorkers->post(qHash(node->getUUID()), [this, node, nodeData, permissions, lastDomainCheckinTimestamp,
+                                                   requestPacketReceiveTime, newConnection, nodeListVersion, baseVersion,
+                                                   isFullList, usecs, destinationSocket,
+                                                   packedEntries = std::move(packedEntries)] {
+        quint64 startTime = usecTimestampNow();
+        auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+        // setup the extended header for the domain list packets
+        // this data is at the beginning of each of the domain list packets
+        QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
+        QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
+
+        extendedHeaderStream << limitedNodeList->getSessionUUID();
+        extendedHeaderStream << limitedNodeList->getSessionLocalID();
+        extendedHeaderStream << node->getUUID();
+        extendedHeaderStream << node->getLocalID();
+        extendedHeaderStream << permissions;
+        extendedHeaderStream << limitedNodeList->getAuthenticatePackets();
+        extendedHeaderStream << lastDomainCheckinTimestamp;
+        extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
+        extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
+        extendedHeaderStream << newConnection;
+        extendedHeaderStream << nodeListVersion;
+        extendedHeaderStream << baseVersion;
+        extendedHeaderStream << (quint32)packedEntries.size();
+        auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
+
+        for (const auto& packedEntry : packedEntries) {
+            // since we're about to add a node to the packet we start a segment
+            domainListPackets->startSegment();
+            domainListPackets->write(packedEntry);
+
+            // we've added the node we wanted so end the segment now
+            domainListPackets->endSegment();
+        }
+
+        // send an empty list to the node, in case there were no other nodes
+        domainListPackets->closeCurrentPacket(true);
+
+        quint64 numBytes = domainListPackets->getDataSize();
+
+        // write the PacketList to this node
+        limitedNodeList->sendPacketList(std::move(domainListPackets), destinationSocket, node->getAuthenticateHash());
+
+        quint64 totalUsecs = usecs + (usecTimestampNow() - startTime);
+        nodeData->getDomainListStats().record(isFullList, numBytes, totalUsecs);
+        _domainListStats.record(isFullList, numBytes, totalUsecs);
+    });
 }
 
 QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -2254,6 +2363,10 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             });
 
             rootJSON["nodes"] = nodesJSONArray;
+            rootJSON["domain_list"] = _domainListStats.toJson();
+            if (_checkInWorkers) {
+                rootJSON["check_in_workers"] = _checkInWorkers->statsObject();
+            }
 
             // print out the created JSON
             QJsonDocument nodesDocument(rootJSON);
@@ -2348,6 +2461,8 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
 
                     // add the node type to the JSON data for output purposes
                     statsObject["node_type"] = NodeType::getNodeTypeName(matchingNode->getType()).toLower().replace(' ', '-');
+                    statsObject["domain_list"] =
+                        static_cast<DomainServerNodeData*>(matchingNode->getLinkedData())->getDomainListStats().toJson();
 
                     QJsonDocument statsDocument(statsObject);
 
@@ -3255,7 +3370,10 @@ void DomainServer::updateReplicatedNodes() {
                 qDebug() << "Setting node to replicated:"
                     << otherNode->getPermissions().getVerifiedUserName() << otherNode->getUUID();
             }
-            otherNode->setIsReplicated(shouldReplicate);
+            if (isReplicated != shouldReplicate) {
+                otherNode->setIsReplicated(shouldReplicate);
+                recordNodeListChange(otherNode);
+            }
         }
     );
 }
@@ -3320,6 +3438,7 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
         }
     }
 
+    recordNodeListChange(node, true);
     broadcastNodeDisconnect(node);
 }
 
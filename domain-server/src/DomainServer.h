@@ -13,6 +13,8 @@
 #ifndef hifi_DomainServer_h
 #define hifi_DomainServer_h
 
+#include <deque>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QHash>
 #include <QtCore/QJsonObject>
@@ -31,6 +33,7 @@
 #include <webrtc/WebRTCSignalingServer.h>
 
 #include "AssetsBackupHandler.h"
+#include "DomainCheckInWorkers.h"
 #include "DomainGatekeeper.h"
 #include "DomainMetadata.h"
 #include "DomainServerSettingsManager.h"
@@ -39,6 +42,7 @@
 
 #include "PendingAssignedNodeData.h"
 #include "DomainServerExporter.h"
+#include "DomainServerNodeData.h"
 
 #include <QLoggingCategory>
 
@@ -189,7 +193,9 @@ private:
     void handleKillNode(SharedNodePointer nodeToKill);
     void broadcastNodeDisconnect(const SharedNodePointer& disconnnectedNode);
 
-    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr& senderSockAddr, bool newConnection);
+    void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr& senderSockAddr, bool newConnection,
+                              quint32 domainListVersion = 0);
+    void recordNodeListChange(const SharedNodePointer& node, bool isRemoved = false);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
 
@@ -250,6 +256,21 @@ private:
 
     std::vector<QString> _replicatedUsernames;
 
+    // Every addition, change and removal of a node that other nodes hear about, numbered with the version of the node list
+    // it leads to, so that check ins can be answered with what changed since the last version the node received all of
+    struct NodeListChange {
+        quint32 version;
+        QUuid nodeUUID;
+        NodeType_t nodeType;
+        bool isRemoved;
+    };
+    std::deque<NodeListChange> _nodeListChanges;
+    quint32 _nodeListVersion { 1 };
+    DomainListStats _domainListStats;
+
+    // connect requests are verified and domain lists are sent on these, sharded by node
+    std::unique_ptr<DomainCheckInWorkers> _checkInWorkers;
+
     DomainGatekeeper _gatekeeper;
     DomainServerExporter _exporter;
 
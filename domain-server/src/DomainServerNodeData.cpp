@@ -23,6 +23,28 @@
 
 DomainServerNodeData::StringPairHash DomainServerNodeData::_overrideHash;
 
+void DomainListStats::record(bool isFullList, quint64 numBytes, quint64 usecs) {
+    if (isFullList) {
+        _numFullLists++;
+    } else {
+        _numDeltaLists++;
+    }
+    _numBytes += numBytes;
+    _usecs += usecs;
+}
+
+QJsonObject DomainListStats::toJson() const {
+    QJsonObject result;
+    quint64 numFullLists = _numFullLists;
+    quint64 numDeltaLists = _numDeltaLists;
+    quint64 numLists = numFullLists + numDeltaLists;
+    result["full_lists"] = (double)numFullLists;
+    result["delta_lists"] = (double)numDeltaLists;
+    result["bytes_per_checkin"] = numLists > 0 ? (double)_numBytes.load() / numLists : 0.0;
+    result["usecs_per_checkin"] = numLists > 0 ? (double)_usecs.load() / numLists : 0.0;
+    return result;
+}
+
 DomainServerNodeData::DomainServerNodeData() {
     _paymentIntervalTimer.start();
 }
@@ -13,6 +13,8 @@
 #ifndef hifi_DomainServerNodeData_h
 #define hifi_DomainServerNodeData_h
 
+#include <atomic>
+
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QHash>
 #include <QtCore/QUuid>
@@ -23,6 +25,20 @@
 #include <NodeData.h>
 #include <NodeType.h>
 
+// What answering check ins with domain lists cost, for one node or the whole domain
+// (recorded by the check-in workers that send the lists, read on the main thread)
+class DomainListStats {
+public:
+    void record(bool isFullList, quint64 numBytes, quint64 usecs);
+    QJsonObject toJson() const;
+
+private:
+    std::atomic<quint64> _numFullLists { 0 };
+    std::atomic<quint64> _numDeltaLists { 0 };
+    std::atomic<quint64> _numBytes { 0 };
+    std::atomic<quint64> _usecs { 0 };
+};
+
 class DomainServerNodeData : public NodeData {
 public:
     DomainServerNodeData();
@@ -73,6 +89,12 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
+
+    // Set when the node has to be sent the whole node list with its next domain list, instead of what changed
+    bool needsFullDomainList() const { return _needsFullDomainList; }
+    void setNeedsFullDomainList(bool needsFullDomainList) { _needsFullDomainList = needsFullDomainList; }
+
+    DomainListStats& getDomainListStats() { return _domainListStats; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -99,6 +121,8 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+    bool _needsFullDomainList { true };
+    DomainListStats _domainListStats;
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -691,6 +691,9 @@ void DomainServerSettingsManager::packPermissions() {
     // save settings for blocklist groups
     packPermissionsForMap("permissions", _groupForbiddens, GROUP_FORBIDDENS_KEYPATH);
 
+    // every change made to the permissions in memory is packed, so this is where connecting nodes get to see it
+    updatePermissionsSnapshot();
+
     persistToFile();
 }
 
@@ -808,6 +811,8 @@ void DomainServerSettingsManager::unpackPermissions() {
 
     if (needPack) {
         packPermissions();
+    } else {
+        updatePermissionsSnapshot();
     }
 
 #ifdef WANT_DEBUG
@@ -839,6 +844,35 @@ void DomainServerSettingsManager::unpackPermissions() {
 
 }
 
+void DomainServerSettingsManager::updatePermissionsSnapshot() {
+    auto snapshot = std::make_shared<DomainPermissionsSnapshot>();
+
+    DomainPermissionsSnapshot::copyTable(_standardAgentPermissions, snapshot->_standardAgentPermissions);
+    DomainPermissionsSnapshot::copyTable(_agentPermissions, snapshot->_agentPermissions);
+    DomainPermissionsSnapshot::copyTable(_ipPermissions, snapshot->_ipPermissions);
+    DomainPermissionsSnapshot::copyTable(_macPermissions, snapshot->_macPermissions);
+    DomainPermissionsSnapshot::copyTable(_machineFingerprintPermissions, snapshot->_machineFingerprintPermissions);
+    DomainPermissionsSnapshot::copyTable(_groupPermissions, snapshot->_groupPermissions);
+    DomainPermissionsSnapshot::copyTable(_groupForbiddens, snapshot->_groupForbiddens);
+
+    // resolve the group-id lookups now, the same way getPermissionsForGroup and getForbiddensForGroup do
+    for (auto itr = _groupPermissionsByUUID.cbegin(); itr != _groupPermissionsByUUID.cend(); ++itr) {
+        NodePermissionsKey groupKey = itr.value()->getKey();
+        snapshot->_groupPermissionsByUUID[itr.key()] = getPermissionsForGroup(groupKey.first, groupKey.second);
+    }
+    for (auto itr = _groupForbiddensByUUID.cbegin(); itr != _groupForbiddensByUUID.cend(); ++itr) {
+        NodePermissionsKey groupKey = itr.value()->getKey();
+        snapshot->_groupForbiddensByUUID[itr.key()] = getForbiddensForGroup(groupKey.first, groupKey.second);
+    }
+
+    snapshot->_groupIDs = getGroupIDs();
+    snapshot->_blocklistGroupIDs = getBlocklistGroupIDs();
+    snapshot->_domainServerGroupNames = getDomainServerGroupNames();
+    snapshot->_domainServerBlocklistGroupNames = getDomainServerBlocklistGroupNames();
+
+    std::atomic_store(&_permissionsSnapshot, DomainPermissionsSnapshot::Pointer(std::move(snapshot)));
+}
+
 bool DomainServerSettingsManager::ensurePermissionsForGroupRanks() {
     // make sure each rank in each group has its own set of permissions
     bool changed = false;
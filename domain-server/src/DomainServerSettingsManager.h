@@ -25,6 +25,7 @@
 #include <ReceivedMessage.h>
 
 #include "DomainGatekeeper.h"
+#include "DomainPermissionsSnapshot.h"
 #include "NodePermissions.h"
 
 const QString SETTINGS_PATHS_KEY = "paths";
@@ -43,8 +44,6 @@ const QString CONTENT_SETTINGS_INSTALLED_CONTENT_CREATION_TIME = "installed_cont
 const QString CONTENT_SETTINGS_INSTALLED_CONTENT_INSTALL_TIME = "installed_content.install_time";
 const QString CONTENT_SETTINGS_INSTALLED_CONTENT_INSTALLED_BY = "installed_content.installed_by";
 
-using GroupByUUIDKey = QPair<QUuid, QUuid>; // groupID, rankID
-
 enum SettingsType {
     DomainSettings,
     ContentSettings
@@ -140,7 +139,12 @@ public:
     QStringList getDomainServerGroupNames();
     QStringList getDomainServerBlocklistGroupNames();
 
+    // an immutable copy of the permission tables above, swapped for a new one whenever they change,
+    // that permissions can be resolved against from any thread
+    DomainPermissionsSnapshot::Pointer getPermissionsSnapshot() const { return std::atomic_load(&_permissionsSnapshot); }
+
     // these are used to locally cache the result of calling "/api/v1/groups/.../is_member/..." on Directory Services api
+    QHash<QUuid, QUuid> getGroupMemberships(const QString& name) const { return _groupMembership.value(name.toLower()); }
     void clearGroupMemberships(const QString& name) { _groupMembership[name.toLower()].clear(); }
     void recordGroupMembership(const QString& name, const QUuid groupID, QUuid rankID);
     QUuid isGroupMember(const QString& name, const QUuid& groupID); // returns rank or -1 if not a member
@@ -232,6 +236,7 @@ private:
     bool unpackPermissionsForKeypath(const QString& keyPath, NodePermissionsMap* destinationMapPointer,
                                      std::function<void(NodePermissionsPointer)> customUnpacker = {});
     bool ensurePermissionsForGroupRanks();
+    void updatePermissionsSnapshot();
 
     NodePermissionsMap _standardAgentPermissions; // anonymous, logged-in, localhost, friend-of-domain-owner
     NodePermissionsMap _agentPermissions; // specific account-names
@@ -255,6 +260,9 @@ private:
     // keep track of answers to api queries about which users are in which groups
     QHash<QString, QHash<QUuid, QUuid>> _groupMembership; // QHash<user-name, QHash<group-id, rank-id>>
 
+    // only ever replaced, with std::atomic_store, never changed in place
+    DomainPermissionsSnapshot::Pointer _permissionsSnapshot { std::make_shared<DomainPermissionsSnapshot>() };
+
     /// guard read/write access from multiple threads to settings
     QReadWriteLock _settingsLock { QReadWriteLock::Recursive };
 
@@ -30,6 +30,7 @@ public:
     SockAddr senderSockAddr;
     QList<NodeType_t> interestList;
     QString placeName;
+    quint32 domainListVersion { 0 }; // the last node list version the node received all of, for list requests
     QString hardwareAddress;
     QUuid machineFingerprint;
     QString SystemInfo;
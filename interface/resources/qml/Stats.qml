@@ -71,6 +71,11 @@ Item {
                     StatText {
                         text: "Physics Object Count: " + root.physicsObjectCount
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "    Owned: " + root.physicsOwnedCount + " (" + root.physicsRestingCount + " resting), " +
+                              root.physicsOmittedProperties.toFixed(1) + "% omitted"
+                    }
                     StatText {
                         visible: root.expanded
                         text: root.gameUpdateStats
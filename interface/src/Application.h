@@ -184,6 +184,9 @@ public:
 
     bool getLogWindowOnTopSetting() { return _keepLogWindowOnTop.get(); }
     void setLogWindowOnTopSetting(bool keepOnTop) { _keepLogWindowOnTop.set(keepOnTop); }
+
+    int getPhysicsSimulationThreads() { return _physicsSimulationThreads.get(); }
+    void setPhysicsSimulationThreads(int numThreads);
     bool getPreferStylusOverLaser() { return _preferStylusOverLaserSetting.get(); }
     void setPreferStylusOverLaser(bool value) { _preferStylusOverLaserSetting.set(value); }
     bool getPreferAvatarFingerOverStylus() { return _preferAvatarFingerOverStylusSetting.get(); }
@@ -333,6 +336,9 @@ public:
     const GameWorkload& getGameWorkload() const { return _gameWorkload; }
 
     float getNumCollisionObjects() const { return _physicsEngine ? _physicsEngine->getNumCollisionObjects() : 0; }
+    PhysicalEntitySimulation::OwnedUpdateStats getOwnedPhysicsUpdateStats() const {
+        return _entitySimulation ? _entitySimulation->getOwnedUpdateStats() : PhysicalEntitySimulation::OwnedUpdateStats();
+    }
     void saveNextPhysicsStats(QString filename) { _physicsEngine->saveNextPhysicsStats(filename); }
 
 
@@ -808,6 +814,7 @@ private:
     Setting::Handle<bool> _darkTheme;
     Setting::Handle<bool> _miniTabletEnabledSetting;
     Setting::Handle<bool> _keepLogWindowOnTop { "keepLogWindowOnTop", false };
+    Setting::Handle<int> _physicsSimulationThreads { "physicsSimulationThreads", 1 };
 
     void updateThemeColors();
 
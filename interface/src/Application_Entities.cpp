@@ -36,6 +36,13 @@ void Application::setMaxOctreePacketsPerSecond(int maxOctreePPS) {
     }
 }
 
+void Application::setPhysicsSimulationThreads(int numThreads) {
+    _physicsSimulationThreads.set(numThreads);
+    if (_physicsEngine) {
+        _physicsEngine->setNumSimulationThreads(numThreads);
+    }
+}
+
 QVector<EntityItemID> Application::pasteEntities(const QString& entityHostType, float x, float y, float z) {
     return _entityClipboard->sendEntities(_entityEditSender.get(), getEntities()->getTree(), entityHostType, x, y, z);
 }
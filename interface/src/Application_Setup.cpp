@@ -96,6 +96,7 @@
 #include <scripting/TestScriptingInterface.h>
 #include <scripting/TTSScriptingInterface.h>
 #include <scripting/WindowScriptingInterface.h>
+#include <ShapeCache.h>
 #include <ShapeEntityItem.h>
 #ifndef Q_OS_ANDROID
 #include <shared/FileLogger.h>
@@ -1335,7 +1336,11 @@ void Application::init() {
 
     getEntities()->init();
 
+    auto shapeCache = std::make_shared<ShapeCache>();
+    shapeCache->initialize();
+    _shapeManager.setShapeCache(shapeCache);
     ObjectMotionState::setShapeManager(&_shapeManager);
+    _physicsEngine->setNumSimulationThreads(_physicsSimulationThreads.get());
     _physicsEngine->init();
 
     EntityTreePointer tree = getEntities()->getTree();
@@ -1577,8 +1582,12 @@ void Application::setupSignalsAndOperators() {
                 return 0.0f;
             }
 
+            // Things we are moving towards load as if we were already a little closer, so they are ready when we get there
+            const float LOADING_LOOKAHEAD = 2.0f; // seconds
             const glm::vec3 itemPosition = item.getWorldPosition();
-            const float distance = glm::distance(getMyAvatar()->getWorldPosition(), itemPosition);
+            const glm::vec3 avatarPosition = getMyAvatar()->getWorldPosition();
+            const glm::vec3 predictedPosition = avatarPosition + LOADING_LOOKAHEAD * getMyAvatar()->getWorldVelocity();
+            const float distance = glm::min(glm::distance(avatarPosition, itemPosition), glm::distance(predictedPosition, itemPosition));
             float result = atan2(maxSize, distance);
             bool isInView = true;
             {
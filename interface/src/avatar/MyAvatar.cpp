@@ -345,6 +345,7 @@ MyAvatar::MyAvatar(QThread* thread) :
     });
 
     static const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+    Frame::registerKeyframeTest(AVATAR_FRAME_TYPE, &AvatarData::isKeyframe);
     Frame::registerFrameHandler(AVATAR_FRAME_TYPE, [=](Frame::ConstPointer frame) {
         static AvatarData dummyAvatar;
         AvatarData::fromFrame(frame->data, dummyAvatar);
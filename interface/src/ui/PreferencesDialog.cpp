@@ -13,6 +13,7 @@
 #include <avatar/AvatarManager.h>
 #include <ScriptEngines.h>
 #include <OffscreenUi.h>
+#include <PhysicsEngine.h>
 #include <Preferences.h>
 #include <plugins/PluginUtils.h>
 #include <plugins/PluginManager.h>
@@ -678,6 +679,18 @@ void setupPreferences() {
         }
     }
 
+    // only builds with USE_BULLET_MULTITHREADING can step physics on more than one thread
+    int maxPhysicsThreads = PhysicsEngine::getMaxNumSimulationThreads();
+    if (maxPhysicsThreads > 1) {
+        static const QString PHYSICS("Physics");
+        auto getter = []()->int { return qApp->getPhysicsSimulationThreads(); };
+        auto setter = [](int value) { qApp->setPhysicsSimulationThreads(value); };
+        auto preference = new IntSpinnerPreference(PHYSICS, "Simulation threads", getter, setter);
+        preference->setMin(1);
+        preference->setMax(maxPhysicsThreads);
+        preferences->addPreference(preference);
+    }
+
     static const QString PLUGIN_CATEGORY{ "Plugins" };
     auto pluginManager = PluginManager::getInstance();
     {
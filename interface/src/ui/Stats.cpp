@@ -127,6 +127,14 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(avatarCount, avatarManager->size() - 1);
     STAT_UPDATE(heroAvatarCount, avatarManager->getNumHeroAvatars());
     STAT_UPDATE(physicsObjectCount, qApp->getNumCollisionObjects());
+    {
+        auto ownedStats = qApp->getOwnedPhysicsUpdateStats();
+        STAT_UPDATE(physicsOwnedCount, (int)ownedStats.numOwned);
+        STAT_UPDATE(physicsRestingCount, (int)ownedStats.numResting);
+        uint64_t numProperties = ownedStats.numDeltaProperties;
+        float omitted = numProperties > 0 ? 100.0f * (float)ownedStats.numPropertiesOmitted / (float)numProperties : 0.0f;
+        STAT_UPDATE_FLOAT(physicsOmittedProperties, omitted, 0.1f);
+    }
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(updatedHeroAvatarCount, avatarManager->getNumHeroAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
@@ -87,6 +87,14 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} physicsObjectCount - The number of objects that have collisions enabled.
  *     <em>Read-only.</em>
+ * @property {number} physicsOwnedCount - The number of objects whose simulation the client owns.
+ *     <em>Read-only.</em>
+ * @property {number} physicsRestingCount - The number of owned objects that are at rest and aren't checked for updates every
+ *     frame.
+ *     <em>Read-only.</em>
+ * @property {number} physicsOmittedProperties - The percentage of transform and velocity properties left out of the
+ *     simulation updates sent by the client, because the entity server already has their values.
+ *     <em>Read-only.</em>
  * @property {number} updatedAvatarCount - The number of avatars in the domain, other than the client's, that were updated in 
  *     the most recent game loop.
  *     <em>Read-only.</em>
@@ -488,6 +496,9 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, uxMode, QString())
     STATS_PROPERTY(int, heroAvatarCount, 0)
     STATS_PROPERTY(int, physicsObjectCount, 0)
+    STATS_PROPERTY(int, physicsOwnedCount, 0)
+    STATS_PROPERTY(int, physicsRestingCount, 0)
+    STATS_PROPERTY(float, physicsOmittedProperties, 0)
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
@@ -802,6 +813,27 @@ signals:
      */
     void physicsObjectCountChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>physicsOwnedCount</code> property changes.
+     * @function Stats.physicsOwnedCountChanged
+     * @returns {Signal}
+     */
+    void physicsOwnedCountChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>physicsRestingCount</code> property changes.
+     * @function Stats.physicsRestingCountChanged
+     * @returns {Signal}
+     */
+    void physicsRestingCountChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>physicsOmittedProperties</code> property changes.
+     * @function Stats.physicsOmittedPropertiesChanged
+     * @returns {Signal}
+     */
+    void physicsOmittedPropertiesChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>updatedAvatarCount</code> property changes.
      * @function Stats.updatedAvatarCountChanged
@@ -681,7 +681,7 @@ QVector<QUuid> Overlays::findOverlays(const glm::vec3& center, float radius) {
         unsigned int searchFilter = PickFilter::getBitMask(PickFilter::FlagBit::LOCAL_ENTITIES);
         // For legacy reasons, this only finds visible objects
         searchFilter = searchFilter | PickFilter::getBitMask(PickFilter::FlagBit::VISIBLE);
-        entityTree->withReadLock([&] {
+        entityTree->withSearchLock([&] {
             entityTree->evalEntitiesInSphere(center, radius, PickFilter(searchFilter), result);
         });
     }
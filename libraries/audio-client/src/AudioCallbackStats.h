@@ -0,0 +1,61 @@
+//
+//  AudioCallbackStats.h
+//  libraries/audio-client/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_AudioCallbackStats_h
+#define hifi_AudioCallbackStats_h
+
+#include <atomic>
+#include <chrono>
+
+#include <QtCore/QtGlobal>
+
+// Times an audio device callback against the audio it produced. A callback that takes longer than its audio takes
+// to play has missed its deadline: sustained, the device runs dry. Updates are lock-free, so they can be made from
+// the callback and read from any other thread.
+class AudioCallbackStats {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static Clock::time_point now() { return Clock::now(); }
+
+    void update(Clock::time_point start, int numFrames, int sampleRate) {
+        quint64 usecs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+        quint64 deadlineUsecs = (sampleRate > 0) ? (quint64)numFrames * 1000000 / sampleRate : 0;
+
+        _numCallbacks.fetch_add(1, std::memory_order_relaxed);
+        if (numFrames > 0 && usecs > deadlineUsecs) {
+            _numDeadlineMisses.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        quint64 maxUsecs = _windowMaxUsecs.load(std::memory_order_relaxed);
+        while (usecs > maxUsecs && !_windowMaxUsecs.compare_exchange_weak(maxUsecs, usecs, std::memory_order_relaxed)) {
+        }
+    }
+
+    void reset() {
+        _numCallbacks.store(0, std::memory_order_relaxed);
+        _numDeadlineMisses.store(0, std::memory_order_relaxed);
+        _windowMaxUsecs.store(0, std::memory_order_relaxed);
+    }
+
+    quint64 getNumCallbacks() const { return _numCallbacks.load(std::memory_order_relaxed); }
+    quint64 getNumDeadlineMisses() const { return _numDeadlineMisses.load(std::memory_order_relaxed); }
+
+    // the longest callback since the previous call, in usecs
+    quint64 takeWindowMaxUsecs() { return _windowMaxUsecs.exchange(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<quint64> _numCallbacks { 0 };
+    std::atomic<quint64> _numDeadlineMisses { 0 };
+    std::atomic<quint64> _windowMaxUsecs { 0 };
+};
+
+#endif // hifi_AudioCallbackStats_h
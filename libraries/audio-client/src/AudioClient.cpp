@@ -200,34 +200,6 @@ QList<HifiAudioDeviceInfo> AudioClient::getAudioDevices(QAudio::Mode mode) const
     }
 }
 
-static void channelUpmix(int16_t* source, int16_t* dest, int numSamples, int numExtraChannels) {
-    for (int i = 0; i < numSamples/2; i++) {
-
-        // read 2 samples
-        int16_t left = *source++;
-        int16_t right = *source++;
-
-        // write 2 + N samples
-        *dest++ = left;
-        *dest++ = right;
-        for (int n = 0; n < numExtraChannels; n++) {
-            *dest++ = 0;
-        }
-    }
-}
-
-static void channelDownmix(int16_t* source, int16_t* dest, int numSamples) {
-    for (int i = 0; i < numSamples/2; i++) {
-
-        // read 2 samples
-        int16_t left = *source++;
-        int16_t right = *source++;
-
-        // write 1 sample
-        *dest++ = (int16_t)((left + right) / 2);
-    }
-}
-
 static bool detectClipping(int16_t* samples, int numSamples, int numChannels) {
 
     const int32_t CLIPPING_THRESHOLD = 32392;   // -0.1 dBFS
@@ -282,43 +254,25 @@ static float computeLoudness(int16_t* samples, int numSamples) {
     return (float)loudness * scale;
 }
 
-template <int NUM_CHANNELS>
-static void applyGainSmoothing(float* buffer, int numFrames, float gain0, float gain1) {
-    
-    // fast path for unity gain
-    if (gain0 == 1.0f && gain1 == 1.0f) {
-        return;
-    }
-
-    // cubic poly from gain0 to gain1
-    float c3 = -2.0f * (gain1 - gain0);
-    float c2 = 3.0f * (gain1 - gain0);
-    float c0 = gain0;
-
-    float t = 0.0f;
-    float tStep = 1.0f / numFrames;
-
-    for (int i = 0; i < numFrames; i++) {
-   
-        // evaluate poly over t=[0,1)
-        float gain = (c3 * t + c2) * t * t + c0;
-        t += tStep;
-
-        // apply gain to all channels
-        for (int ch = 0; ch < NUM_CHANNELS; ch++) {
-            buffer[NUM_CHANNELS*i + ch] *= gain;
-        }
-    }
-}
-
-static inline float convertToFloat(int16_t sample) {
-    return (float)sample * (1 / 32768.0f);
-}
-
 AudioClient::AudioClient() {
 
     // avoid putting a lock in the device callback
-    assert(_localSamplesAvailable.is_lock_free());
+    assert(_localInjectorsAvailable.is_lock_free());
+
+    // the output device reads on the output's thread, and leaves the rest to this one
+    _audioOutputIODevice.setBytesUnplayedGetter([this] {
+        return _audioOutput->bufferSize() - _audioOutput->bytesFree();
+    });
+    _audioOutputIODevice.setReadHandler([this] {
+        _outputWorkerCondition.notify_one();
+    });
+#if defined(WEBRTC_AUDIO)
+    _audioOutputIODevice.setFarEndHandler([this](const int16_t* samples, int numFrames, int sampleRate) {
+        if (_isAECEnabled) {
+            processWebrtcFarEnd(samples, numFrames, OUTPUT_CHANNEL_COUNT, sampleRate);
+        }
+    });
+#endif
 
     // Set up the desired audio format, since scripting API expects it to be set and audio scripting API
     // is initialized before audio thread starts.
@@ -823,6 +777,7 @@ void AudioClient::start() {
 
     // Input was originally set to HifiAudioDeviceInfo(), but that was causing trouble.
     //Original comment: initialize input to the dummy device to prevent starves
+    startOutputWorker();
     switchInputToAudioDevice(defaultAudioDeviceForMode(QAudio::AudioInput, QString()));
     switchOutputToAudioDevice(defaultAudioDeviceForMode(QAudio::AudioOutput, QString())); 
 
@@ -839,6 +794,8 @@ void AudioClient::stop() {
     qCDebug(audioclient) << "AudioClient::stop(), requesting switchOutputToAudioDevice() to shut down";
     switchOutputToAudioDevice(HifiAudioDeviceInfo(), true);
 
+    stopOutputWorker();
+
     // Stop triggering the checks
     QObject::disconnect(_checkPeakValuesTimer, &QTimer::timeout, nullptr, nullptr);
     QObject::disconnect(_checkDevicesTimer, &QTimer::timeout, nullptr, nullptr);
@@ -1355,9 +1312,9 @@ void AudioClient::handleLocalEchoAndReverb(QByteArray& inputByteArray) {
         int16_t* deviceSamples = reinterpret_cast<int16_t*>(deviceByteArray.data());
 
         if (deviceChannelCount > OUTPUT_CHANNEL_COUNT) {
-            channelUpmix(loopbackSamples, deviceSamples, numLoopbackSamples, deviceChannelCount - OUTPUT_CHANNEL_COUNT);
+            AudioOutputIODevice::channelUpmix(loopbackSamples, deviceSamples, numLoopbackSamples, deviceChannelCount - OUTPUT_CHANNEL_COUNT);
         } else {
-            channelDownmix(loopbackSamples, deviceSamples, numLoopbackSamples);
+            AudioOutputIODevice::channelDownmix(loopbackSamples, deviceSamples, numLoopbackSamples);
         }
         _loopbackOutputDevice->write(deviceByteArray);
     }
@@ -1414,20 +1371,31 @@ void AudioClient::handleAudioInput(QByteArray& audioBuffer) {
         auto packetType = _shouldEchoToServer ? PacketType::MicrophoneAudioWithEcho : PacketType::MicrophoneAudioNoEcho;
         if (!audioGateOpen && !closedInLastBlock) {
             packetType = PacketType::SilentAudioFrame;
-            _silentOutbound.increment();
-        } else {
-            _audioOutbound.increment();
         }
 
         Transform audioTransform;
         audioTransform.setTranslation(_positionGetter());
         audioTransform.setRotation(_orientationGetter());
 
+        // a silent packet carries no audio, so there is nothing to encode
         QByteArray encodedBuffer;
-        if (_encoder) {
-            _encoder->encode(audioBuffer, encodedBuffer);
+        if (packetType != PacketType::SilentAudioFrame) {
+            if (_encoder) {
+                _encoder->encode(audioBuffer, encodedBuffer);
+
+                // the codec found the frame silent (Opus DTX in a pause), and has already flushed itself to silence
+                if (_encoder->isLastFrameSilent()) {
+                    packetType = PacketType::SilentAudioFrame;
+                }
+            } else {
+                encodedBuffer = audioBuffer;
+            }
+        }
+
+        if (packetType == PacketType::SilentAudioFrame) {
+            _silentOutbound.increment();
         } else {
-            encodedBuffer = audioBuffer;
+            _audioOutbound.increment();
         }
 
         emitAudioPacket(encodedBuffer.data(), encodedBuffer.size(), _outgoingAvatarAudioSequenceNumber, _isStereoInput,
@@ -1529,26 +1497,49 @@ void AudioClient::handleRecordedAudioInput(const QByteArray& audio) {
     handleAudioInput(audioBuffer);
 }
 
-void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLock) {
-    bool doSynchronously = localAudioLock.operator bool();
-    if (!localAudioLock) {
-        localAudioLock.reset(new Lock(_localAudioMutex));
+void AudioClient::startOutputWorker() {
+    if (_outputWorkerThread.joinable()) {
+        return;
+    }
+    _isOutputWorkerRunning = true;
+    _outputWorkerThread = std::thread([this] { runOutputWorker(); });
+}
+
+void AudioClient::stopOutputWorker() {
+    if (_outputWorkerThread.joinable()) {
+        _isOutputWorkerRunning = false;
+        _outputWorkerCondition.notify_one();
+        _outputWorkerThread.join();
     }
+}
+
+void AudioClient::runOutputWorker() {
+    setThreadName("AudioClient Output Worker");
 
-    int samplesNeeded = std::numeric_limits<int>::max();
-    while (samplesNeeded > 0) {
-        if (!doSynchronously) {
-            // unlock between every write to allow device switching
-            localAudioLock->unlock();
-            localAudioLock->lock();
+    // a wake-up can be missed while the worker is busy, so it never sleeps for more than a fraction of a frame
+    const auto OUTPUT_WORKER_TIMEOUT = std::chrono::microseconds(AudioConstants::NETWORK_FRAME_USECS / 4);
+
+    while (_isOutputWorkerRunning) {
+        {
+            Lock lock(_outputWorkerMutex);
+            _outputWorkerCondition.wait_for(lock, OUTPUT_WORKER_TIMEOUT);
         }
 
-        // in case of a device switch, consider bufferCapacity volatile across iterations
+        prepareLocalAudioInjectors();
+        writeRecordedOutput();
+    }
+}
+
+void AudioClient::prepareLocalAudioInjectors() {
+    while (true) {
+        // lock between every write to allow device switching
+        Lock localAudioLock(_localAudioMutex);
+
+        // in case of a device switch, consider the buffer capacity volatile across iterations
         if (_outputPeriod == 0) {
             return;
         }
 
-        int bufferCapacity = _localInjectorsStream.getSampleCapacity();
         int maxOutputSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * AudioConstants::STEREO;
         if (_localToOutputResampler) {
             maxOutputSamples =
@@ -1556,8 +1547,7 @@ void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLoc
                 AudioConstants::STEREO;
         }
 
-        samplesNeeded = bufferCapacity - _localSamplesAvailable.load(std::memory_order_relaxed);
-        if (samplesNeeded < maxOutputSamples) {
+        if (_localInjectorsStream.spaceAvailable() < maxOutputSamples) {
             // avoid overwriting the buffer to prevent losing frames
             break;
         }
@@ -1572,25 +1562,42 @@ void AudioClient::prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLoc
             _localReverb.render(_localMixBuffer, _localMixBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
         }
 
-        int samples;
         if (_localToOutputResampler) {
             // resample to output sample rate
             int frames = _localToOutputResampler->render(_localMixBuffer, _localOutputMixBuffer,
                 AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
             // write to local injectors' ring buffer
-            samples = frames * AudioConstants::STEREO;
-            _localInjectorsStream.writeSamples(_localOutputMixBuffer, samples);
+            _localInjectorsStream.writeSamples(_localOutputMixBuffer, frames * AudioConstants::STEREO);
 
         } else {
             // write to local injectors' ring buffer
-            samples = AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
-            _localInjectorsStream.writeSamples(_localMixBuffer,
-                AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+            _localInjectorsStream.writeSamples(_localMixBuffer, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
         }
+    }
+}
+
+void AudioClient::writeRecordedOutput() {
+    static const int RECORDING_CHUNK_SAMPLES = 4096;
+    int16_t chunk[RECORDING_CHUNK_SAMPLES];
 
-        _localSamplesAvailable.fetch_add(samples, std::memory_order_release);
-        samplesNeeded -= samples;
+    while (true) {
+        int samples;
+        {
+            // the recording stream is resized with the device, under this lock, but the file is written outside it so
+            // that a slow disk doesn't hold up switching devices or mixing the local injectors
+            Lock localAudioLock(_localAudioMutex);
+            samples = _recordingStream.readSamples(chunk, RECORDING_CHUNK_SAMPLES);
+        }
+        if (samples == 0) {
+            break;
+        }
+
+        // drop what was buffered when the recording stopped
+        Lock lock(_recordMutex);
+        if (_isRecording) {
+            _audioFileWav.addRawAudioChunk((char*)chunk, samples * AudioConstants::SAMPLE_SIZE);
+        }
     }
 }
 
@@ -2129,20 +2136,14 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
     // NOTE: device start() uses the Qt internal device list
     Lock lock(_deviceMutex);
 
-    _localSamplesAvailable.exchange(0, std::memory_order_release);
-
-    //wait on local injectors prep to finish running
-    if ( !_localPrepInjectorFuture.isFinished()) {
-        _localPrepInjectorFuture.waitForFinished();
-    }
-
+    // hold off the output worker, which only touches the device's buffers under this lock
     Lock localAudioLock(_localAudioMutex);
 
     // cleanup any previously initialized device
     if (_audioOutput) {
         _audioOutputIODevice.close();
         _audioOutput->stop();
-        _audioOutputInitialized = false;
+        _audioOutputIODevice.deconfigure();
 
         //must be deleted in next eventloop cycle when its called from notify()
         _audioOutput->deleteLater();
@@ -2153,14 +2154,10 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
         _loopbackAudioOutput->deleteLater();
         _loopbackAudioOutput = NULL;
 
-        delete[] _outputMixBuffer;
-        _outputMixBuffer = NULL;
-
-        delete[] _outputScratchBuffer;
-        _outputScratchBuffer = NULL;
-
         delete[] _localOutputMixBuffer;
         _localOutputMixBuffer = NULL;
+
+        _outputPeriod = 0;
         
         _outputDeviceInfo.setDevice(QAudioDeviceInfo());
     }
@@ -2235,9 +2232,6 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
             // device callback may exceed reported period, so double it to avoid stutter
             _outputPeriod *= 2;
 
-            _outputMixBuffer = new float[_outputPeriod];
-            _outputScratchBuffer = new int16_t[_outputPeriod];
-
             // size local output mix buffer based on resampled network frame size
             int networkPeriod = _localToOutputResampler ?  _localToOutputResampler->getMaxOutput(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO) : AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
             _localOutputMixBuffer = new float[networkPeriod];
@@ -2248,9 +2242,12 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
             // round up to an exact multiple of networkPeriod
             localPeriod = ((localPeriod + networkPeriod - 1) / networkPeriod) * networkPeriod;
             // this ensures lowest latency without stutter from underrun
-            _localInjectorsStream.resizeForFrameSize(localPeriod);
+            _localInjectorsStream.resize(localPeriod);
+
+            // buffer a second of recorded output, for the worker to write to file
+            _recordingStream.resize(_outputFormat.sampleRate() * deviceChannelCount);
 
-            _audioOutputInitialized = true;
+            _audioOutputIODevice.configure(_outputFormat, _outputPeriod);
 
             int bufferSize = _audioOutput->bufferSize();
             int bufferSamples = bufferSize / AudioConstants::SAMPLE_SIZE;
@@ -2263,7 +2260,6 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
             qCDebug(audioclient) << "period (samples):" << _outputPeriod;
             qCDebug(audioclient) << "local buffer (samples):" << localPeriod;
 
-            // unlock to avoid a deadlock with the device callback (which always succeeds this initialization)
             localAudioLock.unlock();
 
             // setup a loopback audio output device
@@ -2361,121 +2357,8 @@ float AudioClient::gainForSource(float distance, float volume) {
     return gain;
 }
 
-qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
-
-    // lock-free wait for initialization to avoid races
-    if (!_audio->_audioOutputInitialized.load(std::memory_order_acquire)) {
-        memset(data, 0, maxSize);
-        return maxSize;
-    }
-
-    // max samples requested from OUTPUT_CHANNEL_COUNT
-    int deviceChannelCount = _audio->_outputFormat.channelCount();
-    int maxSamplesRequested = (int)(maxSize / AudioConstants::SAMPLE_SIZE) * OUTPUT_CHANNEL_COUNT / deviceChannelCount;
-    // restrict samplesRequested to the size of our mix/scratch buffers
-    maxSamplesRequested = std::min(maxSamplesRequested, _audio->_outputPeriod);
-
-    int16_t* scratchBuffer = _audio->_outputScratchBuffer;
-    float* mixBuffer = _audio->_outputMixBuffer;
-
-    int samplesRequested = maxSamplesRequested;
-    int networkSamplesPopped;
-    if ((networkSamplesPopped = _receivedAudioStream.popSamples(samplesRequested, false)) > 0) {
-        qCDebug(audiostream, "Read %d samples from buffer (%d available, %d requested)", networkSamplesPopped, _receivedAudioStream.getSamplesAvailable(), samplesRequested);
-        AudioRingBuffer::ConstIterator lastPopOutput = _receivedAudioStream.getLastPopOutput();
-        lastPopOutput.readSamples(scratchBuffer, networkSamplesPopped);
-        for (int i = 0; i < networkSamplesPopped; i++) {
-            mixBuffer[i] = convertToFloat(scratchBuffer[i]);
-        }
-        samplesRequested = networkSamplesPopped;
-    }
-
-    int injectorSamplesPopped = 0;
-    {
-        bool append = networkSamplesPopped > 0;
-        // check the samples we have available locklessly; this is possible because only two functions add to the count:
-        // - prepareLocalAudioInjectors will only increase samples count
-        // - switchOutputToAudioDevice will zero samples count,
-        //   stop the device - so that readData will exhaust the existing buffer or see a zeroed samples count,
-        //   and start the device - which can then only see a zeroed samples count
-        int samplesAvailable = _audio->_localSamplesAvailable.load(std::memory_order_acquire);
-
-        // if we do not have enough samples buffered despite having injectors, buffer them synchronously
-        if (samplesAvailable < samplesRequested && _audio->_localInjectorsAvailable.load(std::memory_order_acquire)) {
-            // try_to_lock, in case the device is being shut down already
-            std::unique_ptr<Lock> localAudioLock(new Lock(_audio->_localAudioMutex, std::try_to_lock));
-            if (localAudioLock->owns_lock()) {
-                _audio->prepareLocalAudioInjectors(std::move(localAudioLock));
-                samplesAvailable = _audio->_localSamplesAvailable.load(std::memory_order_acquire);
-            }
-        }
-
-        samplesRequested = std::min(samplesRequested, samplesAvailable);
-        if ((injectorSamplesPopped = _localInjectorsStream.appendSamples(mixBuffer, samplesRequested, append)) > 0) {
-            _audio->_localSamplesAvailable.fetch_sub(injectorSamplesPopped, std::memory_order_release);
-            qCDebug(audiostream, "Read %d samples from injectors (%d available, %d requested)", injectorSamplesPopped, _localInjectorsStream.samplesAvailable(), samplesRequested);
-        }
-    }
-    
-    // prepare injectors for the next callback
-     _audio->_localPrepInjectorFuture = QtConcurrent::run(QThreadPool::globalInstance(), [this] {
-        _audio->prepareLocalAudioInjectors();
-    });
-
-    int samplesPopped = std::max(networkSamplesPopped, injectorSamplesPopped);
-    if (samplesPopped == 0) {
-        // nothing on network, don't grab anything from injectors, and fill with silence
-        samplesPopped = maxSamplesRequested;
-        memset(mixBuffer, 0, samplesPopped * sizeof(float));
-    }
-    int framesPopped = samplesPopped / OUTPUT_CHANNEL_COUNT;
-
-    // apply output gain
-    float newGain = _audio->_outputGain.load(std::memory_order_acquire);
-    float oldGain = _audio->_lastOutputGain;
-    _audio->_lastOutputGain = newGain;
-
-    applyGainSmoothing<OUTPUT_CHANNEL_COUNT>(mixBuffer, framesPopped, oldGain, newGain);
-
-    // limit the audio
-    _audio->_audioLimiter.render(mixBuffer, scratchBuffer, framesPopped);
-
-#if defined(WEBRTC_AUDIO)
-    if (_audio->_isAECEnabled) {
-        _audio->processWebrtcFarEnd(scratchBuffer, framesPopped, OUTPUT_CHANNEL_COUNT, _audio->_outputFormat.sampleRate());
-    }
-#endif
-
-    // if required, upmix or downmix to deviceChannelCount
-    if (deviceChannelCount == OUTPUT_CHANNEL_COUNT) {
-        memcpy(data, scratchBuffer, samplesPopped * AudioConstants::SAMPLE_SIZE);
-    } else if (deviceChannelCount > OUTPUT_CHANNEL_COUNT) {
-        int extraChannels = deviceChannelCount - OUTPUT_CHANNEL_COUNT;
-        channelUpmix(scratchBuffer, (int16_t*)data, samplesPopped, extraChannels);
-    } else {
-        channelDownmix(scratchBuffer, (int16_t*)data, samplesPopped);
-    }
-    int bytesWritten = framesPopped * AudioConstants::SAMPLE_SIZE * deviceChannelCount;
-    assert(bytesWritten <= maxSize);
-
-    // send output buffer for recording
-    if (_audio->_isRecording) {
-        Lock lock(_recordMutex);
-        _audio->_audioFileWav.addRawAudioChunk(data, bytesWritten);
-    }
-
-    int bytesAudioOutputUnplayed = _audio->_audioOutput->bufferSize() - _audio->_audioOutput->bytesFree();
-    float msecsAudioOutputUnplayed = bytesAudioOutputUnplayed / (float)_audio->_outputFormat.bytesForDuration(USECS_PER_MSEC);
-    _audio->_stats.updateOutputMsUnplayed(msecsAudioOutputUnplayed);
-
-    if (bytesAudioOutputUnplayed == 0) {
-        _unfulfilledReads++;
-    }
-
-    return bytesWritten;
-}
-
 bool AudioClient::startRecording(const QString& filepath) {
+    Lock lock(_recordMutex);
     if (!_audioFileWav.create(_outputFormat, filepath)) {
         qDebug() << "Error creating audio file: " + filepath;
         return false;
@@ -2485,6 +2368,7 @@ bool AudioClient::startRecording(const QString& filepath) {
 }
 
 void AudioClient::stopRecording() {
+    Lock lock(_recordMutex);
     if (_isRecording) {
         _isRecording = false;
         _audioFileWav.close();
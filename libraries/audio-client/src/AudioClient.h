@@ -13,13 +13,14 @@
 #ifndef hifi_AudioClient_h
 #define hifi_AudioClient_h
 
+#include <condition_variable>
 #include <fstream>
 #include <memory>
 #include <vector>
 #include <mutex>
 #include <queue>
+#include <thread>
 
-#include <QFuture>
 #include <QtCore/QtGlobal>
 #include <QtCore/QByteArray>
 #include <QtCore/QElapsedTimer>
@@ -47,6 +48,7 @@
 #include <AudioInjector.h>
 #include <AudioReverb.h>
 #include <AudioLimiter.h>
+#include <AudioSPSCRingBuffer.h>
 #include <AudioConstants.h>
 #include <AudioGate.h>
 
@@ -55,6 +57,7 @@
 #include <plugins/CodecPlugin.h>
 
 #include "AudioIOStats.h"
+#include "AudioOutputIODevice.h"
 #include "AudioFileWav.h"
 #include "HifiAudioDeviceInfo.h"
 
@@ -96,7 +99,8 @@ class AudioClient : public AbstractAudioInterface, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
 
-    using LocalInjectorsStream = AudioMixRingBuffer;
+    using LocalInjectorsStream = AudioOutputIODevice::LocalInjectorsStream;
+    using RecordingStream = AudioOutputIODevice::RecordingStream;
 public:
     static const int MIN_BUFFER_FRAMES;
     static const int MAX_BUFFER_FRAMES;
@@ -107,24 +111,6 @@ public:
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
 
-    class AudioOutputIODevice : public QIODevice {
-    public:
-        AudioOutputIODevice(LocalInjectorsStream& localInjectorsStream, MixedProcessedAudioStream& receivedAudioStream,
-                AudioClient* audio) :
-            _localInjectorsStream(localInjectorsStream), _receivedAudioStream(receivedAudioStream),
-            _audio(audio), _unfulfilledReads(0) {}
-
-        void start() { open(QIODevice::ReadOnly | QIODevice::Unbuffered); }
-        qint64 readData(char* data, qint64 maxSize) override;
-        qint64 writeData(const char* data, qint64 maxSize) override { return 0; }
-        int getRecentUnfulfilledReads() { int unfulfilledReads = _unfulfilledReads; _unfulfilledReads = 0; return unfulfilledReads; }
-    private:
-        LocalInjectorsStream& _localInjectorsStream;
-        MixedProcessedAudioStream& _receivedAudioStream;
-        AudioClient* _audio;
-        int _unfulfilledReads;
-    };
-    
     void startThread();
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
@@ -267,7 +253,7 @@ public slots:
 
     void setLocalInjectorGain(float gain) { _localInjectorGain = gain; };
     void setSystemInjectorGain(float gain) { _systemInjectorGain = gain; };
-    void setOutputGain(float gain) { _outputGain = gain; };
+    void setOutputGain(float gain) { _audioOutputIODevice.setOutputGain(gain); };
 
     void outputNotify();
     void noteAwakening();
@@ -324,7 +310,6 @@ private:
     static const AudioOrientationGetter DEFAULT_ORIENTATION_GETTER;
 
     friend class CheckDevicesThread;
-    friend class LocalInjectorsThread;
 
     float loudnessToLevel(float loudness);
 
@@ -334,7 +319,8 @@ private:
 
     void outputFormatChanged();
     void handleAudioInput(QByteArray& audioBuffer);
-    void prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLock = nullptr);
+    void prepareLocalAudioInjectors();
+    void writeRecordedOutput();
     bool mixLocalAudioInjectors(float* mixBuffer);
     float azimuthForSource(const glm::vec3& relativePosition);
     float gainForSource(float distance, float volume);
@@ -379,7 +365,6 @@ private:
     QIODevice* _inputDevice{ nullptr };
     int _numInputCallbackBytes{ 0 };
     QAudioOutput* _audioOutput{ nullptr };
-    std::atomic<bool> _audioOutputInitialized { false };
     QAudioFormat _desiredOutputFormat;
     QAudioFormat _outputFormat;
     int _outputFrameSize{ 0 };
@@ -387,11 +372,11 @@ private:
     QAudioOutput* _loopbackAudioOutput{ nullptr };
     QIODevice* _loopbackOutputDevice{ nullptr };
     AudioRingBuffer _inputRingBuffer{ 0 };
-    LocalInjectorsStream _localInjectorsStream{ 0 , 1 };
-    // In order to use _localInjectorsStream as a lock-free pipe,
-    // use it with a single producer/consumer, and track available samples and injectors
-    std::atomic<int> _localSamplesAvailable { 0 };
+    // written by the output worker, read by the device callback
+    LocalInjectorsStream _localInjectorsStream;
     std::atomic<bool> _localInjectorsAvailable { false };
+    // written by the device callback, read by the output worker
+    RecordingStream _recordingStream;
     MixedProcessedAudioStream _receivedAudioStream{ RECEIVED_AUDIO_STREAM_CAPACITY_FRAMES };
     bool _isStereoInput{ false };
     std::atomic<bool> _enablePeakValues { false };
@@ -439,10 +424,6 @@ private:
 
     // for output audio (used by this thread)
     int _outputPeriod { 0 };
-    float* _outputMixBuffer { NULL };
-    int16_t* _outputScratchBuffer { NULL };
-    std::atomic<float> _outputGain { 1.0f };
-    float _lastOutputGain { 1.0f };
 
     // for local audio (used by audio injectors thread)
     std::atomic<float> _localInjectorGain { 1.0f };
@@ -451,7 +432,16 @@ private:
     int16_t _localScratchBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
     float* _localOutputMixBuffer { NULL };
     Mutex _localAudioMutex;
-    AudioLimiter _audioLimiter{ AudioConstants::SAMPLE_RATE, OUTPUT_CHANNEL_COUNT };
+
+    // The device callback must not lock or allocate, so it leaves mixing local injectors and writing recordings to
+    // this thread, and wakes it after every read. The timeout covers a wake-up that arrives before it waits.
+    void startOutputWorker();
+    void stopOutputWorker();
+    void runOutputWorker();
+    std::thread _outputWorkerThread;
+    Mutex _outputWorkerMutex;
+    std::condition_variable _outputWorkerCondition;
+    std::atomic<bool> _isOutputWorkerRunning { false };
 
     // Adds Reverb
     void configureReverb();
@@ -482,7 +472,7 @@ private:
 
     quint16 _outgoingAvatarAudioSequenceNumber{ 0 };
 
-    AudioOutputIODevice _audioOutputIODevice{ _localInjectorsStream, _receivedAudioStream, this };
+    AudioOutputIODevice _audioOutputIODevice{ _localInjectorsStream, _receivedAudioStream, _recordingStream, _isRecording, _stats };
 
     AudioIOStats _stats{ &_receivedAudioStream };
 
@@ -528,14 +518,13 @@ private:
 
     AudioSolo _solo;
     
-    QFuture<void> _localPrepInjectorFuture;
     QReadWriteLock _hmdNameLock;
     Mutex _checkDevicesMutex;
     QTimer* _checkDevicesTimer { nullptr };
     Mutex _checkPeakValuesMutex;
     QTimer* _checkPeakValuesTimer { nullptr };
 
-    bool _isRecording { false };
+    std::atomic<bool> _isRecording { false };
 };
 
 
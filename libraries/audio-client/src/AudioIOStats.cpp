@@ -45,8 +45,10 @@ void AudioIOStats::reset() {
     _inputMsUnplayed.reset();
     _outputMsUnplayed.reset();
     _packetTimegaps.reset();
+    _outputCallbacks.reset();
 
     _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
+    _interface->updateOutputCallbacks(_outputCallbacks);
     _interface->updateMixerStream(AudioStreamStats());
     _interface->updateClientStream(AudioStreamStats());
     _interface->updateInjectorStreams(QHash<QUuid, AudioStreamStats>());
@@ -110,6 +112,7 @@ void AudioIOStats::publish() {
 
     // update the interface
     _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
+    _interface->updateOutputCallbacks(_outputCallbacks);
     _interface->updateClientStream(stats);
 
     // prepare a packet to the mixer
@@ -180,6 +183,11 @@ void AudioStatsInterface::updateLocalBuffers(const MovingMinMaxAvg<float>& input
     sentTimegapMsAvgWindow(timegaps.getWindowAverage() / USECS_PER_MSEC);
 }
 
+void AudioStatsInterface::updateOutputCallbacks(AudioCallbackStats& outputCallbacks) {
+    outputCallbackMsMax(outputCallbacks.takeWindowMaxUsecs() / (float)USECS_PER_MSEC);
+    outputDeadlineMisses(outputCallbacks.getNumDeadlineMisses());
+}
+
 void AudioStatsInterface::updateInjectorStreams(const QHash<QUuid, AudioStreamStats>& stats) {
     // Get existing injectors
     auto injectorIds = _injectors->dynamicPropertyNames();
@@ -12,6 +12,7 @@
 #ifndef hifi_AudioIOStats_h
 #define hifi_AudioIOStats_h
 
+#include "AudioCallbackStats.h"
 #include "MovingMinMaxAvg.h"
 
 #include <QObject>
@@ -255,6 +256,11 @@ class AudioStatsInterface : public QObject {
      * @property {number} outputUnplayedMsMax - The maximum duration of output audio recently in the output buffer waiting to 
      *     be played, in ms.
      *     <em>Read-only.</em>
+     * @property {number} outputCallbackMsMax - The maximum time recently taken to produce a block of output audio for the 
+     *     audio device, in ms.
+     *     <em>Read-only.</em>
+     * @property {number} outputDeadlineMisses - The number of blocks of output audio that took longer to produce than to play.
+     *     <em>Read-only.</em>
      * @property {number} pingMs - The current ping time to the audio mixer, in ms.
      *     <em>Read-only.</em>
      * @property {number} sentTimegapMsAvg - The overall average time between sending data packets to the audio mixer, in ms.
@@ -304,6 +310,22 @@ class AudioStatsInterface : public QObject {
      */
     AUDIO_PROPERTY(float, outputUnplayedMsMax);
 
+    /*@jsdoc
+     * Triggered when the maximum time recently taken to produce a block of output audio for the audio device changes.
+     * @function AudioStats.outputCallbackMsMaxChanged
+     * @param {number} outputCallbackMsMax - The maximum time recently taken to produce a block of output audio for the audio 
+     *     device, in ms.
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(float, outputCallbackMsMax);
+
+    /*@jsdoc
+     * Triggered when the number of blocks of output audio that took longer to produce than to play changes.
+     * @function AudioStats.outputDeadlineMissesChanged
+     * @param {number} outputDeadlineMisses - The number of blocks of output audio that took longer to produce than to play.
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(quint64, outputDeadlineMisses);
 
     /*@jsdoc
      * Triggered when the overall maximum time between sending data packets to the audio mixer changes.
@@ -353,6 +375,7 @@ public:
                             const MovingMinMaxAvg<float>& inputMsUnplayed,
                             const MovingMinMaxAvg<float>& outputMsUnplayed,
                             const MovingMinMaxAvg<quint64>& timegaps);
+    void updateOutputCallbacks(AudioCallbackStats& outputCallbacks);
     void updateMixerStream(const AudioStreamStats& stats) { _mixer->updateStream(stats); emit mixerStreamChanged(); }
     void updateClientStream(const AudioStreamStats& stats) { _client->updateStream(stats); emit clientStreamChanged(); }
     void updateInjectorStreams(const QHash<QUuid, AudioStreamStats>& stats);
@@ -401,6 +424,10 @@ public:
     void updateInputMsRead(float ms) const { _inputMsRead.update(ms); }
     void updateInputMsUnplayed(float ms) const { _inputMsUnplayed.update(ms); }
     void updateOutputMsUnplayed(float ms) const { _outputMsUnplayed.update(ms); }
+    void updateOutputCallback(AudioCallbackStats::Clock::time_point start, int numFrames, int sampleRate) const {
+        _outputCallbacks.update(start, numFrames, sampleRate);
+    }
+    const AudioCallbackStats& getOutputCallbacks() const { return _outputCallbacks; }
     void sentPacket() const;
 
     void publish();
@@ -414,6 +441,7 @@ private:
     mutable MovingMinMaxAvg<float> _inputMsRead;
     mutable MovingMinMaxAvg<float> _inputMsUnplayed;
     mutable MovingMinMaxAvg<float> _outputMsUnplayed;
+    mutable AudioCallbackStats _outputCallbacks;
 
     mutable quint64 _lastSentPacketTime;
     mutable MovingMinMaxAvg<quint64> _packetTimegaps;
@@ -0,0 +1,209 @@
+//
+//  AudioOutputIODevice.cpp
+//  libraries/audio-client/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AudioOutputIODevice.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include <NumericalConstants.h>
+
+#include "AudioLogging.h"
+
+template <int NUM_CHANNELS>
+static void applyGainSmoothing(float* buffer, int numFrames, float gain0, float gain1) {
+
+    // fast path for unity gain
+    if (gain0 == 1.0f && gain1 == 1.0f) {
+        return;
+    }
+
+    // cubic poly from gain0 to gain1
+    float c3 = -2.0f * (gain1 - gain0);
+    float c2 = 3.0f * (gain1 - gain0);
+    float c0 = gain0;
+
+    float t = 0.0f;
+    float tStep = 1.0f / numFrames;
+
+    for (int i = 0; i < numFrames; i++) {
+
+        // evaluate poly over t=[0,1)
+        float gain = (c3 * t + c2) * t * t + c0;
+        t += tStep;
+
+        // apply gain to all channels
+        for (int ch = 0; ch < NUM_CHANNELS; ch++) {
+            buffer[NUM_CHANNELS*i + ch] *= gain;
+        }
+    }
+}
+
+static inline float convertToFloat(int16_t sample) {
+    return (float)sample * (1 / 32768.0f);
+}
+
+void AudioOutputIODevice::channelUpmix(int16_t* source, int16_t* dest, int numSamples, int numExtraChannels) {
+    for (int i = 0; i < numSamples/2; i++) {
+
+        // read 2 samples
+        int16_t left = *source++;
+        int16_t right = *source++;
+
+        // write 2 + N samples
+        *dest++ = left;
+        *dest++ = right;
+        for (int n = 0; n < numExtraChannels; n++) {
+            *dest++ = 0;
+        }
+    }
+}
+
+void AudioOutputIODevice::channelDownmix(int16_t* source, int16_t* dest, int numSamples) {
+    for (int i = 0; i < numSamples/2; i++) {
+
+        // read 2 samples
+        int16_t left = *source++;
+        int16_t right = *source++;
+
+        // write 1 sample
+        *dest++ = (int16_t)((left + right) / 2);
+    }
+}
+
+AudioOutputIODevice::AudioOutputIODevice(LocalInjectorsStream& localInjectorsStream,
+                                         MixedProcessedAudioStream& receivedAudioStream, RecordingStream& recordingStream,
+                                         const std::atomic<bool>& isRecording, const AudioIOStats& stats) :
+    _localInjectorsStream(localInjectorsStream),
+    _receivedAudioStream(receivedAudioStream),
+    _recordingStream(recordingStream),
+    _isRecording(isRecording),
+    _stats(stats) {
+
+    // avoid putting a lock in the device callback
+    assert(_outputGain.is_lock_free());
+}
+
+void AudioOutputIODevice::configure(const QAudioFormat& format, int maxSamples) {
+    _isConfigured.store(false, std::memory_order_release);
+    _format = format;
+    _maxSamples = maxSamples;
+    _mixBuffer.reset(new float[maxSamples]);
+    _scratchBuffer.reset(new int16_t[maxSamples]);
+    _isConfigured.store(true, std::memory_order_release);
+}
+
+void AudioOutputIODevice::deconfigure() {
+    _isConfigured.store(false, std::memory_order_release);
+    _mixBuffer.reset();
+    _scratchBuffer.reset();
+    _maxSamples = 0;
+}
+
+qint64 AudioOutputIODevice::readData(char * data, qint64 maxSize) {
+
+    // lock-free wait for initialization to avoid races
+    if (!_isConfigured.load(std::memory_order_acquire)) {
+        memset(data, 0, maxSize);
+        return maxSize;
+    }
+
+    // nothing from here on may lock or allocate
+    auto callbackStart = AudioCallbackStats::now();
+
+    // max samples requested from OUTPUT_CHANNEL_COUNT
+    int deviceChannelCount = _format.channelCount();
+    int maxSamplesRequested = (int)(maxSize / AudioConstants::SAMPLE_SIZE) * OUTPUT_CHANNEL_COUNT / deviceChannelCount;
+    // restrict samplesRequested to the size of our mix/scratch buffers
+    maxSamplesRequested = std::min(maxSamplesRequested, _maxSamples);
+
+    int16_t* scratchBuffer = _scratchBuffer.get();
+    float* mixBuffer = _mixBuffer.get();
+
+    int samplesRequested = maxSamplesRequested;
+    int networkSamplesPopped;
+    if ((networkSamplesPopped = _receivedAudioStream.popSamples(samplesRequested, false)) > 0) {
+        qCDebug(audiostream, "Read %d samples from buffer (%d available, %d requested)", networkSamplesPopped, _receivedAudioStream.getSamplesAvailable(), samplesRequested);
+        AudioRingBuffer::ConstIterator lastPopOutput = _receivedAudioStream.getLastPopOutput();
+        lastPopOutput.readSamples(scratchBuffer, networkSamplesPopped);
+        for (int i = 0; i < networkSamplesPopped; i++) {
+            mixBuffer[i] = convertToFloat(scratchBuffer[i]);
+        }
+        samplesRequested = networkSamplesPopped;
+    }
+
+    // the output worker keeps the local injectors' stream topped up; whatever it has not caught up with is skipped
+    // rather than waited for. The stream is only resized while the device is stopped.
+    int injectorSamplesPopped = 0;
+    {
+        bool append = networkSamplesPopped > 0;
+        if ((injectorSamplesPopped = _localInjectorsStream.appendSamples(mixBuffer, samplesRequested, append)) > 0) {
+            qCDebug(audiostream, "Read %d samples from injectors (%d available, %d requested)", injectorSamplesPopped, _localInjectorsStream.samplesAvailable(), samplesRequested);
+        }
+    }
+
+    int samplesPopped = std::max(networkSamplesPopped, injectorSamplesPopped);
+    if (samplesPopped == 0) {
+        // nothing on network, don't grab anything from injectors, and fill with silence
+        samplesPopped = maxSamplesRequested;
+        memset(mixBuffer, 0, samplesPopped * sizeof(float));
+    }
+    int framesPopped = samplesPopped / OUTPUT_CHANNEL_COUNT;
+
+    // apply output gain
+    float newGain = _outputGain.load(std::memory_order_acquire);
+    float oldGain = _lastOutputGain;
+    _lastOutputGain = newGain;
+
+    applyGainSmoothing<OUTPUT_CHANNEL_COUNT>(mixBuffer, framesPopped, oldGain, newGain);
+
+    // limit the audio
+    _audioLimiter.render(mixBuffer, scratchBuffer, framesPopped);
+
+    if (_farEndHandler) {
+        _farEndHandler(scratchBuffer, framesPopped, _format.sampleRate());
+    }
+
+    // if required, upmix or downmix to deviceChannelCount
+    if (deviceChannelCount == OUTPUT_CHANNEL_COUNT) {
+        memcpy(data, scratchBuffer, samplesPopped * AudioConstants::SAMPLE_SIZE);
+    } else if (deviceChannelCount > OUTPUT_CHANNEL_COUNT) {
+        int extraChannels = deviceChannelCount - OUTPUT_CHANNEL_COUNT;
+        channelUpmix(scratchBuffer, (int16_t*)data, samplesPopped, extraChannels);
+    } else {
+        channelDownmix(scratchBuffer, (int16_t*)data, samplesPopped);
+    }
+    int bytesWritten = framesPopped * AudioConstants::SAMPLE_SIZE * deviceChannelCount;
+    assert(bytesWritten <= maxSize);
+
+    // send output buffer for recording, which the output worker writes to file
+    if (_isRecording) {
+        _recordingStream.writeSamples((int16_t*)data, bytesWritten / AudioConstants::SAMPLE_SIZE);
+    }
+
+    // wake the output worker to prepare injectors for the next callback
+    if (_readHandler) {
+        _readHandler();
+    }
+
+    int bytesAudioOutputUnplayed = _bytesUnplayedGetter ? _bytesUnplayedGetter() : 0;
+    float msecsAudioOutputUnplayed = bytesAudioOutputUnplayed / (float)_format.bytesForDuration(USECS_PER_MSEC);
+    _stats.updateOutputMsUnplayed(msecsAudioOutputUnplayed);
+
+    if (bytesAudioOutputUnplayed == 0) {
+        _unfulfilledReads++;
+    }
+
+    _stats.updateOutputCallback(callbackStart, framesPopped, _format.sampleRate());
+
+    return bytesWritten;
+}
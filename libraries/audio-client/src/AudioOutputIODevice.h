@@ -0,0 +1,97 @@
+//
+//  AudioOutputIODevice.h
+//  libraries/audio-client/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_AudioOutputIODevice_h
+#define hifi_AudioOutputIODevice_h
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include <QtCore/QIODevice>
+#include <QtMultimedia/QAudioFormat>
+
+#include <AudioConstants.h>
+#include <AudioLimiter.h>
+#include <AudioSPSCRingBuffer.h>
+#include <MixedProcessedAudioStream.h>
+
+#include "AudioIOStats.h"
+
+// The device the audio output reads from, on the output's own thread. Each read mixes the audio received from the
+// mixer with the local injectors that the output worker mixed ahead of time, applies the output gain and the limiter,
+// and copies the result to the recording stream. Nothing a read does may lock or allocate.
+//
+// It doesn't depend on AudioClient, so that it can be driven by a NullAudioOutput on a machine without audio hardware.
+class AudioOutputIODevice : public QIODevice {
+public:
+    // the audio pipeline's output format, which is always stereo
+    static const int OUTPUT_CHANNEL_COUNT { 2 };
+
+    using LocalInjectorsStream = AudioSPSCRingBuffer<float>;
+    using RecordingStream = AudioSPSCRingBuffer<int16_t>;
+
+    // Called after each read with the stereo output, for echo cancellation
+    using FarEndHandler = std::function<void(const int16_t* samples, int numFrames, int sampleRate)>;
+    // Returns the bytes the output has buffered but not played yet
+    using BytesUnplayedGetter = std::function<int()>;
+    // Called at the end of each read, to wake the thread that refills the local injectors' stream
+    using ReadHandler = std::function<void()>;
+
+    AudioOutputIODevice(LocalInjectorsStream& localInjectorsStream, MixedProcessedAudioStream& receivedAudioStream,
+                        RecordingStream& recordingStream, const std::atomic<bool>& isRecording, const AudioIOStats& stats);
+
+    void start() { open(QIODevice::ReadOnly | QIODevice::Unbuffered); }
+
+    // Sizes the mix buffers for reads of up to maxSamples stereo samples, in the given device format, and lets reads
+    // mix from then on. Until then, and after deconfigure(), reads return silence. Only call while no read can run.
+    void configure(const QAudioFormat& format, int maxSamples);
+    void deconfigure();
+
+    void setFarEndHandler(FarEndHandler handler) { _farEndHandler = handler; }
+    void setBytesUnplayedGetter(BytesUnplayedGetter getter) { _bytesUnplayedGetter = getter; }
+    void setReadHandler(ReadHandler handler) { _readHandler = handler; }
+
+    void setOutputGain(float gain) { _outputGain.store(gain, std::memory_order_release); }
+
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override { return 0; }
+
+    int getRecentUnfulfilledReads() { int unfulfilledReads = _unfulfilledReads; _unfulfilledReads = 0; return unfulfilledReads; }
+
+    static void channelUpmix(int16_t* source, int16_t* dest, int numSamples, int numExtraChannels);
+    static void channelDownmix(int16_t* source, int16_t* dest, int numSamples);
+
+private:
+    LocalInjectorsStream& _localInjectorsStream;
+    MixedProcessedAudioStream& _receivedAudioStream;
+    RecordingStream& _recordingStream;
+    const std::atomic<bool>& _isRecording;
+    const AudioIOStats& _stats;
+
+    FarEndHandler _farEndHandler;
+    BytesUnplayedGetter _bytesUnplayedGetter;
+    ReadHandler _readHandler;
+
+    std::atomic<bool> _isConfigured { false };
+    QAudioFormat _format;
+    int _maxSamples { 0 };
+    std::unique_ptr<float[]> _mixBuffer;
+    std::unique_ptr<int16_t[]> _scratchBuffer;
+
+    std::atomic<float> _outputGain { 1.0f };
+    float _lastOutputGain { 1.0f };
+    AudioLimiter _audioLimiter { AudioConstants::SAMPLE_RATE, OUTPUT_CHANNEL_COUNT };
+
+    int _unfulfilledReads { 0 };
+};
+
+#endif // hifi_AudioOutputIODevice_h
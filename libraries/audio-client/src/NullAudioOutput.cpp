@@ -0,0 +1,69 @@
+//
+//  NullAudioOutput.cpp
+//  libraries/audio-client/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "NullAudioOutput.h"
+
+#include <NumericalConstants.h>
+#include <ThreadHelpers.h>
+
+NullAudioOutput::NullAudioOutput(const QAudioFormat& format, int periodFrames) :
+    _format(format),
+    _periodFrames(periodFrames),
+    _periodBytes(format.bytesForFrames(periodFrames)),
+    _buffer(new char[_periodBytes]) {
+}
+
+void NullAudioOutput::start(QIODevice* device) {
+    stop();
+
+    _bytesRead = 0;
+    _underruns = 0;
+    _callbackStats.reset();
+
+    _isRunning = true;
+    _thread = std::thread([this, device] { run(device); });
+}
+
+void NullAudioOutput::stop() {
+    _isRunning = false;
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void NullAudioOutput::run(QIODevice* device) {
+    setThreadName("Null Audio Output");
+
+    using Clock = AudioCallbackStats::Clock;
+    const auto period = std::chrono::microseconds((qint64)_periodFrames * USECS_PER_SECOND / _format.sampleRate());
+
+    auto deadline = Clock::now();
+    while (_isRunning) {
+        auto start = AudioCallbackStats::now();
+        qint64 bytesRead = device->read(_buffer.get(), _periodBytes);
+        _callbackStats.update(start, _periodFrames, _format.sampleRate());
+
+        if (bytesRead > 0) {
+            _bytesRead.fetch_add(bytesRead, std::memory_order_relaxed);
+        }
+        if (bytesRead < _periodBytes) {
+            _underruns.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // the next period is due when this one finishes playing; like a device, don't try to catch up a late one
+        deadline += period;
+        auto now = Clock::now();
+        if (deadline < now) {
+            deadline = now;
+        }
+        std::this_thread::sleep_until(deadline);
+    }
+}
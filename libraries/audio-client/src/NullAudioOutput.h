@@ -0,0 +1,61 @@
+//
+//  NullAudioOutput.h
+//  libraries/audio-client/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_NullAudioOutput_h
+#define hifi_NullAudioOutput_h
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <QtCore/QIODevice>
+#include <QtMultimedia/QAudioFormat>
+
+#include "AudioCallbackStats.h"
+
+// An audio output with no hardware behind it. Like a sound card in pull mode, it reads a period of audio from a
+// QIODevice each time the last one would have finished playing, from a thread of its own, and discards it.
+// This lets the output path run, and be timed, on a machine without an audio device.
+class NullAudioOutput {
+public:
+    NullAudioOutput(const QAudioFormat& format, int periodFrames);
+    ~NullAudioOutput() { stop(); }
+
+    void start(QIODevice* device);
+    void stop();
+
+    // in bytes, as QAudioOutput reports it
+    int periodSize() const { return _periodBytes; }
+
+    quint64 getBytesRead() const { return _bytesRead.load(std::memory_order_relaxed); }
+
+    // reads that returned less than a full period
+    quint64 getUnderruns() const { return _underruns.load(std::memory_order_relaxed); }
+
+    AudioCallbackStats& getCallbackStats() { return _callbackStats; }
+
+private:
+    void run(QIODevice* device);
+
+    QAudioFormat _format;
+    int _periodFrames;
+    int _periodBytes;
+    std::unique_ptr<char[]> _buffer;
+
+    std::thread _thread;
+    std::atomic<bool> _isRunning { false };
+
+    std::atomic<quint64> _bytesRead { 0 };
+    std::atomic<quint64> _underruns { 0 };
+    AudioCallbackStats _callbackStats;
+};
+
+#endif // hifi_NullAudioOutput_h
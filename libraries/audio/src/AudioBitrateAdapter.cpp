@@ -0,0 +1,57 @@
+//
+//  AudioBitrateAdapter.cpp
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AudioBitrateAdapter.h"
+
+#include <algorithm>
+
+const int AudioBitrateAdapter::MIN_BITRATE;
+const int AudioBitrateAdapter::MAX_BITRATE;
+const int AudioBitrateAdapter::PROBE_BITRATE_STEP;
+
+const float AudioBitrateAdapter::BACK_OFF_LOSS_RATE = 0.02f;
+const float AudioBitrateAdapter::PROBE_LOSS_RATE = 0.005f;
+const float AudioBitrateAdapter::BACK_OFF_RATIO = 0.75f;
+
+void AudioBitrateAdapter::reset() {
+    _lastStats = PacketStreamStats();
+    _hasStats = false;
+    _bitrate = MAX_BITRATE;
+}
+
+bool AudioBitrateAdapter::update(const PacketStreamStats& receivedStats) {
+    // the first report, or one after the receiver reset its stats, only sets the baseline
+    if (!_hasStats || receivedStats._expectedReceived < _lastStats._expectedReceived) {
+        _lastStats = receivedStats;
+        _hasStats = true;
+        return false;
+    }
+
+    PacketStreamStats interval = receivedStats - _lastStats;
+    if (interval._expectedReceived == 0) {
+        return false;
+    }
+    _lastStats = receivedStats;
+
+    // packets counted lost in an earlier interval, and recovered in this one, leave it with less than none lost
+    float lostRate = (qint32)interval._lost > 0 ? interval.getLostRate() : 0.0f;
+
+    int bitrate = _bitrate;
+    if (lostRate > BACK_OFF_LOSS_RATE) {
+        bitrate = std::max((int)(bitrate * BACK_OFF_RATIO), MIN_BITRATE);
+    } else if (lostRate < PROBE_LOSS_RATE) {
+        bitrate = std::min(bitrate + PROBE_BITRATE_STEP, MAX_BITRATE);
+    }
+
+    bool changed = bitrate != _bitrate;
+    _bitrate = bitrate;
+    return changed;
+}
@@ -0,0 +1,45 @@
+//
+//  AudioBitrateAdapter.h
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_AudioBitrateAdapter_h
+#define hifi_AudioBitrateAdapter_h
+
+#include "SequenceNumberStats.h"
+
+// Picks the bitrate to encode a stream at, from what its receiver reports of it.
+//
+// The receiver's stats arrive about once a second. Loss over the interval since the last report backs the bitrate off
+// multiplicatively, and a clean interval probes it back up a step at a time, so a congested listener sheds load quickly
+// and recovers without oscillating.
+class AudioBitrateAdapter {
+public:
+    static const int MIN_BITRATE = 24000;
+    static const int MAX_BITRATE = 128000;
+    static const int PROBE_BITRATE_STEP = 8000;
+
+    static const float BACK_OFF_LOSS_RATE;
+    static const float PROBE_LOSS_RATE;
+    static const float BACK_OFF_RATIO;
+
+    void reset();
+
+    // the receiver's stats of the stream, as last reported; returns whether the bitrate changed
+    bool update(const PacketStreamStats& receivedStats);
+
+    int getBitrate() const { return _bitrate; }
+
+private:
+    PacketStreamStats _lastStats;
+    bool _hasStats { false };
+    int _bitrate { MAX_BITRATE };
+};
+
+#endif // hifi_AudioBitrateAdapter_h
@@ -25,6 +25,7 @@
 #include "AudioLogging.h"
 #include "SoundCache.h"
 #include "AudioHelpers.h"
+#include "ResidentInjectedAudioStream.h"
 
 int metaType = qRegisterMetaType<AudioInjectorPointer>("AudioInjectorPointer");
 
@@ -139,6 +140,14 @@ bool AudioInjector::inject(bool(AudioInjectorManager::*injection)(const AudioInj
         numBytes = _audioData->getNumBytes();
     });
 
+    // only a sound loaded from a URL the mixer will fetch, at its own pitch, can be played by the mixer, and only for a
+    // node allowed to rez; anything else is streamed to it
+    auto nodeList = DependencyManager::get<NodeList>();
+    _isResident = (options.resident || options.ambient) && options.pitch == 1.0f && _sound &&
+        ResidentInjectedAudioStream::isAllowedSoundURL(_sound->getURL()) &&
+        (nodeList->getThisNodeCanRez() || nodeList->getThisNodeCanRezTmp());
+    _hasResidentPlayedOut = false;
+
     int byteOffset = 0;
     if (options.secondOffset > 0.0f) {
         int numChannels = options.ambisonic ? 4 : (options.stereo ? 2 : 1);
@@ -226,6 +235,10 @@ int64_t AudioInjector::injectNextFrame() {
         return _options;
     });
 
+    if (_isResident) {
+        return injectResidentFrame(options);
+    }
+
     if (!_currentPacket) {
         if (_currentSendOffset < 0 ||
             _currentSendOffset >= (int)_audioData->getNumBytes()) {
@@ -408,8 +421,51 @@ int64_t AudioInjector::injectNextFrame() {
     return std::max(INT64_C(0), playNextFrameAt - currentTime);
 }
 
+int64_t AudioInjector::injectResidentFrame(const AudioInjectorOptions& options) {
+    if (!_frameTimer) {
+        _frameTimer = std::unique_ptr<QElapsedTimer>(new QElapsedTimer);
+    }
+
+    ResidentInjectedAudioStream::Flags flags = 0;
+    if (!_hasSentFirstFrame || !_frameTimer->isValid()) {
+        // (re)starting - the mixer plays from the second offset, and we time the sound from now
+        flags |= ResidentInjectedAudioStream::RESTART;
+        _frameTimer->restart();
+        _hasSentFirstFrame = true;
+    }
+    if (_localAudioInterface && _localAudioInterface->shouldLoopbackInjectors()) {
+        flags |= ResidentInjectedAudioStream::LOOPBACK;
+    }
+
+    int64_t currentTime = _frameTimer->nsecsElapsed() / 1000;
+    int64_t timeLeft = ResidentInjectedAudioStream::REFRESH_USECS;
+    if (!options.loop) {
+        float secondsToPlay = _audioData->getDuration() - std::max(options.secondOffset, 0.0f);
+        timeLeft = (int64_t)(secondsToPlay * USECS_PER_SECOND) - currentTime;
+        if (timeLeft <= 0) {
+            // the mixer plays what is left of the sound out by itself, so it does not need to be stopped
+            _hasResidentPlayedOut = true;
+            finishNetworkInjection();
+            return NEXT_FRAME_DELTA_ERROR_OR_FINISHED;
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (audioMixer) {
+        auto residentPacket = NLPacket::create(PacketType::ResidentInjector);
+        ResidentInjectedAudioStream::writeResidentData(*residentPacket, _streamID, _sound->getURL(), options, flags);
+        nodeList->sendUnreliablePacket(*residentPacket, *audioMixer);
+    }
+
+    return std::min(timeLeft, (int64_t)ResidentInjectedAudioStream::REFRESH_USECS);
+}
 
 void AudioInjector::sendStopInjectorPacket() {
+    if (_hasResidentPlayedOut) {
+        return;
+    }
+
     auto nodeList = DependencyManager::get<NodeList>();
     if (auto audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer)) {
         // Build packet
@@ -98,6 +98,7 @@ signals:
 
 private:
     int64_t injectNextFrame();
+    int64_t injectResidentFrame(const AudioInjectorOptions& options);
     bool inject(bool(AudioInjectorManager::*injection)(const AudioInjectorPointer&));
     bool injectLocally();
     void sendStopInjectorPacket();
@@ -118,6 +119,10 @@ private:
     std::unique_ptr<QElapsedTimer> _frameTimer { nullptr };
     quint16 _outgoingSequenceNumber { 0 };
 
+    // a resident injector has the mixer play its sound, and only sends its state
+    bool _isResident { false };
+    bool _hasResidentPlayedOut { false };
+
     // when the injector is local, we need this
     AudioHRTF _localHRTF;
     AudioFOA _localFOA;
@@ -30,7 +30,9 @@ AudioInjectorOptions::AudioInjectorOptions() :
     ignorePenumbra(false),
     localOnly(false),
     secondOffset(0.0f),
-    pitch(1.0f)
+    pitch(1.0f),
+    resident(false),
+    ambient(false)
 {
 }
 
@@ -46,6 +48,8 @@ ScriptValue injectorOptionsToScriptValue(ScriptEngine* engine, const AudioInject
     obj.setProperty("localOnly", injectorOptions.localOnly);
     obj.setProperty("secondOffset", injectorOptions.secondOffset);
     obj.setProperty("pitch", injectorOptions.pitch);
+    obj.setProperty("resident", injectorOptions.resident);
+    obj.setProperty("ambient", injectorOptions.ambient);
     return obj;
 }
 
@@ -67,6 +71,14 @@ ScriptValue injectorOptionsToScriptValue(ScriptEngine* engine, const AudioInject
  *     others via the audio mixer.
  * @property {boolean} ignorePenumbra=false - <p class="important">Deprecated: This property is deprecated and will be
  *     removed.</p>
+ * @property {boolean} resident=false - If <code>true</code>, the audio mixer downloads the sound and plays it itself, rather
+ *     than the sound being streamed to it. Only the sound's URL and the injector's options are sent, a few times a second, so
+ *     changes of options take effect less promptly. Ignored if the sound was not loaded from a URL, or if <code>pitch</code>
+ *     is not <code>1.0</code>.
+ * @property {boolean} ambient=false - If <code>true</code>, the sound is <code>resident</code> and part of the ambience of
+ *     the audio zone it is in: the audio mixer mixes it with the zone's other ambient sounds, as heard from the zone's
+ *     center, and each listener in the zone hears that mix as a whole. Outside a zone, the sound plays as any other resident
+ *     sound.
  */
 bool injectorOptionsFromScriptValue(const ScriptValue& object, AudioInjectorOptions& injectorOptions) {
     if (!object.isObject()) {
@@ -124,6 +136,18 @@ bool injectorOptionsFromScriptValue(const ScriptValue& object, AudioInjectorOpti
             } else {
                 qCWarning(audio) << "Audio injector options: pitch is not a number";
             }
+        } else if (it->name() == "resident") {
+            if (it->value().isBool()) {
+                injectorOptions.resident = it->value().toBool();
+            } else {
+                qCWarning(audio) << "Audio injector options: resident is not a boolean";
+            }
+        } else if (it->name() == "ambient") {
+            if (it->value().isBool()) {
+                injectorOptions.ambient = it->value().toBool();
+            } else {
+                qCWarning(audio) << "Audio injector options: ambient is not a boolean";
+            }
         } else {
             qCWarning(audio) << "Unknown audio injector option:" << it->name();
         }
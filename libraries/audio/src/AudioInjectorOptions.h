@@ -34,6 +34,8 @@ public:
     bool localOnly;
     float secondOffset;
     float pitch;    // multiplier, where 2.0f shifts up one octave
+    bool resident;  // played by the audio mixer from its own copy of the sound, rather than streamed to it
+    bool ambient;   // resident, and mixed into the ambience of the zone it is in
 };
 
 Q_DECLARE_METATYPE(AudioInjectorOptions);
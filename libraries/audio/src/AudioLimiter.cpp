@@ -9,6 +9,7 @@
 #include "AudioLimiter.h"
 
 #include <assert.h>
+#include <string.h>
 
 #include "AudioDynamics.h"
 
@@ -192,178 +193,168 @@ int32_t LimiterImpl::envelope(int32_t attn) {
 }
 
 //
-// Limiter (mono)
+// Block processing kernels
 //
-template<int N>
-class LimiterMono : public LimiterImpl {
 
-    MinFilter<N> _filter;
-    MonoDelay<N> _delay;
-
-public:
-    LimiterMono(int sampleRate) : LimiterImpl(sampleRate) {}
+// peak detect and convert to log2 domain, for interleaved input
+static void peaklog2Block_ref(float* input, int32_t* output, int numFrames, int numChannels) {
 
-    void process(float* input, int16_t* output, int numFrames) override;
-};
+    switch (numChannels) {
+    case 1:
+        for (int i = 0; i < numFrames; i++) {
+            output[i] = peaklog2(&input[i]);
+        }
+        break;
+    case 2:
+        for (int i = 0; i < numFrames; i++) {
+            output[i] = peaklog2(&input[2*i+0], &input[2*i+1]);
+        }
+        break;
+    case 4:
+        for (int i = 0; i < numFrames; i++) {
+            output[i] = peaklog2(&input[4*i+0], &input[4*i+1], &input[4*i+2], &input[4*i+3]);
+        }
+        break;
+    default:
+        assert(0); // unsupported
+    }
+}
 
-template<int N>
-void LimiterMono<N>::process(float* input, int16_t* output, int numFrames) {
+// convert from log2 domain
+static void fixexp2Block_ref(const int32_t* input, int32_t* output, int numFrames) {
 
-    for (int n = 0; n < numFrames; n++) {
+    for (int i = 0; i < numFrames; i++) {
+        output[i] = fixexp2(input[i]);
+    }
+}
 
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[n]);
+// apply gain and dither to interleaved input, and store 16-bit output
+static void applyGain_ref(const float* input, const float* gain, const float* dith, int16_t* output,
+                          int numFrames, int numChannels) {
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
+    for (int i = 0; i < numFrames; i++) {
+        for (int j = 0; j < numChannels; j++) {
+            float x = input[numChannels*i+j];
+            x *= gain[i];
+            x += dith[i];
+            output[numChannels*i+j] = (int16_t)floatToInt(x);
+        }
+    }
+}
 
-        // apply envelope
-        attn = envelope(attn);
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+//
+// Runtime CPU dispatch
+//
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+#include "CPUDetect.h"
 
-        // delay audio
-        float x = input[n];
-        _delay.process(x);
+void peaklog2Block_AVX2(float* input, int32_t* output, int numFrames, int numChannels);
+void fixexp2Block_AVX2(const int32_t* input, int32_t* output, int numFrames);
+void applyGain_AVX2(const float* input, const float* gain, const float* dith, int16_t* output,
+                    int numFrames, int numChannels);
 
-        // apply gain
-        x *= gain;
+static void peaklog2Block(float* input, int32_t* output, int numFrames, int numChannels) {
+    static auto f = cpuSupportsAVX2() ? peaklog2Block_AVX2 : peaklog2Block_ref;
+    (*f)(input, output, numFrames, numChannels);  // dispatch
+}
 
-        // apply dither
-        x += dither();
+static void fixexp2Block(const int32_t* input, int32_t* output, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? fixexp2Block_AVX2 : fixexp2Block_ref;
+    (*f)(input, output, numFrames);  // dispatch
+}
 
-        // store 16-bit output
-        output[n] = (int16_t)floatToInt(x);
-    }
+static void applyGain(const float* input, const float* gain, const float* dith, int16_t* output,
+                      int numFrames, int numChannels) {
+    static auto f = cpuSupportsAVX2() ? applyGain_AVX2 : applyGain_ref;
+    (*f)(input, gain, dith, output, numFrames, numChannels);  // dispatch
 }
 
+#else   // portable reference code
+
+static auto& peaklog2Block = peaklog2Block_ref;
+static auto& fixexp2Block = fixexp2Block_ref;
+static auto& applyGain = applyGain_ref;
+
+#endif
+
 //
-// Limiter (stereo)
+// Limiter (mono, stereo or quad)
+// The per-sample envelope and lowpass filter are recursive, everything around them is processed a block at a time.
 //
-template<int N>
-class LimiterStereo : public LimiterImpl {
+static const int LIMITER_BLOCK = 256;
+
+template<int N, int C>
+class LimiterT : public LimiterImpl {
+
+    static const int DELAY = N - 1;
 
     MinFilter<N> _filter;
-    StereoDelay<N> _delay;
+    float _history[C * DELAY] = {};     // the last N-1 input frames
 
 public:
-    LimiterStereo(int sampleRate) : LimiterImpl(sampleRate) {}
+    LimiterT(int sampleRate) : LimiterImpl(sampleRate) {}
 
-    // interleaved stereo input/output
+    // interleaved input/output
     void process(float* input, int16_t* output, int numFrames) override;
 };
 
-template<int N>
-void LimiterStereo<N>::process(float* input, int16_t* output, int numFrames) {
-
-    for (int n = 0; n < numFrames; n++) {
-
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[2*n+0], &input[2*n+1]);
-
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
-
-        // apply envelope
-        attn = envelope(attn);
-
-        // convert from log2 domain
-        attn = fixexp2(attn);
-
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+template<int N, int C>
+void LimiterT<N, C>::process(float* input, int16_t* output, int numFrames) {
 
-        // delay audio
-        float x0 = input[2*n+0];
-        float x1 = input[2*n+1];
-        _delay.process(x0, x1);
+    int32_t attn[LIMITER_BLOCK];
+    float gain[LIMITER_BLOCK];
+    float dith[LIMITER_BLOCK];
 
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
+    for (int offset = 0; offset < numFrames; offset += LIMITER_BLOCK) {
+        int n = MIN(numFrames - offset, LIMITER_BLOCK);
 
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
+        float* x = &input[C * offset];
+        int16_t* y = &output[C * offset];
 
-        // store 16-bit output
-        output[2*n+0] = (int16_t)floatToInt(x0);
-        output[2*n+1] = (int16_t)floatToInt(x1);
-    }
-}
-
-//
-// Limiter (quad)
-//
-template<int N>
-class LimiterQuad : public LimiterImpl {
+        // peak detect and convert to log2 domain
+        peaklog2Block(x, attn, n, C);
 
-    MinFilter<N> _filter;
-    QuadDelay<N> _delay;
+        for (int i = 0; i < n; i++) {
 
-public:
-    LimiterQuad(int sampleRate) : LimiterImpl(sampleRate) {}
+            // compute limiter attenuation
+            int32_t a = MAX(_threshold - attn[i], 0);
 
-    // interleaved quad input/output
-    void process(float* input, int16_t* output, int numFrames) override;
-};
+            // apply envelope
+            attn[i] = envelope(a);
+        }
 
-template<int N>
-void LimiterQuad<N>::process(float* input, int16_t* output, int numFrames) {
+        // convert from log2 domain
+        fixexp2Block(attn, attn, n);
 
-    for (int n = 0; n < numFrames; n++) {
+        for (int i = 0; i < n; i++) {
 
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[4*n+0], &input[4*n+1], &input[4*n+2], &input[4*n+3]);
+            // lowpass filter
+            gain[i] = _filter.process(attn[i]) * _outGain;
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
+            dith[i] = dither();
+        }
 
-        // apply envelope
-        attn = envelope(attn);
+        // apply gain and dither to the audio delayed by N-1 frames
+        int m = MIN(n, DELAY);
+        applyGain(_history, gain, dith, y, m, C);
+        applyGain(x, &gain[m], &dith[m], &y[C * m], n - m, C);
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
-
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
-
-        // delay audio
-        float x0 = input[4*n+0];
-        float x1 = input[4*n+1];
-        float x2 = input[4*n+2];
-        float x3 = input[4*n+3];
-        _delay.process(x0, x1, x2, x3);
-
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
-        x2 *= gain;
-        x3 *= gain;
-
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
-        x2 += d;
-        x3 += d;
-
-        // store 16-bit output
-        output[4*n+0] = (int16_t)floatToInt(x0);
-        output[4*n+1] = (int16_t)floatToInt(x1);
-        output[4*n+2] = (int16_t)floatToInt(x2);
-        output[4*n+3] = (int16_t)floatToInt(x3);
+        // keep the last N-1 frames
+        if (n >= DELAY) {
+            memcpy(_history, &x[C * (n - DELAY)], C * DELAY * sizeof(float));
+        } else {
+            memmove(_history, &_history[C * n], C * (DELAY - n) * sizeof(float));
+            memcpy(&_history[C * (DELAY - n)], x, C * n * sizeof(float));
+        }
     }
 }
 
+template<int N> using LimiterMono = LimiterT<N, 1>;
+template<int N> using LimiterStereo = LimiterT<N, 2>;
+template<int N> using LimiterQuad = LimiterT<N, 4>;
+
 //
 // Public API
 //
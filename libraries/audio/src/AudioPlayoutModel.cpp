@@ -0,0 +1,119 @@
+//
+//  AudioPlayoutModel.cpp
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AudioPlayoutModel.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "AudioConstants.h"
+
+const float AudioPlayoutModel::DEFAULT_TARGET_CONCEALMENT_RATE = 0.01f;
+const int AudioPlayoutModel::MAX_GAP_FRAMES;
+const int AudioPlayoutModel::ACCELERATE_INPUT_RATE;
+const int AudioPlayoutModel::DECELERATE_INPUT_RATE;
+const int AudioPlayoutModel::PLAYOUT_OUTPUT_RATE;
+
+// each packet's gap is weighted against the last ~500 packets (5 seconds)
+static const float GAP_HISTOGRAM_FORGETTING = 0.998f;
+
+// the level is smoothed over ~16 packets, so the playout rate follows the trend and not each packet's jitter
+static const float LEVEL_SMOOTHING = 1.0f / 16.0f;
+
+// just after a packet arrives, a buffer at its target holds between target and target + 1 frames
+static const float LEVEL_OVER_TARGET = 0.5f;
+static const float LEVEL_HYSTERESIS_FRAMES = 1.0f;
+
+AudioPlayoutModel::AudioPlayoutModel(float targetConcealmentRate) :
+    _targetConcealmentRate(targetConcealmentRate) {
+    reset();
+}
+
+void AudioPlayoutModel::reset() {
+    // until packets say otherwise, they arrive a frame apart
+    _gapHistogram.fill(0.0f);
+    _gapHistogram[1] = 1.0f;
+    _lastArrivalUsecs = 0;
+    _targetFrames = 1;
+
+    _filteredLevel = 0.0f;
+    _hasLevel = false;
+    _playout = Playout::Normal;
+}
+
+void AudioPlayoutModel::setTargetConcealmentRate(float targetConcealmentRate) {
+    _targetConcealmentRate = targetConcealmentRate;
+    updateTarget();
+}
+
+void AudioPlayoutModel::packetArrived(quint64 arrivalUsecs, int numLost) {
+    if (_lastArrivalUsecs != 0 && arrivalUsecs >= _lastArrivalUsecs) {
+        // the lost packets account for part of the gap; the rest is jitter
+        float gapFrames = (float)(arrivalUsecs - _lastArrivalUsecs) / AudioConstants::NETWORK_FRAME_USECS;
+        int gap = (int)roundf(gapFrames) - numLost;
+        gap = std::max(std::min(gap, MAX_GAP_FRAMES), 0);
+
+        for (auto& probability : _gapHistogram) {
+            probability *= GAP_HISTOGRAM_FORGETTING;
+        }
+        _gapHistogram[gap] += 1.0f - GAP_HISTOGRAM_FORGETTING;
+
+        updateTarget();
+    }
+    _lastArrivalUsecs = arrivalUsecs;
+}
+
+void AudioPlayoutModel::levelObserved(int framesAvailable) {
+    if (!_hasLevel) {
+        _filteredLevel = (float)framesAvailable;
+        _hasLevel = true;
+    } else {
+        _filteredLevel += LEVEL_SMOOTHING * ((float)framesAvailable - _filteredLevel);
+    }
+
+    float nominalLevel = _targetFrames + LEVEL_OVER_TARGET;
+    if (_filteredLevel > nominalLevel + LEVEL_HYSTERESIS_FRAMES) {
+        _playout = Playout::Accelerate;
+    } else if (_filteredLevel < nominalLevel - LEVEL_HYSTERESIS_FRAMES) {
+        _playout = Playout::Decelerate;
+    } else if ((_playout == Playout::Accelerate && _filteredLevel <= nominalLevel) ||
+               (_playout == Playout::Decelerate && _filteredLevel >= nominalLevel)) {
+        // once steering, keep on until the level is back at the target
+        _playout = Playout::Normal;
+    }
+}
+
+float AudioPlayoutModel::getExpectedConcealmentRate(int bufferFrames) const {
+    float rate = 0.0f;
+    for (int gap = bufferFrames + 1; gap <= MAX_GAP_FRAMES; gap++) {
+        rate += _gapHistogram[gap] * (gap - bufferFrames);
+    }
+    return rate;
+}
+
+void AudioPlayoutModel::updateTarget() {
+    // the expected concealment of a buffer of b frames is the sum over gaps n > b of p(n) * (n - b),
+    // which is tailMoment - b * tailMass for the gaps above b; it only falls as b grows
+    float tailMass = 0.0f;
+    float tailMoment = 0.0f;
+    int targetFrames = MAX_GAP_FRAMES;
+    for (int bufferFrames = MAX_GAP_FRAMES - 1; bufferFrames >= 1; bufferFrames--) {
+        int gap = bufferFrames + 1;
+        tailMass += _gapHistogram[gap];
+        tailMoment += _gapHistogram[gap] * gap;
+
+        if (tailMoment - bufferFrames * tailMass > _targetConcealmentRate) {
+            break;
+        }
+        targetFrames = bufferFrames;
+    }
+    _targetFrames = targetFrames;
+}
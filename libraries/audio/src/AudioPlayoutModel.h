@@ -0,0 +1,75 @@
+//
+//  AudioPlayoutModel.h
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_AudioPlayoutModel_h
+#define hifi_AudioPlayoutModel_h
+
+#include <array>
+
+#include <QtCore/QtGlobal>
+
+// A model of when the packets of an audio stream arrive, which sizes the stream's jitter buffer.
+//
+// The gap before each packet, in frames and net of the packets lost in it, is kept in a histogram that slowly forgets.
+// A buffer of b frames rides out a gap of n frames but for max(n - b, 0) frames that must be concealed, so the target
+// is the smallest buffer whose expected concealment, per frame played, is within the target concealment rate.
+//
+// The level of the buffer is steered toward the target by playing the stream slightly faster or slower.
+class AudioPlayoutModel {
+public:
+    enum class Playout {
+        Normal,
+        Accelerate,
+        Decelerate
+    };
+
+    static const float DEFAULT_TARGET_CONCEALMENT_RATE;
+    static const int MAX_GAP_FRAMES = 50;
+
+    // the rates the stream is played at, while accelerating or decelerating, as the ratio of frames in to frames out
+    static const int ACCELERATE_INPUT_RATE = 49;
+    static const int DECELERATE_INPUT_RATE = 47;
+    static const int PLAYOUT_OUTPUT_RATE = 48;
+
+    AudioPlayoutModel(float targetConcealmentRate = DEFAULT_TARGET_CONCEALMENT_RATE);
+
+    void reset();
+
+    void setTargetConcealmentRate(float targetConcealmentRate);
+
+    // a packet arrived, with numLost packets lost since the one before it
+    void packetArrived(quint64 arrivalUsecs, int numLost);
+
+    // the frames buffered just after a packet arrived
+    void levelObserved(int framesAvailable);
+
+    int getTargetFrames() const { return _targetFrames; }
+    Playout getPlayout() const { return _playout; }
+    float getFilteredLevel() const { return _filteredLevel; }
+
+    // the concealment rate expected with a buffer of this many frames
+    float getExpectedConcealmentRate(int bufferFrames) const;
+
+private:
+    void updateTarget();
+
+    float _targetConcealmentRate;
+
+    std::array<float, MAX_GAP_FRAMES + 1> _gapHistogram;
+    quint64 _lastArrivalUsecs { 0 };
+    int _targetFrames { 1 };
+
+    float _filteredLevel { 0.0f };
+    bool _hasLevel { false };
+    Playout _playout { Playout::Normal };
+};
+
+#endif // hifi_AudioPlayoutModel_h
@@ -625,6 +625,137 @@ void PZShelf(double coef[3], double w0, double dbgain, int isHigh) {
     coef[2] = a1 * scale;
 }
 
+//
+// Block processing kernels
+//
+
+// output[i] = gain * x[i + offset], where x[k] is input[k] for k >= 0, and was written to the delay buffer before index for k < 0
+static void delayTap_ref(const float* buffer, int mask, int index, int offset, float gain, const float* input, float* output, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+        int k = i + offset;
+        float x = (k < 0) ? buffer[(index + k) & mask] : input[k];
+        output[i] = gain * x;
+    }
+}
+
+// a block of Allpass::process(), returns the new output state
+static float allpass_ref(float* buffer, int mask, int index, int delay, float coef, float state,
+                         const float* input, float* output, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+        float x = input[i];
+
+        float y = buffer[(index - delay) & mask] - coef * x;    // feedforward path
+        buffer[index] = x + coef * y;                           // feedback path
+        index = (index + 1) & mask;
+
+        output[i] = state;
+        state = y;
+    }
+    return state;
+}
+
+// a block of AllPassMod::process(), returns the new output state
+static float allpassMod_ref(float* buffer, int mask, int index, int delay, float coef, float state,
+                            const float* input, const int32_t* mod, float* output, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+        float x = input[i];
+
+        // add modulation to delay
+        int32_t offset = delay + (mod[i] >> MOD_FRACBITS);
+        float frac = (mod[i] & MOD_FRACMASK) * QMOD_TO_FLOAT;
+
+        // 3rd-order Lagrange interpolation
+        int k0 = (index - (offset-1)) & mask;
+        int k1 = (index - (offset+0)) & mask;
+        int k2 = (index - (offset+1)) & mask;
+        int k3 = (index - (offset+2)) & mask;
+
+        float x0 = buffer[k0];
+        float x1 = buffer[k1];
+        float x2 = buffer[k2];
+        float x3 = buffer[k3];
+
+        // compute the polynomial coefficients
+        float c0 = (1/6.0f) * (x3 - x0) + (1/2.0f) * (x1 - x2);
+        float c1 = (1/2.0f) * (x0 + x2) - x1;
+        float c2 = x2 - (1/3.0f) * x0 - (1/2.0f) * x1 - (1/6.0f) * x3;
+        float c3 = x1;
+
+        // compute the polynomial
+        float delayMod = ((c0 * frac + c1) * frac + c2) * frac + c3;
+
+        float y = delayMod - coef * x;      // feedforward path
+        buffer[index] = x + coef * y;       // feedback path
+        index = (index + 1) & mask;
+
+        output[i] = state;
+        state = y;
+    }
+    return state;
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void delayTap_AVX2(const float* buffer, int mask, int index, int offset, float gain, const float* input, float* output, int numFrames);
+float allpass_AVX2(float* buffer, int mask, int index, int delay, float coef, float state,
+                   const float* input, float* output, int numFrames);
+float allpassMod_AVX2(float* buffer, int mask, int index, int delay, float coef, float state,
+                      const float* input, const int32_t* mod, float* output, int numFrames);
+
+static void delayTap(const float* buffer, int mask, int index, int offset, float gain, const float* input, float* output, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? delayTap_AVX2 : delayTap_ref;
+    (*f)(buffer, mask, index, offset, gain, input, output, numFrames);  // dispatch
+}
+
+static float allpass(float* buffer, int mask, int index, int delay, float coef, float state,
+                     const float* input, float* output, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? allpass_AVX2 : allpass_ref;
+    return (*f)(buffer, mask, index, delay, coef, state, input, output, numFrames);  // dispatch
+}
+
+static float allpassMod(float* buffer, int mask, int index, int delay, float coef, float state,
+                        const float* input, const int32_t* mod, float* output, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? allpassMod_AVX2 : allpassMod_ref;
+    return (*f)(buffer, mask, index, delay, coef, state, input, mod, output, numFrames);  // dispatch
+}
+
+#else   // portable reference code
+
+static auto& delayTap = delayTap_ref;
+static auto& allpass = allpass_ref;
+static auto& allpassMod = allpassMod_ref;
+
+#endif
+
+// copy a block of input into a delay buffer, starting at index
+template<int N>
+static void writeDelay(float* buffer, int index, const float* input, int numFrames) {
+    int n = MIN(numFrames, N - index);
+    memcpy(&buffer[index], input, n * sizeof(float));
+    memcpy(&buffer[0], &input[n], (numFrames - n) * sizeof(float));
+}
+
+// a block of one tap of a delay line: output[i] is the tap's previous output, and the tap output becomes
+// gain * x[i - delay], where x is the block's input, or the input before it still in the buffer
+template<int N>
+static void readDelay(const float* buffer, int index, int delay, float gain, float& state,
+                    const float* input, float* output, int numFrames) {
+    output[0] = state;
+    delayTap(buffer, N - 1, index, -delay, gain, input, &output[1], numFrames - 1);
+
+    int k = numFrames - 1 - delay;
+    state = gain * ((k < 0) ? buffer[(index + k) & (N - 1)] : input[k]);
+}
+
 class BandwidthEQ {
 
     float _buffer[4] {};
@@ -685,6 +816,12 @@ public:
         _buffer[3] = _b2 * input1 - _a2 * _output1;
     }
 
+    void process(const float* input0, const float* input1, float* output0, float* output1, int numFrames) {
+        for (int i = 0; i < numFrames; i++) {
+            process(input0[i], input1[i], output0[i], output1[i]);
+        }
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output0 = 0.0f;
@@ -722,6 +859,14 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    // output must not alias input
+    void process(const float* input, float* output, int numFrames) {
+        readDelay<N>(_buffer, _index, _delay, 1.0f, _output, input, output, numFrames);
+
+        writeDelay<N>(_buffer, _index, input, numFrames);
+        _index = (_index + numFrames) & (N - 1);
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output = 0.0f;
@@ -768,6 +913,13 @@ public:
         _index1 = (_index1 + 1) & (N - 1);
     }
 
+    void process(const float* input, float* output, int numFrames) {
+        _output = allpass(_buffer, N - 1, _index0, _delay, _coef, _output, input, output, numFrames);
+
+        _index0 = (_index0 + numFrames) & (N - 1);
+        _index1 = (_index1 + numFrames) & (N - 1);
+    }
+
     void getOutput(float& output) {
         output = _output;
     }
@@ -922,6 +1074,12 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    void process(const float* input, const int32_t* mod, float* output, int numFrames) {
+        _output = allpassMod(_buffer, N - 1, _index, _delay, _coef, _output, input, mod, output, numFrames);
+
+        _index = (_index + numFrames) & (N - 1);
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output = 0.0f;
@@ -957,6 +1115,12 @@ public:
         _buffer[0] = input;
     }
 
+    void process(const float* input, float* output, int numFrames) {
+        for (int i = 0; i < numFrames; i++) {
+            process(input[i], output[i]);
+        }
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output = 0.0f;
@@ -1003,6 +1167,12 @@ public:
         _buffer[1] = _b2 * input - _a2 * _output;
     }
 
+    void process(const float* input, float* output, int numFrames) {
+        for (int i = 0; i < numFrames; i++) {
+            process(input[i], output[i]);
+        }
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output = 0.0f;
@@ -1060,6 +1230,27 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    // A block of tap k, for a block of input that has not been written yet.
+    // When the block is no longer than the tap delay, the input is not used and can be null.
+    void readTap(int k, const float* input, float* output, int numFrames) {
+        switch (k) {
+            case 0: readDelay<N>(_buffer, _index, _delay0, _gain0, _output0, input, output, numFrames); break;
+            case 1: readDelay<N>(_buffer, _index, _delay1, _gain1, _output1, input, output, numFrames); break;
+        }
+    }
+
+    void write(const float* input, int numFrames) {
+        writeDelay<N>(_buffer, _index, input, numFrames);
+        _index = (_index + numFrames) & (N - 1);
+    }
+
+    // outputs must not alias input
+    void process(const float* input, float* output0, float* output1, int numFrames) {
+        readTap(0, input, output0, numFrames);
+        readTap(1, input, output1, numFrames);
+        write(input, numFrames);
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output0 = 0.0f;
@@ -1127,6 +1318,16 @@ public:
         _index = (_index + 1) & (N - 1);
     }
 
+    // outputs must not alias input
+    void process(const float* input, float* output0, float* output1, float* output2, int numFrames) {
+        readDelay<N>(_buffer, _index, _delay0, _gain0, _output0, input, output0, numFrames);
+        readDelay<N>(_buffer, _index, _delay1, _gain1, _output1, input, output1, numFrames);
+        readDelay<N>(_buffer, _index, _delay2, _gain2, _output2, input, output2, numFrames);
+
+        writeDelay<N>(_buffer, _index, input, numFrames);
+        _index = (_index + numFrames) & (N - 1);
+    }
+
     void reset() {
         memset(_buffer, 0, sizeof(_buffer));
         _output0 = 0.0f;
@@ -1138,6 +1339,8 @@ public:
 //
 // Stereo Reverb
 //
+static const int REVERB_BLOCK = 256;
+
 class ReverbImpl {
 
     // Preprocess
@@ -1205,6 +1408,19 @@ class ReverbImpl {
     float _earlyGain = 0.0f;
     float _wetDryMix = 0.0f;
 
+    // block signals
+    float _preL[REVERB_BLOCK], _preR[REVERB_BLOCK];
+    float _early0L[REVERB_BLOCK], _early1L[REVERB_BLOCK], _early2L[REVERB_BLOCK], _earlyOutL[REVERB_BLOCK];
+    float _early0R[REVERB_BLOCK], _early1R[REVERB_BLOCK], _early2R[REVERB_BLOCK], _earlyOutR[REVERB_BLOCK];
+    int32_t _lfoSin[REVERB_BLOCK], _lfoCos[REVERB_BLOCK];
+    float _lateOut0[REVERB_BLOCK], _lateOut1[REVERB_BLOCK], _lateOut2[REVERB_BLOCK], _lateOut3[REVERB_BLOCK];
+    float _x0[REVERB_BLOCK], _x1[REVERB_BLOCK];
+    float _y0[REVERB_BLOCK], _y1[REVERB_BLOCK], _y2[REVERB_BLOCK], _y3[REVERB_BLOCK];
+
+    void processEarly(int numFrames);
+    void processLate(int numFrames);
+    void processLateBlock(int offset, int numFrames);
+
 public:
     void setParameters(ReverbParameters *p);
     void process(float** inputs, float** outputs, int numFrames);
@@ -1577,73 +1793,81 @@ void ReverbImpl::setParameters(ReverbParameters *p) {
     _wetDryMix = MIN(MAX(_wetDryMix, 0.0f), 1.0f);
 }
 
-void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
+void ReverbImpl::processEarly(int numFrames) {
 
+    // Early Left
+    _mt0.process(_preL, _x0, _x1, _y0, numFrames);
     for (int i = 0; i < numFrames; i++) {
-        float x0, x1, y0, y1, y2, y3;
+        _x0[i] += _x1[i];
+    }
+    _ap0.process(_x0, _y1, numFrames);
+    _mt1.process(_y1, _x0, _x1, _early0L, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] += _x1[i];
+    }
+    _ap1.process(_x0, _y2, numFrames);
+    _ap2.process(_y2, _x0, numFrames);
+    _mt2.process(_x0, _early1L, _early2L, numFrames);
 
-        // Preprocess
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
-        _bw.process(x0, x1, x0, x1);
-
-        float preL, preR;
-        _dl0.process(x0, preL);
-        _dl1.process(x1, preR);
-
-        // Early Left
-        float early0L, early1L, early2L, earlyOutL;
-        _mt0.process(preL, x0, x1, y0);
-        _ap0.process(x0 + x1, y1);
-        _mt1.process(y1, x0, x1, early0L);
-        _ap1.process(x0 + x1, y2);
-        _ap2.process(y2, x0);
-        _mt2.process(x0, early1L, early2L);
-
-        earlyOutL = (y0 + y1 * _earlyMix1L + y2 * _earlyMix2L) * _earlyGain;
-
-        // Early Right
-        float early0R, early1R, early2R, earlyOutR;
-        _mt3.process(preR, x0, x1, y0);
-        _ap3.process(x0 + x1, y1);
-        _mt4.process(y1, x0, x1, early0R);
-        _ap4.process(x0 + x1, y2);
-        _ap5.process(y2, x0);
-        _mt5.process(x0, early1R, early2R);
-
-        earlyOutR = (y0 + y1 * _earlyMix1R + y2 * _earlyMix2R) * _earlyGain;
+    for (int i = 0; i < numFrames; i++) {
+        _earlyOutL[i] = (_y0[i] + _y1[i] * _earlyMix1L + _y2[i] * _earlyMix2L) * _earlyGain;
+    }
 
-        // LFO update
-        int32_t lfoSin, lfoCos;
-        _lfo.process(lfoSin, lfoCos);
+    // Early Right
+    _mt3.process(_preR, _x0, _x1, _y0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] += _x1[i];
+    }
+    _ap3.process(_x0, _y1, numFrames);
+    _mt4.process(_y1, _x0, _x1, _early0R, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] += _x1[i];
+    }
+    _ap4.process(_x0, _y2, numFrames);
+    _ap5.process(_y2, _x0, numFrames);
+    _mt5.process(_x0, _early1R, _early2R, numFrames);
+
+    for (int i = 0; i < numFrames; i++) {
+        _earlyOutR[i] = (_y0[i] + _y1[i] * _earlyMix1R + _y2[i] * _earlyMix2R) * _earlyGain;
+    }
+}
+
+// late reverb, one sample at a time
+void ReverbImpl::processLate(int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+        float x0, y0, y1, y2, y3;
+
+        float early0L = _early0L[i];
+        float early1L = _early1L[i];
+        float early2L = _early2L[i];
+        float early0R = _early0R[i];
+        float early1R = _early1R[i];
+        float early2R = _early2R[i];
 
         // Late
-        float lateOut0;
         _ap6.getOutput(x0);
-        _ap7.process(x0, lfoSin, x0);
+        _ap7.process(x0, _lfoSin[i], x0);
         _eq0.process(-early0L + x0, x0);
-        _mt6.process(x0, y0, lateOut0);
+        _mt6.process(x0, y0, _lateOut0[i]);
 
-        float lateOut1;
         _ap8.getOutput(x0);
-        _ap9.process(x0, lfoCos, x0);
+        _ap9.process(x0, _lfoCos[i], x0);
         _eq1.process(-early0R + x0, x0);
-        _mt7.process(x0, y1, lateOut1);
+        _mt7.process(x0, y1, _lateOut1[i]);
 
-        float lateOut2;
         _ap10.getOutput(x0);
         _ap11.process(-early2L + x0, x0);
         _ap12.process(x0, x0);
         _ap13.process(-early2L - x0, x0);
-        _mt8.process(-early0L + x0, x0, lateOut2);
+        _mt8.process(-early0L + x0, x0, _lateOut2[i]);
         _lp0.process(x0, y2);
 
-        float lateOut3;
         _ap14.getOutput(x0);
         _ap15.process(-early2R + x0, x0);
         _ap16.process(x0, x0);
         _ap17.process(-early2R - x0, x0);
-        _mt9.process(-early0R + x0, x0, lateOut3);
+        _mt9.process(-early0R + x0, x0, _lateOut3[i]);
         _lp1.process(x0, y3);
 
         // Feedback matrix
@@ -1651,19 +1875,150 @@ void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
         _ap8.process(early1R - y2 - y3, x0);
         _ap10.process(-early2R + y0 + y1, x0);
         _ap14.process(-early2L - y0 + y1, x0);
+    }
+}
+
+// Late reverb, a block at a time.
+// The block must be no longer than the shortest loop delay, so that the loop taps only read from their buffers,
+// and the whole feedback matrix can be computed before the allpass chains that consume it.
+void ReverbImpl::processLateBlock(int offset, int numFrames) {
+
+    const float* early0L = &_early0L[offset];
+    const float* early1L = &_early1L[offset];
+    const float* early2L = &_early2L[offset];
+    const float* early0R = &_early0R[offset];
+    const float* early1R = &_early1R[offset];
+    const float* early2R = &_early2R[offset];
+
+    // loop taps
+    _mt6.readTap(0, nullptr, _y0, numFrames);
+    _mt7.readTap(0, nullptr, _y1, numFrames);
+    _mt8.readTap(0, nullptr, _x0, numFrames);
+    _mt9.readTap(0, nullptr, _x1, numFrames);
+    _lp0.process(_x0, _y2, numFrames);
+    _lp1.process(_x1, _y3, numFrames);
+
+    // Feedback matrix, into each chain
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] = early1L[i] + _y2[i] - _y3[i];
+    }
+    _ap6.process(_x0, _x0, numFrames);
+    _ap7.process(_x0, &_lfoSin[offset], _x0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] = -early0L[i] + _x0[i];
+    }
+    _eq0.process(_x0, _x0, numFrames);
+    _mt6.readTap(1, _x0, &_lateOut0[offset], numFrames);
+    _mt6.write(_x0, numFrames);
+
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] = early1R[i] - _y2[i] - _y3[i];
+    }
+    _ap8.process(_x0, _x0, numFrames);
+    _ap9.process(_x0, &_lfoCos[offset], _x0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] = -early0R[i] + _x0[i];
+    }
+    _eq1.process(_x0, _x0, numFrames);
+    _mt7.readTap(1, _x0, &_lateOut1[offset], numFrames);
+    _mt7.write(_x0, numFrames);
+
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] = -early2R[i] + _y0[i] + _y1[i];
+    }
+    _ap10.process(_x0, _x0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] = -early2L[i] + _x0[i];
+    }
+    _ap11.process(_x0, _x0, numFrames);
+    _ap12.process(_x0, _x0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] = -early2L[i] - _x0[i];
+    }
+    _ap13.process(_x0, _x0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] = -early0L[i] + _x0[i];
+    }
+    _mt8.readTap(1, _x0, &_lateOut2[offset], numFrames);
+    _mt8.write(_x0, numFrames);
+
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] = -early2L[i] - _y0[i] + _y1[i];
+    }
+    _ap14.process(_x0, _x0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] = -early2R[i] + _x0[i];
+    }
+    _ap15.process(_x0, _x0, numFrames);
+    _ap16.process(_x0, _x0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] = -early2R[i] - _x0[i];
+    }
+    _ap17.process(_x0, _x0, numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        _x0[i] = -early0R[i] + _x0[i];
+    }
+    _mt9.readTap(1, _x0, &_lateOut3[offset], numFrames);
+    _mt9.write(_x0, numFrames);
+}
+
+void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
+
+    // blocks shorter than this are not worth vectorizing
+    const int MIN_LATE_BLOCK = 8;
+
+    int loopDelay = MIN(MIN(_mt6.getDelay(0), _mt7.getDelay(0)), MIN(_mt8.getDelay(0), _mt9.getDelay(0)));
+
+    for (int offset = 0; offset < numFrames; offset += REVERB_BLOCK) {
+        int n = MIN(numFrames - offset, REVERB_BLOCK);
+
+        const float* input0 = &inputs[0][offset];
+        const float* input1 = &inputs[1][offset];
+
+        // Preprocess
+        _bw.process(input0, input1, _x0, _x1, n);
+        _dl0.process(_x0, _preL, n);
+        _dl1.process(_x1, _preR, n);
+
+        // Early
+        processEarly(n);
+
+        // LFO update
+        for (int i = 0; i < n; i++) {
+            _lfo.process(_lfoSin[i], _lfoCos[i]);
+        }
+
+        // Late
+        if (loopDelay < MIN_LATE_BLOCK) {
+            processLate(n);
+        } else {
+            for (int i = 0; i < n; i += loopDelay) {
+                processLateBlock(i, MIN(n - i, loopDelay));
+            }
+        }
 
         // Output Left
-        _ap18.process(-earlyOutL + lateOut0 + lateOut3, x0);
-        _ap19.process(x0, y0);
+        for (int i = 0; i < n; i++) {
+            _x0[i] = -_earlyOutL[i] + _lateOut0[i] + _lateOut3[i];
+        }
+        _ap18.process(_x0, _x0, n);
+        _ap19.process(_x0, _y0, n);
 
         // Output Right
-        _ap20.process(-earlyOutR + lateOut1 + lateOut2, x1);
-        _ap21.process(x1, y1);
-
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
-        outputs[0][i] = x0 + (y0 - x0) * _wetDryMix;
-        outputs[1][i] = x1 + (y1 - x1) * _wetDryMix;
+        for (int i = 0; i < n; i++) {
+            _x1[i] = -_earlyOutR[i] + _lateOut1[i] + _lateOut2[i];
+        }
+        _ap20.process(_x1, _x1, n);
+        _ap21.process(_x1, _y1, n);
+
+        float* output0 = &outputs[0][offset];
+        float* output1 = &outputs[1][offset];
+        for (int i = 0; i < n; i++) {
+            float x0 = input0[i];
+            float x1 = input1[i];
+            output0[i] = x0 + (_y0[i] - x0) * _wetDryMix;
+            output1[i] = x1 + (_y1[i] - x1) * _wetDryMix;
+        }
     }
 }
 
@@ -1720,8 +2075,6 @@ void ReverbImpl::reset() {
 // Public API
 //
 
-static const int REVERB_BLOCK = 256;
-
 AudioReverb::AudioReverb(float sampleRate) {
 
     _impl = new ReverbImpl;
@@ -0,0 +1,135 @@
+//
+//  AudioSPSCRingBuffer.h
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_AudioSPSCRingBuffer_h
+#define hifi_AudioSPSCRingBuffer_h
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+// A ring buffer of samples for exactly one producer thread and one consumer thread.
+// Reads and writes never lock or allocate, so either side may be a device callback.
+// Storage is allocated by resize(), which (like clear()) must only be called while neither side is running.
+template <class T>
+class AudioSPSCRingBuffer {
+public:
+    using Sample = T;
+
+    explicit AudioSPSCRingBuffer(int sampleCapacity = 0) { resize(sampleCapacity); }
+
+    // disallow copying
+    AudioSPSCRingBuffer(const AudioSPSCRingBuffer&) = delete;
+    AudioSPSCRingBuffer& operator=(const AudioSPSCRingBuffer&) = delete;
+
+    void resize(int sampleCapacity) {
+        _bufferLength = std::max(sampleCapacity, 0) + 1;  // one slot is kept empty to tell full from empty
+        _buffer.reset(new Sample[_bufferLength]);
+        clear();
+    }
+
+    void clear() {
+        _readIndex.store(0, std::memory_order_relaxed);
+        _writeIndex.store(0, std::memory_order_relaxed);
+        _overflowCount.store(0, std::memory_order_relaxed);
+    }
+
+    int getSampleCapacity() const { return _bufferLength - 1; }
+
+    /// Return the number of samples the producer could not write because the buffer was full
+    int getOverflowCount() const { return _overflowCount.load(std::memory_order_relaxed); }
+
+    // consumer side
+
+    int samplesAvailable() const {
+        int write = _writeIndex.load(std::memory_order_acquire);
+        int read = _readIndex.load(std::memory_order_relaxed);
+        return (write >= read) ? write - read : write - read + _bufferLength;
+    }
+
+    /// Read up to maxSamples into destination
+    /// Returns number of read samples
+    int readSamples(Sample* destination, int maxSamples) { return appendSamples(destination, maxSamples, false); }
+
+    /// Add up to maxSamples into destination
+    /// If append == false, behaves as readSamples
+    /// Returns number of appended samples
+    int appendSamples(Sample* destination, int maxSamples, bool append = true) {
+        int read = _readIndex.load(std::memory_order_relaxed);
+        int numSamples = std::min(std::max(maxSamples, 0), samplesAvailable());
+
+        // at most two runs, split where the buffer wraps
+        int first = std::min(numSamples, _bufferLength - read);
+        copy(destination, &_buffer[read], first, append);
+        copy(destination + first, &_buffer[0], numSamples - first, append);
+
+        read += numSamples;
+        if (read >= _bufferLength) {
+            read -= _bufferLength;
+        }
+        _readIndex.store(read, std::memory_order_release);
+        return numSamples;
+    }
+
+    // producer side
+
+    int spaceAvailable() const {
+        int read = _readIndex.load(std::memory_order_acquire);
+        int write = _writeIndex.load(std::memory_order_relaxed);
+        return (read > write) ? read - write - 1 : read - write - 1 + _bufferLength;
+    }
+
+    /// Write up to maxSamples from source, without overwriting samples that have not been read
+    /// Returns number of written samples
+    int writeSamples(const Sample* source, int maxSamples) {
+        int write = _writeIndex.load(std::memory_order_relaxed);
+        int numSamples = std::min(std::max(maxSamples, 0), spaceAvailable());
+        if (numSamples < maxSamples) {
+            _overflowCount.fetch_add(maxSamples - numSamples, std::memory_order_relaxed);
+        }
+
+        int first = std::min(numSamples, _bufferLength - write);
+        copy(&_buffer[write], source, first, false);
+        copy(&_buffer[0], source + first, numSamples - first, false);
+
+        write += numSamples;
+        if (write >= _bufferLength) {
+            write -= _bufferLength;
+        }
+        _writeIndex.store(write, std::memory_order_release);
+        return numSamples;
+    }
+
+private:
+    static void copy(Sample* destination, const Sample* source, int numSamples, bool append) {
+        if (append) {
+            for (int i = 0; i < numSamples; i++) {
+                destination[i] += source[i];
+            }
+        } else if (numSamples > 0) {
+            memcpy(destination, source, numSamples * sizeof(Sample));
+        }
+    }
+
+    std::unique_ptr<Sample[]> _buffer;
+    int _bufferLength { 1 };
+
+    // pad the indices onto separate cache lines, so the two threads don't contend for one
+    static const int CACHE_LINE_SIZE = 64;
+    char _padRead[CACHE_LINE_SIZE];
+    std::atomic<int> _readIndex { 0 };
+    char _padWrite[CACHE_LINE_SIZE];
+    std::atomic<int> _writeIndex { 0 };
+    std::atomic<int> _overflowCount { 0 };
+};
+
+#endif // hifi_AudioSPSCRingBuffer_h
@@ -19,6 +19,7 @@
 #include <NodeList.h>
 
 #include "AudioLogging.h"
+#include "AudioSRC.h"
 
 const bool InboundAudioStream::DEFAULT_DYNAMIC_JITTER_BUFFER_ENABLED = true;
 const int InboundAudioStream::DEFAULT_STATIC_JITTER_FRAMES = 1;
@@ -29,8 +30,6 @@ const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_REDUCTION = 10;
 const bool InboundAudioStream::USE_STDEV_FOR_JITTER = false;
 const bool InboundAudioStream::REPETITION_WITH_FADE = true;
 
-static const int STARVE_HISTORY_CAPACITY = 50;
-
 // This is called 1x/s, and we want it to log the last 5s
 static const int UNPLAYED_MS_WINDOW_SECS = 5;
 
@@ -59,7 +58,6 @@ InboundAudioStream::InboundAudioStream(int numChannels, int numFrames, int numBl
     _staticJitterBufferFrames(std::max(numStaticJitterBlocks, DEFAULT_STATIC_JITTER_FRAMES)),
     _desiredJitterBufferFrames(_dynamicJitterBufferEnabled ? 1 : _staticJitterBufferFrames),
     _incomingSequenceNumberStats(STATS_FOR_STATS_PACKET_WINDOW_SECONDS),
-    _starveHistory(STARVE_HISTORY_CAPACITY),
     _unplayedMs(0, UNPLAYED_MS_WINDOW_SECS),
     _timeGapStatsForStatsPacket(0, STATS_FOR_STATS_PACKET_WINDOW_SECONDS) {}
 
@@ -89,9 +87,8 @@ void InboundAudioStream::resetStats() {
     _oldFramesDropped = 0;
     _incomingSequenceNumberStats.reset();
     _lastPacketReceivedTime = 0;
-    _timeGapStatsForDesiredCalcOnTooManyStarves.reset();
-    _timeGapStatsForDesiredReduction.reset();
-    _starveHistory.clear();
+    _calculatedJitterBufferFrames = 0;
+    _playoutModel.reset();
     _framesAvailableStat.reset();
     _currentJitterBufferFrames = 0;
     _timeGapStatsForStatsPacket.reset();
@@ -112,8 +109,6 @@ void InboundAudioStream::setReverb(float reverbTime, float wetLevel) {
 
 void InboundAudioStream::perSecondCallbackForUpdatingStats() {
     _incomingSequenceNumberStats.pushStatsToHistory();
-    _timeGapStatsForDesiredCalcOnTooManyStarves.currentIntervalComplete();
-    _timeGapStatsForDesiredReduction.currentIntervalComplete();
     _timeGapStatsForStatsPacket.currentIntervalComplete();
     _unplayedMs.currentIntervalComplete();
 }
@@ -136,6 +131,8 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
 
     message.seek(prePropertyPosition + propertyBytes);
 
+    int packetsLost = 0;
+
     // handle this packet based on its arrival status.
     switch (arrivalInfo._status) {
         case SequenceNumberStats::Unreasonable: {
@@ -147,13 +144,15 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
             // OnTime packet and this packet were lost. If we're using a codec this will 
             // also result in allowing the codec to interpolate lost data. Then
             // fall through to the "on time" logic to actually handle this packet
-            int packetsDropped = arrivalInfo._seqDiffFromExpected;
-            lostAudioData(packetsDropped);
+            packetsLost = arrivalInfo._seqDiffFromExpected;
+            lostAudioData(packetsLost);
 
             // fall through to OnTime case
         }
         // FALLTHRU
         case SequenceNumberStats::OnTime: {
+            _playoutModel.packetArrived(_lastPacketReceivedTime, packetsLost);
+
             // Packet is on time; parse its data to the ringbuffer
             if (message.getType() == PacketType::SilentAudioFrame
                 || message.getType() == PacketType::ReplicatedSilentAudioFrame) {
@@ -206,7 +205,17 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
         }
     }
 
+    _calculatedJitterBufferFrames = _playoutModel.getTargetFrames();
+    if (_dynamicJitterBufferEnabled) {
+        if (_calculatedJitterBufferFrames != _desiredJitterBufferFrames) {
+            _desiredJitterBufferFrames = _calculatedJitterBufferFrames;
+            qCDebug(audiostream, "Set desired jitter frames to %d (modeled)", _desiredJitterBufferFrames);
+        }
+    }
+
     int framesAvailable = _ringBuffer.framesAvailable();
+    _playoutModel.levelObserved(framesAvailable);
+
     // if this stream was starved, check if we're still starved.
     if (_isStarved && framesAvailable >= _desiredJitterBufferFrames) {
         _isStarved = false;
@@ -277,9 +286,11 @@ int InboundAudioStream::parseAudioData(const QByteArray& packetAfterStreamProper
     QMutexLocker lock(&_decoderMutex);
     if (_decoder) {
         _decoder->decode(packetAfterStreamProperties, decodedBuffer);
+        _decoderNeedsFade = true;
     } else {
         decodedBuffer = packetAfterStreamProperties;
     }
+    stretchForPlayout(decodedBuffer, AudioConstants::SAMPLE_RATE, _numChannels);
     auto actualSize = decodedBuffer.size();
     return _ringBuffer.writeData(decodedBuffer.data(), actualSize);
 }
@@ -292,14 +303,16 @@ int InboundAudioStream::writeDroppableSilentFrames(int silentFrames) {
     // leave the decoder holding some unknown loud state. To handle this 
     // case we will call the decoder's lostFrame() method, which indicates
     // that it should interpolate from its last known state down toward 
-    // silence.
+    // silence. Once faded the decoder holds no such state, so a run of
+    // silent frames (as senders using DTX send through every pause) costs
+    // one concealment, not one per frame.
     {
         // may block on the real-time thread, which is acceptible as 
         // writeDroppableSilentFrames is only called by the packet processing
         // thread which, while high performance, is not as sensitive to
         // delays as the real-time thread.
         QMutexLocker lock(&_decoderMutex);
-        if (_decoder) {
+        if (_decoder && _decoderNeedsFade) {
             // FIXME - We could potentially use the output from the codec, in which 
             // case we might get a cleaner fade toward silence. NOTE: The below logic 
             // attempts to catch up in the event that the jitter buffers have grown. 
@@ -309,6 +322,7 @@ int InboundAudioStream::writeDroppableSilentFrames(int silentFrames) {
             // output to silence.
             QByteArray decodedBuffer;
             _decoder->lostFrame(decodedBuffer);
+            _decoderNeedsFade = false;
         }
     }
 
@@ -427,42 +441,7 @@ void InboundAudioStream::setToStarved() {
     // be considered refilled. in that case, there's no need to set _isStarved to true.
     _isStarved = (_ringBuffer.framesAvailable() < _desiredJitterBufferFrames);
 
-    // record the time of this starve in the starve history
-    quint64 now = usecTimestampNow();
-    _starveHistory.insert(now);
-
-    if (_dynamicJitterBufferEnabled) {
-        // dynamic jitter buffers are enabled. check if this starve put us over the window
-        // starve threshold
-        quint64 windowEnd = now - WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES * USECS_PER_SECOND;
-        RingBufferHistory<quint64>::Iterator starvesIterator = _starveHistory.begin();
-        RingBufferHistory<quint64>::Iterator end = _starveHistory.end();
-        int starvesInWindow = 1;
-        do {
-            ++starvesIterator;
-            if (*starvesIterator < windowEnd) {
-                break;
-            }
-            starvesInWindow++;
-        } while (starvesIterator != end);
-
-        // this starve put us over the starve threshold. update _desiredJitterBufferFrames to
-        // value determined by window A.
-        if (starvesInWindow >= WINDOW_STARVE_THRESHOLD) {
-            int calculatedJitterBufferFrames;
-            // we don't know when the next packet will arrive, so it's possible the gap between the last packet and the
-            // next packet will exceed the max time gap in the window.  If the time since the last packet has already exceeded
-            // the window max gap, then we should use that value to calculate desired frames.
-            int framesSinceLastPacket = ceilf((float)(now - _lastPacketReceivedTime)
-                                              / (float)AudioConstants::NETWORK_FRAME_USECS);
-            calculatedJitterBufferFrames = std::max(_calculatedJitterBufferFrames, framesSinceLastPacket);
-            // make sure _desiredJitterBufferFrames does not become lower here
-            if (calculatedJitterBufferFrames >= _desiredJitterBufferFrames) {
-                _desiredJitterBufferFrames = calculatedJitterBufferFrames;
-                qCInfo(audiostream, "Set desired jitter frames to %d (starved)", _desiredJitterBufferFrames);
-            }
-        }
-    }
+    // under dynamic jitter buffers, the playout model sizes the buffer from the gaps between packets, starved or not
 }
 
 void InboundAudioStream::setDynamicJitterBufferEnabled(bool enable) {
@@ -472,6 +451,7 @@ void InboundAudioStream::setDynamicJitterBufferEnabled(bool enable) {
         if (!_dynamicJitterBufferEnabled) {
             // if we're enabling dynamic jitter buffer frames, start desired frames at 1
             _desiredJitterBufferFrames = 1;
+            _playoutModel.reset();
         }
     }
     _dynamicJitterBufferEnabled = enable;
@@ -486,40 +466,55 @@ void InboundAudioStream::setStaticJitterBufferFrames(int staticJitterBufferFrame
 
 void InboundAudioStream::packetReceivedUpdateTimingStats() {
     
-    // update our timegap stats and desired jitter buffer frames if necessary
+    // update our timegap stats
     // discard the first few packets we receive since they usually have gaps that aren't represensative of normal jitter
     const quint32 NUM_INITIAL_PACKETS_DISCARD = 1000; // 10s
-    quint64 now = usecTimestampNow();
+    quint64 now = getNowUsecs();
     if (_incomingSequenceNumberStats.getReceived() > NUM_INITIAL_PACKETS_DISCARD) {
         quint64 gap = now - _lastPacketReceivedTime;
         _timeGapStatsForStatsPacket.update(gap);
+    }
 
-        // update all stats used for desired frames calculations under dynamic jitter buffer mode
-        _timeGapStatsForDesiredCalcOnTooManyStarves.update(gap);
-        _timeGapStatsForDesiredReduction.update(gap);
+    _lastPacketReceivedTime = now;
+}
 
-        if (_timeGapStatsForDesiredCalcOnTooManyStarves.getNewStatsAvailableFlag()) {
-            _calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredCalcOnTooManyStarves.getWindowMax()
-                                                             / (float) AudioConstants::NETWORK_FRAME_USECS);
-            _timeGapStatsForDesiredCalcOnTooManyStarves.clearNewStatsAvailableFlag();
-        }
+void InboundAudioStream::stretchForPlayout(QByteArray& buffer, int sampleRate, int numChannels) {
+    auto playout = _playoutModel.getPlayout();
+    if (!_dynamicJitterBufferEnabled || playout == AudioPlayoutModel::Playout::Normal || buffer.isEmpty() ||
+        numChannels < 1 || numChannels > SRC_MAX_CHANNELS) {
+        return;
+    }
 
-        if (_dynamicJitterBufferEnabled) {
-            // if the max gap in window B (_timeGapStatsForDesiredReduction) corresponds to a smaller number of frames than _desiredJitterBufferFrames,
-            // then reduce _desiredJitterBufferFrames to that number of frames.
-            if (_timeGapStatsForDesiredReduction.getNewStatsAvailableFlag() && _timeGapStatsForDesiredReduction.isWindowFilled()) {
-                int calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredReduction.getWindowMax()
-                                                         / (float)AudioConstants::NETWORK_FRAME_USECS);
-                if (calculatedJitterBufferFrames < _desiredJitterBufferFrames) {
-                    _desiredJitterBufferFrames = calculatedJitterBufferFrames;
-                    qCInfo(audiostream, "Set desired jitter frames to %d (reduced)", _desiredJitterBufferFrames);
-                }
-                _timeGapStatsForDesiredReduction.clearNewStatsAvailableFlag();
-            }
+    if (sampleRate != _stretchSampleRate || numChannels != _stretchNumChannels) {
+        _accelerateSRC.reset();
+        _decelerateSRC.reset();
+        _stretchSampleRate = sampleRate;
+        _stretchNumChannels = numChannels;
+    }
+
+    // playing a couple of percent off rate shifts the pitch as much, which is far less audible than a starve or a
+    // dropped frame; switching in and out of it costs a small discontinuity, which the model's hysteresis keeps rare
+    AudioSRC* src;
+    if (playout == AudioPlayoutModel::Playout::Accelerate) {
+        if (!_accelerateSRC) {
+            int inputSampleRate = sampleRate * AudioPlayoutModel::ACCELERATE_INPUT_RATE / AudioPlayoutModel::PLAYOUT_OUTPUT_RATE;
+            _accelerateSRC.reset(new AudioSRC(inputSampleRate, sampleRate, numChannels));
         }
+        src = _accelerateSRC.get();
+    } else {
+        if (!_decelerateSRC) {
+            int inputSampleRate = sampleRate * AudioPlayoutModel::DECELERATE_INPUT_RATE / AudioPlayoutModel::PLAYOUT_OUTPUT_RATE;
+            _decelerateSRC.reset(new AudioSRC(inputSampleRate, sampleRate, numChannels));
+        }
+        src = _decelerateSRC.get();
     }
 
-    _lastPacketReceivedTime = now;
+    int inputFrames = buffer.size() / (int)(numChannels * sizeof(int16_t));
+    QByteArray stretchedBuffer(src->getMaxOutput(inputFrames) * numChannels * (int)sizeof(int16_t), 0);
+    int outputFrames = src->render(reinterpret_cast<const int16_t*>(buffer.constData()),
+                                   reinterpret_cast<int16_t*>(stretchedBuffer.data()), inputFrames);
+    stretchedBuffer.resize(outputFrames * numChannels * (int)sizeof(int16_t));
+    buffer = stretchedBuffer;
 }
 
 AudioStreamStats InboundAudioStream::getAudioStreamStats() const {
@@ -574,6 +569,7 @@ void InboundAudioStream::setupCodec(CodecPluginPointer codec, const QString& cod
     if (_codec) {
         QMutexLocker lock(&_decoderMutex);
         _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, numChannels);
+        _decoderNeedsFade = false;
     }
 }
 
@@ -12,6 +12,8 @@
 #ifndef hifi_InboundAudioStream_h
 #define hifi_InboundAudioStream_h
 
+#include <memory>
+
 #include <Node.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
@@ -21,12 +23,15 @@
 
 #include <plugins/CodecPlugin.h>
 
+#include "AudioPlayoutModel.h"
 #include "AudioRingBuffer.h"
 #include "MovingMinMaxAvg.h"
 #include "SequenceNumberStats.h"
 #include "AudioStreamStats.h"
 #include "TimeWeightedAvg.h"
 
+class AudioSRC;
+
 // Audio Env bitset
 const int HAS_REVERB_BIT = 0; // 1st bit
 
@@ -64,17 +69,19 @@ public:
     bool lastPopSucceeded() const { return _lastPopSucceeded; };
     const AudioRingBuffer::ConstIterator& getLastPopOutput() const { return _lastPopOutput; }
 
-    quint64 usecsSinceLastPacket() { return usecTimestampNow() - _lastPacketReceivedTime; }
+    quint64 usecsSinceLastPacket() { return getNowUsecs() - _lastPacketReceivedTime; }
 
     void setToStarved();
 
     void setDynamicJitterBufferEnabled(bool enable);
     void setStaticJitterBufferFrames(int staticJitterBufferFrames);
+    void setTargetConcealmentRate(float targetConcealmentRate) { _playoutModel.setTargetConcealmentRate(targetConcealmentRate); }
 
     virtual AudioStreamStats getAudioStreamStats() const;
 
     /// returns the desired number of jitter buffer frames under the dyanmic jitter buffers scheme
     int getCalculatedJitterBufferFrames() const { return _calculatedJitterBufferFrames; }
+    const AudioPlayoutModel& getPlayoutModel() const { return _playoutModel; }
     
     bool dynamicJitterBufferEnabled() const { return _dynamicJitterBufferEnabled; }
     int getStaticJitterBufferFrames() { return _staticJitterBufferFrames; }
@@ -139,6 +146,13 @@ protected:
 
     /// writes silent frames to the buffer that may be dropped to reduce latency caused by the buffer
     virtual int writeDroppableSilentFrames(int silentFrames);
+
+    /// the time packets are stamped with as they arrive; a test can replay a recorded trace by overriding it
+    virtual quint64 getNowUsecs() const { return usecTimestampNow(); }
+
+    /// under dynamic jitter buffers, resamples audio to play slightly faster or slower,
+    /// steering the buffer toward the size the playout model wants
+    void stretchForPlayout(QByteArray& buffer, int sampleRate, int numChannels);
     
 protected:
 
@@ -165,11 +179,13 @@ protected:
     SequenceNumberStats _incomingSequenceNumberStats;
 
     quint64 _lastPacketReceivedTime { 0 };
-    MovingMinMaxAvg<quint64> _timeGapStatsForDesiredCalcOnTooManyStarves { 0, WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES };
     int _calculatedJitterBufferFrames { 0 };
-    MovingMinMaxAvg<quint64> _timeGapStatsForDesiredReduction { 0, WINDOW_SECONDS_FOR_DESIRED_REDUCTION };
 
-    RingBufferHistory<quint64> _starveHistory;
+    AudioPlayoutModel _playoutModel;
+    std::unique_ptr<AudioSRC> _accelerateSRC;
+    std::unique_ptr<AudioSRC> _decelerateSRC;
+    int _stretchSampleRate { 0 };
+    int _stretchNumChannels { 0 };
 
     TimeWeightedAvg<int> _framesAvailableStat;
     MovingMinMaxAvg<float> _unplayedMs;
@@ -189,6 +205,7 @@ protected:
     QString _selectedCodecName;
     QMutex _decoderMutex;
     Decoder* _decoder { nullptr };
+    bool _decoderNeedsFade { false }; // audio was decoded since the decoder was last faded toward silence
     int _mismatchedAudioCodecCount { 0 };
 };
 
@@ -27,15 +27,16 @@ public:
 
     virtual const QUuid& getStreamIdentifier() const override { return _streamIdentifier; }
 
+protected:
+    const QUuid _streamIdentifier;
+    float _radius;
+    float _attenuationRatio;
+
 private:
     Q_DISABLE_COPY(InjectedAudioStream)
 
     AudioStreamStats getAudioStreamStats() const override;
     int parseStreamProperties(PacketType type, const QByteArray& packetAfterSeqNum, int& numAudioSamples) override;
-
-    const QUuid _streamIdentifier;
-    float _radius;
-    float _attenuationRatio;
 };
 
 #endif // hifi_InjectedAudioStream_h
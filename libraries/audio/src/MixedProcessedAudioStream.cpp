@@ -71,6 +71,7 @@ int MixedProcessedAudioStream::parseAudioData(const QByteArray& packetAfterStrea
     QMutexLocker lock(&_decoderMutex);
     if (_decoder) {
         _decoder->decode(packetAfterStreamProperties, decodedBuffer);
+        _decoderNeedsFade = true;
     } else {
         decodedBuffer = packetAfterStreamProperties;
     }
@@ -80,6 +81,9 @@ int MixedProcessedAudioStream::parseAudioData(const QByteArray& packetAfterStrea
     QByteArray outputBuffer;
     emit processSamples(decodedBuffer, outputBuffer);
 
+    // processing expects whole network frames, so the output is stretched once it is at the device's rate
+    stretchForPlayout(outputBuffer, (int)_outputSampleRate, (int)_outputChannelCount);
+
     _ringBuffer.writeData(outputBuffer.data(), outputBuffer.size());
     qCDebug(audiostream, "Wrote %d samples to buffer (%d available)", outputBuffer.size() / (int)sizeof(int16_t), getSamplesAvailable());
 
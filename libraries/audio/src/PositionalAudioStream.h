@@ -79,6 +79,10 @@ public:
     bool isIgnoreBoxEnabled() const { return _isIgnoreBoxEnabled; }
     const IgnoreBox& getIgnoreBox() const { return _ignoreBox; }
 
+    // set by the mixer each frame, before mixing: a stream mixed into its zone's ambient bed is not mixed per listener
+    void setInAmbientBed(bool isInAmbientBed) { _isInAmbientBed = isInAmbientBed; }
+    bool isInAmbientBed() const { return _isInAmbientBed; }
+
 protected:
     // disallow copying of PositionalAudioStream objects
     PositionalAudioStream(const PositionalAudioStream&);
@@ -108,6 +112,7 @@ protected:
     int _frameCounter;
 
     bool _isIgnoreBoxEnabled { false };
+    bool _isInAmbientBed { false };
     IgnoreBox _ignoreBox;
 };
 
@@ -0,0 +1,187 @@
+//
+//  ResidentInjectedAudioStream.cpp
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ResidentInjectedAudioStream.h"
+
+#include <cstring>
+
+#include <AudioHelpers.h>
+#include <NetworkingConstants.h>
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+#include <SharedUtil.h>
+
+const ResidentInjectedAudioStream::Flags ResidentInjectedAudioStream::LOOP;
+const ResidentInjectedAudioStream::Flags ResidentInjectedAudioStream::AMBIENT;
+const ResidentInjectedAudioStream::Flags ResidentInjectedAudioStream::RESTART;
+const ResidentInjectedAudioStream::Flags ResidentInjectedAudioStream::LOOPBACK;
+const ResidentInjectedAudioStream::Flags ResidentInjectedAudioStream::IGNORE_PENUMBRA;
+const quint64 ResidentInjectedAudioStream::REFRESH_USECS;
+const quint64 ResidentInjectedAudioStream::TIMEOUT_USECS;
+
+ResidentInjectedAudioStream::ResidentInjectedAudioStream(const QUuid& streamIdentifier) :
+    InjectedAudioStream(streamIdentifier, false) {
+}
+
+void ResidentInjectedAudioStream::writeResidentData(NLPacket& packet, const QUuid& streamIdentifier, const QUrl& soundURL,
+                                                    const AudioInjectorOptions& options, Flags flags) {
+    if (options.loop) {
+        flags |= LOOP;
+    }
+    if (options.ambient) {
+        flags |= AMBIENT;
+    }
+    if (options.ignorePenumbra) {
+        flags |= IGNORE_PENUMBRA;
+    }
+
+    packet.write(streamIdentifier.toRfc4122());
+    packet.writeString(soundURL.toString());
+    packet.writePrimitive(flags);
+    packet.writePrimitive(packFloatGainToByte(options.volume));
+    packet.writePrimitive(options.position);
+    packet.writePrimitive(options.orientation);
+    packet.writePrimitive(options.secondOffset);
+}
+
+bool ResidentInjectedAudioStream::isAllowedSoundURL(const QUrl& soundURL) {
+    if (!soundURL.isValid()) {
+        return false;
+    }
+    auto scheme = soundURL.scheme();
+    if (scheme == URL_SCHEME_ATP) {
+        return true;
+    }
+    return (scheme == HIFI_URL_SCHEME_HTTP || scheme == HIFI_URL_SCHEME_HTTPS) && !soundURL.host().isEmpty();
+}
+
+bool ResidentInjectedAudioStream::parseResidentData(ReceivedMessage& message) {
+    QUrl soundURL(message.readString());
+
+    Flags flags;
+    quint8 volume;
+    glm::vec3 position;
+    glm::quat orientation;
+    float secondOffset;
+
+    const qint64 SIZE_AFTER_URL = sizeof(flags) + sizeof(volume) + sizeof(position) + sizeof(orientation) +
+        sizeof(secondOffset);
+    if (!isAllowedSoundURL(soundURL) || message.getBytesLeftToRead() < SIZE_AFTER_URL) {
+        return false;
+    }
+
+    message.readPrimitive(&flags);
+    message.readPrimitive(&volume);
+    message.readPrimitive(&position);
+    message.readPrimitive(&orientation);
+    message.readPrimitive(&secondOffset);
+
+    if (glm::any(glm::isnan(position)) || glm::isnan(orientation.x) || glm::isnan(secondOffset)) {
+        return false;
+    }
+
+    // a new sound, or a restart, plays from the offset; a refresh leaves the sound where it is
+    bool isRestart = (flags & RESTART) || _lastHeardUsecs == 0;
+    if (soundURL != _soundURL) {
+        _soundURL = soundURL;
+        _audioData.reset();
+        isRestart = true;
+    }
+    if (isRestart) {
+        _startFrame = (quint32)(std::max(secondOffset, 0.0f) * AudioConstants::SAMPLE_RATE);
+        _nextFrame = _startFrame;
+    }
+
+    _flags = (Flags)(flags & ~RESTART);
+    _shouldLoopbackForNode = flags & LOOPBACK;
+    _ignorePenumbra = flags & IGNORE_PENUMBRA;
+    _attenuationRatio = unpackFloatGainFromByte(volume);
+    _position = position;
+    _orientation = orientation;
+
+    _lastHeardUsecs = usecTimestampNow();
+    return true;
+}
+
+void ResidentInjectedAudioStream::setAudioData(AudioDataPointer audioData) {
+    _audioData = audioData;
+
+    if (_audioData && _audioData->getNumFrames() > 0 && isLooping()) {
+        _nextFrame %= _audioData->getNumFrames();
+    }
+}
+
+bool ResidentInjectedAudioStream::isPlayedOut() const {
+    return _audioData && (_audioData->getNumFrames() == 0 || (!isLooping() && _nextFrame >= _audioData->getNumFrames()));
+}
+
+void ResidentInjectedAudioStream::renderFrame() {
+    _hasAmbisonicFrame = false;
+
+    // until the sound is decoded there is nothing to pop, which the mixer treats as a starved stream
+    if (!_audioData || isPlayedOut()) {
+        return;
+    }
+
+    const int numChannels = _audioData->getNumChannels();
+    const quint32 numFrames = _audioData->getNumFrames();
+    const AudioConstants::AudioSample* samples = _audioData->data();
+
+    bool isStereo = (numChannels == AudioConstants::STEREO);
+    bool isAmbisonic = (numChannels == AudioConstants::AMBISONIC);
+    if (isStereo != _isStereo) {
+        _ringBuffer.resizeForFrameSize(isStereo ? AudioConstants::NETWORK_FRAME_SAMPLES_STEREO
+                                                : AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        _isStereo = isStereo;
+        _numChannels = isStereo ? AudioConstants::STEREO : AudioConstants::MONO;
+    }
+
+    int16_t frame[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+        if (_nextFrame >= numFrames && isLooping()) {
+            _nextFrame = 0;
+        }
+
+        if (_nextFrame < numFrames) {
+            const AudioConstants::AudioSample* input = &samples[_nextFrame * numChannels];
+            if (isStereo) {
+                frame[2 * i + 0] = input[0];
+                frame[2 * i + 1] = input[1];
+            } else {
+                // mono, or the W channel of an ambisonic sound
+                frame[i] = input[0];
+            }
+            if (isAmbisonic) {
+                memcpy(&_ambisonicFrame[AudioConstants::AMBISONIC * i], input,
+                       AudioConstants::AMBISONIC * sizeof(AudioConstants::AudioSample));
+            }
+            ++_nextFrame;
+        } else {
+            // a one-shot ends partway through the frame
+            if (isStereo) {
+                frame[2 * i + 0] = 0;
+                frame[2 * i + 1] = 0;
+            } else {
+                frame[i] = 0;
+            }
+            if (isAmbisonic) {
+                memset(&_ambisonicFrame[AudioConstants::AMBISONIC * i], 0,
+                       AudioConstants::AMBISONIC * sizeof(AudioConstants::AudioSample));
+            }
+        }
+    }
+    _hasAmbisonicFrame = isAmbisonic;
+
+    _ringBuffer.writeSamples(frame, _ringBuffer.getNumFrameSamples());
+
+    // the sound is already here, so there is no jitter to buffer against
+    _isStarved = false;
+}
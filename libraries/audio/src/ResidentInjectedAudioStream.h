@@ -0,0 +1,83 @@
+//
+//  ResidentInjectedAudioStream.h
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_ResidentInjectedAudioStream_h
+#define hifi_ResidentInjectedAudioStream_h
+
+#include <QtCore/QUrl>
+
+#include <NumericalConstants.h>
+
+#include "AudioInjectorOptions.h"
+#include "InjectedAudioStream.h"
+#include "Sound.h"
+
+class NLPacket;
+class ReceivedMessage;
+
+// An injector that lives in the audio mixer. Rather than streaming its audio, the injector sends the URL of its sound,
+// and its options, and the mixer plays the sound from a copy it has decoded itself. The injector re-sends its state
+// every REFRESH_USECS, which carries any change of options and recovers from lost packets or a restarted mixer.
+class ResidentInjectedAudioStream : public InjectedAudioStream {
+public:
+    using Flags = quint8;
+    static const Flags LOOP = 1;
+    static const Flags AMBIENT = 2;
+    static const Flags RESTART = 4;
+    static const Flags LOOPBACK = 8;
+    static const Flags IGNORE_PENUMBRA = 16;
+
+    static const quint64 REFRESH_USECS = 250 * USECS_PER_MSEC;
+
+    // a looping stream that has not been refreshed for this long is dropped; a one-shot plays out
+    static const quint64 TIMEOUT_USECS = 8 * REFRESH_USECS;
+
+    ResidentInjectedAudioStream(const QUuid& streamIdentifier);
+
+    static void writeResidentData(NLPacket& packet, const QUuid& streamIdentifier, const QUrl& soundURL,
+                                  const AudioInjectorOptions& options, Flags flags);
+
+    // the mixer only fetches sounds from the asset server or the web
+    static bool isAllowedSoundURL(const QUrl& soundURL);
+
+    // parses the packet that follows the stream identifier; returns false if the packet is malformed
+    bool parseResidentData(ReceivedMessage& message);
+
+    const QUrl& getSoundURL() const { return _soundURL; }
+    bool hasAudioData() const { return (bool)_audioData; }
+    void setAudioData(AudioDataPointer audioData);
+
+    bool isLooping() const { return _flags & LOOP; }
+    bool isAmbient() const { return _flags & AMBIENT; }
+    bool isPlayedOut() const;
+    bool isTimedOut(quint64 now) const { return isLooping() && now - _lastHeardUsecs > TIMEOUT_USECS; }
+
+    // writes the next frame of the sound to the ring buffer, ready to be popped; called once per mixer frame
+    void renderFrame();
+
+    // an ambisonic sound is popped as its W channel; this is the whole of the last frame rendered, or null
+    const int16_t* getLastAmbisonicFrame() const { return _hasAmbisonicFrame ? _ambisonicFrame : nullptr; }
+
+private:
+    Q_DISABLE_COPY(ResidentInjectedAudioStream)
+
+    QUrl _soundURL;
+    AudioDataPointer _audioData;
+    Flags _flags { 0 };
+    quint32 _startFrame { 0 };
+    quint32 _nextFrame { 0 };
+    quint64 _lastHeardUsecs { 0 };
+
+    int16_t _ambisonicFrame[AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
+    bool _hasAmbisonicFrame { false };
+};
+
+#endif // hifi_ResidentInjectedAudioStream_h
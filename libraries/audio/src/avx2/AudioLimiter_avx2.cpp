@@ -0,0 +1,220 @@
+//
+//  AudioLimiter_avx2.cpp
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifdef __AVX2__
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "../AudioDynamics.h"
+
+//
+// Block limiter kernels
+// AVX2 version
+//
+
+// signed (a * b) >> 32
+static inline __m256i mulhi(__m256i a, __m256i b) {
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), 32);
+    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+// 2nd-order polynomial from a table of [16][3] coefficients, indexed by the top bits of x
+static_assert(LOG2_TABBITS == EXP2_TABBITS, "log2 and exp2 tables must be the same size");
+static inline __m256i polynomial(const int32_t table[][3], __m256i x) {
+    __m256i k = _mm256_srli_epi32(x, 31 - LOG2_TABBITS);
+    k = _mm256_add_epi32(k, _mm256_slli_epi32(k, 1));   // k * 3
+
+    __m256i c0 = _mm256_i32gather_epi32(&table[0][0], k, 4);
+    __m256i c1 = _mm256_i32gather_epi32(&table[0][1], k, 4);
+    __m256i c2 = _mm256_i32gather_epi32(&table[0][2], k, 4);
+
+    c1 = _mm256_add_epi32(c1, mulhi(c0, x));
+    c2 = _mm256_add_epi32(c2, mulhi(c1, x));
+    return c2;
+}
+
+// -log2(peak) for the absolute float bits of 8 frames
+static inline __m256i log2Peak(__m256i peak) {
+
+    // split into e and x - 1.0
+    __m256i e = _mm256_sub_epi32(_mm256_set1_epi32(IEEE754_EXPN_BIAS + LOG2_HEADROOM),
+                                 _mm256_srli_epi32(peak, IEEE754_MANT_BITS));
+    __m256i x = _mm256_and_si256(_mm256_slli_epi32(peak, IEEE754_EXPN_BITS), _mm256_set1_epi32(0x7fffffff));
+
+    // polynomial for log2(1+x) over x=[0,1]
+    __m256i c2 = polynomial(log2Table, x);
+
+    // reconstruct result in Q26
+    __m256i result = _mm256_sub_epi32(_mm256_slli_epi32(e, LOG2_FRACBITS), _mm256_srai_epi32(c2, 3));
+
+    // saturate when e > 31 or e < 0
+    __m256i sat = _mm256_andnot_si256(_mm256_srai_epi32(e, 31), _mm256_set1_epi32(0x7fffffff));
+    __m256i mask = _mm256_or_si256(_mm256_cmpgt_epi32(e, _mm256_set1_epi32(31)), _mm256_srai_epi32(e, 31));
+
+    return _mm256_blendv_epi8(result, sat, mask);
+}
+
+// max of adjacent pairs, from two vectors in order
+static inline __m256i maxPairs(__m256i a, __m256i b) {
+    __m256 even = _mm256_shuffle_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 odd = _mm256_shuffle_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _MM_SHUFFLE(3, 1, 3, 1));
+    return _mm256_max_epi32(_mm256_castps_si256(even), _mm256_castps_si256(odd));
+}
+
+//
+// Peak detect and convert to log2 domain, for interleaved input
+//
+void peaklog2Block_AVX2(float* input, int32_t* output, int numFrames, int numChannels) {
+
+    assert(numChannels == 1 || numChannels == 2 || numChannels == 4);
+
+    const __m256i FABS_MASK = _mm256_set1_epi32(IEEE754_FABS_MASK);
+    int i = 0;
+
+    for (; i <= numFrames - 8; i += 8) {
+
+        const __m256i* x = (const __m256i*)&input[numChannels * i];
+        __m256i peak;
+
+        if (numChannels == 1) {
+
+            peak = _mm256_and_si256(_mm256_loadu_si256(&x[0]), FABS_MASK);
+
+        } else if (numChannels == 2) {
+
+            __m256i x0 = _mm256_and_si256(_mm256_loadu_si256(&x[0]), FABS_MASK);
+            __m256i x1 = _mm256_and_si256(_mm256_loadu_si256(&x[1]), FABS_MASK);
+
+            // frames in the order 0 1 4 5 2 3 6 7
+            peak = maxPairs(x0, x1);
+            peak = _mm256_permutevar8x32_epi32(peak, _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7));
+
+        } else {
+
+            __m256i x0 = _mm256_and_si256(_mm256_loadu_si256(&x[0]), FABS_MASK);
+            __m256i x1 = _mm256_and_si256(_mm256_loadu_si256(&x[1]), FABS_MASK);
+            __m256i x2 = _mm256_and_si256(_mm256_loadu_si256(&x[2]), FABS_MASK);
+            __m256i x3 = _mm256_and_si256(_mm256_loadu_si256(&x[3]), FABS_MASK);
+
+            // frames in the order 0 2 4 6 1 3 5 7
+            peak = maxPairs(maxPairs(x0, x1), maxPairs(x2, x3));
+            peak = _mm256_permutevar8x32_epi32(peak, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+        }
+
+        _mm256_storeu_si256((__m256i*)&output[i], log2Peak(peak));
+    }
+
+    for (; i < numFrames; i++) {
+        switch (numChannels) {
+        case 1:
+            output[i] = peaklog2(&input[i]);
+            break;
+        case 2:
+            output[i] = peaklog2(&input[2*i+0], &input[2*i+1]);
+            break;
+        case 4:
+            output[i] = peaklog2(&input[4*i+0], &input[4*i+1], &input[4*i+2], &input[4*i+3]);
+            break;
+        }
+    }
+
+    _mm256_zeroupper();
+}
+
+//
+// Convert from log2 domain
+//
+void fixexp2Block_AVX2(const int32_t* input, int32_t* output, int numFrames) {
+
+    int i = 0;
+
+    for (; i <= numFrames - 8; i += 8) {
+
+        __m256i u = _mm256_loadu_si256((const __m256i*)&input[i]);
+
+        // split into e and 1.0 - x
+        __m256i e = _mm256_srli_epi32(u, LOG2_FRACBITS);
+        __m256i x = _mm256_andnot_si256(_mm256_slli_epi32(u, LOG2_INTBITS), _mm256_set1_epi32(0x7fffffff));
+
+        // polynomial for exp2(x)
+        __m256i c2 = polynomial(exp2Table, x);
+
+        // reconstruct result in Q31
+        __m256i result = _mm256_srav_epi32(c2, e);
+
+        // x <= 0 returns 0x7fffffff
+        __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(1), u);
+        result = _mm256_blendv_epi8(result, _mm256_set1_epi32(0x7fffffff), mask);
+
+        _mm256_storeu_si256((__m256i*)&output[i], result);
+    }
+
+    for (; i < numFrames; i++) {
+        output[i] = fixexp2(input[i]);
+    }
+
+    _mm256_zeroupper();
+}
+
+//
+// Apply gain and dither to interleaved input, and store 16-bit output
+//
+void applyGain_AVX2(const float* input, const float* gain, const float* dith, int16_t* output,
+                    int numFrames, int numChannels) {
+
+    assert(numChannels == 1 || numChannels == 2 || numChannels == 4);
+
+    // the frame of each lane, for each vector of 8 frames
+    __m256i frames[4];
+    for (int j = 0; j < numChannels; j++) {
+        frames[j] = _mm256_setr_epi32((8*j+0) / numChannels, (8*j+1) / numChannels, (8*j+2) / numChannels, (8*j+3) / numChannels,
+                                      (8*j+4) / numChannels, (8*j+5) / numChannels, (8*j+6) / numChannels, (8*j+7) / numChannels);
+    }
+
+    int i = 0;
+
+    for (; i <= numFrames - 8; i += 8) {
+
+        __m256 g = _mm256_loadu_ps(&gain[i]);
+        __m256 d = _mm256_loadu_ps(&dith[i]);
+
+        for (int j = 0; j < numChannels; j++) {
+
+            __m256 x = _mm256_loadu_ps(&input[numChannels * i + 8 * j]);
+
+            // apply gain and dither
+            x = _mm256_mul_ps(x, _mm256_permutevar8x32_ps(g, frames[j]));
+            x = _mm256_add_ps(x, _mm256_permutevar8x32_ps(d, frames[j]));
+
+            // convert to int32, and wrap to int16 like the scalar cast
+            __m256i y = _mm256_and_si256(_mm256_cvtps_epi32(x), _mm256_set1_epi32(0xffff));
+            y = _mm256_packus_epi32(y, y);
+            y = _mm256_permute4x64_epi64(y, _MM_SHUFFLE(3, 1, 2, 0));
+
+            _mm_storeu_si128((__m128i*)&output[numChannels * i + 8 * j], _mm256_castsi256_si128(y));
+        }
+    }
+
+    for (; i < numFrames; i++) {
+        for (int j = 0; j < numChannels; j++) {
+            float x = input[numChannels*i+j];
+            x *= gain[i];
+            x += dith[i];
+            output[numChannels*i+j] = (int16_t)floatToInt(x);
+        }
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
@@ -0,0 +1,217 @@
+//
+//  AudioReverb_avx2.cpp
+//  libraries/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+static const int MOD_INTBITS = 4;
+static const int MOD_FRACBITS = 31 - MOD_INTBITS;
+static const uint32_t MOD_FRACMASK = (1 << MOD_FRACBITS) - 1;
+static const float QMOD_TO_FLOAT = 1.0f / (1 << MOD_FRACBITS);
+
+//
+// Block reverb kernels
+// AVX2 version
+//
+
+//
+// output[i] = gain * x[i + offset], where x[k] is input[k] for k >= 0,
+// and was written to the delay buffer before index for k < 0
+//
+void delayTap_AVX2(const float* buffer, int mask, int index, int offset, float gain, const float* input, float* output, int numFrames) {
+
+    __m256 g = _mm256_set1_ps(gain);
+    int i = 0;
+
+    // from the delay buffer, in runs that do not wrap
+    while (i < numFrames && i + offset < 0) {
+        int k = (index + i + offset) & mask;
+        int n = numFrames - i;
+        n = (n < -(i + offset)) ? n : -(i + offset);
+        n = (n < (mask + 1) - k) ? n : (mask + 1) - k;
+
+        const float* src = &buffer[k];
+        float* dst = &output[i];
+        int j = 0;
+        for (; j <= n - 8; j += 8) {
+            _mm256_storeu_ps(&dst[j], _mm256_mul_ps(g, _mm256_loadu_ps(&src[j])));
+        }
+        for (; j < n; j++) {
+            dst[j] = gain * src[j];
+        }
+        i += n;
+    }
+
+    // from the input
+    const float* src = &input[i + offset];
+    float* dst = &output[i];
+    int n = numFrames - i;
+    int j = 0;
+    for (; j <= n - 8; j += 8) {
+        _mm256_storeu_ps(&dst[j], _mm256_mul_ps(g, _mm256_loadu_ps(&src[j])));
+    }
+    for (; j < n; j++) {
+        dst[j] = gain * src[j];
+    }
+
+    _mm256_zeroupper();
+}
+
+// rotate the outputs one sample later, and fill in the previous state
+static inline __m256 delayOutput(__m256 y, float& state) {
+    __m256 r = _mm256_permutevar8x32_ps(y, _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6));
+    __m256 out = _mm256_blend_ps(r, _mm256_set1_ps(state), 0x01);
+    state = _mm256_cvtss_f32(r);
+    return out;
+}
+
+//
+// A block of allpass processing, returns the new output state.
+// Runs 8 samples at a time, whenever the delay is long enough that none of them depend on each other.
+//
+float allpass_AVX2(float* buffer, int mask, int index, int delay, float coef, float state,
+                   const float* input, float* output, int numFrames) {
+
+    __m256 c = _mm256_set1_ps(coef);
+    int i = 0;
+
+    while (i < numFrames) {
+        int k = (index - delay) & mask;
+
+        if (delay >= 8 && i <= numFrames - 8 && index <= mask + 1 - 8 && k <= mask + 1 - 8) {
+
+            __m256 x = _mm256_loadu_ps(&input[i]);
+            __m256 y = _mm256_fnmadd_ps(c, x, _mm256_loadu_ps(&buffer[k]));    // feedforward path
+            _mm256_storeu_ps(&buffer[index], _mm256_fmadd_ps(c, y, x));         // feedback path
+
+            _mm256_storeu_ps(&output[i], delayOutput(y, state));
+
+            index = (index + 8) & mask;
+            i += 8;
+
+        } else {
+
+            float x = input[i];
+            float y = buffer[k] - coef * x;     // feedforward path
+            buffer[index] = x + coef * y;       // feedback path
+            index = (index + 1) & mask;
+
+            output[i] = state;
+            state = y;
+            i += 1;
+        }
+    }
+
+    _mm256_zeroupper();
+    return state;
+}
+
+//
+// A block of modulated allpass processing, returns the new output state.
+// Delay taps are gathered, so only the write needs to be contiguous.
+//
+float allpassMod_AVX2(float* buffer, int mask, int index, int delay, float coef, float state,
+                      const float* input, const int32_t* mod, float* output, int numFrames) {
+
+    // modulation moves the nearest tap by at most this much
+    const int MAX_EXCURSION = (1 << MOD_INTBITS) + 1;
+
+    __m256 c = _mm256_set1_ps(coef);
+    __m256i m = _mm256_set1_epi32(mask);
+    __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    int i = 0;
+
+    while (i < numFrames) {
+
+        if (delay - MAX_EXCURSION >= 8 && delay + MAX_EXCURSION + 8 <= mask + 1 &&
+            i <= numFrames - 8 && index <= mask + 1 - 8) {
+
+            __m256 x = _mm256_loadu_ps(&input[i]);
+            __m256i q = _mm256_loadu_si256((const __m256i*)&mod[i]);
+
+            // add modulation to delay
+            __m256i offset = _mm256_add_epi32(_mm256_set1_epi32(delay), _mm256_srai_epi32(q, MOD_FRACBITS));
+            __m256 frac = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_and_si256(q, _mm256_set1_epi32(MOD_FRACMASK))),
+                                        _mm256_set1_ps(QMOD_TO_FLOAT));
+
+            // 3rd-order Lagrange interpolation
+            __m256i k1 = _mm256_sub_epi32(_mm256_add_epi32(_mm256_set1_epi32(index), lanes), offset);
+            __m256i k0 = _mm256_and_si256(_mm256_add_epi32(k1, _mm256_set1_epi32(1)), m);
+            __m256i k2 = _mm256_and_si256(_mm256_sub_epi32(k1, _mm256_set1_epi32(1)), m);
+            __m256i k3 = _mm256_and_si256(_mm256_sub_epi32(k1, _mm256_set1_epi32(2)), m);
+            k1 = _mm256_and_si256(k1, m);
+
+            __m256 x0 = _mm256_i32gather_ps(buffer, k0, 4);
+            __m256 x1 = _mm256_i32gather_ps(buffer, k1, 4);
+            __m256 x2 = _mm256_i32gather_ps(buffer, k2, 4);
+            __m256 x3 = _mm256_i32gather_ps(buffer, k3, 4);
+
+            // compute the polynomial coefficients
+            __m256 c0 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(1/6.0f), _mm256_sub_ps(x3, x0)),
+                                      _mm256_mul_ps(_mm256_set1_ps(1/2.0f), _mm256_sub_ps(x1, x2)));
+            __m256 c1 = _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(1/2.0f), _mm256_add_ps(x0, x2)), x1);
+            __m256 c2 = _mm256_sub_ps(x2, _mm256_mul_ps(_mm256_set1_ps(1/3.0f), x0));
+            c2 = _mm256_sub_ps(c2, _mm256_mul_ps(_mm256_set1_ps(1/2.0f), x1));
+            c2 = _mm256_sub_ps(c2, _mm256_mul_ps(_mm256_set1_ps(1/6.0f), x3));
+
+            // compute the polynomial
+            __m256 delayMod = _mm256_fmadd_ps(c0, frac, c1);
+            delayMod = _mm256_fmadd_ps(delayMod, frac, c2);
+            delayMod = _mm256_fmadd_ps(delayMod, frac, x1);
+
+            __m256 y = _mm256_fnmadd_ps(c, x, delayMod);                // feedforward path
+            _mm256_storeu_ps(&buffer[index], _mm256_fmadd_ps(c, y, x));  // feedback path
+
+            _mm256_storeu_ps(&output[i], delayOutput(y, state));
+
+            index = (index + 8) & mask;
+            i += 8;
+
+        } else {
+
+            float x = input[i];
+
+            // add modulation to delay
+            int32_t offset = delay + (mod[i] >> MOD_FRACBITS);
+            float frac = (mod[i] & MOD_FRACMASK) * QMOD_TO_FLOAT;
+
+            // 3rd-order Lagrange interpolation
+            float x0 = buffer[(index - (offset-1)) & mask];
+            float x1 = buffer[(index - (offset+0)) & mask];
+            float x2 = buffer[(index - (offset+1)) & mask];
+            float x3 = buffer[(index - (offset+2)) & mask];
+
+            // compute the polynomial coefficients
+            float c0 = (1/6.0f) * (x3 - x0) + (1/2.0f) * (x1 - x2);
+            float c1 = (1/2.0f) * (x0 + x2) - x1;
+            float c2 = x2 - (1/3.0f) * x0 - (1/2.0f) * x1 - (1/6.0f) * x3;
+            float c3 = x1;
+
+            // compute the polynomial
+            float delayMod = ((c0 * frac + c1) * frac + c2) * frac + c3;
+
+            float y = delayMod - coef * x;      // feedforward path
+            buffer[index] = x + coef * y;       // feedback path
+            index = (index + 1) & mask;
+
+            output[i] = state;
+            state = y;
+            i += 1;
+        }
+    }
+
+    _mm256_zeroupper();
+    return state;
+}
+
+#endif
@@ -14,6 +14,7 @@
 
 #include "AvatarData.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <stdint.h>
@@ -2412,6 +2413,7 @@ void AvatarData::setRecordingBasis(std::shared_ptr<Transform> recordingBasis) {
         //recordingBasis->setScale(getTargetScale());
     }
     _recordingBasis = recordingBasis;
+    _recordedFrameState = RecordingFrameState();
 }
 
 void AvatarData::createRecordingIDs() {
@@ -2425,6 +2427,7 @@ void AvatarData::createRecordingIDs() {
 
 void AvatarData::clearRecordingBasis() {
     _recordingBasis.reset();
+    _recordedFrameState = RecordingFrameState();
 }
 
 static const QString JSON_AVATAR_BASIS = QStringLiteral("basisTransform");
@@ -2635,6 +2638,372 @@ void AvatarData::fromJson(const QJsonObject& json, bool useFrameSkeleton) {
     }
 }
 
+// Compact frames start with this instead of the "qbjs" tag of QJsonDocument binary data
+static const char COMPACT_FRAME_TAG[] = { 'o', 'a', 'v', 'f' };
+static const int COMPACT_FRAME_TAG_SIZE = sizeof(COMPACT_FRAME_TAG);
+static const uint8_t COMPACT_FRAME_VERSION = 1;
+
+enum CompactFrameFlags : uint8_t {
+    COMPACT_FRAME_KEYFRAME = 1 << 0, // all joints, and the fields that rarely change
+    COMPACT_FRAME_HAS_BASIS = 1 << 1,
+    COMPACT_FRAME_HAS_RELATIVE = 1 << 2,
+    COMPACT_FRAME_HAS_SCALE = 1 << 3,
+    COMPACT_FRAME_HAS_HEAD = 1 << 4,
+    COMPACT_FRAME_HAS_JOINTS = 1 << 5
+};
+
+// Frames between keyframes, so that playback after a seek catches up quickly
+static const uint32_t COMPACT_FRAME_KEYFRAME_INTERVAL = 45;
+// Translations are quantized against a scale set at each keyframe, with some room for the avatar to stretch
+static const float COMPACT_FRAME_TRANSLATION_HEADROOM = 1.25f;
+static const int PACKED_JOINT_SIZE = 6;
+
+template <typename T>
+static void appendValue(QByteArray& frame, const T& value) {
+    frame.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool readValue(const uint8_t*& cursor, const uint8_t* end, T& value) {
+    if (end - cursor < (ptrdiff_t)sizeof(T)) {
+        return false;
+    }
+    memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+static void appendTransform(QByteArray& frame, const Transform& transform) {
+    appendValue(frame, transform.getTranslation());
+    appendValue(frame, transform.getRotation());
+    appendValue(frame, transform.getScale());
+}
+
+static bool readTransform(const uint8_t*& cursor, const uint8_t* end, Transform& transform) {
+    glm::vec3 translation;
+    glm::quat rotation;
+    glm::vec3 scale;
+    if (!readValue(cursor, end, translation) || !readValue(cursor, end, rotation) || !readValue(cursor, end, scale)) {
+        return false;
+    }
+    transform.setTranslation(translation);
+    transform.setRotation(rotation);
+    transform.setScale(scale);
+    return true;
+}
+
+bool AvatarData::isCompactFrame(const QByteArray& frameData) {
+    return frameData.size() > COMPACT_FRAME_TAG_SIZE && memcmp(frameData.data(), COMPACT_FRAME_TAG, COMPACT_FRAME_TAG_SIZE) == 0;
+}
+
+bool AvatarData::isKeyframe(const QByteArray& frameData) {
+    static const int FLAGS_OFFSET = COMPACT_FRAME_TAG_SIZE + sizeof(COMPACT_FRAME_VERSION);
+    if (!isCompactFrame(frameData)) {
+        return true;
+    }
+    return frameData.size() > FLAGS_OFFSET && (frameData[FLAGS_OFFSET] & COMPACT_FRAME_KEYFRAME);
+}
+
+QByteArray AvatarData::writeCompactFrame(const QJsonObject& json, RecordingFrameState& state) {
+    int version = json.contains(JSON_AVATAR_VERSION) ? json[JSON_AVATAR_VERSION].toInt() : (int)JsonAvatarFrameVersion::JointRotationsInRelativeFrame;
+
+    // Version 0 joint rotations can't be played back, see fromJson
+    QVector<JointData> joints;
+    bool hasJoints = json.contains(JSON_AVATAR_JOINT_ARRAY) && version != (int)JsonAvatarFrameVersion::JointRotationsInRelativeFrame;
+    if (hasJoints) {
+        QJsonArray jointArrayJson = json[JSON_AVATAR_JOINT_ARRAY].toArray();
+        joints.reserve(std::min((int)jointArrayJson.size(), (int)UINT16_MAX));
+        for (const auto& jointJson : jointArrayJson) {
+            if (joints.size() == UINT16_MAX) {
+                break;
+            }
+            joints.push_back(jointDataFromJsonValue(version, jointJson));
+        }
+    }
+    const int numJoints = joints.size();
+
+    float maxTranslationDimension = 0.001f;
+    for (const auto& joint : joints) {
+        if (!joint.translationIsDefaultPose) {
+            maxTranslationDimension = glm::max(maxTranslationDimension, glm::compMax(glm::abs(joint.translation)));
+        }
+    }
+
+    bool isKeyframe = !state.isValid || state.framesSinceKeyframe >= COMPACT_FRAME_KEYFRAME_INTERVAL ||
+        numJoints != state.joints.size() || maxTranslationDimension > state.translationScale;
+    if (isKeyframe) {
+        state.framesSinceKeyframe = 0;
+        state.translationScale = maxTranslationDimension * COMPACT_FRAME_TRANSLATION_HEADROOM;
+        state.joints = QVector<JointData>(numJoints);
+        state.packedJoints.assign(numJoints * 2 * PACKED_JOINT_SIZE, 0);
+    } else {
+        state.framesSinceKeyframe++;
+    }
+    state.frameIndex = state.isValid ? state.frameIndex + 1 : 0;
+    state.isValid = true;
+
+    uint8_t flags = 0;
+    flags |= isKeyframe ? COMPACT_FRAME_KEYFRAME : 0;
+    flags |= json.contains(JSON_AVATAR_BASIS) ? COMPACT_FRAME_HAS_BASIS : 0;
+    flags |= json.contains(JSON_AVATAR_RELATIVE) ? COMPACT_FRAME_HAS_RELATIVE : 0;
+    flags |= json.contains(JSON_AVATAR_SCALE) ? COMPACT_FRAME_HAS_SCALE : 0;
+    flags |= json.contains(JSON_AVATAR_HEAD) ? COMPACT_FRAME_HAS_HEAD : 0;
+    flags |= hasJoints ? COMPACT_FRAME_HAS_JOINTS : 0;
+
+    QByteArray frame;
+    frame.reserve(COMPACT_FRAME_TAG_SIZE + 128 + numJoints * 2 * PACKED_JOINT_SIZE);
+    frame.append(COMPACT_FRAME_TAG, COMPACT_FRAME_TAG_SIZE);
+    appendValue(frame, COMPACT_FRAME_VERSION);
+    appendValue(frame, flags);
+    appendValue(frame, state.frameIndex);
+
+    if (isKeyframe) {
+        // the rest of the frame, which is small and rarely changes
+        QJsonObject rest = json;
+        rest.remove(JSON_AVATAR_BASIS);
+        rest.remove(JSON_AVATAR_RELATIVE);
+        rest.remove(JSON_AVATAR_SCALE);
+        rest.remove(JSON_AVATAR_HEAD);
+        rest.remove(JSON_AVATAR_JOINT_ARRAY);
+        QByteArray restData = QJsonDocument(rest).toJson(QJsonDocument::Compact);
+        appendValue(frame, (uint32_t)restData.size());
+        frame.append(restData);
+    }
+    if (flags & COMPACT_FRAME_HAS_BASIS) {
+        appendTransform(frame, Transform::fromJson(json[JSON_AVATAR_BASIS]));
+    }
+    if (flags & COMPACT_FRAME_HAS_RELATIVE) {
+        appendTransform(frame, Transform::fromJson(json[JSON_AVATAR_RELATIVE]));
+    }
+    if (flags & COMPACT_FRAME_HAS_SCALE) {
+        appendValue(frame, (float)json[JSON_AVATAR_SCALE].toDouble());
+    }
+    if (flags & COMPACT_FRAME_HAS_HEAD) {
+        HeadData::writeCompactFrame(json[JSON_AVATAR_HEAD].toObject(), frame);
+    }
+
+    if (hasJoints) {
+        appendValue(frame, (uint16_t)numJoints);
+        appendValue(frame, state.translationScale);
+
+        // quantize, and find what changed since the previous frame
+        std::vector<uint8_t> packedJoints(numJoints * 2 * PACKED_JOINT_SIZE);
+        std::vector<bool> rotationChanged(numJoints);
+        std::vector<bool> translationChanged(numJoints);
+        for (int i = 0; i < numJoints; i++) {
+            const JointData& joint = joints[i];
+            const JointData& previous = state.joints[i];
+            uint8_t* packedRotation = &packedJoints[i * 2 * PACKED_JOINT_SIZE];
+            uint8_t* packedTranslation = packedRotation + PACKED_JOINT_SIZE;
+            const uint8_t* previousPacked = &state.packedJoints[i * 2 * PACKED_JOINT_SIZE];
+            if (!joint.rotationIsDefaultPose) {
+                packOrientationQuatToSixBytes(packedRotation, joint.rotation);
+                rotationChanged[i] = isKeyframe || previous.rotationIsDefaultPose ||
+                    memcmp(packedRotation, previousPacked, PACKED_JOINT_SIZE) != 0;
+            }
+            if (!joint.translationIsDefaultPose) {
+                packFloatVec3ToSignedTwoByteFixed(packedTranslation, joint.translation / state.translationScale,
+                                                  TRANSLATION_COMPRESSION_RADIX);
+                translationChanged[i] = isKeyframe || previous.translationIsDefaultPose ||
+                    memcmp(packedTranslation, previousPacked + PACKED_JOINT_SIZE, PACKED_JOINT_SIZE) != 0;
+            }
+        }
+
+        int bitVectorSize = calcBitVectorSize(numJoints);
+        int offset = frame.size();
+        frame.resize(offset + 4 * bitVectorSize);
+        uint8_t* bitVectors = reinterpret_cast<uint8_t*>(frame.data()) + offset;
+        bitVectors += writeBitVector(bitVectors, numJoints, [&](int i) { return joints[i].rotationIsDefaultPose; });
+        bitVectors += writeBitVector(bitVectors, numJoints, [&](int i) { return joints[i].translationIsDefaultPose; });
+        bitVectors += writeBitVector(bitVectors, numJoints, [&](int i) { return (bool)rotationChanged[i]; });
+        writeBitVector(bitVectors, numJoints, [&](int i) { return (bool)translationChanged[i]; });
+
+        for (int i = 0; i < numJoints; i++) {
+            if (rotationChanged[i]) {
+                frame.append(reinterpret_cast<const char*>(&packedJoints[i * 2 * PACKED_JOINT_SIZE]), PACKED_JOINT_SIZE);
+                memcpy(&state.packedJoints[i * 2 * PACKED_JOINT_SIZE], &packedJoints[i * 2 * PACKED_JOINT_SIZE], PACKED_JOINT_SIZE);
+            }
+            state.joints[i].rotationIsDefaultPose = joints[i].rotationIsDefaultPose;
+        }
+        for (int i = 0; i < numJoints; i++) {
+            if (translationChanged[i]) {
+                frame.append(reinterpret_cast<const char*>(&packedJoints[i * 2 * PACKED_JOINT_SIZE + PACKED_JOINT_SIZE]), PACKED_JOINT_SIZE);
+                memcpy(&state.packedJoints[i * 2 * PACKED_JOINT_SIZE + PACKED_JOINT_SIZE],
+                       &packedJoints[i * 2 * PACKED_JOINT_SIZE + PACKED_JOINT_SIZE], PACKED_JOINT_SIZE);
+            }
+            state.joints[i].translationIsDefaultPose = joints[i].translationIsDefaultPose;
+        }
+    }
+
+    return frame;
+}
+
+void AvatarData::readCompactFrame(const QByteArray& frameData, bool useFrameSkeleton) {
+    const uint8_t* cursor = reinterpret_cast<const uint8_t*>(frameData.data()) + COMPACT_FRAME_TAG_SIZE;
+    const uint8_t* end = reinterpret_cast<const uint8_t*>(frameData.data()) + frameData.size();
+
+    auto invalidFrame = [&] {
+        _playedFrameState.isValid = false;
+        quint64 now = usecTimestampNow();
+        if (shouldLogError(now)) {
+            qCWarning(avatars) << "Invalid compact avatar recording frame";
+        }
+    };
+
+    uint8_t version;
+    uint8_t flags;
+    uint32_t frameIndex;
+    if (!readValue(cursor, end, version) || !readValue(cursor, end, flags) || !readValue(cursor, end, frameIndex)) {
+        invalidFrame();
+        return;
+    }
+    if (version > COMPACT_FRAME_VERSION) {
+        quint64 now = usecTimestampNow();
+        if (shouldLogError(now)) {
+            qCWarning(avatars) << "Avatar recording frame version" << version << "is newer than supported";
+        }
+        return;
+    }
+    bool isKeyframe = flags & COMPACT_FRAME_KEYFRAME;
+
+    if (isKeyframe) {
+        uint32_t restSize;
+        if (!readValue(cursor, end, restSize) || end - cursor < (ptrdiff_t)restSize) {
+            invalidFrame();
+            return;
+        }
+        QJsonObject rest = QJsonDocument::fromJson(QByteArray::fromRawData(reinterpret_cast<const char*>(cursor), restSize)).object();
+        cursor += restSize;
+
+        if (rest.contains(JSON_AVATAR_BODY_MODEL)) {
+            auto bodyModelURL = rest.value(JSON_AVATAR_BODY_MODEL).toString();
+            if (useFrameSkeleton && bodyModelURL != getSkeletonModelURL().toString()) {
+                setSkeletonModelURL(bodyModelURL);
+            }
+        }
+        QString newDisplayName = rest.value(JSON_AVATAR_DISPLAY_NAME).toString();
+        if (newDisplayName != getDisplayName()) {
+            setDisplayName(newDisplayName);
+        }
+        if (rest.value(JSON_AVATAR_ENTITIES).isArray()) {
+            for (auto avatarEntityJSON : rest.value(JSON_AVATAR_ENTITIES).toArray()) {
+                if (avatarEntityJSON.isObject()) {
+                    QVariantMap entityData = avatarEntityJSON.toObject().toVariantMap();
+                    QUuid id = entityData.value("id").toUuid();
+                    QByteArray data = QByteArray::fromBase64(entityData.value("properties").toByteArray());
+                    updateAvatarEntity(id, data);
+                }
+            }
+        }
+    }
+
+    Transform frameBasis;
+    if ((flags & COMPACT_FRAME_HAS_BASIS) && !readTransform(cursor, end, frameBasis)) {
+        invalidFrame();
+        return;
+    }
+    auto currentBasis = getRecordingBasis();
+    if (!currentBasis) {
+        currentBasis = std::make_shared<Transform>(frameBasis);
+    }
+
+    // See fromJson
+    glm::quat orientation;
+    if (flags & COMPACT_FRAME_HAS_RELATIVE) {
+        Transform relativeTransform;
+        if (!readTransform(cursor, end, relativeTransform)) {
+            invalidFrame();
+            return;
+        }
+        auto worldTransform = currentBasis->worldTransform(relativeTransform);
+        setWorldPosition(worldTransform.getTranslation());
+        orientation = worldTransform.getRotation();
+    } else {
+        setWorldPosition(currentBasis->getTranslation());
+        orientation = currentBasis->getRotation();
+    }
+    setWorldOrientation(orientation);
+    updateAttitude(orientation);
+
+    float scale = 1.0f;
+    if ((flags & COMPACT_FRAME_HAS_SCALE) && !readValue(cursor, end, scale)) {
+        invalidFrame();
+        return;
+    }
+
+    if (flags & COMPACT_FRAME_HAS_HEAD) {
+        if (!_headData) {
+            _headData = new HeadData(this);
+        }
+        int headSize = _headData->readCompactFrame(cursor, (int)(end - cursor));
+        if (headSize < 0) {
+            invalidFrame();
+            return;
+        }
+        cursor += headSize;
+    }
+
+    if (flags & COMPACT_FRAME_HAS_SCALE) {
+        setTargetScale(scale);
+    }
+
+    if (!(flags & COMPACT_FRAME_HAS_JOINTS)) {
+        return;
+    }
+
+    uint16_t numJoints;
+    float translationScale;
+    if (!readValue(cursor, end, numJoints) || !readValue(cursor, end, translationScale)) {
+        invalidFrame();
+        return;
+    }
+
+    // Deltas only apply on top of the frame before them. The deck replays the frames from the last keyframe after a seek,
+    // so this only happens when frames are played out of order some other way: wait for the next keyframe
+    auto& state = _playedFrameState;
+    if (isKeyframe) {
+        state.joints = QVector<JointData>(numJoints);
+    } else if (!state.isValid || state.frameIndex + 1 != frameIndex || state.joints.size() != numJoints) {
+        state.isValid = false;
+        return;
+    }
+
+    int bitVectorSize = calcBitVectorSize(numJoints);
+    if (end - cursor < 4 * bitVectorSize) {
+        invalidFrame();
+        return;
+    }
+    JointData* joints = state.joints.data();
+    std::vector<bool> rotationChanged(numJoints);
+    std::vector<bool> translationChanged(numJoints);
+    cursor += readBitVector(cursor, numJoints, [&](int i, bool value) { joints[i].rotationIsDefaultPose = value; });
+    cursor += readBitVector(cursor, numJoints, [&](int i, bool value) { joints[i].translationIsDefaultPose = value; });
+    cursor += readBitVector(cursor, numJoints, [&](int i, bool value) { rotationChanged[i] = value; });
+    cursor += readBitVector(cursor, numJoints, [&](int i, bool value) { translationChanged[i] = value; });
+
+    int numChanged = (int)std::count(rotationChanged.begin(), rotationChanged.end(), true) +
+        (int)std::count(translationChanged.begin(), translationChanged.end(), true);
+    if (end - cursor < numChanged * PACKED_JOINT_SIZE) {
+        invalidFrame();
+        return;
+    }
+    for (int i = 0; i < numJoints; i++) {
+        if (rotationChanged[i]) {
+            cursor += unpackOrientationQuatFromSixBytes(cursor, joints[i].rotation);
+        }
+    }
+    for (int i = 0; i < numJoints; i++) {
+        if (translationChanged[i]) {
+            cursor += unpackFloatVec3FromSignedTwoByteFixed(cursor, joints[i].translation, TRANSLATION_COMPRESSION_RADIX);
+            joints[i].translation *= translationScale;
+        }
+    }
+
+    state.frameIndex = frameIndex;
+    state.isValid = true;
+    setRawJointData(state.joints);
+}
+
 // Every frame will store both a basis for the recording and a relative transform
 // This allows the application to decide whether playback should be relative to an avatar's
 // transform at the start of playback, or relative to the transform of the recorded
@@ -2648,14 +3017,26 @@ QByteArray AvatarData::toFrame(const AvatarData& avatar) {
         qCDebug(avatars).noquote() << QJsonDocument(obj).toJson(QJsonDocument::JsonFormat::Indented);
     }
 #endif
+    return writeCompactFrame(root, avatar._recordedFrameState);
+}
+
+QByteArray AvatarData::toCompactFrame(const QByteArray& frameData, AvatarData& avatar) {
+    if (isCompactFrame(frameData)) {
+        return frameData;
+    }
     OVERTE_IGNORE_DEPRECATED_BEGIN
-    // Can't use CBOR yet, would break the protocol
-    return QJsonDocument(root).toBinaryData();
+    QJsonDocument doc = QJsonDocument::fromBinaryData(frameData);
     OVERTE_IGNORE_DEPRECATED_END
+    return writeCompactFrame(doc.object(), avatar._recordedFrameState);
 }
 
-
 void AvatarData::fromFrame(const QByteArray& frameData, AvatarData& result, bool useFrameSkeleton) {
+    if (isCompactFrame(frameData)) {
+        result.readCompactFrame(frameData, useFrameSkeleton);
+        return;
+    }
+
+    // Recorded before compact frames
     OVERTE_IGNORE_DEPRECATED_BEGIN
     QJsonDocument doc = QJsonDocument::fromBinaryData(frameData);
     OVERTE_IGNORE_DEPRECATED_END
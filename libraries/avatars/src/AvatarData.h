@@ -600,9 +600,19 @@ public:
 
     static const QString FRAME_NAME;
 
+    // Frames are recorded in a compact binary form, with joints quantized as in avatar data packets. Between keyframes,
+    // a frame only holds the joints that changed since the frame before it, so frames have to be written and read in
+    // order. Frame handlers register isKeyframe() as the keyframe test of the frame type, so that after a seek the deck
+    // replays the frames from the last keyframe. Frames recorded as JSON can still be read.
     static void fromFrame(const QByteArray& frameData, AvatarData& avatar, bool useFrameSkeleton = true);
     static QByteArray toFrame(const AvatarData& avatar);
 
+    static bool isCompactFrame(const QByteArray& frameData);
+    // Whether the frame can be played without the frames before it. Frames recorded as JSON always can.
+    static bool isKeyframe(const QByteArray& frameData);
+    // Converts a frame recorded as JSON. The frames of a clip have to be converted in order, with the same avatar.
+    static QByteArray toCompactFrame(const QByteArray& frameData, AvatarData& avatar);
+
     AvatarData();
     virtual ~AvatarData();
 
@@ -1621,6 +1631,21 @@ protected:
     // During playback, it holds the origin from which to play the relative positions in the clip
     TransformPointer _recordingBasis;
 
+    // The frame that the next compact recording frame is a delta against
+    struct RecordingFrameState {
+        bool isValid { false };
+        uint32_t frameIndex { 0 };
+        uint32_t framesSinceKeyframe { 0 };
+        float translationScale { 0.0f };
+        QVector<JointData> joints;
+        std::vector<uint8_t> packedJoints; // when writing, to find the joints that changed
+    };
+    static QByteArray writeCompactFrame(const QJsonObject& json, RecordingFrameState& state);
+    void readCompactFrame(const QByteArray& frameData, bool useFrameSkeleton);
+
+    mutable RecordingFrameState _recordedFrameState;
+    RecordingFrameState _playedFrameState;
+
     // _globalPosition is sent along with localPosition + parent because the avatar-mixer doesn't know
     // where Entities are located.  This is currently only used by the mixer to decide how often to send
     // updates about one avatar to another.
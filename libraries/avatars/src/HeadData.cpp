@@ -11,7 +11,9 @@
 
 #include "HeadData.h"
 
+#include <cstring>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonArray>
@@ -202,6 +204,128 @@ void HeadData::fromJson(const QJsonObject& json) {
     }
 }
 
+enum CompactHeadFlags : uint8_t {
+    COMPACT_HEAD_HAS_ROTATION = 1 << 0,
+    COMPACT_HEAD_HAS_LOOKAT = 1 << 1
+};
+
+// ARKit blendshapes that replaced a legacy one by a left and right half
+static bool legacyBlendshapeIndices(const QString& name, int& left, int& right) {
+    if (name == "LipsUpperUp") {
+        left = (int)Blendshapes::MouthUpperUp_L;
+        right = (int)Blendshapes::MouthUpperUp_R;
+    } else if (name == "LipsLowerDown") {
+        left = (int)Blendshapes::MouthLowerDown_L;
+        right = (int)Blendshapes::MouthLowerDown_R;
+    } else if (name == "Sneer") {
+        left = (int)Blendshapes::NoseSneer_L;
+        right = (int)Blendshapes::NoseSneer_R;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void HeadData::writeCompactFrame(const QJsonObject& json, QByteArray& frame) {
+    uint8_t flags = 0;
+    glm::quat rotation;
+    if (json.contains(JSON_AVATAR_HEAD_ROTATION)) {
+        flags |= COMPACT_HEAD_HAS_ROTATION;
+        rotation = quatFromJsonValue(json[JSON_AVATAR_HEAD_ROTATION]);
+    }
+    glm::vec3 relativeLookAt;
+    if (json.contains(JSON_AVATAR_HEAD_LOOKAT)) {
+        flags |= COMPACT_HEAD_HAS_LOOKAT;
+        relativeLookAt = vec3FromJsonValue(json[JSON_AVATAR_HEAD_LOOKAT]);
+    }
+
+    std::vector<std::pair<uint8_t, float>> blendshapes;
+    QJsonObject blendshapesJson = json[JSON_AVATAR_HEAD_BLENDSHAPE_COEFFICIENTS].toObject();
+    for (auto it = blendshapesJson.begin(); it != blendshapesJson.end(); ++it) {
+        float value = (float)it.value().toDouble();
+        int index = BLENDSHAPE_LOOKUP_MAP.value(it.key(), -1);
+        int left, right;
+        if (index >= 0) {
+            blendshapes.emplace_back((uint8_t)index, value);
+        } else if (legacyBlendshapeIndices(it.key(), left, right)) {
+            blendshapes.emplace_back((uint8_t)left, value);
+            blendshapes.emplace_back((uint8_t)right, value);
+        }
+    }
+    blendshapes.resize(std::min(blendshapes.size(), (size_t)UINT8_MAX));
+
+    frame.append((const char*)&flags, sizeof(flags));
+    if (flags & COMPACT_HEAD_HAS_ROTATION) {
+        uint8_t packedRotation[6];
+        packOrientationQuatToSixBytes(packedRotation, rotation);
+        frame.append((const char*)packedRotation, sizeof(packedRotation));
+    }
+    if (flags & COMPACT_HEAD_HAS_LOOKAT) {
+        frame.append((const char*)&relativeLookAt, sizeof(relativeLookAt));
+    }
+    uint8_t numBlendshapes = (uint8_t)blendshapes.size();
+    frame.append((const char*)&numBlendshapes, sizeof(numBlendshapes));
+    for (const auto& blendshape : blendshapes) {
+        frame.append((const char*)&blendshape.first, sizeof(blendshape.first));
+        frame.append((const char*)&blendshape.second, sizeof(blendshape.second));
+    }
+}
+
+int HeadData::readCompactFrame(const uint8_t* data, int size) {
+    const uint8_t* cursor = data;
+    const uint8_t* end = data + size;
+
+    if (end - cursor < 1) {
+        return -1;
+    }
+    uint8_t flags = *cursor++;
+
+    if (flags & COMPACT_HEAD_HAS_ROTATION) {
+        if (end - cursor < 6) {
+            return -1;
+        }
+        glm::quat rotation;
+        cursor += unpackOrientationQuatFromSixBytes(cursor, rotation);
+        setHeadOrientation(rotation);
+    }
+
+    if (flags & COMPACT_HEAD_HAS_LOOKAT) {
+        glm::vec3 relativeLookAt;
+        if (end - cursor < (ptrdiff_t)sizeof(relativeLookAt)) {
+            return -1;
+        }
+        memcpy(&relativeLookAt, cursor, sizeof(relativeLookAt));
+        cursor += sizeof(relativeLookAt);
+        if (glm::length2(relativeLookAt) > 0.01f) {
+            setLookAtPosition((_owningAvatar->getWorldOrientation() * relativeLookAt) + _owningAvatar->getWorldPosition());
+        }
+    }
+
+    if (end - cursor < 1) {
+        return -1;
+    }
+    uint8_t numBlendshapes = *cursor++;
+    const int BLENDSHAPE_SIZE = sizeof(uint8_t) + sizeof(float);
+    if (end - cursor < numBlendshapes * BLENDSHAPE_SIZE) {
+        return -1;
+    }
+    for (int i = 0; i < numBlendshapes; i++) {
+        int index = *cursor++;
+        float value;
+        memcpy(&value, cursor, sizeof(value));
+        cursor += sizeof(value);
+        if (_blendshapeCoefficients.size() <= index) {
+            _blendshapeCoefficients.resize(index + 1);
+        }
+        if (_transientBlendshapeCoefficients.size() <= index) {
+            _transientBlendshapeCoefficients.resize(index + 1);
+        }
+        _blendshapeCoefficients[index] = value;
+    }
+
+    return (int)(cursor - data);
+}
+
 bool HeadData::getProceduralAnimationFlag(ProceduralAnimationType type) const {
     return _userProceduralAnimationFlags[(int)type];
 }
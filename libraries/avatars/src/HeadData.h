@@ -102,6 +102,11 @@ public:
     QJsonObject toJson() const;
     void fromJson(const QJsonObject& json);
 
+    // The head section of compact recording frames (see AvatarData::toFrame), written from the JSON of a frame
+    static void writeCompactFrame(const QJsonObject& json, QByteArray& frame);
+    // Returns the number of bytes read, or -1 if the data is not valid
+    int readCompactFrame(const uint8_t* data, int size);
+
 protected:
     // degrees
     float _baseYaw;
@@ -13,6 +13,8 @@
 
 #include "ModelBaker.h"
 
+#include <limits>
+
 #include <PathUtils.h>
 #include <NetworkAccessManager.h>
 #include <NetworkingConstants.h>
@@ -216,7 +218,12 @@ void ModelBaker::bakeSourceCopy() {
         handleError("Error opening " + _originalOutputModelPath + " for reading");
         return;
     }
-    hifi::ByteArray modelData = modelFile.readAll();
+    // Map the file rather than reading it, which saves a copy of the whole model. FBXSerializer copies everything it
+    // keeps out of the data, but other serializers may hold on to it past the mapping, so they get their own copy.
+    qint64 modelSize = modelFile.size();
+    uchar* mappedData = modelSize > 0 && modelSize <= std::numeric_limits<int>::max() ? modelFile.map(0, modelSize) : nullptr;
+    hifi::ByteArray modelData = mappedData ?
+        hifi::ByteArray::fromRawData(reinterpret_cast<const char*>(mappedData), (int)modelSize) : modelFile.readAll();
 
     std::vector<hifi::ByteArray> dracoMeshes;
     std::vector<std::vector<hifi::ByteArray>> dracoMaterialLists; // Material order for per-mesh material lookup used by dracoMeshes
@@ -227,14 +234,24 @@ void ModelBaker::bakeSourceCopy() {
             handleError("Could not recognize file type of model file " + _originalOutputModelPath);
             return;
         }
+        std::shared_ptr<FBXSerializer> fbxSerializer = std::dynamic_pointer_cast<FBXSerializer>(serializer);
+        if (mappedData && !fbxSerializer) {
+            modelData = hifi::ByteArray(reinterpret_cast<const char*>(mappedData), (int)modelSize);
+            modelFile.unmap(mappedData);
+            mappedData = nullptr;
+        }
         hifi::VariantHash serializerMapping = _mapping;
         serializerMapping["combineParts"] = true; // set true so that OBJSerializer reads material info from material library
         serializerMapping["deduplicateIndices"] = true; // Draco compression also deduplicates, but we might as well shave it off to save on some earlier processing (currently FBXSerializer only)
         hfm::Model::Pointer loadedModel = serializer->read(modelData, serializerMapping, _modelURL);
+        if (mappedData) {
+            modelData = hifi::ByteArray();
+            modelFile.unmap(mappedData);
+            mappedData = nullptr;
+        }
 
         // Temporarily support copying the pre-parsed node from FBXSerializer, for better performance in FBXBaker
         // TODO: Pure HFM baking
-        std::shared_ptr<FBXSerializer> fbxSerializer = std::dynamic_pointer_cast<FBXSerializer>(serializer);
         if (fbxSerializer) {
             qCDebug(model_baking) << "Parsing" << _modelURL;
             _rootNode = fbxSerializer->_rootNode;
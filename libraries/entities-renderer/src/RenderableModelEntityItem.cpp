@@ -1324,7 +1324,14 @@ void ModelEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEntityPoint
             scene->enqueueTransaction(transaction);
         });
         entity->setModel(model);
-        model->setLoadingPriorityOperator([entity]() {
+        // the operator is copied into every texture of the model, which the texture cache can keep long after the
+        // entity is deleted, so it must not keep the entity alive
+        std::weak_ptr<RenderableModelEntityItem> weakEntity = entity;
+        model->setLoadingPriorityOperator([weakEntity]() {
+            auto entity = weakEntity.lock();
+            if (!entity) {
+                return 0.0f;
+            }
             float loadPriority = entity->getLoadPriority();
             return fabs(loadPriority) > EPSILON ? loadPriority : EntityTreeRenderer::getEntityLoadingPriority(*entity);
         });
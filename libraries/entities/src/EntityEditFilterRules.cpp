@@ -0,0 +1,309 @@
+//
+//  EntityEditFilterRules.cpp
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EntityEditFilterRules.h"
+
+#include <cfloat>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+struct EntityEditFilterRules::Accessor {
+    const char* name;
+    bool isVec3;
+    bool (*changed)(const EntityItemProperties& properties);
+    glm::vec3 (*get)(const EntityItemProperties& properties);
+    void (*set)(EntityItemProperties& properties, const glm::vec3& value);
+};
+
+#define VEC3_ACCESSOR(N, n)                                                             \
+    { #n, true,                                                                         \
+      [](const EntityItemProperties& p) { return p.n##Changed(); },                     \
+      [](const EntityItemProperties& p) { return glm::vec3(p.get##N()); },              \
+      [](EntityItemProperties& p, const glm::vec3& v) { p.set##N(v); } }
+
+#define FLOAT_ACCESSOR(N, n, T)                                                         \
+    { #n, false,                                                                        \
+      [](const EntityItemProperties& p) { return p.n##Changed(); },                     \
+      [](const EntityItemProperties& p) { return glm::vec3((float)p.get##N()); },       \
+      [](EntityItemProperties& p, const glm::vec3& v) { p.set##N((T)v.x); } }
+
+// the properties that are edited at high rate (physics, particle tweaking) and worth filtering natively
+static const EntityEditFilterRules::Accessor ACCESSORS[] = {
+    VEC3_ACCESSOR(Position, position),
+    VEC3_ACCESSOR(Dimensions, dimensions),
+    VEC3_ACCESSOR(Velocity, velocity),
+    VEC3_ACCESSOR(AngularVelocity, angularVelocity),
+    VEC3_ACCESSOR(Gravity, gravity),
+    VEC3_ACCESSOR(Acceleration, acceleration),
+    FLOAT_ACCESSOR(Density, density, float),
+    FLOAT_ACCESSOR(Damping, damping, float),
+    FLOAT_ACCESSOR(AngularDamping, angularDamping, float),
+    FLOAT_ACCESSOR(Restitution, restitution, float),
+    FLOAT_ACCESSOR(Friction, friction, float),
+    FLOAT_ACCESSOR(Lifetime, lifetime, float),
+    FLOAT_ACCESSOR(MaxParticles, maxParticles, quint32),
+    FLOAT_ACCESSOR(Lifespan, lifespan, float),
+    FLOAT_ACCESSOR(EmitRate, emitRate, float),
+    FLOAT_ACCESSOR(EmitSpeed, emitSpeed, float),
+    FLOAT_ACCESSOR(ParticleRadius, particleRadius, float),
+};
+
+#undef VEC3_ACCESSOR
+#undef FLOAT_ACCESSOR
+
+const EntityEditFilterRules::Accessor* EntityEditFilterRules::findAccessor(const QString& propertyName) {
+    for (const auto& accessor : ACCESSORS) {
+        if (propertyName == accessor.name) {
+            return &accessor;
+        }
+    }
+    return nullptr;
+}
+
+static uint8_t filterTypeBit(EntityTree::FilterType filterType) {
+    return 1 << (uint8_t)filterType;
+}
+
+static bool readBound(const QJsonValue& value, float defaultValue, glm::vec3& bound) {
+    if (value.isUndefined()) {
+        bound = glm::vec3(defaultValue);
+        return true;
+    }
+    if (value.isDouble()) {
+        bound = glm::vec3((float)value.toDouble());
+        return true;
+    }
+    QJsonArray array = value.toArray();
+    if (array.size() == 3) {
+        bound = glm::vec3((float)array[0].toDouble(), (float)array[1].toDouble(), (float)array[2].toDouble());
+        return true;
+    }
+    return false;
+}
+
+EntityEditFilterRulesPointer EntityEditFilterRules::compile(const QByteArray& data, QString& error) {
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(data, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+        // not a rules document, let the caller try it as a script
+        return nullptr;
+    }
+
+    const QJsonObject root = document.object();
+    if (!root.contains("rules") || !root["rules"].isArray()) {
+        error = "rules document has no \"rules\" array";
+        return nullptr;
+    }
+
+    auto rules = std::make_shared<EntityEditFilterRules>();
+
+    if (root.contains("filterTypes")) {
+        for (const auto& value : root["filterTypes"].toArray()) {
+            QString type = value.toString();
+            if (type == "add") {
+                rules->_filterTypes |= filterTypeBit(EntityTree::FilterType::Add);
+            } else if (type == "edit") {
+                rules->_filterTypes |= filterTypeBit(EntityTree::FilterType::Edit);
+            } else if (type == "physics") {
+                rules->_filterTypes |= filterTypeBit(EntityTree::FilterType::Physics);
+            } else if (type == "delete") {
+                rules->_filterTypes |= filterTypeBit(EntityTree::FilterType::Delete);
+            } else {
+                error = QString("unknown filter type \"%1\"").arg(type);
+                return nullptr;
+            }
+        }
+    } else {
+        // same defaults as script filters
+        rules->_filterTypes = filterTypeBit(EntityTree::FilterType::Add) | filterTypeBit(EntityTree::FilterType::Edit) |
+            filterTypeBit(EntityTree::FilterType::Physics);
+    }
+
+    for (const auto& value : root["rules"].toArray()) {
+        const QJsonObject rule = value.toObject();
+
+        if (rule.contains("clamp") || rule.contains("reject")) {
+            RangeRule rangeRule;
+            rangeRule.type = rule.contains("clamp") ? RuleType::Clamp : RuleType::Reject;
+            QString propertyName = rule[rangeRule.type == RuleType::Clamp ? "clamp" : "reject"].toString();
+            rangeRule.accessor = findAccessor(propertyName);
+            if (!rangeRule.accessor) {
+                error = QString("property \"%1\" can't be used in a range rule").arg(propertyName);
+                return nullptr;
+            }
+            if (!readBound(rule["min"], -FLT_MAX, rangeRule.min) || !readBound(rule["max"], FLT_MAX, rangeRule.max)) {
+                error = QString("invalid bounds for \"%1\"").arg(propertyName);
+                return nullptr;
+            }
+            rangeRule.maxLength = (float)rule["maxLength"].toDouble(FLT_MAX);
+            rules->_rangeRules.push_back(rangeRule);
+        } else if (rule.contains("keepInsideZone")) {
+            QString mode = rule["keepInsideZone"].toString();
+            if (mode == "reject") {
+                rules->_keepInsideZone = ZoneMode::Reject;
+            } else if (mode == "clamp") {
+                rules->_keepInsideZone = ZoneMode::Clamp;
+            } else {
+                error = QString("keepInsideZone must be \"reject\" or \"clamp\", not \"%1\"").arg(mode);
+                return nullptr;
+            }
+        } else if (rule.contains("lockedProperties")) {
+            for (const auto& name : rule["lockedProperties"].toArray()) {
+                EntityPropertyInfo propertyInfo;
+                if (!EntityItemProperties::getPropertyInfo(name.toString(), propertyInfo)) {
+                    error = QString("unknown property \"%1\"").arg(name.toString());
+                    return nullptr;
+                }
+                for (int flag = (int)propertyInfo.propertyEnums.firstFlag(); flag <= (int)propertyInfo.propertyEnums.lastFlag(); flag++) {
+                    if (propertyInfo.propertyEnums.getHasProperty((EntityPropertyList)flag)) {
+                        rules->_lockedProperties.push_back((EntityPropertyList)flag);
+                    }
+                }
+            }
+        } else if (rule.contains("rateLimit")) {
+            rules->_rateLimit = (float)rule["rateLimit"].toDouble();
+            rules->_rateLimitBurst = (float)rule["burst"].toDouble(rules->_rateLimit);
+            if (rules->_rateLimit <= 0.0f || rules->_rateLimitBurst < 1.0f) {
+                error = "rateLimit and burst must be positive";
+                return nullptr;
+            }
+        } else {
+            error = QString("unknown rule %1").arg(QString(QJsonDocument(rule).toJson(QJsonDocument::Compact)));
+            return nullptr;
+        }
+    }
+
+    return rules;
+}
+
+bool EntityEditFilterRules::wantsToFilter(EntityTree::FilterType filterType) const {
+    return (_filterTypes & filterTypeBit(filterType)) != 0;
+}
+
+bool EntityEditFilterRules::applyRangeRule(const RangeRule& rule, EntityItemProperties& properties, bool& wasChanged) const {
+    if (!rule.accessor->changed(properties)) {
+        return true;
+    }
+
+    glm::vec3 value = rule.accessor->get(properties);
+    glm::vec3 clamped = glm::clamp(value, rule.min, rule.max);
+    if (rule.accessor->isVec3) {
+        float length = glm::length(clamped);
+        if (length > rule.maxLength) {
+            clamped *= rule.maxLength / length;
+        }
+    } else {
+        clamped = glm::vec3(std::min(clamped.x, rule.maxLength));
+    }
+
+    if (clamped == value) {
+        return true;
+    }
+    if (rule.type == RuleType::Reject) {
+        return false;
+    }
+    rule.accessor->set(properties, clamped);
+    wasChanged = true;
+    return true;
+}
+
+bool EntityEditFilterRules::consumeRateLimitToken(RateLimitBuckets& buckets, const QUuid& key) {
+    quint64 now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_rateLimitLock);
+
+    // a full bucket carries no state, so drop them now and then to keep the tables from growing with every entity
+    // ever edited and every sender ever connected
+    const quint64 RATE_LIMIT_EXPIRY_USECS = 10 * USECS_PER_SECOND;
+    const int MAX_RATE_LIMIT_BUCKETS = 100000;
+    if (now - _lastRateLimitExpiry > RATE_LIMIT_EXPIRY_USECS || buckets.size() > MAX_RATE_LIMIT_BUCKETS) {
+        expireRateLimitBuckets(_editRateLimitBuckets, now);
+        expireRateLimitBuckets(_addRateLimitBuckets, now);
+        _lastRateLimitExpiry = now;
+    }
+
+    auto it = buckets.find(key);
+    if (it == buckets.end()) {
+        it = buckets.insert(key, { _rateLimitBurst, now });
+    }
+
+    auto& bucket = it.value();
+    float elapsed = (float)(now - bucket.lastRefill) / (float)USECS_PER_SECOND;
+    bucket.tokens = std::min(_rateLimitBurst, bucket.tokens + elapsed * _rateLimit);
+    bucket.lastRefill = now;
+
+    if (bucket.tokens < 1.0f) {
+        return false;
+    }
+    bucket.tokens -= 1.0f;
+    return true;
+}
+
+void EntityEditFilterRules::expireRateLimitBuckets(RateLimitBuckets& buckets, quint64 now) {
+    for (auto it = buckets.begin(); it != buckets.end();) {
+        float refilled = it->tokens + (float)(now - it->lastRefill) / (float)USECS_PER_SECOND * _rateLimit;
+        if (refilled >= _rateLimitBurst) {
+            it = buckets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool EntityEditFilterRules::apply(EntityItemProperties& properties, EntityTree::FilterType filterType, const EntityItemID& entityID,
+                                  const EntityItemPointer& existingEntity, const AABox* zoneBox, bool& wasChanged,
+                                  const QUuid& senderID) {
+    if (!wantsToFilter(filterType)) {
+        return true;
+    }
+
+    if (filterType == EntityTree::FilterType::Edit || filterType == EntityTree::FilterType::Physics) {
+        auto changedProperties = properties.getChangedProperties();
+        for (auto property : _lockedProperties) {
+            if (changedProperties.getHasProperty(property)) {
+                return false;
+            }
+        }
+    }
+
+    for (const auto& rule : _rangeRules) {
+        if (!applyRangeRule(rule, properties, wasChanged)) {
+            return false;
+        }
+    }
+
+    if (zoneBox && _keepInsideZone != ZoneMode::None && properties.positionChanged()) {
+        // only world positions can be checked against the zone
+        bool hasParent = existingEntity ? !existingEntity->getParentID().isNull() : !properties.getParentID().isNull();
+        glm::vec3 position = properties.getPosition();
+        if (!hasParent && !zoneBox->contains(position)) {
+            if (_keepInsideZone == ZoneMode::Reject) {
+                return false;
+            }
+            properties.setPosition(glm::clamp(position, zoneBox->getMinimumPoint(), zoneBox->getMaximumPoint()));
+            wasChanged = true;
+        }
+    }
+
+    if (_rateLimit > 0.0f) {
+        // an add has no entity to limit yet; limiting them all together would let one sender use up everyone's adds
+        bool isAdd = filterType == EntityTree::FilterType::Add;
+        if (!consumeRateLimitToken(isAdd ? _addRateLimitBuckets : _editRateLimitBuckets, isAdd ? senderID : entityID)) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,129 @@
+//
+//  EntityEditFilterRules.h
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_EntityEditFilterRules_h
+#define hifi_EntityEditFilterRules_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+
+#include "EntityItemID.h"
+#include "EntityItemProperties.h"
+#include "EntityTree.h"
+
+class EntityEditFilterRules;
+using EntityEditFilterRulesPointer = std::shared_ptr<EntityEditFilterRules>;
+
+/// A declarative entity edit filter, compiled to native checks so edits can be filtered without a script engine.
+///
+/// Rules are read from a JSON document:
+/// @code
+/// {
+///     "filterTypes": [ "add", "edit", "physics" ],
+///     "rules": [
+///         { "clamp": "velocity", "min": -10, "max": 10 },
+///         { "clamp": "dimensions", "max": [ 20, 20, 20 ] },
+///         { "clamp": "angularVelocity", "maxLength": 6.28 },
+///         { "reject": "emitRate", "max": 1000 },
+///         { "keepInsideZone": "clamp" },
+///         { "lockedProperties": [ "serverScripts", "script", "locked" ] },
+///         { "rateLimit": 30, "burst": 60 }
+///     ]
+/// }
+/// @endcode
+///
+/// <code>clamp</code> rules clamp a changed property into range, <code>reject</code> rules reject the edit when a changed
+/// property is out of range. <code>keepInsideZone</code> either rejects or clamps a position that leaves the filtering
+/// zone. <code>lockedProperties</code> rejects edits (but not adds) changing any of the listed properties.
+/// <code>rateLimit</code> allows that many edits per second and per entity, with bursts of up to <code>burst</code> edits;
+/// adds, which have no entity yet, are limited per sender instead.
+///
+/// Rules are evaluated in order, and evaluation is thread safe. Since rules need no script engine, the entity server runs
+/// them ahead of the script filters, as it splits up an edit packet: an edit a rule rejects never reaches a script filter,
+/// and script filters see the edit as the rules clamped it.
+class EntityEditFilterRules {
+public:
+    /// Compiles the rules in a JSON document.
+    /// @return The compiled rules, or nullptr if the data isn't a JSON rules document, in which case error is set if it
+    /// looked like one but couldn't be compiled.
+    static EntityEditFilterRulesPointer compile(const QByteArray& data, QString& error);
+
+    bool wantsToFilter(EntityTree::FilterType filterType) const;
+
+    /// Applies the rules to an edit.
+    /// @param properties The edit, modified in place by clamp rules.
+    /// @param zoneBox The bounds of the filtering zone, or nullptr for the domain-wide filter.
+    /// @param wasChanged Set to true if a rule modified the edit.
+    /// @param senderID The node that sent the edit, which adds are rate limited by.
+    /// @return false if the edit is rejected.
+    bool apply(EntityItemProperties& properties, EntityTree::FilterType filterType, const EntityItemID& entityID,
+               const EntityItemPointer& existingEntity, const AABox* zoneBox, bool& wasChanged,
+               const QUuid& senderID = QUuid());
+
+    bool needsZoneBox() const { return _keepInsideZone != ZoneMode::None; }
+
+    /// Reads and writes one of the properties that can be used in range rules
+    struct Accessor;
+
+private:
+    enum class RuleType {
+        Clamp,
+        Reject
+    };
+
+    enum class ZoneMode {
+        None,
+        Reject,
+        Clamp
+    };
+
+    struct RangeRule {
+        RuleType type;
+        const Accessor* accessor;
+        glm::vec3 min;
+        glm::vec3 max;
+        float maxLength;
+    };
+
+    struct RateLimitBucket {
+        float tokens;
+        quint64 lastRefill;
+    };
+
+    static const Accessor* findAccessor(const QString& propertyName);
+    bool applyRangeRule(const RangeRule& rule, EntityItemProperties& properties, bool& wasChanged) const;
+    using RateLimitBuckets = QHash<QUuid, RateLimitBucket>;
+    bool consumeRateLimitToken(RateLimitBuckets& buckets, const QUuid& key);
+    void expireRateLimitBuckets(RateLimitBuckets& buckets, quint64 now);
+
+    uint8_t _filterTypes { 0 };
+    std::vector<RangeRule> _rangeRules;
+    std::vector<EntityPropertyList> _lockedProperties;
+    ZoneMode _keepInsideZone { ZoneMode::None };
+
+    float _rateLimit { 0.0f };
+    float _rateLimitBurst { 0.0f };
+    std::mutex _rateLimitLock;
+    RateLimitBuckets _editRateLimitBuckets;  // by entity
+    RateLimitBuckets _addRateLimitBuckets;   // by sender
+    quint64 _lastRateLimitExpiry { 0 };
+};
+
+#endif // hifi_EntityEditFilterRules_h
@@ -48,7 +48,8 @@ QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
 }
 
 bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut,
-        bool& wasChanged, EntityTree::FilterType filterType, EntityItemID& itemID, const EntityItemPointer& existingEntity) {
+        bool& wasChanged, EntityTree::FilterType filterType, EntityItemID& itemID, const EntityItemPointer& existingEntity,
+        EntityTree::FilterPass pass, const QUuid& senderID) {
 
     // get the ids of all the zones (plus the global entity edit filter) that the position
     // lies within
@@ -68,6 +69,36 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 return false;
             }
 
+            if (filterData.rules) {
+                if (pass == EntityTree::FilterPass::ScriptOnly) {
+                    continue;
+                }
+
+                AABox zoneBox;
+                bool hasZoneBox = false;
+                if (filterData.rules->needsZoneBox() && !id.isInvalidID()) {
+                    auto zoneEntity = _tree->findEntityByEntityItemID(id);
+                    if (zoneEntity) {
+                        zoneBox = zoneEntity->getAABox(hasZoneBox);
+                    }
+                }
+
+                bool rulesChangedProperties = false;
+                if (!filterData.rules->apply(propertiesIn, filterType, itemID, existingEntity, hasZoneBox ? &zoneBox : nullptr,
+                                             rulesChangedProperties, senderID)) {
+                    return false;
+                }
+                if (rulesChangedProperties) {
+                    propertiesOut = propertiesIn;
+                    wasChanged = true;
+                }
+                continue;
+            }
+
+            if (pass == EntityTree::FilterPass::NativeOnly) {
+                continue;
+            }
+
             // check to see if this filter wants to filter this message type
             if ((!filterData.wantsToFilterEdit && filterType == EntityTree::FilterType::Edit) ||
                 (!filterData.wantsToFilterPhysics && filterType == EntityTree::FilterType::Physics) ||
@@ -172,6 +203,17 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
 void EntityEditFilters::removeFilter(EntityItemID entityID) {
     QWriteLocker writeLock(&_lock);
     _filterDataMap.remove(entityID);
+    updateNativeFilterCount();
+}
+
+void EntityEditFilters::updateNativeFilterCount() {
+    int numNativeFilters = 0;
+    for (const auto& filterData : _filterDataMap) {
+        if (filterData.rules) {
+            numNativeFilters++;
+        }
+    }
+    _numNativeFilters = numNativeFilters;
 }
 
 void EntityEditFilters::addFilter(EntityItemID entityID, QString filterURL) {
@@ -245,6 +287,30 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
     if (scriptRequest && scriptRequest->getResult() == ResourceRequest::Success) {
         const QString urlString = scriptRequest->getUrl().toString();
         auto scriptContents = scriptRequest->getData();
+
+        // a JSON rules document is compiled to native checks, anything else is evaluated as a script filter
+        QString rulesError;
+        auto rules = EntityEditFilterRules::compile(scriptContents, rulesError);
+        if (rules) {
+            FilterData filterData;
+            filterData.rules = rules;
+            filterData.rejectAll = false;
+
+            _lock.lockForWrite();
+            _filterDataMap.insert(entityID, filterData);
+            updateNativeFilterCount();
+            _lock.unlock();
+
+            qDebug() << "native filter rules processed for entity id " << entityID;
+
+            emit filterAdded(entityID, true);
+            return;
+        } else if (!rulesError.isEmpty()) {
+            qCritical() << "Failed to compile entity edit filter rules" << urlString << ":" << rulesError;
+            emit filterAdded(entityID, false);
+            return;
+        }
+
         qInfo() << "Downloaded script:" << scriptContents;
         // create a ScriptEngine for this script
         ScriptManagerPointer manager = newScriptManager(ScriptManager::ENTITY_SERVER_SCRIPT, "", urlString);
@@ -17,10 +17,12 @@
 #include <QMap>
 #include <glm/glm.hpp>
 
+#include <atomic>
 #include <functional>
 
 #include <ScriptValue.h>
 
+#include "EntityEditFilterRules.h"
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
 #include "EntityTree.h"
@@ -31,6 +33,7 @@ class EntityEditFilters : public QObject, public Dependency {
     Q_OBJECT
 public:
     struct FilterData {
+        EntityEditFilterRulesPointer rules;
         ScriptValue filterFn;
         bool wantsOriginalProperties { false };
         bool wantsZoneProperties { false };
@@ -49,7 +52,7 @@ public:
         bool rejectAll;
         
         FilterData(): rejectAll(false) {};
-        bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
+        bool valid() { return (rejectAll || rules || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
     };
 
     EntityEditFilters() {};
@@ -59,7 +62,10 @@ public:
     void removeFilter(EntityItemID entityID);
 
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
-                EntityTree::FilterType filterType, EntityItemID& entityID, const EntityItemPointer& existingEntity);
+                EntityTree::FilterType filterType, EntityItemID& entityID, const EntityItemPointer& existingEntity,
+                EntityTree::FilterPass pass = EntityTree::FilterPass::All, const QUuid& senderID = QUuid());
+
+    bool hasNativeFilters() const { return _numNativeFilters > 0; }
 
 signals:
     void filterAdded(EntityItemID id, bool success);
@@ -69,13 +75,15 @@ private slots:
     
 private:
     QList<EntityItemID> getZonesByPosition(glm::vec3& position);
+    void updateNativeFilterCount();
 
     EntityTreePointer _tree {};
     bool _rejectAll {false};
     ScriptValue _nullObjectForFilter{};
     
-    QReadWriteLock _lock;
+    mutable QReadWriteLock _lock;
     QMap<EntityItemID, FilterData> _filterDataMap;
+    std::atomic<int> _numNativeFilters { 0 };
 };
 
 #endif //hifi_EntityEditFilters_h
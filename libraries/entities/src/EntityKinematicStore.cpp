@@ -0,0 +1,257 @@
+//
+//  EntityKinematicStore.cpp
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EntityKinematicStore.h"
+
+#include <algorithm>
+
+#include <glm/gtx/norm.hpp>
+
+#include <NumericalConstants.h>
+#include <PhysicsHelpers.h>
+#include <Transform.h>
+
+bool EntityKinematicStore::canStore(const EntityItemPointer& entity) {
+    return entity && !entity->getPhysicsInfo() && entity->getParentID().isNull();
+}
+
+void EntityKinematicStore::add(const EntityItemPointer& entity) {
+    if (contains(entity)) {
+        return;
+    }
+
+    Transform transform;
+    glm::vec3 linearVelocity;
+    glm::vec3 angularVelocity;
+    entity->getLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
+
+    _rows[entity.get()] = _entities.size();
+    _entities.push_back(entity);
+    _positions.push_back(transform.getTranslation());
+    _rotations.push_back(transform.getRotation());
+    _linearVelocities.push_back(linearVelocity);
+    _angularVelocities.push_back(angularVelocity);
+    // without a parent the world frame acceleration is also the local frame acceleration
+    _accelerations.push_back(entity->getAcceleration());
+    _dampings.push_back(entity->getDamping());
+    _angularDampings.push_back(entity->getAngularDamping());
+    _lastSimulated.push_back(entity->getLastSimulated());
+    _timeSteps.push_back(0.0f);
+    _dirty.push_back(1);
+}
+
+void EntityKinematicStore::remove(const EntityItemPointer& entity) {
+    auto it = _rows.find(entity.get());
+    if (it != _rows.end()) {
+        removeRow(it->second);
+    }
+}
+
+void EntityKinematicStore::retainOnly(const SetOfEntities& entities) {
+    size_t row = 0;
+    while (row < _entities.size()) {
+        if (entities.contains(_entities[row])) {
+            ++row;
+        } else {
+            removeRow(row);
+        }
+    }
+}
+
+void EntityKinematicStore::removeRow(size_t row) {
+    // move the last row into the hole so the columns stay dense
+    size_t last = _entities.size() - 1;
+    _rows.erase(_entities[row].get());
+    if (row != last) {
+        _rows[_entities[last].get()] = row;
+        _entities[row] = std::move(_entities[last]);
+        _positions[row] = _positions[last];
+        _rotations[row] = _rotations[last];
+        _linearVelocities[row] = _linearVelocities[last];
+        _angularVelocities[row] = _angularVelocities[last];
+        _accelerations[row] = _accelerations[last];
+        _dampings[row] = _dampings[last];
+        _angularDampings[row] = _angularDampings[last];
+        _lastSimulated[row] = _lastSimulated[last];
+        _timeSteps[row] = _timeSteps[last];
+        _dirty[row] = _dirty[last];
+    }
+    _entities.pop_back();
+    _positions.pop_back();
+    _rotations.pop_back();
+    _linearVelocities.pop_back();
+    _angularVelocities.pop_back();
+    _accelerations.pop_back();
+    _dampings.pop_back();
+    _angularDampings.pop_back();
+    _lastSimulated.pop_back();
+    _timeSteps.pop_back();
+    _dirty.pop_back();
+}
+
+void EntityKinematicStore::clear() {
+    _rows.clear();
+    _entities.clear();
+    _positions.clear();
+    _rotations.clear();
+    _linearVelocities.clear();
+    _angularVelocities.clear();
+    _accelerations.clear();
+    _dampings.clear();
+    _angularDampings.clear();
+    _lastSimulated.clear();
+    _timeSteps.clear();
+    _dirty.clear();
+    publishSnapshot(0);
+}
+
+// Same integration as EntityItem::stepKinematicMotion(), one field at a time over all rows.
+void EntityKinematicStore::integrate(std::vector<uint8_t>& stopped) {
+    const size_t numRows = _entities.size();
+    stopped.assign(numRows, 0);
+
+    const float MIN_KINEMATIC_ANGULAR_SPEED_SQUARED = KINEMATIC_ANGULAR_SPEED_THRESHOLD * KINEMATIC_ANGULAR_SPEED_THRESHOLD;
+    const float MIN_KINEMATIC_LINEAR_SPEED_SQUARED = KINEMATIC_LINEAR_SPEED_THRESHOLD * KINEMATIC_LINEAR_SPEED_THRESHOLD;
+    const float MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED = 1.0e-4f; // 0.01 m/sec^2
+
+    for (size_t i = 0; i < numRows; ++i) {
+        glm::vec3& angularVelocity = _angularVelocities[i];
+        float dt = _timeSteps[i];
+        if (dt <= 0.0f || glm::length2(angularVelocity) == 0.0f) {
+            continue;
+        }
+        if (_angularDampings[i] > 0.0f) {
+            angularVelocity *= powf(1.0f - _angularDampings[i], dt);
+        }
+        if (glm::length2(angularVelocity) < MIN_KINEMATIC_ANGULAR_SPEED_SQUARED) {
+            angularVelocity = glm::vec3(0.0f);
+        } else {
+            glm::quat rotation = _rotations[i];
+            while (dt > 0.0f) {
+                glm::quat dQ = computeBulletRotationStep(angularVelocity, glm::min(dt, PHYSICS_ENGINE_FIXED_SUBSTEP));
+                rotation = glm::normalize(dQ * rotation);
+                dt -= PHYSICS_ENGINE_FIXED_SUBSTEP;
+            }
+            _rotations[i] = rotation;
+        }
+    }
+
+    for (size_t i = 0; i < numRows; ++i) {
+        glm::vec3& linearVelocity = _linearVelocities[i];
+        float dt = _timeSteps[i];
+        float linearSpeedSquared = glm::length2(linearVelocity);
+        if (dt <= 0.0f || linearSpeedSquared == 0.0f) {
+            continue;
+        }
+
+        glm::vec3 deltaVelocity(0.0f);
+        if (_dampings[i] > 0.0f) {
+            deltaVelocity = (powf(1.0f - _dampings[i], dt) - 1.0f) * linearVelocity;
+        }
+
+        bool hasAcceleration = glm::length2(_accelerations[i]) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED;
+        if (hasAcceleration) {
+            deltaVelocity += _accelerations[i] * dt;
+        }
+
+        bool tooSlow = linearSpeedSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED;
+        if (hasAcceleration) {
+            tooSlow = tooSlow && glm::length2(deltaVelocity) < MIN_KINEMATIC_LINEAR_SPEED_SQUARED &&
+                glm::length2(linearVelocity + deltaVelocity) < MIN_KINEMATIC_LINEAR_SPEED_SQUARED;
+        }
+        if (tooSlow) {
+            linearVelocity = glm::vec3(0.0f);
+        } else {
+            // like Bullet, leave out the second-order acceleration term
+            _positions[i] += dt * linearVelocity;
+            linearVelocity += deltaVelocity;
+        }
+    }
+
+    for (size_t i = 0; i < numRows; ++i) {
+        stopped[i] = glm::length2(_linearVelocities[i]) == 0.0f && glm::length2(_angularVelocities[i]) == 0.0f;
+    }
+}
+
+void EntityKinematicStore::step(uint64_t now, std::vector<EntityItemPointer>& movedEntities,
+                                std::vector<EntityItemPointer>& stoppedEntities) {
+    const float MAX_TIME_ELAPSED = 1.0f; // seconds
+    const size_t numRows = _entities.size();
+    for (size_t i = 0; i < numRows; ++i) {
+        uint64_t lastSimulated = _lastSimulated[i] == 0 ? now : _lastSimulated[i];
+        float timeElapsed = now > lastSimulated ? (float)(now - lastSimulated) / (float)USECS_PER_SECOND : 0.0f;
+        _timeSteps[i] = glm::min(timeElapsed, MAX_TIME_ELAPSED);
+        // a row that was simulated up to now already has nothing to integrate or write back
+        if (_lastSimulated[i] != now) {
+            _dirty[i] = 1;
+        }
+        _lastSimulated[i] = now;
+    }
+
+    std::vector<uint8_t> stopped;
+    integrate(stopped);
+
+    movedEntities.reserve(movedEntities.size() + numRows);
+    for (size_t i = 0; i < numRows; ++i) {
+        if (!_dirty[i] && !stopped[i]) {
+            continue;
+        }
+        const EntityItemPointer& entity = _entities[i];
+        Transform transform = entity->getLocalTransform();
+        transform.setTranslation(_positions[i]);
+        transform.setRotation(_rotations[i]);
+        entity->setLocalTransformAndVelocities(transform, _linearVelocities[i], _angularVelocities[i]);
+        entity->setLastSimulated(now);
+        if (stopped[i]) {
+            stoppedEntities.push_back(entity);
+        } else {
+            movedEntities.push_back(entity);
+        }
+    }
+
+    // publish before the stopped rows are removed, so readers see them at rest
+    publishSnapshot(now);
+
+    for (const auto& entity : stoppedEntities) {
+        remove(entity);
+    }
+}
+
+void EntityKinematicStore::publishSnapshot(uint64_t now) {
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->timestamp = now;
+    const size_t numRows = _entities.size();
+    size_t numDirty = (size_t)std::count(_dirty.begin(), _dirty.end(), (uint8_t)1);
+    snapshot->entityIDs.reserve(numDirty);
+    snapshot->positions.reserve(numDirty);
+    snapshot->rotations.reserve(numDirty);
+    snapshot->linearVelocities.reserve(numDirty);
+    snapshot->angularVelocities.reserve(numDirty);
+    for (size_t i = 0; i < numRows; ++i) {
+        if (!_dirty[i]) {
+            continue;
+        }
+        snapshot->entityIDs.push_back(_entities[i]->getEntityItemID());
+        snapshot->positions.push_back(_positions[i]);
+        snapshot->rotations.push_back(_rotations[i]);
+        snapshot->linearVelocities.push_back(_linearVelocities[i]);
+        snapshot->angularVelocities.push_back(_angularVelocities[i]);
+        _dirty[i] = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(_snapshotLock);
+    _snapshot = snapshot;
+}
+
+EntityKinematicStore::SnapshotPointer EntityKinematicStore::getSnapshot() const {
+    std::lock_guard<std::mutex> lock(_snapshotLock);
+    return _snapshot;
+}
@@ -0,0 +1,92 @@
+//
+//  EntityKinematicStore.h
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_EntityKinematicStore_h
+#define hifi_EntityKinematicStore_h
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "EntityItem.h"
+
+/// Columnar copy of the transform and kinematic state of the entities an EntitySimulation moves with simple
+/// kinematic motion.
+///
+/// Each field is kept in its own array so the integration runs over contiguous memory instead of chasing
+/// entity pointers and taking the entity locks for every field. Only entities without a parent and without
+/// physics are stored: their local frame is the world frame, so integration needs nothing but their own state.
+/// The store doesn't notice changes made to the entities: the simulation removes an entity when it is changed
+/// externally, and gathers it again on the next step.
+///
+/// After every step the rows that changed since the previous step are published as an immutable snapshot that
+/// readers can hold on to without locking the simulation or the entities.
+class EntityKinematicStore {
+public:
+    /// The entities added or moved by a step, and their state after it
+    struct Snapshot {
+        quint64 timestamp { 0 };
+        std::vector<EntityItemID> entityIDs;
+        std::vector<glm::vec3> positions;
+        std::vector<glm::quat> rotations;
+        std::vector<glm::vec3> linearVelocities;
+        std::vector<glm::vec3> angularVelocities;
+    };
+    using SnapshotPointer = std::shared_ptr<const Snapshot>;
+
+    /// @return true if the entity's motion can be integrated from its stored state alone
+    static bool canStore(const EntityItemPointer& entity);
+
+    bool contains(const EntityItemPointer& entity) const { return _rows.find(entity.get()) != _rows.end(); }
+    int size() const { return (int)_entities.size(); }
+
+    void add(const EntityItemPointer& entity);
+    void remove(const EntityItemPointer& entity);
+    /// Removes the stored entities that aren't in the set
+    void retainOnly(const SetOfEntities& entities);
+    void clear();
+
+    /// Integrates the motion of every stored entity up to now and writes the result back to the entities that moved.
+    /// @param movedEntities Receives the entities that were moved.
+    /// @param stoppedEntities Receives the entities that came to rest, which are removed from the store.
+    void step(uint64_t now, std::vector<EntityItemPointer>& movedEntities, std::vector<EntityItemPointer>& stoppedEntities);
+
+    /// @return The state of the entities the last step added or moved
+    SnapshotPointer getSnapshot() const;
+
+private:
+    void removeRow(size_t row);
+    void integrate(std::vector<uint8_t>& stopped);
+    void publishSnapshot(uint64_t now);
+
+    std::unordered_map<const EntityItem*, size_t> _rows;
+
+    std::vector<EntityItemPointer> _entities;
+    std::vector<glm::vec3> _positions;
+    std::vector<glm::quat> _rotations;
+    std::vector<glm::vec3> _linearVelocities;
+    std::vector<glm::vec3> _angularVelocities;
+    std::vector<glm::vec3> _accelerations;
+    std::vector<float> _dampings;
+    std::vector<float> _angularDampings;
+    std::vector<uint64_t> _lastSimulated;
+    std::vector<float> _timeSteps;
+    std::vector<uint8_t> _dirty; // added or moved since the last snapshot
+
+    mutable std::mutex _snapshotLock;
+    SnapshotPointer _snapshot { std::make_shared<Snapshot>() };
+};
+
+#endif // hifi_EntityKinematicStore_h
@@ -12,6 +12,7 @@
 #include "EntitySimulation.h"
 
 #include <AACube.h>
+#include <GLMHelpers.h>
 #include <Profile.h>
 
 #include "EntitiesLogging.h"
@@ -25,6 +26,7 @@ void EntitySimulation::setEntityTree(EntityTreePointer tree) {
         _entitiesToUpdate.clear();
         _mortalEntities.clear();
         _nextExpiry = std::numeric_limits<uint64_t>::max();
+        _kinematicStore.clear();
     }
     _entityTree = tree;
 }
@@ -50,6 +52,7 @@ void EntitySimulation::removeEntityFromInternalLists(EntityItemPointer entity) {
     _allEntities.remove(entity);
     _entitiesToUpdate.remove(entity);
     _mortalEntities.remove(entity);
+    _kinematicStore.remove(entity);
     entity->setSimulated(false);
 }
 
@@ -174,6 +177,8 @@ void EntitySimulation::changeEntity(EntityItemPointer entity) {
     QMutexLocker lock(&_mutex);
     assert(entity);
     _changedEntities.insert(entity);
+    // the stored copy is stale now, gather it again on the next step
+    _kinematicStore.remove(entity);
 }
 
 void EntitySimulation::processChangedEntities() {
@@ -223,39 +228,104 @@ void EntitySimulation::clearEntities() {
     _entitiesToUpdate.clear();
     _mortalEntities.clear();
     _nextExpiry = std::numeric_limits<uint64_t>::max();
+    _kinematicStore.clear();
+}
+
+void EntitySimulation::setUseColumnarKinematics(bool useColumnarKinematics) {
+    QMutexLocker lock(&_mutex);
+    _useColumnarKinematics = useColumnarKinematics;
+    if (!_useColumnarKinematics) {
+        _kinematicStore.clear();
+    }
+}
+
+// returns false if the entity is no longer non-physical-kinematic
+bool EntitySimulation::moveSimpleKinematicEntity(const EntityItemPointer& entity, uint64_t now) {
+    // The entity-server doesn't know where avatars are, so don't attempt to do simple extrapolation for
+    // children of avatars.  See related code in EntityMotionState::remoteSimulationOutOfSync.
+    bool ancestryIsKnown;
+    entity->getMaximumAACube(ancestryIsKnown);
+    bool hasAvatarAncestor = entity->hasAncestorOfType(NestableType::Avatar);
+
+    bool isMoving = entity->isMovingRelativeToParent();
+    if (isMoving && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
+        entity->simulate(now);
+        if (ancestryIsKnown && !hasAvatarAncestor) {
+            entity->updateQueryAACube();
+        }
+        _entitiesToSort.insert(entity);
+        return true;
+    }
+
+    if (!isMoving && ancestryIsKnown && !hasAvatarAncestor) {
+        // HACK: This catches most cases where the entity's QueryAACube (and spatial sorting in the EntityTree)
+        // would otherwise be out of date at conclusion of its "unowned" simpleKinematicMotion.
+        entity->updateQueryAACube();
+        _entitiesToSort.insert(entity);
+    }
+    return false;
 }
 
 void EntitySimulation::moveSimpleKinematics(uint64_t now) {
     PROFILE_RANGE_EX(simulation_physics, "MoveSimples", 0xffff00ff, (uint64_t)_simpleKinematicEntities.size());
+    if (_useColumnarKinematics) {
+        moveColumnarKinematics(now);
+        return;
+    }
+
     SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
     while (itemItr != _simpleKinematicEntities.end()) {
-        EntityItemPointer entity = *itemItr;
-
-        // The entity-server doesn't know where avatars are, so don't attempt to do simple extrapolation for
-        // children of avatars.  See related code in EntityMotionState::remoteSimulationOutOfSync.
-        bool ancestryIsKnown;
-        entity->getMaximumAACube(ancestryIsKnown);
-        bool hasAvatarAncestor = entity->hasAncestorOfType(NestableType::Avatar);
+        if (moveSimpleKinematicEntity(*itemItr, now)) {
+            ++itemItr;
+        } else {
+            itemItr = _simpleKinematicEntities.erase(itemItr);
+        }
+    }
+}
 
-        bool isMoving = entity->isMovingRelativeToParent();
-        if (isMoving && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
-            entity->simulate(now);
-            if (ancestryIsKnown && !hasAvatarAncestor) {
-                entity->updateQueryAACube();
+void EntitySimulation::moveColumnarKinematics(uint64_t now) {
+    // entities that aren't stored yet take one step the per-entity way, and are gathered for the next steps
+    int numStored = 0;
+    int numAdded = 0;
+    SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
+    while (itemItr != _simpleKinematicEntities.end()) {
+        const EntityItemPointer& entity = *itemItr;
+        if (_kinematicStore.contains(entity)) {
+            ++numStored;
+            ++itemItr;
+        } else if (moveSimpleKinematicEntity(entity, now)) {
+            if (EntityKinematicStore::canStore(entity)) {
+                _kinematicStore.add(entity);
+                ++numAdded;
             }
-            _entitiesToSort.insert(entity);
             ++itemItr;
         } else {
-            if (!isMoving && ancestryIsKnown && !hasAvatarAncestor) {
-                // HACK: This catches most cases where the entity's QueryAACube (and spatial sorting in the EntityTree)
-                // would otherwise be out of date at conclusion of its "unowned" simpleKinematicMotion.
-                entity->updateQueryAACube();
-                _entitiesToSort.insert(entity);
-            }
-            // the entity is no longer non-physical-kinematic
             itemItr = _simpleKinematicEntities.erase(itemItr);
         }
     }
+    if (numStored + numAdded != _kinematicStore.size()) {
+        // some subclass dropped stored entities from _simpleKinematicEntities without changing them
+        _kinematicStore.retainOnly(_simpleKinematicEntities);
+    }
+
+    std::vector<EntityItemPointer> movedEntities;
+    std::vector<EntityItemPointer> stoppedEntities;
+    {
+        PROFILE_RANGE_EX(simulation_physics, "MoveColumns", 0xffff00ff, (uint64_t)_kinematicStore.size());
+        _kinematicStore.step(now, movedEntities, stoppedEntities);
+    }
+    for (const auto& entity : movedEntities) {
+        entity->updateQueryAACube();
+        _entitiesToSort.insert(entity);
+    }
+    for (const auto& entity : stoppedEntities) {
+        // like EntityItem::simulate(), flag it to transition from KINEMATIC to STATIC
+        entity->markDirtyFlags(Simulation::DIRTY_MOTION_TYPE);
+        entity->setAcceleration(Vectors::ZERO);
+        entity->updateQueryAACube();
+        _entitiesToSort.insert(entity);
+        _simpleKinematicEntities.remove(entity);
+    }
 }
 
 void EntitySimulation::processDeadEntities() {
@@ -21,6 +21,7 @@
 #include <PerfStat.h>
 
 #include "EntityItem.h"
+#include "EntityKinematicStore.h"
 #include "EntityTree.h"
 
 using EntitySimulationPointer = std::shared_ptr<EntitySimulation>;
@@ -73,6 +74,12 @@ public:
 
     void moveSimpleKinematics(uint64_t now);
 
+    /// Opts in to integrating simple kinematic motion over a columnar copy of the entities' kinematic state
+    void setUseColumnarKinematics(bool useColumnarKinematics);
+    bool getUseColumnarKinematics() const { return _useColumnarKinematics; }
+    /// @return The kinematic state after the last step, when using columnar kinematics
+    EntityKinematicStore::SnapshotPointer getKinematicSnapshot() const { return _kinematicStore.getSnapshot(); }
+
     EntityTreePointer getEntityTree() { return _entityTree; }
 
     virtual void prepareEntityForDelete(EntityItemPointer entity);
@@ -98,6 +105,8 @@ protected:
 
 private:
     void moveSimpleKinematics();
+    bool moveSimpleKinematicEntity(const EntityItemPointer& entity, uint64_t now);
+    void moveColumnarKinematics(uint64_t now);
 
     // We maintain multiple lists, each for its distinct purpose.
     // An entity may be in more than one list.
@@ -107,6 +116,9 @@ private:
     SetOfEntities _mortalEntities; // entities that have an expiry
     uint64_t _nextExpiry;
 
+    bool _useColumnarKinematics { false };
+    EntityKinematicStore _kinematicStore; // state of the _simpleKinematicEntities that can be integrated in columns
+
     // back pointer to EntityTree structure
     EntityTreePointer _entityTree;
 };
@@ -0,0 +1,618 @@
+//
+//  EntitySpatialIndex.cpp
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EntitySpatialIndex.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include <glm/integer.hpp>
+
+static const int MAX_LEAF_SIZE = 4;
+static const int MAX_BUILD_DEPTH = 48;
+static const int NUM_SAH_BINS = 12;
+// rebuild once this many entities were added since the last build, on top of a fraction of the indexed ones
+static const int MAX_UNINDEXED_ITEMS = 64;
+// the refit tree gets looser as entities move, so rebuild it every so often
+static const int MAX_REFITS_BETWEEN_BUILDS = 300;
+// the grid of cells that carry the versions of the regions of the world
+static const float VERSION_CELL_SIZE = 16.0f; // meters
+static const int MAX_VERSION_CELLS_PER_REGION = 64;
+
+const int EntitySpatialIndex::NUM_VERSION_CELLS;
+
+// calls the operator with the hash of each version cell a region covers, or returns false if it covers too many
+template <typename F>
+static bool forEachVersionCell(const glm::vec3& minimum, const glm::vec3& maximum, F&& f) {
+    glm::vec3 first = glm::floor(minimum / VERSION_CELL_SIZE);
+    glm::vec3 last = glm::floor(maximum / VERSION_CELL_SIZE);
+    glm::vec3 count = last - first + glm::vec3(1.0f);
+    // this also turns away NaNs and the huge bounds that don't fit the integer cell coordinates
+    if (!(count.x >= 1.0f && count.y >= 1.0f && count.z >= 1.0f && count.x * count.y * count.z <= MAX_VERSION_CELLS_PER_REGION &&
+          glm::all(glm::lessThan(glm::abs(first), glm::vec3(1.0e6f))))) {
+        return false;
+    }
+    glm::ivec3 firstCell(first);
+    glm::ivec3 lastCell(last);
+    for (int x = firstCell.x; x <= lastCell.x; ++x) {
+        for (int y = firstCell.y; y <= lastCell.y; ++y) {
+            for (int z = firstCell.z; z <= lastCell.z; ++z) {
+                f((uint32_t)x * 73856093u ^ (uint32_t)y * 19349663u ^ (uint32_t)z * 83492791u);
+            }
+        }
+    }
+    return true;
+}
+
+static float halfSurfaceArea(const glm::vec3& minimum, const glm::vec3& maximum) {
+    glm::vec3 size = glm::max(maximum - minimum, glm::vec3(0.0f));
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+static bool sphereTouchesBox(const glm::vec3& center, float radius, const glm::vec3& minimum, const glm::vec3& maximum) {
+    glm::vec3 offset = glm::clamp(center, minimum, maximum) - center;
+    return glm::dot(offset, offset) <= radius * radius;
+}
+
+static bool rayHitsBox(const glm::vec3& origin, const glm::vec3& invDirection, const glm::vec3& minimum,
+                       const glm::vec3& maximum, float& entry) {
+    glm::vec3 t0 = (minimum - origin) * invDirection;
+    glm::vec3 t1 = (maximum - origin) * invDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    float tEnter = glm::max(glm::max(tNear.x, tNear.y), tNear.z);
+    float tExit = glm::min(glm::min(tFar.x, tFar.y), tFar.z);
+    if (tExit < 0.0f || tEnter > tExit) {
+        return false;
+    }
+    entry = glm::max(tEnter, 0.0f);
+    return true;
+}
+
+static bool parabolaHitsBox(const EntitySpatialIndex::Parabola& parabola, const glm::vec3& minimum, const glm::vec3& maximum,
+                            float& entry) {
+    if (glm::any(glm::greaterThan(minimum, maximum))) {
+        // a node left empty by a refit
+        return false;
+    }
+    AABox box(minimum, maximum - minimum);
+    if (box.contains(parabola.origin)) {
+        entry = 0.0f;
+        return true;
+    }
+    BoxFace face;
+    glm::vec3 normal;
+    return box.findParabolaIntersection(parabola.origin, parabola.velocity, parabola.acceleration, entry, face, normal);
+}
+
+static glm::vec3 safeInverse(const glm::vec3& direction) {
+    // a huge finite reciprocal keeps the slab test free of NaNs for axis aligned rays
+    return glm::vec3(direction.x == 0.0f ? FLT_MAX : 1.0f / direction.x,
+                     direction.y == 0.0f ? FLT_MAX : 1.0f / direction.y,
+                     direction.z == 0.0f ? FLT_MAX : 1.0f / direction.z);
+}
+
+void EntitySpatialIndex::add(const EntityItemPointer& entity) {
+    std::lock_guard<std::mutex> lock(_pendingLock);
+    _pendingRemoves.remove(entity->getEntityItemID());
+    _pendingAdds.push_back(entity);
+    _hasPendingChanges = true;
+}
+
+void EntitySpatialIndex::remove(const EntityItemID& id) {
+    std::lock_guard<std::mutex> lock(_pendingLock);
+    _pendingAdds.erase(std::remove_if(_pendingAdds.begin(), _pendingAdds.end(), [&](const EntityItemPointer& entity) {
+        return entity->getEntityItemID() == id;
+    }), _pendingAdds.end());
+    _pendingRemoves.insert(id);
+    _pendingChanges.remove(id);
+    _hasPendingChanges = true;
+}
+
+void EntitySpatialIndex::markChanged(const EntityItemID& id) {
+    std::lock_guard<std::mutex> lock(_pendingLock);
+    _pendingChanges.insert(id);
+    _hasPendingChanges = true;
+}
+
+void EntitySpatialIndex::clear() {
+    QWriteLocker treeLocker(&_treeLock);
+    {
+        std::lock_guard<std::mutex> lock(_pendingLock);
+        _pendingAdds.clear();
+        _pendingRemoves.clear();
+        _pendingChanges.clear();
+        _hasPendingChanges = false;
+    }
+    // everything goes, so every region changes
+    _version++;
+    _largeVersion++;
+    _itemIndices.clear();
+    _items.clear();
+    _freeItems.clear();
+    _nodes.clear();
+    _leafItems.clear();
+    _unindexedItems.clear();
+    _numRemovedSinceBuild = 0;
+    _numRefitsSinceBuild = 0;
+}
+
+int EntitySpatialIndex::size() const {
+    QReadLocker treeLocker(&_treeLock);
+    return _itemIndices.size();
+}
+
+uint64_t EntitySpatialIndex::getVersion(const glm::vec3& minimum, const glm::vec3& maximum) {
+    refresh();
+    QReadLocker treeLocker(&_treeLock);
+    uint64_t version = _largeVersion;
+    if (!forEachVersionCell(minimum, maximum, [&](uint32_t hash) { version += _cellVersions[hash % NUM_VERSION_CELLS]; })) {
+        return _version;
+    }
+    return version;
+}
+
+void EntitySpatialIndex::bumpVersions(const Item& item) {
+    if (!item.valid) {
+        // an entity without bounds is in no query's results
+        return;
+    }
+    if (!forEachVersionCell(item.minimum, item.maximum, [&](uint32_t hash) { _cellVersions[hash % NUM_VERSION_CELLS]++; })) {
+        _largeVersion++;
+    }
+}
+
+EntitySpatialIndex::Stats EntitySpatialIndex::getStats() const {
+    QReadLocker treeLocker(&_treeLock);
+    Stats stats;
+    stats.numEntities = _itemIndices.size();
+    stats.numNodes = (int)_nodes.size();
+    stats.numUnindexed = (int)_unindexedItems.size();
+    stats.numBuilds = _numBuilds;
+    stats.numRefits = _numRefits;
+    return stats;
+}
+
+void EntitySpatialIndex::updateItemBounds(Item& item) {
+    // use the cube around the box's bounding sphere, like the octree picks do, so billboarded entities that turn away
+    // from their world orientation are still inside their bounds
+    bool success = false;
+    AABox box = item.entity->getAABox(success);
+    item.valid = success;
+    glm::vec3 center = box.calcCenter();
+    glm::vec3 halfSize(0.5f * glm::length(box.getScale()));
+    item.minimum = center - halfSize;
+    item.maximum = center + halfSize;
+}
+
+void EntitySpatialIndex::refresh() {
+    if (!_hasPendingChanges) {
+        return;
+    }
+
+    QWriteLocker treeLocker(&_treeLock);
+    std::vector<EntityItemPointer> adds;
+    QSet<EntityItemID> removes;
+    QSet<EntityItemID> changes;
+    {
+        std::lock_guard<std::mutex> lock(_pendingLock);
+        adds.swap(_pendingAdds);
+        removes.swap(_pendingRemoves);
+        changes.swap(_pendingChanges);
+        _hasPendingChanges = false;
+    }
+
+    if (!adds.empty() || !removes.empty() || !changes.isEmpty()) {
+        _version++;
+    }
+
+    // the regions an entity leaves and the regions it enters both change
+    bool needsRefit = false;
+    for (const auto& entity : adds) {
+        EntityItemID id = entity->getEntityItemID();
+        auto it = _itemIndices.find(id);
+        if (it != _itemIndices.end()) {
+            // re-added under the same ID, the slot keeps its place in the tree
+            Item& item = _items[it.value()];
+            bumpVersions(item);
+            item.entity = entity;
+            updateItemBounds(item);
+            bumpVersions(item);
+            needsRefit = true;
+            continue;
+        }
+        int index;
+        if (!_freeItems.empty()) {
+            index = _freeItems.back();
+            _freeItems.pop_back();
+        } else {
+            index = (int)_items.size();
+            _items.emplace_back();
+        }
+        _items[index].entity = entity;
+        updateItemBounds(_items[index]);
+        bumpVersions(_items[index]);
+        _itemIndices.insert(id, index);
+        _unindexedItems.push_back(index);
+    }
+
+    for (const auto& id : removes) {
+        auto it = _itemIndices.find(id);
+        if (it != _itemIndices.end()) {
+            // the slot stays in the tree and is skipped until the next build frees it
+            bumpVersions(_items[it.value()]);
+            _items[it.value()].entity.reset();
+            _items[it.value()].valid = false;
+            _itemIndices.erase(it);
+            _numRemovedSinceBuild++;
+        }
+    }
+
+    for (const auto& id : changes) {
+        auto it = _itemIndices.find(id);
+        if (it != _itemIndices.end()) {
+            Item& item = _items[it.value()];
+            bumpVersions(item);
+            updateItemBounds(item);
+            bumpVersions(item);
+            needsRefit = true;
+        }
+    }
+
+    int numIndexed = (int)_leafItems.size();
+    if ((int)_unindexedItems.size() > MAX_UNINDEXED_ITEMS + numIndexed / 32 || _numRemovedSinceBuild > numIndexed / 4 ||
+        _numRefitsSinceBuild >= MAX_REFITS_BETWEEN_BUILDS) {
+        rebuild();
+    } else if (needsRefit) {
+        refit();
+    }
+}
+
+void EntitySpatialIndex::rebuild() {
+    _numBuilds++;
+    _numRefitsSinceBuild = 0;
+    _numRemovedSinceBuild = 0;
+    _unindexedItems.clear();
+    _freeItems.clear();
+    _leafItems.clear();
+    _nodes.clear();
+
+    for (int i = 0; i < (int)_items.size(); ++i) {
+        if (!_items[i].entity) {
+            _freeItems.push_back(i);
+        } else {
+            // items without bounds are kept in the tree with their last bounds, they are skipped until they get some
+            _leafItems.push_back(i);
+        }
+    }
+    if (_leafItems.empty()) {
+        return;
+    }
+
+    _nodes.reserve(2 * _leafItems.size() / MAX_LEAF_SIZE + 1);
+    _nodes.emplace_back();
+    buildNode(0, (int)_leafItems.size());
+}
+
+void EntitySpatialIndex::buildNode(int begin, int end) {
+    // nodes are laid out parent first, so children always come after their parent
+    struct BuildTask {
+        int node;
+        int begin;
+        int end;
+        int depth;
+    };
+    std::vector<BuildTask> tasks;
+    tasks.push_back({ (int)_nodes.size() - 1, begin, end, 0 });
+
+    while (!tasks.empty()) {
+        BuildTask task = tasks.back();
+        tasks.pop_back();
+
+        glm::vec3 minimum(FLT_MAX);
+        glm::vec3 maximum(-FLT_MAX);
+        glm::vec3 centroidMinimum(FLT_MAX);
+        glm::vec3 centroidMaximum(-FLT_MAX);
+        for (int i = task.begin; i < task.end; ++i) {
+            const Item& item = _items[_leafItems[i]];
+            minimum = glm::min(minimum, item.minimum);
+            maximum = glm::max(maximum, item.maximum);
+            glm::vec3 centroid = 0.5f * (item.minimum + item.maximum);
+            centroidMinimum = glm::min(centroidMinimum, centroid);
+            centroidMaximum = glm::max(centroidMaximum, centroid);
+        }
+        _nodes[task.node].minimum = minimum;
+        _nodes[task.node].maximum = maximum;
+
+        int count = task.end - task.begin;
+        if (count <= MAX_LEAF_SIZE) {
+            _nodes[task.node].first = task.begin;
+            _nodes[task.node].count = count;
+            continue;
+        }
+
+        glm::vec3 centroidExtent = centroidMaximum - centroidMinimum;
+        int axis = 0;
+        if (centroidExtent.y > centroidExtent[axis]) {
+            axis = 1;
+        }
+        if (centroidExtent.z > centroidExtent[axis]) {
+            axis = 2;
+        }
+        float extent = centroidExtent[axis];
+        float axisMinimum = centroidMinimum[axis];
+        auto binOf = [&](int itemIndex) {
+            const Item& item = _items[itemIndex];
+            float centroid = 0.5f * (item.minimum[axis] + item.maximum[axis]);
+            return glm::clamp((int)((centroid - axisMinimum) / extent * NUM_SAH_BINS), 0, NUM_SAH_BINS - 1);
+        };
+
+        int split = -1;
+        if (extent > 0.0f && task.depth < MAX_BUILD_DEPTH) {
+            int binCounts[NUM_SAH_BINS] = {};
+            glm::vec3 binMinimums[NUM_SAH_BINS];
+            glm::vec3 binMaximums[NUM_SAH_BINS];
+            for (int b = 0; b < NUM_SAH_BINS; ++b) {
+                binMinimums[b] = glm::vec3(FLT_MAX);
+                binMaximums[b] = glm::vec3(-FLT_MAX);
+            }
+            for (int i = task.begin; i < task.end; ++i) {
+                int b = binOf(_leafItems[i]);
+                const Item& item = _items[_leafItems[i]];
+                binCounts[b]++;
+                binMinimums[b] = glm::min(binMinimums[b], item.minimum);
+                binMaximums[b] = glm::max(binMaximums[b], item.maximum);
+            }
+
+            // sweep from the right to get the cost of every right side, then from the left to find the cheapest split
+            float rightCosts[NUM_SAH_BINS] = {};
+            glm::vec3 sweepMinimum(FLT_MAX);
+            glm::vec3 sweepMaximum(-FLT_MAX);
+            int sweepCount = 0;
+            for (int b = NUM_SAH_BINS - 1; b > 0; --b) {
+                sweepMinimum = glm::min(sweepMinimum, binMinimums[b]);
+                sweepMaximum = glm::max(sweepMaximum, binMaximums[b]);
+                sweepCount += binCounts[b];
+                rightCosts[b] = sweepCount > 0 ? halfSurfaceArea(sweepMinimum, sweepMaximum) * sweepCount : 0.0f;
+            }
+            sweepMinimum = glm::vec3(FLT_MAX);
+            sweepMaximum = glm::vec3(-FLT_MAX);
+            sweepCount = 0;
+            float bestCost = FLT_MAX;
+            int bestBin = -1;
+            for (int b = 0; b < NUM_SAH_BINS - 1; ++b) {
+                sweepMinimum = glm::min(sweepMinimum, binMinimums[b]);
+                sweepMaximum = glm::max(sweepMaximum, binMaximums[b]);
+                sweepCount += binCounts[b];
+                if (sweepCount == 0 || sweepCount == count) {
+                    continue;
+                }
+                float cost = halfSurfaceArea(sweepMinimum, sweepMaximum) * sweepCount + rightCosts[b + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestBin = b;
+                }
+            }
+
+            if (bestBin >= 0) {
+                auto middle = std::partition(_leafItems.begin() + task.begin, _leafItems.begin() + task.end,
+                                             [&](int itemIndex) { return binOf(itemIndex) <= bestBin; });
+                split = (int)(middle - _leafItems.begin());
+            }
+        }
+        if (split <= task.begin || split >= task.end) {
+            // all centroids in one place, or the tree got too deep: fall back to a median split
+            split = task.begin + count / 2;
+            std::nth_element(_leafItems.begin() + task.begin, _leafItems.begin() + split, _leafItems.begin() + task.end,
+                             [&](int a, int b) {
+                return _items[a].minimum[axis] + _items[a].maximum[axis] < _items[b].minimum[axis] + _items[b].maximum[axis];
+            });
+        }
+
+        int first = (int)_nodes.size();
+        _nodes.emplace_back();
+        _nodes.emplace_back();
+        _nodes[task.node].first = first;
+        _nodes[task.node].count = 0;
+        tasks.push_back({ first + 1, split, task.end, task.depth + 1 });
+        tasks.push_back({ first, task.begin, split, task.depth + 1 });
+    }
+}
+
+void EntitySpatialIndex::refit() {
+    _numRefits++;
+    _numRefitsSinceBuild++;
+    for (int i = (int)_nodes.size() - 1; i >= 0; --i) {
+        Node& node = _nodes[i];
+        glm::vec3 minimum(FLT_MAX);
+        glm::vec3 maximum(-FLT_MAX);
+        if (node.count > 0) {
+            for (int j = node.first; j < node.first + node.count; ++j) {
+                const Item& item = _items[_leafItems[j]];
+                if (item.valid) {
+                    minimum = glm::min(minimum, item.minimum);
+                    maximum = glm::max(maximum, item.maximum);
+                }
+            }
+        } else {
+            minimum = glm::min(_nodes[node.first].minimum, _nodes[node.first + 1].minimum);
+            maximum = glm::max(_nodes[node.first].maximum, _nodes[node.first + 1].maximum);
+        }
+        node.minimum = minimum;
+        node.maximum = maximum;
+    }
+}
+
+template <typename Query>
+void EntitySpatialIndex::traverse(int numQueries, const Query& query) {
+    refresh();
+    QReadLocker treeLocker(&_treeLock);
+
+    for (int batchStart = 0; batchStart < numQueries; batchStart += MAX_BATCH_SIZE) {
+        int batchSize = std::min(MAX_BATCH_SIZE, numQueries - batchStart);
+        uint64_t allQueries = batchSize == 64 ? ~(uint64_t)0 : (((uint64_t)1 << batchSize) - 1);
+
+        if (!_nodes.empty()) {
+            // each stack entry carries the queries that still overlap the node
+            std::vector<std::pair<int, uint64_t>> stack;
+            stack.emplace_back(0, allQueries);
+            while (!stack.empty()) {
+                int nodeIndex = stack.back().first;
+                uint64_t queries = stack.back().second;
+                stack.pop_back();
+
+                const Node& node = _nodes[nodeIndex];
+                uint64_t overlapping = 0;
+                for (uint64_t remaining = queries; remaining; remaining &= remaining - 1) {
+                    int bit = glm::findLSB(remaining);
+                    if (query.overlaps(batchStart + bit, node.minimum, node.maximum)) {
+                        overlapping |= (uint64_t)1 << bit;
+                    }
+                }
+                if (!overlapping) {
+                    continue;
+                }
+
+                if (node.count > 0) {
+                    for (int i = node.first; i < node.first + node.count; ++i) {
+                        const Item& item = _items[_leafItems[i]];
+                        if (!item.valid) {
+                            continue;
+                        }
+                        for (uint64_t remaining = overlapping; remaining; remaining &= remaining - 1) {
+                            query.visit(batchStart + glm::findLSB(remaining), item.entity, item.minimum, item.maximum);
+                        }
+                    }
+                } else {
+                    stack.emplace_back(node.first + 1, overlapping);
+                    stack.emplace_back(node.first, overlapping);
+                }
+            }
+        }
+
+        for (int index : _unindexedItems) {
+            const Item& item = _items[index];
+            if (!item.valid) {
+                continue;
+            }
+            for (int q = batchStart; q < batchStart + batchSize; ++q) {
+                query.visit(q, item.entity, item.minimum, item.maximum);
+            }
+        }
+    }
+}
+
+void EntitySpatialIndex::findInSpheres(const std::vector<Sphere>& spheres, std::vector<std::vector<EntityItemPointer>>& candidates) {
+    candidates.assign(spheres.size(), std::vector<EntityItemPointer>());
+    struct SphereQuery {
+        const std::vector<Sphere>& spheres;
+        std::vector<std::vector<EntityItemPointer>>& candidates;
+        bool overlaps(int q, const glm::vec3& minimum, const glm::vec3& maximum) const {
+            return sphereTouchesBox(spheres[q].center, spheres[q].radius, minimum, maximum);
+        }
+        void visit(int q, const EntityItemPointer& entity, const glm::vec3& minimum, const glm::vec3& maximum) const {
+            if (overlaps(q, minimum, maximum)) {
+                candidates[q].push_back(entity);
+            }
+        }
+    };
+    traverse((int)spheres.size(), SphereQuery { spheres, candidates });
+}
+
+void EntitySpatialIndex::findInSphere(const glm::vec3& center, float radius, std::vector<EntityItemPointer>& candidates) {
+    std::vector<std::vector<EntityItemPointer>> results;
+    findInSpheres({ { center, radius } }, results);
+    candidates.swap(results[0]);
+}
+
+void EntitySpatialIndex::findInBox(const AABox& box, std::vector<EntityItemPointer>& candidates) {
+    candidates.clear();
+    struct BoxQuery {
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        std::vector<EntityItemPointer>& candidates;
+        bool overlaps(int q, const glm::vec3& otherMinimum, const glm::vec3& otherMaximum) const {
+            return glm::all(glm::lessThanEqual(minimum, otherMaximum)) && glm::all(glm::lessThanEqual(otherMinimum, maximum));
+        }
+        void visit(int q, const EntityItemPointer& entity, const glm::vec3& otherMinimum, const glm::vec3& otherMaximum) const {
+            if (overlaps(q, otherMinimum, otherMaximum)) {
+                candidates.push_back(entity);
+            }
+        }
+    };
+    traverse(1, BoxQuery { box.getMinimumPoint(), box.getMaximumPoint(), candidates });
+}
+
+void EntitySpatialIndex::findAlongRays(const std::vector<Ray>& rays, std::vector<std::vector<RayCandidate>>& candidates) {
+    candidates.assign(rays.size(), std::vector<RayCandidate>());
+    std::vector<glm::vec3> invDirections;
+    invDirections.reserve(rays.size());
+    for (const auto& ray : rays) {
+        invDirections.push_back(safeInverse(ray.direction));
+    }
+
+    struct RayQuery {
+        const std::vector<Ray>& rays;
+        const std::vector<glm::vec3>& invDirections;
+        std::vector<std::vector<RayCandidate>>& candidates;
+        bool overlaps(int q, const glm::vec3& minimum, const glm::vec3& maximum) const {
+            float entry;
+            return rayHitsBox(rays[q].origin, invDirections[q], minimum, maximum, entry);
+        }
+        void visit(int q, const EntityItemPointer& entity, const glm::vec3& minimum, const glm::vec3& maximum) const {
+            float entry;
+            if (rayHitsBox(rays[q].origin, invDirections[q], minimum, maximum, entry)) {
+                candidates[q].push_back({ entry, entity });
+            }
+        }
+    };
+    traverse((int)rays.size(), RayQuery { rays, invDirections, candidates });
+
+    for (auto& rayCandidates : candidates) {
+        std::sort(rayCandidates.begin(), rayCandidates.end());
+    }
+}
+
+void EntitySpatialIndex::findAlongRay(const glm::vec3& origin, const glm::vec3& direction, std::vector<RayCandidate>& candidates) {
+    std::vector<std::vector<RayCandidate>> results;
+    findAlongRays({ { origin, direction } }, results);
+    candidates.swap(results[0]);
+}
+
+void EntitySpatialIndex::findAlongParabolas(const std::vector<Parabola>& parabolas,
+                                            std::vector<std::vector<RayCandidate>>& candidates) {
+    candidates.assign(parabolas.size(), std::vector<RayCandidate>());
+    struct ParabolaQuery {
+        const std::vector<Parabola>& parabolas;
+        std::vector<std::vector<RayCandidate>>& candidates;
+        bool overlaps(int q, const glm::vec3& minimum, const glm::vec3& maximum) const {
+            float entry;
+            return parabolaHitsBox(parabolas[q], minimum, maximum, entry);
+        }
+        void visit(int q, const EntityItemPointer& entity, const glm::vec3& minimum, const glm::vec3& maximum) const {
+            float entry;
+            if (parabolaHitsBox(parabolas[q], minimum, maximum, entry)) {
+                candidates[q].push_back({ entry, entity });
+            }
+        }
+    };
+    traverse((int)parabolas.size(), ParabolaQuery { parabolas, candidates });
+
+    for (auto& parabolaCandidates : candidates) {
+        std::sort(parabolaCandidates.begin(), parabolaCandidates.end());
+    }
+}
+
+void EntitySpatialIndex::findAlongParabola(const Parabola& parabola, std::vector<RayCandidate>& candidates) {
+    std::vector<std::vector<RayCandidate>> results;
+    findAlongParabolas({ parabola }, results);
+    candidates.swap(results[0]);
+}
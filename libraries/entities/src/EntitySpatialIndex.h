@@ -0,0 +1,187 @@
+//
+//  EntitySpatialIndex.h
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_EntitySpatialIndex_h
+#define hifi_EntitySpatialIndex_h
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QSet>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+
+#include "EntityItem.h"
+#include "EntityItemID.h"
+
+/// A bounding volume hierarchy over the world frame bounding boxes of the entities of an EntityTree, used as the
+/// broadphase of picks and sphere and box searches instead of recursing the octree.
+///
+/// The hierarchy is built with a binned surface area heuristic. Entities that move or resize are refit in place on
+/// the next query, added entities are kept in a short list that every query scans until the next rebuild, and removed
+/// entities are skipped. The tree is rebuilt when those lists grow, or after many refits.
+///
+/// Queries only return candidates whose bounding box is hit; exact tests are up to the caller. The batched queries
+/// answer many rays or spheres in one traversal of the tree.
+///
+/// Changes bump the versions of the cells of a coarse grid that their old and new bounds cover, so callers can cache
+/// the results of a query for as long as the version of its region doesn't change, whatever moves elsewhere.
+class EntitySpatialIndex {
+public:
+    struct Ray {
+        glm::vec3 origin;
+        glm::vec3 direction;
+    };
+
+    struct Sphere {
+        glm::vec3 center;
+        float radius;
+    };
+
+    struct Parabola {
+        glm::vec3 origin;
+        glm::vec3 velocity;
+        glm::vec3 acceleration;
+    };
+
+    struct RayCandidate {
+        // to the entry point of the entity's bounding box, along the ray or the parabola, 0 if it starts inside
+        float distance;
+        EntityItemPointer entity;
+        bool operator<(const RayCandidate& other) const { return distance < other.distance; }
+    };
+
+    void add(const EntityItemPointer& entity);
+    void remove(const EntityItemID& id);
+    /// Marks an entity whose bounds may have changed
+    void markChanged(const EntityItemID& id);
+    void clear();
+
+    int size() const;
+    /// Applies the pending changes first
+    /// @return A number that changes whenever an entity whose bounds touch the region is added, removed or changed
+    uint64_t getVersion(const glm::vec3& minimum, const glm::vec3& maximum);
+
+    void findInSphere(const glm::vec3& center, float radius, std::vector<EntityItemPointer>& candidates);
+    void findInBox(const AABox& box, std::vector<EntityItemPointer>& candidates);
+    /// @param candidates Receives the candidates sorted by distance along the ray
+    void findAlongRay(const glm::vec3& origin, const glm::vec3& direction, std::vector<RayCandidate>& candidates);
+    /// @param candidates Receives the candidates sorted by parabolic distance
+    void findAlongParabola(const Parabola& parabola, std::vector<RayCandidate>& candidates);
+
+    void findInSpheres(const std::vector<Sphere>& spheres, std::vector<std::vector<EntityItemPointer>>& candidates);
+    void findAlongRays(const std::vector<Ray>& rays, std::vector<std::vector<RayCandidate>>& candidates);
+    void findAlongParabolas(const std::vector<Parabola>& parabolas, std::vector<std::vector<RayCandidate>>& candidates);
+
+    struct Stats {
+        int numEntities { 0 };
+        int numNodes { 0 };
+        int numUnindexed { 0 };
+        uint64_t numBuilds { 0 };
+        uint64_t numRefits { 0 };
+    };
+    Stats getStats() const;
+
+private:
+    struct Item {
+        EntityItemPointer entity;
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        bool valid { false }; // has bounds and isn't removed
+    };
+
+    struct Node {
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        int first { 0 }; // first child node for inner nodes, first entry of _leafItems for leaves
+        int count { 0 }; // number of items for leaves, 0 for inner nodes
+    };
+
+    static const int MAX_BATCH_SIZE = 64;
+    static const int NUM_VERSION_CELLS = 4096;
+
+    void refresh();
+    void updateItemBounds(Item& item);
+    void bumpVersions(const Item& item);
+    void rebuild();
+    void buildNode(int begin, int end);
+    void refit();
+
+    template <typename Query>
+    void traverse(int numQueries, const Query& query);
+
+    mutable QReadWriteLock _treeLock;
+    QHash<EntityItemID, int> _itemIndices;
+    std::vector<Item> _items;
+    std::vector<int> _freeItems;
+    std::vector<Node> _nodes;
+    std::vector<int> _leafItems;
+    std::vector<int> _unindexedItems; // added since the last build
+    int _numRemovedSinceBuild { 0 };
+    int _numRefitsSinceBuild { 0 };
+    uint64_t _numBuilds { 0 };
+    uint64_t _numRefits { 0 };
+
+    std::mutex _pendingLock;
+    std::vector<EntityItemPointer> _pendingAdds;
+    QSet<EntityItemID> _pendingRemoves;
+    QSet<EntityItemID> _pendingChanges;
+    std::atomic<bool> _hasPendingChanges { false };
+
+    // guarded by _treeLock; cells are hashed into a fixed table, so a collision only costs a cache miss
+    std::array<uint64_t, NUM_VERSION_CELLS> _cellVersions {};
+    uint64_t _largeVersion { 0 }; // bumped for bounds that span too many cells
+    uint64_t _version { 0 }; // bumped by every change, the version of regions that span too many cells
+};
+
+/// Remembers query results for as long as the version of the region they were computed from doesn't change.
+template <typename Key, typename Result>
+class EntityQueryCache {
+public:
+    bool find(uint64_t version, const Key& key, Result& result) {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto it = _results.find(key);
+        if (it == _results.end() || it.value().first != version) {
+            _misses++;
+            return false;
+        }
+        result = it.value().second;
+        _hits++;
+        return true;
+    }
+
+    void insert(uint64_t version, const Key& key, const Result& result) {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_results.size() >= MAX_RESULTS && !_results.contains(key)) {
+            _results.clear();
+        }
+        _results.insert(key, { version, result });
+    }
+
+    uint64_t getHits() const { return _hits; }
+    uint64_t getMisses() const { return _misses; }
+
+private:
+    static const int MAX_RESULTS = 256;
+
+    std::mutex _lock;
+    QHash<Key, std::pair<uint64_t, Result>> _results;
+    std::atomic<uint64_t> _hits { 0 };
+    std::atomic<uint64_t> _misses { 0 };
+};
+
+#endif // hifi_EntitySpatialIndex_h
@@ -15,6 +15,8 @@
 #include "EntityTree.h"
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
+#include <QtCore/QThread>
+#include <QtConcurrent/QtConcurrentRun>
 #include <openssl/err.h>
 #include <openssl/pem.h>
 #include <openssl/x509.h>
@@ -92,8 +94,7 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
         QHash<EntityItemID, EntityItemPointer> savedEntities;
         // NOTE: lock the Tree first, then lock the _entityMap.
         // It should never be done the other way around.
-        QReadLocker locker(&_entityMapLock);
-        foreach(EntityItemPointer entity, _entityMap) {
+        _entityMap.forEach([&](const EntityItemPointer& entity) {
             EntityTreeElementPointer element = entity->getElement();
             if (element) {
                 element->cleanupDomainAndNonOwnedEntities();
@@ -109,8 +110,11 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
                     }
                 }
             }
-        }
-        _entityMap.swap(savedEntities);
+            if (_useSpatialIndex && !savedEntities.contains(entity->getEntityItemID())) {
+                removeFromSpatialIndex(entity);
+            }
+        });
+        _entityMap.reset(savedEntities);
     });
 
     resetClientEditStats();
@@ -137,8 +141,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     if (_simulation) {
         _simulation->clearEntities();
     }
-    QHash<EntityItemID, EntityItemPointer> localMap;
-    localMap.swap(_entityMap);
+    QHash<EntityItemID, EntityItemPointer> localMap = _entityMap.takeAll();
     this->withWriteLock([&] {
         foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
@@ -152,6 +155,9 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
                     _staleProxies.push_back(spaceIndex);
                 }
             }
+            if (_useSpatialIndex) {
+                removeFromSpatialIndex(entity);
+            }
         }
     });
     localMap.clear();
@@ -308,11 +314,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
 }
 
 bool EntityTree::updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode) {
-    EntityItemPointer entity;
-    {
-        QReadLocker locker(&_entityMapLock);
-        entity = _entityMap.value(entityID);
-    }
+    EntityItemPointer entity = _entityMap.value(entityID);
     if (!entity) {
         return false;
     }
@@ -679,11 +681,7 @@ void EntityTree::deleteEntitiesByID(const std::vector<EntityItemID>& ids, bool f
             std::vector<EntityItemPointer> entitiesToDelete;
             entitiesToDelete.reserve(ids.size());
             for (auto id : ids) {
-                EntityItemPointer entity;
-                {
-                    QReadLocker locker(&_entityMapLock);
-                    entity = _entityMap.value(id);
-                }
+                EntityItemPointer entity = _entityMap.value(id);
                 if (entity) {
                     recursivelyFilterAndCollectForDelete(entity, entitiesToDelete, force);
                 }
@@ -699,11 +697,7 @@ void EntityTree::deleteEntitiesByID(const std::vector<EntityItemID>& ids, bool f
         QUuid sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
         withWriteLock([&] {
             for (auto id : ids) {
-                EntityItemPointer entity;
-                {
-                    QReadLocker locker(&_entityMapLock);
-                    entity = _entityMap.value(id);
-                }
+                EntityItemPointer entity = _entityMap.value(id);
                 if (entity) {
                     bool isServerless = isServerlessMode();
                     if (entity->isDomainEntity() && !isServerless) {
@@ -841,6 +835,24 @@ float evalRayIntersectionSortingOp(const OctreeElementPointer& element, void* ex
     return distance;
 }
 
+// Candidates come sorted by the distance to their bounds, so the walk stops at the first one farther than the best hit.
+static EntityItemID evalClosestRayCandidate(const std::vector<EntitySpatialIndex::RayCandidate>& candidates, RayArgs& args) {
+    EntityItemID entityID;
+    for (const auto& candidate : candidates) {
+        if (candidate.distance > args.distance) {
+            break;
+        }
+        OctreeElementPointer element = candidate.entity->getElement();
+        if (EntityTreeElement::evalEntityRayIntersection(candidate.entity, args.origin, args.direction, args.viewFrustumPos,
+                element, args.distance, args.face, args.surfaceNormal, args.entityIdsToInclude, args.entityIdsToDiscard,
+                args.searchFilter, args.extraInfo)) {
+            entityID = candidate.entity->getEntityItemID();
+            args.element = element;
+        }
+    }
+    return entityID;
+}
+
 EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
                                     QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
                                     PickFilter searchFilter, OctreeElementPointer& element, float& distance,
@@ -857,7 +869,13 @@ EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm:
 
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&]{
-        recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
+        if (_useSpatialIndex) {
+            std::vector<EntitySpatialIndex::RayCandidate> candidates;
+            _spatialIndex->findAlongRay(origin, direction, candidates);
+            args.entityID = evalClosestRayCandidate(candidates, args);
+        } else {
+            recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
+        }
     }, requireLock);
 
     if (accurateResult) {
@@ -924,6 +942,26 @@ float evalParabolaIntersectionSortingOp(const OctreeElementPointer& element, voi
     return distance;
 }
 
+// Same walk as evalClosestRayCandidate, with candidates sorted by parabolic distance.
+static EntityItemID evalClosestParabolaCandidate(const std::vector<EntitySpatialIndex::RayCandidate>& candidates,
+                                                 ParabolaArgs& args) {
+    EntityItemID entityID;
+    glm::vec3 normal = EntityTreeElement::getParabolaPlaneNormal(args.velocity, args.acceleration);
+    for (const auto& candidate : candidates) {
+        if (candidate.distance > args.parabolicDistance) {
+            break;
+        }
+        OctreeElementPointer element = candidate.entity->getElement();
+        if (EntityTreeElement::evalEntityParabolaIntersection(candidate.entity, args.origin, args.velocity, args.acceleration,
+                args.viewFrustumPos, normal, element, args.parabolicDistance, args.face, args.surfaceNormal,
+                args.entityIdsToInclude, args.entityIdsToDiscard, args.searchFilter, args.extraInfo)) {
+            entityID = candidate.entity->getEntityItemID();
+            args.element = element;
+        }
+    }
+    return entityID;
+}
+
 EntityItemID EntityTree::evalParabolaIntersection(const PickParabola& parabola,
                                     QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
                                     PickFilter searchFilter,
@@ -937,7 +975,13 @@ EntityItemID EntityTree::evalParabolaIntersection(const PickParabola& parabola,
 
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&] {
-        recurseTreeWithOperationSorted(evalParabolaIntersectionOp, evalParabolaIntersectionSortingOp, &args);
+        if (_useSpatialIndex) {
+            std::vector<EntitySpatialIndex::RayCandidate> candidates;
+            _spatialIndex->findAlongParabola({ parabola.origin, parabola.velocity, parabola.acceleration }, candidates);
+            args.entityID = evalClosestParabolaCandidate(candidates, args);
+        } else {
+            recurseTreeWithOperationSorted(evalParabolaIntersectionOp, evalParabolaIntersectionSortingOp, &args);
+        }
     }, requireLock);
 
     if (accurateResult) {
@@ -1033,11 +1077,42 @@ bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData)
     return false;
 }
 
-// NOTE: assumes caller has handled locking
+static QByteArray makeQueryCacheKey(const glm::vec3& first, const glm::vec3& second, PickFilter searchFilter) {
+    unsigned long flags = searchFilter._flags.to_ulong();
+    QByteArray key;
+    key.reserve(2 * sizeof(glm::vec3) + sizeof(flags));
+    key.append(reinterpret_cast<const char*>(&first), sizeof(glm::vec3));
+    key.append(reinterpret_cast<const char*>(&second), sizeof(glm::vec3));
+    key.append(reinterpret_cast<const char*>(&flags), sizeof(flags));
+    return key;
+}
+
+// NOTE: assumes caller has handled locking, see withSearchLock()
 void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereOperation, &args);
-    foundEntities.swap(args.entities);
+    if (!_useSpatialIndex) {
+        FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
+        recurseTreeWithOperation(evalInSphereOperation, &args);
+        foundEntities.swap(args.entities);
+        return;
+    }
+
+    uint64_t version = _spatialIndex->getVersion(center - glm::vec3(radius), center + glm::vec3(radius));
+    QByteArray key = makeQueryCacheKey(center, glm::vec3(radius), searchFilter);
+    if (_sphereQueryCache.find(version, key, foundEntities)) {
+        return;
+    }
+
+    std::vector<EntityItemPointer> candidates;
+    _spatialIndex->findInSphere(center, radius, candidates);
+    QVector<QUuid> entities;
+    for (const auto& entity : candidates) {
+        if (EntityTreeElement::checkFilterSettings(entity, searchFilter) &&
+            EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+            entities.push_back(entity->getID());
+        }
+    }
+    _sphereQueryCache.insert(version, key, entities);
+    foundEntities.swap(entities);
 }
 
 class FindEntitiesInSphereWithTypeArgs {
@@ -1194,13 +1269,35 @@ bool findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
     return false;
 }
 
-// NOTE: assumes caller has handled locking
+// NOTE: assumes caller has handled locking, see withSearchLock()
 void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
+    if (!_useSpatialIndex) {
+        FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
+        // NOTE: This should use recursion, since this is a spatial operation
+        recurseTreeWithOperation(findInBoxOperation, &args);
+        // swap the two lists of entity pointers instead of copy
+        foundEntities.swap(args.entities);
+        return;
+    }
+
+    uint64_t version = _spatialIndex->getVersion(box.getMinimumPoint(), box.getMaximumPoint());
+    QByteArray key = makeQueryCacheKey(box.getMinimumPoint(), box.getMaximumPoint(), searchFilter);
+    if (_boxQueryCache.find(version, key, foundEntities)) {
+        return;
+    }
+
+    std::vector<EntityItemPointer> candidates;
+    _spatialIndex->findInBox(box, candidates);
+    QVector<QUuid> entities;
+    for (const auto& entity : candidates) {
+        bool success;
+        AABox entityBox = entity->getAABox(success);
+        if (success && entityBox.touches(box) && EntityTreeElement::checkFilterSettings(entity, searchFilter)) {
+            entities.push_back(entity->getID());
+        }
+    }
+    _boxQueryCache.insert(version, key, entities);
+    foundEntities.swap(entities);
 }
 
 class FindEntitiesInFrustumArgs {
@@ -1238,11 +1335,7 @@ EntityItemPointer EntityTree::findEntityByID(const QUuid& id) const {
 }
 
 EntityItemPointer EntityTree::findEntityByEntityItemID(const EntityItemID& entityID) const {
-    EntityItemPointer foundEntity = nullptr;
-    {
-        QReadLocker locker(&_entityMapLock);
-        foundEntity = _entityMap.value(entityID);
-    }
+    EntityItemPointer foundEntity = _entityMap.value(entityID);
     if (foundEntity && !foundEntity->getElement()) {
         // special case to maintain legacy behavior:
         // if the entity is in the map but not in the tree
@@ -1426,18 +1519,104 @@ void EntityTree::fixupTerseEditLogging(EntityItemProperties& properties, QList<Q
 }
 
 
-bool EntityTree::filterProperties(const EntityItemPointer& existingEntity, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, FilterType filterType) const {
+bool EntityTree::filterProperties(const EntityItemPointer& existingEntity, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, FilterType filterType,
+                                  FilterPass pass, const QUuid& senderID) const {
     bool accepted = true;
     auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
     if (entityEditFilters) {
         auto position = existingEntity ? existingEntity->getWorldPosition() : propertiesIn.getPosition();
         auto entityID = existingEntity ? existingEntity->getEntityItemID() : EntityItemID();
-        accepted = entityEditFilters->filter(position, propertiesIn, propertiesOut, wasChanged, filterType, entityID, existingEntity);
+        accepted = entityEditFilters->filter(position, propertiesIn, propertiesOut, wasChanged, filterType, entityID, existingEntity, pass,
+                                             senderID);
     }
 
     return accepted;
 }
 
+void EntityTree::prefilterEditPacket(ReceivedMessage& message, const SharedNodePointer& senderNode) {
+    _prefilteredEdits.clear();
+
+    PacketType packetType = message.getType();
+    if (!isEntityServer() ||
+        (packetType != PacketType::EntityAdd && packetType != PacketType::EntityEdit && packetType != PacketType::EntityPhysics)) {
+        return;
+    }
+
+    bool isAdd = packetType == PacketType::EntityAdd;
+    bool isPhysics = packetType == PacketType::EntityPhysics;
+    FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
+
+    // Having (un)lock rights bypasses the filter, unless it's a physics result.
+    auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
+    bool runNativeFilters = entityEditFilters && entityEditFilters->hasNativeFilters() &&
+        (isPhysics || !senderNode->isAllowedEditor());
+    QUuid senderID = senderNode->getUUID();
+
+    // decoding doesn't touch the tree, and the entity map has its own locks, so split the packet into its edits and
+    // find their entities up front
+    std::vector<PrefilteredEdit> edits;
+    const unsigned char* editData = reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition());
+    int bytesLeft = message.getBytesLeftToRead();
+    while (bytesLeft > 0) {
+        PrefilteredEdit edit;
+        edit.editData = editData;
+        edit.validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, bytesLeft, edit.processedBytes,
+                                                                            edit.entityItemID, edit.properties);
+        if (edit.processedBytes <= 0 || edit.processedBytes > bytesLeft) {
+            break;
+        }
+        editData += edit.processedBytes;
+        bytesLeft -= edit.processedBytes;
+        edits.push_back(std::move(edit));
+    }
+
+    // the lookups and native filters only take shard and entity level locks, spread them across the available cores
+    auto filterEdits = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            prefilterEdit(edits[i], filterType, runNativeFilters, senderID);
+        }
+    };
+
+    const size_t MIN_EDITS_PER_TASK = 8;
+    size_t numTasks = std::min((size_t)std::max(1, QThread::idealThreadCount()), edits.size() / MIN_EDITS_PER_TASK);
+    if (numTasks > 1) {
+        size_t editsPerTask = (edits.size() + numTasks - 1) / numTasks;
+        std::vector<QFuture<void>> futures;
+        for (size_t begin = editsPerTask; begin < edits.size(); begin += editsPerTask) {
+            size_t end = std::min(begin + editsPerTask, edits.size());
+            futures.push_back(QtConcurrent::run([&filterEdits, begin, end] { filterEdits(begin, end); }));
+        }
+        filterEdits(0, editsPerTask);
+        for (auto& future : futures) {
+            future.waitForFinished();
+        }
+    } else {
+        filterEdits(0, edits.size());
+    }
+
+    for (auto& edit : edits) {
+        const unsigned char* key = edit.editData;
+        _prefilteredEdits.emplace(key, std::move(edit));
+    }
+}
+
+void EntityTree::prefilterEdit(PrefilteredEdit& edit, FilterType filterType, bool runNativeFilters, const QUuid& senderID) const {
+    if (!edit.validEditPacket) {
+        return;
+    }
+    bool isAdd = filterType == FilterType::Add;
+    if (!isAdd) {
+        edit.existingEntity = findEntityByEntityItemID(edit.entityItemID);
+    }
+    if (!runNativeFilters || (!isAdd && !edit.existingEntity)) {
+        // the entity may be added before the edit is applied, so leave the edit to the full filter then
+        return;
+    }
+    edit.accepted = filterProperties(edit.existingEntity, edit.properties, edit.properties, edit.wasChanged, filterType,
+                                     FilterPass::NativeOnly, senderID);
+    edit.nativeFiltered = true;
+}
+
 void EntityTree::bumpTimestamp(EntityItemProperties& properties) { //fixme put class/header
     const quint64 LAST_EDITED_SERVERSIDE_BUMP = 1; // usec
     // also bump up the lastEdited time of the properties so that the interface that created this edit
@@ -1514,7 +1693,14 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
             bool validEditPacket = false;
             EntityItemID entityIDToClone;
             EntityItemPointer entityToClone;
-            if (isClone) {
+            auto prefilteredEdit = isClone ? _prefilteredEdits.end() : _prefilteredEdits.find(editData);
+            bool wasPrefiltered = prefilteredEdit != _prefilteredEdits.end();
+            if (wasPrefiltered) {
+                validEditPacket = prefilteredEdit->second.validEditPacket;
+                processedBytes = prefilteredEdit->second.processedBytes;
+                entityItemID = prefilteredEdit->second.entityItemID;
+                properties = prefilteredEdit->second.properties;
+            } else if (isClone) {
                 QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
                 validEditPacket = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, entityIDToClone, entityItemID);
                 if (validEditPacket) {
@@ -1531,9 +1717,15 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
 
             EntityItemPointer existingEntity;
             if (!isAdd) {
-                // search for the entity by EntityItemID
+                // search for the entity by EntityItemID, unless it was found before taking the lock and is still in
+                // the tree: deleting it clears its element under this same lock
                 startLookup = usecTimestampNow();
-                existingEntity = findEntityByEntityItemID(entityItemID);
+                if (wasPrefiltered && prefilteredEdit->second.existingEntity &&
+                    prefilteredEdit->second.existingEntity->getElement()) {
+                    existingEntity = prefilteredEdit->second.existingEntity;
+                } else {
+                    existingEntity = findEntityByEntityItemID(entityItemID);
+                }
                 endLookup = usecTimestampNow();
                 if (!existingEntity) {
                     // this is not an add-entity operation, and we don't know about the identified entity.
@@ -1635,7 +1827,17 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                 bool wasChanged = false;
                 // Having (un)lock rights bypasses the filter, unless it's a physics result.
                 FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
+                bool allowed;
+                if (wasPrefiltered && prefilteredEdit->second.getRemainingFilterPass() == FilterPass::ScriptOnly) {
+                    // the native filters already ran in prefilterEditPacket(), only the script filters are left
+                    wasChanged = prefilteredEdit->second.wasChanged;
+                    allowed = prefilteredEdit->second.accepted &&
+                        filterProperties(existingEntity, properties, properties, wasChanged, filterType, FilterPass::ScriptOnly);
+                } else {
+                    allowed = (!isPhysics && senderNode->isAllowedEditor()) ||
+                        filterProperties(existingEntity, properties, properties, wasChanged, filterType, FilterPass::All,
+                                         senderNode->getUUID());
+                }
                 if (!allowed) {
                     // the update failed and we need to convey that fact to the sender
                     // our method is to re-assert the current properties and bump the lastEdited timestamp
@@ -2051,7 +2253,9 @@ bool EntityTree::shouldEraseEntity(EntityItemID entityID, const SharedNodePointe
     EntityItemProperties dummyProperties;
     bool wasChanged = false;
 
-    bool allowed = (sourceNode->isAllowedEditor()) || filterProperties(existingEntity, dummyProperties, dummyProperties, wasChanged, filterType);
+    bool allowed = (sourceNode->isAllowedEditor()) ||
+        filterProperties(existingEntity, dummyProperties, dummyProperties, wasChanged, filterType, FilterPass::All,
+                         sourceNode->getUUID());
     auto endFilter = usecTimestampNow();
 
     _totalFilterTime += endFilter - startFilter;
@@ -2184,11 +2388,7 @@ int EntityTree::processEraseMessageDetails(const QByteArray& dataByteArray, cons
 }
 
 EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& entityItemID)  /*const*/ {
-    EntityItemPointer entity;
-    {
-        QReadLocker locker(&_entityMapLock);
-        entity = _entityMap.value(entityItemID);
-    }
+    EntityItemPointer entity = _entityMap.value(entityItemID);
     if (entity) {
         return entity->getElement();
     }
@@ -2197,25 +2397,73 @@ EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& en
 
 void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
     EntityItemID id = entity->getEntityItemID();
-    QWriteLocker locker(&_entityMapLock);
-    EntityItemPointer otherEntity = _entityMap.value(id);
-    if (otherEntity) {
+    if (!_entityMap.insert(id, entity)) {
         qCWarning(entities) << "EntityTree::addEntityMapEntry() found pre-existing id " << id;
         assert(false);
         return;
     }
-    _entityMap.insert(id, entity);
+    if (_useSpatialIndex) {
+        addToSpatialIndex(entity);
+    }
 }
 
 void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
-    QWriteLocker locker(&_entityMapLock);
+    EntityItemPointer entity = _entityMap.value(id);
     _entityMap.remove(id);
+    if (entity && _useSpatialIndex) {
+        removeFromSpatialIndex(entity);
+    }
+}
+
+void EntityTree::setUseSpatialIndex(bool useSpatialIndex) {
+    withWriteLock([&] {
+        if (useSpatialIndex == _useSpatialIndex) {
+            return;
+        }
+        // while the index is off nothing tells it about moves, so it is emptied, and filled again when turned on
+        if (useSpatialIndex) {
+            _entityMap.forEach([&](const EntityItemPointer& entity) {
+                addToSpatialIndex(entity);
+            });
+        } else {
+            _entityMap.forEach([&](const EntityItemPointer& entity) {
+                removeFromSpatialIndex(entity);
+            });
+            _spatialIndex->clear();
+        }
+        _useSpatialIndex = useSpatialIndex;
+    });
+}
+
+void EntityTree::addToSpatialIndex(const EntityItemPointer& entity) {
+    std::weak_ptr<EntitySpatialIndex> weakIndex = _spatialIndex;
+    EntityItem::ChangeHandlerId handlerId = entity->registerChangeHandler([weakIndex](const EntityItemID& id) {
+        auto index = weakIndex.lock();
+        if (index) {
+            index->markChanged(id);
+        }
+    });
+    {
+        std::lock_guard<std::mutex> lock(_spatialIndexHandlersLock);
+        _spatialIndexHandlers.insert(entity->getEntityItemID(), handlerId);
+    }
+    _spatialIndex->add(entity);
+}
+
+void EntityTree::removeFromSpatialIndex(const EntityItemPointer& entity) {
+    EntityItem::ChangeHandlerId handlerId;
+    {
+        std::lock_guard<std::mutex> lock(_spatialIndexHandlersLock);
+        handlerId = _spatialIndexHandlers.take(entity->getEntityItemID());
+    }
+    if (!handlerId.isNull()) {
+        entity->deregisterChangeHandler(handlerId);
+    }
+    _spatialIndex->remove(entity->getEntityItemID());
 }
 
 void EntityTree::debugDumpMap() {
-    // QHash's are implicitly shared, so we make a shared copy and use that instead.
-    // This way we might be able to avoid both a lock and a true copy.
-    QHash<EntityItemID, EntityItemPointer> localMap(_entityMap);
+    QHash<EntityItemID, EntityItemPointer> localMap = _entityMap.snapshot();
     qCDebug(entities) << "EntityTree::debugDumpMap() --------------------------";
     QHashIterator<EntityItemID, EntityItemPointer> i(localMap);
     while (i.hasNext()) {
@@ -12,6 +12,9 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <cfloat>
+#include <unordered_map>
+
 #include <QSet>
 #include <QVector>
 
@@ -20,9 +23,11 @@
 #include <SpatialParentFinder.h>
 
 #include "AddEntityOperator.h"
+#include "EntitySpatialIndex.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
+#include "ShardedEntityMap.h"
 
 class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
@@ -56,6 +61,13 @@ public:
         Physics,
         Delete
     };
+    // Native (rules) edit filters don't need a script engine, so they can be evaluated ahead of the script filters,
+    // on any thread, outside of the tree lock.
+    enum class FilterPass {
+        All,
+        NativeOnly,
+        ScriptOnly
+    };
     EntityTree(bool shouldReaverage = false);
     virtual ~EntityTree();
 
@@ -91,6 +103,26 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual void prefilterEditPacket(ReceivedMessage& message, const SharedNodePointer& senderNode) override;
+
+    // an edit of an inbound packet, decoded, looked up and run through the native filters ahead of applying it,
+    // so none of that needs the tree's write lock
+    struct PrefilteredEdit {
+        const unsigned char* editData { nullptr };
+        int processedBytes { 0 };
+        bool validEditPacket { false };
+        bool nativeFiltered { false };
+        bool accepted { true };
+        bool wasChanged { false };
+        EntityItemID entityItemID;
+        EntityItemProperties properties;
+        EntityItemPointer existingEntity;
+
+        // an edit the native filters couldn't check (its entity wasn't there yet) still gets every filter
+        FilterPass getRemainingFilterPass() const { return nativeFiltered ? FilterPass::ScriptOnly : FilterPass::All; }
+    };
+    void prefilterEdit(PrefilteredEdit& edit, FilterType filterType, bool runNativeFilters, const QUuid& senderID) const;
+    virtual void clearPrefilteredEdits() override { _prefilteredEdits.clear(); }
 
     virtual EntityItemID evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
         QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
@@ -144,6 +176,24 @@ public:
     void evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities);
     void evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities);
 
+    /// Ray and parabola picks and sphere and box searches use the spatial index when set (the default), and recurse the
+    /// octree otherwise.
+    /// The index is only kept up to date while it is used.
+    void setUseSpatialIndex(bool useSpatialIndex);
+    bool getUseSpatialIndex() const { return _useSpatialIndex; }
+
+    /// Runs evalEntitiesInSphere or evalEntitiesInBox. With the spatial index on, those only touch the index and the
+    /// entities' own locked properties, so they skip the octree read lock and never wait for a tree writer.
+    template <typename F>
+    void withSearchLock(F&& f) const {
+        if (_useSpatialIndex) {
+            f();
+        } else {
+            withReadLock(std::forward<F>(f));
+        }
+    }
+    EntitySpatialIndex::Stats getSpatialIndexStats() const { return _spatialIndex->getStats(); }
+
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
@@ -171,6 +221,7 @@ public:
     void addEntityMapEntry(EntityItemPointer entity);
     void clearEntityMapEntry(const EntityItemID& id);
     void debugDumpMap();
+    QJsonObject getEntityMapLockStats() const { return _entityMap.getLockStatsJson(); }
     virtual void dumpTree() override;
     virtual void pruneTree() override;
 
@@ -325,8 +376,18 @@ protected:
         _deletedEntityItemIDs << id;
     }
 
-    mutable QReadWriteLock _entityMapLock;
-    QHash<EntityItemID, EntityItemPointer> _entityMap;
+    ShardedEntityMap _entityMap;
+
+    void addToSpatialIndex(const EntityItemPointer& entity);
+    void removeFromSpatialIndex(const EntityItemPointer& entity);
+
+    // shared so that the change handlers registered on the entities never outlive it
+    std::shared_ptr<EntitySpatialIndex> _spatialIndex { std::make_shared<EntitySpatialIndex>() };
+    std::mutex _spatialIndexHandlersLock;
+    QHash<EntityItemID, EntityItem::ChangeHandlerId> _spatialIndexHandlers;
+    std::atomic<bool> _useSpatialIndex { true };
+    EntityQueryCache<QByteArray, QVector<QUuid>> _sphereQueryCache;
+    EntityQueryCache<QByteArray, QVector<QUuid>> _boxQueryCache;
 
     EntitySimulationPointer _simulation;
 
@@ -365,7 +426,12 @@ protected:
 
     float _maxTmpEntityLifetime { DEFAULT_MAX_TMP_ENTITY_LIFETIME };
 
-    bool filterProperties(const EntityItemPointer& existingEntity, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, FilterType filterType) const;
+    bool filterProperties(const EntityItemPointer& existingEntity, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, FilterType filterType,
+                          FilterPass pass = FilterPass::All, const QUuid& senderID = QUuid()) const;
+
+    // edits of the packet being processed that were decoded and went through the native filters ahead of time,
+    // keyed by the start of their data in the packet
+    std::unordered_map<const unsigned char*, PrefilteredEdit> _prefilteredEdits;
     bool _hasEntityEditFilter{ false };
     QStringList _entityScriptSourceAllowlist;
 
@@ -135,6 +135,23 @@ public:
     virtual bool deleteApproved() const override { return !hasEntities(); }
 
     static bool checkFilterSettings(const EntityItemPointer& entity, PickFilter searchFilter);
+    /// Exact ray test against a single entity, also used by the EntityTree spatial index.
+    /// @return true if the entity is hit closer than distance, in which case the hit is written to the out parameters
+    static bool evalEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin, const glm::vec3& direction,
+                         const glm::vec3& viewFrustumPos, OctreeElementPointer& element, float& distance,
+                         BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
+                         const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
+    /// Exact parabola test against a single entity, also used by the EntityTree spatial index.
+    /// @param normal The normal of the plane of the parabola, from getParabolaPlaneNormal()
+    /// @return true if the entity is hit closer than parabolicDistance, in which case the hit is written to the out parameters
+    static bool evalEntityParabolaIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+                         const glm::vec3& velocity, const glm::vec3& acceleration, const glm::vec3& viewFrustumPos,
+                         const glm::vec3& normal, OctreeElementPointer& element, float& parabolicDistance,
+                         BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
+                         const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
+    static glm::vec3 getParabolaPlaneNormal(const glm::vec3& velocity, const glm::vec3& acceleration);
+    /// Exact sphere test against a single entity, ignoring the search filter
+    static bool entityTouchesSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius);
     virtual bool canPickIntersect() const override { return hasEntities(); }
     virtual EntityItemID evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& viewFrustumPos,
         OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
@@ -0,0 +1,167 @@
+//
+//  ShardedEntityMap.cpp
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ShardedEntityMap.h"
+
+#include <QtCore/QJsonArray>
+
+#include <SharedUtil.h>
+
+void ShardedEntityMap::Shard::lockForRead() const {
+    if (!lock.tryLockForRead()) {
+        quint64 start = usecTimestampNow();
+        lock.lockForRead();
+        contendedLocks++;
+        waitUsecs += usecTimestampNow() - start;
+    }
+}
+
+void ShardedEntityMap::Shard::lockForWrite() const {
+    if (!lock.tryLockForWrite()) {
+        quint64 start = usecTimestampNow();
+        lock.lockForWrite();
+        contendedLocks++;
+        waitUsecs += usecTimestampNow() - start;
+    }
+}
+
+EntityItemPointer ShardedEntityMap::value(const EntityItemID& id) const {
+    EntityItemPointer entity;
+    const Shard& shard = shardFor(id);
+    withReadLock(shard, [&] {
+        entity = shard.entities.value(id);
+    });
+    return entity;
+}
+
+bool ShardedEntityMap::insert(const EntityItemID& id, const EntityItemPointer& entity) {
+    bool inserted = false;
+    Shard& shard = shardFor(id);
+    withWriteLock(shard, [&] {
+        auto it = shard.entities.find(id);
+        if (it == shard.entities.end() || !it.value()) {
+            shard.entities.insert(id, entity);
+            inserted = true;
+        }
+    });
+    return inserted;
+}
+
+void ShardedEntityMap::remove(const EntityItemID& id) {
+    Shard& shard = shardFor(id);
+    withWriteLock(shard, [&] {
+        shard.entities.remove(id);
+    });
+}
+
+void ShardedEntityMap::clear() {
+    for (auto& shard : _shards) {
+        withWriteLock(shard, [&] {
+            shard.entities.clear();
+        });
+    }
+}
+
+int ShardedEntityMap::size() const {
+    int size = 0;
+    for (const auto& shard : _shards) {
+        withReadLock(shard, [&] {
+            size += shard.entities.size();
+        });
+    }
+    return size;
+}
+
+void ShardedEntityMap::forEach(const std::function<void(const EntityItemPointer&)>& operation) const {
+    for (const auto& shard : _shards) {
+        // QHash is implicitly shared, so this only holds the shard lock long enough to take a reference
+        QHash<EntityItemID, EntityItemPointer> entities;
+        withReadLock(shard, [&] {
+            entities = shard.entities;
+        });
+        for (const auto& entity : entities) {
+            operation(entity);
+        }
+    }
+}
+
+QHash<EntityItemID, EntityItemPointer> ShardedEntityMap::snapshot() const {
+    QHash<EntityItemID, EntityItemPointer> result;
+    result.reserve(size());
+    for (const auto& shard : _shards) {
+        withReadLock(shard, [&] {
+            for (auto it = shard.entities.constBegin(); it != shard.entities.constEnd(); ++it) {
+                result.insert(it.key(), it.value());
+            }
+        });
+    }
+    return result;
+}
+
+QHash<EntityItemID, EntityItemPointer> ShardedEntityMap::takeAll() {
+    // always locked in shard order, and no other caller holds more than one shard lock at a time
+    for (const auto& shard : _shards) {
+        shard.lockForWrite();
+    }
+    QHash<EntityItemID, EntityItemPointer> result;
+    for (auto& shard : _shards) {
+        if (result.isEmpty()) {
+            result.swap(shard.entities);
+        } else {
+            for (auto it = shard.entities.constBegin(); it != shard.entities.constEnd(); ++it) {
+                result.insert(it.key(), it.value());
+            }
+            shard.entities.clear();
+        }
+    }
+    for (const auto& shard : _shards) {
+        shard.unlock();
+    }
+    return result;
+}
+
+void ShardedEntityMap::reset(const QHash<EntityItemID, EntityItemPointer>& entities) {
+    std::array<QHash<EntityItemID, EntityItemPointer>, NUM_SHARDS> sharded;
+    for (auto it = entities.constBegin(); it != entities.constEnd(); ++it) {
+        sharded[qHash(it.key()) & (NUM_SHARDS - 1)].insert(it.key(), it.value());
+    }
+    for (int i = 0; i < NUM_SHARDS; ++i) {
+        withWriteLock(_shards[i], [&] {
+            _shards[i].entities.swap(sharded[i]);
+        });
+    }
+}
+
+ShardedEntityMap::LockStats ShardedEntityMap::getLockStats() const {
+    LockStats stats;
+    for (const auto& shard : _shards) {
+        stats.contendedLocks += shard.contendedLocks;
+        stats.waitUsecs += shard.waitUsecs;
+    }
+    return stats;
+}
+
+QJsonObject ShardedEntityMap::getLockStatsJson() const {
+    LockStats stats = getLockStats();
+
+    QJsonObject json;
+    json["1. shards"] = NUM_SHARDS;
+    json["2. contendedLocks"] = (double)stats.contendedLocks;
+    json["3. waitUsecs"] = (double)stats.waitUsecs;
+    json["4. avgWaitUsecsWhenContended"] = stats.contendedLocks > 0 ? (double)stats.waitUsecs / (double)stats.contendedLocks : 0.0;
+
+    QJsonArray contendedPerShard;
+    for (const auto& shard : _shards) {
+        contendedPerShard.append((double)shard.contendedLocks);
+    }
+    json["5. contendedLocksPerShard"] = contendedPerShard;
+    return json;
+}
@@ -0,0 +1,99 @@
+//
+//  ShardedEntityMap.h
+//  libraries/entities/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_ShardedEntityMap_h
+#define hifi_ShardedEntityMap_h
+
+#include <array>
+#include <atomic>
+#include <functional>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QReadWriteLock>
+
+#include "EntityItem.h"
+#include "EntityItemID.h"
+
+/// The entity ID to entity index of an EntityTree, split into independently locked shards so lookups and
+/// inserts of different entities don't serialize on a single lock.
+///
+/// Every lock acquisition is first tried without blocking, so the map can count how often and for how
+/// long callers had to wait, per shard. Only the waits are counted: uncontended lookups touch nothing but their shard.
+class ShardedEntityMap {
+public:
+    static const int NUM_SHARDS = 16;
+
+    struct LockStats {
+        quint64 contendedLocks { 0 };
+        quint64 waitUsecs { 0 };
+    };
+
+    EntityItemPointer value(const EntityItemID& id) const;
+    bool contains(const EntityItemID& id) const { return value(id) != nullptr; }
+
+    /// @return false if an entity with the same ID is already in the map, which is left unchanged
+    bool insert(const EntityItemID& id, const EntityItemPointer& entity);
+    void remove(const EntityItemID& id);
+    void clear();
+
+    int size() const;
+
+    /// Calls the operator on every entity, holding the read lock of one shard at a time.
+    /// Entities added or removed concurrently in another shard may or may not be visited.
+    void forEach(const std::function<void(const EntityItemPointer&)>& operation) const;
+
+    /// @return A copy of the whole map, for the callers that need to iterate while modifying it.
+    QHash<EntityItemID, EntityItemPointer> snapshot() const;
+    /// Empties the map and returns what it held. The write locks of all the shards are held together, so an entity
+    /// inserted concurrently is either returned or stays in the map.
+    QHash<EntityItemID, EntityItemPointer> takeAll();
+    /// Replaces the contents of the map.
+    void reset(const QHash<EntityItemID, EntityItemPointer>& entities);
+
+    LockStats getLockStats() const;
+    QJsonObject getLockStatsJson() const;
+
+private:
+    // aligned so the lock of one shard is never on the cache line of the next
+    struct alignas(64) Shard {
+        void lockForRead() const;
+        void lockForWrite() const;
+        void unlock() const { lock.unlock(); }
+
+        mutable QReadWriteLock lock;
+        QHash<EntityItemID, EntityItemPointer> entities;
+
+        mutable std::atomic<quint64> contendedLocks { 0 };
+        mutable std::atomic<quint64> waitUsecs { 0 };
+    };
+
+    template <typename F>
+    static void withReadLock(const Shard& shard, F&& f) {
+        shard.lockForRead();
+        f();
+        shard.unlock();
+    }
+
+    template <typename F>
+    static void withWriteLock(const Shard& shard, F&& f) {
+        shard.lockForWrite();
+        f();
+        shard.unlock();
+    }
+
+    const Shard& shardFor(const EntityItemID& id) const { return _shards[qHash(id) & (NUM_SHARDS - 1)]; }
+    Shard& shardFor(const EntityItemID& id) { return _shards[qHash(id) & (NUM_SHARDS - 1)]; }
+
+    std::array<Shard, NUM_SHARDS> _shards;
+};
+
+#endif // hifi_ShardedEntityMap_h
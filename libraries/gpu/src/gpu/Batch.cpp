@@ -39,6 +39,8 @@ using namespace gpu;
 static const int MAX_NUM_UNIFORM_BUFFERS = 14;
 static const int MAX_NUM_RESOURCE_BUFFERS = 16;
 static const int MAX_NUM_RESOURCE_TEXTURES = 16;
+// Named buffers kept around between uses of a batch; a frame that needed more than this gives the extra ones back
+static const size_t MAX_NAMED_BUFFER_POOL_SIZE = 64;
 
 size_t Batch::_commandsMax{ BATCH_PREALLOCATE_MIN };
 size_t Batch::_commandOffsetsMax{ BATCH_PREALLOCATE_MIN };
@@ -87,6 +89,16 @@ void Batch::clear() {
     _framebuffers.clear();
     _lambdas.clear();
     _names.clear();
+
+    // Keep the named buffers that nothing else holds on to, rather than allocating new ones for the next use
+    for (auto& namedCallData : _namedData) {
+        for (auto& buffer : namedCallData.second.buffers) {
+            if (buffer && buffer.use_count() == 1 && _namedBufferPool.size() < MAX_NAMED_BUFFER_POOL_SIZE) {
+                buffer->resize(0);
+                _namedBufferPool.push_back(std::move(buffer));
+            }
+        }
+    }
     _namedData.clear();
     _objects.clear();
     _params.clear();
@@ -110,6 +122,166 @@ void Batch::clear() {
     _mustUpdatePreviousModels = true;
 }
 
+static void offsetParam(Batch::Param& param, size_t offset) {
+#if (QT_POINTER_SIZE == 8)
+    param._size += offset;
+#else
+    param._uint += (uint32)offset;
+#endif
+}
+
+void Batch::append(const Batch& other) {
+    assert(other._currentNamedCall.empty());
+
+    const size_t paramsOffset = _params.size();
+    const size_t dataOffset = _data.size();
+    const size_t objectsOffset = _objects.size();
+    const size_t buffersOffset = _buffers.append(other._buffers);
+    const size_t texturesOffset = _textures.append(other._textures);
+    const size_t textureTablesOffset = _textureTables.append(other._textureTables);
+    const size_t samplersOffset = _samplers.append(other._samplers);
+    const size_t streamFormatsOffset = _streamFormats.append(other._streamFormats);
+    const size_t transformsOffset = _transforms.append(other._transforms);
+    const size_t pipelinesOffset = _pipelines.append(other._pipelines);
+    const size_t framebuffersOffset = _framebuffers.append(other._framebuffers);
+    const size_t swapChainsOffset = _swapChains.append(other._swapChains);
+    const size_t queriesOffset = _queries.append(other._queries);
+    const size_t lambdasOffset = _lambdas.append(other._lambdas);
+    const size_t profileRangesOffset = _profileRanges.append(other._profileRanges);
+    const size_t namesOffset = _names.append(other._names);
+
+    _commands.insert(_commands.end(), other._commands.begin(), other._commands.end());
+    _commandOffsets.reserve(_commandOffsets.size() + other._commandOffsets.size());
+    for (auto offset : other._commandOffsets) {
+        _commandOffsets.push_back(offset + paramsOffset);
+    }
+    _params.insert(_params.end(), other._params.begin(), other._params.end());
+    _data.insert(_data.end(), other._data.begin(), other._data.end());
+
+    // Move the params that point into the caches or the data along with them
+    const size_t numCommands = other._commands.size();
+    for (size_t i = 0; i < numCommands; ++i) {
+        const size_t commandOffset = other._commandOffsets[i];
+        const size_t numParams = (i + 1 < numCommands ? other._commandOffsets[i + 1] : other._params.size()) - commandOffset;
+        Param* params = _params.data() + paramsOffset + commandOffset;
+
+        switch (other._commands[i]) {
+            case COMMAND_setInputFormat:
+                offsetParam(params[0], streamFormatsOffset);
+                break;
+            case COMMAND_setInputBuffer:
+            case COMMAND_setUniformBuffer:
+                offsetParam(params[2], buffersOffset);
+                break;
+            case COMMAND_setIndexBuffer:
+            case COMMAND_copySavedViewProjectionTransformToBuffer:
+                offsetParam(params[1], buffersOffset);
+                break;
+            case COMMAND_setIndirectBuffer:
+            case COMMAND_setResourceBuffer:
+                offsetParam(params[0], buffersOffset);
+                break;
+            case COMMAND_setViewTransform:
+                offsetParam(params[0], transformsOffset);
+                break;
+            case COMMAND_setProjectionTransform:
+            case COMMAND_setViewportTransform:
+            case COMMAND_setStateScissorRect:
+            case COMMAND_glUniform3fv:
+            case COMMAND_glUniform4fv:
+            case COMMAND_glUniform4iv:
+            case COMMAND_glUniformMatrix3fv:
+            case COMMAND_glUniformMatrix4fv:
+                offsetParam(params[0], dataOffset);
+                break;
+            case COMMAND_setProjectionJitterSequence:
+                offsetParam(params[1], dataOffset);
+                break;
+            case COMMAND_setPipeline:
+                offsetParam(params[0], pipelinesOffset);
+                break;
+            case COMMAND_setResourceTexture:
+                offsetParam(params[0], texturesOffset);
+                offsetParam(params[2], samplersOffset);
+                break;
+            case COMMAND_setResourceTextureTable:
+                offsetParam(params[0], textureTablesOffset);
+                // followed by one sampler per texture of the table
+                for (size_t j = 2; j < numParams; ++j) {
+                    offsetParam(params[j], samplersOffset);
+                }
+                break;
+            case COMMAND_setResourceFramebufferSwapChainTexture:
+                offsetParam(params[0], swapChainsOffset);
+                offsetParam(params[4], samplersOffset);
+                break;
+            case COMMAND_setFramebuffer:
+                offsetParam(params[0], framebuffersOffset);
+                break;
+            case COMMAND_setFramebufferSwapChain:
+            case COMMAND_advance:
+                offsetParam(params[0], swapChainsOffset);
+                break;
+            case COMMAND_blit:
+                offsetParam(params[0], framebuffersOffset);
+                offsetParam(params[5], framebuffersOffset);
+                break;
+            case COMMAND_generateTextureMips:
+            case COMMAND_generateTextureMipsWithPipeline:
+                offsetParam(params[0], texturesOffset);
+                break;
+            case COMMAND_beginQuery:
+            case COMMAND_endQuery:
+            case COMMAND_getQuery:
+                offsetParam(params[0], queriesOffset);
+                break;
+            case COMMAND_runLambda:
+                offsetParam(params[0], lambdasOffset);
+                break;
+            case COMMAND_startNamedCall:
+                offsetParam(params[0], namesOffset);
+                break;
+            case COMMAND_pushProfileRange:
+                offsetParam(params[0], profileRangesOffset);
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Draw calls refer to their transform object by index
+    _objects.insert(_objects.end(), other._objects.begin(), other._objects.end());
+    for (const auto& drawCallInfo : other._drawCallInfos) {
+        _drawCallInfos.emplace_back((DrawCallInfo::Index)(drawCallInfo.index + objectsOffset), drawCallInfo.unused);
+    }
+
+    // Named calls run at the end of the frame over the instances of every part, so their instances are concatenated
+    for (const auto& namedCallData : other._namedData) {
+        const auto& name = namedCallData.first;
+        const auto& otherInstance = namedCallData.second;
+        NamedBatchData& instance = _namedData[name];
+        if (!instance.function) {
+            instance.function = otherInstance.function;
+        }
+        for (const auto& drawCallInfo : otherInstance.drawCallInfos) {
+            instance.drawCallInfos.emplace_back((DrawCallInfo::Index)(drawCallInfo.index + objectsOffset), drawCallInfo.unused);
+        }
+        for (size_t i = 0; i < otherInstance.buffers.size(); ++i) {
+            const auto& otherBuffer = otherInstance.buffers[i];
+            if (otherBuffer && otherBuffer->getSize() > 0) {
+                getNamedBuffer(name, (uint8_t)i)->append(otherBuffer->getSize(), otherBuffer->getData());
+            }
+        }
+    }
+
+    // Carry on from the state the other batch ended in
+    _currentModel = other._currentModel;
+    _previousModel = other._previousModel;
+    _invalidModel = true;
+    _drawcallUniform = _drawcallUniformReset;
+    _mustUpdatePreviousModels = _mustUpdatePreviousModels || other._mustUpdatePreviousModels;
+}
+
 size_t Batch::cacheData(size_t size, const void* data) {
     size_t offset = _data.size();
     size_t numBytes = size;
@@ -592,7 +764,12 @@ const BufferPointer& Batch::getNamedBuffer(const std::string& instanceName, uint
         instance.buffers.resize(index + 1);
     }
     if (!instance.buffers[index]) {
-        instance.buffers[index] = std::make_shared<Buffer>();
+        if (!_namedBufferPool.empty()) {
+            instance.buffers[index] = std::move(_namedBufferPool.back());
+            _namedBufferPool.pop_back();
+        } else {
+            instance.buffers[index] = std::make_shared<Buffer>();
+        }
     }
     return instance.buffers[index];
 }
@@ -107,6 +107,11 @@ public:
     const std::string& getName() const { return _name; }
     void clear();
 
+    // Append the commands recorded in another batch after the ones of this batch, as if they had been recorded here.
+    // This lets several threads record parts of a pass into their own batches, merged in order before submission.
+    // The other batch must not be in a named call, and should set its own model transform before drawing.
+    void append(const Batch& other);
+
     // Batches may need to override the context level stereo settings
     // if they're performing framebuffer copy operations, like the
     // deferred lighting resolution mechanism
@@ -460,6 +465,13 @@ public:
             void clear() {
                 _items.clear();
             }
+
+            // Returns the offset of the first appended item
+            size_t append(const Vector& other) {
+                size_t offset = _items.size();
+                _items.insert(_items.end(), other._items.begin(), other._items.end());
+                return offset;
+            }
         };
     };
 
@@ -544,6 +556,8 @@ public:
     StringCaches _names;
 
     NamedBatchDataMap _namedData;
+    // Named buffers of the previous uses of this batch, emptied and ready to be handed out again
+    std::vector<BufferPointer> _namedBufferPool;
 
     bool _isJitterOnProjectionEnabled { false };
 
@@ -698,6 +698,7 @@ public:
 
     void addSamplerFunc(std::function<void(void)> samplerFunc) { _samplerFuncs.push_back(samplerFunc); }
     void resetSamplers() { _samplerFuncs.clear(); }
+    bool hasSamplers() const { return !_samplerFuncs.empty(); }
     void applySamplers() const;
 
 private:
@@ -12,6 +12,7 @@
 #include "TextureCache.h"
 
 #include <mutex>
+#include <tuple>
 
 #include <QtConcurrent/QtConcurrentRun>
 
@@ -42,6 +43,7 @@
 #include <PathUtils.h>
 #include <Finally.h>
 #include <Profile.h>
+#include <SharedUtil.h>
 
 #include <NetworkLogging.h>
 #include "MaterialNetworkingLogging.h"
@@ -98,6 +100,13 @@ static const QUrl HMD_PREVIEW_FRAME_URL("resource://hmdPreviewFrame");
 static const float SKYBOX_LOAD_PRIORITY { 10.0f }; // Make sure skybox loads first
 static const float HIGH_MIPS_LOAD_PRIORITY { 9.0f }; // Make sure high mips loads after skybox but before models
 
+// Contiguous mips are fetched together in one range request, up to this many bytes
+static const size_t MAX_MIP_BATCH_SIZE { 512 * 1024 };
+// How much the screen priority of a texture's users outweighs the number of mips it already has
+static const float MIP_SCREEN_PRIORITY_WEIGHT { 4.0f };
+
+const uint64_t TextureCache::DEFAULT_MIP_STREAMING_BUDGET { 2048ULL * 1024 * 1024 };
+
 std::function<gpu::TexturePointer(const QUuid&)> Texture::_unboundTextureForUUIDOperator { nullptr };
 
 TextureCache::TextureCache() {
@@ -112,6 +121,64 @@ TextureCache::TextureCache() {
 TextureCache::~TextureCache() {
 }
 
+void TextureCache::setMipStreamingBudget(uint64_t budget) {
+    _mipStreamingBudget = budget;
+    resumeTexturesWaitingForBudget();
+}
+
+float TextureCache::getAverageSharpeningLatency() const {
+    uint64_t numSharpened = _numSharpenedTextures;
+    if (numSharpened == 0) {
+        return 0.0f;
+    }
+    return (float)_totalSharpeningLatency / (float)(numSharpened * USECS_PER_MSEC);
+}
+
+int TextureCache::getNumTexturesWaitingForBudget() {
+    std::lock_guard<std::mutex> lock(_texturesWaitingForBudgetMutex);
+    return (int)_texturesWaitingForBudget.size();
+}
+
+bool TextureCache::reserveMipBytes(const QWeakPointer<Resource>& texture) {
+    // check and wait under the same lock that resumeTexturesWaitingForBudget() checks and resumes under, so that bytes
+    // released in between can't resume the waiting textures before this one joins them
+    std::lock_guard<std::mutex> lock(_texturesWaitingForBudgetMutex);
+    if (_streamedMipBytes < _mipStreamingBudget) {
+        return true;
+    }
+    _texturesWaitingForBudget.push_back(texture);
+    return false;
+}
+
+void TextureCache::releaseStreamedMipBytes(uint64_t bytes) {
+    _streamedMipBytes -= std::min(bytes, _streamedMipBytes.load());
+    resumeTexturesWaitingForBudget();
+}
+
+void TextureCache::resumeTexturesWaitingForBudget() {
+    std::vector<QWeakPointer<Resource>> textures;
+    {
+        std::lock_guard<std::mutex> lock(_texturesWaitingForBudgetMutex);
+        if (_streamedMipBytes >= _mipStreamingBudget) {
+            return;
+        }
+        std::swap(textures, _texturesWaitingForBudget);
+    }
+
+    // The ResourceCache queue decides which of them streams first; any that still don't fit wait again
+    for (auto& texture : textures) {
+        auto resource = texture.lock();
+        if (resource) {
+            QMetaObject::invokeMethod(resource.data(), "startRequestForNextMipLevel", Qt::QueuedConnection);
+        }
+    }
+}
+
+void TextureCache::recordSharpened(quint64 latency) {
+    _totalSharpeningLatency += latency;
+    _numSharpenedTextures++;
+}
+
 // use fixed table of permutations. Could also make ordered list programmatically
 // and then shuffle algorithm. For testing, this ensures consistent behavior in each run.
 // this list taken from Ken Perlin's Improved Noise reference implementation (orig. in Java) at
@@ -526,6 +593,12 @@ private:
 };
 
 NetworkTexture::~NetworkTexture() {
+    if (_streamedMipBytes > 0) {
+        auto textureCache = DependencyManager::get<TextureCache>();
+        if (textureCache) {
+            textureCache->releaseStreamedMipBytes(_streamedMipBytes);
+        }
+    }
     if (_ktxHeaderRequest || _ktxMipRequest) {
         if (_ktxHeaderRequest) {
             _ktxHeaderRequest->disconnect(this);
@@ -602,9 +675,16 @@ void NetworkTexture::makeRequest() {
 
             // Add a fragment to the base url so we can identify the section of the ktx being requested when debugging
             // The actual requested url is _activeUrl and will not contain the fragment
-            uint16_t nextMip = _lowestKnownPopulatedMip - 1;
-            _url.setFragment(QString::number(nextMip));
-            startMipRangeRequest(nextMip, nextMip);
+            // Smaller mips are cheap to fetch one at a time, so take as many contiguous ones as fit in a batch
+            auto& images = _originalKtxDescriptor->images;
+            uint16_t high = _lowestKnownPopulatedMip - 1;
+            uint16_t low = high;
+            while (low > _lowestRequestedMipLevel &&
+                   images[high + 1]._imageOffset - images[low - 1]._imageOffset <= MAX_MIP_BATCH_SIZE) {
+                low--;
+            }
+            _url.setFragment(low == high ? QString::number(high) : QString("%1-%2").arg(low).arg(high));
+            startMipRangeRequest(low, high);
         }
     } else {
         qWarning(networking) << "NetworkTexture::makeRequest() called while not in a valid state: " << _ktxResourceState;
@@ -712,16 +792,52 @@ void NetworkTexture::startRequestForNextMipLevel() {
 
     _lowestKnownPopulatedMip = texture->minAvailableMipLevel();
     if (_lowestRequestedMipLevel < _lowestKnownPopulatedMip) {
+        if (!DependencyManager::get<TextureCache>()->reserveMipBytes(_self)) {
+            // Stay in WAITING_FOR_MIP_REQUEST until the TextureCache has room again
+            return;
+        }
         _ktxResourceState = PENDING_MIP_REQUEST;
 
         init(false);
-        float priority = -(float)_originalKtxDescriptor->header.numberOfMipmapLevels + (float)_lowestKnownPopulatedMip;
-        setLoadPriorityOperator(this, [priority]() { return priority; });
+        setLoadPriorityOperator(this, [this]() { return getMipLoadPriority(); });
         _url.setFragment(QString::number(_lowestKnownPopulatedMip - 1));
         TextureCache::attemptRequest(self);
     }
 }
 
+void NetworkTexture::setMipPriorityOperator(const QPointer<QObject>& owner, std::function<float()> priorityOperator) {
+    // getMipLoadPriority() stops being called once the texture is sharp, so drop the operators of destroyed owners here
+    // too, along with whatever they captured
+    for (auto it = _mipPriorityOperators.begin(); it != _mipPriorityOperators.end();) {
+        if (it.key().isNull()) {
+            it = _mipPriorityOperators.erase(it);
+        } else {
+            it++;
+        }
+    }
+    _mipPriorityOperators.insert(owner, priorityOperator);
+}
+
+float NetworkTexture::getMipLoadPriority() {
+    // Highest across all users, or 0 without any
+    float screenPriority = 0.0f;
+    bool hasUsers = false;
+    for (auto it = _mipPriorityOperators.begin(); it != _mipPriorityOperators.end();) {
+        if (it.key().isNull() || !it.value()) {
+            it = _mipPriorityOperators.erase(it);
+            continue;
+        }
+        float priority = it.value()();
+        screenPriority = hasUsers ? std::max(screenPriority, priority) : priority;
+        hasUsers = true;
+        it++;
+    }
+
+    // Textures with the fewest mips go first, unless their users are much larger on screen
+    float numPopulatedMips = (float)_originalKtxDescriptor->header.numberOfMipmapLevels - (float)_lowestKnownPopulatedMip;
+    return MIP_SCREEN_PRIORITY_WEIGHT * screenPriority - numPopulatedMips;
+}
+
 // Load mips in the range [low, high] (inclusive)
 void NetworkTexture::startMipRangeRequest(uint16_t low, uint16_t high) {
     if (_ktxMipRequest) {
@@ -839,17 +955,34 @@ void NetworkTexture::ktxMipRequestFinished() {
 
         if (_ktxResourceState == REQUESTING_MIP) {
             Q_ASSERT(_ktxMipLevelRangeInFlight.first != NULL_MIP_LEVEL);
-            Q_ASSERT(_ktxMipLevelRangeInFlight.second - _ktxMipLevelRangeInFlight.first == 0);
+            Q_ASSERT(_ktxMipLevelRangeInFlight.second >= _ktxMipLevelRangeInFlight.first);
 
             _ktxResourceState = WAITING_FOR_MIP_REQUEST;
 
             auto self = _self;
             auto url = _url;
             auto data = _ktxMipRequest->getData();
-            auto mipLevel = _ktxMipLevelRangeInFlight.first;
             auto texture = _textureSource->getGPUTexture();
+
+            _streamedMipBytes += data.size();
+            DependencyManager::get<TextureCache>()->addStreamedMipBytes(data.size());
+
+            // Where each mip of the range is in the data, finest first
+            std::vector<std::tuple<uint16_t, size_t, size_t>> mips;
+            auto& images = _originalKtxDescriptor->images;
+            auto lowMipLevel = _ktxMipLevelRangeInFlight.first;
+            for (uint16_t level = lowMipLevel; level <= _ktxMipLevelRangeInFlight.second; level++) {
+                size_t offset = images[level]._imageOffset - images[lowMipLevel]._imageOffset;
+                size_t size = images[level]._imageSize;
+                if (offset + size > (size_t)data.size()) {
+                    break;
+                }
+                mips.emplace_back(level, offset, size);
+            }
+            auto initialLoadTime = _initialLoadTime;
+
             DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
-            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, mipLevel, url, texture] {
+            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, mips, url, texture, initialLoadTime] {
                 PROFILE_RANGE_EX(resource_parse_image, "NetworkTexture - Processing Mip Data", 0xffff0000, 0, { { "url", url.toString() } });
                 DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
                 CounterStat counter("Processing");
@@ -869,14 +1002,27 @@ void NetworkTexture::ktxMipRequestFinished() {
 
                 Q_ASSERT_X(texture, "Async - NetworkTexture::ktxMipRequestFinished", "NetworkTexture should have been assigned a GPU texture by now.");
 
-                texture->assignStoredMip(mipLevel, data.size(), reinterpret_cast<const uint8_t*>(data.data()));
+                // Coarser mips first, so that each one is usable as soon as it is assigned
+                bool assigned = false;
+                for (auto mip = mips.rbegin(); mip != mips.rend(); ++mip) {
+                    auto mipLevel = std::get<0>(*mip);
+                    texture->assignStoredMip(mipLevel, std::get<2>(*mip),
+                                             reinterpret_cast<const uint8_t*>(data.data()) + std::get<1>(*mip));
 
-                // If mip level assigned above is still unavailable, then we assume future requests will also fail.
-                auto minMipLevel = texture->minAvailableMipLevel();
-                if (minMipLevel > mipLevel) {
+                    // If mip level assigned above is still unavailable, then we assume future requests will also fail.
+                    if (texture->minAvailableMipLevel() > mipLevel) {
+                        break;
+                    }
+                    assigned = true;
+                }
+                if (!assigned) {
                     return;
                 }
 
+                if (texture->minAvailableMipLevel() == 0 && initialLoadTime > 0) {
+                    DependencyManager::get<TextureCache>()->recordSharpened(usecTimestampNow() - initialLoadTime);
+                }
+
                 QMetaObject::invokeMethod(resource.data(), "setImage",
                     Q_ARG(gpu::TexturePointer, texture),
                     Q_ARG(int, texture->getWidth()),
@@ -913,6 +1059,7 @@ void NetworkTexture::handleFinishedInitialLoad() {
     _ktxHighMipData.clear();
 
     _ktxResourceState = WAITING_FOR_MIP_REQUEST;
+    _initialLoadTime = usecTimestampNow();
 
     auto self = _self;
     auto url = _url;
@@ -12,12 +12,16 @@
 #ifndef hifi_TextureCache_h
 #define hifi_TextureCache_h
 
+#include <atomic>
+#include <mutex>
+
 #include <gpu/Texture.h>
 
 #include <QImage>
 #include <QMap>
 #include <QColor>
 #include <QMetaEnum>
+#include <QtCore/QPointer>
 #include <QtCore/QSharedPointer>
 
 #include <DependencyManager.h>
@@ -73,6 +77,10 @@ public:
 
     void setExtra(void* extra) override;
 
+    /// Sets how much one user of the texture wants its higher resolution mips, usually from its size on screen.
+    /// Unlike load priority operators these are kept once the texture has loaded, since they order mip streaming.
+    void setMipPriorityOperator(const QPointer<QObject>& owner, std::function<float()> priorityOperator);
+
 signals:
     void networkTextureCreated(const QWeakPointer<NetworkTexture>& self);
 
@@ -100,6 +108,8 @@ protected:
     void startMipRangeRequest(uint16_t low, uint16_t high);
     void handleFinishedInitialLoad();
 
+    float getMipLoadPriority();
+
 private:
     friend class KTXReader;
     friend class ImageReader;
@@ -138,6 +148,12 @@ private:
     uint16_t _lowestRequestedMipLevel { NULL_MIP_LEVEL };
     uint16_t _lowestKnownPopulatedMip { NULL_MIP_LEVEL };
 
+    QHash<QPointer<QObject>, std::function<float()>> _mipPriorityOperators;
+
+    // Bytes of mip data streamed so far, counted against the TextureCache budget
+    uint64_t _streamedMipBytes { 0 };
+    quint64 _initialLoadTime { 0 };
+
     // This is a copy of the original KTX descriptor from the source url.
     // We need this because the KTX that will be cached will likely include extra data
     // in its key/value data, and so will not match up with the original, causing
@@ -206,6 +222,19 @@ public:
     void setGPUContext(const gpu::ContextPointer& context) { _gpuContext = context; }
     gpu::ContextPointer getGPUContext() const { return _gpuContext; }
 
+    static const uint64_t DEFAULT_MIP_STREAMING_BUDGET;
+
+    /// Textures stop streaming higher resolution mips while more than this many bytes of mips have been streamed
+    void setMipStreamingBudget(uint64_t budget);
+    uint64_t getMipStreamingBudget() const { return _mipStreamingBudget; }
+    uint64_t getStreamedMipBytes() const { return _streamedMipBytes; }
+
+    /// Returns the number of textures that reached their full resolution, and the average time it took them
+    /// from their initial load
+    uint64_t getNumSharpenedTextures() const { return _numSharpenedTextures; }
+    float getAverageSharpeningLatency() const;
+    int getNumTexturesWaitingForBudget();
+
 signals:
     void spectatorCameraFramebufferReset();
 
@@ -231,6 +260,21 @@ private:
 
     gpu::ContextPointer _gpuContext { nullptr };
 
+    bool reserveMipBytes(const QWeakPointer<Resource>& texture);
+    void addStreamedMipBytes(uint64_t bytes) { _streamedMipBytes += bytes; }
+    void releaseStreamedMipBytes(uint64_t bytes);
+    void resumeTexturesWaitingForBudget();
+    void recordSharpened(quint64 latency);
+
+    std::atomic<uint64_t> _mipStreamingBudget { DEFAULT_MIP_STREAMING_BUDGET };
+    std::atomic<uint64_t> _streamedMipBytes { 0 };
+    std::atomic<uint64_t> _numSharpenedTextures { 0 };
+    std::atomic<uint64_t> _totalSharpeningLatency { 0 };
+
+    // Textures that stopped streaming mips because the budget was used up
+    std::vector<QWeakPointer<Resource>> _texturesWaitingForBudget;
+    std::mutex _texturesWaitingForBudgetMutex;
+
     std::shared_ptr<cache::FileCache> _ktxCache { std::make_shared<KTXCache>(KTX_DIRNAME, KTX_EXT) };
 
     // Map from image hashes to texture weak pointers
@@ -21,3 +21,28 @@ TextureCacheScriptingInterface::TextureCacheScriptingInterface() :
 ScriptableResource* TextureCacheScriptingInterface::prefetch(const QUrl& url, int type, int maxNumPixels) {
     return DependencyManager::get<TextureCache>()->prefetch(url, type, maxNumPixels);
 }
+
+/*@jsdoc
+ * Statistics on the streaming of higher resolution texture mips.
+ * @typedef {object} TextureCache.MipStreamingStats
+ * @property {number} streamedBytes - The number of bytes of mips streamed by the textures currently in use.
+ * @property {number} budget - The number of bytes that may be streamed before textures stop sharpening.
+ * @property {number} numWaitingForBudget - The number of textures waiting for the budget to free up.
+ * @property {number} numSharpened - The number of textures that reached their full resolution.
+ * @property {number} averageSharpeningLatency - The average time, in milliseconds, textures took to reach their full
+ *     resolution after their initial low resolution load.
+ */
+QVariantMap TextureCacheScriptingInterface::getMipStreamingStats() {
+    auto textureCache = DependencyManager::get<TextureCache>();
+    QVariantMap stats;
+    stats["streamedBytes"] = (quint64)textureCache->getStreamedMipBytes();
+    stats["budget"] = (quint64)textureCache->getMipStreamingBudget();
+    stats["numWaitingForBudget"] = textureCache->getNumTexturesWaitingForBudget();
+    stats["numSharpened"] = (quint64)textureCache->getNumSharpenedTextures();
+    stats["averageSharpeningLatency"] = textureCache->getAverageSharpeningLatency();
+    return stats;
+}
+
+void TextureCacheScriptingInterface::setMipStreamingBudget(quint64 budget) {
+    DependencyManager::get<TextureCache>()->setMipStreamingBudget(budget);
+}
@@ -63,6 +63,20 @@ public:
      */
     Q_INVOKABLE ScriptableResource* prefetch(const QUrl& url, int type, int maxNumPixels = ABSOLUTE_MAX_TEXTURE_NUM_PIXELS);
 
+    /*@jsdoc
+     * Gets statistics on the streaming of higher resolution texture mips.
+     * @function TextureCache.getMipStreamingStats
+     * @returns {TextureCache.MipStreamingStats} Statistics on the streaming of texture mips.
+     */
+    Q_INVOKABLE QVariantMap getMipStreamingStats();
+
+    /*@jsdoc
+     * Sets how many bytes of higher resolution mips may be streamed before textures stop sharpening.
+     * @function TextureCache.setMipStreamingBudget
+     * @param {number} budget - The budget, in bytes.
+     */
+    Q_INVOKABLE void setMipStreamingBudget(quint64 budget);
+
 signals:
     /*@jsdoc
      * @function TextureCache.spectatorCameraFramebufferReset
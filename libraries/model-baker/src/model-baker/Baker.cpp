@@ -124,49 +124,27 @@ namespace baker {
         }
     };
 
-    class BakerEngineBuilder {
+    class BuildMeshDataTask {
     public:
-        using Input = VaryingSet3<hfm::Model::Pointer, hifi::VariantHash, hifi::URL>;
-        using Output = VaryingSet5<hfm::Model::Pointer, MaterialMapping, std::vector<hifi::ByteArray>, std::vector<bool>, std::vector<std::vector<hifi::ByteArray>>>;
-        using JobModel = Task::ModelIO<BakerEngineBuilder, Input, Output>;
-        void build(JobModel& model, const Varying& input, Varying& output) {
-            const auto& hfmModelIn = input.getN<Input>(0);
-            const auto& mapping = input.getN<Input>(1);
-            const auto& materialMappingBaseURL = input.getN<Input>(2);
+        using Input = VaryingSet3<std::vector<hfm::Mesh>, hifi::URL, baker::MeshIndicesToModelNames>;
+        using Output = VaryingSet6<NormalsPerMesh, TangentsPerMesh, std::vector<graphics::MeshPointer>, std::vector<hifi::ByteArray>, std::vector<bool>, std::vector<std::vector<hifi::ByteArray>>>;
+        using JobModel = Task::ModelIO<BuildMeshDataTask, Input, Output>;
 
-            // Split up the inputs from hfm::Model
-            const auto modelPartsIn = model.addJob<GetModelPartsTask>("GetModelParts", hfmModelIn);
-            const auto meshesIn = modelPartsIn.getN<GetModelPartsTask::Output>(0);
-            const auto url = modelPartsIn.getN<GetModelPartsTask::Output>(1);
-            const auto meshIndicesToModelNames = modelPartsIn.getN<GetModelPartsTask::Output>(2);
-            const auto blendshapesPerMeshIn = modelPartsIn.getN<GetModelPartsTask::Output>(3);
-            const auto jointsIn = modelPartsIn.getN<GetModelPartsTask::Output>(4);
+        void build(JobModel& model, const Varying& input, Varying& output) {
+            const auto meshesIn = input.getN<Input>(0);
+            const auto url = input.getN<Input>(1);
+            const auto meshIndicesToModelNames = input.getN<Input>(2);
 
-            // Calculate normals and tangents for meshes and blendshapes if they do not exist
+            // Calculate normals and tangents for meshes if they do not exist
             // Note: Normals are never calculated here for OBJ models. OBJ files optionally define normals on a per-face basis, so for consistency normals are calculated beforehand in OBJSerializer.
             const auto normalsPerMesh = model.addJob<CalculateMeshNormalsTask>("CalculateMeshNormals", meshesIn);
             const auto calculateMeshTangentsInputs = CalculateMeshTangentsTask::Input(normalsPerMesh, meshesIn).asVarying();
             const auto tangentsPerMesh = model.addJob<CalculateMeshTangentsTask>("CalculateMeshTangents", calculateMeshTangentsInputs);
-            const auto calculateBlendshapeNormalsInputs = CalculateBlendshapeNormalsTask::Input(blendshapesPerMeshIn, meshesIn).asVarying();
-            const auto normalsPerBlendshapePerMesh = model.addJob<CalculateBlendshapeNormalsTask>("CalculateBlendshapeNormals", calculateBlendshapeNormalsInputs);
-            const auto calculateBlendshapeTangentsInputs = CalculateBlendshapeTangentsTask::Input(normalsPerBlendshapePerMesh, blendshapesPerMeshIn, meshesIn).asVarying();
-            const auto tangentsPerBlendshapePerMesh = model.addJob<CalculateBlendshapeTangentsTask>("CalculateBlendshapeTangents", calculateBlendshapeTangentsInputs);
 
             // Build the graphics::MeshPointer for each hfm::Mesh
             const auto buildGraphicsMeshInputs = BuildGraphicsMeshTask::Input(meshesIn, url, meshIndicesToModelNames, normalsPerMesh, tangentsPerMesh).asVarying();
             const auto graphicsMeshes = model.addJob<BuildGraphicsMeshTask>("BuildGraphicsMesh", buildGraphicsMeshInputs);
 
-            // Prepare joint information
-            const auto prepareJointsInputs = PrepareJointsTask::Input(jointsIn, mapping).asVarying();
-            const auto jointInfoOut = model.addJob<PrepareJointsTask>("PrepareJoints", prepareJointsInputs);
-            const auto jointsOut = jointInfoOut.getN<PrepareJointsTask::Output>(0);
-            const auto jointRotationOffsets = jointInfoOut.getN<PrepareJointsTask::Output>(1);
-            const auto jointIndices = jointInfoOut.getN<PrepareJointsTask::Output>(2);
-
-            // Parse material mapping
-            const auto parseMaterialMappingInputs = ParseMaterialMappingTask::Input(mapping, materialMappingBaseURL).asVarying();
-            const auto materialMapping = model.addJob<ParseMaterialMappingTask>("ParseMaterialMapping", parseMaterialMappingInputs);
-
             // Build Draco meshes
             // NOTE: This task is disabled by default and must be enabled through configuration
             // TODO: Tangent support (Needs changes to FBXSerializer_Mesh as well)
@@ -178,9 +156,104 @@ namespace baker {
             const auto dracoErrors = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(1);
             const auto materialList = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(2);
 
+            output = Output(normalsPerMesh, tangentsPerMesh, graphicsMeshes, dracoMeshes, dracoErrors, materialList);
+        }
+    };
+
+    class BuildBlendshapeDataTask {
+    public:
+        using Input = VaryingSet2<BlendshapesPerMesh, std::vector<hfm::Mesh>>;
+        using Output = VaryingSet2<std::vector<NormalsPerBlendshape>, std::vector<TangentsPerBlendshape>>;
+        using JobModel = Task::ModelIO<BuildBlendshapeDataTask, Input, Output>;
+
+        void build(JobModel& model, const Varying& input, Varying& output) {
+            const auto blendshapesPerMeshIn = input.getN<Input>(0);
+            const auto meshesIn = input.getN<Input>(1);
+
+            // Calculate normals and tangents for blendshapes if they do not exist
+            const auto calculateBlendshapeNormalsInputs = CalculateBlendshapeNormalsTask::Input(blendshapesPerMeshIn, meshesIn).asVarying();
+            const auto normalsPerBlendshapePerMesh = model.addJob<CalculateBlendshapeNormalsTask>("CalculateBlendshapeNormals", calculateBlendshapeNormalsInputs);
+            const auto calculateBlendshapeTangentsInputs = CalculateBlendshapeTangentsTask::Input(normalsPerBlendshapePerMesh, blendshapesPerMeshIn, meshesIn).asVarying();
+            const auto tangentsPerBlendshapePerMesh = model.addJob<CalculateBlendshapeTangentsTask>("CalculateBlendshapeTangents", calculateBlendshapeTangentsInputs);
+
+            output = Output(normalsPerBlendshapePerMesh, tangentsPerBlendshapePerMesh);
+        }
+    };
+
+    // The branches only read the parts of the model, so they run concurrently
+    class BuildModelPartsTask {
+    public:
+        using Input = VaryingSet6<std::vector<hfm::Mesh>, hifi::URL, baker::MeshIndicesToModelNames, BlendshapesPerMesh, std::vector<hfm::Joint>, hifi::VariantHash>;
+        using Output = VaryingSet4<BuildMeshDataTask::Output, BuildBlendshapeDataTask::Output, PrepareJointsTask::Output, FlowData>;
+        using JobModel = Parallel::ModelIO<BuildModelPartsTask, Input, Output>;
+
+        void build(JobModel& model, const Varying& input, Varying& output) {
+            const auto meshesIn = input.getN<Input>(0);
+            const auto url = input.getN<Input>(1);
+            const auto meshIndicesToModelNames = input.getN<Input>(2);
+            const auto blendshapesPerMeshIn = input.getN<Input>(3);
+            const auto jointsIn = input.getN<Input>(4);
+            const auto mapping = input.getN<Input>(5);
+
+            const auto buildMeshDataInputs = BuildMeshDataTask::Input(meshesIn, url, meshIndicesToModelNames).asVarying();
+            const auto meshData = model.addJob<BuildMeshDataTask>("BuildMeshData", buildMeshDataInputs);
+
+            const auto buildBlendshapeDataInputs = BuildBlendshapeDataTask::Input(blendshapesPerMeshIn, meshesIn).asVarying();
+            const auto blendshapeData = model.addJob<BuildBlendshapeDataTask>("BuildBlendshapeData", buildBlendshapeDataInputs);
+
+            // Prepare joint information
+            const auto prepareJointsInputs = PrepareJointsTask::Input(jointsIn, mapping).asVarying();
+            const auto jointInfoOut = model.addJob<PrepareJointsTask>("PrepareJoints", prepareJointsInputs);
+
             // Parse flow data
             const auto flowData = model.addJob<ParseFlowDataTask>("ParseFlowData", mapping);
 
+            output = Output(meshData, blendshapeData, jointInfoOut, flowData);
+        }
+    };
+
+    class BakerEngineBuilder {
+    public:
+        using Input = VaryingSet3<hfm::Model::Pointer, hifi::VariantHash, hifi::URL>;
+        using Output = VaryingSet5<hfm::Model::Pointer, MaterialMapping, std::vector<hifi::ByteArray>, std::vector<bool>, std::vector<std::vector<hifi::ByteArray>>>;
+        using JobModel = Task::ModelIO<BakerEngineBuilder, Input, Output>;
+        void build(JobModel& model, const Varying& input, Varying& output) {
+            const auto& hfmModelIn = input.getN<Input>(0);
+            const auto& mapping = input.getN<Input>(1);
+            const auto& materialMappingBaseURL = input.getN<Input>(2);
+
+            // Split up the inputs from hfm::Model
+            const auto modelPartsIn = model.addJob<GetModelPartsTask>("GetModelParts", hfmModelIn);
+            const auto meshesIn = modelPartsIn.getN<GetModelPartsTask::Output>(0);
+            const auto url = modelPartsIn.getN<GetModelPartsTask::Output>(1);
+            const auto meshIndicesToModelNames = modelPartsIn.getN<GetModelPartsTask::Output>(2);
+            const auto blendshapesPerMeshIn = modelPartsIn.getN<GetModelPartsTask::Output>(3);
+            const auto jointsIn = modelPartsIn.getN<GetModelPartsTask::Output>(4);
+
+            // Parse material mapping
+            // This requests materials from the MaterialCache, so it stays out of the worker threads
+            const auto parseMaterialMappingInputs = ParseMaterialMappingTask::Input(mapping, materialMappingBaseURL).asVarying();
+            const auto materialMapping = model.addJob<ParseMaterialMappingTask>("ParseMaterialMapping", parseMaterialMappingInputs);
+
+            // Work on the meshes, the blendshapes and the joints independently
+            const auto buildModelPartsInputs = BuildModelPartsTask::Input(meshesIn, url, meshIndicesToModelNames, blendshapesPerMeshIn, jointsIn, mapping).asVarying();
+            const auto modelPartsOut = model.addJob<BuildModelPartsTask>("BuildModelParts", buildModelPartsInputs);
+            const auto meshDataOut = modelPartsOut.getN<BuildModelPartsTask::Output>(0);
+            const auto normalsPerMesh = meshDataOut.getN<BuildMeshDataTask::Output>(0);
+            const auto tangentsPerMesh = meshDataOut.getN<BuildMeshDataTask::Output>(1);
+            const auto graphicsMeshes = meshDataOut.getN<BuildMeshDataTask::Output>(2);
+            const auto dracoMeshes = meshDataOut.getN<BuildMeshDataTask::Output>(3);
+            const auto dracoErrors = meshDataOut.getN<BuildMeshDataTask::Output>(4);
+            const auto materialList = meshDataOut.getN<BuildMeshDataTask::Output>(5);
+            const auto blendshapeDataOut = modelPartsOut.getN<BuildModelPartsTask::Output>(1);
+            const auto normalsPerBlendshapePerMesh = blendshapeDataOut.getN<BuildBlendshapeDataTask::Output>(0);
+            const auto tangentsPerBlendshapePerMesh = blendshapeDataOut.getN<BuildBlendshapeDataTask::Output>(1);
+            const auto jointInfoOut = modelPartsOut.getN<BuildModelPartsTask::Output>(2);
+            const auto jointsOut = jointInfoOut.getN<PrepareJointsTask::Output>(0);
+            const auto jointRotationOffsets = jointInfoOut.getN<PrepareJointsTask::Output>(1);
+            const auto jointIndices = jointInfoOut.getN<PrepareJointsTask::Output>(2);
+            const auto flowData = modelPartsOut.getN<BuildModelPartsTask::Output>(3);
+
             // Combine the outputs into a new hfm::Model
             const auto buildBlendshapesInputs = BuildBlendshapesTask::Input(blendshapesPerMeshIn, normalsPerBlendshapePerMesh, tangentsPerBlendshapePerMesh).asVarying();
             const auto blendshapesPerMeshOut = model.addJob<BuildBlendshapesTask>("BuildBlendshapes", buildBlendshapesInputs);
@@ -12,6 +12,8 @@
 #include "BuildGraphicsMeshTask.h"
 
 #include <glm/gtc/packing.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 #include <LogHandler.h>
 #include "ModelBakerLogging.h"
@@ -396,20 +398,23 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
 
     auto& graphicsMeshes = output;
 
-    int n = (int)meshes.size();
-    for (int i = 0; i < n; i++) {
-        graphicsMeshes.emplace_back();
-        auto& graphicsMesh = graphicsMeshes[i];
-        
-        // Try to create the graphics::Mesh
-        buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i));
-
-        // Choose a name for the mesh
-        if (graphicsMesh) {
-            graphicsMesh->displayName = url.toString().toStdString() + "#/mesh/" + std::to_string(i);
-            if (meshIndicesToModelNames.find(i) != meshIndicesToModelNames.cend()) {
-                graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
+    const std::string urlString = url.toString().toStdString();
+    graphicsMeshes.resize(meshes.size());
+    tbb::parallel_for(tbb::blocked_range<int>(0, (int)meshes.size()), [&](const tbb::blocked_range<int>& range) {
+        for (int i = range.begin(); i != range.end(); i++) {
+            auto& graphicsMesh = graphicsMeshes[i];
+
+            // Try to create the graphics::Mesh
+            buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i));
+
+            // Choose a name for the mesh
+            if (graphicsMesh) {
+                graphicsMesh->displayName = urlString + "#/mesh/" + std::to_string(i);
+                auto modelName = meshIndicesToModelNames.find(i);
+                if (modelName != meshIndicesToModelNames.cend()) {
+                    graphicsMesh->modelName = modelName.value().toStdString();
+                }
             }
         }
-    }
+    });
 }
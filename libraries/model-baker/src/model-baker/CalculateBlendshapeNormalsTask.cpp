@@ -11,6 +11,9 @@
 
 #include "CalculateBlendshapeNormalsTask.h"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include "ModelMath.h"
 
 void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -18,21 +21,26 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
     const auto& meshes = input.get1();
     auto& normalsPerBlendshapePerMeshOut = output;
 
-    normalsPerBlendshapePerMeshOut.reserve(blendshapesPerMesh.size());
-    for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
+    // Blendshapes are independent of each other, so the (usually few) meshes and their (often many) blendshapes
+    // are both spread over the worker threads
+    normalsPerBlendshapePerMeshOut.resize(blendshapesPerMesh.size());
+    tbb::parallel_for((size_t)0, blendshapesPerMesh.size(), [&](size_t i) {
         const auto& mesh = meshes[i];
         const auto& blendshapes = blendshapesPerMesh[i];
-        normalsPerBlendshapePerMeshOut.emplace_back();
-        auto& normalsPerBlendshapeOut = normalsPerBlendshapePerMeshOut[normalsPerBlendshapePerMeshOut.size()-1];
+        auto& normalsPerBlendshapeOut = normalsPerBlendshapePerMeshOut[i];
+
+        normalsPerBlendshapeOut.resize(blendshapes.size());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, blendshapes.size()), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t j = range.begin(); j != range.end(); j++) {
+                const auto& blendshape = blendshapes[j];
+                const auto& normalsIn = blendshape.normals;
+                auto& normals = normalsPerBlendshapeOut[j];
+                // Check if normals are already defined. Otherwise, calculate them from existing blendshape vertices.
+                if (!normalsIn.empty()) {
+                    normals = std::vector<glm::vec3>(normalsIn.begin(), normalsIn.end());
+                    continue;
+                }
 
-        normalsPerBlendshapeOut.reserve(blendshapes.size());
-        for (size_t j = 0; j < blendshapes.size(); j++) {
-            const auto& blendshape = blendshapes[j];
-            const auto& normalsIn = blendshape.normals;
-            // Check if normals are already defined. Otherwise, calculate them from existing blendshape vertices.
-            if (!normalsIn.empty()) {
-                normalsPerBlendshapeOut.push_back(std::vector<glm::vec3>(normalsIn.begin(), normalsIn.end()));
-            } else {
                 // Create lookup to get index in blendshape from vertex index in mesh
                 std::vector<int> reverseIndices;
                 reverseIndices.resize(mesh.vertices.size());
@@ -42,8 +50,6 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
                     reverseIndices[indexInMesh] = indexInBlendShape;
                 }
 
-                normalsPerBlendshapeOut.emplace_back();
-                auto& normals = normalsPerBlendshapeOut[normalsPerBlendshapeOut.size()-1];
                 normals.resize(mesh.vertices.size());
                 baker::calculateNormals(mesh,
                     [&reverseIndices, &blendshape, &normals](int normalIndex) /* NormalAccessor */ {
@@ -65,6 +71,6 @@ void CalculateBlendshapeNormalsTask::run(const baker::BakeContextPointer& contex
                         }
                     });
             }
-        }
-    }
+        });
+    });
 }
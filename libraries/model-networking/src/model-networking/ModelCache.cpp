@@ -479,6 +479,7 @@ void Geometry::setTextures(const QVariantMap& textureMap) {
                 _areTexturesLoaded = false;
             }
         }
+        applyTextureLoadPriorityOperator();
 
         // If we only use cached textures, they should all be loaded
         areTexturesLoaded();
@@ -487,6 +488,39 @@ void Geometry::setTextures(const QVariantMap& textureMap) {
     }
 }
 
+void Geometry::setTextureLoadPriorityOperator(const QPointer<QObject>& owner, std::function<float()> priorityOperator) {
+    _textureLoadPriorityOwner = owner;
+    _textureLoadPriorityOperator = priorityOperator;
+    applyTextureLoadPriorityOperator();
+}
+
+void Geometry::applyTextureLoadPriorityOperator() {
+    if (_textureLoadPriorityOwner.isNull() || !_textureLoadPriorityOperator) {
+        return;
+    }
+
+    auto applyToMaterial = [&](const std::shared_ptr<NetworkMaterial>& material) {
+        for (auto& texture : material->_textures) {
+            if (texture.second.texture) {
+                texture.second.texture->setMipPriorityOperator(_textureLoadPriorityOwner, _textureLoadPriorityOperator);
+            }
+        }
+    };
+
+    for (auto& material : _materials) {
+        applyToMaterial(material);
+    }
+    for (auto& materialMapping : _materialMapping) {
+        if (materialMapping.second) {
+            for (auto& materialPair : materialMapping.second->parsedMaterials.networkMaterials) {
+                if (materialPair.second) {
+                    applyToMaterial(materialPair.second);
+                }
+            }
+        }
+    }
+}
+
 bool Geometry::areTexturesLoaded() const {
     if (!_areTexturesLoaded) {
         for (auto& material : _materials) {
@@ -12,6 +12,7 @@
 #ifndef hifi_ModelCache_h
 #define hifi_ModelCache_h
 
+#include <QtCore/QPointer>
 #include <QtCore/QSharedPointer>
 
 #include <DependencyManager.h>
@@ -57,6 +58,10 @@ public:
     void setTextures(const QVariantMap& textureMap);
 
     virtual bool areTexturesLoaded() const;
+
+    /// Orders the streaming of higher resolution mips of all textures, including ones set later with setTextures
+    void setTextureLoadPriorityOperator(const QPointer<QObject>& owner, std::function<float()> priorityOperator);
+
     const QUrl& getAnimGraphOverrideUrl() const { return _animGraphOverrideUrl; }
     bool shouldWaitForWearables() const { return _waitForWearables; }
     const QVariantHash& getMapping() const { return _mapping; }
@@ -76,7 +81,12 @@ protected:
     bool _waitForWearables { false };
 
 private:
+    void applyTextureLoadPriorityOperator();
+
     mutable bool _areTexturesLoaded { false };
+
+    QPointer<QObject> _textureLoadPriorityOwner;
+    std::function<float()> _textureLoadPriorityOperator;
 };
 
 /// A geometry loaded from the network.
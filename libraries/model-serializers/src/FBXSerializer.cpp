@@ -12,9 +12,11 @@
 
 #include "FBXSerializer.h"
 
-#include <QBuffer>
 #include <QRegularExpression>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/transform.hpp>
@@ -211,6 +213,123 @@ public:
     glm::mat4 transformLink;
 };
 
+// What the skin weights of a mesh need from the joints, captured in mesh order so that the weights can be computed in
+// parallel afterwards with the bind pose each mesh would have seen.
+class MeshSkinning {
+public:
+    QString meshID;
+    ExtractedMesh* extracted { nullptr };
+    QVector<QString> clusterIDs;
+    std::vector<glm::mat4> meshToJoints; // one per cluster
+    glm::mat4 geometricOffset;
+    bool hasGeometricOffset { false };
+
+    // the joint-frame vertices of each cluster, appended to the shape of its joint in order
+    std::vector<ShapeVertices> clusterPoints;
+};
+
+void computeSkinning(MeshSkinning& skinning, const QHash<QString, Cluster>& clusters) {
+    ExtractedMesh& extracted = *skinning.extracted;
+    skinning.clusterPoints.resize(extracted.mesh.clusters.size());
+
+    // whether we're skinned depends on how many clusters are attached
+    if (skinning.clusterIDs.size() > 1) {
+        // this is a multi-mesh joint
+        const int WEIGHTS_PER_VERTEX = 4;
+        int numClusterIndices = extracted.mesh.vertices.size() * WEIGHTS_PER_VERTEX;
+        extracted.mesh.clusterIndices.fill(extracted.mesh.clusters.size() - 1, numClusterIndices);
+        QVector<float> weightAccumulators;
+        weightAccumulators.fill(0.0f, numClusterIndices);
+
+        for (int i = 0; i < skinning.clusterIDs.size(); i++) {
+            const Cluster cluster = clusters.value(skinning.clusterIDs.at(i));
+            const glm::mat4& meshToJoint = skinning.meshToJoints[i];
+            ShapeVertices& points = skinning.clusterPoints[i];
+
+            for (int j = 0; j < cluster.indices.size(); j++) {
+                int oldIndex = cluster.indices.at(j);
+                float weight = cluster.weights.at(j);
+                for (QMultiHash<int, int>::const_iterator it = extracted.newIndices.constFind(oldIndex);
+                        it != extracted.newIndices.constEnd() && it.key() == oldIndex; it++) {
+                    int newIndex = it.value();
+
+                    // remember vertices with at least 1/4 weight
+                    // FIXME: vertices with no weightpainting won't get recorded here
+                    const float EXPANSION_WEIGHT_THRESHOLD = 0.25f;
+                    if (weight >= EXPANSION_WEIGHT_THRESHOLD) {
+                        // transform to joint-frame and save for later
+                        const glm::mat4 vertexTransform = meshToJoint * glm::translate(extracted.mesh.vertices.at(newIndex));
+                        points.push_back(extractTranslation(vertexTransform));
+                    }
+
+                    // look for an unused slot in the weights vector
+                    int weightIndex = newIndex * WEIGHTS_PER_VERTEX;
+                    int lowestIndex = -1;
+                    float lowestWeight = FLT_MAX;
+                    int k = 0;
+                    for (; k < WEIGHTS_PER_VERTEX; k++) {
+                        if (weightAccumulators[weightIndex + k] == 0.0f) {
+                            extracted.mesh.clusterIndices[weightIndex + k] = i;
+                            weightAccumulators[weightIndex + k] = weight;
+                            break;
+                        }
+                        if (weightAccumulators[weightIndex + k] < lowestWeight) {
+                            lowestIndex = k;
+                            lowestWeight = weightAccumulators[weightIndex + k];
+                        }
+                    }
+                    if (k == WEIGHTS_PER_VERTEX && weight > lowestWeight) {
+                        // no space for an additional weight; we must replace the lowest
+                        weightAccumulators[weightIndex + lowestIndex] = weight;
+                        extracted.mesh.clusterIndices[weightIndex + lowestIndex] = i;
+                    }
+                }
+            }
+        }
+
+        // now that we've accumulated the most relevant weights for each vertex
+        // normalize and compress to 16-bits
+        extracted.mesh.clusterWeights.fill(0, numClusterIndices);
+        int numVertices = extracted.mesh.vertices.size();
+        for (int i = 0; i < numVertices; ++i) {
+            int j = i * WEIGHTS_PER_VERTEX;
+
+            // normalize weights into uint16_t
+            float totalWeight = 0.0f;
+            for (int k = j; k < j + WEIGHTS_PER_VERTEX; ++k) {
+                totalWeight += weightAccumulators[k];
+            }
+
+            const float ALMOST_HALF = 0.499f;
+            if (totalWeight > 0.0f) {
+                float weightScalingFactor = (float)(UINT16_MAX) / totalWeight;
+                for (int k = j; k < j + WEIGHTS_PER_VERTEX; ++k) {
+                    extracted.mesh.clusterWeights[k] = (uint16_t)(weightScalingFactor * weightAccumulators[k] + ALMOST_HALF);
+                }
+            } else {
+                extracted.mesh.clusterWeights[j] = (uint16_t)((float)(UINT16_MAX) + ALMOST_HALF);
+            }
+        }
+    } else {
+        // this is a single-joint mesh
+        // transform cluster vertices to joint-frame and save for later
+        const glm::mat4& meshToJoint = skinning.meshToJoints[0];
+        ShapeVertices& points = skinning.clusterPoints[0];
+        points.reserve(extracted.mesh.vertices.size());
+        foreach (const glm::vec3& vertex, extracted.mesh.vertices) {
+            const glm::mat4 vertexTransform = meshToJoint * glm::translate(vertex);
+            points.push_back(extractTranslation(vertexTransform));
+        }
+
+        // Apply geometric offset, if present, by transforming the vertices directly
+        if (skinning.hasGeometricOffset) {
+            for (int i = 0; i < extracted.mesh.vertices.size(); i++) {
+                extracted.mesh.vertices[i] = transformPoint(skinning.geometricOffset, extracted.mesh.vertices[i]);
+            }
+        }
+    }
+}
+
 void appendModelIDs(const QString& parentID, const QMultiMap<QString, QString>& connectionChildMap,
         QHash<QString, FBXModel>& fbxModels, QSet<QString>& remainingModels, QVector<QString>& modelIDs, bool isRootNode = false) {
     if (remainingModels.contains(parentID)) {
@@ -453,6 +572,12 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
     glm::vec3 ambientColor;
     QString hifiGlobalNodeID;
     unsigned int meshIndex = 0;
+    struct MeshToExtract {
+        QString id;
+        const FBXNode* object;
+        unsigned int meshIndex;
+    };
+    std::vector<MeshToExtract> meshesToExtract;
     haveReportedUnhandledRotationOrder = false;
     int fbxVersionNumber = -1;
     bool isBlenderVersionLower280 = false;
@@ -534,7 +659,8 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
             foreach (const FBXNode& object, child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex, deduplicateIndices));
+                        // extracted in parallel once all the objects are read, with the index they would have had in order
+                        meshesToExtract.push_back({ getID(object.properties), &object, meshIndex++ });
                     } else { // object.properties.at(2) == "Shape"
                         ExtractedBlendshape extracted = { getID(object.properties), extractBlendshape(object) };
                         blendshapes.append(extracted);
@@ -1238,6 +1364,18 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
 #endif
     }
 
+    // the geometry of each mesh only depends on its own node
+    std::vector<ExtractedMesh> extractedMeshes(meshesToExtract.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, meshesToExtract.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            unsigned int index = meshesToExtract[i].meshIndex;
+            extractedMeshes[i] = extractMesh(*meshesToExtract[i].object, index, deduplicateIndices);
+        }
+    });
+    for (size_t i = 0; i < meshesToExtract.size(); ++i) {
+        meshes.insert(meshesToExtract[i].id, std::move(extractedMeshes[i]));
+    }
+
     // TODO: check if is code is needed
     if (!lights.empty()) {
         if (hifiGlobalNodeID.isEmpty()) {
@@ -1438,6 +1576,8 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
     // see if any materials have texture children
     bool materialsHaveTextures = checkMaterialsHaveTextures(_hfmMaterials, _textureFilenames, _connectionChildMap);
 
+    std::vector<MeshSkinning> skinnings;
+    skinnings.reserve(meshes.size());
     for (QMap<QString, ExtractedMesh>::iterator it = meshes.begin(); it != meshes.end(); it++) {
         ExtractedMesh& extracted = it.value();
 
@@ -1551,115 +1691,43 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
             extracted.mesh.clusters.append(cluster);
         }
 
-        // whether we're skinned depends on how many clusters are attached
+        // capture the bind pose as it is now, later meshes may still override it
+        MeshSkinning skinning;
+        skinning.meshID = it.key();
+        skinning.extracted = &extracted;
+        skinning.clusterIDs = clusterIDs;
         if (clusterIDs.size() > 1) {
-            // this is a multi-mesh joint
-            const int WEIGHTS_PER_VERTEX = 4;
-            int numClusterIndices = extracted.mesh.vertices.size() * WEIGHTS_PER_VERTEX;
-            extracted.mesh.clusterIndices.fill(extracted.mesh.clusters.size() - 1, numClusterIndices);
-            QVector<float> weightAccumulators;
-            weightAccumulators.fill(0.0f, numClusterIndices);
-
             for (int i = 0; i < clusterIDs.size(); i++) {
-                QString clusterID = clusterIDs.at(i);
-                const Cluster& cluster = clusters[clusterID];
-                const HFMCluster& hfmCluster = extracted.mesh.clusters.at(i);
-                int jointIndex = hfmCluster.jointIndex;
-                HFMJoint& joint = hfmModel.joints[jointIndex];
-
-                glm::mat4 meshToJoint = glm::inverse(joint.bindTransform) * modelTransform;
-                ShapeVertices& points = hfmModel.shapeVertices.at(jointIndex);
-
-                for (int j = 0; j < cluster.indices.size(); j++) {
-                    int oldIndex = cluster.indices.at(j);
-                    float weight = cluster.weights.at(j);
-                    for (QMultiHash<int, int>::const_iterator it = extracted.newIndices.constFind(oldIndex);
-                            it != extracted.newIndices.end() && it.key() == oldIndex; it++) {
-                        int newIndex = it.value();
-
-                        // remember vertices with at least 1/4 weight
-                        // FIXME: vertices with no weightpainting won't get recorded here
-                        const float EXPANSION_WEIGHT_THRESHOLD = 0.25f;
-                        if (weight >= EXPANSION_WEIGHT_THRESHOLD) {
-                            // transform to joint-frame and save for later
-                            const glm::mat4 vertexTransform = meshToJoint * glm::translate(extracted.mesh.vertices.at(newIndex));
-                            points.push_back(extractTranslation(vertexTransform));
-                        }
-
-                        // look for an unused slot in the weights vector
-                        int weightIndex = newIndex * WEIGHTS_PER_VERTEX;
-                        int lowestIndex = -1;
-                        float lowestWeight = FLT_MAX;
-                        int k = 0;
-                        for (; k < WEIGHTS_PER_VERTEX; k++) {
-                            if (weightAccumulators[weightIndex + k] == 0.0f) {
-                                extracted.mesh.clusterIndices[weightIndex + k] = i;
-                                weightAccumulators[weightIndex + k] = weight;
-                                break;
-                            }
-                            if (weightAccumulators[weightIndex + k] < lowestWeight) {
-                                lowestIndex = k;
-                                lowestWeight = weightAccumulators[weightIndex + k];
-                            }
-                        }
-                        if (k == WEIGHTS_PER_VERTEX && weight > lowestWeight) {
-                            // no space for an additional weight; we must replace the lowest
-                            weightAccumulators[weightIndex + lowestIndex] = weight;
-                            extracted.mesh.clusterIndices[weightIndex + lowestIndex] = i;
-                        }
-                    }
-                }
-            }
-
-            // now that we've accumulated the most relevant weights for each vertex
-            // normalize and compress to 16-bits
-            extracted.mesh.clusterWeights.fill(0, numClusterIndices);
-            int numVertices = extracted.mesh.vertices.size();
-            for (int i = 0; i < numVertices; ++i) {
-                int j = i * WEIGHTS_PER_VERTEX;
-
-                // normalize weights into uint16_t
-                float totalWeight = 0.0f;
-                for (int k = j; k < j + WEIGHTS_PER_VERTEX; ++k) {
-                    totalWeight += weightAccumulators[k];
-                }
-
-                const float ALMOST_HALF = 0.499f;
-                if (totalWeight > 0.0f) {
-                    float weightScalingFactor = (float)(UINT16_MAX) / totalWeight;
-                    for (int k = j; k < j + WEIGHTS_PER_VERTEX; ++k) {
-                        extracted.mesh.clusterWeights[k] = (uint16_t)(weightScalingFactor * weightAccumulators[k] + ALMOST_HALF);
-                    }
-                } else {
-                    extracted.mesh.clusterWeights[j] = (uint16_t)((float)(UINT16_MAX) + ALMOST_HALF);
-                }
+                const HFMJoint& joint = hfmModel.joints[extracted.mesh.clusters.at(i).jointIndex];
+                skinning.meshToJoints.push_back(glm::inverse(joint.bindTransform) * modelTransform);
             }
         } else {
-            // this is a single-joint mesh
-            const HFMCluster& firstHFMCluster = extracted.mesh.clusters.at(0);
-            int jointIndex = firstHFMCluster.jointIndex;
-            HFMJoint& joint = hfmModel.joints[jointIndex];
-
-            // transform cluster vertices to joint-frame and save for later
-            glm::mat4 meshToJoint = glm::inverse(joint.bindTransform) * modelTransform;
-            ShapeVertices& points = hfmModel.shapeVertices.at(jointIndex);
-            foreach (const glm::vec3& vertex, extracted.mesh.vertices) {
-                const glm::mat4 vertexTransform = meshToJoint * glm::translate(vertex);
-                points.push_back(extractTranslation(vertexTransform));
-            }
-
-            // Apply geometric offset, if present, by transforming the vertices directly
+            const HFMJoint& joint = hfmModel.joints[extracted.mesh.clusters.at(0).jointIndex];
+            skinning.meshToJoints.push_back(glm::inverse(joint.bindTransform) * modelTransform);
             if (joint.hasGeometricOffset) {
-                glm::mat4 geometricOffset = createMatFromScaleQuatAndPos(joint.geometricScaling, joint.geometricRotation, joint.geometricTranslation);
-                for (int i = 0; i < extracted.mesh.vertices.size(); i++) {
-                    extracted.mesh.vertices[i] = transformPoint(geometricOffset, extracted.mesh.vertices[i]);
-                }
+                skinning.hasGeometricOffset = true;
+                skinning.geometricOffset = createMatFromScaleQuatAndPos(joint.geometricScaling, joint.geometricRotation, joint.geometricTranslation);
             }
         }
+        skinnings.push_back(std::move(skinning));
+    }
 
+    // the skin weights of each mesh only depend on the mesh itself and on what was captured above
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, skinnings.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            computeSkinning(skinnings[i], clusters);
+        }
+    });
+
+    for (const auto& skinning : skinnings) {
+        const ExtractedMesh& extracted = *skinning.extracted;
+        for (size_t i = 0; i < skinning.clusterPoints.size(); i++) {
+            ShapeVertices& points = hfmModel.shapeVertices.at(extracted.mesh.clusters.at((int)i).jointIndex);
+            points.insert(points.end(), skinning.clusterPoints[i].begin(), skinning.clusterPoints[i].end());
+        }
         hfmModel.meshes.append(extracted.mesh);
         int meshIndex = hfmModel.meshes.size() - 1;
-        meshIDsToMeshIndices.insert(it.key(), meshIndex);
+        meshIDsToMeshIndices.insert(skinning.meshID, meshIndex);
     }
 
     // attempt to map any meshes to a named model
@@ -1701,10 +1769,7 @@ std::unique_ptr<hfm::Serializer::Factory> FBXSerializer::getFactory() const {
 }
 
 HFMModel::Pointer FBXSerializer::read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url) {
-    QBuffer buffer(const_cast<hifi::ByteArray*>(&data));
-    buffer.open(QIODevice::ReadOnly);
-
-    _rootNode = parseFBX(&buffer);
+    _rootNode = parseFBX(data);
 
     // FBXSerializer's mapping parameter supports the bool "deduplicateIndices," which is passed into FBXSerializer::extractMesh as "deduplicate"
 
@@ -115,7 +115,11 @@ public:
     HFMModel::Pointer read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url = hifi::URL()) override;
 
     FBXNode _rootNode;
+    /// Binary files are parsed from a mapping of the file when the device is a QFile, and read whole otherwise
     static FBXNode parseFBX(QIODevice* device);
+    /// Parses binary files in place from the buffer, text files are tokenized as a stream.
+    /// Either way the result is a whole FBXNode tree with QVariant properties, which extractHFMModel then walks.
+    static FBXNode parseFBX(const hifi::ByteArray& data);
 
     HFMModel* extractHFMModel(const hifi::VariantHash& mapping, const QString& url);
 
@@ -11,199 +11,169 @@
 
 #include "FBXSerializer.h"
 
+#include <algorithm>
 #include <iostream>
+
+#include <zlib.h>
+
 #include <QtCore/QBuffer>
-#include <QtCore/QDataStream>
+#include <QtCore/QFile>
 #include <QtCore/QIODevice>
 #include <QtCore/QStringList>
 #include <QtCore/QTextStream>
 #include <QtCore/QDebug>
-#include <QtCore/QtEndian>
 #include <QtCore/QFileInfo>
 
 #include <shared/NsightHelpers.h>
 #include <hfm/ModelFormatLogging.h>
 
-template<class T>
-int streamSize() {
-    return sizeof(T);
-}
+// Reads values straight out of the bytes of a binary FBX file. Every read is bounds checked, so a truncated or corrupt
+// file throws instead of reading past the end of the buffer.
+class FBXBinaryCursor {
+public:
+    FBXBinaryCursor(const hifi::ByteArray& data) : _data(data.constData()), _size(data.size()) { }
 
-template<bool>
-int streamSize() {
-    return 1;
-}
+    qint64 getPosition() const { return _position; }
+    bool atEnd() const { return _position >= _size; }
 
-template<class T>
-QVariant readBinaryArray(QDataStream& in, int& position) {
-    quint32 arrayLength;
-    quint32 encoding;
-    quint32 compressedLength;
+    template<class T>
+    T read() {
+        T value;
+        copyLittleEndian(take(sizeof(T)), &value, 1);
+        return value;
+    }
+
+    const char* take(qint64 length) {
+        if (length < 0 || length > _size - _position) {
+            throw QString("FBX file most likely corrupt: data ends unexpectedly");
+        }
+        const char* data = _data + _position;
+        _position += length;
+        return data;
+    }
+
+    void skip(qint64 length) { take(length); }
+
+    template<class T>
+    static void copyLittleEndian(const char* source, T* destination, qint64 count) {
+        memcpy(destination, source, count * sizeof(T));
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        swapToHostOrder(destination, count);
+#endif
+    }
 
-    in >> arrayLength;
+    template<class T>
+    static void swapToHostOrder(T* values, qint64 count) {
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        for (qint64 i = 0; i < count; i++) {
+            char* bytes = reinterpret_cast<char*>(&values[i]);
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+#else
+        Q_UNUSED(values);
+        Q_UNUSED(count);
+#endif
+    }
+
+private:
+    const char* _data;
+    qint64 _size;
+    qint64 _position { 0 };
+};
+
+template<class T>
+QVariant readBinaryArray(FBXBinaryCursor& cursor) {
+    quint32 arrayLength = cursor.read<quint32>();
     if (arrayLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
         throw QString("FBX file most likely corrupt: binary data exceeds data limits");
     }
-    in >> encoding;
-    in >> compressedLength;
+    quint32 encoding = cursor.read<quint32>();
+    quint32 compressedLength = cursor.read<quint32>();
     if (compressedLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
         throw QString("FBX file most likely corrupt: compressed binary data exceeds data limits");
     }
-    position += sizeof(quint32) * 3;
-
-    QVector<T> values;
-    if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
-        values.resize(arrayLength);
-        hifi::ByteArray arrayData;
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-        } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
-        }
 
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
-        }
-    } else {
-        values.reserve(arrayLength);
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            hifi::ByteArray uncompressed = qUncompress(compressed);
-            if (uncompressed.isEmpty()) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-            QDataStream uncompressedIn(uncompressed);
-            uncompressedIn.setByteOrder(QDataStream::LittleEndian);
-            uncompressedIn.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                uncompressedIn >> value;
-                values.append(value);
-            }
-        } else {
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                in >> value;
-                position += streamSize<T>();
-                values.append(value);
-            }
+    // the values are decoded in place in the vector that ends up in the node, without any intermediate copy
+    QVector<T> values(arrayLength);
+    uLongf arrayBytes = (uLongf)(arrayLength * sizeof(T));
+    if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+        const char* compressed = cursor.take(compressedLength);
+        uLongf inflatedBytes = arrayBytes;
+        if (arrayBytes > 0 && (uncompress(reinterpret_cast<Bytef*>(values.data()), &inflatedBytes,
+                reinterpret_cast<const Bytef*>(compressed), compressedLength) != Z_OK || inflatedBytes != arrayBytes)) {
+            throw QString("corrupt fbx file");
         }
+        FBXBinaryCursor::swapToHostOrder(values.data(), arrayLength);
+    } else if (arrayLength > 0) {
+        FBXBinaryCursor::copyLittleEndian(cursor.take(arrayBytes), values.data(), arrayLength);
     }
     return QVariant::fromValue(values);
 }
 
-QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
-    char ch;
-    in.device()->getChar(&ch);
-    position++;
+QVariant parseBinaryFBXProperty(FBXBinaryCursor& cursor) {
+    char ch = cursor.read<char>();
     switch (ch) {
         case 'Y': {
-            qint16 value;
-            in >> value;
-            position += sizeof(qint16);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(cursor.read<qint16>());
         }
         case 'C': {
-            bool value;
-            in >> value;
-            position++;
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(cursor.read<quint8>() != 0);
         }
         case 'I': {
-            qint32 value;
-            in >> value;
-            position += sizeof(qint32);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(cursor.read<qint32>());
         }
         case 'F': {
-            float value;
-            in >> value;
-            position += sizeof(float);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(cursor.read<float>());
         }
         case 'D': {
-            double value;
-            in >> value;
-            position += sizeof(double);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(cursor.read<double>());
         }
         case 'L': {
-            qint64 value;
-            in >> value;
-            position += sizeof(qint64);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(cursor.read<qint64>());
         }
         case 'f': {
-            return readBinaryArray<float>(in, position);
+            return readBinaryArray<float>(cursor);
         }
         case 'd': {
-            return readBinaryArray<double>(in, position);
+            return readBinaryArray<double>(cursor);
         }
         case 'l': {
-            return readBinaryArray<qint64>(in, position);
+            return readBinaryArray<qint64>(cursor);
         }
         case 'i': {
-            return readBinaryArray<qint32>(in, position);
+            return readBinaryArray<qint32>(cursor);
         }
         case 'b': {
-            return readBinaryArray<bool>(in, position);
+            return readBinaryArray<bool>(cursor);
         }
         case 'S':
         case 'R': {
-            quint32 length;
-            in >> length;
-            position += sizeof(quint32) + length;
-            return QVariant::fromValue(in.device()->read(length));
+            quint32 length = cursor.read<quint32>();
+            return QVariant::fromValue(hifi::ByteArray(cursor.take(length), length));
         }
         default:
             throw QString("Unknown property type: ") + ch;
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
+FBXNode parseBinaryFBXNode(FBXBinaryCursor& cursor, bool has64BitPositions = false) {
     qint64 endOffset;
     quint64 propertyCount;
-    quint64 propertyListLength;
-    quint8 nameLength;
 
     // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
     // our code generally doesn't care about the size that much, so we will use 64bit values
-    // from here on out, but if the file is an older format we read the stream into temp 32bit
-    // values and then assign to our actual 64bit values.
+    // from here on out, but if the file is an older format we read into temp 32bit values
+    // and then assign to our actual 64bit values.
     if (has64BitPositions) {
-        in >> endOffset;
-        in >> propertyCount;
-        in >> propertyListLength;
-        position += sizeof(quint64) * 3;
+        endOffset = cursor.read<qint64>();
+        propertyCount = cursor.read<quint64>();
+        cursor.read<quint64>(); // property list length
     } else {
-        qint32 tempEndOffset;
-        quint32 tempPropertyCount;
-        quint32 tempPropertyListLength;
-        in >> tempEndOffset;
-        in >> tempPropertyCount;
-        in >> tempPropertyListLength;
-        position += sizeof(quint32) * 3;
-        endOffset = tempEndOffset;
-        propertyCount = tempPropertyCount;
-        propertyListLength = tempPropertyListLength;
-    }
-    in >> nameLength;
-    position += sizeof(quint8);
+        endOffset = cursor.read<qint32>();
+        propertyCount = cursor.read<quint32>();
+        cursor.read<quint32>(); // property list length
+    }
+    quint8 nameLength = cursor.read<quint8>();
 
     FBXNode node;
     const int MIN_VALID_OFFSET = 40;
@@ -211,15 +181,14 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
         // use a null name to indicate a null node
         return node;
     }
-    node.name = in.device()->read(nameLength);
-    position += nameLength;
+    node.name = hifi::ByteArray(cursor.take(nameLength), nameLength);
 
-    for (quint32 i = 0; i < propertyCount; i++) {
-        node.properties.append(parseBinaryFBXProperty(in, position));
+    for (quint64 i = 0; i < propertyCount; i++) {
+        node.properties.append(parseBinaryFBXProperty(cursor));
     }
 
-    while (endOffset > position) {
-        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (endOffset > cursor.getPosition()) {
+        FBXNode child = parseBinaryFBXNode(cursor, has64BitPositions);
         if (!child.name.isNull()) {
             node.children.append(child);
         }
@@ -352,26 +321,49 @@ FBXNode parseTextFBXNode(Tokenizer& tokenizer) {
 }
 
 FBXNode FBXSerializer::parseFBX(QIODevice* device) {
+    if (device->peek(FBX_BINARY_PROLOG.size()) == FBX_BINARY_PROLOG) {
+        // the binary parser copies everything it keeps out of the buffer, so files are parsed straight from a mapping
+        QFile* file = qobject_cast<QFile*>(device);
+        qint64 size = file ? file->size() : 0;
+        uchar* mapped = (size > 0 && size <= std::numeric_limits<int>::max()) ? file->map(0, size) : nullptr;
+        if (mapped) {
+            FBXNode top;
+            try {
+                top = parseFBX(hifi::ByteArray::fromRawData(reinterpret_cast<const char*>(mapped), (int)size));
+            } catch (...) {
+                file->unmap(mapped);
+                throw;
+            }
+            file->unmap(mapped);
+            return top;
+        }
+        return parseFBX(device->readAll());
+    }
+
     PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, device);
-    // verify the prolog
-    if (device->peek(FBX_BINARY_PROLOG.size()) != FBX_BINARY_PROLOG) {
-        // parse as a text file
-        FBXNode top;
-        Tokenizer tokenizer(device);
-        while (device->bytesAvailable()) {
-            FBXNode next = parseTextFBXNode(tokenizer);
-            if (next.name.isNull()) {
-                return top;
+    // parse as a text file
+    FBXNode top;
+    Tokenizer tokenizer(device);
+    while (device->bytesAvailable()) {
+        FBXNode next = parseTextFBXNode(tokenizer);
+        if (next.name.isNull()) {
+            return top;
 
-            } else {
-                top.children.append(next);
-            }
+        } else {
+            top.children.append(next);
         }
-        return top;
     }
-    QDataStream in(device);
-    in.setByteOrder(QDataStream::LittleEndian);
-    in.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
+    return top;
+}
+
+FBXNode FBXSerializer::parseFBX(const hifi::ByteArray& data) {
+    // verify the prolog
+    if (!data.startsWith(FBX_BINARY_PROLOG)) {
+        QBuffer buffer(const_cast<hifi::ByteArray*>(&data));
+        buffer.open(QIODevice::ReadOnly);
+        return parseFBX(&buffer);
+    }
+    PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xff0000ff, data.size());
 
     // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
     // of the FBX binary format
@@ -380,17 +372,15 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
     //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
     //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
     //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
-    in.skipRawData(FBX_HEADER_BYTES_BEFORE_VERSION);
-    int position = FBX_HEADER_BYTES_BEFORE_VERSION;
-    quint32 fileVersion;
-    in >> fileVersion;
-    position += sizeof(fileVersion);
+    FBXBinaryCursor cursor(data);
+    cursor.skip(FBX_HEADER_BYTES_BEFORE_VERSION);
+    quint32 fileVersion = cursor.read<quint32>();
     bool has64BitPositions = (fileVersion >= FBX_VERSION_2016);
 
     // parse the top-level node
     FBXNode top;
-    while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (!cursor.atEnd()) {
+        FBXNode next = parseBinaryFBXNode(cursor, has64BitPositions);
         if (next.name.isNull()) {
             return top;
 
@@ -402,7 +392,6 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
     return top;
 }
 
-
 glm::vec3 FBXSerializer::getVec3(const QVariantList& properties, int index) {
     return glm::vec3(properties.at(index).value<double>(), properties.at(index + 1).value<double>(),
         properties.at(index + 2).value<double>());
@@ -410,6 +399,7 @@ glm::vec3 FBXSerializer::getVec3(const QVariantList& properties, int index) {
 
 QVector<glm::vec4> FBXSerializer::createVec4Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec4> values;
+    values.reserve(doubleVector.size() / 4);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -423,6 +413,7 @@ QVector<glm::vec4> FBXSerializer::createVec4Vector(const QVector<double>& double
 
 QVector<glm::vec4> FBXSerializer::createVec4VectorRGBA(const QVector<double>& doubleVector, glm::vec4& average) {
     QVector<glm::vec4> values;
+    values.reserve(doubleVector.size() / 4);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 4) * 4); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -440,6 +431,7 @@ QVector<glm::vec4> FBXSerializer::createVec4VectorRGBA(const QVector<double>& do
 
 QVector<glm::vec3> FBXSerializer::createVec3Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec3> values;
+    values.reserve(doubleVector.size() / 3);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 3) * 3); it != end; ) {
         float x = *it++;
         float y = *it++;
@@ -451,6 +443,7 @@ QVector<glm::vec3> FBXSerializer::createVec3Vector(const QVector<double>& double
 
 QVector<glm::vec2> FBXSerializer::createVec2Vector(const QVector<double>& doubleVector) {
     QVector<glm::vec2> values;
+    values.reserve(doubleVector.size() / 2);
     for (const double* it = doubleVector.constData(), *end = it + ((doubleVector.size() / 2) * 2); it != end; ) {
         float s = *it++;
         float t = *it++;
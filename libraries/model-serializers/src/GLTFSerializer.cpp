@@ -31,9 +31,13 @@
 #include <qfile.h>
 #include <qfileinfo.h>
 
+#include <functional>
 #include <sstream>
+#include <unordered_map>
 
 #include <glm/gtx/transform.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 #include <shared/NsightHelpers.h>
 #include <NetworkAccessManager.h>
@@ -164,13 +168,13 @@ bool findNodeInPointerArray(const cgltf_node *nodePointer, cgltf_node **nodes, s
 }
 
 template<typename T> bool findPointerInArray(const T *pointer, const T *array, size_t arraySize, size_t &index) {
-    for (size_t i = 0; i < arraySize; i++) {
-        if (&array[i] == pointer) {
-            index = i;
-            return true;
-        }
+    // the elements are contiguous, so the index follows from the address
+    std::less<const T*> less;
+    if (less(pointer, array) || !less(pointer, array + arraySize)) {
+        return false;
     }
-    return false;
+    index = (size_t)(pointer - array);
+    return true;
 }
 
 bool findAttribute(const QString &name, const cgltf_attribute *attributes, size_t numAttributes, size_t &index) {
@@ -188,6 +192,353 @@ bool findAttribute(const QString &name, const cgltf_attribute *attributes, size_
     return false;
 }
 
+// The vertex data of one primitive, unpacked from its accessors.
+class GLTFPrimitiveData {
+public:
+    enum Status {
+        Decoded,
+        Skipped, // the primitive is left out of the mesh
+        Failed // the whole model fails to load
+    };
+
+    Status status { Decoded };
+    int errorCount { 0 };
+
+    QVector<int> indices;
+    QVector<float> vertices;
+    QVector<float> normals;
+    QVector<float> tangents;
+    int tangentStride { 4 };
+    QVector<float> texcoords;
+    QVector<float> texcoords2;
+    QVector<float> colors;
+    int colorStride { 3 };
+    QVector<uint16_t> joints;
+    int jointStride { 4 };
+    QVector<float> weights;
+    int weightStride { 4 };
+};
+
+// Only reads the cgltf data, so it is safe to call for several primitives at once.
+void GLTFSerializer::decodePrimitive(const cgltf_primitive& primitive, GLTFPrimitiveData& data) const {
+    if (primitive.indices == nullptr) {
+        qDebug() << "No indices accessor for mesh: " << _url;
+        data.errorCount++;
+        data.status = GLTFPrimitiveData::Failed;
+        return;
+    }
+    auto &indicesAccessor = primitive.indices;
+
+    QVector<int>& indices = data.indices;
+    QVector<float>& vertices = data.vertices;
+    QVector<float>& normals = data.normals;
+    QVector<float>& tangents = data.tangents;
+    int& tangentStride = data.tangentStride;
+    QVector<float>& texcoords = data.texcoords;
+    const int texCoordStride = 2;
+    QVector<float>& texcoords2 = data.texcoords2;
+    const int texCoord2Stride = 2;
+    QVector<float>& colors = data.colors;
+    int& colorStride = data.colorStride;
+    QVector<uint16_t>& joints = data.joints;
+    int& jointStride = data.jointStride;
+    QVector<float>& weights = data.weights;
+    int& weightStride = data.weightStride;
+
+    indices.resize((int)indicesAccessor->count);
+    size_t readIndicesCount = cgltf_accessor_unpack_indices(indicesAccessor, indices.data(), sizeof(unsigned int), indicesAccessor->count);
+
+    if (readIndicesCount != indicesAccessor->count) {
+        qWarning(modelformat) << "There was a problem reading glTF INDICES data for model " << _url;
+        data.errorCount++;
+        data.status = GLTFPrimitiveData::Skipped;
+        return;
+    }
+
+    for (size_t attributeIndex = 0; attributeIndex < primitive.attributes_count; attributeIndex++) {
+        if (primitive.attributes[attributeIndex].name == nullptr) {
+            qDebug() << "Inalid accessor name for mesh: " << _url;
+            data.errorCount++;
+            data.status = GLTFPrimitiveData::Failed;
+            return;
+        }
+        QString key(primitive.attributes[attributeIndex].name);
+
+        if (primitive.attributes[attributeIndex].data == nullptr) {
+            qDebug() << "Inalid accessor for mesh: " << _url;
+            data.errorCount++;
+            data.status = GLTFPrimitiveData::Failed;
+            return;
+        }
+        auto accessor = primitive.attributes[attributeIndex].data;
+        int accessorCount = (int)accessor->count;
+
+        if (key == "POSITION") {
+            if (accessor->type != cgltf_type_vec3) {
+                qWarning(modelformat) << "Invalid accessor type on glTF POSITION data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+
+            vertices.resize(accessorCount * 3);
+            size_t floatCount = cgltf_accessor_unpack_floats(accessor, vertices.data(), accessor->count * 3);
+            if (floatCount != accessor->count * 3) {
+                qWarning(modelformat) << "There was a problem reading glTF POSITION data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+        } else if (key == "NORMAL") {
+            if (accessor->type != cgltf_type_vec3) {
+                qWarning(modelformat) << "Invalid accessor type on glTF NORMAL data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+
+            normals.resize(accessorCount * 3);
+            size_t floatCount = cgltf_accessor_unpack_floats(accessor, normals.data(), accessor->count * 3);
+            if (floatCount != accessor->count * 3) {
+                qWarning(modelformat) << "There was a problem reading glTF NORMAL data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+        } else if (key == "TANGENT") {
+            if (accessor->type == cgltf_type_vec4) {
+                tangentStride = 4;
+            } else if (accessor->type == cgltf_type_vec3) {
+                tangentStride = 3;
+            } else {
+                qWarning(modelformat) << "Invalid accessor type on glTF TANGENT data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+
+            tangents.resize(accessorCount * tangentStride);
+            size_t floatCount = cgltf_accessor_unpack_floats(accessor, tangents.data(), accessor->count * tangentStride);
+            if (floatCount != accessor->count * tangentStride) {
+                qWarning(modelformat) << "There was a problem reading glTF TANGENT data for model " << _url;
+                data.errorCount++;
+                tangentStride = 0;
+                continue;
+            }
+        } else if (key == "TEXCOORD_0") {
+            if (accessor->type != cgltf_type_vec2) {
+                qWarning(modelformat) << "Invalid accessor type on glTF TEXCOORD_0 data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+
+            texcoords.resize(accessorCount * 2);
+            size_t floatCount = cgltf_accessor_unpack_floats(accessor, texcoords.data(), accessor->count * 2);
+            if (floatCount != accessor->count * 2) {
+                qWarning(modelformat) << "There was a problem reading glTF TEXCOORD_0 data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+        } else if (key == "TEXCOORD_1") {
+            if (accessor->type != cgltf_type_vec2) {
+                qWarning(modelformat) << "Invalid accessor type on glTF TEXCOORD_1 data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+
+            texcoords2.resize(accessorCount * 2);
+            size_t floatCount = cgltf_accessor_unpack_floats(accessor, texcoords2.data(), accessor->count * 2);
+            if (floatCount != accessor->count * 2) {
+                qWarning(modelformat) << "There was a problem reading glTF TEXCOORD_1 data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+        } else if (key == "COLOR_0") {
+            if (accessor->type == cgltf_type_vec4) {
+                colorStride = 4;
+            } else if (accessor->type == cgltf_type_vec3) {
+                colorStride = 3;
+            } else {
+                qWarning(modelformat) << "Invalid accessor type on glTF COLOR_0 data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+
+            colors.resize(accessorCount * colorStride);
+            size_t floatCount = cgltf_accessor_unpack_floats(accessor, colors.data(), accessor->count * colorStride);
+            if (floatCount != accessor->count * colorStride) {
+                qWarning(modelformat) << "There was a problem reading glTF COLOR_0 data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+        } else if (key == "JOINTS_0") {
+            if (accessor->type == cgltf_type_vec4) {
+                jointStride = 4;
+            } else if (accessor->type == cgltf_type_vec3) {
+                jointStride = 3;
+            } else if (accessor->type == cgltf_type_vec2) {
+                jointStride = 2;
+            } else if (accessor->type == cgltf_type_scalar) {
+                jointStride = 1;
+            } else {
+                qWarning(modelformat) << "Invalid accessor type on glTF JOINTS_0 data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+
+            joints.resize(accessorCount * jointStride);
+            cgltf_uint jointIndices[4];
+            for (size_t i = 0; i < accessor->count; i++) {
+                cgltf_accessor_read_uint(accessor, i, jointIndices, jointStride);
+                for (int component = 0; component < jointStride; component++) {
+                    joints[(int)i * jointStride + component] = (uint16_t)jointIndices[component];
+                }
+            }
+
+        } else if (key == "WEIGHTS_0") {
+            if (accessor->type == cgltf_type_vec4) {
+                weightStride = 4;
+            } else if (accessor->type == cgltf_type_vec3) {
+                weightStride = 3;
+            } else if (accessor->type == cgltf_type_vec2) {
+                weightStride = 2;
+            } else if (accessor->type == cgltf_type_scalar) {
+                weightStride = 1;
+            } else {
+                qWarning(modelformat) << "Invalid accessor type on glTF WEIGHTS_0 data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+
+            weights.resize(accessorCount * weightStride);
+            size_t floatCount = cgltf_accessor_unpack_floats(accessor, weights.data(), accessor->count * weightStride);
+            if (floatCount != accessor->count * weightStride) {
+                qWarning(modelformat) << "There was a problem reading glTF WEIGHTS_0 data for model " << _url;
+                data.errorCount++;
+                continue;
+            }
+        }
+    }
+
+    // Validation stage
+    if (indices.count() == 0) {
+        qWarning(modelformat) << "Missing indices for model " << _url;
+        data.errorCount++;
+        data.status = GLTFPrimitiveData::Skipped;
+        return;
+    }
+    if (vertices.count() == 0) {
+        qWarning(modelformat) << "Missing vertices for model " << _url;
+        data.errorCount++;
+        data.status = GLTFPrimitiveData::Skipped;
+        return;
+    }
+
+    int partVerticesCount = vertices.size() / 3;
+
+    // generate the normals if they don't exist
+    if (normals.size() == 0) {
+        QVector<int> newIndices;
+        QVector<float> newVertices;
+        QVector<float> newNormals;
+        QVector<float> newTexcoords;
+        QVector<float> newTexcoords2;
+        QVector<float> newColors;
+        QVector<uint16_t> newJoints;
+        QVector<float> newWeights;
+        newIndices.reserve(indices.size());
+        newVertices.reserve(indices.size() * 3);
+        newNormals.reserve(indices.size() * 3);
+
+        for (int n = 0; n + 2 < indices.size(); n = n + 3) {
+            int v1_index = (indices[n + 0] * 3);
+            int v2_index = (indices[n + 1] * 3);
+            int v3_index = (indices[n + 2] * 3);
+
+            if (v1_index + 2 >= vertices.size() || v2_index + 2 >= vertices.size() || v3_index + 2 >= vertices.size()) {
+                qWarning(modelformat) << "Indices out of range for model " << _url;
+                data.errorCount++;
+                data.status = GLTFPrimitiveData::Failed;
+                return;
+            }
+
+            glm::vec3 v1 = glm::vec3(vertices[v1_index], vertices[v1_index + 1], vertices[v1_index + 2]);
+            glm::vec3 v2 = glm::vec3(vertices[v2_index], vertices[v2_index + 1], vertices[v2_index + 2]);
+            glm::vec3 v3 = glm::vec3(vertices[v3_index], vertices[v3_index + 1], vertices[v3_index + 2]);
+
+            newVertices.append(v1.x);
+            newVertices.append(v1.y);
+            newVertices.append(v1.z);
+            newVertices.append(v2.x);
+            newVertices.append(v2.y);
+            newVertices.append(v2.z);
+            newVertices.append(v3.x);
+            newVertices.append(v3.y);
+            newVertices.append(v3.z);
+
+            glm::vec3 norm = glm::normalize(glm::cross(v2 - v1, v3 - v1));
+
+            newNormals.append(norm.x);
+            newNormals.append(norm.y);
+            newNormals.append(norm.z);
+            newNormals.append(norm.x);
+            newNormals.append(norm.y);
+            newNormals.append(norm.z);
+            newNormals.append(norm.x);
+            newNormals.append(norm.y);
+            newNormals.append(norm.z);
+
+            if (texcoords.size() == partVerticesCount * texCoordStride) {
+                GLTF_APPEND_ARRAY_2(newTexcoords, texcoords)
+            }
+
+            if (texcoords2.size() == partVerticesCount * texCoord2Stride) {
+                GLTF_APPEND_ARRAY_2(newTexcoords2, texcoords2)
+            }
+
+            if (colors.size() == partVerticesCount * colorStride) {
+                if (colorStride == 4) {
+                    GLTF_APPEND_ARRAY_4(newColors, colors)
+                } else {
+                    GLTF_APPEND_ARRAY_3(newColors, colors)
+                }
+            }
+
+            if (joints.size() == partVerticesCount * jointStride) {
+                if (jointStride == 4) {
+                    GLTF_APPEND_ARRAY_4(newJoints, joints)
+                } else if (jointStride == 3) {
+                    GLTF_APPEND_ARRAY_3(newJoints, joints)
+                } else if (jointStride == 2) {
+                    GLTF_APPEND_ARRAY_2(newJoints, joints)
+                } else {
+                    GLTF_APPEND_ARRAY_1(newJoints, joints)
+                }
+            }
+
+            if (weights.size() == partVerticesCount * weightStride) {
+                if (weightStride == 4) {
+                    GLTF_APPEND_ARRAY_4(newWeights, weights)
+                } else if (weightStride == 3) {
+                    GLTF_APPEND_ARRAY_3(newWeights, weights)
+                } else if (weightStride == 2) {
+                    GLTF_APPEND_ARRAY_2(newWeights, weights)
+                } else {
+                    GLTF_APPEND_ARRAY_1(newWeights, weights)
+                }
+            }
+            newIndices.append(n);
+            newIndices.append(n + 1);
+            newIndices.append(n + 2);
+        }
+
+        vertices = newVertices;
+        normals = newNormals;
+        tangents = QVector<float>();
+        texcoords = newTexcoords;
+        texcoords2 = newTexcoords2;
+        colors = newColors;
+        joints = newJoints;
+        weights = newWeights;
+        indices = newIndices;
+    }
+}
+
 bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& url) {
     hfmModel.originalURL = url.toString();
 
@@ -390,6 +741,26 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
     }
 
 
+    // Unpack the accessors of every primitive up front, in parallel. Decoding only reads the cgltf data, and nodes
+    // that share a mesh share its decoded primitives.
+    std::vector<const cgltf_primitive*> primitives;
+    std::unordered_map<const cgltf_mesh*, size_t> firstDecodedPrimitives;
+    for (int nodeIndex : sortedNodes) {
+        const cgltf_mesh* nodeMesh = _data->nodes[nodeIndex].mesh;
+        if (nodeMesh != nullptr && firstDecodedPrimitives.find(nodeMesh) == firstDecodedPrimitives.end()) {
+            firstDecodedPrimitives[nodeMesh] = primitives.size();
+            for (size_t primitiveIndex = 0; primitiveIndex < nodeMesh->primitives_count; primitiveIndex++) {
+                primitives.push_back(&nodeMesh->primitives[primitiveIndex]);
+            }
+        }
+    }
+    std::vector<GLTFPrimitiveData> decodedPrimitives(primitives.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, primitives.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            decodePrimitive(*primitives[i], decodedPrimitives[i]);
+        }
+    });
+
     // Build meshes
     int nodeCount = 0;
     hfmModel.meshExtents.reset();
@@ -435,45 +806,37 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                 }
             }
 
+            size_t firstDecodedPrimitive = firstDecodedPrimitives[node.mesh];
             for (size_t primitiveIndex = 0; primitiveIndex < node.mesh->primitives_count; primitiveIndex++) {
                 auto &primitive = node.mesh->primitives[primitiveIndex];
                 HFMMeshPart part = HFMMeshPart();
 
-                if (primitive.indices == nullptr) {
-                    qDebug() << "No indices accessor for mesh: " << _url;
-                    hfmModel.loadErrorCount++;
+                const GLTFPrimitiveData& data = decodedPrimitives[firstDecodedPrimitive + primitiveIndex];
+                hfmModel.loadErrorCount += data.errorCount;
+                if (data.status == GLTFPrimitiveData::Failed) {
                     return false;
-                }
-                auto &indicesAccessor = primitive.indices;
-
-                // Buffers
-                QVector<int> indices;
-                QVector<float> vertices;
-                int verticesStride = 3;
-                QVector<float> normals;
-                int normalStride = 3;
-                QVector<float> tangents;
-                int tangentStride = 4;
-                QVector<float> texcoords;
-                int texCoordStride = 2;
-                QVector<float> texcoords2;
-                int texCoord2Stride = 2;
-                QVector<float> colors;
-                int colorStride = 3;
-                QVector<uint16_t> joints;
-                int jointStride = 4;
-                QVector<float> weights;
-                int weightStride = 4;
-
-                indices.resize((int)indicesAccessor->count);
-                size_t readIndicesCount = cgltf_accessor_unpack_indices(indicesAccessor, indices.data(), sizeof(unsigned int), indicesAccessor->count);
-
-                if (readIndicesCount != indicesAccessor->count) {
-                    qWarning(modelformat) << "There was a problem reading glTF INDICES data for model " << _url;
-                    hfmModel.loadErrorCount++;
+                } else if (data.status == GLTFPrimitiveData::Skipped) {
                     continue;
                 }
 
+                const QVector<int>& indices = data.indices;
+                const QVector<float>& vertices = data.vertices;
+                const int verticesStride = 3;
+                const QVector<float>& normals = data.normals;
+                const int normalStride = 3;
+                const QVector<float>& tangents = data.tangents;
+                const int tangentStride = data.tangentStride;
+                const QVector<float>& texcoords = data.texcoords;
+                const int texCoordStride = 2;
+                const QVector<float>& texcoords2 = data.texcoords2;
+                const int texCoord2Stride = 2;
+                const QVector<float>& colors = data.colors;
+                const int colorStride = data.colorStride;
+                const QVector<uint16_t>& joints = data.joints;
+                const int jointStride = data.jointStride;
+                const QVector<float>& weights = data.weights;
+                const int weightStride = data.weightStride;
+
                 // Increment the triangle indices by the current mesh vertex count so each mesh part can all reference the same buffers within the mesh
                 int prevMeshVerticesCount = mesh.vertices.count();
 
@@ -481,283 +844,8 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                 QVector<uint16_t> clusterJoints;
                 QVector<float> clusterWeights;
 
-                for (size_t attributeIndex = 0; attributeIndex < primitive.attributes_count; attributeIndex++) {
-                    if (primitive.attributes[attributeIndex].name == nullptr) {
-                        qDebug() << "Inalid accessor name for mesh: " << _url;
-                        hfmModel.loadErrorCount++;
-                        return false;
-                    }
-                    QString key(primitive.attributes[attributeIndex].name);
-
-                    if (primitive.attributes[attributeIndex].data == nullptr) {
-                        qDebug() << "Inalid accessor for mesh: " << _url;
-                        hfmModel.loadErrorCount++;
-                        return false;
-                    }
-                    auto accessor = primitive.attributes[attributeIndex].data;
-                    int accessorCount = (int)accessor->count;
-
-                    if (key == "POSITION") {
-                        if (accessor->type != cgltf_type_vec3) {
-                            qWarning(modelformat) << "Invalid accessor type on glTF POSITION data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        vertices.resize(accessorCount * 3);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, vertices.data(), accessor->count * 3);
-                        if (floatCount != accessor->count * 3) {
-                            qWarning(modelformat) << "There was a problem reading glTF POSITION data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-                    } else if (key == "NORMAL") {
-                        if (accessor->type != cgltf_type_vec3) {
-                            qWarning(modelformat) << "Invalid accessor type on glTF NORMAL data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        normals.resize(accessorCount * 3);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, normals.data(), accessor->count * 3);
-                        if (floatCount != accessor->count * 3) {
-                            qWarning(modelformat) << "There was a problem reading glTF NORMAL data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-                    } else if (key == "TANGENT") {
-                        if (accessor->type == cgltf_type_vec4) {
-                            tangentStride = 4;
-                        } else if (accessor->type == cgltf_type_vec3) {
-                            tangentStride = 3;
-                        } else {
-                            qWarning(modelformat) << "Invalid accessor type on glTF TANGENT data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        tangents.resize(accessorCount * tangentStride);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, tangents.data(), accessor->count * tangentStride);
-                        if (floatCount != accessor->count * tangentStride) {
-                            qWarning(modelformat) << "There was a problem reading glTF TANGENT data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            tangentStride = 0;
-                            continue;
-                        }
-                    } else if (key == "TEXCOORD_0") {
-                        if (accessor->type != cgltf_type_vec2) {
-                            qWarning(modelformat) << "Invalid accessor type on glTF TEXCOORD_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        texcoords.resize(accessorCount * 2);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, texcoords.data(), accessor->count * 2);
-                        if (floatCount != accessor->count * 2) {
-                            qWarning(modelformat) << "There was a problem reading glTF TEXCOORD_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-                    } else if (key == "TEXCOORD_1") {
-                        if (accessor->type != cgltf_type_vec2) {
-                            qWarning(modelformat) << "Invalid accessor type on glTF TEXCOORD_1 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        texcoords2.resize(accessorCount * 2);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, texcoords2.data(), accessor->count * 2);
-                        if (floatCount != accessor->count * 2) {
-                            qWarning(modelformat) << "There was a problem reading glTF TEXCOORD_1 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-                    } else if (key == "COLOR_0") {
-                        if (accessor->type == cgltf_type_vec4) {
-                            colorStride = 4;
-                        } else if (accessor->type == cgltf_type_vec3) {
-                            colorStride = 3;
-                        } else {
-                            qWarning(modelformat) << "Invalid accessor type on glTF COLOR_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        colors.resize(accessorCount * colorStride);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, colors.data(), accessor->count * colorStride);
-                        if (floatCount != accessor->count * colorStride) {
-                            qWarning(modelformat) << "There was a problem reading glTF COLOR_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-                    } else if (key == "JOINTS_0") {
-                        if (accessor->type == cgltf_type_vec4) {
-                            jointStride = 4;
-                        } else if (accessor->type == cgltf_type_vec3) {
-                            jointStride = 3;
-                        } else if (accessor->type == cgltf_type_vec2) {
-                            jointStride = 2;
-                        } else if (accessor->type == cgltf_type_scalar) {
-                            jointStride = 1;
-                        } else {
-                            qWarning(modelformat) << "Invalid accessor type on glTF JOINTS_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        joints.resize(accessorCount * jointStride);
-                        cgltf_uint jointIndices[4];
-                        for (size_t i = 0; i < accessor->count; i++) {
-                            cgltf_accessor_read_uint(accessor, i, jointIndices, jointStride);
-                            for (int component = 0; component < jointStride; component++) {
-                                joints[(int)i * jointStride + component] = (uint16_t)jointIndices[component];
-                            }
-                        }
-
-                    } else if (key == "WEIGHTS_0") {
-                        if (accessor->type == cgltf_type_vec4) {
-                            weightStride = 4;
-                        } else if (accessor->type == cgltf_type_vec3) {
-                            weightStride = 3;
-                        } else if (accessor->type == cgltf_type_vec2) {
-                            weightStride = 2;
-                        } else if (accessor->type == cgltf_type_scalar) {
-                            weightStride = 1;
-                        } else {
-                            qWarning(modelformat) << "Invalid accessor type on glTF WEIGHTS_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-
-                        weights.resize(accessorCount * weightStride);
-                        size_t floatCount = cgltf_accessor_unpack_floats(accessor, weights.data(), accessor->count * weightStride);
-                        if (floatCount != accessor->count * weightStride) {
-                            qWarning(modelformat) << "There was a problem reading glTF WEIGHTS_0 data for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            continue;
-                        }
-                    }
-                }
-
-                // Validation stage
-                if (indices.count() == 0) {
-                    qWarning(modelformat) << "Missing indices for model " << _url;
-                    hfmModel.loadErrorCount++;
-                    continue;
-                }
-                if (vertices.count() == 0) {
-                    qWarning(modelformat) << "Missing vertices for model " << _url;
-                    hfmModel.loadErrorCount++;
-                    continue;
-                }
-
                 int partVerticesCount = vertices.size() / 3;
 
-                // generate the normals if they don't exist
-                if (normals.size() == 0) {
-                    QVector<int> newIndices;
-                    QVector<float> newVertices;
-                    QVector<float> newNormals;
-                    QVector<float> newTexcoords;
-                    QVector<float> newTexcoords2;
-                    QVector<float> newColors;
-                    QVector<uint16_t> newJoints;
-                    QVector<float> newWeights;
-
-                    for (int n = 0; n + 2 < indices.size(); n = n + 3) {
-                        int v1_index = (indices[n + 0] * 3);
-                        int v2_index = (indices[n + 1] * 3);
-                        int v3_index = (indices[n + 2] * 3);
-
-                        if (v1_index + 2 >= vertices.size() || v2_index + 2 >= vertices.size() || v3_index + 2 >= vertices.size()) {
-                            qWarning(modelformat) << "Indices out of range for model " << _url;
-                            hfmModel.loadErrorCount++;
-                            return false;
-                        }
-
-                        glm::vec3 v1 = glm::vec3(vertices[v1_index], vertices[v1_index + 1], vertices[v1_index + 2]);
-                        glm::vec3 v2 = glm::vec3(vertices[v2_index], vertices[v2_index + 1], vertices[v2_index + 2]);
-                        glm::vec3 v3 = glm::vec3(vertices[v3_index], vertices[v3_index + 1], vertices[v3_index + 2]);
-
-                        newVertices.append(v1.x);
-                        newVertices.append(v1.y);
-                        newVertices.append(v1.z);
-                        newVertices.append(v2.x);
-                        newVertices.append(v2.y);
-                        newVertices.append(v2.z);
-                        newVertices.append(v3.x);
-                        newVertices.append(v3.y);
-                        newVertices.append(v3.z);
-
-                        glm::vec3 norm = glm::normalize(glm::cross(v2 - v1, v3 - v1));
-
-                        newNormals.append(norm.x);
-                        newNormals.append(norm.y);
-                        newNormals.append(norm.z);
-                        newNormals.append(norm.x);
-                        newNormals.append(norm.y);
-                        newNormals.append(norm.z);
-                        newNormals.append(norm.x);
-                        newNormals.append(norm.y);
-                        newNormals.append(norm.z);
-
-                        if (texcoords.size() == partVerticesCount * texCoordStride) {
-                            GLTF_APPEND_ARRAY_2(newTexcoords, texcoords)
-                        }
-
-                        if (texcoords2.size() == partVerticesCount * texCoord2Stride) {
-                            GLTF_APPEND_ARRAY_2(newTexcoords2, texcoords2)
-                        }
-
-                        if (colors.size() == partVerticesCount * colorStride) {
-                            if (colorStride == 4) {
-                                GLTF_APPEND_ARRAY_4(newColors, colors)
-                            } else {
-                                GLTF_APPEND_ARRAY_3(newColors, colors)
-                            }
-                        }
-
-                        if (joints.size() == partVerticesCount * jointStride) {
-                            if (jointStride == 4) {
-                                GLTF_APPEND_ARRAY_4(newJoints, joints)
-                            } else if (jointStride == 3) {
-                                GLTF_APPEND_ARRAY_3(newJoints, joints)
-                            } else if (jointStride == 2) {
-                                GLTF_APPEND_ARRAY_2(newJoints, joints)
-                            } else {
-                                GLTF_APPEND_ARRAY_1(newJoints, joints)
-                            }
-                        }
-
-                        if (weights.size() == partVerticesCount * weightStride) {
-                            if (weightStride == 4) {
-                                GLTF_APPEND_ARRAY_4(newWeights, weights)
-                            } else if (weightStride == 3) {
-                                GLTF_APPEND_ARRAY_3(newWeights, weights)
-                            } else if (weightStride == 2) {
-                                GLTF_APPEND_ARRAY_2(newWeights, weights)
-                            } else {
-                                GLTF_APPEND_ARRAY_1(newWeights, weights)
-                            }
-                        }
-                        newIndices.append(n);
-                        newIndices.append(n + 1);
-                        newIndices.append(n + 2);
-                    }
-
-                    vertices = newVertices;
-                    normals = newNormals;
-                    tangents = QVector<float>();
-                    texcoords = newTexcoords;
-                    texcoords2 = newTexcoords2;
-                    colors = newColors;
-                    joints = newJoints;
-                    weights = newWeights;
-                    indices = newIndices;
-
-                    partVerticesCount = vertices.size() / 3;
-                }
-
                 QVector<int> validatedIndices;
                 for (int n = 0; n < indices.count(); ++n) {
                     if (indices[n] < partVerticesCount) {
@@ -944,6 +1032,7 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                     }
 
                     // normalize and compress to 16-bits
+                    glm::vec3 globalMeshScale = extractScale(globalTransforms[nodeIndex]);
                     for (int i = 0; i < numVertices; ++i) {
                         int j = i * WEIGHTS_PER_VERTEX;
 
@@ -962,7 +1051,6 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                         for (int k = j; k < j + WEIGHTS_PER_VERTEX; ++k) {
                             int clusterIndex = mesh.clusterIndices[prevMeshClusterIndexCount + k];
                             ShapeVertices& points = hfmModel.shapeVertices.at(clusterIndex);
-                            glm::vec3 globalMeshScale = extractScale(globalTransforms[nodeIndex]);
                             const glm::mat4 meshToJoint = glm::scale(glm::mat4(), globalMeshScale) * jointInverseBindTransforms[clusterIndex];
 
                             const uint16_t EXPANSION_WEIGHT_THRESHOLD = UINT16_MAX/4; // Equivalent of 0.25f?
@@ -1133,8 +1221,9 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                     }
                 }
 
-                foreach(const glm::vec3& vertex, mesh.vertices) {
-                    glm::vec3 transformedVertex = glm::vec3(globalTransforms[nodeIndex] * glm::vec4(vertex, 1.0f));
+                // the vertices of the previous parts are already in the extents
+                for (int i = prevMeshVerticesCount; i < mesh.vertices.size(); i++) {
+                    glm::vec3 transformedVertex = glm::vec3(globalTransforms[nodeIndex] * glm::vec4(mesh.vertices[i], 1.0f));
                     mesh.meshExtents.addPoint(transformedVertex);
                     hfmModel.meshExtents.addPoint(transformedVertex);
                 }
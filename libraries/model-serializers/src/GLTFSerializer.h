@@ -25,6 +25,7 @@ float atof_locale_independent(char* str);
 
 #include "cgltf.h"
 
+class GLTFPrimitiveData;
 
 class GLTFSerializer : public QObject, public HFMSerializer {
     Q_OBJECT
@@ -43,6 +44,7 @@ private:
     bool getSkinInverseBindMatrices(std::vector<std::vector<float>>& inverseBindMatrixValues);
     bool generateTargetData(cgltf_accessor *accessor, float weight, QVector<glm::vec3>& returnVector);
 
+    void decodePrimitive(const cgltf_primitive& primitive, GLTFPrimitiveData& data) const;
     bool buildGeometry(HFMModel& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& url);
 
     bool readBinary(const QString& url, cgltf_buffer &buffer);
@@ -16,6 +16,7 @@
 #include "OBJSerializer.h"
 
 #include <ctype.h>  // .obj files are not locale-specific. The C/ASCII charset applies.
+#include <atomic>
 #include <sstream>
 
 #include <QtCore/QBuffer>
@@ -24,6 +25,9 @@
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkRequest>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <shared/NsightHelpers.h>
 #include <NetworkAccessManager.h>
 #include <ResourceManager.h>
@@ -44,7 +48,7 @@ const float ILLUMINATION_MODEL_APPLY_NON_METALLIC = 0.0f;
 
 namespace {
 template<class T>
-T& checked_at(QVector<T>& vector, int i) {
+const T& checked_at(const QVector<T>& vector, int i) {
     if (i < 0 || i >= vector.size()) {
         throw std::out_of_range("index " + std::to_string(i) + "is out of range");
     }
@@ -761,71 +765,128 @@ HFMModel::Pointer OBJSerializer::read(const hifi::ByteArray& data, const hifi::V
         mesh.parts.clear();
         mesh.parts = QVector<HFMMeshPart>(hfmMeshParts);
 
-        for (int i = 0, meshPartCount = 0; i < unmodifiedMeshPartCount; i++, meshPartCount++) {
-            FaceGroup faceGroup = faceGroups[meshPartCount];
-
+        // Every triangle gets three vertices of its own, so the position of its data in the mesh is known up front
+        // and the vertex data can be filled in in parallel. Only the part indices are appended in order.
+        std::vector<const OBJFace*> faces;
+        std::vector<int> faceParts;
+        for (int i = 0; i < unmodifiedMeshPartCount; i++) {
+            for (const OBJFace& face : faceGroups.at(i)) {
+                faces.push_back(&face);
+                faceParts.push_back(materialMeshIdMap[face.materialName]);
+            }
+        }
+        const int numFaces = (int)faces.size();
+        const bool hasVertexColors = (vertexColors.size() > 0);
+        const int firstVertex = mesh.vertices.count();
+        const int firstColor = mesh.colors.count();
+        const int firstNormal = mesh.normals.count();
+        const int firstTexCoord = mesh.texCoords.count();
+
+        mesh.vertices.resize(firstVertex + 3 * numFaces);
+        if (hasVertexColors) {
+            mesh.colors.resize(firstColor + 3 * numFaces);
+        }
+        mesh.normals.resize(firstNormal + 3 * numFaces);
+        mesh.texCoords.resize(firstTexCoord + 3 * numFaces);
+        glm::vec3* meshVertices = mesh.vertices.data() + firstVertex;
+        glm::vec3* meshColors = mesh.colors.data() + firstColor;
+        glm::vec3* meshNormals = mesh.normals.data() + firstNormal;
+        glm::vec2* meshTexCoords = mesh.texCoords.data() + firstTexCoord;
+
+        auto addFace = [&](int faceIndex) {
             // Now that each mesh has been created with its own unique material mappings, fill them with data (vertex data is duplicated, face data is not).
-            foreach(OBJFace face, faceGroup) {
-                HFMMeshPart& meshPart = mesh.parts[materialMeshIdMap[face.materialName]];
-
-                glm::vec3 v0 = checked_at(vertices, face.vertexIndices[0]);
-                glm::vec3 v1 = checked_at(vertices, face.vertexIndices[1]);
-                glm::vec3 v2 = checked_at(vertices, face.vertexIndices[2]);
-
-                glm::vec3 vc0, vc1, vc2;
-                bool hasVertexColors = (vertexColors.size() > 0);
-                if (hasVertexColors) {
-                    // If there are any vertex colors, it's safe to assume all meshes had them exported.
-                    vc0 = checked_at(vertexColors, face.vertexIndices[0]);
-                    vc1 = checked_at(vertexColors, face.vertexIndices[1]);
-                    vc2 = checked_at(vertexColors, face.vertexIndices[2]);
-                }
+            const OBJFace& face = *faces[faceIndex];
+
+            glm::vec3 v0 = checked_at(vertices, face.vertexIndices[0]);
+            glm::vec3 v1 = checked_at(vertices, face.vertexIndices[1]);
+            glm::vec3 v2 = checked_at(vertices, face.vertexIndices[2]);
+
+            glm::vec3 vc0, vc1, vc2;
+            if (hasVertexColors) {
+                // If there are any vertex colors, it's safe to assume all meshes had them exported.
+                vc0 = checked_at(vertexColors, face.vertexIndices[0]);
+                vc1 = checked_at(vertexColors, face.vertexIndices[1]);
+                vc2 = checked_at(vertexColors, face.vertexIndices[2]);
+            }
 
-                // Scale the vertices if the OBJ file scale is specified as non-one.
-                if (scaleGuess != 1.0f) {
-                    v0 *= scaleGuess;
-                    v1 *= scaleGuess;
-                    v2 *= scaleGuess;
-                }
+            // Scale the vertices if the OBJ file scale is specified as non-one.
+            if (scaleGuess != 1.0f) {
+                v0 *= scaleGuess;
+                v1 *= scaleGuess;
+                v2 *= scaleGuess;
+            }
 
-                // Add the vertices.
-                meshPart.triangleIndices.append(mesh.vertices.count()); // not face.vertexIndices into vertices
-                mesh.vertices << v0;
-                meshPart.triangleIndices.append(mesh.vertices.count());
-                mesh.vertices << v1;
-                meshPart.triangleIndices.append(mesh.vertices.count());
-                mesh.vertices << v2;
+            glm::vec3 n0, n1, n2;
+            if (face.normalIndices.count()) {
+                n0 = checked_at(normals, face.normalIndices[0]);
+                n1 = checked_at(normals, face.normalIndices[1]);
+                n2 = checked_at(normals, face.normalIndices[2]);
+            } else {
+                // generate normals from triangle plane if not provided
+                n0 = n1 = n2 = glm::cross(v1 - v0, v2 - v0);
+            }
 
-                if (hasVertexColors) {
-                    // Add vertex colors.
-                    mesh.colors << vc0;
-                    mesh.colors << vc1;
-                    mesh.colors << vc2;
-                }
+            glm::vec2 uv0, uv1, uv2;
+            if (face.textureUVIndices.count()) {
+                uv0 = checked_at(textureUVs, face.textureUVIndices[0]);
+                uv1 = checked_at(textureUVs, face.textureUVIndices[1]);
+                uv2 = checked_at(textureUVs, face.textureUVIndices[2]);
+            } else {
+                uv0 = uv1 = uv2 = glm::vec2(0.0f, 1.0f);
+            }
 
-                glm::vec3 n0, n1, n2;
-                if (face.normalIndices.count()) {
-                    n0 = checked_at(normals, face.normalIndices[0]);
-                    n1 = checked_at(normals, face.normalIndices[1]);
-                    n2 = checked_at(normals, face.normalIndices[2]);
-                } else {
-                    // generate normals from triangle plane if not provided
-                    n0 = n1 = n2 = glm::cross(v1 - v0, v2 - v0);
+            // everything has been looked up, so a bad index can't leave a face half written
+            int offset = 3 * faceIndex;
+            meshVertices[offset] = v0;
+            meshVertices[offset + 1] = v1;
+            meshVertices[offset + 2] = v2;
+            if (hasVertexColors) {
+                meshColors[offset] = vc0;
+                meshColors[offset + 1] = vc1;
+                meshColors[offset + 2] = vc2;
+            }
+            meshNormals[offset] = n0;
+            meshNormals[offset + 1] = n1;
+            meshNormals[offset + 2] = n2;
+            meshTexCoords[offset] = uv0;
+            meshTexCoords[offset + 1] = uv1;
+            meshTexCoords[offset + 2] = uv2;
+        };
+
+        // remember the first face with a bad index, the faces before it are kept like they would be in a serial pass
+        std::atomic<int> firstBadFace { numFaces };
+        tbb::parallel_for(tbb::blocked_range<int>(0, numFaces), [&](const tbb::blocked_range<int>& range) {
+            for (int faceIndex = range.begin(); faceIndex != range.end(); ++faceIndex) {
+                try {
+                    addFace(faceIndex);
+                } catch (const std::out_of_range&) {
+                    int badFace = firstBadFace;
+                    while (faceIndex < badFace && !firstBadFace.compare_exchange_weak(badFace, faceIndex)) {}
+                    return;
                 }
-
-                mesh.normals.append(n0);
-                mesh.normals.append(n1);
-                mesh.normals.append(n2);
-
-                if (face.textureUVIndices.count()) {
-                    mesh.texCoords <<
-                        checked_at(textureUVs, face.textureUVIndices[0]) <<
-                        checked_at(textureUVs, face.textureUVIndices[1]) <<
-                        checked_at(textureUVs, face.textureUVIndices[2]);
-                } else {
-                    glm::vec2 corner(0.0f, 1.0f);
-                    mesh.texCoords << corner << corner << corner;
+            }
+        });
+
+        int numGoodFaces = firstBadFace;
+        for (int faceIndex = 0; faceIndex < numGoodFaces; faceIndex++) {
+            HFMMeshPart& meshPart = mesh.parts[faceParts[faceIndex]];
+            int vertexIndex = firstVertex + 3 * faceIndex; // not face.vertexIndices into vertices
+            meshPart.triangleIndices.append(vertexIndex);
+            meshPart.triangleIndices.append(vertexIndex + 1);
+            meshPart.triangleIndices.append(vertexIndex + 2);
+        }
+        if (numGoodFaces < numFaces) {
+            try {
+                // throws again, for the error handling below
+                addFace(numGoodFaces);
+            } catch (const std::out_of_range&) {
+                mesh.vertices.resize(firstVertex + 3 * numGoodFaces);
+                if (hasVertexColors) {
+                    mesh.colors.resize(firstColor + 3 * numGoodFaces);
                 }
+                mesh.normals.resize(firstNormal + 3 * numGoodFaces);
+                mesh.texCoords.resize(firstTexCoord + 3 * numGoodFaces);
+                throw;
             }
         }
 
@@ -521,13 +521,14 @@ qint64 LimitedNodeList::sendUnreliableUnorderedPacketList(NLPacketList& packetLi
     return bytesSent;
 }
 
-qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList, const SockAddr& sockAddr) {
+qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList, const SockAddr& sockAddr,
+                                       HMACAuth* hmacAuth) {
     // close the last packet in the list
     packetList->closeCurrentPacket();
 
     for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
         NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
-        fillPacketHeader(*nlPacket);
+        fillPacketHeader(*nlPacket, hmacAuth);
     }
 
     return _nodeSocket.writePacketList(std::move(packetList), sockAddr);
@@ -12,6 +12,7 @@
 
 #include "NodeList.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include <QtCore/QDataStream>
@@ -322,6 +323,11 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
 
+    // ask for the whole node list again
+    _domainListVersion = 0;
+    _pendingDomainListVersion = 0;
+    _pendingDomainListEntries.clear();
+
     // if we setup the DTLS socket, also disconnect from the DTLS socket readyRead() so it can handle handshaking
     if (_dtlsSocket) {
         disconnect(_dtlsSocket, 0, this, 0);
@@ -504,7 +510,10 @@ void NodeList::sendDomainServerCheckIn() {
             << localSockAddr << _nodeTypesOfInterest.values();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
-        if (!domainIsConnected) {
+        if (domainIsConnected) {
+            // let the domain-server know which state of the node list we have, so it only sends what changed since
+            packetStream << _domainListVersion.load();
+        } else {
 
             // Directory services account.
             DataServerAccountInfo& accountInfo = accountManager->getAccountInfo();
@@ -765,6 +774,13 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     bool newConnection;
     packetStream >> newConnection;
 
+    // the version of the node list this packet brings us to, the version it has the changes since (or 0 for the whole
+    // list) and the number of nodes added, changed or removed over all of the packets of the list
+    quint32 domainListVersion;
+    quint32 baseDomainListVersion;
+    quint32 numDomainListEntries;
+    packetStream >> domainListVersion >> baseDomainListVersion >> numDomainListEntries;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -861,9 +877,47 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
 
+    parseDomainListEntries(packetStream, message->getSize(), domainListVersion, baseDomainListVersion, numDomainListEntries);
+}
+
+void NodeList::parseDomainListEntries(QDataStream& packetStream, qint64 packetSize, quint32 domainListVersion,
+                                      quint32 baseDomainListVersion, quint32 numDomainListEntries) {
+    // changes since a version we don't have (anymore) can't be applied, the next check in asks for the right ones
+    if (baseDomainListVersion > _domainListVersion) {
+        return;
+    }
+
+    // the entries of a list can span several unreliable packets, and the same list can be sent more than once, so keep
+    // track of which entries were received to know when we have all of them
+    if (domainListVersion != _pendingDomainListVersion || baseDomainListVersion != _pendingDomainListBaseVersion ||
+        _pendingDomainListEntries.size() != numDomainListEntries) {
+        _pendingDomainListVersion = domainListVersion;
+        _pendingDomainListBaseVersion = baseDomainListVersion;
+        _pendingDomainListEntries.assign(numDomainListEntries, false);
+    }
+
     // pull each node in the packet
-    while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+    while (packetStream.device()->pos() < packetSize) {
+        quint32 entryIndex;
+        bool isRemoved;
+        packetStream >> entryIndex >> isRemoved;
+        if (isRemoved) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            killNodeWithUUID(nodeUUID);
+            removeDelayedAdd(nodeUUID);
+        } else {
+            parseNodeFromPacketStream(packetStream);
+        }
+        if (entryIndex < _pendingDomainListEntries.size()) {
+            _pendingDomainListEntries[entryIndex] = true;
+        }
+    }
+
+    bool isComplete = std::all_of(_pendingDomainListEntries.begin(), _pendingDomainListEntries.end(),
+                                  [](bool received) { return received; });
+    if (isComplete && (baseDomainListVersion == 0 || domainListVersion > _domainListVersion)) {
+        _domainListVersion = domainListVersion;
     }
 }
 
@@ -170,6 +170,8 @@ private:
     void sendDSPathQuery(const QString& newPath);
 
     void parseNodeFromPacketStream(QDataStream& packetStream);
+    void parseDomainListEntries(QDataStream& packetStream, qint64 packetSize, quint32 domainListVersion,
+                                quint32 baseDomainListVersion, quint32 numDomainListEntries);
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
 
@@ -183,6 +185,13 @@ private:
     QTimer _keepAlivePingTimer;
     bool _requestsDomainListData { false };
 
+    // The domain-server numbers the states of its node list, and answers each check in with what changed since the last
+    // one we received all of, or everything when that is 0
+    std::atomic<quint32> _domainListVersion { 0 };
+    quint32 _pendingDomainListVersion { 0 };
+    quint32 _pendingDomainListBaseVersion { 0 };
+    std::vector<bool> _pendingDomainListEntries;
+
     bool _sendDomainServerCheckInEnabled { true };
     bool _domainPortAutoDiscovery { true };
 
@@ -12,6 +12,7 @@
 #include "ResourceCache.h"
 #include "ResourceRequestObserver.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <assert.h>
@@ -20,6 +21,7 @@
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 #include <shared/QtHelpers.h>
 #include <Trace.h>
@@ -30,13 +32,19 @@
 #include "NetworkLogging.h"
 #include "NodeList.h"
 
+const quint64 ResourceCacheSharedItems::PRIORITY_REFRESH_INTERVAL { 16 * USECS_PER_MSEC };
+
 bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource, float priority) {
     Lock lock(_mutex);
     if ((uint32_t)_loadingRequests.size() < _requestLimit) {
         _loadingRequests.append({ resource, priority });
         return true;
     } else {
-        _pendingRequests.append(resource);
+        auto locked = resource.lock();
+        if (locked) {
+            _pendingRequests.push_back({ resource, locked->getLoadPriority(), locked->getURL().scheme() == HIFI_URL_SCHEME_FILE });
+            std::push_heap(_pendingRequests.begin(), _pendingRequests.end());
+        }
         return false;
     }
 }
@@ -55,8 +63,8 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach (QWeakPointer<Resource> resource, _pendingRequests) {
-        auto locked = resource.lock();
+    for (const auto& request : _pendingRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -67,7 +75,7 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return (uint32_t)_pendingRequests.size();
 }
 
 QList<std::pair<QSharedPointer<Resource>, float>> ResourceCacheSharedItems::getLoadingRequests() const {
@@ -106,40 +114,47 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     }
 }
 
-std::pair<QSharedPointer<Resource>, float> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
+void ResourceCacheSharedItems::updatePendingPriorities() {
     Lock lock(_mutex);
+    updatePendingPrioritiesLocked();
+}
 
-    bool currentHighestIsFile = false;
-
-    for (int i = 0; i < _pendingRequests.size();) {
-        // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
+void ResourceCacheSharedItems::updatePendingPrioritiesLocked() {
+    // Clear any freed resources and rebuild the heap from fresh priorities, in O(n)
+    auto end = std::remove_if(_pendingRequests.begin(), _pendingRequests.end(), [](PendingRequest& request) {
+        auto resource = request.resource.lock();
         if (!resource) {
-            _pendingRequests.removeAt(i);
-            continue;
+            return true;
         }
+        request.priority = resource->getLoadPriority();
+        return false;
+    });
+    _pendingRequests.erase(end, _pendingRequests.end());
+    std::make_heap(_pendingRequests.begin(), _pendingRequests.end());
+    _lastPriorityRefresh = usecTimestampNow();
+}
 
-        // Check load priority
-        float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
-            currentHighestIsFile = isFile;
-        }
-        i++;
+std::pair<QSharedPointer<Resource>, float> ResourceCacheSharedItems::getHighestPendingRequest() {
+    Lock lock(_mutex);
+
+    // Priorities follow the camera, so they are evaluated again once per frame rather than on every dispatch
+    if (usecTimestampNow() - _lastPriorityRefresh > PRIORITY_REFRESH_INTERVAL) {
+        updatePendingPrioritiesLocked();
     }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+    while (!_pendingRequests.empty()) {
+        std::pop_heap(_pendingRequests.begin(), _pendingRequests.end());
+        PendingRequest request = _pendingRequests.back();
+        _pendingRequests.pop_back();
+
+        // Skip any freed resources
+        auto resource = request.resource.lock();
+        if (resource) {
+            return { resource, request.priority };
+        }
     }
 
-    return { highestResource, highestPriority };
+    return { QSharedPointer<Resource>(), -FLT_MAX };
 }
 
 void ResourceCacheSharedItems::clear() {
@@ -16,6 +16,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <vector>
 #include <math.h>
 
 #include <QtCore/QHash>
@@ -78,11 +79,32 @@ public:
     uint32_t getLoadingRequestsCount() const;
     void clear();
 
+    /// Evaluates the load priority of every pending request again.  This happens by itself at most once per
+    /// PRIORITY_REFRESH_INTERVAL when requests are dispatched; in between, the priorities they were last given are used.
+    void updatePendingPriorities();
+
+    static const quint64 PRIORITY_REFRESH_INTERVAL; // usecs
+
 private:
     ResourceCacheSharedItems() = default;
 
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        float priority;
+        bool isFile;
+
+        // Local files go first, then the highest priority
+        bool operator<(const PendingRequest& other) const {
+            return isFile != other.isFile ? !isFile : priority < other.priority;
+        }
+    };
+
+    void updatePendingPrioritiesLocked();
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
+    // Max-heap on the last evaluated priority
+    std::vector<PendingRequest> _pendingRequests;
+    quint64 _lastPriorityRefresh { 0 };
     QList<std::pair<QWeakPointer<Resource>, float>> _loadingRequests;
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
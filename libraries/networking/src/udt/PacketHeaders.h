@@ -147,6 +147,7 @@ public:
         StopInjector,
         AvatarZonePresence,
         WebRTCSignaling,
+        ResidentInjector,
         NUM_PACKET_TYPE
     };
 
@@ -449,7 +450,8 @@ enum class DomainConnectRequestVersion : PacketVersion {
 
 enum class DomainListRequestVersion : PacketVersion {
     PreSocketTypes = 22,
-    SocketTypes
+    SocketTypes,
+    NodeListDeltas
 };
 
 enum class DomainConnectionDeniedVersion : PacketVersion {
@@ -472,7 +474,8 @@ enum class DomainListVersion : PacketVersion {
     AuthenticationOptional,
     HasTimestamp,
     HasConnectReason,
-    SocketTypes
+    SocketTypes,
+    NodeListDeltas
 };
 
 enum class AudioVersion : PacketVersion {
@@ -483,7 +486,8 @@ enum class AudioVersion : PacketVersion {
     SpaceBubbleChanges,
     HasPersonalMute,
     HighDynamicRangeVolume,
-    StopInjectors
+    StopInjectors,
+    ResidentInjectors
 };
 
 enum class MessageDataVersion : PacketVersion {
@@ -68,6 +68,39 @@ Octree::~Octree() {
     eraseAllOctreeElements(false);
 }
 
+void Octree::lockForReadMeasured() const {
+    if (!getLock().tryLockForRead()) {
+        quint64 start = usecTimestampNow();
+        getLock().lockForRead();
+        _contendedReadLocks++;
+        _readWaitUsecs += usecTimestampNow() - start;
+    }
+}
+
+void Octree::lockForWriteMeasured() const {
+    if (!getLock().tryLockForWrite()) {
+        quint64 start = usecTimestampNow();
+        getLock().lockForWrite();
+        _contendedWriteLocks++;
+        _writeWaitUsecs += usecTimestampNow() - start;
+    }
+}
+
+QJsonObject Octree::getLockStatsJson() const {
+    quint64 contendedReadLocks = _contendedReadLocks;
+    quint64 contendedWriteLocks = _contendedWriteLocks;
+    QJsonObject json;
+    json["1. contendedReadLocks"] = (double)contendedReadLocks;
+    json["2. readWaitUsecs"] = (double)_readWaitUsecs;
+    json["3. avgReadWaitUsecsWhenContended"] =
+        contendedReadLocks > 0 ? (double)_readWaitUsecs / (double)contendedReadLocks : 0.0;
+    json["4. contendedWriteLocks"] = (double)contendedWriteLocks;
+    json["5. writeWaitUsecs"] = (double)_writeWaitUsecs;
+    json["6. avgWriteWaitUsecsWhenContended"] =
+        contendedWriteLocks > 0 ? (double)_writeWaitUsecs / (double)contendedWriteLocks : 0.0;
+    return json;
+}
+
 // Recurses voxel tree calling the RecurseOctreeOperation function for each element.
 // stops recursion if operation function returns false.
 void Octree::recurseTreeWithOperation(const RecurseOctreeOperation& operation, void* extraData) {
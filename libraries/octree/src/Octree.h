@@ -12,6 +12,7 @@
 #ifndef hifi_Octree_h
 #define hifi_Octree_h
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <stdint.h>
@@ -138,6 +139,10 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
+    // Optionally decode and validate the edits of a packet before processEditPacketData() is called for each of them
+    // under the write lock. Called without holding the tree lock.
+    virtual void prefilterEditPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { }
+    virtual void clearPrefilteredEdits() { }
 
     virtual bool rootElementHasData() const { return false; }
     virtual void releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncodeData) const { }
@@ -258,8 +263,29 @@ public:
 
     void incrementPersistDataVersion() { _persistDataVersion++; }
 
+    /// withReadLock and withWriteLock for the server's inbound edit and send paths, which also count how often
+    /// and for how long the caller had to wait for the tree lock.
+    template <typename F>
+    void withMeasuredReadLock(F&& f) const {
+        lockForReadMeasured();
+        f();
+        getLock().unlock();
+    }
+
+    template <typename F>
+    void withMeasuredWriteLock(F&& f) const {
+        lockForWriteMeasured();
+        f();
+        getLock().unlock();
+    }
+
+    QJsonObject getLockStatsJson() const;
+
 
 protected:
+    void lockForReadMeasured() const;
+    void lockForWriteMeasured() const;
+
     void deleteOctalCodeFromTreeRecursion(const OctreeElementPointer& element, void* extraData);
 
     static bool countOctreeElementsOperation(const OctreeElementPointer& element, void* extraData);
@@ -279,6 +305,11 @@ protected:
 
     bool _isViewing;
     bool _isServer;
+
+    mutable std::atomic<quint64> _contendedReadLocks { 0 };
+    mutable std::atomic<quint64> _readWaitUsecs { 0 };
+    mutable std::atomic<quint64> _contendedWriteLocks { 0 };
+    mutable std::atomic<quint64> _writeWaitUsecs { 0 };
 };
 
 #endif // hifi_Octree_h
@@ -0,0 +1,98 @@
+//
+//  BulletTaskScheduler.cpp
+//  libraries/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BulletTaskScheduler.h"
+
+#include <functional>
+#include <mutex>
+
+#include <glm/glm.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+
+#include <LinearMath/btQuickprof.h>
+
+#include "PhysicsLogging.h"
+
+BulletTaskScheduler* BulletTaskScheduler::install() {
+    static BulletTaskScheduler* scheduler { nullptr };
+    static std::once_flag once;
+    std::call_once(once, [] {
+        // Bullet keeps a raw pointer for the lifetime of the process
+        scheduler = new BulletTaskScheduler();
+        btSetTaskScheduler(scheduler);
+        qCDebug(physics) << "BulletTaskScheduler: up to" << scheduler->getMaxNumThreads() << "simulation threads";
+    });
+    return scheduler;
+}
+
+BulletTaskScheduler::BulletTaskScheduler() :
+    btITaskScheduler("TBB"),
+    _arena(1) {
+}
+
+int BulletTaskScheduler::getMaxNumThreads() const {
+    // Bullet gives every thread that ever enters one of its loops a slot in per-thread tables of BT_MAX_THREAD_COUNT
+    // entries, and the threads that step the world use some of them too
+    const int RESERVED_THREAD_SLOTS = 4;
+    return glm::clamp(tbb::this_task_arena::max_concurrency(), 1, BT_MAX_THREAD_COUNT - RESERVED_THREAD_SLOTS);
+}
+
+void BulletTaskScheduler::setNumThreads(int numThreads) {
+    numThreads = glm::clamp(numThreads, 1, getMaxNumThreads());
+    if (numThreads != _numThreads) {
+        _numThreads = numThreads;
+        _arena.terminate();
+        _arena.initialize(_numThreads);
+    }
+}
+
+void BulletTaskScheduler::applyRequestedNumThreads() {
+    int numThreads = _requestedNumThreads.exchange(0);
+    if (numThreads > 0) {
+        setNumThreads(numThreads);
+    }
+}
+
+void BulletTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) {
+    BT_PROFILE("parallelFor_TBB");
+    if (_numThreads == 1 || iEnd - iBegin <= grainSize) {
+        body.forLoop(iBegin, iEnd);
+        return;
+    }
+    btPushThreadsAreRunning();
+    _arena.execute([&] {
+        tbb::parallel_for(tbb::blocked_range<int>(iBegin, iEnd, glm::max(grainSize, 1)),
+            [&](const tbb::blocked_range<int>& range) {
+                body.forLoop(range.begin(), range.end());
+            }, tbb::simple_partitioner());
+    });
+    btPopThreadsAreRunning();
+}
+
+btScalar BulletTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) {
+    BT_PROFILE("parallelSum_TBB");
+    if (_numThreads == 1 || iEnd - iBegin <= grainSize) {
+        return body.sumLoop(iBegin, iEnd);
+    }
+    btScalar sum = btScalar(0);
+    btPushThreadsAreRunning();
+    _arena.execute([&] {
+        sum = tbb::parallel_reduce(tbb::blocked_range<int>(iBegin, iEnd, glm::max(grainSize, 1)), btScalar(0),
+            [&](const tbb::blocked_range<int>& range, btScalar partialSum) {
+                return partialSum + body.sumLoop(range.begin(), range.end());
+            }, std::plus<btScalar>(), tbb::simple_partitioner());
+    });
+    btPopThreadsAreRunning();
+    return sum;
+}
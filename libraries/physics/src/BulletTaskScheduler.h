@@ -0,0 +1,55 @@
+//
+//  BulletTaskScheduler.h
+//  libraries/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_BulletTaskScheduler_h
+#define hifi_BulletTaskScheduler_h
+
+#include <atomic>
+
+#include <LinearMath/btThreads.h>
+
+#include <tbb/task_arena.h>
+
+/// Runs the parallel loops of Bullet's multithreaded world (btDiscreteDynamicsWorldMt, btCollisionDispatcherMt and the
+/// solvers in btConstraintSolverPoolMt) on the TBB thread pool that the rest of the engine already uses.
+///
+/// Loops run in a task arena of their own so that the number of threads the simulation uses can be limited without
+/// affecting other TBB work. With a single thread the loops run inline on the calling thread.
+class BulletTaskScheduler : public btITaskScheduler {
+public:
+    /// Creates the scheduler and hands it to Bullet, once per process. Bullet requires this to happen on the thread that
+    /// steps the simulation, before any other thread has used Bullet.
+    /// @return the scheduler Bullet is using
+    static BulletTaskScheduler* install();
+
+    BulletTaskScheduler();
+
+    int getMaxNumThreads() const override;
+    int getNumThreads() const override { return _numThreads; }
+
+    /// Takes effect when the next loop starts. Must not be called while a simulation step is running on another thread;
+    /// use requestNumThreads from other threads.
+    void setNumThreads(int numThreads) override;
+
+    /// Thread safe: the count is applied by applyRequestedNumThreads, at the start of the next simulation step.
+    void requestNumThreads(int numThreads) { _requestedNumThreads = numThreads; }
+    void applyRequestedNumThreads();
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+private:
+    tbb::task_arena _arena;
+    int _numThreads { 1 };
+    std::atomic<int> _requestedNumThreads { 0 };
+};
+
+#endif // hifi_BulletTaskScheduler_h
@@ -11,6 +11,10 @@
 
 #include "EntityMotionState.h"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
 #include <glm/gtx/norm.hpp>
 
 #include <EntityItem.h>
@@ -295,6 +299,20 @@ void EntityMotionState::setWorldTransform(const btTransform& worldTrans) {
 
 
 const uint8_t MAX_NUM_INACTIVE_UPDATES = 20;
+// we resend the inactive update with a growing delay: every INACTIVE_UPDATE_PERIOD * _numInactiveUpdates
+const float INACTIVE_UPDATE_PERIOD = 0.5f;
+const uint8_t FULL_UPDATE_PERIOD = 8;
+
+bool EntityMotionState::canRest() const {
+    // these are the conditions under which remoteSimulationOutOfSync() only waits for the next inactive update
+    return _body && !_body->isActive() && _numInactiveUpdates > 0 && _numInactiveUpdates <= MAX_NUM_INACTIVE_UPDATES &&
+        !_entity->dynamicDataNeedsTransmit() && !_entity->shouldSuppressLocationEdits();
+}
+
+uint32_t EntityMotionState::getNextRestingUpdateStep() const {
+    float delay = INACTIVE_UPDATE_PERIOD * (float)_numInactiveUpdates;
+    return _lastStep + (uint32_t)(delay / PHYSICS_ENGINE_FIXED_SUBSTEP) + 1;
+}
 
 bool EntityMotionState::remoteSimulationOutOfSync(uint32_t simulationStep) {
     // NOTE: this method is only ever called when the entity simulation is locally owned
@@ -314,10 +332,8 @@ bool EntityMotionState::remoteSimulationOutOfSync(uint32_t simulationStep) {
             _entity->clearSimulationOwnership();
             return false;
         }
-        // we resend the inactive update with a growing delay: every INACTIVE_UPDATE_PERIOD * _numInactiveUpdates
-        // until it is removed from the owned list
+        // we resend the inactive update with a growing delay until it is removed from the owned list
         // (which happens when we no longer own the simulation)
-        const float INACTIVE_UPDATE_PERIOD = 0.5f;
         return (dt > INACTIVE_UPDATE_PERIOD * (float)_numInactiveUpdates);
     }
 
@@ -514,7 +530,20 @@ void EntityMotionState::sendBid(OctreeEditPacketSender* packetSender, uint32_t s
     _bumpedPriority = 0;
 }
 
-void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_t step) {
+template <typename T>
+static bool deltaNeedsSend(const T& value, T& sentValue, uint8_t& numUnchangedSends) {
+    if (numUnchangedSends > 0 && value == sentValue) {
+        if (numUnchangedSends < std::numeric_limits<uint8_t>::max()) {
+            ++numUnchangedSends;
+        }
+    } else {
+        sentValue = value;
+        numUnchangedSends = 1;
+    }
+    return numUnchangedSends <= 2;
+}
+
+uint32_t EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_t step) {
     DETAILED_PROFILE_RANGE(simulation_physics, "Send");
     assert(isLocallyOwned());
 
@@ -528,12 +557,28 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_
     _serverAcceleration = _entity->getAcceleration();
     _serverActionData = _entity->getDynamicData();
 
+    bool fullUpdate = _numInactiveUpdates > 0 || _numUpdatesSinceFull >= FULL_UPDATE_PERIOD;
+    _numUpdatesSinceFull = fullUpdate ? 0 : _numUpdatesSinceFull + 1;
+    uint32_t numOmittedProperties = 0;
+    auto sendIfChanged = [&](const auto& value, auto& sentValue, DeltaProperty property, auto setter) {
+        if (deltaNeedsSend(value, sentValue, _numUnchangedSends[property]) || fullUpdate) {
+            setter(value);
+        } else {
+            ++numOmittedProperties;
+        }
+    };
+
     EntityItemProperties properties;
-    properties.setPosition(_entity->getLocalPosition());
-    properties.setRotation(_entity->getLocalOrientation());
-    properties.setVelocity(_serverVelocity);
-    properties.setAcceleration(_serverAcceleration);
-    properties.setAngularVelocity(_serverAngularVelocity);
+    sendIfChanged(_entity->getLocalPosition(), _sentPosition, DELTA_POSITION,
+                  [&](const glm::vec3& value) { properties.setPosition(value); });
+    sendIfChanged(_entity->getLocalOrientation(), _sentRotation, DELTA_ROTATION,
+                  [&](const glm::quat& value) { properties.setRotation(value); });
+    sendIfChanged(_serverVelocity, _sentVelocity, DELTA_VELOCITY,
+                  [&](const glm::vec3& value) { properties.setVelocity(value); });
+    sendIfChanged(_serverAngularVelocity, _sentAngularVelocity, DELTA_ANGULAR_VELOCITY,
+                  [&](const glm::vec3& value) { properties.setAngularVelocity(value); });
+    sendIfChanged(_serverAcceleration, _sentAcceleration, DELTA_ACCELERATION,
+                  [&](const glm::vec3& value) { properties.setAcceleration(value); });
     if (_entity->dynamicDataNeedsTransmit()) {
         _entity->setDynamicDataNeedsTransmit(false);
         properties.setActionData(_serverActionData);
@@ -612,6 +657,7 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_
     // which might get promoted again next frame (after local script or simulation interaction)
     // or we might win the bid
     _bumpedPriority = 0;
+    return numOmittedProperties;
 }
 
 uint32_t EntityMotionState::getIncomingDirtyFlags() const {
@@ -793,18 +839,23 @@ void EntityMotionState::setRegion(uint8_t region) {
 void EntityMotionState::initForBid() {
     if (_ownershipState != EntityMotionState::OwnershipState::Unownable) {
         _ownershipState = EntityMotionState::OwnershipState::PendingBid;
+        // a bid carries everything too, and what we sent under an earlier ownership says nothing about the server now
+        resetDeltaSends();
     }
 }
 
 void EntityMotionState::initForOwned() {
     if (_ownershipState != EntityMotionState::OwnershipState::Unownable) {
         _ownershipState = EntityMotionState::OwnershipState::LocallyOwned;
+        // we don't know what the server has from the previous owner, so the first updates carry everything
+        resetDeltaSends();
     }
 }
 
 void EntityMotionState::clearOwnershipState() {
     if (_ownershipState != OwnershipState::Unownable) {
         _ownershipState = OwnershipState::NotLocallyOwned;
+        resetDeltaSends();
     }
 }
 
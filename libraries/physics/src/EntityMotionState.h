@@ -12,6 +12,8 @@
 #ifndef hifi_EntityMotionState_h
 #define hifi_EntityMotionState_h
 
+#include <algorithm>
+
 #include <EntityItem.h>
 #include <EntityTypes.h>
 #include <AACube.h>
@@ -53,7 +55,12 @@ public:
 
     bool shouldSendUpdate(uint32_t simulationStep);
     void sendBid(OctreeEditPacketSender* packetSender, uint32_t step);
-    void sendUpdate(OctreeEditPacketSender* packetSender, uint32_t step);
+    /// \return the number of transform and velocity properties left out of the update because the server has them
+    uint32_t sendUpdate(OctreeEditPacketSender* packetSender, uint32_t step);
+
+    /// \return true when the body is asleep and shouldSendUpdate() can't be true before getNextRestingUpdateStep()
+    bool canRest() const;
+    uint32_t getNextRestingUpdateStep() const;
 
     virtual uint32_t getIncomingDirtyFlags() const override;
     virtual void clearIncomingDirtyFlags(uint32_t mask = DIRTY_PHYSICS_FLAGS) override;
@@ -154,6 +161,21 @@ protected:
     uint8_t _loopsWithoutOwner;
     mutable uint8_t _accelerationNearlyGravityCount;
     uint8_t _numInactiveUpdates { 1 };
+    bool _isResting { false }; // in PhysicalEntitySimulation's list of owned states that are skipped until they wake
+
+    // Updates only carry the transform and velocities that changed: a value is left out once it has gone out in
+    // two updates in a row, so one lost packet can't leave the server with a stale value.  Every
+    // FULL_UPDATE_PERIOD updates, and the updates that put the object to rest, carry everything.
+    enum DeltaProperty { DELTA_POSITION = 0, DELTA_ROTATION, DELTA_VELOCITY, DELTA_ANGULAR_VELOCITY, DELTA_ACCELERATION,
+                         NUM_DELTA_PROPERTIES };
+    glm::vec3 _sentPosition;
+    glm::quat _sentRotation;
+    glm::vec3 _sentVelocity;
+    glm::vec3 _sentAngularVelocity;
+    glm::vec3 _sentAcceleration;
+    uint8_t _numUnchangedSends[NUM_DELTA_PROPERTIES] { 0, 0, 0, 0, 0 };
+    uint8_t _numUpdatesSinceFull { 0 };
+    void resetDeltaSends() { std::fill(std::begin(_numUnchangedSends), std::end(_numUnchangedSends), 0); }
     uint8_t _bumpedPriority { 0 }; // the target simulation priority according to collision history
     uint8_t _region { workload::Region::INVALID };
 
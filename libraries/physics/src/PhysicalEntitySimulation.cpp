@@ -12,6 +12,10 @@
 
 #include "PhysicalEntitySimulation.h"
 
+#include <cfloat>
+
+#include <glm/gtx/norm.hpp>
+
 #include <Profile.h>
 
 #include "PhysicsHelpers.h"
@@ -80,12 +84,8 @@ void PhysicalEntitySimulation::removeEntityFromInternalLists(EntityItemPointer e
 void PhysicalEntitySimulation::removeOwnershipData(EntityMotionState* motionState) {
     assert(motionState);
     if (motionState->getOwnershipState() == EntityMotionState::OwnershipState::LocallyOwned) {
-        for (uint32_t i = 0; i < _owned.size(); ++i) {
-            if (_owned[i] == motionState) {
-                _owned[i]->clearOwnershipState();
-                _owned.remove(i);
-            }
-        }
+        removeOwned(motionState);
+        motionState->clearOwnershipState();
     } else if (motionState->getOwnershipState() == EntityMotionState::OwnershipState::PendingBid) {
         for (uint32_t i = 0; i < _bids.size(); ++i) {
             if (_bids[i] == motionState) {
@@ -101,12 +101,39 @@ void PhysicalEntitySimulation::clearOwnershipData() {
         _owned[i]->clearOwnershipState();
     }
     _owned.clear();
+    for (uint32_t i = 0; i < _restingOwned.size(); ++i) {
+        _restingOwned[i]->clearOwnershipState();
+        _restingOwned[i]->_isResting = false;
+    }
+    _restingOwned.clear();
+    _nextRestingUpdateStep = std::numeric_limits<uint32_t>::max();
     for (uint32_t i = 0; i < _bids.size(); ++i) {
         _bids[i]->clearOwnershipState();
     }
     _bids.clear();
 }
 
+void PhysicalEntitySimulation::removeOwned(EntityMotionState* motionState) {
+    if (motionState->_isResting) {
+        _restingOwned.removeFirst(motionState);
+        motionState->_isResting = false;
+    } else {
+        _owned.removeFirst(motionState);
+    }
+}
+
+void PhysicalEntitySimulation::restOwned(EntityMotionState* motionState) {
+    motionState->_isResting = true;
+    _restingOwned.push_back(motionState);
+    _nextRestingUpdateStep = glm::min(_nextRestingUpdateStep, motionState->getNextRestingUpdateStep());
+}
+
+void PhysicalEntitySimulation::wakeOwned(EntityMotionState* motionState) {
+    _restingOwned.removeFirst(motionState);
+    motionState->_isResting = false;
+    _owned.push_back(motionState);
+}
+
 void PhysicalEntitySimulation::takeDeadAvatarEntities(SetOfEntities& deadEntities) {
     _deadAvatarEntities.swap(deadEntities);
     _deadAvatarEntities.clear();
@@ -259,6 +286,18 @@ void PhysicalEntitySimulation::removeDeadEntities() {
 }
 // end EntitySimulation overrides
 
+float PhysicalEntitySimulation::computeShapePriority(const EntityItemPointer& entity) const {
+    if (_views.empty()) {
+        return 0.0f;
+    }
+    glm::vec3 position = entity->getWorldPosition();
+    float distance2 = FLT_MAX;
+    for (const auto& view : _views) {
+        distance2 = glm::min(distance2, glm::distance2(position, view.origin));
+    }
+    return sqrtf(distance2);
+}
+
 void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
     // this lambda for when we decide to actually build the motionState
     auto buildMotionState = [&](btCollisionShape* shape, EntityItemPointer entity) {
@@ -298,7 +337,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                         // bummer, the hashes are different and we no longer want the shape we've received
                         ObjectMotionState::getShapeManager()->releaseShape(shape);
                         // try again
-                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->requestShape(shapeInfo, computeShapePriority(entity)));
                         if (shape) {
                             buildMotionState(shape, entity);
                             requestItr = _shapeRequests.erase(requestItr);
@@ -372,7 +411,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                 ShapeInfo shapeInfo;
                 entity->computeShapeInfo(shapeInfo);
                 uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->requestShape(shapeInfo, computeShapePriority(entity)));
                 if (shape) {
                     buildMotionState(shape, entity);
                 } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
@@ -410,11 +449,20 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
     }
     _entitiesToRemoveFromPhysics.clear();
 
+    // shapes are cooked closest to the views first
+    if (_space) {
+        _space->copyViews(_views);
+    }
+
     // entities to add
     buildMotionStatesForEntitiesThatNeedThem();
 
     // motionStates with changed entities: delete, add, or change
     for (auto& object : _incomingChanges) {
+        if (object->_isResting) {
+            // something other than the simulation changed it, so it may have something to send
+            wakeOwned(object);
+        }
         uint32_t unhandledFlags = object->getIncomingDirtyFlags();
 
         uint32_t handledFlags = EASY_DIRTY_PHYSICS_FLAGS;
@@ -427,41 +475,27 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
 
         bool needsNewShape = object->needsNewShape() && object->_entity->isReadyToComputeShape();
         if (needsNewShape) {
-            ShapeType shapeType = object->getShapeType();
-            if (shapeType == SHAPE_TYPE_STATIC_MESH) {
-                ShapeRequest shapeRequest(object->_entity);
-                ShapeRequests::iterator requestItr = _shapeRequests.find(shapeRequest);
-                if (requestItr == _shapeRequests.end()) {
-                    ShapeInfo shapeInfo;
-                    object->_entity->computeShapeInfo(shapeInfo);
-                    uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
-                    if (shape) {
-                        object->setShape(shape);
-                        handledFlags |= Simulation::DIRTY_SHAPE;
-                        needsNewShape = false;
-                    } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
-                        // shape doesn't exist but a new worker has been spawned to build it --> add to shapeRequests and wait
-                        shapeRequest.shapeHash = shapeInfo.getHash();
-                        _shapeRequests.insert(shapeRequest);
-                    } else {
-                        // failed to build shape --> will not be added/updated
-                        handledFlags |= Simulation::DIRTY_SHAPE;
-                    }
-                } else {
-                    // continue waiting for shape request
-                }
-            } else {
+            ShapeRequest shapeRequest(object->_entity);
+            ShapeRequests::iterator requestItr = _shapeRequests.find(shapeRequest);
+            if (requestItr == _shapeRequests.end()) {
                 ShapeInfo shapeInfo;
                 object->_entity->computeShapeInfo(shapeInfo);
-                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
+                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->requestShape(shapeInfo, computeShapePriority(object->_entity)));
                 if (shape) {
                     object->setShape(shape);
                     handledFlags |= Simulation::DIRTY_SHAPE;
                     needsNewShape = false;
+                } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
+                    // shape doesn't exist but a new worker has been spawned to build it --> add to shapeRequests and wait
+                    shapeRequest.shapeHash = shapeInfo.getHash();
+                    _shapeRequests.insert(shapeRequest);
                 } else {
-                    // failed to build shape --> will not be added
+                    // failed to build shape --> will not be added/updated
+                    handledFlags |= Simulation::DIRTY_SHAPE;
                 }
+            } else {
+                // continue waiting for shape request
             }
         }
         if (!isInPhysicsSimulation) {
@@ -517,7 +551,7 @@ void PhysicalEntitySimulation::handleDeactivatedMotionStates(const VectorOfMotio
                             entityState->clearOwnershipState();
                             break;
                         case EntityMotionState::OwnershipState::LocallyOwned:
-                            _owned.removeFirst(entityState);
+                            removeOwned(entityState);
                             entityState->clearOwnershipState();
                             break;
                         default:
@@ -553,6 +587,9 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
                 } else {
                     entityState->getEntity()->updateQueryAACube();
                 }
+            } else if (entityState->_isResting) {
+                // its body woke up
+                wakeOwned(entityState);
             }
         }
     }
@@ -603,7 +640,9 @@ void PhysicalEntitySimulation::sendOwnershipBids(uint32_t numSubsteps) {
                 // therefore we need to immediately send an update so that the values stored are what we're
                 // "telling" the server rather than what we've been "hearing" from the server.
                 _bids[i]->workerBidPriority();
-                _bids[i]->sendUpdate(_entityPacketSender, numSubsteps);
+                _ownedUpdateStats.numPropertiesOmitted += _bids[i]->sendUpdate(_entityPacketSender, numSubsteps);
+                ++_ownedUpdateStats.numUpdatesSent;
+                _ownedUpdateStats.numDeltaProperties += EntityMotionState::NUM_DELTA_PROPERTIES;
 
                 addOwnership(_bids[i]);
                 removeBid = true;
@@ -629,22 +668,51 @@ void PhysicalEntitySimulation::sendOwnedUpdates(uint32_t numSubsteps) {
         return;
     }
     PROFILE_RANGE_EX(simulation_physics, "Update", 0x00000000, (uint64_t)_owned.size());
+
+    // resting states are only visited when the earliest of their inactive updates is due
+    if (numSubsteps >= _nextRestingUpdateStep) {
+        _nextRestingUpdateStep = std::numeric_limits<uint32_t>::max();
+        uint32_t i = 0;
+        while (i < _restingOwned.size()) {
+            EntityMotionState* motionState = _restingOwned[i];
+            if (!motionState->canRest() || numSubsteps >= motionState->getNextRestingUpdateStep()) {
+                _restingOwned.remove(i);
+                motionState->_isResting = false;
+                _owned.push_back(motionState);
+            } else {
+                _nextRestingUpdateStep = glm::min(_nextRestingUpdateStep, motionState->getNextRestingUpdateStep());
+                ++i;
+            }
+        }
+    }
+
     uint32_t i = 0;
     while (i < _owned.size()) {
-        if (!_owned[i]->isLocallyOwned()) {
-            if (_owned[i]->shouldSendBid()) {
-                addOwnershipBid(_owned[i]);
+        EntityMotionState* motionState = _owned[i];
+        ++_ownedUpdateStats.numVisited;
+        if (!motionState->isLocallyOwned()) {
+            if (motionState->shouldSendBid()) {
+                addOwnershipBid(motionState);
             } else {
-                _owned[i]->clearOwnershipState();
+                motionState->clearOwnershipState();
             }
             _owned.remove(i);
         } else {
-            if (_owned[i]->shouldSendUpdate(numSubsteps)) {
-                _owned[i]->sendUpdate(_entityPacketSender, numSubsteps);
+            if (motionState->shouldSendUpdate(numSubsteps)) {
+                _ownedUpdateStats.numPropertiesOmitted += motionState->sendUpdate(_entityPacketSender, numSubsteps);
+                ++_ownedUpdateStats.numUpdatesSent;
+                _ownedUpdateStats.numDeltaProperties += EntityMotionState::NUM_DELTA_PROPERTIES;
+            }
+            if (motionState->canRest() && motionState->isLocallyOwned()) {
+                _owned.remove(i);
+                restOwned(motionState);
+            } else {
+                ++i;
             }
-            ++i;
         }
     }
+    _ownedUpdateStats.numOwned = (uint32_t)(_owned.size() + _restingOwned.size());
+    _ownedUpdateStats.numResting = (uint32_t)_restingOwned.size();
 }
 
 void PhysicalEntitySimulation::handleCollisionEvents(const CollisionEvents& collisionEvents) {
@@ -13,6 +13,7 @@
 #define hifi_PhysicalEntitySimulation_h
 
 #include <stdint.h>
+#include <limits>
 #include <map>
 #include <set>
 
@@ -53,6 +54,16 @@ public:
 class PhysicalEntitySimulation : public EntitySimulation {
     Q_OBJECT
 public:
+    /// Counts of the work spent on the simulations this client owns, and of the updates it sent for them.
+    struct OwnedUpdateStats {
+        uint32_t numOwned { 0 };
+        uint32_t numResting { 0 }; // owned but asleep: not visited until their next inactive update is due
+        uint64_t numVisited { 0 };
+        uint64_t numUpdatesSent { 0 };
+        uint64_t numDeltaProperties { 0 }; // transform and velocities in the updates sent, before the delta encoding
+        uint64_t numPropertiesOmitted { 0 }; // those of them that were left out
+    };
+
     PhysicalEntitySimulation();
     ~PhysicalEntitySimulation();
 
@@ -92,6 +103,8 @@ public:
     void handleChangedMotionStates(const VectorOfMotionStates& motionStates);
     void handleCollisionEvents(const CollisionEvents& collisionEvents);
 
+    const OwnedUpdateStats& getOwnedUpdateStats() const { return _ownedUpdateStats; }
+
     EntityEditPacketSender* getPacketSender() { return _entityPacketSender; }
 
     void addOwnershipBid(EntityMotionState* motionState);
@@ -100,7 +113,13 @@ public:
     void sendOwnedUpdates(uint32_t numSubsteps);
 
 private:
+    void removeOwned(EntityMotionState* motionState);
+    void restOwned(EntityMotionState* motionState);
+    void wakeOwned(EntityMotionState* motionState);
+
     void buildMotionStatesForEntitiesThatNeedThem();
+    /// @return the priority of cooking the shape of entity: its distance to the nearest workload view
+    float computeShapePriority(const EntityItemPointer& entity) const;
 
     class ShapeRequest {
     public:
@@ -123,6 +142,7 @@ private:
     EntityEditPacketSender* _entityPacketSender = nullptr;
 
     VectorOfEntityMotionStates _owned;
+    VectorOfEntityMotionStates _restingOwned; // owned states whose bodies sleep, see EntityMotionState::canRest()
     VectorOfEntityMotionStates _bids;
     SetOfEntities _deadAvatarEntities; // to remove from Avatar's lists
     std::vector<EntityItemPointer> _entitiesToDeleteLater;
@@ -132,8 +152,11 @@ private:
     QRecursiveMutex _dynamicsMutex;
 
     workload::SpacePointer _space;
+    std::vector<workload::View> _views;
     uint64_t _nextBidExpiry;
     uint32_t _lastStepSendPackets { 0 };
+    uint32_t _nextRestingUpdateStep { std::numeric_limits<uint32_t>::max() };
+    OwnedUpdateStats _ownedUpdateStats;
     uint32_t _lastWorkDeliveryCount { 0 };
 };
 
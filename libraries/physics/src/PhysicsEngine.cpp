@@ -11,6 +11,7 @@
 
 #include "PhysicsEngine.h"
 
+#include <algorithm>
 #include <functional>
 
 #include <QFile>
@@ -19,7 +20,12 @@
 #include <PhysicsCollisionGroups.h>
 #include <Profile.h>
 #include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#ifdef HIFI_BULLET_MULTITHREADING
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#endif
 
+#include "BulletTaskScheduler.h"
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
 #include "PhysicsHelpers.h"
@@ -39,16 +45,30 @@ PhysicsEngine::~PhysicsEngine() {
     delete _broadphaseFilter;
     delete _constraintSolver;
     delete _dynamicsWorld;
+    delete _solverPool;
     delete _ghostPairCallback;
 }
 
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
         _collisionConfig = new btDefaultCollisionConfiguration();
-        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
+#ifdef HIFI_BULLET_MULTITHREADING
+        _taskScheduler = BulletTaskScheduler::install();
+        // with one thread the scheduler runs every loop inline, on the thread that steps the world
+        _taskScheduler->setNumThreads(_numSimulationThreads);
+        _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig);
+        // one solver per thread solves the small islands, and a multithreaded solver takes the large ones
+        _solverPool = new btConstraintSolverPoolMt(_taskScheduler->getMaxNumThreads());
+        _constraintSolver = new btSequentialImpulseConstraintSolverMt();
+        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter,
+                                                     static_cast<btConstraintSolverPoolMt*>(_solverPool),
+                                                     _constraintSolver, _collisionConfig);
+#else
+        _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _constraintSolver = new btSequentialImpulseConstraintSolver;
         _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+#endif
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -70,6 +90,25 @@ void PhysicsEngine::init() {
     }
 }
 
+void PhysicsEngine::setNumSimulationThreads(int numThreads) {
+    _numSimulationThreads = std::max(numThreads, 1);
+    if (_taskScheduler) {
+        _taskScheduler->requestNumThreads(_numSimulationThreads);
+    }
+}
+
+int PhysicsEngine::getNumSimulationThreads() const {
+    return _taskScheduler ? _taskScheduler->getNumThreads() : 1;
+}
+
+int PhysicsEngine::getMaxNumSimulationThreads() {
+#ifdef HIFI_BULLET_MULTITHREADING
+    return BulletTaskScheduler::install()->getMaxNumThreads();
+#else
+    return 1;
+#endif
+}
+
 uint32_t PhysicsEngine::getNumSubsteps() const {
     return _dynamicsWorld->getNumSubsteps();
 }
@@ -315,6 +354,10 @@ void PhysicsEngine::stepSimulation() {
     _clock.reset();
     float timeStep = btMin(dt, MAX_TIMESTEP);
 
+    if (_taskScheduler) {
+        _taskScheduler->applyRequestedNumThreads();
+    }
+
     auto onSubStep = [this]() {
         this->updateContactMap();
         this->doOwnershipInfectionForConstraints();
@@ -29,6 +29,7 @@
 
 const float HALF_SIMULATION_EXTENT = 512.0f; // meters
 
+class BulletTaskScheduler;
 class CharacterController;
 class PhysicsDebugDraw;
 
@@ -99,6 +100,14 @@ public:
     uint32_t getNumSubsteps() const;
     int32_t getNumCollisionObjects() const;
 
+    /// Limits how many threads narrowphase, integration and island solving may use when built with
+    /// USE_BULLET_MULTITHREADING (otherwise the simulation always runs on one thread). One by default.
+    /// Thread safe; applied on the next step, or by init() when called before it.
+    void setNumSimulationThreads(int numThreads);
+    int getNumSimulationThreads() const;
+    /// @return 1 unless built with USE_BULLET_MULTITHREADING
+    static int getMaxNumSimulationThreads();
+
     void removeObjects(const VectorOfMotionStates& objects);
     void removeSetOfObjects(const SetOfMotionStates& objects); // only called during teardown
 
@@ -154,6 +163,7 @@ public:
     // See PhysicsCollisionGroups.h for mask flags.
     std::vector<ContactTestResult> contactTest(uint16_t mask, const ShapeInfo& regionShapeInfo, const Transform& regionTransform, uint16_t group = USER_COLLISION_GROUP_DYNAMIC, float threshold = 0.0f) const;
 
+    // cb may be called concurrently from several threads when the world is multithreaded
     void setContactAddedCallback(ContactAddedCallback cb);
 
     btDiscreteDynamicsWorld* getDynamicsWorld() const { return _dynamicsWorld; }
@@ -173,7 +183,10 @@ private:
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
     btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolver* _solverPool = NULL;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
+    BulletTaskScheduler* _taskScheduler = NULL;
+    int _numSimulationThreads { 1 };
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
 
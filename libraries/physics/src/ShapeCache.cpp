@@ -0,0 +1,386 @@
+//
+//  ShapeCache.cpp
+//  libraries/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ShapeCache.h"
+
+#include <cstring>
+
+#include <QtCore/QFile>
+
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+
+#include "PhysicsLogging.h"
+
+const std::string ShapeCache::DIRNAME { "shape_cache" };
+const std::string ShapeCache::EXT { "shape" };
+
+// Whenever a change is made to the format of the cached shapes that isn't backward compatible,
+// this value should be incremented.  Entries with another version are ignored and written again.
+const uint32_t SHAPE_CACHE_VERSION = 1;
+const uint32_t SHAPE_CACHE_MAGIC = 0x48535043; // "CPSH"
+
+// Hulls and meshes with fewer points are cheaper to build than to read back
+const int MIN_CACHED_POINTS = 256;
+
+// btQuantizedBvh::deSerializeInPlace needs an aligned buffer
+const size_t BVH_ALIGNMENT = 16;
+
+enum ShapeNodeType : uint32_t {
+    SHAPE_NODE_HULL = 1,
+    SHAPE_NODE_COMPOUND,
+    SHAPE_NODE_STATIC_MESH
+};
+
+struct ShapeFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t bulletVersion;
+    uint16_t scalarSize;
+    uint16_t pointerSize; // the serialized BVH layout depends on it
+    uint64_t contentHash;
+    uint64_t payloadHash;
+    uint64_t payloadSize;
+    uint64_t reserved;
+};
+static_assert(sizeof(ShapeFileHeader) % BVH_ALIGNMENT == 0, "the payload must start aligned");
+
+static uint64_t hashBytes(const void* data, size_t size, uint64_t hash) {
+    const uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    hash ^= (uint64_t)size * PRIME_1;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(uint64_t));
+        hash ^= word * PRIME_2;
+        hash = ((hash << 31) | (hash >> 33)) * PRIME_1;
+    }
+    for (; i < size; i++) {
+        hash ^= bytes[i] * PRIME_1;
+        hash = ((hash << 11) | (hash >> 53)) * PRIME_2;
+    }
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+template <typename T>
+static uint64_t hashVector(const QVector<T>& data, uint64_t hash) {
+    return hashBytes(data.constData(), data.size() * sizeof(T), hash);
+}
+
+class ShapeWriter {
+public:
+    ShapeWriter(QByteArray& data) : _data(data) {}
+
+    bool writeShape(const btCollisionShape* shape) {
+        switch (shape->getShapeType()) {
+            case CONVEX_HULL_SHAPE_PROXYTYPE: {
+                const btConvexHullShape* hull = static_cast<const btConvexHullShape*>(shape);
+                write<uint32_t>(SHAPE_NODE_HULL);
+                write<uint32_t>((uint32_t)hull->getNumPoints());
+                write<float>(hull->getMargin());
+                const btVector3* points = hull->getUnscaledPoints();
+                for (int i = 0; i < hull->getNumPoints(); ++i) {
+                    writeVector(points[i]);
+                }
+                return true;
+            }
+            case COMPOUND_SHAPE_PROXYTYPE: {
+                const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+                write<uint32_t>(SHAPE_NODE_COMPOUND);
+                write<uint32_t>((uint32_t)compound->getNumChildShapes());
+                for (int i = 0; i < compound->getNumChildShapes(); ++i) {
+                    const btTransform& transform = compound->getChildTransform(i);
+                    for (int row = 0; row < 3; ++row) {
+                        writeVector(transform.getBasis()[row]);
+                    }
+                    writeVector(transform.getOrigin());
+                    if (!writeShape(compound->getChildShape(i))) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            case TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+                // getOptimizedBvh() isn't const, but we only read from it
+                auto meshShape = const_cast<btBvhTriangleMeshShape*>(static_cast<const btBvhTriangleMeshShape*>(shape));
+                btOptimizedBvh* bvh = meshShape->getOptimizedBvh();
+                if (!bvh) {
+                    return false;
+                }
+                uint32_t bvhSize = bvh->calculateSerializeBufferSize();
+                write<uint32_t>(SHAPE_NODE_STATIC_MESH);
+                write<uint32_t>(bvhSize);
+                align();
+
+                void* buffer = btAlignedAlloc(bvhSize, BVH_ALIGNMENT);
+                bool success = bvh->serializeInPlace(buffer, bvhSize, false);
+                if (success) {
+                    _data.append(static_cast<const char*>(buffer), bvhSize);
+                }
+                btAlignedFree(buffer);
+                return success;
+            }
+            default:
+                return false;
+        }
+    }
+
+private:
+    template <typename T>
+    void write(T value) {
+        _data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void writeVector(const btVector3& vector) {
+        write<float>(vector.getX());
+        write<float>(vector.getY());
+        write<float>(vector.getZ());
+    }
+
+    void align() {
+        while (_data.size() % BVH_ALIGNMENT != 0) {
+            _data.append('\0');
+        }
+    }
+
+    QByteArray& _data;
+};
+
+// Holds the mapping of a cached file, and keeps the file from being evicted while it is mapped
+class MappedShapeFile {
+public:
+    MappedShapeFile(const cache::FilePointer& file) : _file(file), _qFile(QString::fromStdString(file->getFilepath())) {
+        if (_qFile.open(QIODevice::ReadOnly)) {
+            // private, as the BVH is fixed up in place
+            _data = _qFile.map(0, (qint64)file->getLength(), QFileDevice::MapPrivateOption);
+        }
+    }
+
+    ~MappedShapeFile() {
+        if (_data) {
+            _qFile.unmap(_data);
+        }
+    }
+
+    uchar* getData() const { return _data; }
+    size_t getLength() const { return _file->getLength(); }
+
+private:
+    cache::FilePointer _file;
+    QFile _qFile;
+    uchar* _data { nullptr };
+};
+
+class ShapeReader {
+public:
+    ShapeReader(const std::shared_ptr<MappedShapeFile>& mapping, size_t offset) :
+        _mapping(mapping), _data(reinterpret_cast<char*>(mapping->getData())), _size(mapping->getLength()), _offset(offset) {}
+
+    bool atEnd() const { return _offset == _size; }
+
+    btCollisionShape* readShape(const ShapeInfo& info) {
+        uint32_t type;
+        if (!read(type)) {
+            return nullptr;
+        }
+        switch (type) {
+            case SHAPE_NODE_HULL: {
+                uint32_t numPoints;
+                float margin;
+                if (!read(numPoints) || !read(margin) || numPoints == 0 || numPoints > (_size - _offset) / (3 * sizeof(float))) {
+                    return nullptr;
+                }
+                btConvexHullShape* hull = new btConvexHullShape();
+                for (uint32_t i = 0; i < numPoints; ++i) {
+                    btVector3 point;
+                    readVector(point);
+                    hull->addPoint(point, false);
+                }
+                hull->setMargin(margin);
+                hull->recalcLocalAabb();
+                return hull;
+            }
+            case SHAPE_NODE_COMPOUND: {
+                uint32_t numChildren;
+                if (!read(numChildren)) {
+                    return nullptr;
+                }
+                auto compound = new btCompoundShape();
+                for (uint32_t i = 0; i < numChildren; ++i) {
+                    btVector3 rows[3];
+                    btVector3 origin;
+                    btCollisionShape* child = nullptr;
+                    if (readVector(rows[0]) && readVector(rows[1]) && readVector(rows[2]) && readVector(origin)) {
+                        child = readShape(info);
+                    }
+                    if (!child) {
+                        ShapeFactory::deleteShape(compound);
+                        return nullptr;
+                    }
+                    btTransform transform(btMatrix3x3(rows[0].getX(), rows[0].getY(), rows[0].getZ(),
+                                                      rows[1].getX(), rows[1].getY(), rows[1].getZ(),
+                                                      rows[2].getX(), rows[2].getY(), rows[2].getZ()), origin);
+                    compound->addChildShape(transform, child);
+                }
+                return compound;
+            }
+            case SHAPE_NODE_STATIC_MESH: {
+                uint32_t bvhSize;
+                if (!read(bvhSize)) {
+                    return nullptr;
+                }
+                _offset = (_offset + BVH_ALIGNMENT - 1) & ~(BVH_ALIGNMENT - 1);
+                if (_offset > _size || bvhSize > _size - _offset) {
+                    return nullptr;
+                }
+                btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(_data + _offset, bvhSize, false);
+                _offset += bvhSize;
+                if (!bvh) {
+                    return nullptr;
+                }
+                // the shape keeps the mapping alive, since its BVH lives there
+                return const_cast<btCollisionShape*>(ShapeFactory::createStaticMeshShape(info, bvh, _mapping));
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+private:
+    template <typename T>
+    bool read(T& value) {
+        if (sizeof(T) > _size - _offset) {
+            _offset = _size;
+            return false;
+        }
+        memcpy(&value, _data + _offset, sizeof(T));
+        _offset += sizeof(T);
+        return true;
+    }
+
+    bool readVector(btVector3& vector) {
+        float x, y, z;
+        if (!read(x) || !read(y) || !read(z)) {
+            return false;
+        }
+        vector.setValue(x, y, z);
+        return true;
+    }
+
+    std::shared_ptr<MappedShapeFile> _mapping;
+    char* _data;
+    size_t _size;
+    size_t _offset;
+};
+
+ShapeCache::ShapeCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) { }
+
+bool ShapeCache::shouldCache(const ShapeInfo& info) {
+    switch (info.getType()) {
+        case SHAPE_TYPE_SIMPLE_HULL:
+        case SHAPE_TYPE_COMPOUND:
+        case SHAPE_TYPE_SIMPLE_COMPOUND:
+        case SHAPE_TYPE_STATIC_MESH: {
+            int numPoints = 0;
+            for (const auto& points : info.getPointCollection()) {
+                numPoints += points.size();
+            }
+            return numPoints >= MIN_CACHED_POINTS;
+        }
+        default:
+            return false;
+    }
+}
+
+ShapeCache::Key ShapeCache::computeKey(const ShapeInfo& info, uint64_t& contentHash) {
+    uint8_t type = info.getType();
+    uint64_t hash = hashBytes(&type, sizeof(type), 0);
+    hash = hashBytes(&info.getHalfExtents(), sizeof(glm::vec3), hash);
+    hash = hashBytes(&info.getOffset(), sizeof(glm::vec3), hash);
+    for (const auto& points : info.getPointCollection()) {
+        hash = hashVector(points, hash);
+    }
+    hash = hashVector(info.getTriangleIndices(), hash);
+    hash = hashVector(info.getSphereCollection(), hash);
+    contentHash = hash;
+    return QString::number((qulonglong)hash, 16).rightJustified(16, '0').toStdString();
+}
+
+const btCollisionShape* ShapeCache::loadShape(const ShapeInfo& info) {
+    uint64_t contentHash;
+    Key key = computeKey(info, contentHash);
+    auto file = getFile(key);
+    if (!file) {
+        _numMisses++;
+        return nullptr;
+    }
+
+    auto mapping = std::make_shared<MappedShapeFile>(file);
+    const uchar* data = mapping->getData();
+    size_t length = mapping->getLength();
+    ShapeFileHeader header;
+    if (!data || length < sizeof(ShapeFileHeader)) {
+        _numMisses++;
+        return nullptr;
+    }
+    memcpy(&header, data, sizeof(ShapeFileHeader));
+    if (header.magic != SHAPE_CACHE_MAGIC || header.version != SHAPE_CACHE_VERSION ||
+            header.bulletVersion != BT_BULLET_VERSION || header.scalarSize != sizeof(btScalar) ||
+            header.pointerSize != sizeof(void*) || header.contentHash != contentHash ||
+            header.payloadSize != length - sizeof(ShapeFileHeader) ||
+            header.payloadHash != hashBytes(data + sizeof(ShapeFileHeader), header.payloadSize, 0)) {
+        qCDebug(physics) << "ShapeCache: ignoring stale entry" << key.c_str();
+        _numMisses++;
+        return nullptr;
+    }
+
+    ShapeReader reader(mapping, sizeof(ShapeFileHeader));
+    btCollisionShape* shape = reader.readShape(info);
+    if (shape && !reader.atEnd()) {
+        ShapeFactory::deleteShape(shape);
+        shape = nullptr;
+    }
+    if (!shape) {
+        qCWarning(physics) << "ShapeCache: ignoring damaged entry" << key.c_str();
+        _numMisses++;
+        return nullptr;
+    }
+    _numHits++;
+    return shape;
+}
+
+void ShapeCache::storeShape(const ShapeInfo& info, const btCollisionShape* shape) {
+    QByteArray data(sizeof(ShapeFileHeader), '\0');
+    ShapeWriter writer(data);
+    if (!writer.writeShape(shape)) {
+        return;
+    }
+
+    ShapeFileHeader header;
+    header.magic = SHAPE_CACHE_MAGIC;
+    header.version = SHAPE_CACHE_VERSION;
+    header.bulletVersion = BT_BULLET_VERSION;
+    header.scalarSize = sizeof(btScalar);
+    header.pointerSize = sizeof(void*);
+    Key key = computeKey(info, header.contentHash);
+    header.payloadSize = data.size() - sizeof(ShapeFileHeader);
+    header.payloadHash = hashBytes(data.constData() + sizeof(ShapeFileHeader), header.payloadSize, 0);
+    header.reserved = 0;
+    memcpy(data.data(), &header, sizeof(ShapeFileHeader));
+
+    // overwrite stale entries
+    writeFile(data.constData(), Metadata(key, data.size()), true);
+}
@@ -0,0 +1,60 @@
+//
+//  ShapeCache.h
+//  libraries/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_ShapeCache_h
+#define hifi_ShapeCache_h
+
+#include <atomic>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <shared/FileCache.h>
+#include <ShapeInfo.h>
+
+#include "ShapeFactory.h"
+
+/// Keeps cooked collision shapes on disk so that they don't have to be built again the next time they are needed.
+///
+/// Only the shapes that are expensive to build are kept: convex hulls, compounds of hulls and static triangle meshes
+/// with their quantized BVH. Entries are addressed by a hash of the full content of the ShapeInfo they were built from
+/// (unlike ShapeInfo::getHash, which only covers part of it), and carry a checksum and the Bullet version and layout
+/// they were written with, so stale or damaged entries are ignored and written again.
+///
+/// Files are memory mapped when read. The BVH of a static mesh is used in place from the mapping, which lives as long
+/// as the shape does.
+///
+/// All methods are thread safe.
+class ShapeCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    static const std::string DIRNAME;
+    static const std::string EXT;
+
+    ShapeCache(const std::string& dir = DIRNAME, const std::string& ext = EXT);
+
+    static bool shouldCache(const ShapeInfo& info);
+
+    /// @return the shape that was cached for info, or nullptr if there is none or it can't be used
+    const btCollisionShape* loadShape(const ShapeInfo& info);
+    void storeShape(const ShapeInfo& info, const btCollisionShape* shape);
+
+    uint64_t getNumHits() const { return _numHits; }
+    uint64_t getNumMisses() const { return _numMisses; }
+
+private:
+    static Key computeKey(const ShapeInfo& info, uint64_t& contentHash);
+
+    std::atomic<uint64_t> _numHits { 0 };
+    std::atomic<uint64_t> _numMisses { 0 };
+};
+
+#endif // hifi_ShapeCache_h
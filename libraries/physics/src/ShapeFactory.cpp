@@ -11,11 +11,15 @@
 
 #include "ShapeFactory.h"
 
+#include <algorithm>
+
 #include <glm/gtx/norm.hpp>
+#include <tbb/parallel_for.h>
 
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
+#include "ShapeCache.h"
 
 
 class StaticMeshShape : public btBvhTriangleMeshShape {
@@ -27,6 +31,13 @@ public:
         assert(_dataArray);
     }
 
+    // the bvh was built earlier and lives in bvhStorage, which is kept for as long as the shape
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, btOptimizedBvh* bvh, const std::shared_ptr<void>& bvhStorage)
+    :   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _bvhStorage(bvhStorage) {
+        assert(_dataArray);
+        setOptimizedBvh(bvh);
+    }
+
     ~StaticMeshShape() {
         assert(_dataArray);
         IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
@@ -47,6 +58,7 @@ public:
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    std::shared_ptr<void> _bvhStorage;
 };
 
 // the dataArray must be created before we create the StaticMeshShape
@@ -198,6 +210,16 @@ btConvexHullShape* createConvexHull(const ShapeInfo::PointList& points) {
     return hull;
 }
 
+// util method: builds the hulls in parallel, and leaves out those that failed
+std::vector<btConvexHullShape*> createConvexHulls(const ShapeInfo::PointCollection& pointCollection) {
+    std::vector<btConvexHullShape*> hulls(pointCollection.size(), nullptr);
+    tbb::parallel_for(0, (int)pointCollection.size(), [&](int i) {
+        hulls[i] = createConvexHull(pointCollection[i]);
+    });
+    hulls.erase(std::remove(hulls.begin(), hulls.end(), nullptr), hulls.end());
+    return hulls;
+}
+
 // util method
 btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     assert(info.getType() == SHAPE_TYPE_STATIC_MESH); // should only get here for mesh shapes
@@ -270,7 +292,7 @@ btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     return dataArray;
 }
 
-const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+static const btCollisionShape* buildShapeFromInfo(const ShapeInfo& info) {
     btCollisionShape* shape = nullptr;
     int type = info.getType();
     switch(type) {
@@ -364,8 +386,7 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
                 auto compound = new btCompoundShape();
                 btTransform trans;
                 trans.setIdentity();
-                foreach (const ShapeInfo::PointList& hullPoints, pointCollection) {
-                    btConvexHullShape* hull = createConvexHull(hullPoints);
+                for (btConvexHullShape* hull : createConvexHulls(pointCollection)) {
                     compound->addChildShape(trans, hull);
                 }
                 shape = compound;
@@ -380,9 +401,9 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
             const uint32_t MIN_NUM_SIMPLE_COMPOUND_INDICES = 2; // END_OF_MESH_PART + END_OF_MESH
             if (numMeshes > 0 && numIndices > MIN_NUM_SIMPLE_COMPOUND_INDICES) {
                 uint32_t i = 0;
-                std::vector<btConvexHullShape*> hulls;
+                ShapeInfo::PointCollection partPoints;
                 for (auto& points : pointCollection) {
-                    // build a hull around each part
+                    // gather the points of each part
                     while (i < numIndices) {
                         ShapeInfo::PointList hullPoints;
                         hullPoints.reserve(points.size());
@@ -396,8 +417,7 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
                             hullPoints.push_back(points[j]);
                         }
                         if (hullPoints.size() > 0) {
-                            btConvexHullShape* hull = createConvexHull(hullPoints);
-                            hulls.push_back(hull);
+                            partPoints.push_back(hullPoints);
                         }
 
                         assert(i < numIndices);
@@ -408,6 +428,8 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
                         }
                     }
                 }
+                // build a hull around each part
+                std::vector<btConvexHullShape*> hulls = createConvexHulls(partPoints);
                 uint32_t numHulls = (uint32_t)hulls.size();
                 if (numHulls == 1) {
                     shape = hulls[0];
@@ -462,6 +484,30 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
     return shape;
 }
 
+const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info, const ShapeCachePointer& shapeCache) {
+    bool useCache = shapeCache && ShapeCache::shouldCache(info);
+    if (useCache) {
+        const btCollisionShape* shape = shapeCache->loadShape(info);
+        if (shape) {
+            return shape;
+        }
+    }
+    const btCollisionShape* shape = buildShapeFromInfo(info);
+    if (shape && useCache) {
+        shapeCache->storeShape(info, shape);
+    }
+    return shape;
+}
+
+const btCollisionShape* ShapeFactory::createStaticMeshShape(const ShapeInfo& info, btOptimizedBvh* bvh,
+                                                            const std::shared_ptr<void>& bvhStorage) {
+    btTriangleIndexVertexArray* dataArray = createStaticMeshArray(info);
+    if (!dataArray) {
+        return nullptr;
+    }
+    return new StaticMeshShape(dataArray, bvh, bvhStorage);
+}
+
 void ShapeFactory::deleteShape(const btCollisionShape* shape) {
     assert(shape);
     // ShapeFactory is responsible for deleting all shapes, even the const ones that are stored
@@ -484,6 +530,6 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
 }
 
 void ShapeFactory::Worker::run() {
-    shape = ShapeFactory::createShapeFromInfo(shapeInfo);
+    shape = ShapeFactory::createShapeFromInfo(shapeInfo, shapeCache);
     emit submitWork(this);
 }
@@ -12,6 +12,8 @@
 #ifndef hifi_ShapeFactory_h
 #define hifi_ShapeFactory_h
 
+#include <memory>
+
 #include <btBulletDynamicsCommon.h>
 #include <glm/glm.hpp>
 #include <QObject>
@@ -19,10 +21,17 @@
 
 #include <ShapeInfo.h>
 
+class ShapeCache;
+using ShapeCachePointer = std::shared_ptr<ShapeCache>;
+
 // The ShapeFactory assembles and correctly disassembles btCollisionShapes.
 
 namespace ShapeFactory {
-    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
+    /// When a shapeCache is given, cooked shapes are read from it when possible and written to it otherwise
+    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info, const ShapeCachePointer& shapeCache = ShapeCachePointer());
+    /// Creates a static mesh shape around a BVH that was built earlier, which lives in bvhStorage
+    const btCollisionShape* createStaticMeshShape(const ShapeInfo& info, btOptimizedBvh* bvh,
+                                                  const std::shared_ptr<void>& bvhStorage);
     void deleteShape(const btCollisionShape* shape);
 
     class Worker : public QObject, public QRunnable {
@@ -31,6 +40,7 @@ namespace ShapeFactory {
         Worker(const ShapeInfo& info) : shapeInfo(info), shape(nullptr) {}
         void run() override;
         ShapeInfo shapeInfo;
+        ShapeCachePointer shapeCache;
         const btCollisionShape* shape;
     signals:
         void submitWork(Worker*);
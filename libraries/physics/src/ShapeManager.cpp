@@ -11,16 +11,25 @@
 
 #include "ShapeManager.h"
 
+#include <algorithm>
+#include <functional>
+
 #include <glm/gtx/norm.hpp>
+#include <QThread>
 #include <QThreadPool>
 
 #include <NumericalConstants.h>
 
 const int MAX_RING_SIZE = 256;
 
+// hulls with fewer points are cooked faster than the round trip through a worker
+const int MIN_NUM_POINTS_TO_COOK_ASYNC = 256;
+
 ShapeManager::ShapeManager() {
     _garbageRing.reserve(MAX_RING_SIZE);
     _nextOrphanExpiry = std::chrono::steady_clock::now();
+    // leave a core for the thread that simulates physics
+    _maxNumWorkers = (uint32_t)std::max(1, QThread::idealThreadCount() - 1);
 }
 
 ShapeManager::~ShapeManager() {
@@ -30,13 +39,39 @@ ShapeManager::~ShapeManager() {
         ShapeFactory::deleteShape(shapeRef->shape);
     }
     _shapeMap.clear();
-    if (_deadWorker) {
-        delete _deadWorker;
-        _deadWorker = nullptr;
+    for (auto worker : _deadWorkers) {
+        delete worker;
     }
+    _deadWorkers.clear();
 }
 
 const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
+    return getOrCookShape(info, info.getType() == SHAPE_TYPE_STATIC_MESH, 0.0f);
+}
+
+const btCollisionShape* ShapeManager::requestShape(const ShapeInfo& info, float priority) {
+    return getOrCookShape(info, shouldCookAsync(info), priority);
+}
+
+bool ShapeManager::shouldCookAsync(const ShapeInfo& info) {
+    switch (info.getType()) {
+        case SHAPE_TYPE_STATIC_MESH:
+            return true;
+        case SHAPE_TYPE_COMPOUND:
+        case SHAPE_TYPE_SIMPLE_HULL:
+        case SHAPE_TYPE_SIMPLE_COMPOUND: {
+            int numPoints = 0;
+            for (const auto& points : info.getPointCollection()) {
+                numPoints += points.size();
+            }
+            return numPoints >= MIN_NUM_POINTS_TO_COOK_ASYNC;
+        }
+        default:
+            return false;
+    }
+}
+
+const btCollisionShape* ShapeManager::getOrCookShape(const ShapeInfo& info, bool cookAsync, float priority) {
     if (info.getType() == SHAPE_TYPE_NONE) {
         return nullptr;
     }
@@ -47,33 +82,23 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         return shapeRef->shape;
     }
     const btCollisionShape* shape = nullptr;
-    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+    if (cookAsync) {
         uint64_t hash = info.getHash();
 
         // bump the request count to the caller knows we're 
         // starting or waiting on a thread.
         ++_workRequestCount;
 
-        const auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), hash);
-        if (itr == _pendingMeshShapes.end()) {
-            // start a worker
-            _pendingMeshShapes.push_back(hash);
-            // try to recycle old deadWorker
-            ShapeFactory::Worker* worker = _deadWorker;
-            if (!worker) {
-                worker = new ShapeFactory::Worker(info);
-            } else {
-                worker->shapeInfo = info;
-                _deadWorker = nullptr;
-            }
-            // we will delete worker manually later
-            worker->setAutoDelete(false);
-            QObject::connect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
-            QThreadPool::globalInstance()->start(worker);
+        const auto itr = std::find(_pendingShapes.begin(), _pendingShapes.end(), hash);
+        if (itr == _pendingShapes.end()) {
+            queueShape(info, priority);
+            dispatchWork();
         }
         // else we're still waiting for the shape to be created on another thread
     } else {
-        shape = ShapeFactory::createShapeFromInfo(info);
+        // a worker may already be cooking this shape: acceptWork() drops its copy, and a queued one is no longer needed
+        _queuedShapes.erase(info.getHash());
+        shape = ShapeFactory::createShapeFromInfo(info, _shapeCache);
         if (shape) {
             ShapeReference newRef;
             newRef.refCount = 1;
@@ -85,6 +110,64 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
     return shape;
 }
 
+void ShapeManager::queueShape(const ShapeInfo& info, float priority) {
+    uint64_t hash = info.getHash();
+    auto queuedItr = _queuedShapes.find(hash);
+    if (queuedItr == _queuedShapes.end()) {
+        _queuedShapes.emplace(hash, QueuedShape(info, priority));
+    } else if (priority != queuedItr->second.priority) {
+        // the viewer has moved since it was queued
+        queuedItr->second.priority = priority;
+    } else {
+        return;
+    }
+
+    // rebuild the heap once the entries left behind outnumber the live ones
+    const size_t MIN_HEAP_SIZE_TO_REBUILD = 64;
+    if (_queuedHeap.size() >= MIN_HEAP_SIZE_TO_REBUILD && _queuedHeap.size() > 2 * _queuedShapes.size()) {
+        _queuedHeap.clear();
+        for (const auto& queued : _queuedShapes) {
+            _queuedHeap.emplace_back(queued.second.priority, queued.first);
+        }
+        std::make_heap(_queuedHeap.begin(), _queuedHeap.end(), std::greater<std::pair<float, uint64_t>>());
+    } else {
+        _queuedHeap.emplace_back(priority, hash);
+        std::push_heap(_queuedHeap.begin(), _queuedHeap.end(), std::greater<std::pair<float, uint64_t>>());
+    }
+}
+
+void ShapeManager::dispatchWork() {
+    while (_pendingShapes.size() < _maxNumWorkers && !_queuedHeap.empty()) {
+        std::pop_heap(_queuedHeap.begin(), _queuedHeap.end(), std::greater<std::pair<float, uint64_t>>());
+        auto next = _queuedHeap.back();
+        _queuedHeap.pop_back();
+
+        auto nextItr = _queuedShapes.find(next.second);
+        if (nextItr == _queuedShapes.end() || nextItr->second.priority != next.first) {
+            // dequeued, or re-prioritized since
+            continue;
+        }
+
+        // start a worker
+        _pendingShapes.push_back(nextItr->first);
+        // try to recycle old deadWorker
+        ShapeFactory::Worker* worker = nullptr;
+        if (_deadWorkers.empty()) {
+            worker = new ShapeFactory::Worker(nextItr->second.info);
+        } else {
+            worker = _deadWorkers.back();
+            _deadWorkers.pop_back();
+            worker->shapeInfo = nextItr->second.info;
+        }
+        _queuedShapes.erase(nextItr);
+        worker->shapeCache = _shapeCache;
+        // we will delete worker manually later
+        worker->setAutoDelete(false);
+        QObject::connect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
+        QThreadPool::globalInstance()->start(worker);
+    }
+}
+
 const btCollisionShape* ShapeManager::getShapeByKey(uint64_t key) {
     HashKey hashKey(key);
     ShapeReference* shapeRef = _shapeMap.find(hashKey);
@@ -208,8 +291,8 @@ bool ShapeManager::hasShape(const btCollisionShape* shape) const {
 
 // slot: called when ShapeFactory::Worker is done building shape
 void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
-    auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), worker->shapeInfo.getHash());
-    if (itr == _pendingMeshShapes.end()) {
+    auto itr = std::find(_pendingShapes.begin(), _pendingShapes.end(), worker->shapeInfo.getHash());
+    if (itr == _pendingShapes.end()) {
         // we've received a shape but don't remember asking for it
         // (should not fall in here, but if we do: delete the unwanted shape)
         if (worker->shape) {
@@ -217,17 +300,20 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
         }
     } else {
         // clear pending status
-        *itr = _pendingMeshShapes.back();
-        _pendingMeshShapes.pop_back();
+        *itr = _pendingShapes.back();
+        _pendingShapes.pop_back();
 
-        // cache the new shape
-        if (worker->shape) {
+        HashKey hashKey(worker->shapeInfo.getHash());
+        if (worker->shape && _shapeMap.find(hashKey)) {
+            // getShape() built it while the worker was busy, and objects may already hold that one
+            ShapeFactory::deleteShape(worker->shape);
+        } else if (worker->shape) {
+            // cache the new shape
             ShapeReference newRef;
             // refCount is zero because nothing is using the shape yet
             newRef.refCount = 0;
             newRef.shape = worker->shape;
             newRef.key = worker->shapeInfo.getHash();
-            HashKey hashKey(newRef.key);
             _shapeMap.insert(hashKey, newRef);
 
             // This shape's refCount is zero because an object requested it but is not yet using it.  We expect it to be
@@ -270,13 +356,17 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
     }
     disconnect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
 
-    if (_deadWorker) {
-        // delete the previous deadWorker manually
-        delete _deadWorker;
-    }
     // save this dead worker for later
     worker->shapeInfo.clear();
+    worker->shapeCache.reset();
     worker->shape = nullptr;
-    _deadWorker = worker;
+    if (_deadWorkers.size() < _maxNumWorkers) {
+        _deadWorkers.push_back(worker);
+    } else {
+        worker->deleteLater();
+    }
     ++_workDeliveryCount;
+
+    // hand the next queued shape to a worker
+    dispatchWork();
 }
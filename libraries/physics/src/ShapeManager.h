@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <unordered_map>
 #include <vector>
 
 #include <QObject>
@@ -41,6 +42,13 @@
 // and returns the pointer.  If not it asks the ShapeFactory to create it, adds an
 // entry in the map with a ref-count of 1, and returns the pointer.
 //
+// Shapes that are expensive to cook (static meshes, and hulls with many points when
+// requested with requestShape()) are built on worker threads instead: the request
+// returns nullptr, bumps the work request count, and the shape can be fetched by key
+// once the work delivery count changes.  Requests for a shape that is already queued
+// or being cooked are merged, and queued shapes are handed to the workers by priority
+// (smaller first, as of their latest request), with at most one worker per spare core.
+//
 // When a body stops using a shape the ShapeManager must be informed so it can
 // decrement its ref-count.  When a ref-count drops to zero the ShapeManager
 // doesn't delete it right away.  Instead it puts the shape's key on a list delete
@@ -55,8 +63,15 @@ public:
     ShapeManager();
     ~ShapeManager();
 
-    /// \return pointer to shape
+    /// Cooked shapes are read from and written to shapeCache, when set
+    void setShapeCache(const ShapeCachePointer& shapeCache) { _shapeCache = shapeCache; }
+
+    /// \return pointer to shape, or nullptr if it is a static mesh that is being cooked on another thread
     const btCollisionShape* getShape(const ShapeInfo& info);
+    /// \return pointer to shape, or nullptr if it is being cooked on another thread
+    /// \param priority shapes with a smaller priority are cooked first, e.g. the distance to the viewer
+    const btCollisionShape* requestShape(const ShapeInfo& info, float priority);
+    static bool shouldCookAsync(const ShapeInfo& info);
     const btCollisionShape* getShapeByKey(uint64_t key);
     bool hasShapeWithKey(uint64_t key) const;
 
@@ -78,9 +93,19 @@ protected slots:
     void acceptWork(ShapeFactory::Worker* worker);
 
 private:
+    const btCollisionShape* getOrCookShape(const ShapeInfo& info, bool cookAsync, float priority);
+    void queueShape(const ShapeInfo& info, float priority);
+    void dispatchWork();
     void addToGarbage(uint64_t key);
     bool releaseShapeByKey(uint64_t key);
 
+    class QueuedShape {
+    public:
+        QueuedShape(const ShapeInfo& i, float p) : info(i), priority(p) {}
+        ShapeInfo info;
+        float priority;
+    };
+
     class ShapeReference {
     public:
         int refCount;
@@ -100,9 +125,15 @@ private:
     // btHashMap is required because it supports memory alignment of the btCollisionShapes
     btHashMap<HashKey, ShapeReference> _shapeMap;
     std::vector<uint64_t> _garbageRing;
-    std::vector<uint64_t> _pendingMeshShapes;
+    std::unordered_map<uint64_t, QueuedShape> _queuedShapes; // waiting for a worker
+    // min-heap of (priority, key) over _queuedShapes; entries left behind when a shape is dequeued or re-prioritized
+    // are skipped as they come up
+    std::vector<std::pair<float, uint64_t>> _queuedHeap;
+    std::vector<uint64_t> _pendingShapes; // being cooked
     std::vector<KeyExpiry> _orphans;
-    ShapeFactory::Worker* _deadWorker { nullptr };
+    std::vector<ShapeFactory::Worker*> _deadWorkers;
+    uint32_t _maxNumWorkers { 1 };
+    ShapeCachePointer _shapeCache;
     TimePoint _nextOrphanExpiry;
     uint32_t _ringIndex { 0 };
     std::atomic_uint _workRequestCount { 0 };
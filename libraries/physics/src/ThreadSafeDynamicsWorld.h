@@ -20,6 +20,9 @@
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#ifdef HIFI_BULLET_MULTITHREADING
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#endif
 
 #include "ObjectMotionState.h"
 
@@ -27,15 +30,34 @@
 
 using SubStepCallback = std::function<void()>;
 
-ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorld {
+// When Bullet is built with BULLET2_MULTITHREADING the world derives from btDiscreteDynamicsWorldMt, which runs
+// narrowphase, integration and per-island constraint solving through the task scheduler (see BulletTaskScheduler).
+// Substeps are still driven from here, one at a time, so the substep callback semantics are the same for both.
+#ifdef HIFI_BULLET_MULTITHREADING
+using DynamicsWorldBase = btDiscreteDynamicsWorldMt;
+#else
+using DynamicsWorldBase = btDiscreteDynamicsWorld;
+#endif
+
+ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public DynamicsWorldBase {
 public:
     BT_DECLARE_ALIGNED_ALLOCATOR();
 
+#ifdef HIFI_BULLET_MULTITHREADING
+    // solverPool solves small islands concurrently, constraintSolverMt (may be NULL) solves large islands on its own
+    ThreadSafeDynamicsWorld(
+            btDispatcher* dispatcher,
+            btBroadphaseInterface* pairCache,
+            btConstraintSolverPoolMt* solverPool,
+            btConstraintSolver* constraintSolverMt,
+            btCollisionConfiguration* collisionConfiguration);
+#else
     ThreadSafeDynamicsWorld(
             btDispatcher* dispatcher,
             btBroadphaseInterface* pairCache,
             btConstraintSolver* constraintSolver,
             btCollisionConfiguration* collisionConfiguration);
+#endif
 
     int getNumSubsteps() const { return _numSubsteps; }
     int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps = 1,
@@ -16,6 +16,17 @@ class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // whether the last frame encoded carries nothing worth sending (an Opus DTX frame or comfort noise update, for instance);
+    // senders may send a SilentAudioFrame in its place
+    virtual bool isLastFrameSilent() const { return false; }
+
+    // the bitrate the connection the frames are sent over can carry; ignored by codecs with a fixed bitrate
+    virtual void setBitrate(int bitrate) { }
+
+    // whether the codec may stop sending frames through pauses, leaving the receiver to fill them in (Opus DTX, for
+    // instance); ignored by codecs without it
+    virtual void setDTX(int dtx) { }
 };
 
 class Decoder {
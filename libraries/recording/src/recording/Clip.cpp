@@ -13,12 +13,10 @@
 
 #include "impl/FileClip.h"
 #include "impl/BufferClip.h"
+#include "impl/ClipWriter.h"
 
-#include <QtCore/QJsonDocument>
-#include <QtCore/QJsonObject>
 #include <QtCore/QBuffer>
 #include <QtCore/QDebug>
-#include "WarningsSuppression.h"
 
 using namespace recording;
 
@@ -55,71 +53,21 @@ float Clip::position() const {
     return Frame::frameTimeToSeconds(positionFrameTime());
 }
 
-// FIXME move to frame?
-bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
-    if (frame.type == Frame::TYPE_INVALID) {
-        qWarning() << "Attempting to write invalid frame";
-        return true;
-    }
-
-    auto written = output.write((char*)&(frame.type), sizeof(FrameType));
-    if (written != sizeof(FrameType)) {
-        return false;
-    }
-    //qDebug(recordingLog) << "Writing frame with time offset " << frame.timeOffset;
-    written = output.write((char*)&(frame.timeOffset), sizeof(Frame::Time));
-    if (written != sizeof(Frame::Time)) {
-        return false;
-    }
-    QByteArray frameData = frame.data;
-    if (compressed) {
-        frameData = qCompress(frameData);
-    }
-
-    uint16_t dataSize = frameData.size();
-    written = output.write((char*)&dataSize, sizeof(FrameSize));
-    if (written != sizeof(uint16_t)) {
-        return false;
-    }
-
-    if (dataSize != 0) {
-        written = output.write(frameData);
-        if (written != dataSize) {
-            return false;
-        }
-    }
-    return true;
-}
-
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
 
 bool Clip::write(QIODevice& output) {
-    auto frameTypes = Frame::getFrameTypes();
-    QJsonObject frameTypeObj;
-    for (const auto& frameTypeName : frameTypes.keys()) {
-        frameTypeObj[frameTypeName] = frameTypes[frameTypeName];
-    }
-
-    QJsonObject rootObject;
-    rootObject.insert(FRAME_TYPE_MAP, frameTypeObj);
-    // Always mark new files as compressed
-    rootObject.insert(FRAME_COMREPSSION_FLAG, true);
-    OVERTE_IGNORE_DEPRECATED_BEGIN
-    // Can't use CBOR yet, will break the protocol.
-    QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
-    OVERTE_IGNORE_DEPRECATED_END
-    // Never compress the header frame
-    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
+    ClipWriter writer(output);
+    if (!writer.writeHeader()) {
         return false;
     }
 
     seek(0);
 
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
+        if (!writer.writeFrame(*frame)) {
             return false;
         }
     }
-    return true;
+    return writer.writeIndex();
 }
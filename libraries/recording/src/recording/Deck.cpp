@@ -8,6 +8,8 @@
 
 #include "Deck.h"
  
+#include <algorithm>
+
 #include <QtCore/QThread>
 
 #include <NumericalConstants.h>
@@ -85,6 +87,7 @@ void Deck::seek(float position) {
 
     // reset the clips to the appropriate spot
     for (auto& clip : _clips) {
+        replayFromKeyframes(clip, _position);
         clip->seekFrameTime(_position);
     }
 
@@ -94,6 +97,61 @@ void Deck::seek(float position) {
     }
 }
 
+// How far back to look for keyframes first, doubled until every type that needs one has one
+static const Frame::Time KEYFRAME_LOOKBACK = Frame::secondsToFrameTime(1.0f);
+
+void Deck::replayFromKeyframes(const ClipPointer& clip, Frame::Time position) {
+    if (position == 0 || !Frame::hasKeyframeTests()) {
+        return;
+    }
+
+    // Find the last keyframe before the position of every type with a keyframe test
+    QMap<FrameType, Frame::KeyframeTest> keyframeTests;
+    QMap<FrameType, Frame::Time> lastKeyframes;
+    Frame::Time lookback = KEYFRAME_LOOKBACK;
+    Frame::Time start;
+    while (true) {
+        start = position > lookback ? position - lookback : 0;
+        clip->seekFrameTime(start);
+        for (auto frame = clip->nextFrame(); frame && frame->timeOffset < position; frame = clip->nextFrame()) {
+            if (!keyframeTests.contains(frame->type)) {
+                keyframeTests.insert(frame->type, Frame::getKeyframeTest(frame->type));
+            }
+            const auto& keyframeTest = keyframeTests[frame->type];
+            if (keyframeTest && keyframeTest(frame->data)) {
+                lastKeyframes[frame->type] = frame->timeOffset;
+            }
+        }
+
+        bool foundAll = true;
+        for (auto itr = keyframeTests.cbegin(); itr != keyframeTests.cend(); ++itr) {
+            if (itr.value() && !lastKeyframes.contains(itr.key())) {
+                foundAll = false;
+            }
+        }
+        if (foundAll || start == 0) {
+            break;
+        }
+        lookback *= 2;
+    }
+    if (lastKeyframes.empty()) {
+        return;
+    }
+
+    // Then hand those frames to their handlers from there, leaving out the types that don't need it
+    Frame::Time replayStart = position;
+    for (const auto& keyframeTime : lastKeyframes) {
+        replayStart = std::min(replayStart, keyframeTime);
+    }
+    clip->seekFrameTime(replayStart);
+    for (auto frame = clip->nextFrame(); frame && frame->timeOffset < position; frame = clip->nextFrame()) {
+        auto keyframe = lastKeyframes.constFind(frame->type);
+        if (keyframe != lastKeyframes.constEnd() && frame->timeOffset >= keyframe.value()) {
+            Frame::handleFrame(frame);
+        }
+    }
+}
+
 float Deck::position() const {
     Locker lock(_mutex);
     auto currentPosition = _position;
@@ -70,6 +70,7 @@ private:
 
     ClipPointer getNextClip();
     void processFrames();
+    void replayFromKeyframes(const ClipPointer& clip, Frame::Time position);
 
     mutable Mutex _mutex;
     QTimer _timer;
@@ -71,6 +71,7 @@ private:
 
 static Registry<FrameType, QString> frameTypes;
 static QMap<FrameType, Frame::Handler> handlerMap;
+static QMap<FrameType, Frame::KeyframeTest> keyframeTestMap;
 using Mutex = std::mutex;
 using Locker = std::unique_lock<Mutex>;
 static Mutex mutex;
@@ -149,6 +150,20 @@ void Frame::clearFrameHandler(const QString& frameTypeName) {
     clearFrameHandler(frameType); 
 }
 
+void Frame::registerKeyframeTest(FrameType type, KeyframeTest test) {
+    Locker lock(mutex);
+    keyframeTestMap[type] = test;
+}
+
+Frame::KeyframeTest Frame::getKeyframeTest(FrameType type) {
+    Locker lock(mutex);
+    return keyframeTestMap.value(type);
+}
+
+bool Frame::hasKeyframeTests() {
+    Locker lock(mutex);
+    return !keyframeTestMap.empty();
+}
 
 void Frame::handleFrame(const Frame::ConstPointer& frame) {
     Handler handler; 
@@ -58,6 +58,7 @@ public:
     using Pointer = std::shared_ptr<Frame>;
     using ConstPointer = std::shared_ptr<const Frame>;
     using Handler = std::function<void(Frame::ConstPointer frame)>;
+    using KeyframeTest = std::function<bool(const QByteArray& data)>;
 
     QByteArray data;
 
@@ -70,6 +71,11 @@ public:
     static Handler registerFrameHandler(const QString& frameTypeName, Handler handler);
     static void clearFrameHandler(FrameType type);
     static void clearFrameHandler(const QString& frameTypeName);
+    // Frames of a type with a keyframe test may only hold what changed since the frame before them. After a seek, the
+    // deck hands them to their handler again from the last keyframe, so that the first frame played is complete.
+    static void registerKeyframeTest(FrameType type, KeyframeTest test);
+    static KeyframeTest getKeyframeTest(FrameType type);
+    static bool hasKeyframeTests();
     static QMap<QString, FrameType> getFrameTypes();
     static QMap<FrameType, QString> getFrameTypeNames();
     static void handleFrame(const ConstPointer& frame);
@@ -12,6 +12,7 @@
 #include <SharedUtil.h>
 
 #include "impl/BufferClip.h"
+#include "impl/FileClipWriter.h"
 #include "Frame.h"
 
 using namespace recording;
@@ -27,12 +28,23 @@ float Recorder::position() {
     return 0.0f;
 }
 
-void Recorder::start() {
+void Recorder::start(const QString& filePath) {
     Locker lock(_mutex);
     if (!_recording) {
         _recording = true;
         // FIXME for now just record a new clip every time
         _clip = std::make_shared<BufferClip>();
+        // Replacing the previous writer waits for it to finish, if it hasn't yet
+        _writer.reset();
+        _filePath.clear();
+        if (!filePath.isEmpty()) {
+            _writer = std::make_shared<FileClipWriter>(filePath);
+            if (_writer->isOpen()) {
+                _filePath = filePath;
+            } else {
+                _writer.reset();
+            }
+        }
         _startEpoch = usecTimestampNow();
         _timer.start();
         emit recordingStateChanged();
@@ -44,10 +56,18 @@ void Recorder::stop() {
     if (_recording) {
         _recording = false;
         _elapsed = _timer.elapsed();
+        if (_writer) {
+            _writer->close();
+        }
         emit recordingStateChanged();
     }
 }
 
+QString Recorder::getFilePath() {
+    Locker lock(_mutex);
+    return _filePath;
+}
+
 bool Recorder::isRecording() {
     Locker lock(_mutex);
     return _recording;
@@ -69,6 +89,9 @@ void Recorder::recordFrame(FrameType type, QByteArray frameData) {
     frame->data = frameData;
     frame->timeOffset = (usecTimestampNow() - _startEpoch) / USECS_PER_MSEC;
     _clip->addFrame(frame);
+    if (_writer) {
+        _writer->addFrame(frame);
+    }
 }
 
 ClipPointer Recorder::getClip() {
@@ -14,6 +14,7 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QString>
 
 #include <DependencyManager.h>
 
@@ -21,6 +22,8 @@
 
 namespace recording {
 
+class FileClipWriter;
+
 // An interface for interacting with clips, creating them by recording or
 // playing them back.  Also serialization to and from files / network sources
 class Recorder : public QObject, public Dependency {
@@ -30,11 +33,14 @@ public:
 
     float position();
 
-    // Start recording frames
-    void start();
-    // Stop recording
+    // Start recording frames, also writing them to filePath as they are recorded if it isn't empty
+    void start(const QString& filePath = QString());
+    // Stop recording, and finish writing the file from another thread
     void stop();
 
+    // The file the current or last recording was written to, if any
+    QString getFilePath();
+
     // Test if recording is active
     bool isRecording();
 
@@ -56,6 +62,8 @@ private:
     Mutex _mutex;
     QElapsedTimer _timer;
     ClipPointer _clip;
+    std::shared_ptr<FileClipWriter> _writer;
+    QString _filePath;
     quint64 _elapsed { 0 };
     quint64 _startEpoch { 0 };
     bool _recording { false };
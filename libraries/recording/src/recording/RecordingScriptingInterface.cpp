@@ -11,6 +11,7 @@
 #include "RecordingScriptingInterface.h"
 
 #include <QStandardPaths>
+#include <QtCore/QFileInfo>
 #include <QtCore/QThread>
 #include <QtCore/QUrl>
 #include <QtWidgets/QFileDialog>
@@ -27,6 +28,7 @@
 #include "Clip.h"
 #include "Frame.h"
 #include "ClipCache.h"
+#include "impl/FileClipWriter.h"
 
 #include <ScriptEngine.h>
 #include <ScriptEngineLogging.h>
@@ -203,14 +205,14 @@ float RecordingScriptingInterface::recorderElapsed() const {
     return _recorder->position();
 }
 
-void RecordingScriptingInterface::startRecording() {
+void RecordingScriptingInterface::startRecording(const QString& filename) {
     if (_recorder->isRecording()) {
         qCWarning(scriptengine) << "Recorder is already running";
         return;
     }
 
     Locker lock(_mutex);
-    _recorder->start();
+    _recorder->start(filename);
 }
 
 void RecordingScriptingInterface::stopRecording() {
@@ -239,8 +241,18 @@ void RecordingScriptingInterface::saveRecording(const QString& filename) {
         qWarning() << "There is no recording to save";
         return;
     }
+    if (!_recorder->getFilePath().isEmpty() && _recorder->getClip() == _lastClip &&
+        QFileInfo(filename) == QFileInfo(_recorder->getFilePath())) {
+        // Already written while it was recorded
+        return;
+    }
 
-    recording::Clip::toFile(filename, _lastClip);
+    // Write from another thread so that saving doesn't hold up recording or playback. The previous writer is
+    // finished first, since the new one truncates its file, which may be the same one.
+    _clipWriter.reset();
+    _clipWriter = std::make_shared<recording::FileClipWriter>(filename);
+    _clipWriter->addClip(_lastClip);
+    _clipWriter->close();
 }
 
 bool RecordingScriptingInterface::saveRecordingToAsset(const ScriptValue& getClipAtpUrl) {
@@ -27,6 +27,10 @@
 #include "Forward.h"
 #include "Frame.h"
 
+namespace recording {
+class FileClipWriter;
+}
+
 /*@jsdoc
  * The <code>Recording</code> API makes and plays back recordings of voice and avatar movements. Playback may be done on a 
  * user's avatar or an assignment client agent (see the {@link Agent} API).
@@ -223,8 +227,11 @@ public slots:
     /*@jsdoc
      * Starts making a recording.
      * @function Recording.startRecording
+     * @param {string} [filename=""] - The path and name of a file to write the recording to as it is made. If specified,
+     *     the recording doesn't need to be saved to that file with {@link Recording.saveRecording|saveRecording}
+     *     afterwards.
      */
-    void startRecording();
+    void startRecording(const QString& filename = QString());
 
     /*@jsdoc
      * Stops making a recording. The recording may be saved using {@link Recording.saveRecording|saveRecording} or 
@@ -351,6 +358,7 @@ protected:
     Flag _useHeadModel { false };
     Flag _useSkeletonModel { false };
     recording::ClipPointer _lastClip;
+    std::shared_ptr<recording::FileClipWriter> _clipWriter;
 
     QSet<recording::NetworkClipLoaderPointer> _clipLoaders;
 
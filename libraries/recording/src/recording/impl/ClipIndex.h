@@ -0,0 +1,62 @@
+//
+//  ClipIndex.h
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+#ifndef hifi_Recording_Impl_ClipIndex_h
+#define hifi_Recording_Impl_ClipIndex_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include "../Frame.h"
+
+// Clips are written with an index after their last frame, so that readers can open and seek them without walking every
+// frame. The index is made of ordinary frames of the index type:
+//
+// - a summary frame: version, number of frames, frames per entry, then for each frame type its count and last time
+// - entry frames: the time and file offset of every FRAMES_PER_ENTRY-th frame, for up to MAX_ENTRIES_PER_FRAME each
+// - a footer frame, always the last footerFrameSize() bytes: the file offset of the summary frame and FOOTER_TAG
+//
+// Index frames are compressed like every other frame of the clip. The footer is compressed without deflating it, so
+// that its size only depends on its length. Offsets are to the start of a frame, and entries are only written for
+// clips whose frames are in time order.
+//
+// Readers that predate the index only load the frame types they have registered, so they leave the index frames out
+// of the clip, but they still read every frame header when they open it. Rewriting such a clip drops its index.
+namespace recording { namespace index {
+
+static const QString FRAME_TYPE_NAME = QStringLiteral("com.overte.recording.Index");
+
+static const uint32_t VERSION = 2;
+static const uint32_t FRAMES_PER_ENTRY = 256;
+static const size_t MAX_ENTRIES_PER_FRAME = 4096;
+
+static const size_t ENTRY_SIZE = sizeof(Frame::Time) + sizeof(quint64);
+static const size_t SUMMARY_SIZE = 3 * sizeof(uint32_t) + sizeof(uint16_t);
+static const size_t TYPE_SUMMARY_SIZE = sizeof(FrameType) + sizeof(uint32_t) + sizeof(Frame::Time);
+
+static const char FOOTER_TAG[4] = { 'o', 'r', 'c', 'i' };
+static const size_t FOOTER_SIZE = sizeof(quint64) + sizeof(FOOTER_TAG);
+static const int FOOTER_COMPRESSION_LEVEL = 0;
+
+inline QByteArray compressFooter(const QByteArray& footer) {
+    return qCompress(footer, FOOTER_COMPRESSION_LEVEL);
+}
+
+inline size_t footerFrameSize() {
+    static const size_t size = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize) +
+        compressFooter(QByteArray((int)FOOTER_SIZE, 0)).size();
+    return size;
+}
+
+} }
+
+#endif
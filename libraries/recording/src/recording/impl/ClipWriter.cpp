@@ -0,0 +1,139 @@
+//
+//  ClipWriter.cpp
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ClipWriter.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QIODevice>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include "../Clip.h"
+#include "ClipIndex.h"
+#include "WarningsSuppression.h"
+
+using namespace recording;
+
+template <typename T>
+static void append(QByteArray& data, const T& value) {
+    data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+ClipWriter::ClipWriter(QIODevice& output) :
+    _output(output),
+    _indexType(Frame::registerFrameType(index::FRAME_TYPE_NAME)) {
+}
+
+bool ClipWriter::writeRawFrame(FrameType type, Frame::Time timeOffset, const QByteArray& data) {
+    auto written = _output.write((char*)&type, sizeof(FrameType));
+    if (written != sizeof(FrameType)) {
+        return false;
+    }
+    written = _output.write((char*)&timeOffset, sizeof(Frame::Time));
+    if (written != sizeof(Frame::Time)) {
+        return false;
+    }
+
+    uint16_t dataSize = data.size();
+    written = _output.write((char*)&dataSize, sizeof(FrameSize));
+    if (written != sizeof(uint16_t)) {
+        return false;
+    }
+
+    if (dataSize != 0) {
+        written = _output.write(data.constData(), dataSize);
+        if (written != dataSize) {
+            return false;
+        }
+    }
+    _offset += sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize) + dataSize;
+    return true;
+}
+
+bool ClipWriter::writeHeader() {
+    auto frameTypes = Frame::getFrameTypes();
+    QJsonObject frameTypeObj;
+    for (const auto& frameTypeName : frameTypes.keys()) {
+        frameTypeObj[frameTypeName] = frameTypes[frameTypeName];
+    }
+
+    QJsonObject rootObject;
+    rootObject.insert(Clip::FRAME_TYPE_MAP, frameTypeObj);
+    // Always mark new files as compressed
+    rootObject.insert(Clip::FRAME_COMREPSSION_FLAG, true);
+    OVERTE_IGNORE_DEPRECATED_BEGIN
+    // Can't use CBOR yet, will break the protocol.
+    QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
+    OVERTE_IGNORE_DEPRECATED_END
+    // Never compress the header frame
+    return writeRawFrame(Frame::TYPE_HEADER, 0, headerFrameData);
+}
+
+bool ClipWriter::writeFrame(const Frame& frame) {
+    if (frame.type == Frame::TYPE_INVALID) {
+        qWarning() << "Attempting to write invalid frame";
+        return true;
+    }
+
+    if (frame.timeOffset < _lastTime) {
+        _ordered = false;
+    }
+    if (_frameCount % index::FRAMES_PER_ENTRY == 0) {
+        _entries.emplace_back(frame.timeOffset, _offset);
+    }
+    auto& typeSummary = _typeSummaries[frame.type];
+    typeSummary.count++;
+    typeSummary.lastTime = std::max(typeSummary.lastTime, frame.timeOffset);
+    _lastTime = std::max(_lastTime, frame.timeOffset);
+    _frameCount++;
+
+    return writeRawFrame(frame.type, frame.timeOffset, qCompress(frame.data));
+}
+
+bool ClipWriter::writeIndex() {
+    // Readers fall back to walking every frame of clips that are out of order
+    if (!_ordered) {
+        return true;
+    }
+
+    quint64 summaryOffset = _offset;
+    QByteArray summary;
+    append(summary, index::VERSION);
+    append(summary, _frameCount);
+    append(summary, index::FRAMES_PER_ENTRY);
+    append(summary, (uint16_t)_typeSummaries.size());
+    for (auto itr = _typeSummaries.cbegin(); itr != _typeSummaries.cend(); ++itr) {
+        append(summary, itr.key());
+        append(summary, itr.value().count);
+        append(summary, itr.value().lastTime);
+    }
+    if (!writeRawFrame(_indexType, _lastTime, qCompress(summary))) {
+        return false;
+    }
+
+    for (size_t first = 0; first < _entries.size(); first += index::MAX_ENTRIES_PER_FRAME) {
+        auto last = std::min(first + index::MAX_ENTRIES_PER_FRAME, _entries.size());
+        QByteArray entries;
+        entries.reserve((int)((last - first) * index::ENTRY_SIZE));
+        for (auto i = first; i < last; i++) {
+            append(entries, _entries[i].first);
+            append(entries, _entries[i].second);
+        }
+        if (!writeRawFrame(_indexType, _lastTime, qCompress(entries))) {
+            return false;
+        }
+    }
+
+    QByteArray footer;
+    append(footer, summaryOffset);
+    footer.append(index::FOOTER_TAG, sizeof(index::FOOTER_TAG));
+    return writeRawFrame(_indexType, _lastTime, index::compressFooter(footer));
+}
@@ -0,0 +1,56 @@
+//
+//  ClipWriter.h
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+#ifndef hifi_Recording_Impl_ClipWriter_h
+#define hifi_Recording_Impl_ClipWriter_h
+
+#include <vector>
+
+#include <QtCore/QMap>
+
+#include "../Frame.h"
+
+class QIODevice;
+
+namespace recording {
+
+// Writes a clip to a device one frame at a time: the header, then the frames, then the index (see ClipIndex.h)
+class ClipWriter {
+public:
+    ClipWriter(QIODevice& output);
+
+    bool writeHeader();
+    bool writeFrame(const Frame& frame);
+    bool writeIndex();
+
+private:
+    struct TypeSummary {
+        uint32_t count { 0 };
+        Frame::Time lastTime { 0 };
+    };
+
+    bool writeRawFrame(FrameType type, Frame::Time timeOffset, const QByteArray& data);
+
+    QIODevice& _output;
+    quint64 _offset { 0 };
+    FrameType _indexType;
+
+    uint32_t _frameCount { 0 };
+    Frame::Time _lastTime { 0 };
+    bool _ordered { true };
+    QMap<FrameType, TypeSummary> _typeSummaries;
+    std::vector<std::pair<Frame::Time, quint64>> _entries;
+};
+
+}
+
+#endif
@@ -41,7 +41,7 @@ QString FileClip::getName() const {
 
 
 bool FileClip::write(const QString& fileName, Clip::Pointer clip) {
-    // FIXME need to move this to a different thread
+    // Blocks until the clip is written, FileClipWriter writes from a thread of its own
     //qCDebug(recordingLog) << "Writing clip to file " << fileName << " with " << clip->frameCount() << " frames";
 
     if (0 == clip->frameCount()) {
@@ -0,0 +1,105 @@
+//
+//  FileClipWriter.cpp
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "FileClipWriter.h"
+
+#include "../Logging.h"
+#include "ClipWriter.h"
+
+using namespace recording;
+
+FileClipWriter::FileClipWriter(const QString& filePath) : _file(filePath) {
+    if (!_file.open(QFile::Truncate | QFile::WriteOnly)) {
+        qCWarning(recordingLog) << "Unable to open file " << filePath;
+        _closed = true;
+        return;
+    }
+    _thread = std::thread([this] { run(); });
+}
+
+FileClipWriter::~FileClipWriter() {
+    close();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void FileClipWriter::addFrame(FrameConstPointer frame) {
+    Locker lock(_mutex);
+    if (_closing) {
+        return;
+    }
+    _pending.push_back({ frame, Clip::ConstPointer() });
+    _condition.notify_all();
+}
+
+void FileClipWriter::addClip(Clip::ConstPointer clip) {
+    Locker lock(_mutex);
+    if (_closing) {
+        return;
+    }
+    _pending.push_back({ FrameConstPointer(), clip });
+    _condition.notify_all();
+}
+
+void FileClipWriter::close() {
+    Locker lock(_mutex);
+    _closing = true;
+    _condition.notify_all();
+}
+
+bool FileClipWriter::wait() {
+    Locker lock(_mutex);
+    _condition.wait(lock, [this] { return _closed; });
+    return _succeeded;
+}
+
+void FileClipWriter::run() {
+    ClipWriter writer(_file);
+    bool succeeded = writer.writeHeader();
+    while (true) {
+        Pending next;
+        {
+            Locker lock(_mutex);
+            _condition.wait(lock, [this] { return _closing || !_pending.empty(); });
+            if (_pending.empty()) {
+                break;
+            }
+            next = _pending.front();
+            _pending.pop_front();
+        }
+
+        // Keep emptying the queue after a failure, so that it doesn't grow for as long as frames are added
+        if (!succeeded) {
+            continue;
+        }
+        if (next.frame) {
+            succeeded = writer.writeFrame(*next.frame);
+        } else if (next.clip) {
+            // Reading frames moves a clip's position, so read from a copy in case the clip is also playing
+            auto copy = next.clip->duplicate();
+            copy->seek(0);
+            for (auto frame = copy->nextFrame(); frame && succeeded; frame = copy->nextFrame()) {
+                succeeded = writer.writeFrame(*frame);
+            }
+        }
+    }
+    succeeded = succeeded && writer.writeIndex();
+    _file.close();
+    if (!succeeded) {
+        qCWarning(recordingLog) << "Failed writing clip to file " << _file.fileName();
+    }
+
+    Locker lock(_mutex);
+    _succeeded = succeeded;
+    _closed = true;
+    _condition.notify_all();
+}
@@ -0,0 +1,70 @@
+//
+//  FileClipWriter.h
+//  libraries/recording/src/recording/impl
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+#ifndef hifi_Recording_Impl_FileClipWriter_h
+#define hifi_Recording_Impl_FileClipWriter_h
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <QtCore/QFile>
+
+#include "../Clip.h"
+
+namespace recording {
+
+// Streams frames to a clip file from a thread of its own, so that compressing and writing them never holds up the
+// thread that records or plays them. Frames are written in the order they are added, and the index once closed.
+class FileClipWriter {
+public:
+    FileClipWriter(const QString& filePath);
+    // Closes the file and waits for everything added to be written
+    ~FileClipWriter();
+
+    bool isOpen() const { return _thread.joinable(); }
+
+    void addFrame(FrameConstPointer frame);
+    // Adds every frame of the clip, read from a copy of it on the writer thread
+    void addClip(Clip::ConstPointer clip);
+
+    // Writes the index after the frames already added and closes the file, without waiting
+    void close();
+    // Waits for the file to be closed, returning whether everything was written
+    bool wait();
+
+private:
+    struct Pending {
+        FrameConstPointer frame;
+        Clip::ConstPointer clip;
+    };
+
+    using Mutex = std::mutex;
+    using Locker = std::unique_lock<Mutex>;
+
+    void run();
+
+    QFile _file;
+    std::thread _thread;
+
+    Mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<Pending> _pending;
+    bool _closing { false };
+    bool _closed { false };
+    bool _succeeded { false };
+};
+
+}
+
+#endif
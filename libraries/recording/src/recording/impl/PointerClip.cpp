@@ -19,6 +19,7 @@
 #include "../Frame.h"
 #include "../Logging.h"
 #include "BufferClip.h"
+#include "ClipIndex.h"
 #include "WarningsSuppression.h"
 
 using namespace recording;
@@ -45,13 +46,15 @@ FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
 }
 
 
-PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size) {
+// Reads at most maxFrames frame headers, starting at begin and stopping at size; offsets are from start
+PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size, size_t begin = 0,
+                                         size_t maxFrames = SIZE_MAX) {
     PointerFrameHeaderList results;
-    auto current = start;
-    auto end = current + size;
+    auto current = start + begin;
+    auto end = start + size;
     // Read all the frame headers
     // FIXME move to Frame::readHeader?
-    while (end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
+    while (results.size() < maxFrames && end - current >= PointerClip::MINIMUM_FRAME_SIZE) {
         PointerFrameHeader header;
         memcpy(&(header.type), current, sizeof(FrameType));
         current += sizeof(FrameType);
@@ -66,19 +69,33 @@ PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size)
         current += header.size;
         results.push_back(header);
     }
-    qDebug(recordingLog) << "Parsed source data into " << results.size() << " frames";
-//    int i = 0;
-//    for (const auto& frameHeader : results) {
-//        qDebug(recordingLog) << "Frame " << i++ << " time " << frameHeader.timeOffset << " Type " << frameHeader.type;
-//    }
     return results;
 }
 
+template <typename T>
+static T readValue(const uchar*& current) {
+    T result;
+    memcpy(&result, current, sizeof(T));
+    current += sizeof(T);
+    return result;
+}
+
 void PointerClip::reset() {
+    ArrayClip::reset();
     _frames.clear();
     _data = nullptr;
     _size = 0;
     _header = QJsonDocument();
+    _indexed = false;
+    _translationMap.clear();
+    _index.clear();
+    _framesPerEntry = 0;
+    _framesEnd = 0;
+    _indexedFrameCount = 0;
+    _knownFrameCount = 0;
+    _indexedDuration = 0;
+    _loadedEntry = SIZE_MAX;
+    _loadedFrames.clear();
 }
 
 void PointerClip::init(uchar* data, size_t size) {
@@ -87,18 +104,20 @@ void PointerClip::init(uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
+    // Make sure the index frames are translated, even when this process hasn't written a clip yet
+    auto indexType = Frame::registerFrameType(index::FRAME_TYPE_NAME);
+
     // Verify that at least one frame exists and that the first frame is a header
-    if (0 == parsedFrameHeaders.size()) {
+    auto fileHeaderFrameHeaders = parseFrameHeaders(data, size, 0, 1);
+    if (0 == fileHeaderFrameHeaders.size()) {
         qWarning() << "No frames found, invalid file";
         reset();
         return;
     }
 
     // Grab the file header
+    auto fileHeaderFrameHeader = *fileHeaderFrameHeaders.begin();
     {
-        auto fileHeaderFrameHeader = *parsedFrameHeaders.begin();
-        parsedFrameHeaders.pop_front();
         if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
             qWarning() << "Missing header frame, invalid file";
             reset();
@@ -127,6 +146,17 @@ void PointerClip::init(uchar* data, size_t size) {
             return;
         }
 
+        if (readIndex(translationMap)) {
+            qDebug(recordingLog) << "Read index of " << _indexedFrameCount << " frames";
+            skipUnknownFrames();
+            return;
+        }
+
+        // Without an index, read all the frame headers
+        auto framesBegin = fileHeaderFrameHeader.fileOffset + fileHeaderFrameHeader.size;
+        auto parsedFrameHeaders = parseFrameHeaders(data, size, framesBegin);
+        qDebug(recordingLog) << "Parsed source data into " << parsedFrameHeaders.size() << " frames";
+
         // Update the loaded headers with the frame data
         _frames.reserve(parsedFrameHeaders.size());
         for (auto& frameHeader : parsedFrameHeaders) {
@@ -134,25 +164,277 @@ void PointerClip::init(uchar* data, size_t size) {
                 continue;
             }
             frameHeader.type = translationMap[frameHeader.type];
+            if (frameHeader.type == indexType) {
+                continue;
+            }
             _frames.push_back(frameHeader);
         }
     }
 
 }
 
+bool PointerClip::readIndex(const FrameTranslationMap& translationMap) {
+    auto indexType = Frame::registerFrameType(index::FRAME_TYPE_NAME);
+    auto isIndexFrame = [&](const PointerFrameHeader& frameHeader) {
+        return translationMap.contains(frameHeader.type) && translationMap[frameHeader.type] == indexType;
+    };
+    if (_size < index::footerFrameSize()) {
+        return false;
+    }
+
+    // The footer is the last frame, and points at the summary
+    size_t footerOffset = _size - index::footerFrameSize();
+    auto footerFrameHeaders = parseFrameHeaders(_data, _size, footerOffset, 1);
+    if (footerFrameHeaders.empty()) {
+        return false;
+    }
+    const auto& footerFrameHeader = footerFrameHeaders.front();
+    if (footerFrameHeader.fileOffset + footerFrameHeader.size != _size || !isIndexFrame(footerFrameHeader)) {
+        return false;
+    }
+    QByteArray footer = readFrame(footerFrameHeader)->data;
+    if (footer.size() != (int)index::FOOTER_SIZE) {
+        return false;
+    }
+    const uchar* current = reinterpret_cast<const uchar*>(footer.constData());
+    auto summaryOffset = readValue<quint64>(current);
+    if (memcmp(current, index::FOOTER_TAG, sizeof(index::FOOTER_TAG)) != 0 || summaryOffset >= footerOffset) {
+        return false;
+    }
+
+    auto indexFrameHeaders = parseFrameHeaders(_data, footerOffset, summaryOffset);
+    if (indexFrameHeaders.empty()) {
+        return false;
+    }
+    for (const auto& indexFrameHeader : indexFrameHeaders) {
+        if (!isIndexFrame(indexFrameHeader)) {
+            return false;
+        }
+    }
+
+    // The summary gives the number of frames, and the count and duration of each type of them
+    QByteArray summary = readFrame(indexFrameHeaders.front())->data;
+    if ((size_t)summary.size() < index::SUMMARY_SIZE) {
+        return false;
+    }
+    current = reinterpret_cast<const uchar*>(summary.constData());
+    auto version = readValue<uint32_t>(current);
+    auto frameCount = readValue<uint32_t>(current);
+    auto framesPerEntry = readValue<uint32_t>(current);
+    auto typeCount = readValue<uint16_t>(current);
+    if (version != index::VERSION || framesPerEntry == 0 ||
+        (size_t)summary.size() != index::SUMMARY_SIZE + typeCount * index::TYPE_SUMMARY_SIZE) {
+        return false;
+    }
+    size_t knownFrameCount = 0;
+    Frame::Time duration = 0;
+    for (uint16_t i = 0; i < typeCount; i++) {
+        auto type = readValue<FrameType>(current);
+        auto count = readValue<uint32_t>(current);
+        auto lastTime = readValue<Frame::Time>(current);
+        if (translationMap.contains(type)) {
+            knownFrameCount += count;
+            duration = std::max(duration, lastTime);
+        }
+    }
+
+    // Then the entries, in as many frames as they need
+    std::vector<IndexEntry> entries;
+    entries.reserve((frameCount + framesPerEntry - 1) / framesPerEntry);
+    for (auto itr = std::next(indexFrameHeaders.begin()); itr != indexFrameHeaders.end(); ++itr) {
+        QByteArray entryData = readFrame(*itr)->data;
+        if ((size_t)entryData.size() % index::ENTRY_SIZE != 0) {
+            return false;
+        }
+        current = reinterpret_cast<const uchar*>(entryData.constData());
+        for (size_t i = 0; i < (size_t)entryData.size() / index::ENTRY_SIZE; i++) {
+            IndexEntry entry;
+            entry.timeOffset = readValue<Frame::Time>(current);
+            entry.fileOffset = readValue<quint64>(current);
+            if (entry.fileOffset >= summaryOffset) {
+                return false;
+            }
+            entries.push_back(entry);
+        }
+    }
+    if (entries.size() != (frameCount + framesPerEntry - 1) / framesPerEntry) {
+        return false;
+    }
+
+    _indexed = true;
+    _translationMap = translationMap;
+    _index.swap(entries);
+    _framesPerEntry = framesPerEntry;
+    _framesEnd = summaryOffset;
+    _indexedFrameCount = frameCount;
+    _knownFrameCount = knownFrameCount;
+    _indexedDuration = duration;
+    return true;
+}
+
+PointerFrameHeader PointerClip::indexedFrameHeader(size_t frameIndex) const {
+    size_t entry = frameIndex / _framesPerEntry;
+    if (entry != _loadedEntry) {
+        _loadedEntry = entry;
+        _loadedFrames.clear();
+        if (entry < _index.size()) {
+            auto parsedFrameHeaders = parseFrameHeaders(_data, _framesEnd, _index[entry].fileOffset, _framesPerEntry);
+            _loadedFrames.reserve(parsedFrameHeaders.size());
+            for (auto& frameHeader : parsedFrameHeaders) {
+                if (_translationMap.contains(frameHeader.type)) {
+                    frameHeader.type = _translationMap[frameHeader.type];
+                } else {
+                    frameHeader.type = Frame::TYPE_INVALID;
+                }
+                _loadedFrames.push_back(frameHeader);
+            }
+        }
+    }
+
+    size_t loadedIndex = frameIndex - entry * _framesPerEntry;
+    if (loadedIndex < _loadedFrames.size()) {
+        return _loadedFrames[loadedIndex];
+    }
+    // The data ended early
+    PointerFrameHeader result;
+    result.type = Frame::TYPE_INVALID;
+    result.timeOffset = Frame::INVALID_TIME;
+    result.size = 0;
+    result.fileOffset = 0;
+    return result;
+}
+
+void PointerClip::skipUnknownFrames() const {
+    while (_frameIndex < _indexedFrameCount && indexedFrameHeader(_frameIndex).type == Frame::TYPE_INVALID) {
+        ++_frameIndex;
+    }
+}
+
+float PointerClip::duration() const {
+    if (!_indexed) {
+        return ArrayClip::duration();
+    }
+    Locker lock(_mutex);
+    return Frame::frameTimeToSeconds(_indexedDuration);
+}
+
+size_t PointerClip::frameCount() const {
+    if (!_indexed) {
+        return ArrayClip::frameCount();
+    }
+    Locker lock(_mutex);
+    return _knownFrameCount;
+}
+
+Clip::Pointer PointerClip::duplicate() const {
+    if (!_indexed) {
+        return ArrayClip::duplicate();
+    }
+    auto result = newClip();
+    Locker lock(_mutex);
+    for (size_t i = 0; i < _indexedFrameCount; ++i) {
+        auto header = indexedFrameHeader(i);
+        if (header.type != Frame::TYPE_INVALID) {
+            result->addFrame(readFrame(header));
+        }
+    }
+    return result;
+}
+
+void PointerClip::seekFrameTime(Frame::Time offset) {
+    if (!_indexed) {
+        ArrayClip::seekFrameTime(offset);
+        return;
+    }
+    Locker lock(_mutex);
+    auto itr = std::lower_bound(_index.begin(), _index.end(), offset,
+        [](const IndexEntry& a, Frame::Time b)->bool {
+            return a.timeOffset < b;
+        }
+    );
+    size_t entry = itr - _index.begin();
+    _frameIndex = std::min(entry * _framesPerEntry, _indexedFrameCount);
+    // The first frame at or after the offset may be in the previous entry's frames
+    if (entry > 0) {
+        size_t first = (entry - 1) * _framesPerEntry;
+        indexedFrameHeader(first);
+        auto frameItr = std::lower_bound(_loadedFrames.begin(), _loadedFrames.end(), offset,
+            [](const PointerFrameHeader& a, Frame::Time b)->bool {
+                return a.timeOffset < b;
+            }
+        );
+        if (frameItr != _loadedFrames.end()) {
+            _frameIndex = first + (frameItr - _loadedFrames.begin());
+        }
+    }
+    skipUnknownFrames();
+}
+
+Frame::Time PointerClip::positionFrameTime() const {
+    if (!_indexed) {
+        return ArrayClip::positionFrameTime();
+    }
+    Locker lock(_mutex);
+    Frame::Time result = Frame::INVALID_TIME;
+    if (_frameIndex < _indexedFrameCount) {
+        result = indexedFrameHeader(_frameIndex).timeOffset;
+    }
+    return result;
+}
+
+FrameConstPointer PointerClip::peekFrame() const {
+    if (!_indexed) {
+        return ArrayClip::peekFrame();
+    }
+    Locker lock(_mutex);
+    FrameConstPointer result;
+    if (_frameIndex < _indexedFrameCount) {
+        result = readFrame(indexedFrameHeader(_frameIndex));
+    }
+    return result;
+}
+
+FrameConstPointer PointerClip::nextFrame() {
+    if (!_indexed) {
+        return ArrayClip::nextFrame();
+    }
+    Locker lock(_mutex);
+    FrameConstPointer result;
+    if (_frameIndex < _indexedFrameCount) {
+        result = readFrame(indexedFrameHeader(_frameIndex++));
+        skipUnknownFrames();
+    }
+    return result;
+}
+
+void PointerClip::skipFrame() {
+    if (!_indexed) {
+        ArrayClip::skipFrame();
+        return;
+    }
+    Locker lock(_mutex);
+    if (_frameIndex < _indexedFrameCount) {
+        ++_frameIndex;
+        skipUnknownFrames();
+    }
+}
+
 // Internal only function, needs no locking
 FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
-    FramePointer result;
-    if (frameIndex < _frames.size()) {
-        result = std::make_shared<Frame>();
-        const auto& header = _frames[frameIndex];
-        result->type = header.type;
-        result->timeOffset = header.timeOffset;
-        if (header.size) {
-            result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
-            if (_compressed) {
-                result->data = qUncompress(result->data);
-            }
+    if (_indexed) {
+        return frameIndex < _indexedFrameCount ? readFrame(indexedFrameHeader(frameIndex)) : FrameConstPointer();
+    }
+    return frameIndex < _frames.size() ? readFrame(_frames[frameIndex]) : FrameConstPointer();
+}
+
+FrameConstPointer PointerClip::readFrame(const PointerFrameHeader& header) const {
+    FramePointer result = std::make_shared<Frame>();
+    result->type = header.type;
+    result->timeOffset = header.timeOffset;
+    if (header.size) {
+        result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
+        if (_compressed) {
+            result->data = qUncompress(result->data);
         }
     }
     return result;
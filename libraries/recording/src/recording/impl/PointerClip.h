@@ -15,6 +15,7 @@
 #include <mutex>
 
 #include <QtCore/QJsonDocument>
+#include <QtCore/QMap>
 
 #include "../Frame.h"
 
@@ -42,15 +43,53 @@ public:
         return _header;
     }
 
+    // True when the clip was opened from its index, without reading every frame header
+    bool isIndexed() const { return _indexed; }
+
+    virtual float duration() const override;
+    virtual size_t frameCount() const override;
+    virtual Clip::Pointer duplicate() const override;
+    virtual void seekFrameTime(Frame::Time offset) override;
+    virtual Frame::Time positionFrameTime() const override;
+    virtual FrameConstPointer peekFrame() const override;
+    virtual FrameConstPointer nextFrame() override;
+    virtual void skipFrame() override;
+
     // FIXME move to frame?
     static const qint64 MINIMUM_FRAME_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
 protected:
+    using FrameTranslationMap = QMap<FrameType, FrameType>;
+
+    struct IndexEntry {
+        Frame::Time timeOffset;
+        quint64 fileOffset;
+    };
+
     void reset() override;
     virtual FrameConstPointer readFrame(size_t index) const override;
+    FrameConstPointer readFrame(const PointerFrameHeader& header) const;
+    bool readIndex(const FrameTranslationMap& translationMap);
+
+    // When indexed, _frameIndex counts every frame in the data, including those of types this reader doesn't know,
+    // and the headers are read one index entry's worth at a time
+    PointerFrameHeader indexedFrameHeader(size_t frameIndex) const;
+    void skipUnknownFrames() const;
+
     QJsonDocument _header;
     uchar* _data { nullptr };
     size_t _size { 0 };
     bool _compressed { true };
+
+    bool _indexed { false };
+    FrameTranslationMap _translationMap;
+    std::vector<IndexEntry> _index;
+    size_t _framesPerEntry { 0 };
+    size_t _framesEnd { 0 };
+    size_t _indexedFrameCount { 0 };
+    size_t _knownFrameCount { 0 };
+    Frame::Time _indexedDuration { 0 };
+    mutable size_t _loadedEntry { SIZE_MAX };
+    mutable std::vector<PointerFrameHeader> _loadedFrames;
 };
 
 }
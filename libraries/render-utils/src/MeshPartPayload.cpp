@@ -26,6 +26,13 @@
 
 using namespace render;
 
+static const uint32_t WHITE_COMPACT_COLOR = 0xFFFFFFFF;
+
+static bool colorBufferIsWhite(const gpu::BufferPointer& colorBuffer) {
+    return colorBuffer && colorBuffer->getSize() == sizeof(WHITE_COMPACT_COLOR) &&
+        *reinterpret_cast<const uint32_t*>(colorBuffer->getData()) == WHITE_COMPACT_COLOR;
+}
+
 ModelMeshPartPayload::ModelMeshPartPayload(ModelPointer model, int meshIndex, int partIndex, int shapeIndex,
                                            const Transform& transform, const uint64_t& created) :
     _meshIndex(meshIndex),
@@ -373,8 +380,12 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
             args->_details._materialSwitches++;
         }
 
-        const uint32_t compactColor = 0xFFFFFFFF;
-        _drawMesh->getColorBuffer()->setData(sizeof(compactColor), (const gpu::Byte*) &compactColor);
+        // The color buffer is shared by all the parts of the mesh, so only write it when it isn't white already
+        auto colorBuffer = _drawMesh->getColorBuffer();
+        if (!colorBufferIsWhite(colorBuffer)) {
+            const uint32_t compactColor = WHITE_COMPACT_COLOR;
+            colorBuffer->setData(sizeof(compactColor), (const gpu::Byte*) &compactColor);
+        }
     }
 
     // Draw!
@@ -387,6 +398,15 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
 }
 
+bool ModelMeshPartPayload::canRenderConcurrently() const {
+    // Procedurals, materials that still have to be updated and texture samplers all touch state shared with other
+    // payloads, and so does the color write when the mesh's color buffer isn't white yet
+    if (_shapeKey.hasOwnPipeline() || _drawMaterials.shouldUpdate() || _drawMaterials.hasSamplers()) {
+        return false;
+    }
+    return _itemKey.isMirror() || (_drawMesh && colorBufferIsWhite(_drawMesh->getColorBuffer()));
+}
+
 bool ModelMeshPartPayload::passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const {
     if (!_renderWithZones.isEmpty()) {
         if (!containingZones.empty()) {
@@ -475,4 +495,11 @@ template <> HighlightStyle payloadGetOutlineStyle(const ModelMeshPartPayload::Po
     }
     return HighlightStyle();
 }
+
+template <> bool payloadCanRenderConcurrently(const ModelMeshPartPayload::Pointer& payload) {
+    if (payload) {
+        return payload->canRenderConcurrently();
+    }
+    return false;
+}
 }
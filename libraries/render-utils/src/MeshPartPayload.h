@@ -65,6 +65,7 @@ public:
     bool passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const;
     render::ItemID computeMirrorView(ViewFrustum& viewFrustum) const;
     render::HighlightStyle getOutlineStyle(const ViewFrustum& viewFrustum, const size_t height) const;
+    bool canRenderConcurrently() const;
 
     void addMaterial(graphics::MaterialLayer material) { _drawMaterials.push(material); }
     void removeMaterial(graphics::MaterialPointer material) { _drawMaterials.remove(material); }
@@ -118,6 +119,7 @@ namespace render {
     template <> bool payloadPassesZoneOcclusionTest(const ModelMeshPartPayload::Pointer& payload, const std::unordered_set<QUuid>& containingZones);
     template <> ItemID payloadComputeMirrorView(const ModelMeshPartPayload::Pointer& payload, ViewFrustum& viewFrustum);
     template <> HighlightStyle payloadGetOutlineStyle(const ModelMeshPartPayload::Pointer& payload, const ViewFrustum& viewFrustum, const size_t height);
+    template <> bool payloadCanRenderConcurrently(const ModelMeshPartPayload::Pointer& payload);
 }
 
 #endif // hifi_MeshPartPayload_h
@@ -1353,8 +1353,12 @@ void Model::setURL(const QUrl& url) {
 void Model::loadURLFinished(bool success) {
     if (!success) {
         _visualGeometryRequestFailed = true;
-    } else if (!_pendingTextures.empty()) {
-        setTextures(_pendingTextures);
+    } else {
+        if (!_pendingTextures.empty()) {
+            setTextures(_pendingTextures);
+        }
+        // Higher resolution mips of our textures stream in the same order as we loaded
+        _renderGeometry->setTextureLoadPriorityOperator(this, _loadingPriorityOperator);
     }
     emit setURLFinished(success);
 }
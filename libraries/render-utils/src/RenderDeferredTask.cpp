@@ -561,7 +561,7 @@ void DrawStateSortDeferred::run(const RenderContextPointer& renderContext, const
         args->_globalShapeKey = globalKey._flags.to_ulong();
 
         if (_stateSort) {
-            renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey, _parallelRecording);
         } else {
             renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
         }
@@ -65,6 +65,7 @@ class DrawStateSortConfig : public render::Job::Config {
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
     Q_PROPERTY(int maxDrawn MEMBER maxDrawn NOTIFY dirty)
     Q_PROPERTY(bool stateSort MEMBER stateSort NOTIFY dirty)
+    Q_PROPERTY(bool parallelRecording MEMBER parallelRecording NOTIFY dirty)
 public:
     int getNumDrawn() { return numDrawn; }
     void setNumDrawn(int num) {
@@ -74,6 +75,8 @@ public:
 
     int maxDrawn{ -1 };
     bool stateSort{ true };
+    // Record the state sorted shapes on several threads. Payloads that don't opt in are still recorded on the render thread.
+    bool parallelRecording{ false };
 
 signals:
     void numDrawnChanged();
@@ -97,6 +100,7 @@ public:
     void configure(const Config& config) {
         _maxDrawn = config.maxDrawn;
         _stateSort = config.stateSort;
+        _parallelRecording = config.parallelRecording;
     }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
@@ -105,6 +109,7 @@ protected:
     uint _transformSlot;
     int _maxDrawn;  // initialized by Config
     bool _stateSort;
+    bool _parallelRecording;
 };
 
 class SetSeparateDeferredDepthBuffer {
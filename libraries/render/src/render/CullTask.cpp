@@ -14,11 +14,17 @@
 #include <algorithm>
 #include <assert.h>
 
+#include <tbb/parallel_for.h>
+
 #include <PerfStat.h>
 #include <OctreeUtils.h>
 
 using namespace render;
 
+// culling is spread across threads in chunks of this many items, for lists long enough to be worth it
+const size_t CULL_CHUNK_SIZE = 1024;
+const size_t MIN_ITEMS_FOR_PARALLEL_CULL = 2 * CULL_CHUNK_SIZE;
+
 std::unordered_set<QUuid> CullTest::_containingZones = std::unordered_set<QUuid>();
 std::unordered_set<QUuid> CullTest::_prevContainingZones = std::unordered_set<QUuid>();
 
@@ -144,6 +150,53 @@ void FetchSpatialTree::run(const RenderContextPointer& renderContext, const Inpu
     }
 }
 
+template <class Culling>
+void CullSpatialSelection::cullItems(const RenderContextPointer& renderContext, const ItemFilter& filter,
+                                     RenderDetails::Item& details, const ItemIDs& inItems, ItemBounds& outItems,
+                                     const Culling& culling) {
+    RenderArgs* args = renderContext->args;
+    auto& scene = renderContext->_scene;
+
+    auto cullRange = [&](size_t begin, size_t end, CullTest& test, ItemBounds& rangeItems) {
+        for (size_t i = begin; i < end; i++) {
+            auto id = inItems[i];
+            auto& item = scene->getItem(id);
+            if (id != args->_ignoreItem && filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
+                ItemBound itemBound(id, item.getBound(args));
+                if (culling(test, itemBound.bound)) {
+                    rangeItems.emplace_back(itemBound);
+                    if (item.getKey().isMetaCullGroup()) {
+                        item.fetchMetaSubItemBounds(rangeItems, (*scene), args);
+                    }
+                }
+            }
+        }
+    };
+
+    if (inItems.size() < MIN_ITEMS_FOR_PARALLEL_CULL) {
+        CullTest test(_cullFunctor, args, details);
+        cullRange(0, inItems.size(), test, outItems);
+        return;
+    }
+
+    // Each chunk is culled with its own test and output, and the outputs are appended in chunk order
+    // so the result is the same as a serial cull
+    size_t numChunks = (inItems.size() + CULL_CHUNK_SIZE - 1) / CULL_CHUNK_SIZE;
+    std::vector<ItemBounds> chunkItems(numChunks);
+    std::vector<RenderDetails::Item> chunkDetails(numChunks);
+    tbb::parallel_for((size_t)0, numChunks, [&](size_t chunk) {
+        CullTest test(_cullFunctor, args, chunkDetails[chunk]);
+        chunkItems[chunk].reserve(CULL_CHUNK_SIZE);
+        cullRange(chunk * CULL_CHUNK_SIZE, std::min(inItems.size(), (chunk + 1) * CULL_CHUNK_SIZE), test, chunkItems[chunk]);
+    });
+
+    for (size_t chunk = 0; chunk < numChunks; chunk++) {
+        outItems.insert(outItems.end(), chunkItems[chunk].begin(), chunkItems[chunk].end());
+        details._outOfView += chunkDetails[chunk]._outOfView;
+        details._tooSmall += chunkDetails[chunk]._tooSmall;
+    }
+}
+
 void CullSpatialSelection::configure(const Config& config) {
     _justFrozeFrustum = _justFrozeFrustum || (config.freezeFrustum && !_freezeFrustum);
     _freezeFrustum = config.freezeFrustum;
@@ -155,7 +208,6 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
     RenderArgs* args = renderContext->args;
-    auto& scene = renderContext->_scene;
     auto& inSelection = inputs.get0();
 
     auto& details = args->_details.edit(_detailType);
@@ -170,8 +222,6 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         args->pushViewFrustum(_frozenFrustum); // replace the true view frustum by the frozen one
     }
 
-    CullTest test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
@@ -184,133 +234,47 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         // filter individually against the _filter
         // visibility cull if partially selected ( octree cell contianing it was partial)
         // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-        if (_skipCulling || _overrideSkipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (id != renderContext->args->_ignoreItem && filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (id != renderContext->args->_ignoreItem && filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (id != renderContext->args->_ignoreItem && filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (id != renderContext->args->_ignoreItem && filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-        } else {
-
-            // inside & fit items: easy, just filter
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (id != renderContext->args->_ignoreItem && filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
+        bool skipCulling = _skipCulling || _overrideSkipCulling;
+        auto noCulling = [](CullTest& test, const AABox& bound) { return true; };
+        auto solidAngleCulling = [](CullTest& test, const AABox& bound) { return test.solidAngleTest(bound); };
+        auto frustumCulling = [](CullTest& test, const AABox& bound) { return test.frustumTest(bound); };
+        auto frustumAndSolidAngleCulling = [](CullTest& test, const AABox& bound) {
+            return test.frustumTest(bound) && test.solidAngleTest(bound);
+        };
+
+        // inside & fit items: easy, just filter
+        {
+            PerformanceTimer perfTimer("insideFitItems");
+            cullItems(renderContext, filter, details, inSelection.insideItems, outItems, noCulling);
+        }
 
-            // inside & subcell items: filter & distance cull
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (id != renderContext->args->_ignoreItem && filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
+        // inside & subcell items: filter & distance cull
+        {
+            PerformanceTimer perfTimer("insideSmallItems");
+            if (skipCulling) {
+                cullItems(renderContext, filter, details, inSelection.insideSubcellItems, outItems, noCulling);
+            } else {
+                cullItems(renderContext, filter, details, inSelection.insideSubcellItems, outItems, solidAngleCulling);
             }
+        }
 
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (id != renderContext->args->_ignoreItem && filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
+        // partial & fit items: filter & frustum cull
+        {
+            PerformanceTimer perfTimer("partialFitItems");
+            if (skipCulling) {
+                cullItems(renderContext, filter, details, inSelection.partialItems, outItems, noCulling);
+            } else {
+                cullItems(renderContext, filter, details, inSelection.partialItems, outItems, frustumCulling);
             }
+        }
 
-            // partial & subcell items:: filter & frutum cull & solidangle cull
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (id != renderContext->args->_ignoreItem && filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound) && test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
+        // partial & subcell items:: filter & frutum cull & solidangle cull
+        {
+            PerformanceTimer perfTimer("partialSmallItems");
+            if (skipCulling) {
+                cullItems(renderContext, filter, details, inSelection.partialSubcellItems, outItems, noCulling);
+            } else {
+                cullItems(renderContext, filter, details, inSelection.partialSubcellItems, outItems, frustumAndSolidAngleCulling);
             }
         }
     }
@@ -119,6 +119,12 @@ namespace render {
 
         void configure(const Config& config);
         void run(const RenderContextPointer& renderContext, const Inputs& inputs, ItemBounds& outItems);
+
+    private:
+        // Filters and culls inItems into outItems, in order. Long lists are culled on several threads.
+        template <class Culling>
+        void cullItems(const RenderContextPointer& renderContext, const ItemFilter& filter, RenderDetails::Item& details,
+                       const ItemIDs& inItems, ItemBounds& outItems, const Culling& culling);
     };
 
     class ApplyCullFunctorOnItemBounds {
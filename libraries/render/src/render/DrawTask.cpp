@@ -15,6 +15,8 @@
 #include <algorithm>
 #include <assert.h>
 
+#include <tbb/parallel_for.h>
+
 #include <LogHandler.h>
 #include <PerfStat.h>
 #include <ViewFrustum.h>
@@ -81,8 +83,90 @@ void render::renderShapes(const RenderContextPointer& renderContext,
     }
 }
 
+using SortedPipelines = std::vector<render::ShapeKey>;
+using SortedShapes = std::unordered_map<render::ShapeKey, std::vector<Item>, render::ShapeKey::Hash, render::ShapeKey::KeyEqual>;
+
+// The items of each pipeline are recorded in chunks of this many, each chunk in its own batch
+const size_t RECORD_CHUNK_SIZE = 128;
+const size_t MIN_ITEMS_FOR_PARALLEL_RECORD = 2 * RECORD_CHUNK_SIZE;
+
+static void recordSortedShapesInParallel(RenderArgs* args, const ShapePlumberPointer& shapeContext,
+                                         const SortedPipelines& sortedPipelines, SortedShapes& sortedShapes) {
+    struct RecordChunk {
+        ShapeKey key;
+        const std::vector<Item>* items;
+        size_t begin;
+        size_t end;
+        bool concurrent;
+        ShapePipelinePointer pipeline;
+        gpu::BatchPointer batch;
+        int materialSwitches { 0 };
+        int trianglesRendered { 0 };
+    };
+    std::vector<RecordChunk> chunks;
+    std::vector<size_t> concurrentChunks;
+
+    // Pipelines are picked here rather than on the workers, since picking one can add it to the plumber.
+    // Runs of items that can't render concurrently get chunks of their own, which are recorded on this thread.
+    gpu::Batch* passBatch = args->_batch;
+    for (auto& pipelineKey : sortedPipelines) {
+        auto& bucket = sortedShapes[pipelineKey];
+        for (size_t begin = 0; begin < bucket.size();) {
+            auto batch = gpu::Context::acquireBatch();
+            args->_batch = batch.get();
+            auto pipeline = shapeContext->pickPipeline(args, pipelineKey);
+            if (!pipeline) {
+                break;
+            }
+            bool concurrent = bucket[begin].canRenderConcurrently();
+            size_t end = begin + 1;
+            while (end < bucket.size() && end - begin < RECORD_CHUNK_SIZE && bucket[end].canRenderConcurrently() == concurrent) {
+                ++end;
+            }
+            if (concurrent) {
+                concurrentChunks.push_back(chunks.size());
+            }
+            chunks.push_back({ pipelineKey, &bucket, begin, end, concurrent, pipeline, batch });
+            begin = end;
+        }
+    }
+    args->_batch = passBatch;
+
+    auto recordChunk = [&](RecordChunk& chunk) {
+        RenderArgs chunkArgs(*args);
+        chunkArgs._batch = chunk.batch.get();
+        chunkArgs._shapePipeline = chunk.pipeline;
+        chunkArgs._itemShapeKey = chunk.key._flags.to_ulong();
+        chunkArgs._details._materialSwitches = 0;
+        chunkArgs._details._trianglesRendered = 0;
+        for (size_t j = chunk.begin; j < chunk.end; ++j) {
+            auto& item = (*chunk.items)[j];
+            chunk.pipeline->prepareShapeItem(&chunkArgs, chunk.key, item);
+            item.render(&chunkArgs);
+        }
+        chunk.materialSwitches = chunkArgs._details._materialSwitches;
+        chunk.trianglesRendered = chunkArgs._details._trianglesRendered;
+    };
+
+    for (auto& chunk : chunks) {
+        if (!chunk.concurrent) {
+            recordChunk(chunk);
+        }
+    }
+    tbb::parallel_for((size_t)0, concurrentChunks.size(), [&](size_t i) {
+        recordChunk(chunks[concurrentChunks[i]]);
+    });
+
+    for (auto& chunk : chunks) {
+        passBatch->append(*chunk.batch);
+        args->_details._materialSwitches += chunk.materialSwitches;
+        args->_details._trianglesRendered += chunk.trianglesRendered;
+    }
+}
+
 void render::renderStateSortShapes(const RenderContextPointer& renderContext,
-    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey) {
+    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey,
+    bool parallelRecording) {
     auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
 
@@ -91,8 +175,6 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
         numItemsToDraw = glm::min(numItemsToDraw, maxDrawnItems);
     }
 
-    using SortedPipelines = std::vector<render::ShapeKey>;
-    using SortedShapes = std::unordered_map<render::ShapeKey, std::vector<Item>, render::ShapeKey::Hash, render::ShapeKey::KeyEqual>;
     SortedPipelines sortedPipelines;
     SortedShapes sortedShapes;
     std::vector< std::tuple<Item,ShapeKey> > ownPipelineBucket;
@@ -119,16 +201,24 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
     }
 
     // Then render
-    for (auto& pipelineKey : sortedPipelines) {
-        auto& bucket = sortedShapes[pipelineKey];
-        args->_shapePipeline = shapeContext->pickPipeline(args, pipelineKey);
-        if (!args->_shapePipeline) {
-            continue;
-        }
-        args->_itemShapeKey = pipelineKey._flags.to_ulong();
-        for (auto& item : bucket) {
-            args->_shapePipeline->prepareShapeItem(args, pipelineKey, item);
-            item.render(args);
+    size_t numSortedItems = 0;
+    for (auto& bucket : sortedShapes) {
+        numSortedItems += bucket.second.size();
+    }
+    if (parallelRecording && numSortedItems >= MIN_ITEMS_FOR_PARALLEL_RECORD) {
+        recordSortedShapesInParallel(args, shapeContext, sortedPipelines, sortedShapes);
+    } else {
+        for (auto& pipelineKey : sortedPipelines) {
+            auto& bucket = sortedShapes[pipelineKey];
+            args->_shapePipeline = shapeContext->pickPipeline(args, pipelineKey);
+            if (!args->_shapePipeline) {
+                continue;
+            }
+            args->_itemShapeKey = pipelineKey._flags.to_ulong();
+            for (auto& item : bucket) {
+                args->_shapePipeline->prepareShapeItem(args, pipelineKey, item);
+                item.render(args);
+            }
         }
     }
     args->_shapePipeline = nullptr;
@@ -19,7 +19,10 @@ namespace render {
 
 void renderItems(const RenderContextPointer& renderContext, const ItemBounds& inItems, int maxDrawnItems = -1);
 void renderShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
-void renderStateSortShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
+// With parallelRecording, the shapes of large passes are recorded on several threads into their own batches, appended in
+// order to the batch of the pass. Only items whose payload opts in through payloadCanRenderConcurrently are recorded on the
+// workers; the others are recorded on the calling thread.
+void renderStateSortShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey(), bool parallelRecording = false);
 
 class DrawLightConfig : public Job::Config {
     Q_OBJECT
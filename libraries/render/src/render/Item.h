@@ -474,6 +474,8 @@ public:
 
         virtual HighlightStyle getOutlineStyle(const ViewFrustum& viewFrustum, const size_t height) const = 0;
 
+        virtual bool canRenderConcurrently() const = 0;
+
         ~PayloadInterface() {}
 
         // Status interface is local to the base class
@@ -534,6 +536,8 @@ public:
 
     HighlightStyle getOutlineStyle(const ViewFrustum& viewFrustum, const size_t height) const { return _payload->getOutlineStyle(viewFrustum, height); }
 
+    bool canRenderConcurrently() const { return _payload->canRenderConcurrently(); }
+
     // Access the status
     const StatusPointer& getStatus() const { return _payload->getStatus(); }
 
@@ -598,6 +602,11 @@ template <class T> HighlightStyle payloadGetOutlineStyle(const std::shared_ptr<T
     return HighlightStyle();
 }
 
+// Concurrent Render Interface
+// Allows payloads to let their render() run on a worker thread, into its own batch, at the same time as the render() of
+// other payloads that answered true. Asked on the render thread right before rendering.
+template <class T> bool payloadCanRenderConcurrently(const std::shared_ptr<T>& payloadData) { return false; }
+
 // THe Payload class is the real Payload to be used
 // THis allow anything to be turned into a Payload as long as the required interface functions are available
 // When creating a new kind of payload from a new "stuff" class then you need to create specialized version for "stuff"
@@ -629,6 +638,8 @@ public:
 
     virtual HighlightStyle getOutlineStyle(const ViewFrustum& viewFrustum, const size_t height) const override { return payloadGetOutlineStyle<T>(_data, viewFrustum, height); }
 
+    virtual bool canRenderConcurrently() const override { return payloadCanRenderConcurrently<T>(_data); }
+
 protected:
     DataPointer _data;
 
@@ -13,10 +13,17 @@
 #include "ShapePipeline.h"
 
 #include <assert.h>
+
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
 #include <ViewFrustum.h>
 
 using namespace render;
 
+// lists shorter than this are sorted on the calling thread
+const size_t MIN_ITEMS_FOR_PARALLEL_SORT = 4096;
+
 struct ItemBoundSort {
     float _centerDepth = 0.0f;
     float _nearDepth = 0.0f;
@@ -28,51 +35,60 @@ struct ItemBoundSort {
     ItemBoundSort(float centerDepth, float nearDepth, float farDepth, ItemID id, const AABox& bounds) : _centerDepth(centerDepth), _nearDepth(nearDepth), _farDepth(farDepth), _id(id), _bounds(bounds) {}
 };
 
+// Ties are broken by id so that the order is the same whichever sort is used
 struct FrontToBackSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth < right._centerDepth);
+    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) const {
+        return (left._centerDepth < right._centerDepth) || (left._centerDepth == right._centerDepth && left._id < right._id);
     }
 };
 
 struct BackToFrontSort {
-    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) {
-        return (left._centerDepth > right._centerDepth);
+    bool operator() (const ItemBoundSort& left, const ItemBoundSort& right) const {
+        return (left._centerDepth > right._centerDepth) || (left._centerDepth == right._centerDepth && left._id < right._id);
     }
 };
 
+template <class Compare>
+static void sortItemBounds(std::vector<ItemBoundSort>& itemBoundSorts, const Compare& compare) {
+    if (itemBoundSorts.size() < MIN_ITEMS_FOR_PARALLEL_SORT) {
+        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), compare);
+    } else {
+        tbb::parallel_sort(itemBoundSorts.begin(), itemBoundSorts.end(), compare);
+    }
+}
+
 void render::depthSortItems(const RenderContextPointer& renderContext, bool frontToBack, 
                             const ItemBounds& inItems, ItemBounds& outItems, AABox* bounds) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
-
+    const ViewFrustum& viewFrustum = args->getViewFrustum();
 
     // Allocate and simply copy
     outItems.clear();
     outItems.reserve(inItems.size());
 
-
     // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
-
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound(args);
-        float distanceSquared = args->getViewFrustum().distanceToCameraSquared(bound.calcCenter());
-
-        itemBoundSorts.emplace_back(ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, bound));
+    std::vector<ItemBoundSort> itemBoundSorts(inItems.size());
+    auto computeDepth = [&](size_t i) {
+        const auto& bound = inItems[i].bound;
+        float distanceSquared = viewFrustum.distanceToCameraSquared(bound.calcCenter());
+        itemBoundSorts[i] = ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, inItems[i].id, bound);
+    };
+    if (inItems.size() < MIN_ITEMS_FOR_PARALLEL_SORT) {
+        for (size_t i = 0; i < inItems.size(); i++) {
+            computeDepth(i);
+        }
+    } else {
+        tbb::parallel_for((size_t)0, inItems.size(), computeDepth);
     }
 
     // sort against Z
     if (frontToBack) {
-        FrontToBackSort frontToBackSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), frontToBackSort);
+        sortItemBounds(itemBoundSorts, FrontToBackSort());
     } else {
-        BackToFrontSort  backToFrontSort;
-        std::sort(itemBoundSorts.begin(), itemBoundSorts.end(), backToFrontSort);
+        sortItemBounds(itemBoundSorts, BackToFrontSort());
     }
 
     // Finally once sorted result to a list of itemID and keep uniques
@@ -118,39 +134,44 @@ void PipelineSortShapes::run(const RenderContextPointer& renderContext, const It
     }
 }
 
-void DepthSortShapes::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes) {
+// Creates the output list of every shape up front, so that the lists can then be sorted concurrently
+static std::vector<std::pair<const ItemBounds*, ItemBounds*>> prepareShapeSorts(const ShapeBounds& inShapes, ShapeBounds& outShapes) {
     outShapes.clear();
     outShapes.reserve(inShapes.size());
 
+    std::vector<std::pair<const ItemBounds*, ItemBounds*>> sorts;
+    sorts.reserve(inShapes.size());
     for (auto& pipeline : inShapes) {
-        auto& inItems = pipeline.second;
         auto outItems = outShapes.find(pipeline.first);
         if (outItems == outShapes.end()) {
             outItems = outShapes.insert(std::make_pair(pipeline.first, ItemBounds{})).first;
         }
-
-        depthSortItems(renderContext, _frontToBack, inItems, outItems->second);
+        sorts.emplace_back(&pipeline.second, &outItems->second);
     }
+    return sorts;
+}
+
+void DepthSortShapes::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes) {
+    auto sorts = prepareShapeSorts(inShapes, outShapes);
+    tbb::parallel_for((size_t)0, sorts.size(), [&](size_t i) {
+        depthSortItems(renderContext, _frontToBack, *sorts[i].first, *sorts[i].second);
+    });
 }
 
 void DepthSortShapesAndComputeBounds::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, Outputs& outputs) {
     auto& outShapes = outputs.edit0();
     auto& outBounds = outputs.edit1();
 
-    outShapes.clear();
-    outShapes.reserve(inShapes.size());
-    outBounds = AABox();
-
-    for (auto& pipeline : inShapes) {
-        auto& inItems = pipeline.second;
-        auto outItems = outShapes.find(pipeline.first);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(pipeline.first, ItemBounds{})).first;
-        }
-        AABox bounds;
+    auto sorts = prepareShapeSorts(inShapes, outShapes);
+    std::vector<AABox> bounds(sorts.size());
+    tbb::parallel_for((size_t)0, sorts.size(), [&](size_t i) {
+        depthSortItems(renderContext, _frontToBack, *sorts[i].first, *sorts[i].second, &bounds[i]);
+    });
 
-        depthSortItems(renderContext, _frontToBack, inItems, outItems->second, &bounds);
-        outBounds += bounds;
+    // merged in the order of the shapes, as a serial sort would have
+    outBounds = AABox();
+    for (const auto& shapeBounds : bounds) {
+        outBounds += shapeBounds;
     }
 }
 
@@ -10,10 +10,20 @@
 //
 #include "SpatialTree.h"
 
+#include <algorithm>
+#include <array>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <ViewFrustum.h>
 
 using namespace render;
 
+// below these sizes the work isn't worth handing to other threads
+const int MIN_CELLS_FOR_PARALLEL_SELECT = 512;
+const size_t MIN_BRICKS_PER_TASK = 64;
+
 void Octree::PerspectiveSelector::setAngle(float a) {
     const float MAX_LOD_ANGLE = glm::radians(45.0f);
     const float MIN_LOD_ANGLE = glm::radians(1.0f / 60.0f);
@@ -445,10 +455,24 @@ int Octree::select(CellSelection& selection, const FrustumSelector& selector) co
     selectCellBrick(cellID, selection, false);
 
     // then traverse deeper
-    for (int i = 0; i < NUM_OCTANTS; i++) {
-        Index subCellID = cell.child((Link)i);
-        if (subCellID != INVALID_CELL) {
-            selectTraverse(subCellID, selection, selector);
+    if (getNumAllocatedCells() < MIN_CELLS_FOR_PARALLEL_SELECT) {
+        for (int i = 0; i < NUM_OCTANTS; i++) {
+            Index subCellID = cell.child((Link)i);
+            if (subCellID != INVALID_CELL) {
+                selectTraverse(subCellID, selection, selector);
+            }
+        }
+    } else {
+        // each octant is traversed on its own, then appended in octant order as the serial traversal would
+        std::array<CellSelection, NUM_OCTANTS> octantSelections;
+        tbb::parallel_for(0, (int)NUM_OCTANTS, [&](int i) {
+            Index subCellID = cell.child((Link)i);
+            if (subCellID != INVALID_CELL) {
+                selectTraverse(subCellID, octantSelections[i], selector);
+            }
+        });
+        for (const auto& octantSelection : octantSelections) {
+            selection.append(octantSelection);
         }
     }
 
@@ -627,29 +651,47 @@ int ItemSpatialTree::selectCells(CellSelection& selection, const ViewFrustum& fr
     }
 }
 
+void ItemSpatialTree::gatherBrickItems(const Indices& bricks, ItemIDs& items, ItemIDs& subcellItems) const {
+    if (bricks.size() < MIN_BRICKS_PER_TASK) {
+        for (auto brickId : bricks) {
+            const auto& brick = getConcreteBrick(brickId);
+            items.insert(items.end(), brick.items.begin(), brick.items.end());
+            subcellItems.insert(subcellItems.end(), brick.subcellItems.begin(), brick.subcellItems.end());
+        }
+        return;
+    }
+
+    // find where the items of each brick go, then copy the bricks in parallel
+    std::vector<size_t> itemOffsets(bricks.size() + 1);
+    std::vector<size_t> subcellItemOffsets(bricks.size() + 1);
+    itemOffsets[0] = items.size();
+    subcellItemOffsets[0] = subcellItems.size();
+    for (size_t i = 0; i < bricks.size(); i++) {
+        const auto& brick = getConcreteBrick(bricks[i]);
+        itemOffsets[i + 1] = itemOffsets[i] + brick.items.size();
+        subcellItemOffsets[i + 1] = subcellItemOffsets[i] + brick.subcellItems.size();
+    }
+    items.resize(itemOffsets.back());
+    subcellItems.resize(subcellItemOffsets.back());
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, bricks.size(), MIN_BRICKS_PER_TASK), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            const auto& brick = getConcreteBrick(bricks[i]);
+            std::copy(brick.items.begin(), brick.items.end(), items.begin() + itemOffsets[i]);
+            std::copy(brick.subcellItems.begin(), brick.subcellItems.end(), subcellItems.begin() + subcellItemOffsets[i]);
+        }
+    });
+}
+
 int ItemSpatialTree::selectCellItems(ItemSelection& selection, const ItemFilter& filter, const ViewFrustum& frustum, 
                                      float threshold) const {
     selectCells(selection.cellSelection, frustum, threshold);
 
     // Just grab the items in every selected bricks
-    for (auto brickId : selection.cellSelection.insideBricks) {
-        auto& brickItems = getConcreteBrick(brickId).items;
-        selection.insideItems.insert(selection.insideItems.end(), brickItems.begin(), brickItems.end());
-
-        auto& brickSubcellItems = getConcreteBrick(brickId).subcellItems;
-        selection.insideSubcellItems.insert(selection.insideSubcellItems.end(), brickSubcellItems.begin(), brickSubcellItems.end());
-    }
-
-    for (auto brickId : selection.cellSelection.partialBricks) {
-        auto& brickItems = getConcreteBrick(brickId).items;
-        selection.partialItems.insert(selection.partialItems.end(), brickItems.begin(), brickItems.end());
-
-        auto& brickSubcellItems = getConcreteBrick(brickId).subcellItems;
-        selection.partialSubcellItems.insert(selection.partialSubcellItems.end(), brickSubcellItems.begin(), brickSubcellItems.end());
-    }
+    gatherBrickItems(selection.cellSelection.insideBricks, selection.insideItems, selection.insideSubcellItems);
+    gatherBrickItems(selection.cellSelection.partialBricks, selection.partialItems, selection.partialSubcellItems);
 
     return (int) selection.numItems();
 }
 
 
-
@@ -307,6 +307,13 @@ namespace render {
                 partialCells.clear();
                 partialBricks.clear();
             }
+
+            void append(const CellSelection& other) {
+                insideCells.insert(insideCells.end(), other.insideCells.begin(), other.insideCells.end());
+                insideBricks.insert(insideBricks.end(), other.insideBricks.begin(), other.insideBricks.end());
+                partialCells.insert(partialCells.end(), other.partialCells.begin(), other.partialCells.end());
+                partialBricks.insert(partialBricks.end(), other.partialBricks.begin(), other.partialBricks.end());
+            }
         };
 
         class FrustumSelector {
@@ -473,8 +480,13 @@ namespace render {
             }
         };
 
+        // The octants of the root and the bricks of large selections are processed in parallel, and their results are
+        // gathered in traversal order, so the selection is the same as a serial traversal would give.
         int selectCellItems(ItemSelection& selection, const ItemFilter& filter, const ViewFrustum& frustum, 
                             float threshold) const;
+
+    private:
+        void gatherBrickItems(const Indices& bricks, ItemIDs& items, ItemIDs& subcellItems) const;
     };
 }
 
@@ -1087,6 +1087,7 @@ void ScriptManager::run() {
         }
 
         qint64 now = usecTimestampNow();
+        _lastHeartbeat = now;
 
         // we check for 'now' in the past in case people set their clock back
         if (_emitScriptUpdates() && _lastUpdate < now) {
@@ -1937,6 +1938,20 @@ int ScriptManager::getNumRunningEntityScripts() const {
     return sum;
 }
 
+QHash<EntityItemID, std::chrono::microseconds> ScriptManager::getEntityScriptExecutionTimes() const {
+    std::lock_guard<std::mutex> lock(_entityScriptExecutionTimesLock);
+    return _entityScriptExecutionTimes;
+}
+
+quint64 ScriptManager::getUsecsSinceLastHeartbeat() const {
+    quint64 lastHeartbeat = _lastHeartbeat;
+    if (lastHeartbeat == 0 || _isFinished) {
+        return 0;
+    }
+    quint64 now = usecTimestampNow();
+    return now > lastHeartbeat ? now - lastHeartbeat : 0;
+}
+
 void ScriptManager::setEntityScriptDetails(const EntityItemID& entityID, const EntityScriptDetails& details) {
     {
         QWriteLocker locker { &_entityScriptsLock };
@@ -2474,6 +2489,10 @@ void ScriptManager::unloadEntityScript(const EntityItemID& entityID, bool should
                 QWriteLocker locker { &_entityScriptsLock };
                 _entityScripts.remove(entityID);
             }
+            {
+                std::lock_guard<std::mutex> lock(_entityScriptExecutionTimesLock);
+                _entityScriptExecutionTimes.remove(entityID);
+            }
             emit entityScriptDetailsUpdated();
         } else if (oldDetails.status != EntityScriptStatus::UNLOADED) {
             EntityScriptDetails newDetails;
@@ -2520,6 +2539,10 @@ void ScriptManager::unloadAllEntityScripts(bool blockingCall) {
         QWriteLocker locker{ &_entityScriptsLock };
         _entityScripts.clear();
     }
+    {
+        std::lock_guard<std::mutex> lock(_entityScriptExecutionTimesLock);
+        _entityScriptExecutionTimes.clear();
+    }
     emit entityScriptDetailsUpdated();
 
 #ifdef DEBUG_ENGINE_STATE
@@ -2569,6 +2592,10 @@ void ScriptManager::doWithEnvironment(const EntityItemID& entityID, const QUrl&
     currentEntityIdentifier = entityID;
     currentSandboxURL = sandboxURL;
 
+    // only account for the outermost entity environment, so nested calls aren't counted twice
+    bool accountExecutionTime = !entityID.isInvalidID() && oldIdentifier.isInvalidID();
+    auto startTime = p_high_resolution_clock::now();
+
 #if DEBUG_CURRENT_ENTITY
     ScriptValue oldData = this->globalObject().property("debugEntityID");
     this->globalObject().setProperty("debugEntityID", entityID.toScriptValue(this)); // Make the entityID available to javascript as a global.
@@ -2579,6 +2606,12 @@ void ScriptManager::doWithEnvironment(const EntityItemID& entityID, const QUrl&
 #endif
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
+
+    if (accountExecutionTime) {
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - startTime);
+        std::lock_guard<std::mutex> lock(_entityScriptExecutionTimesLock);
+        _entityScriptExecutionTimes[entityID] += elapsed;
+    }
 }
 
 void ScriptManager::callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, const ScriptValue& function, const ScriptValue& thisObject, const ScriptValueList& args) {
@@ -1136,6 +1136,26 @@ public:
      */
     int getNumRunningEntityScripts() const;
 
+    /**
+     * @brief Get the accumulated execution time of each entity script
+     *
+     * Time is accumulated every time code runs in the environment of an entity (preload, method calls,
+     * timers and signal handlers). The returned values are totals since the script was loaded, so callers
+     * wanting a rate should diff two snapshots.
+     *
+     * @return QHash<EntityItemID, std::chrono::microseconds> Execution time per entity ID
+     */
+    QHash<EntityItemID, std::chrono::microseconds> getEntityScriptExecutionTimes() const;
+
+    /**
+     * @brief Time elapsed since the script thread last went through its event loop
+     *
+     * This may be called from any thread, and is used by watchdogs to detect a script that is blocking its thread.
+     *
+     * @return quint64 Microseconds since the last iteration of the event loop, or 0 if the script isn't running
+     */
+    quint64 getUsecsSinceLastHeartbeat() const;
+
     /**
      * @brief Retrieves the details about an entity script
      *
@@ -1649,6 +1669,10 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    mutable std::mutex _entityScriptExecutionTimesLock;
+    QHash<EntityItemID, std::chrono::microseconds> _entityScriptExecutionTimes;
+    std::atomic<quint64> _lastHeartbeat { 0 };
+
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
     Setting::Handle<bool> _enableExtendedJSExceptions { _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS, true };
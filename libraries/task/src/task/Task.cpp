@@ -10,8 +10,18 @@
 //
 #include "Task.h"
 
+#include <tbb/task_group.h>
+
 using namespace task;
 
+void task::runConcurrently(const std::vector<std::function<void()>>& functions) {
+    tbb::task_group group;
+    for (const auto& function : functions) {
+        group.run(function);
+    }
+    group.wait();
+}
+
 JobContext::JobContext() {
 }
 
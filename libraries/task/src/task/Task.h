@@ -17,7 +17,9 @@
 #include "Config.h"
 #include "Varying.h"
 
+#include <functional>
 #include <unordered_map>
+#include <vector>
 
 namespace task {
 
@@ -46,6 +48,9 @@ protected:
     bool _doAbortTask{ false };
 };
 
+// Runs the functions on the worker threads and returns once all of them are done
+void runConcurrently(const std::vector<std::function<void()>>& functions);
+
 // JobContext class is the base class for the context object which is passed through all the Job::run calls thoughout the graph of jobs
 // It is used to communicate to the job::run its context and various state information the job relies on.
 // It specifically provide access to:
@@ -499,6 +504,92 @@ public:
     }
 };
 
+// A Parallel is a specialized task whose jobs don't depend on each other, so they run concurrently
+// It can be created on any type T by aliasing the type JobModel in the class T
+// using JobModel = Parallel::Model<T>
+// The class T is expected to have a "build" method acting as a constructor.
+// The build method is where the independent child Jobs (usually Tasks, one per branch of work) are added
+// None of the jobs may take an input produced by another job of the same Parallel
+// Every job runs with its own copy of the context, so the context type has to be copyable
+template <class JC, class TP>
+class Parallel : public Job<JC, TP> {
+public:
+    using Context = JC;
+    using TimeProfiler = TP;
+    using ContextPointer = std::shared_ptr<Context>;
+    using Config = JobConfig;
+    using JobType = Job<JC, TP>;
+    using None = typename JobType::None;
+    using Concept = typename JobType::Concept;
+    using ConceptPointer = typename JobType::ConceptPointer;
+    using TaskConcept = typename Task<JC, TP>::TaskConcept;
+
+    Parallel(ConceptPointer conceptPtr) : JobType(conceptPtr) {}
+
+    template <class T, class C = Config, class I = None, class O = None> class ParallelModel : public TaskConcept {
+    public:
+        using Data = T;
+        using Input = I;
+        using Output = O;
+
+        Data _data;
+
+        ParallelModel(const std::string& name, const Varying& input, QConfigPointer config) :
+            TaskConcept(name, input, config),
+            _data(Data()) {}
+
+        template <class... A>
+        static std::shared_ptr<ParallelModel> create(const std::string& name, const Varying& input, A&&... args) {
+            auto model = std::make_shared<ParallelModel>(name, input, std::make_shared<C>());
+
+            {
+                TimeProfiler probe("build::" + model->getName());
+                model->_data.build(*(model), model->_input, model->_output, std::forward<A>(args)...);
+            }
+
+            return model;
+        }
+
+        template <class... A>
+        static std::shared_ptr<ParallelModel> create(const std::string& name, A&&... args) {
+            const auto input = Varying(Input());
+            return create(name, input, std::forward<A>(args)...);
+        }
+
+        void applyConfiguration() override {
+            TimeProfiler probe("configure::" + JobConcept::getName());
+            jobConfigure(_data, *std::static_pointer_cast<C>(Concept::_config));
+            for (auto& job : TaskConcept::_jobs) {
+                job.applyConfiguration();
+            }
+        }
+
+        void run(const ContextPointer& jobContext) override {
+            auto config = std::static_pointer_cast<C>(Concept::_config);
+            if (config->isEnabled()) {
+                std::vector<std::function<void()>> jobs;
+                for (auto& job : TaskConcept::_jobs) {
+                    jobs.push_back([&job, &jobContext] {
+                        // The context holds the config of the job being run, and the task flow of its task
+                        auto branchContext = std::make_shared<Context>(*jobContext);
+                        branchContext->taskFlow.reset();
+                        job.run(branchContext);
+                    });
+                }
+                runConcurrently(jobs);
+            }
+        }
+    };
+    template <class T, class C = Config> using Model = ParallelModel<T, C, None, None>;
+    template <class T, class I, class C = Config> using ModelI = ParallelModel<T, C, I, None>;
+    template <class T, class O, class C = Config> using ModelO = ParallelModel<T, C, None, O>;
+    template <class T, class I, class O, class C = Config> using ModelIO = ParallelModel<T, C, I, O>;
+
+    std::shared_ptr<Config> getConfiguration() {
+        return std::static_pointer_cast<Config>(JobType::_conceptPtr->getConfiguration());
+    }
+};
+
 template <class JC, class TP>
 class Engine : public Task<JC, TP> {
 public:
@@ -539,6 +630,7 @@ protected:
     using Job = task::Job<ContextType, TimeProfiler>; \
     using Switch = task::Switch<ContextType, TimeProfiler>; \
     using Task = task::Task<ContextType, TimeProfiler>; \
+    using Parallel = task::Parallel<ContextType, TimeProfiler>; \
     using Engine = task::Engine<ContextType, TimeProfiler>; \
     using Varying = task::Varying; \
     template < typename T0, typename T1 > using VaryingSet2 = task::VaryingSet2<T0, T1>; \
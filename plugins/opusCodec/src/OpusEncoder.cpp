@@ -57,6 +57,9 @@ AthenaOpusEncoder::AthenaOpusEncoder(int sampleRate, int numChannels) {
     setComplexity(DEFAULT_COMPLEXITY);
     setApplication(DEFAULT_APPLICATION);
     setSignal(DEFAULT_SIGNAL);
+    setVBR(DEFAULT_VBR);
+    setVBRConstraint(DEFAULT_VBR_CONSTRAINT);
+    setDTX(DEFAULT_DTX);
 
     qCDebug(encoder) << "Opus encoder initialized, sampleRate = " << sampleRate << "; numChannels = " << numChannels;
 }
@@ -80,8 +83,20 @@ void AthenaOpusEncoder::encode(const QByteArray& decodedBuffer, QByteArray& enco
 
     if (bytes >= 0) {
         encodedBuffer.resize(bytes);
+
+        // through a pause, DTX sends a comfort noise update about every 400 msecs between frames that need not be
+        // sent at all. Both are elided as silent, so that a receiver, which plays silent frames as zeros, doesn't
+        // hear the pause broken by a frame of noise every 400 msecs.
+#ifdef OPUS_GET_IN_DTX_REQUEST
+        opus_int32 inDTX = 0;
+        opus_encoder_ctl(_encoder, OPUS_GET_IN_DTX(&inDTX));
+        _lastFrameSilent = inDTX != 0 || bytes <= DTX_MAX_BYTES;
+#else
+        _lastFrameSilent = bytes <= DTX_MAX_BYTES;
+#endif
     } else {
         encodedBuffer.resize(0);
+        _lastFrameSilent = false;
 
         qCWarning(encoder) << "Error when encoding " << decodedBuffer.length() << " bytes of audio: "
             << errorToString(bytes);
@@ -21,13 +21,14 @@ public:
     ~AthenaOpusEncoder() override;
 
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override;
+    virtual bool isLastFrameSilent() const override { return _lastFrameSilent; }
 
 
     int getComplexity() const;
     void setComplexity(int complexity);
 
     int getBitrate() const;
-    void setBitrate(int bitrate);
+    void setBitrate(int bitrate) override;
 
     int getVBR() const;
     void setVBR(int vbr);
@@ -56,7 +57,7 @@ public:
     void setExpectedPacketLossPercentage(int percentage);
 
     int getDTX() const;
-    void setDTX(int dtx);
+    void setDTX(int dtx) override;
 
 
 private:
@@ -66,9 +67,19 @@ private:
     const int DEFAULT_APPLICATION = OPUS_APPLICATION_VOIP;
     const int DEFAULT_SIGNAL = OPUS_AUTO;
 
+    // voice is mostly pauses: spend bits only where the signal needs them, and next to none on silence
+    const int DEFAULT_VBR = 1;
+    const int DEFAULT_VBR_CONSTRAINT = 0;
+    const int DEFAULT_DTX = 1;
+
+    // with DTX, opus_encode() returns a packet this small when it need not be sent; on opus builds without
+    // OPUS_GET_IN_DTX, this is all that tells a DTX frame apart
+    const int DTX_MAX_BYTES = 2;
+
     int _opusSampleRate = 0;
     int _opusChannels = 0;
     int _opusExpectedLoss = 0;
+    bool _lastFrameSilent = false;
 
 
     OpusEncoder* _encoder = nullptr;
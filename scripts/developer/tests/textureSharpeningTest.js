@@ -0,0 +1,86 @@
+//
+//  textureSharpeningTest.js
+//  scripts/developer/tests
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Moves your avatar along a fixed path through the domain and reports how long textures take to reach their full
+//  resolution, along with how much of the mip streaming budget they use. Run it in a freshly loaded domain with an
+//  empty texture cache to compare settings or builds.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+(function () {
+    var SPEED = 4.0; // meters per second
+    var REPORT_INTERVAL = 1000; // milliseconds
+    var ARRIVAL_DISTANCE = 0.5; // meters
+
+    // Square path of 40 meters sides from where the avatar starts, facing the way the camera does
+    var SIDE = 40.0;
+    var start = MyAvatar.position;
+    var forward = Vec3.normalize(Vec3.multiplyVbyV(Quat.getForward(Camera.orientation), { x: 1, y: 0, z: 1 }));
+    var right = Vec3.cross(forward, Vec3.UNIT_Y);
+    var waypoints = [
+        Vec3.sum(start, Vec3.multiply(SIDE, forward)),
+        Vec3.sum(start, Vec3.sum(Vec3.multiply(SIDE, forward), Vec3.multiply(SIDE, right))),
+        Vec3.sum(start, Vec3.multiply(SIDE, right)),
+        start
+    ];
+    var nextWaypoint = 0;
+
+    var previousMotorReferenceFrame = MyAvatar.motorReferenceFrame;
+    var previousMotorVelocity = MyAvatar.motorVelocity;
+    var previousMotorTimescale = MyAvatar.motorTimescale;
+    MyAvatar.motorReferenceFrame = "world";
+    MyAvatar.motorTimescale = 0.1;
+
+    var startTime = Date.now();
+
+    function report(label) {
+        var stats = TextureCache.getMipStreamingStats();
+        print(label + " after " + ((Date.now() - startTime) / 1000).toFixed(1) + "s:" +
+            " sharpened " + stats.numSharpened +
+            ", average latency " + stats.averageSharpeningLatency.toFixed(0) + "ms" +
+            ", streamed " + (stats.streamedBytes / (1024 * 1024)).toFixed(1) + "MB" +
+            " of " + (stats.budget / (1024 * 1024)).toFixed(0) + "MB" +
+            ", waiting for budget " + stats.numWaitingForBudget +
+            ", loading " + TextureCache.numGlobalQueriesLoading +
+            ", pending " + TextureCache.numGlobalQueriesPending);
+    }
+
+    function update() {
+        if (nextWaypoint >= waypoints.length) {
+            return;
+        }
+
+        var toWaypoint = Vec3.subtract(waypoints[nextWaypoint], MyAvatar.position);
+        toWaypoint.y = 0;
+        if (Vec3.length(toWaypoint) < ARRIVAL_DISTANCE) {
+            nextWaypoint++;
+            if (nextWaypoint >= waypoints.length) {
+                MyAvatar.motorVelocity = Vec3.ZERO;
+                report("Path done");
+            }
+            return;
+        }
+        MyAvatar.motorVelocity = Vec3.multiply(SPEED, Vec3.normalize(toWaypoint));
+    }
+
+    var reportTimer = Script.setInterval(function () {
+        report("Streaming");
+    }, REPORT_INTERVAL);
+
+    Script.update.connect(update);
+
+    Script.scriptEnding.connect(function () {
+        Script.clearInterval(reportTimer);
+        Script.update.disconnect(update);
+        MyAvatar.motorVelocity = previousMotorVelocity;
+        MyAvatar.motorTimescale = previousMotorTimescale;
+        MyAvatar.motorReferenceFrame = previousMotorReferenceFrame;
+        report("Final");
+    });
+}());
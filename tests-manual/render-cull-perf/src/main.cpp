@@ -0,0 +1,162 @@
+//
+//  main.cpp
+//  tests-manual/render-cull-perf/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+// Times the CPU side of the render fetch / cull / sort stages for a scene of many items, with one thread and with all
+// of them. No GPU is needed: the items are plain payloads and only the spatial stages run.
+
+#include <random>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+
+#include <NumericalConstants.h>
+#include <render/CullTask.h>
+#include <render/Engine.h>
+#include <render/SortTask.h>
+
+const int NUM_ITEMS = 100000;
+const int NUM_VIEWS = 16;
+const int NUM_FRAMES = 10;
+const float WORLD_SIZE = 2000.0f;
+
+struct CullPerfItem {
+    using Pointer = std::shared_ptr<CullPerfItem>;
+    AABox bound;
+};
+
+namespace render {
+template <> const ItemKey payloadGetKey(const CullPerfItem::Pointer& item) {
+    return ItemKey::Builder::opaqueShape().build();
+}
+template <> const Item::Bound payloadGetBound(const CullPerfItem::Pointer& item, RenderArgs* args) {
+    return item->bound;
+}
+}
+
+static render::ScenePointer buildScene() {
+    std::mt19937 randomGenerator(1234);
+    std::uniform_real_distribution<float> position(-WORLD_SIZE / 2.0f, WORLD_SIZE / 2.0f);
+    std::uniform_real_distribution<float> size(0.05f, 10.0f);
+
+    auto scene = std::make_shared<render::Scene>(glm::vec3(-WORLD_SIZE), 2.0f * WORLD_SIZE);
+    render::Transaction transaction;
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        auto item = std::make_shared<CullPerfItem>();
+        item->bound = AABox(glm::vec3(position(randomGenerator), position(randomGenerator), position(randomGenerator)),
+                            size(randomGenerator));
+        transaction.resetItem(scene->allocateID(), std::make_shared<render::Payload<CullPerfItem>>(item));
+    }
+    scene->enqueueTransaction(transaction);
+    scene->processTransactionQueue();
+    return scene;
+}
+
+static std::vector<ViewFrustum> buildViews() {
+    std::vector<ViewFrustum> views(NUM_VIEWS);
+    for (int i = 0; i < NUM_VIEWS; i++) {
+        float angle = TWO_PI * (float)i / (float)NUM_VIEWS;
+        views[i].setProjection(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, WORLD_SIZE));
+        views[i].setPosition(glm::vec3(0.0f, 2.0f, 0.0f));
+        views[i].setOrientation(glm::angleAxis(angle, Vectors::UNIT_Y));
+        views[i].calculate();
+    }
+    return views;
+}
+
+// Runs fetch, cull and sort for every view, and returns the sorted items of each
+static std::vector<render::ItemBounds> runViews(const render::ScenePointer& scene, const std::vector<ViewFrustum>& views,
+                                                double& msPerView) {
+    using namespace render;
+
+    auto solidAngleCull = [](const RenderArgs* args, const AABox& bounds) {
+        const float MIN_SOLID_ANGLE_HALF_TAN = 0.01f;
+        float distance = glm::distance(args->getViewFrustum().getPosition(), bounds.calcCenter());
+        return bounds.getLargestDimension() > MIN_SOLID_ANGLE_HALF_TAN * distance;
+    };
+
+    auto filter = ItemFilter::Builder::opaqueShape().build();
+    auto fetch = FetchSpatialTree::JobModel::create("fetch", FetchSpatialTree::Inputs(filter, glm::ivec2(0, 0)));
+    auto cull = CullSpatialSelection::JobModel::create("cull",
+        CullSpatialSelection::Inputs(fetch->getOutput(), filter), solidAngleCull, false, RenderDetails::ITEM);
+    auto sort = DepthSortItems::JobModel::create("sort", cull->getOutput(), true);
+
+    RenderArgs args;
+    auto renderContext = std::make_shared<RenderContext>();
+    renderContext->args = &args;
+    renderContext->_scene = scene;
+
+    std::vector<ItemBounds> results(views.size());
+    QElapsedTimer timer;
+    timer.start();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        for (size_t i = 0; i < views.size(); i++) {
+            args.pushViewFrustum(views[i]);
+            fetch->run(renderContext);
+            cull->run(renderContext);
+            sort->run(renderContext);
+            args.popViewFrustum();
+            results[i] = sort->getOutput().get<ItemBounds>();
+        }
+    }
+    msPerView = (double)timer.nsecsElapsed() / (double)NSECS_PER_MSEC / (double)(NUM_FRAMES * views.size());
+    return results;
+}
+
+static bool sameResults(const std::vector<render::ItemBounds>& left, const std::vector<render::ItemBounds>& right) {
+    for (size_t i = 0; i < left.size(); i++) {
+        if (left[i].size() != right[i].size()) {
+            return false;
+        }
+        for (size_t j = 0; j < left[i].size(); j++) {
+            if (left[i][j].id != right[i][j].id) {
+                return false;
+            }
+        }
+    }
+    return left.size() == right.size();
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+
+    auto scene = buildScene();
+    auto views = buildViews();
+
+    double serialMsPerView;
+    std::vector<render::ItemBounds> serialResults;
+    {
+        tbb::global_control serial(tbb::global_control::max_allowed_parallelism, 1);
+        serialResults = runViews(scene, views, serialMsPerView);
+    }
+
+    int numThreads = tbb::this_task_arena::max_concurrency();
+    double parallelMsPerView;
+    auto parallelResults = runViews(scene, views, parallelMsPerView);
+
+    size_t numRendered = 0;
+    for (const auto& items : parallelResults) {
+        numRendered += items.size();
+    }
+    qInfo() << NUM_ITEMS << "items," << numRendered / views.size() << "rendered per view on average";
+    qInfo() << "fetch, cull and sort:" << serialMsPerView << "ms per view on 1 thread," << parallelMsPerView
+            << "ms per view on" << numThreads << "threads";
+
+    if (!sameResults(serialResults, parallelResults)) {
+        qWarning() << "parallel results differ from the serial ones";
+        return 1;
+    }
+    return 0;
+}
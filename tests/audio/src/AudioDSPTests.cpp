@@ -0,0 +1,228 @@
+//
+//  AudioDSPTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AudioDSPTests.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+#include <AudioLimiter.h>
+#include <AudioReverb.h>
+
+QTEST_MAIN(AudioDSPTests)
+
+static const int SAMPLE_RATE = 48000;
+
+// a burst of noise followed by silence, deinterleaved stereo
+static void makeBurst(std::vector<float>& left, std::vector<float>& right, int numFrames, int burstFrames) {
+    left.assign(numFrames, 0.0f);
+    right.assign(numFrames, 0.0f);
+
+    uint32_t r = 1;
+    for (int i = 0; i < burstFrames; i++) {
+        r = r * 1664525 + 1013904223;
+        left[i] = (int32_t)r * (0.5f / 2147483648.0f);
+        r = r * 1664525 + 1013904223;
+        right[i] = (int32_t)r * (0.5f / 2147483648.0f);
+    }
+}
+
+// renders the input through a new reverb, blockSize frames at a time
+static void renderReverb(const ReverbParameters& params, const std::vector<float>& left, const std::vector<float>& right,
+                         std::vector<float>& outLeft, std::vector<float>& outRight, int blockSize) {
+    AudioReverb reverb(SAMPLE_RATE);
+    ReverbParameters p = params;
+    reverb.setParameters(&p);
+
+    int numFrames = (int)left.size();
+    outLeft.assign(numFrames, 0.0f);
+    outRight.assign(numFrames, 0.0f);
+
+    for (int i = 0; i < numFrames; i += blockSize) {
+        int n = std::min(blockSize, numFrames - i);
+        float* inputs[2] = { const_cast<float*>(&left[i]), const_cast<float*>(&right[i]) };
+        float* outputs[2] = { &outLeft[i], &outRight[i] };
+        reverb.render(inputs, outputs, n);
+    }
+}
+
+static float maxDifference(const std::vector<float>& a, const std::vector<float>& b) {
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < a.size(); i++) {
+        maxDiff = std::max(maxDiff, fabsf(a[i] - b[i]));
+    }
+    return maxDiff;
+}
+
+static float peak(const std::vector<float>& a) {
+    float peak = 0.0f;
+    for (float x : a) {
+        peak = std::max(peak, fabsf(x));
+    }
+    return peak;
+}
+
+static ReverbParameters defaultReverbParameters() {
+    AudioReverb reverb(SAMPLE_RATE);
+    ReverbParameters p;
+    reverb.getParameters(&p);
+    return p;
+}
+
+// the late network runs in blocks bounded by its loop delays, and the vector kernels take 8 samples at a time,
+// so the output must not depend on how the caller splits up the audio
+void AudioDSPTests::reverbBlockSizes() {
+    std::vector<float> left, right;
+    makeBurst(left, right, SAMPLE_RATE, SAMPLE_RATE / 10);
+
+    ReverbParameters p = defaultReverbParameters();
+
+    std::vector<float> refLeft, refRight;
+    renderReverb(p, left, right, refLeft, refRight, 1);
+    QVERIFY(peak(refLeft) > 0.01f);
+    QVERIFY(peak(refRight) > 0.01f);
+
+    // the reverb tail is still ringing after the burst
+    std::vector<float> tail(refLeft.begin() + SAMPLE_RATE / 2, refLeft.end());
+    QVERIFY(peak(tail) > 1.0e-4f);
+
+    for (int blockSize : { 7, 240, 256, 480, 1000, SAMPLE_RATE }) {
+        std::vector<float> outLeft, outRight;
+        renderReverb(p, left, right, outLeft, outRight, blockSize);
+        QVERIFY2(maxDifference(refLeft, outLeft) < 1.0e-4f, qPrintable(QString("block size %1").arg(blockSize)));
+        QVERIFY2(maxDifference(refRight, outRight) < 1.0e-4f, qPrintable(QString("block size %1").arg(blockSize)));
+    }
+}
+
+// with low density, loop delays can be too short to process a block at a time
+void AudioDSPTests::reverbShortLoops() {
+    std::vector<float> left, right;
+    makeBurst(left, right, SAMPLE_RATE / 2, SAMPLE_RATE / 10);
+
+    for (float density : { 0.0f, 80.0f }) {
+        ReverbParameters p = defaultReverbParameters();
+        p.density = density;
+        p.roomSize = 0.0f;
+        p.lateDelay = 2.0f;
+
+        std::vector<float> refLeft, refRight, outLeft, outRight;
+        renderReverb(p, left, right, refLeft, refRight, 1);
+        renderReverb(p, left, right, outLeft, outRight, 480);
+
+        QVERIFY(peak(refLeft) > 0.01f);
+        QVERIFY(maxDifference(refLeft, outLeft) < 1.0e-4f);
+        QVERIFY(maxDifference(refRight, outRight) < 1.0e-4f);
+    }
+}
+
+// below threshold, the limiter is a delay of N-1 frames and the makeup gain, plus dither
+void AudioDSPTests::limiterDelaysAndScales() {
+    const int DELAY = 63;   // 48kHz lookahead
+    const float GAIN = 32768.0f * 0.966051f;    // -0.3dB ceiling, at 0dB threshold
+    const int NUM_FRAMES = 4800;
+
+    for (int numChannels : { 1, 2, 4 }) {
+        AudioLimiter limiter(SAMPLE_RATE, numChannels);
+
+        std::vector<float> input(NUM_FRAMES * numChannels);
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            for (int j = 0; j < numChannels; j++) {
+                input[numChannels * i + j] = 0.25f * sinf(0.01f * i * (j + 1));
+            }
+        }
+
+        // in uneven blocks, to cover the delay history and the vector tails
+        std::vector<int16_t> output(NUM_FRAMES * numChannels);
+        for (int i = 0, n = 1; i < NUM_FRAMES; i += n, n = n * 3 % 509) {
+            n = std::min(n, NUM_FRAMES - i);
+            limiter.render(&input[numChannels * i], &output[numChannels * i], n);
+        }
+
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            for (int j = 0; j < numChannels; j++) {
+                float expected = (i < DELAY) ? 0.0f : input[numChannels * (i - DELAY) + j] * GAIN;
+                float actual = output[numChannels * i + j];
+                QVERIFY2(fabsf(actual - expected) <= 2.0f + 0.001f * fabsf(expected),
+                         qPrintable(QString("channels %1 frame %2: %3 vs %4").arg(numChannels).arg(i).arg(actual).arg(expected)));
+            }
+        }
+    }
+}
+
+// far above threshold, the output never exceeds the ceiling
+void AudioDSPTests::limiterCeiling() {
+    const int CEILING = (int)(32768.0f * 0.966051f) + 2;    // allow for dither
+    const int NUM_FRAMES = SAMPLE_RATE;
+
+    for (int numChannels : { 1, 2, 4 }) {
+        AudioLimiter limiter(SAMPLE_RATE, numChannels);
+        limiter.setThreshold(-12.0f);
+
+        std::vector<float> input(NUM_FRAMES * numChannels);
+        uint32_t r = 1;
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            float envelope = 8.0f * fabsf(sinf(0.0005f * i));
+            for (int j = 0; j < numChannels; j++) {
+                r = r * 1664525 + 1013904223;
+                input[numChannels * i + j] = envelope * (int32_t)r * (1.0f / 2147483648.0f);
+            }
+        }
+
+        std::vector<int16_t> output(NUM_FRAMES * numChannels);
+        for (int i = 0; i < NUM_FRAMES; i += 480) {
+            limiter.render(&input[numChannels * i], &output[numChannels * i], 480);
+        }
+
+        int maxOutput = 0;
+        for (int16_t y : output) {
+            maxOutput = std::max(maxOutput, abs(y));
+        }
+        QVERIFY2(maxOutput <= CEILING, qPrintable(QString("channels %1: peak %2").arg(numChannels).arg(maxOutput)));
+        QVERIFY(maxOutput > CEILING / 2);
+    }
+}
+
+void AudioDSPTests::benchmarkReverb() {
+    const int NUM_FRAMES = 480;
+
+    std::vector<float> left, right;
+    makeBurst(left, right, NUM_FRAMES, NUM_FRAMES);
+
+    AudioReverb reverb(SAMPLE_RATE);
+    std::vector<float> outLeft(NUM_FRAMES), outRight(NUM_FRAMES);
+    float* inputs[2] = { left.data(), right.data() };
+    float* outputs[2] = { outLeft.data(), outRight.data() };
+
+    QBENCHMARK {
+        reverb.render(inputs, outputs, NUM_FRAMES);
+    }
+}
+
+void AudioDSPTests::benchmarkLimiter() {
+    const int NUM_FRAMES = 480;
+
+    AudioLimiter limiter(SAMPLE_RATE, 2);
+    limiter.setThreshold(-6.0f);
+
+    std::vector<float> input(NUM_FRAMES * 2);
+    uint32_t r = 1;
+    for (float& x : input) {
+        r = r * 1664525 + 1013904223;
+        x = (int32_t)r * (1.0f / 2147483648.0f);
+    }
+    std::vector<int16_t> output(NUM_FRAMES * 2);
+
+    QBENCHMARK {
+        limiter.render(input.data(), output.data(), NUM_FRAMES);
+    }
+}
@@ -0,0 +1,29 @@
+//
+//  AudioDSPTests.h
+//  tests/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_AudioDSPTests_h
+#define hifi_AudioDSPTests_h
+
+#include <QtTest/QtTest>
+
+class AudioDSPTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void reverbBlockSizes();
+    void reverbShortLoops();
+    void limiterDelaysAndScales();
+    void limiterCeiling();
+    void benchmarkReverb();
+    void benchmarkLimiter();
+};
+
+#endif // hifi_AudioDSPTests_h
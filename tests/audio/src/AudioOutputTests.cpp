@@ -0,0 +1,345 @@
+//
+//  AudioOutputTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "AudioOutputTests.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <AudioIOStats.h>
+#include <AudioOutputIODevice.h>
+#include <AudioSPSCRingBuffer.h>
+#include <MixedProcessedAudioStream.h>
+#include <NullAudioOutput.h>
+
+QTEST_MAIN(AudioOutputTests)
+
+static const int SAMPLE_RATE = 48000;
+static const int PERIOD_FRAMES = 240;
+
+static QAudioFormat stereoFormat() {
+    QAudioFormat format;
+    format.setSampleRate(SAMPLE_RATE);
+    format.setSampleSize(16);
+    format.setCodec("audio/pcm");
+    format.setSampleType(QAudioFormat::SignedInt);
+    format.setByteOrder(QAudioFormat::LittleEndian);
+    format.setChannelCount(2);
+    return format;
+}
+
+// Plays the role of AudioClient's output device: each read takes what the producer has buffered, and pads the rest
+// with silence. Every sample read is kept, to check against what was written.
+class RingBufferDevice : public QIODevice {
+public:
+    RingBufferDevice(AudioSPSCRingBuffer<int16_t>& ringBuffer, int maxSamples, int stallEvery = 0, int stallUsecs = 0) :
+        _ringBuffer(ringBuffer), _stallEvery(stallEvery), _stallUsecs(stallUsecs) {
+        _samplesRead.reserve(maxSamples);
+        open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    }
+
+    // safe to call while reading
+    int getNumSamplesRead() const { return _numSamplesRead; }
+
+    const std::vector<int16_t>& getSamplesRead() const { return _samplesRead; }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override {
+        int16_t* samples = (int16_t*)data;
+        int maxSamples = (int)(maxSize / sizeof(int16_t));
+
+        int numSamples = _ringBuffer.readSamples(samples, maxSamples);
+        if ((int)(_samplesRead.size() + numSamples) <= (int)_samplesRead.capacity()) {
+            _samplesRead.insert(_samplesRead.end(), samples, samples + numSamples);
+            _numSamplesRead = (int)_samplesRead.size();
+        }
+        memset(&samples[numSamples], 0, (maxSamples - numSamples) * sizeof(int16_t));
+
+        if (_stallEvery > 0 && (++_numReads % _stallEvery) == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(_stallUsecs));
+        }
+        return maxSize;
+    }
+    qint64 writeData(const char* data, qint64 maxSize) override { return 0; }
+
+private:
+    AudioSPSCRingBuffer<int16_t>& _ringBuffer;
+    std::vector<int16_t> _samplesRead;
+    std::atomic<int> _numSamplesRead { 0 };
+    int _stallEvery;
+    int _stallUsecs;
+    int _numReads { 0 };
+};
+
+void AudioOutputTests::ringBufferWraps() {
+    AudioSPSCRingBuffer<float> ringBuffer(100);
+    QCOMPARE(ringBuffer.getSampleCapacity(), 100);
+    QCOMPARE(ringBuffer.samplesAvailable(), 0);
+    QCOMPARE(ringBuffer.spaceAvailable(), 100);
+
+    float input[150];
+    float output[150];
+    for (int i = 0; i < 150; i++) {
+        input[i] = (float)i;
+    }
+
+    for (int pass = 0; pass < 20; pass++) {
+
+        // write more than fits, across the end of the buffer
+        QCOMPARE(ringBuffer.writeSamples(input, 73), 73);
+        QCOMPARE(ringBuffer.writeSamples(&input[73], 50), 27);
+        QCOMPARE(ringBuffer.samplesAvailable(), 100);
+        QCOMPARE(ringBuffer.spaceAvailable(), 0);
+
+        // read it back in two pieces
+        QCOMPARE(ringBuffer.readSamples(output, 43), 43);
+        QCOMPARE(ringBuffer.readSamples(&output[43], 150), 57);
+        QCOMPARE(ringBuffer.samplesAvailable(), 0);
+        for (int i = 0; i < 100; i++) {
+            QCOMPARE(output[i], input[i]);
+        }
+
+        // shift where the next pass starts
+        QCOMPARE(ringBuffer.writeSamples(input, 37), 37);
+        QCOMPARE(ringBuffer.readSamples(output, 37), 37);
+    }
+    QCOMPARE(ringBuffer.getOverflowCount(), 20 * 23);
+
+    // appending mixes into what is already there
+    for (int i = 0; i < 10; i++) {
+        output[i] = 1.0f;
+    }
+    ringBuffer.writeSamples(input, 10);
+    QCOMPARE(ringBuffer.appendSamples(output, 10), 10);
+    for (int i = 0; i < 10; i++) {
+        QCOMPARE(output[i], input[i] + 1.0f);
+    }
+
+    // resizing discards what was buffered
+    ringBuffer.writeSamples(input, 10);
+    ringBuffer.resize(20);
+    QCOMPARE(ringBuffer.getSampleCapacity(), 20);
+    QCOMPARE(ringBuffer.samplesAvailable(), 0);
+    QCOMPARE(ringBuffer.getOverflowCount(), 0);
+}
+
+void AudioOutputTests::ringBufferThreads() {
+    const int NUM_SAMPLES = 1 << 22;
+    AudioSPSCRingBuffer<int32_t> ringBuffer(1000);
+
+    // writes a count, in varying lengths
+    std::thread producer([&] {
+        int32_t chunk[311];
+        int32_t next = 0;
+        int length = 1;
+        while (next < NUM_SAMPLES) {
+            length = (length * 7 + 3) % 311 + 1;
+            int n = std::min(length, NUM_SAMPLES - next);
+            for (int i = 0; i < n; i++) {
+                chunk[i] = next + i;
+            }
+            int written = 0;
+            while (written < n) {
+                int space = std::min(ringBuffer.spaceAvailable(), n - written);
+                if (space == 0) {
+                    std::this_thread::yield();
+                }
+                written += ringBuffer.writeSamples(&chunk[written], space);
+            }
+            next += n;
+        }
+    });
+
+    // reads it back, in other lengths, and checks nothing is lost or repeated
+    int32_t chunk[257];
+    int32_t next = 0;
+    int length = 1;
+    bool inOrder = true;
+    while (next < NUM_SAMPLES) {
+        length = (length * 5 + 1) % 257 + 1;
+        int n = ringBuffer.readSamples(chunk, length);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (int i = 0; i < n; i++) {
+            inOrder &= (chunk[i] == next + i);
+        }
+        next += n;
+    }
+    producer.join();
+
+    QVERIFY(inOrder);
+    QCOMPARE(ringBuffer.samplesAvailable(), 0);
+    QCOMPARE(ringBuffer.getOverflowCount(), 0);
+}
+
+void AudioOutputTests::nullOutputPacing() {
+    AudioSPSCRingBuffer<int16_t> ringBuffer(0);
+    RingBufferDevice device(ringBuffer, 0);
+
+    NullAudioOutput output(stereoFormat(), PERIOD_FRAMES);
+    QCOMPARE(output.periodSize(), PERIOD_FRAMES * 2 * (int)sizeof(int16_t));
+
+    auto start = std::chrono::steady_clock::now();
+    output.start(&device);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    output.stop();
+    auto elapsedUsecs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // reads are at least a period apart, and a late one isn't caught up, so however the test is scheduled there can't
+    // be more reads than periods that fit in the time it ran (plus the first, which is immediate)
+    const quint64 PERIOD_USECS = PERIOD_FRAMES * 1000000 / SAMPLE_RATE;
+    quint64 periods = output.getBytesRead() / output.periodSize();
+    QVERIFY(periods > 0);
+    QVERIFY(periods <= (quint64)elapsedUsecs / PERIOD_USECS + 1);
+    QCOMPARE(output.getCallbackStats().getNumCallbacks(), periods);
+    QCOMPARE(output.getUnderruns(), (quint64)0);
+}
+
+void AudioOutputTests::nullOutputPipeline() {
+    const int NUM_SAMPLES = SAMPLE_RATE;
+
+    // a producer that keeps the ring topped up, as the output worker does for local injectors
+    AudioSPSCRingBuffer<int16_t> ringBuffer(4 * PERIOD_FRAMES * 2);
+    RingBufferDevice device(ringBuffer, NUM_SAMPLES);
+    std::atomic<bool> isRunning { true };
+
+    std::thread producer([&] {
+        int16_t chunk[PERIOD_FRAMES];
+        int16_t next = 0;
+        while (isRunning) {
+            while (ringBuffer.spaceAvailable() >= PERIOD_FRAMES) {
+                for (int i = 0; i < PERIOD_FRAMES; i++) {
+                    chunk[i] = next++;
+                }
+                ringBuffer.writeSamples(chunk, PERIOD_FRAMES);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    NullAudioOutput output(stereoFormat(), PERIOD_FRAMES);
+    output.start(&device);
+    while (device.getNumSamplesRead() < NUM_SAMPLES / 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    output.stop();
+    isRunning = false;
+    producer.join();
+
+    // every sample written was played once, in order
+    const auto& samples = device.getSamplesRead();
+    bool inOrder = true;
+    for (size_t i = 0; i < samples.size(); i++) {
+        inOrder &= (samples[i] == (int16_t)i);
+    }
+    QVERIFY(inOrder);
+    QCOMPARE(ringBuffer.getOverflowCount(), 0);
+}
+
+void AudioOutputTests::nullOutputDeadlineMisses() {
+    const int PERIOD_USECS = PERIOD_FRAMES * 1000000 / SAMPLE_RATE;
+
+    // every 4th read takes two periods
+    AudioSPSCRingBuffer<int16_t> ringBuffer(0);
+    RingBufferDevice device(ringBuffer, 0, 4, 2 * PERIOD_USECS);
+
+    NullAudioOutput output(stereoFormat(), PERIOD_FRAMES);
+    output.start(&device);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    output.stop();
+
+    auto& stats = output.getCallbackStats();
+    quint64 callbacks = stats.getNumCallbacks();
+    quint64 misses = stats.getNumDeadlineMisses();
+    QVERIFY(callbacks >= 8);
+    QVERIFY(misses >= callbacks / 4);
+    QVERIFY(stats.takeWindowMaxUsecs() >= (quint64)(2 * PERIOD_USECS));
+    QCOMPARE(stats.takeWindowMaxUsecs(), (quint64)0);
+}
+
+void AudioOutputTests::outputDeviceMixesInjectors() {
+    const int NUM_SAMPLES = SAMPLE_RATE;
+    const int PERIOD_SAMPLES = PERIOD_FRAMES * AudioOutputIODevice::OUTPUT_CHANNEL_COUNT;
+    const float INJECTOR_LEVEL = 0.25f;
+    const float OUTPUT_GAIN = 0.5f;
+
+    // nothing is received from the mixer, so the device plays the local injectors alone
+    MixedProcessedAudioStream receivedAudioStream(100);
+    AudioIOStats stats(&receivedAudioStream);
+    AudioOutputIODevice::LocalInjectorsStream localInjectorsStream(4 * PERIOD_SAMPLES);
+    AudioOutputIODevice::RecordingStream recordingStream(2 * SAMPLE_RATE);
+    std::atomic<bool> isRecording { true };
+
+    // top the injectors up after every read, as the output worker does when woken; doing it on the output's thread
+    // keeps the test from depending on how another thread is scheduled
+    std::vector<float> injectorPeriod(PERIOD_SAMPLES, INJECTOR_LEVEL);
+    auto topUpInjectors = [&] {
+        while (localInjectorsStream.spaceAvailable() >= PERIOD_SAMPLES) {
+            localInjectorsStream.writeSamples(injectorPeriod.data(), PERIOD_SAMPLES);
+        }
+    };
+    topUpInjectors();
+
+    AudioOutputIODevice device(localInjectorsStream, receivedAudioStream, recordingStream, isRecording, stats);
+    std::atomic<int> numReads { 0 };
+    device.setReadHandler([&] {
+        topUpInjectors();
+        numReads++;
+    });
+    device.setOutputGain(OUTPUT_GAIN);
+    device.configure(stereoFormat(), 2 * PERIOD_SAMPLES);
+    device.start();
+
+    std::vector<int16_t> recorded(NUM_SAMPLES + 2 * SAMPLE_RATE);
+    int numRecorded = 0;
+    auto drainRecording = [&] {
+        numRecorded += recordingStream.readSamples(&recorded[numRecorded], (int)recorded.size() - numRecorded);
+    };
+
+    NullAudioOutput output(stereoFormat(), PERIOD_FRAMES);
+    output.start(&device);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (numRecorded < NUM_SAMPLES && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        drainRecording();
+    }
+    output.stop();
+    drainRecording();
+
+    // every read was counted by the device's stats and recorded in full
+    quint64 reads = output.getCallbackStats().getNumCallbacks();
+    QVERIFY(numRecorded >= NUM_SAMPLES);
+    QCOMPARE(stats.getOutputCallbacks().getNumCallbacks(), reads);
+    QCOMPARE((quint64)numReads, reads);
+    QCOMPARE((quint64)numRecorded, reads * PERIOD_SAMPLES);
+    QCOMPARE(recordingStream.getOverflowCount(), 0);
+    QCOMPARE(localInjectorsStream.getOverflowCount(), 0);
+
+    // the first read ramps the gain in, and the limiter's lookahead delays that into the second; after those, the
+    // output is the injectors at the output gain, to within the limiter's dither
+    const int EXPECTED = (int)(INJECTOR_LEVEL * OUTPUT_GAIN * 32768.0f);
+    const int DITHER_TOLERANCE = 2;
+    int numWrong = 0;
+    for (int i = 2 * PERIOD_SAMPLES; i < numRecorded; i++) {
+        numWrong += (std::abs(recorded[i] - EXPECTED) > DITHER_TOLERANCE);
+    }
+    QCOMPARE(numWrong, 0);
+
+    // the recording can be turned off from another thread
+    isRecording = false;
+    output.start(&device);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    output.stop();
+    QCOMPARE(recordingStream.samplesAvailable(), 0);
+}
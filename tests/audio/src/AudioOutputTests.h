@@ -0,0 +1,29 @@
+//
+//  AudioOutputTests.h
+//  tests/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_AudioOutputTests_h
+#define hifi_AudioOutputTests_h
+
+#include <QtTest/QtTest>
+
+class AudioOutputTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void ringBufferWraps();
+    void ringBufferThreads();
+    void nullOutputPacing();
+    void nullOutputPipeline();
+    void nullOutputDeadlineMisses();
+    void outputDeviceMixesInjectors();
+};
+
+#endif // hifi_AudioOutputTests_h
@@ -3,11 +3,15 @@
 #include <QCoreApplication>
 #include <QFile>
 
+#include <random>
+
 
 #include "CodecTests.h"
+#include "AudioBitrateAdapter.h"
 #include "AudioClient.h"
 #include "DependencyManager.h"
 #include "NodeList.h"
+#include "NumericalConstants.h"
 #include "plugins/CodecPlugin.h"
 #include "plugins/PluginManager.h"
 
@@ -123,3 +127,112 @@ void CodecTests::testDecoders () {
         qDebug() << "Codec" << plugin->getName() << "decoded a lost frame";
     }
 }
+
+void CodecTests::testSilenceElided() {
+    const auto& codecPlugins = PluginManager::getInstance()->getCodecPlugins();
+
+    QVERIFY(codecPlugins.size() > 0);
+
+    for (const auto& plugin : codecPlugins) {
+        if (!plugin->isSupported()) {
+            qWarning() << "Skipping unsupported plugin" << plugin->getName();
+            continue;
+        }
+
+        Encoder* encoder = plugin->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+        QVERIFY(encoder != nullptr);
+
+        // a tone is always worth sending
+        QByteArray tone(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+        int16_t* samples = reinterpret_cast<int16_t*>(tone.data());
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+            samples[2 * i] = samples[2 * i + 1] = (int16_t)(8192.0f * sinf(TWO_PI * 440.0f * i / AudioConstants::SAMPLE_RATE));
+        }
+        QByteArray encoded;
+        encoder->encode(tone, encoded);
+        QVERIFY(!encoder->isLastFrameSilent());
+
+        // a second of silence is elided by codecs with DTX, once they have settled into it
+        QByteArray silence(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+        for (int i = 0; i < 100; i++) {
+            encoder->encode(silence, encoded);
+        }
+        bool hasDTX = plugin->getName() == "opus";
+        QCOMPARE(encoder->isLastFrameSilent(), hasDTX);
+
+        // and stays elided through the comfort noise updates DTX sends every 400 msecs
+        if (hasDTX) {
+            int numFramesSent = 0;
+            for (int i = 0; i < 100; i++) {
+                encoder->encode(silence, encoded);
+                numFramesSent += encoder->isLastFrameSilent() ? 0 : 1;
+            }
+            QCOMPARE(numFramesSent, 0);
+        }
+
+        // the mixer turns DTX off, so a quiet noise-like mix (rain, wind, an ambient bed) is always sent
+        if (hasDTX) {
+            encoder->setDTX(0);
+            std::mt19937 generator(1);
+            std::uniform_int_distribution<int> distribution(-64, 64);
+            QByteArray noise(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+            int16_t* noiseSamples = reinterpret_cast<int16_t*>(noise.data());
+            int numFramesSent = 0;
+            for (int i = 0; i < 100; i++) {
+                for (int j = 0; j < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; j++) {
+                    noiseSamples[j] = (int16_t)distribution(generator);
+                }
+                encoder->encode(noise, encoded);
+                numFramesSent += encoder->isLastFrameSilent() ? 0 : 1;
+            }
+            QCOMPARE(numFramesSent, 100);
+        }
+
+        qDebug() << "Codec" << plugin->getName() << "encoded silence into" << encoded.size() << "bytes";
+
+        plugin->releaseEncoder(encoder);
+    }
+}
+
+void CodecTests::testBitrateAdaptsToLoss() {
+    AudioBitrateAdapter adapter;
+    PacketStreamStats stats;
+
+    // the first report is a baseline
+    stats._expectedReceived = 100;
+    stats._received = 100;
+    QVERIFY(!adapter.update(stats));
+    QCOMPARE(adapter.getBitrate(), AudioBitrateAdapter::MAX_BITRATE);
+
+    // loss backs off until the floor
+    int lastBitrate = adapter.getBitrate();
+    for (int i = 0; i < 20; i++) {
+        stats._expectedReceived += 100;
+        stats._received += 90;
+        stats._lost += 10;
+        adapter.update(stats);
+        QVERIFY(adapter.getBitrate() <= lastBitrate);
+        lastBitrate = adapter.getBitrate();
+    }
+    QCOMPARE(adapter.getBitrate(), AudioBitrateAdapter::MIN_BITRATE);
+
+    // a late packet recovered is not loss
+    stats._expectedReceived += 100;
+    stats._received += 100;
+    stats._lost -= 1;
+    stats._recovered += 1;
+    QVERIFY(adapter.update(stats));
+    QCOMPARE(adapter.getBitrate(), AudioBitrateAdapter::MIN_BITRATE + AudioBitrateAdapter::PROBE_BITRATE_STEP);
+
+    // a clean connection probes back up to the ceiling
+    for (int i = 0; i < 20; i++) {
+        stats._expectedReceived += 100;
+        stats._received += 100;
+        adapter.update(stats);
+    }
+    QCOMPARE(adapter.getBitrate(), AudioBitrateAdapter::MAX_BITRATE);
+
+    // a receiver that reset its stats starts a new baseline
+    QVERIFY(!adapter.update(PacketStreamStats()));
+    QCOMPARE(adapter.getBitrate(), AudioBitrateAdapter::MAX_BITRATE);
+}
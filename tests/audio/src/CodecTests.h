@@ -27,6 +27,9 @@ private slots:
     void testEncoders();
     void testDecoders();
 
+    void testSilenceElided();
+    void testBitrateAdaptsToLoss();
+
 };
 
 #endif // hifi_AudioTests_h
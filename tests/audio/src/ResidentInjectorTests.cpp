@@ -0,0 +1,150 @@
+//
+//  ResidentInjectorTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ResidentInjectorTests.h"
+
+#include <vector>
+
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+#include <ResidentInjectedAudioStream.h>
+#include <UUID.h>
+
+QTEST_MAIN(ResidentInjectorTests)
+
+static const QUrl SOUND_URL("atp:/a9b3c53d1fb9f4a52b5ddf52c12e36ad9cb4a2e3f3d5e1bd8df3b3a9ba5a9b6e.wav");
+
+// sends the injector's state to the stream, as the mixer would receive it
+static bool sendResidentData(ResidentInjectedAudioStream& stream, const AudioInjectorOptions& options,
+                             ResidentInjectedAudioStream::Flags flags = 0, const QUrl& soundURL = SOUND_URL) {
+    auto packet = NLPacket::create(PacketType::ResidentInjector);
+    ResidentInjectedAudioStream::writeResidentData(*packet, stream.getStreamIdentifier(), soundURL, options, flags);
+    packet->seek(0);
+
+    ReceivedMessage message(*packet);
+    QUuid streamID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    if (streamID != stream.getStreamIdentifier()) {
+        return false;
+    }
+    return stream.parseResidentData(message);
+}
+
+// a mono sound whose samples count up from zero
+static AudioDataPointer makeRamp(int numFrames) {
+    std::vector<AudioConstants::AudioSample> samples(numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        samples[i] = (AudioConstants::AudioSample)i;
+    }
+    return AudioData::make(numFrames, AudioConstants::MONO, samples.data());
+}
+
+// renders and pops a frame, as the mixer does once a frame
+static std::vector<int16_t> popFrame(ResidentInjectedAudioStream& stream) {
+    stream.renderFrame();
+    std::vector<int16_t> frame(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    if (stream.popFrames(1, true) > 0) {
+        AudioRingBuffer::ConstIterator output = stream.getLastPopOutput();
+        output.readSamples(frame.data(), (int)frame.size());
+    }
+    return frame;
+}
+
+void ResidentInjectorTests::residentDataRoundTrip() {
+    AudioInjectorOptions options;
+    options.loop = true;
+    options.ambient = true;
+    options.volume = 0.5f;
+    options.position = glm::vec3(1.0f, 2.0f, 3.0f);
+    options.secondOffset = 0.5f;
+
+    ResidentInjectedAudioStream stream(QUuid::createUuid());
+    QVERIFY(sendResidentData(stream, options));
+
+    QCOMPARE(stream.getSoundURL(), SOUND_URL);
+    QVERIFY(stream.isLooping());
+    QVERIFY(stream.isAmbient());
+    QVERIFY(!stream.shouldLoopbackForNode());
+    QCOMPARE(stream.getPosition(), options.position);
+    QVERIFY(fabsf(stream.getAttenuationRatio() - options.volume) < 0.01f);
+    QVERIFY(!stream.hasAudioData());
+}
+
+void ResidentInjectorTests::refusesLocalURLs() {
+    QVERIFY(ResidentInjectedAudioStream::isAllowedSoundURL(SOUND_URL));
+    QVERIFY(ResidentInjectedAudioStream::isAllowedSoundURL(QUrl("https://example.com/sounds/rain.wav")));
+    QVERIFY(!ResidentInjectedAudioStream::isAllowedSoundURL(QUrl("file:///etc/passwd")));
+    QVERIFY(!ResidentInjectedAudioStream::isAllowedSoundURL(QUrl("qrc:/sounds/snap.wav")));
+    QVERIFY(!ResidentInjectedAudioStream::isAllowedSoundURL(QUrl("http:///rain.wav")));
+
+    AudioInjectorOptions options;
+    ResidentInjectedAudioStream stream(QUuid::createUuid());
+    QVERIFY(!sendResidentData(stream, options, 0, QUrl("file:///tmp/rain.wav")));
+    QVERIFY(stream.getSoundURL().isEmpty());
+}
+
+void ResidentInjectorTests::refreshKeepsPlayhead() {
+    AudioInjectorOptions options;
+    options.loop = true;
+
+    ResidentInjectedAudioStream stream(QUuid::createUuid());
+    QVERIFY(sendResidentData(stream, options));
+    stream.setAudioData(makeRamp(10 * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL));
+
+    popFrame(stream);
+    QVERIFY(sendResidentData(stream, options));
+    QCOMPARE(popFrame(stream)[0], (int16_t)AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    // a restart goes back to the offset
+    options.secondOffset = 0.0625f;
+    QVERIFY(sendResidentData(stream, options, ResidentInjectedAudioStream::RESTART));
+    QCOMPARE(popFrame(stream)[0], (int16_t)(0.0625f * AudioConstants::SAMPLE_RATE));
+}
+
+void ResidentInjectorTests::loopingSoundWraps() {
+    const int NUM_FRAMES = 300;
+
+    AudioInjectorOptions options;
+    options.loop = true;
+
+    ResidentInjectedAudioStream stream(QUuid::createUuid());
+    QVERIFY(sendResidentData(stream, options));
+    stream.setAudioData(makeRamp(NUM_FRAMES));
+
+    popFrame(stream);
+    auto frame = popFrame(stream);
+    for (int i = 0; i < (int)frame.size(); i++) {
+        int expected = (AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL + i) % NUM_FRAMES;
+        QCOMPARE((int)frame[i], expected);
+    }
+    QVERIFY(!stream.isPlayedOut());
+}
+
+void ResidentInjectorTests::oneShotPlaysOut() {
+    const int NUM_FRAMES = 300;
+
+    AudioInjectorOptions options;
+    ResidentInjectedAudioStream stream(QUuid::createUuid());
+    QVERIFY(sendResidentData(stream, options));
+    stream.setAudioData(makeRamp(NUM_FRAMES));
+
+    popFrame(stream);
+    QVERIFY(!stream.isPlayedOut());
+
+    // the end of the sound is followed by silence
+    auto frame = popFrame(stream);
+    int tail = NUM_FRAMES - AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    QCOMPARE((int)frame[tail - 1], NUM_FRAMES - 1);
+    QCOMPARE((int)frame[tail], 0);
+    QVERIFY(stream.isPlayedOut());
+
+    // and a one-shot does not time out, however long it goes unheard
+    QVERIFY(!stream.isTimedOut(usecTimestampNow() + 10 * ResidentInjectedAudioStream::TIMEOUT_USECS));
+}
@@ -0,0 +1,28 @@
+//
+//  ResidentInjectorTests.h
+//  tests/audio/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_ResidentInjectorTests_h
+#define hifi_ResidentInjectorTests_h
+
+#include <QtTest/QtTest>
+
+class ResidentInjectorTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void residentDataRoundTrip();
+    void refusesLocalURLs();
+    void refreshKeepsPlayhead();
+    void loopingSoundWraps();
+    void oneShotPlaysOut();
+};
+
+#endif // hifi_ResidentInjectorTests_h
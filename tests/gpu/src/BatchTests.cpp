@@ -0,0 +1,156 @@
+//
+//  BatchTests.cpp
+//  tests/gpu/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "BatchTests.h"
+
+#include <gpu/Batch.h>
+
+QTEST_MAIN(BatchTests)
+
+const int NUM_PARTS = 4;
+const int NUM_ITEMS_PER_PART = 20;
+const char* INSTANCE_NAME = "instance";
+
+struct Resources {
+    std::vector<gpu::BufferPointer> buffers;
+    std::vector<gpu::TexturePointer> textures;
+};
+
+static Resources makeResources() {
+    Resources resources;
+    for (int i = 0; i < NUM_PARTS * NUM_ITEMS_PER_PART; i++) {
+        resources.buffers.push_back(std::make_shared<gpu::Buffer>());
+        resources.textures.push_back(gpu::Texture::createStrict(gpu::Element::COLOR_RGBA_32, 1, 1));
+    }
+    return resources;
+}
+
+// Records what a render job would record for one part of its items
+static void recordPart(gpu::Batch& batch, const Resources& resources, int part) {
+    glm::mat4 projection(1.0f);
+    projection[3][2] = (float)part;
+    batch.setProjectionTransform(projection);
+
+    for (int i = 0; i < NUM_ITEMS_PER_PART; i++) {
+        int item = part * NUM_ITEMS_PER_PART + i;
+        Transform model;
+        model.setTranslation(glm::vec3((float)item, 0.0f, 0.0f));
+        batch.setModelTransform(model);
+        batch.setUniformBuffer(0, resources.buffers[item], 0, 16);
+        batch.setResourceTexture(1, resources.textures[item]);
+        if (item % 3 == 0) {
+            // an instanced draw, drawn by the named call at the end of the frame
+            batch.setupNamedCalls(INSTANCE_NAME, [](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+                batch.draw(gpu::TRIANGLES, 3 * (gpu::uint32)data.count());
+            });
+            batch.getNamedBuffer(INSTANCE_NAME)->append((uint32_t)item);
+        } else {
+            batch.setDrawcallUniform((uint16_t)item);
+            batch.drawIndexed(gpu::TRIANGLES, 3 * (gpu::uint32)item);
+        }
+    }
+}
+
+// Resolves the params of every command, so that batches can be compared whatever their cache layout
+static QStringList describe(const gpu::Batch& batch) {
+    QStringList description;
+    batch.forEachCommand([&](gpu::Batch::Command command, const gpu::Batch::Param* params) {
+        QString line = QString::number(command);
+        switch (command) {
+            case gpu::Batch::COMMAND_setProjectionTransform: {
+                auto projection = reinterpret_cast<const glm::mat4*>(batch.readData(params[0]._size));
+                line += " " + QString::number((*projection)[3][2]);
+                break;
+            }
+            case gpu::Batch::COMMAND_setUniformBuffer:
+                line += QString().asprintf(" %p", batch._buffers.get(params[2]._uint).get());
+                break;
+            case gpu::Batch::COMMAND_setResourceTexture:
+                line += QString().asprintf(" %p", batch._textures.get(params[0]._uint).get());
+                break;
+            case gpu::Batch::COMMAND_drawIndexed:
+                line += " " + QString::number(params[1]._uint);
+                break;
+            default:
+                break;
+        }
+        description << line;
+    });
+
+    auto describeDrawCall = [&](const gpu::Batch::DrawCallInfo& drawCallInfo) {
+        const auto& object = batch._objects[drawCallInfo.index];
+        return QString("draw %1 %2").arg(object._model[3][0]).arg(drawCallInfo.unused);
+    };
+    for (const auto& drawCallInfo : batch._drawCallInfos) {
+        description << describeDrawCall(drawCallInfo);
+    }
+    for (const auto& namedCallData : batch._namedData) {
+        description << QString::fromStdString(namedCallData.first);
+        for (const auto& drawCallInfo : namedCallData.second.drawCallInfos) {
+            description << describeDrawCall(drawCallInfo);
+        }
+        const auto& buffer = namedCallData.second.buffers[0];
+        auto instances = reinterpret_cast<const uint32_t*>(buffer->getData());
+        for (gpu::Size i = 0; i < buffer->getNumTypedElements<uint32_t>(); i++) {
+            description << QString("instance %1").arg(instances[i]);
+        }
+    }
+    return description;
+}
+
+void BatchTests::appendMatchesSerialRecording() {
+    auto resources = makeResources();
+
+    gpu::Batch serialBatch;
+    serialBatch.setViewportTransform(glm::ivec4(0, 0, 640, 480));
+    for (int part = 0; part < NUM_PARTS; part++) {
+        recordPart(serialBatch, resources, part);
+    }
+
+    gpu::Batch mergedBatch;
+    mergedBatch.setViewportTransform(glm::ivec4(0, 0, 640, 480));
+    std::vector<std::unique_ptr<gpu::Batch>> partBatches;
+    for (int part = 0; part < NUM_PARTS; part++) {
+        partBatches.push_back(std::make_unique<gpu::Batch>());
+        recordPart(*partBatches.back(), resources, part);
+    }
+    for (const auto& partBatch : partBatches) {
+        mergedBatch.append(*partBatch);
+    }
+
+    auto serialDescription = describe(serialBatch);
+    QCOMPARE(describe(mergedBatch), serialDescription);
+    QCOMPARE(mergedBatch._objects.size(), serialBatch._objects.size());
+
+    // recording carries on after a merge as it would have without
+    Transform model;
+    model.setTranslation(glm::vec3(-1.0f));
+    serialBatch.setModelTransform(model);
+    serialBatch.draw(gpu::TRIANGLES, 3);
+    mergedBatch.setModelTransform(model);
+    mergedBatch.draw(gpu::TRIANGLES, 3);
+    QCOMPARE(describe(mergedBatch), describe(serialBatch));
+}
+
+void BatchTests::namedBuffersArePooled() {
+    gpu::Batch batch;
+    auto buffer = batch.getNamedBuffer(INSTANCE_NAME).get();
+    batch.getNamedBuffer(INSTANCE_NAME)->append((uint32_t)1);
+    batch.clear();
+
+    QCOMPARE(batch.getNamedBuffer(INSTANCE_NAME).get(), buffer);
+    QCOMPARE(batch.getNamedBuffer(INSTANCE_NAME)->getSize(), (gpu::Size)0);
+
+    // a buffer still in use elsewhere is not reused
+    auto heldBuffer = batch.getNamedBuffer(INSTANCE_NAME);
+    batch.clear();
+    QVERIFY(batch.getNamedBuffer(INSTANCE_NAME) != heldBuffer);
+}
@@ -0,0 +1,25 @@
+//
+//  BatchTests.h
+//  tests/gpu/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_BatchTests_h
+#define hifi_BatchTests_h
+
+#include <QtTest/QtTest>
+
+class BatchTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void appendMatchesSerialRecording();
+    void namedBuffersArePooled();
+};
+
+#endif // hifi_BatchTests_h
@@ -18,6 +18,8 @@
 #include <cerrno>
 #include <stdio.h>
 
+#include <QtCore/QTemporaryDir>
+
 #include <NumericalConstants.h>
 #include <MovingMinMaxAvg.h>
 #include <SequenceNumberStats.h>
@@ -25,9 +27,75 @@
 #include <SimpleMovingAverage.h>
 #include <StDev.h>
 
+#include "JitterTraceSimulator.h"
+
 // Uncomment this to run manually
 //#define RUN_MANUALLY
 
+void JitterTests::traceSaveLoad() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString path = directory.filePath("trace.txt");
+
+    JitterTrace trace = JitterTrace::generate(500, 1, 15 * USECS_PER_MSEC, 0.05f, 100, 80 * USECS_PER_MSEC);
+    QVERIFY(trace.save(path));
+
+    JitterTrace loaded;
+    QVERIFY(loaded.load(path));
+    QVERIFY(loaded.arrivals == trace.arrivals);
+
+    // a replayed trace plays out the same
+    JitterSimulation simulation = simulateJitterBuffer(trace);
+    JitterSimulation replay = simulateJitterBuffer(loaded);
+    QCOMPARE(replay.framesPlayed, simulation.framesPlayed);
+    QCOMPARE(replay.framesConcealed, simulation.framesConcealed);
+    QCOMPARE(replay.finalTargetFrames, simulation.finalTargetFrames);
+}
+
+void JitterTests::steadyStream() {
+    JitterSimulation simulation = simulateJitterBuffer(JitterTrace::generate(3000, 1, 2 * USECS_PER_MSEC));
+
+    QVERIFY(simulation.framesConcealed <= 1);
+    QCOMPARE(simulation.finalTargetFrames, 1);
+    QVERIFY(simulation.averageLatencyFrames < 2.0);
+}
+
+void JitterTests::packetLoss() {
+    // lost packets are concealed as they are found, and do not count as gaps to buffer against
+    JitterSimulation simulation = simulateJitterBuffer(JitterTrace::generate(3000, 1, 2 * USECS_PER_MSEC, 0.05f));
+
+    QVERIFY(simulation.framesLost > 0);
+    QVERIFY(simulation.finalTargetFrames <= 2);
+    QVERIFY(simulation.getConcealmentRate() < AudioPlayoutModel::DEFAULT_TARGET_CONCEALMENT_RATE);
+}
+
+void JitterTests::delaySpikes() {
+    // an 80 msec stall every second
+    JitterTrace trace = JitterTrace::generate(6000, 1, 2 * USECS_PER_MSEC, 0.0f, 100, 80 * USECS_PER_MSEC);
+    JitterSimulation simulation = simulateJitterBuffer(trace);
+
+    QVERIFY(simulation.finalTargetFrames > 1);
+    QVERIFY(simulation.getConcealmentRate() <= AudioPlayoutModel::DEFAULT_TARGET_CONCEALMENT_RATE);
+}
+
+void JitterTests::concealmentRateTradesLatency() {
+    JitterTrace trace = JitterTrace::generate(6000, 1, 2 * USECS_PER_MSEC, 0.0f, 100, 80 * USECS_PER_MSEC);
+    JitterSimulation cautious = simulateJitterBuffer(trace, 0.001f);
+    JitterSimulation eager = simulateJitterBuffer(trace, 0.1f);
+
+    QVERIFY(cautious.averageLatencyFrames > eager.averageLatencyFrames);
+    QVERIFY(cautious.getConcealmentRate() < eager.getConcealmentRate());
+}
+
+void JitterTests::recoversAfterStall() {
+    // a 300 msec stall every 20 seconds raises the target, which falls back once the stalls are forgotten
+    JitterTrace trace = JitterTrace::generate(6000, 1, 2 * USECS_PER_MSEC, 0.0f, 2000, 300 * USECS_PER_MSEC);
+    JitterSimulation simulation = simulateJitterBuffer(trace);
+
+    QVERIFY(simulation.maxTargetFrames >= 10);
+    QVERIFY(simulation.finalTargetFrames <= 2);
+}
+
 #ifndef RUN_MANUALLY
 
 QTEST_MAIN(JitterTests)
@@ -16,11 +16,15 @@
 class JitterTests : public QObject {
     Q_OBJECT
     
-    private slots:
-    void qTestsNotYetImplemented () {
-        qDebug() << "TODO: Reimplement this using QtTest!\n"
-        "(JitterTests takes commandline arguments (port numbers), and can be run manually by #define-ing RUN_MANUALLY in JitterTests.cpp)";
-    }
+    // JitterTests can also be run manually, as a sender and receiver taking commandline arguments (port numbers),
+    // by #define-ing RUN_MANUALLY in JitterTests.cpp
+private slots:
+    void traceSaveLoad();
+    void steadyStream();
+    void packetLoss();
+    void delaySpikes();
+    void concealmentRateTradesLatency();
+    void recoversAfterStall();
 };
 
 #endif
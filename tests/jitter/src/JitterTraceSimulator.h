@@ -0,0 +1,199 @@
+//
+//  JitterTraceSimulator.h
+//  tests/jitter/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_JitterTraceSimulator_h
+#define hifi_JitterTraceSimulator_h
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QTextStream>
+
+#include <AudioConstants.h>
+#include <AudioPlayoutModel.h>
+#include <InboundAudioStream.h>
+#include <NLPacket.h>
+#include <NumericalConstants.h>
+#include <ReceivedMessage.h>
+
+// The packets of one audio stream, in the order they arrived. A trace recorded from a real stream, or generated,
+// can be saved and replayed, so a change to the jitter buffer can be judged against the same conditions.
+struct JitterTrace {
+    struct Arrival {
+        quint16 sequence;
+        quint64 arrivalUsecs;
+
+        bool operator==(const Arrival& other) const {
+            return sequence == other.sequence && arrivalUsecs == other.arrivalUsecs;
+        }
+    };
+
+    std::vector<Arrival> arrivals;
+
+    // one "sequence arrivalUsecs" line per packet
+    bool save(const QString& path) const {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            return false;
+        }
+        QTextStream stream(&file);
+        for (const auto& arrival : arrivals) {
+            stream << arrival.sequence << " " << arrival.arrivalUsecs << "\n";
+        }
+        return true;
+    }
+
+    bool load(const QString& path) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            return false;
+        }
+        arrivals.clear();
+        QTextStream stream(&file);
+        while (!stream.atEnd()) {
+            QStringList fields = stream.readLine().split(' ', Qt::SkipEmptyParts);
+            if (fields.size() != 2) {
+                continue;
+            }
+            arrivals.push_back({ (quint16)fields[0].toUInt(), fields[1].toULongLong() });
+        }
+        return true;
+    }
+
+    // A stream that sends a packet every frame. Each packet is delayed by up to jitterUsecs, and lost at lossRate.
+    // Every spikeEvery packets the network (or a loaded mixer) stalls for spikeUsecs, and what was sent meanwhile
+    // arrives in a burst when it ends. The same seed gives the same trace.
+    static JitterTrace generate(int numPackets, unsigned int seed, quint64 jitterUsecs, float lossRate = 0.0f,
+                                int spikeEvery = 0, quint64 spikeUsecs = 0) {
+        const quint64 BASE_DELAY_USECS = 20 * USECS_PER_MSEC;
+
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+
+        JitterTrace trace;
+        quint64 stallEndUsecs = 0;
+        for (int i = 0; i < numPackets; i++) {
+            quint64 sentUsecs = (quint64)i * AudioConstants::NETWORK_FRAME_USECS;
+            if (spikeEvery > 0 && i > 0 && i % spikeEvery == 0) {
+                stallEndUsecs = sentUsecs + spikeUsecs;
+            }
+            if (uniform(generator) < lossRate) {
+                continue;
+            }
+
+            quint64 arrivalUsecs = sentUsecs + BASE_DELAY_USECS + (quint64)(uniform(generator) * jitterUsecs);
+            arrivalUsecs = std::max(arrivalUsecs, stallEndUsecs + BASE_DELAY_USECS);
+            trace.arrivals.push_back({ (quint16)i, arrivalUsecs });
+        }
+
+        std::stable_sort(trace.arrivals.begin(), trace.arrivals.end(), [](const Arrival& a, const Arrival& b) {
+            return a.arrivalUsecs < b.arrivalUsecs;
+        });
+        return trace;
+    }
+};
+
+struct JitterSimulation {
+    int framesPlayed { 0 };
+    int framesConcealed { 0 };  // played out of a starved or empty buffer
+    int framesLost { 0 };       // concealed for packets that never arrived
+    int framesDropped { 0 };
+    int packetsLate { 0 };
+    int maxTargetFrames { 0 };
+    int finalTargetFrames { 0 };
+    double averageLatencyFrames { 0.0 };
+
+    float getConcealmentRate() const {
+        int frames = framesPlayed + framesConcealed;
+        return frames > 0 ? (float)framesConcealed / frames : 0.0f;
+    }
+};
+
+// An InboundAudioStream that stamps each packet with the time the trace says it arrived, rather than the time it was
+// parsed, so a trace plays out the same however fast it is replayed.
+class JitterTraceAudioStream : public InboundAudioStream {
+public:
+    static const int NUM_FRAMES_CAPACITY = 100;
+
+    JitterTraceAudioStream() :
+        InboundAudioStream(AudioConstants::MONO, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL, NUM_FRAMES_CAPACITY, -1) {}
+
+    void setNowUsecs(quint64 nowUsecs) { _nowUsecs = nowUsecs; }
+
+    // a packet of silence, as the mixer would send it
+    void receivePacket(quint16 sequence) {
+        auto packet = NLPacket::create(PacketType::MixedAudio);
+        packet->writePrimitive(sequence);
+        packet->writeString(QString());
+        QByteArray audio(AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL, 0);
+        packet->write(audio.constData(), audio.size());
+
+        ReceivedMessage message(*packet);
+        parseData(message);
+    }
+
+protected:
+    quint64 getNowUsecs() const override { return _nowUsecs; }
+
+private:
+    quint64 _nowUsecs { 0 };
+};
+
+// Replays a trace through an InboundAudioStream, which plays a frame every NETWORK_FRAME_USECS, half a frame out of
+// phase with the sender. The stream does the rest as it would for packets off the network: it conceals lost packets,
+// sizes and steers its buffer from the playout model, and refills when starved.
+inline JitterSimulation simulateJitterBuffer(const JitterTrace& trace,
+                                             float targetConcealmentRate = AudioPlayoutModel::DEFAULT_TARGET_CONCEALMENT_RATE) {
+    JitterSimulation simulation;
+    if (trace.arrivals.empty()) {
+        return simulation;
+    }
+
+    JitterTraceAudioStream stream;
+    stream.setTargetConcealmentRate(targetConcealmentRate);
+    double latencySum = 0.0;
+
+    quint64 nextPlayUsecs = trace.arrivals.front().arrivalUsecs + AudioConstants::NETWORK_FRAME_USECS / 2;
+    for (const auto& arrival : trace.arrivals) {
+        for (; nextPlayUsecs <= arrival.arrivalUsecs; nextPlayUsecs += AudioConstants::NETWORK_FRAME_USECS) {
+            stream.setNowUsecs(nextPlayUsecs);
+            int framesAvailable = stream.getFramesAvailable();
+            bool isConcealed = stream.isStarved() || framesAvailable < 1;
+
+            stream.popFrames(1, true);
+            if (isConcealed) {
+                simulation.framesConcealed++;
+            } else {
+                latencySum += framesAvailable;
+                simulation.framesPlayed++;
+            }
+        }
+
+        stream.setNowUsecs(arrival.arrivalUsecs);
+        stream.receivePacket(arrival.sequence);
+        simulation.maxTargetFrames = std::max(simulation.maxTargetFrames, stream.getDesiredJitterBufferFrames());
+    }
+
+    AudioStreamStats stats = stream.getAudioStreamStats();
+    simulation.framesLost = (int)stats._packetStreamStats._lost;
+    simulation.packetsLate = (int)stats._packetStreamStats._late;
+    simulation.framesDropped = (int)stats._framesDropped;
+    simulation.finalTargetFrames = stream.getDesiredJitterBufferFrames();
+    simulation.averageLatencyFrames = simulation.framesPlayed > 0 ? latencySum / simulation.framesPlayed : 0.0;
+    return simulation;
+}
+
+#endif // hifi_JitterTraceSimulator_h
@@ -21,6 +21,7 @@
 #include "GLTFSerializer.h"
 #include "FBXSerializer.h"
 #include "OBJSerializer.h"
+#include "FBXWriter.h"
 
 #include "Gzip.h"
 #include "model-networking/ModelLoader.h"
@@ -30,6 +31,10 @@
 #include "AssetClient.h"
 #include "LimitedNodeList.h"
 #include "NodeList.h"
+#include "NumericalConstants.h"
+#include <model-baker/Baker.h>
+#include <tbb/global_control.h>
+#include <tbb/task_arena.h>
 
 #include <QUrl>
 #include <QNetworkAccessManager>
@@ -38,6 +43,9 @@
 #include <QByteArray>
 #include <QDebug>
 #include <QDirIterator>
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QTemporaryFile>
 
 QTEST_MAIN(ModelSerializersTests)
 
@@ -159,3 +167,207 @@ void ModelSerializersTests::loadGLTF() {
     QVERIFY(expectWarnings == (model->loadWarningCount>0));
     QVERIFY(expectErrors == (model->loadErrorCount>0));
 }
+
+void ModelSerializersTests::parseBinaryFBX() {
+    // large arrays are written compressed, small ones raw
+    const int NUM_VERTICES = 3000;
+    QVector<double> vertices;
+    QVector<qint32> indices;
+    for (int i = 0; i < NUM_VERTICES; i++) {
+        vertices.append(i * 0.5);
+        indices.append(NUM_VERTICES - i);
+    }
+    QVector<float> weights { 0.25f, 0.5f, 0.25f };
+
+    FBXNode geometry;
+    geometry.name = "Geometry";
+    geometry.properties << (qint64)1234 << QByteArray("Geometry::cube") << QByteArray("Mesh");
+    FBXNode verticesNode;
+    verticesNode.name = "Vertices";
+    verticesNode.properties << QVariant::fromValue(vertices);
+    FBXNode indicesNode;
+    indicesNode.name = "PolygonVertexIndex";
+    indicesNode.properties << QVariant::fromValue(indices);
+    FBXNode weightsNode;
+    weightsNode.name = "Weights";
+    weightsNode.properties << QVariant::fromValue(weights) << 1.5f << true;
+    geometry.children << verticesNode << indicesNode << weightsNode;
+
+    FBXNode objects;
+    objects.name = "Objects";
+    objects.children << geometry;
+    FBXNode root;
+    root.children << objects;
+
+    QByteArray data = FBXWriter::encodeFBX(root);
+    FBXNode parsed = FBXSerializer::parseFBX(data);
+
+    QCOMPARE(parsed.children.size(), 1);
+    const FBXNode& parsedGeometry = parsed.children.at(0).children.at(0);
+    QCOMPARE(parsedGeometry.name, QByteArray("Geometry"));
+    QCOMPARE(parsedGeometry.properties.at(0).toLongLong(), (qint64)1234);
+    QCOMPARE(parsedGeometry.properties.at(1).toByteArray(), QByteArray("Geometry::cube"));
+    QCOMPARE(parsedGeometry.children.size(), 3);
+    QCOMPARE(parsedGeometry.children.at(0).properties.at(0).value<QVector<double>>(), vertices);
+    QCOMPARE(parsedGeometry.children.at(1).properties.at(0).value<QVector<qint32>>(), indices);
+    QCOMPARE(parsedGeometry.children.at(2).properties.at(0).value<QVector<float>>(), weights);
+    QCOMPARE(parsedGeometry.children.at(2).properties.at(1).toFloat(), 1.5f);
+    QCOMPARE(parsedGeometry.children.at(2).properties.at(2).toBool(), true);
+
+    // parsing straight from the buffer and through a device must agree
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    FBXNode parsedFromDevice = FBXSerializer::parseFBX(&buffer);
+    QCOMPARE(parsedFromDevice.children.at(0).children.at(0).children.at(0).properties.at(0).value<QVector<double>>(),
+             vertices);
+
+    // and so must parsing from a mapping of a file
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), (qint64)data.size());
+    QVERIFY(file.seek(0));
+    FBXNode parsedFromFile = FBXSerializer::parseFBX(&file);
+    const FBXNode& fileGeometry = parsedFromFile.children.at(0).children.at(0);
+    QCOMPARE(fileGeometry.properties.at(1).toByteArray(), QByteArray("Geometry::cube"));
+    QCOMPARE(fileGeometry.children.at(0).properties.at(0).value<QVector<double>>(), vertices);
+    QCOMPARE(fileGeometry.children.at(1).properties.at(0).value<QVector<qint32>>(), indices);
+
+    // truncated files have to fail cleanly instead of reading past the end
+    bool threw = false;
+    try {
+        FBXSerializer::parseFBX(data.left(data.size() / 2));
+    } catch (const QString&) {
+        threw = true;
+    }
+    QVERIFY(threw);
+}
+
+// Builds an OBJ grid of quads, as there are no OBJ files in the test corpus.
+static QByteArray makeOBJGrid(int size) {
+    QByteArray obj;
+    obj.append("g grid\n");
+    for (int y = 0; y <= size; y++) {
+        for (int x = 0; x <= size; x++) {
+            obj.append(QString("v %1 %2 0\nvt %3 %4\n").arg(x).arg(y).arg((float)x / size).arg((float)y / size).toUtf8());
+        }
+    }
+    obj.append("vn 0 0 1\n");
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int corner = y * (size + 1) + x + 1;
+            obj.append(QString("f %1/%1/1 %2/%2/1 %3/%3/1 %4/%4/1\n")
+                .arg(corner).arg(corner + 1).arg(corner + size + 2).arg(corner + size + 1).toUtf8());
+        }
+    }
+    return obj;
+}
+
+void ModelSerializersTests::benchmarkLoad() {
+    // the corpus of loadGLTF, plus a generated OBJ file
+    QList<QPair<QUrl, QByteArray>> corpus;
+    QDirIterator it("models/src", QStringList() << "*.glb" << "*.glb.gz", QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QString filename = it.next();
+        if (filename.contains("gltf_samples/1.0")) {
+            continue;
+        }
+        QFile file(filename);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QByteArray data = file.readAll();
+        if (filename.endsWith(".gz")) {
+            QByteArray uncompressedData;
+            QVERIFY(gunzip(data, uncompressedData));
+            data = uncompressedData;
+            filename.chop(3);
+        }
+        corpus.append({ QUrl("https://example.com/" + filename), data });
+    }
+    const int OBJ_GRID_SIZE = 300;
+    corpus.append({ QUrl("https://example.com/grid.obj"), makeOBJGrid(OBJ_GRID_SIZE) });
+
+    QMultiHash<QString, QVariant> serializerMapping;
+    serializerMapping.insert("combineParts", true);
+    serializerMapping.insert("deduplicateIndices", true);
+
+    qint64 totalBytes = 0;
+    qint64 firstModelNsecs = 0;
+    qint64 slowestNsecs = 0;
+    QUrl slowestUrl;
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+    for (const auto& entry : corpus) {
+        QElapsedTimer timer;
+        timer.start();
+        ModelLoader loader;
+        hfm::Model::Pointer model = loader.load(entry.second, serializerMapping, entry.first, "");
+        qint64 nsecs = timer.nsecsElapsed();
+        QVERIFY(model);
+
+        if (firstModelNsecs == 0) {
+            firstModelNsecs = nsecs;
+        }
+        if (nsecs > slowestNsecs) {
+            slowestNsecs = nsecs;
+            slowestUrl = entry.first;
+        }
+        totalBytes += entry.second.size();
+    }
+    double seconds = (double)totalTimer.nsecsElapsed() / NSECS_PER_SECOND;
+    double megabytes = (double)totalBytes / (1024.0 * 1024.0);
+
+    qInfo() << "Loaded" << corpus.size() << "models," << megabytes << "MB in" << seconds << "s:"
+            << megabytes / seconds << "MB/s. First model after"
+            << (double)firstModelNsecs / NSECS_PER_MSEC << "ms, slowest" << (double)slowestNsecs / NSECS_PER_MSEC
+            << "ms for" << slowestUrl;
+}
+
+void ModelSerializersTests::benchmarkBake() {
+    // the avatar with the most blendshapes, with its normals and tangents removed so that the baker computes them
+    QFile file("models/src/Franny.glb.gz");
+    if (!file.open(QIODevice::ReadOnly)) {
+        QSKIP("Franny.glb.gz not downloaded");
+    }
+    QByteArray data;
+    QVERIFY(gunzip(file.readAll(), data));
+    const QUrl url("https://example.com/Franny.glb");
+
+    auto loadModel = [&] {
+        hifi::VariantMultiHash serializerMapping;
+        hfm::Model::Pointer model = ModelLoader().load(data, serializerMapping, url, "");
+        if (model) {
+            for (auto& mesh : model->meshes) {
+                mesh.normals.clear();
+                mesh.tangents.clear();
+                for (auto& blendshape : mesh.blendshapes) {
+                    blendshape.normals.clear();
+                    blendshape.tangents.clear();
+                }
+            }
+        }
+        return model;
+    };
+
+    auto bake = [&](size_t maxParallelism) {
+        hfm::Model::Pointer model = loadModel();
+        if (!model) {
+            return (qint64)0;
+        }
+        tbb::global_control parallelism(tbb::global_control::max_allowed_parallelism, maxParallelism);
+        baker::Baker modelBaker(model, hifi::VariantHash(), url);
+        modelBaker.getConfiguration()->getJobConfig("BuildDracoMesh")->setEnabled(true);
+        QElapsedTimer timer;
+        timer.start();
+        modelBaker.run();
+        qint64 nsecs = timer.nsecsElapsed();
+        return modelBaker.getHFMModel() ? nsecs : (qint64)0;
+    };
+
+    qint64 serialNsecs = bake(1);
+    qint64 parallelNsecs = bake(tbb::this_task_arena::max_concurrency());
+    QVERIFY(serialNsecs > 0);
+    QVERIFY(parallelNsecs > 0);
+
+    qInfo() << "Baked" << url << "in" << (double)serialNsecs / NSECS_PER_MSEC << "ms serially,"
+            << (double)parallelNsecs / NSECS_PER_MSEC << "ms in parallel:" << (double)serialNsecs / (double)parallelNsecs
+            << "x speedup";
+}
@@ -21,6 +21,9 @@ private slots:
     void initTestCase();
     void loadGLTF_data();
     void loadGLTF();
+    void parseBinaryFBX();
+    void benchmarkLoad();
+    void benchmarkBake();
 
 };
 
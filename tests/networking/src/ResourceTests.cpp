@@ -9,6 +9,8 @@
 
 #include "ResourceTests.h"
 
+#include <random>
+
 #include <QNetworkDiskCache>
 
 #include <ExternalResource.h>
@@ -19,6 +21,7 @@
 #include <DependencyManager.h>
 #include <ResourceRequestObserver.h>
 #include <StatTracker.h>
+#include <NumericalConstants.h>
 
 QTEST_MAIN(ResourceTests)
 
@@ -97,3 +100,125 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+static std::mt19937 randomGenerator(1234);
+
+// Pending requests for resources whose priorities are read from priorities, which the caller can change
+static std::vector<QSharedPointer<Resource>> makePendingRequests(QObject* owner, std::vector<float>& priorities) {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+    std::vector<QSharedPointer<Resource>> resources;
+    for (size_t i = 0; i < priorities.size(); i++) {
+        priorities[i] = distribution(randomGenerator);
+        auto resource = QSharedPointer<Resource>::create(QUrl("http://localhost/resource" + QString::number(i)));
+        resource->setSelf(resource);
+        float* priority = &priorities[i];
+        resource->setLoadPriorityOperator(owner, [priority]() { return *priority; });
+        sharedItems->appendRequest(resource, NAN);
+        resources.push_back(resource);
+    }
+    return resources;
+}
+
+void ResourceTests::pendingRequestOrder() {
+    const int NUM_RESOURCES = 1000;
+
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    uint32_t requestLimit = sharedItems->getRequestLimit();
+    sharedItems->clear();
+    // everything waits
+    sharedItems->setRequestLimit(0);
+
+    QObject owner;
+    std::vector<float> priorities(NUM_RESOURCES);
+    auto resources = makePendingRequests(&owner, priorities);
+    QCOMPARE((int)sharedItems->getPendingRequestsCount(), NUM_RESOURCES);
+
+    // a local file goes first whatever its priority
+    auto fileResource = QSharedPointer<Resource>::create(QUrl("file:///resource"));
+    fileResource->setSelf(fileResource);
+    fileResource->setLoadPriorityOperator(&owner, []() { return -100.0f; });
+    sharedItems->appendRequest(fileResource, NAN);
+
+    // change priorities after they were appended, and free some resources
+    for (int i = 0; i < NUM_RESOURCES; i += 2) {
+        priorities[i] = -priorities[i];
+    }
+    const int NUM_FREED = 10;
+    for (int i = 0; i < NUM_FREED; i++) {
+        resources[i * 7].reset();
+    }
+    sharedItems->updatePendingPriorities();
+
+    auto first = sharedItems->getHighestPendingRequest();
+    QCOMPARE(first.first, fileResource);
+
+    float previousPriority = FLT_MAX;
+    int numDispatched = 0;
+    for (auto request = sharedItems->getHighestPendingRequest(); request.first; request = sharedItems->getHighestPendingRequest()) {
+        QVERIFY(request.second <= previousPriority);
+        QCOMPARE(request.second, request.first->getLoadPriority());
+        previousPriority = request.second;
+        numDispatched++;
+    }
+    QCOMPARE(numDispatched, NUM_RESOURCES - NUM_FREED);
+    QCOMPARE((int)sharedItems->getPendingRequestsCount(), 0);
+
+    sharedItems->setRequestLimit(requestLimit);
+}
+
+void ResourceTests::benchmarkPendingRequests10k() {
+    const int NUM_RESOURCES = 10000;
+
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    uint32_t requestLimit = sharedItems->getRequestLimit();
+    sharedItems->clear();
+    sharedItems->setRequestLimit(0);
+
+    QObject owner;
+    std::vector<float> priorities(NUM_RESOURCES);
+    QElapsedTimer timer;
+    timer.start();
+    auto resources = makePendingRequests(&owner, priorities);
+    qint64 appendTime = timer.nsecsElapsed();
+
+    // what each dispatch used to cost: evaluating every pending priority
+    const int NUM_LINEAR_DISPATCHES = 100;
+    QList<QWeakPointer<Resource>> linearRequests;
+    for (const auto& resource : resources) {
+        linearRequests.append(resource);
+    }
+    timer.restart();
+    for (int i = 0; i < NUM_LINEAR_DISPATCHES; i++) {
+        int highestIndex = -1;
+        float highestPriority = -FLT_MAX;
+        for (int j = 0; j < linearRequests.size(); j++) {
+            auto resource = linearRequests.at(j).lock();
+            float priority = resource->getLoadPriority();
+            if (priority >= highestPriority) {
+                highestPriority = priority;
+                highestIndex = j;
+            }
+        }
+        linearRequests.removeAt(highestIndex);
+    }
+    double linearDispatches = (double)NUM_LINEAR_DISPATCHES * NSECS_PER_SECOND / (double)std::max(timer.nsecsElapsed(), (qint64)1);
+
+    // one refresh per frame, as when the camera moves
+    const int DISPATCHES_PER_REFRESH = 100;
+    int numDispatched = 0;
+    timer.restart();
+    while (sharedItems->getHighestPendingRequest().first) {
+        if (++numDispatched % DISPATCHES_PER_REFRESH == 0) {
+            sharedItems->updatePendingPriorities();
+        }
+    }
+    double heapDispatches = (double)numDispatched * NSECS_PER_SECOND / (double)std::max(timer.nsecsElapsed(), (qint64)1);
+
+    qInfo() << NUM_RESOURCES << "pending requests, appended in" << appendTime / NSECS_PER_MSEC << "ms, dispatches per second:"
+            << linearDispatches << "linear," << heapDispatches << "heap";
+    QCOMPARE(numDispatched, NUM_RESOURCES);
+    QVERIFY(heapDispatches > linearDispatches);
+
+    sharedItems->setRequestLimit(requestLimit);
+}
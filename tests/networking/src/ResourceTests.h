@@ -18,6 +18,8 @@ private slots:
     void initTestCase();
     void downloadFirst();
     void downloadAgain();
+    void pendingRequestOrder();
+    void benchmarkPendingRequests10k();
     void cleanupTestCase();
 };
 
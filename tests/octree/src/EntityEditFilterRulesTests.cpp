@@ -0,0 +1,230 @@
+//
+//  EntityEditFilterRulesTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EntityEditFilterRulesTests.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <EntityEditFilterRules.h>
+#include <EntityTree.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(EntityEditFilterRulesTests)
+
+static EntityEditFilterRulesPointer compileRules(const char* json) {
+    QString error;
+    auto rules = EntityEditFilterRules::compile(QByteArray(json), error);
+    if (!error.isEmpty()) {
+        qWarning() << error;
+    }
+    return rules;
+}
+
+void EntityEditFilterRulesTests::scriptIsNotRules() {
+    QString error;
+    auto rules = EntityEditFilterRules::compile("function filter(properties) { return properties; }", error);
+    QVERIFY(!rules);
+    QVERIFY(error.isEmpty());
+}
+
+void EntityEditFilterRulesTests::invalidRules() {
+    QString error;
+    QVERIFY(!EntityEditFilterRules::compile(R"({ "rules": [ { "clamp": "notAProperty" } ] })", error));
+    QVERIFY(!error.isEmpty());
+
+    error.clear();
+    QVERIFY(!EntityEditFilterRules::compile(R"({ "filterTypes": [ "edit" ] })", error));
+    QVERIFY(!error.isEmpty());
+}
+
+void EntityEditFilterRulesTests::clampRules() {
+    auto rules = compileRules(R"({ "rules": [
+        { "clamp": "velocity", "min": -10, "max": 10 },
+        { "clamp": "angularVelocity", "maxLength": 1 },
+        { "clamp": "emitRate", "max": 100 }
+    ] })");
+    QVERIFY(rules);
+
+    EntityItemProperties properties;
+    properties.setVelocity(glm::vec3(20.0f, -20.0f, 5.0f));
+    properties.setAngularVelocity(glm::vec3(0.0f, 3.0f, 0.0f));
+    properties.setEmitRate(500.0f);
+    bool wasChanged = false;
+    QVERIFY(rules->apply(properties, EntityTree::FilterType::Edit, EntityItemID(QUuid::createUuid()), nullptr, nullptr, wasChanged));
+    QVERIFY(wasChanged);
+    QCOMPARE(properties.getVelocity(), glm::vec3(10.0f, -10.0f, 5.0f));
+    QCOMPARE(properties.getAngularVelocity(), glm::vec3(0.0f, 1.0f, 0.0f));
+    QCOMPARE(properties.getEmitRate(), 100.0f);
+
+    // unchanged properties are left alone
+    EntityItemProperties untouched;
+    untouched.setVelocity(glm::vec3(1.0f));
+    wasChanged = false;
+    QVERIFY(rules->apply(untouched, EntityTree::FilterType::Edit, EntityItemID(QUuid::createUuid()), nullptr, nullptr, wasChanged));
+    QVERIFY(!wasChanged);
+    QVERIFY(!untouched.emitRateChanged());
+}
+
+void EntityEditFilterRulesTests::rejectRules() {
+    auto rules = compileRules(R"({ "filterTypes": [ "add" ], "rules": [ { "reject": "dimensions", "max": [ 10, 10, 10 ] } ] })");
+    QVERIFY(rules);
+
+    EntityItemProperties properties;
+    properties.setDimensions(glm::vec3(1.0f, 100.0f, 1.0f));
+    bool wasChanged = false;
+    QVERIFY(!rules->apply(properties, EntityTree::FilterType::Add, EntityItemID(), nullptr, nullptr, wasChanged));
+    // edits aren't filtered by these rules
+    QVERIFY(rules->apply(properties, EntityTree::FilterType::Edit, EntityItemID(), nullptr, nullptr, wasChanged));
+    QVERIFY(!wasChanged);
+}
+
+void EntityEditFilterRulesTests::lockedProperties() {
+    auto rules = compileRules(R"({ "rules": [ { "lockedProperties": [ "serverScripts" ] } ] })");
+    QVERIFY(rules);
+
+    EntityItemProperties properties;
+    properties.setServerScripts("https://example.com/script.js");
+    bool wasChanged = false;
+    QVERIFY(!rules->apply(properties, EntityTree::FilterType::Edit, EntityItemID(QUuid::createUuid()), nullptr, nullptr, wasChanged));
+    QVERIFY(rules->apply(properties, EntityTree::FilterType::Add, EntityItemID(QUuid::createUuid()), nullptr, nullptr, wasChanged));
+}
+
+void EntityEditFilterRulesTests::keepInsideZone() {
+    auto clampRules = compileRules(R"({ "rules": [ { "keepInsideZone": "clamp" } ] })");
+    auto rejectRules = compileRules(R"({ "rules": [ { "keepInsideZone": "reject" } ] })");
+    QVERIFY(clampRules && rejectRules);
+
+    AABox zone(glm::vec3(0.0f), 10.0f);
+    EntityItemProperties properties;
+    properties.setPosition(glm::vec3(5.0f, 20.0f, 5.0f));
+    bool wasChanged = false;
+    QVERIFY(!rejectRules->apply(properties, EntityTree::FilterType::Edit, EntityItemID(), nullptr, &zone, wasChanged));
+    QVERIFY(clampRules->apply(properties, EntityTree::FilterType::Edit, EntityItemID(), nullptr, &zone, wasChanged));
+    QVERIFY(wasChanged);
+    QCOMPARE(properties.getPosition(), glm::vec3(5.0f, 10.0f, 5.0f));
+}
+
+void EntityEditFilterRulesTests::rateLimit() {
+    auto rules = compileRules(R"({ "rules": [ { "rateLimit": 0.001, "burst": 3 } ] })");
+    QVERIFY(rules);
+
+    EntityItemID entityID(QUuid::createUuid());
+    EntityItemID otherEntityID(QUuid::createUuid());
+    EntityItemProperties properties;
+    bool wasChanged = false;
+    for (int i = 0; i < 3; i++) {
+        QVERIFY(rules->apply(properties, EntityTree::FilterType::Physics, entityID, nullptr, nullptr, wasChanged));
+    }
+    QVERIFY(!rules->apply(properties, EntityTree::FilterType::Physics, entityID, nullptr, nullptr, wasChanged));
+    // buckets are per entity
+    QVERIFY(rules->apply(properties, EntityTree::FilterType::Physics, otherEntityID, nullptr, nullptr, wasChanged));
+
+    // adds have no entity yet, so their buckets are per sender
+    QUuid senderID = QUuid::createUuid();
+    QUuid otherSenderID = QUuid::createUuid();
+    for (int i = 0; i < 3; i++) {
+        QVERIFY(rules->apply(properties, EntityTree::FilterType::Add, EntityItemID(), nullptr, nullptr, wasChanged, senderID));
+    }
+    QVERIFY(!rules->apply(properties, EntityTree::FilterType::Add, EntityItemID(), nullptr, nullptr, wasChanged, senderID));
+    QVERIFY(rules->apply(properties, EntityTree::FilterType::Add, EntityItemID(), nullptr, nullptr, wasChanged, otherSenderID));
+}
+
+void EntityEditFilterRulesTests::prefilterUnknownEntity() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+
+    // an edit that arrives before its entity can't be checked ahead of time, so it must get every filter when applied
+    EntityTree::PrefilteredEdit edit;
+    edit.validEditPacket = true;
+    edit.entityItemID = EntityItemID(QUuid::createUuid());
+    edit.properties.setVelocity(glm::vec3(20.0f));
+    tree->prefilterEdit(edit, EntityTree::FilterType::Edit, true);
+    QVERIFY(!edit.nativeFiltered);
+    QVERIFY(edit.getRemainingFilterPass() == EntityTree::FilterPass::All);
+
+    // an add has no entity to wait for
+    EntityTree::PrefilteredEdit add;
+    add.validEditPacket = true;
+    add.entityItemID = EntityItemID(QUuid::createUuid());
+    tree->prefilterEdit(add, EntityTree::FilterType::Add, true);
+    QVERIFY(add.nativeFiltered);
+    QVERIFY(add.getRemainingFilterPass() == EntityTree::FilterPass::ScriptOnly);
+
+    // without native filters the edit is still looked up ahead of time, and left to the full filter
+    EntityTree::PrefilteredEdit unfiltered;
+    unfiltered.validEditPacket = true;
+    unfiltered.entityItemID = add.entityItemID;
+    tree->prefilterEdit(unfiltered, EntityTree::FilterType::Add, false);
+    QVERIFY(!unfiltered.nativeFiltered);
+    QVERIFY(unfiltered.getRemainingFilterPass() == EntityTree::FilterPass::All);
+
+    // nor is an invalid edit filtered at all
+    EntityTree::PrefilteredEdit invalid;
+    tree->prefilterEdit(invalid, EntityTree::FilterType::Add, true);
+    QVERIFY(!invalid.nativeFiltered);
+}
+
+void EntityEditFilterRulesTests::benchmarkEditsPerCore() {
+    auto rules = compileRules(R"({ "rules": [
+        { "clamp": "velocity", "min": -10, "max": 10 },
+        { "clamp": "angularVelocity", "maxLength": 6.28 },
+        { "reject": "dimensions", "max": [ 100, 100, 100 ] },
+        { "lockedProperties": [ "serverScripts", "locked" ] },
+        { "rateLimit": 1000000, "burst": 1000000 }
+    ] })");
+    QVERIFY(rules);
+
+    const int NUM_EDITS = 100000;
+    std::vector<EntityItemProperties> edits(NUM_EDITS);
+    std::vector<EntityItemID> entityIDs(NUM_EDITS);
+    for (int i = 0; i < NUM_EDITS; i++) {
+        edits[i].setVelocity(glm::vec3((float)(i % 40) - 20.0f));
+        edits[i].setAngularVelocity(glm::vec3(0.0f, (float)(i % 10), 0.0f));
+        edits[i].setPosition(glm::vec3((float)i));
+        entityIDs[i] = QUuid::createUuid();
+    }
+
+    auto filterEdits = [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            EntityItemProperties properties = edits[i];
+            bool wasChanged = false;
+            rules->apply(properties, EntityTree::FilterType::Physics, entityIDs[i], nullptr, nullptr, wasChanged);
+        }
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+    filterEdits(0, NUM_EDITS);
+    qint64 singleCoreNsecs = std::max<qint64>(1, timer.nsecsElapsed());
+
+    int numCores = std::max(1, QThread::idealThreadCount());
+    int editsPerCore = NUM_EDITS / numCores;
+    timer.restart();
+    std::vector<QFuture<void>> futures;
+    for (int core = 0; core < numCores; core++) {
+        int begin = core * editsPerCore;
+        int end = core == numCores - 1 ? NUM_EDITS : begin + editsPerCore;
+        futures.push_back(QtConcurrent::run([&filterEdits, begin, end] { filterEdits(begin, end); }));
+    }
+    for (auto& future : futures) {
+        future.waitForFinished();
+    }
+    qint64 allCoresNsecs = std::max<qint64>(1, timer.nsecsElapsed());
+
+    double singleCoreEditsPerSecond = (double)NUM_EDITS * NSECS_PER_SECOND / singleCoreNsecs;
+    double allCoresEditsPerSecond = (double)NUM_EDITS * NSECS_PER_SECOND / allCoresNsecs;
+    qInfo() << "Native edit filter:" << (int)singleCoreEditsPerSecond << "edits/s on one core,"
+            << (int)(allCoresEditsPerSecond / numCores) << "edits/s per core on" << numCores << "cores";
+
+    QBENCHMARK {
+        filterEdits(0, NUM_EDITS);
+    }
+}
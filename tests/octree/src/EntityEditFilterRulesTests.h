@@ -0,0 +1,32 @@
+//
+//  EntityEditFilterRulesTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_EntityEditFilterRulesTests_h
+#define hifi_EntityEditFilterRulesTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEditFilterRulesTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void scriptIsNotRules();
+    void invalidRules();
+    void clampRules();
+    void rejectRules();
+    void lockedProperties();
+    void keepInsideZone();
+    void rateLimit();
+    void prefilterUnknownEntity();
+    void benchmarkEditsPerCore();
+};
+
+#endif // hifi_EntityEditFilterRulesTests_h
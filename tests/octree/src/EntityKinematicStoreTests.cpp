@@ -0,0 +1,191 @@
+//
+//  EntityKinematicStoreTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EntityKinematicStoreTests.h"
+
+#include <EntityKinematicStore.h>
+#include <EntitySimulation.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(EntityKinematicStoreTests)
+
+const uint64_t START_TIME = 1000 * USECS_PER_SECOND;
+const uint64_t FRAME_USECS = USECS_PER_SECOND / 60;
+
+// exposes the simple kinematic motion of EntitySimulation without an EntityTree
+class KinematicTestSimulation : public EntitySimulation {
+public:
+    void addKinematicEntity(const EntityItemPointer& entity) { _simpleKinematicEntities.insert(entity); }
+    int getNumKinematicEntities() const { return _simpleKinematicEntities.size(); }
+    void step(uint64_t now) {
+        moveSimpleKinematics(now);
+        _entitiesToSort.clear();
+    }
+};
+
+static EntityItemPointer makeMovingEntity(int i) {
+    auto entity = std::make_shared<EntityItem>(EntityItemID(QUuid::createUuid()));
+    Transform transform;
+    transform.setTranslation(glm::vec3((float)(i % 100), (float)(i / 100 % 100), (float)(i / 10000)));
+    glm::vec3 velocity((float)(i % 7) - 3.0f, 1.0f, (float)(i % 5) - 2.0f);
+    glm::vec3 angularVelocity(0.0f, (float)(i % 3), 0.5f);
+    entity->setLocalTransformAndVelocities(transform, velocity, angularVelocity);
+    if (i % 2) {
+        entity->setAcceleration(glm::vec3(0.0f, -9.8f, 0.0f));
+    }
+    entity->setLastSimulated(START_TIME);
+    return entity;
+}
+
+void EntityKinematicStoreTests::matchesPerEntityMotion() {
+    const int NUM_ENTITIES = 1000;
+    const int NUM_FRAMES = 120;
+
+    KinematicTestSimulation perEntity;
+    KinematicTestSimulation columnar;
+    columnar.setUseColumnarKinematics(true);
+
+    std::vector<EntityItemPointer> perEntityEntities;
+    std::vector<EntityItemPointer> columnarEntities;
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        perEntityEntities.push_back(makeMovingEntity(i));
+        columnarEntities.push_back(makeMovingEntity(i));
+        perEntity.addKinematicEntity(perEntityEntities.back());
+        columnar.addKinematicEntity(columnarEntities.back());
+    }
+
+    for (int frame = 1; frame <= NUM_FRAMES; frame++) {
+        perEntity.step(START_TIME + frame * FRAME_USECS);
+        columnar.step(START_TIME + frame * FRAME_USECS);
+    }
+
+    const float EPSILON = 1.0e-4f;
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        const auto& expected = perEntityEntities[i];
+        const auto& actual = columnarEntities[i];
+        QVERIFY(glm::distance(expected->getLocalPosition(), actual->getLocalPosition()) < EPSILON);
+        QVERIFY(glm::abs(glm::dot(expected->getLocalOrientation(), actual->getLocalOrientation())) > 1.0f - EPSILON);
+        QVERIFY(glm::distance(expected->getLocalVelocity(), actual->getLocalVelocity()) < EPSILON);
+        QCOMPARE(actual->getLastSimulated(), expected->getLastSimulated());
+    }
+}
+
+void EntityKinematicStoreTests::stopsAndRemoves() {
+    KinematicTestSimulation simulation;
+    simulation.setUseColumnarKinematics(true);
+
+    auto entity = std::make_shared<EntityItem>(EntityItemID(QUuid::createUuid()));
+    entity->setDamping(0.0f);
+    // slower than the kinematic threshold, so it comes to rest on the first integrated step
+    entity->setLocalTransformAndVelocities(Transform(), glm::vec3(0.0005f, 0.0f, 0.0f), glm::vec3(0.0f));
+    entity->setLastSimulated(START_TIME);
+    simulation.addKinematicEntity(entity);
+
+    simulation.step(START_TIME + FRAME_USECS);
+    QCOMPARE(simulation.getNumKinematicEntities(), 0);
+    QCOMPARE(entity->getLocalVelocity(), glm::vec3(0.0f));
+}
+
+void EntityKinematicStoreTests::stopsStoredEntity() {
+    KinematicTestSimulation simulation;
+    simulation.setUseColumnarKinematics(true);
+
+    auto entity = std::make_shared<EntityItem>(EntityItemID(QUuid::createUuid()));
+    entity->setDamping(0.5f);
+    // too small an acceleration to integrate, but still one to clear once the entity stops
+    entity->setAcceleration(glm::vec3(0.0f, 0.005f, 0.0f));
+    entity->setLocalTransformAndVelocities(Transform(), glm::vec3(0.0012f, 0.0f, 0.0f), glm::vec3(0.0f));
+    entity->setLastSimulated(START_TIME);
+
+    // the first step only gathers it, the second halves its speed, the third takes it under the threshold
+    simulation.addKinematicEntity(entity);
+    simulation.step(START_TIME);
+    simulation.step(START_TIME + USECS_PER_SECOND);
+    QCOMPARE(simulation.getNumKinematicEntities(), 1);
+    entity->clearDirtyFlags();
+    simulation.step(START_TIME + 2 * USECS_PER_SECOND);
+
+    QCOMPARE(simulation.getNumKinematicEntities(), 0);
+    QCOMPARE(entity->getLocalVelocity(), glm::vec3(0.0f));
+    QCOMPARE(entity->getAcceleration(), glm::vec3(0.0f));
+    QVERIFY(entity->getDirtyFlags() & Simulation::DIRTY_MOTION_TYPE);
+}
+
+void EntityKinematicStoreTests::snapshot() {
+    const int NUM_ENTITIES = 100;
+    KinematicTestSimulation simulation;
+    simulation.setUseColumnarKinematics(true);
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        simulation.addKinematicEntity(makeMovingEntity(i));
+    }
+
+    simulation.step(START_TIME + FRAME_USECS);
+    auto first = simulation.getKinematicSnapshot();
+    QCOMPARE((int)first->entityIDs.size(), NUM_ENTITIES);
+    QCOMPARE(first->timestamp, START_TIME + FRAME_USECS);
+
+    simulation.step(START_TIME + 2 * FRAME_USECS);
+    auto second = simulation.getKinematicSnapshot();
+    QCOMPARE(second->timestamp, START_TIME + 2 * FRAME_USECS);
+
+    // a snapshot held by a reader is never modified by later steps
+    QCOMPARE(first->timestamp, START_TIME + FRAME_USECS);
+    QVERIFY(first->positions != second->positions);
+
+    // only the rows a step moved are published
+    simulation.step(START_TIME + 2 * FRAME_USECS);
+    auto third = simulation.getKinematicSnapshot();
+    QCOMPARE(third->timestamp, START_TIME + 2 * FRAME_USECS);
+    QVERIFY(third->entityIDs.empty());
+    QCOMPARE((int)second->entityIDs.size(), NUM_ENTITIES);
+}
+
+void EntityKinematicStoreTests::benchmarkStep100k() {
+    const int NUM_ENTITIES = 100000;
+    const int NUM_FRAMES = 30;
+
+    auto runFrames = [&](bool useColumnarKinematics) {
+        KinematicTestSimulation simulation;
+        simulation.setUseColumnarKinematics(useColumnarKinematics);
+        for (int i = 0; i < NUM_ENTITIES; i++) {
+            auto entity = makeMovingEntity(i);
+            entity->setAcceleration(glm::vec3(0.0f));
+            entity->setDamping(0.0f);
+            entity->setAngularDamping(0.0f);
+            simulation.addKinematicEntity(entity);
+        }
+        // the first step gathers the columns
+        simulation.step(START_TIME + FRAME_USECS);
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int frame = 2; frame < NUM_FRAMES + 2; frame++) {
+            simulation.step(START_TIME + frame * FRAME_USECS);
+        }
+        return (double)timer.nsecsElapsed() / NUM_FRAMES / NSECS_PER_MSEC;
+    };
+
+    double perEntityMsecs = runFrames(false);
+    double columnarMsecs = runFrames(true);
+    qInfo() << "Stepping" << NUM_ENTITIES << "kinematic entities, ms per frame:" << perEntityMsecs << "one entity at a time,"
+            << columnarMsecs << "columnar";
+
+    KinematicTestSimulation simulation;
+    simulation.setUseColumnarKinematics(true);
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        simulation.addKinematicEntity(makeMovingEntity(i));
+    }
+    uint64_t now = START_TIME;
+    QBENCHMARK {
+        now += FRAME_USECS;
+        simulation.step(now);
+    }
+}
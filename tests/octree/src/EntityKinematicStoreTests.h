@@ -0,0 +1,28 @@
+//
+//  EntityKinematicStoreTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_EntityKinematicStoreTests_h
+#define hifi_EntityKinematicStoreTests_h
+
+#include <QtTest/QtTest>
+
+class EntityKinematicStoreTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void matchesPerEntityMotion();
+    void stopsAndRemoves();
+    void stopsStoredEntity();
+    void snapshot();
+    void benchmarkStep100k();
+};
+
+#endif // hifi_EntityKinematicStoreTests_h
@@ -0,0 +1,410 @@
+//
+//  EntitySpatialIndexTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "EntitySpatialIndexTests.h"
+
+#include <functional>
+#include <random>
+
+#include <EntitySpatialIndex.h>
+#include <EntityTree.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(EntitySpatialIndexTests)
+
+const float WORLD_SIZE = 1000.0f;
+
+static std::mt19937 randomGenerator(1234);
+
+static float randomFloat(float minimum, float maximum) {
+    return std::uniform_real_distribution<float>(minimum, maximum)(randomGenerator);
+}
+
+static glm::vec3 randomPoint() {
+    return glm::vec3(randomFloat(0.0f, WORLD_SIZE), randomFloat(0.0f, WORLD_SIZE), randomFloat(0.0f, WORLD_SIZE));
+}
+
+static glm::vec3 randomDirection() {
+    glm::vec3 direction(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f));
+    return glm::length(direction) > EPSILON ? glm::normalize(direction) : glm::vec3(1.0f, 0.0f, 0.0f);
+}
+
+static EntityItemPointer makeEntity() {
+    auto entity = std::make_shared<EntityItem>(EntityItemID(QUuid::createUuid()));
+    entity->setLocalPosition(randomPoint());
+    entity->setUnscaledDimensions(glm::vec3(randomFloat(0.1f, 5.0f), randomFloat(0.1f, 5.0f), randomFloat(0.1f, 5.0f)));
+    return entity;
+}
+
+static std::vector<EntityItemPointer> makeEntities(EntitySpatialIndex& index, int numEntities) {
+    std::vector<EntityItemPointer> entities;
+    for (int i = 0; i < numEntities; i++) {
+        entities.push_back(makeEntity());
+        index.add(entities.back());
+    }
+    return entities;
+}
+
+static bool contains(const std::vector<EntityItemPointer>& candidates, const EntityItemPointer& entity) {
+    return std::find(candidates.begin(), candidates.end(), entity) != candidates.end();
+}
+
+static bool contains(const std::vector<EntitySpatialIndex::RayCandidate>& candidates, const EntityItemPointer& entity) {
+    return std::find_if(candidates.begin(), candidates.end(), [&](const EntitySpatialIndex::RayCandidate& candidate) {
+        return candidate.entity == entity;
+    }) != candidates.end();
+}
+
+static bool rayHitsEntityBox(const EntityItemPointer& entity, const glm::vec3& origin, const glm::vec3& direction) {
+    bool success;
+    AABox box = entity->getAABox(success);
+    float distance;
+    BoxFace face;
+    glm::vec3 normal;
+    return success && box.findRayIntersection(origin, direction, 1.0f / direction, distance, face, normal);
+}
+
+void EntitySpatialIndexTests::sphereAndBoxCandidates() {
+    const int NUM_ENTITIES = 5000;
+    const int NUM_QUERIES = 200;
+
+    EntitySpatialIndex index;
+    auto entities = makeEntities(index, NUM_ENTITIES);
+    QCOMPARE(index.size(), NUM_ENTITIES);
+
+    for (int q = 0; q < NUM_QUERIES; q++) {
+        glm::vec3 center = randomPoint();
+        float radius = randomFloat(1.0f, 50.0f);
+        std::vector<EntityItemPointer> candidates;
+        index.findInSphere(center, radius, candidates);
+
+        // the index may return extra candidates, but never miss an entity
+        for (const auto& entity : entities) {
+            bool success;
+            glm::vec3 penetration;
+            if (entity->getAABox(success).findSpherePenetration(center, radius, penetration)) {
+                QVERIFY(contains(candidates, entity));
+            }
+        }
+
+        AABox box(center, glm::vec3(radius));
+        index.findInBox(box, candidates);
+        for (const auto& entity : entities) {
+            bool success;
+            if (entity->getAABox(success).touches(box)) {
+                QVERIFY(contains(candidates, entity));
+            }
+        }
+    }
+}
+
+void EntitySpatialIndexTests::rayCandidates() {
+    const int NUM_ENTITIES = 5000;
+    const int NUM_QUERIES = 200;
+
+    EntitySpatialIndex index;
+    auto entities = makeEntities(index, NUM_ENTITIES);
+
+    for (int q = 0; q < NUM_QUERIES; q++) {
+        glm::vec3 origin = randomPoint();
+        glm::vec3 direction = randomDirection();
+        std::vector<EntitySpatialIndex::RayCandidate> candidates;
+        index.findAlongRay(origin, direction, candidates);
+
+        QVERIFY(std::is_sorted(candidates.begin(), candidates.end()));
+        for (const auto& entity : entities) {
+            if (rayHitsEntityBox(entity, origin, direction)) {
+                QVERIFY(contains(candidates, entity));
+            }
+        }
+    }
+}
+
+void EntitySpatialIndexTests::batchedMatchesSingle() {
+    const int NUM_ENTITIES = 5000;
+    // more than one batch of traversal
+    const int NUM_QUERIES = 150;
+
+    EntitySpatialIndex index;
+    makeEntities(index, NUM_ENTITIES);
+
+    std::vector<EntitySpatialIndex::Ray> rays;
+    std::vector<EntitySpatialIndex::Sphere> spheres;
+    for (int q = 0; q < NUM_QUERIES; q++) {
+        rays.push_back({ randomPoint(), randomDirection() });
+        spheres.push_back({ randomPoint(), randomFloat(1.0f, 50.0f) });
+    }
+
+    std::vector<std::vector<EntitySpatialIndex::RayCandidate>> rayResults;
+    index.findAlongRays(rays, rayResults);
+    std::vector<std::vector<EntityItemPointer>> sphereResults;
+    index.findInSpheres(spheres, sphereResults);
+    QCOMPARE((int)rayResults.size(), NUM_QUERIES);
+    QCOMPARE((int)sphereResults.size(), NUM_QUERIES);
+
+    for (int q = 0; q < NUM_QUERIES; q++) {
+        std::vector<EntitySpatialIndex::RayCandidate> rayCandidates;
+        index.findAlongRay(rays[q].origin, rays[q].direction, rayCandidates);
+        QCOMPARE(rayResults[q].size(), rayCandidates.size());
+        for (size_t i = 0; i < rayCandidates.size(); i++) {
+            QCOMPARE(rayResults[q][i].distance, rayCandidates[i].distance);
+        }
+
+        std::vector<EntityItemPointer> sphereCandidates;
+        index.findInSphere(spheres[q].center, spheres[q].radius, sphereCandidates);
+        std::sort(sphereCandidates.begin(), sphereCandidates.end());
+        std::sort(sphereResults[q].begin(), sphereResults[q].end());
+        QVERIFY(sphereCandidates == sphereResults[q]);
+    }
+}
+
+void EntitySpatialIndexTests::followsChanges() {
+    const int NUM_ENTITIES = 1000;
+
+    EntitySpatialIndex index;
+    auto entities = makeEntities(index, NUM_ENTITIES);
+
+    const glm::vec3 FAR_AWAY(-WORLD_SIZE);
+    std::vector<EntityItemPointer> candidates;
+    index.findInSphere(FAR_AWAY, 1.0f, candidates);
+    QVERIFY(candidates.empty());
+
+    // move one entity far away, and check that the cached bounds follow it
+    auto moved = entities[NUM_ENTITIES / 2];
+    glm::vec3 oldPosition = moved->getWorldPosition();
+    const glm::vec3 UNTOUCHED(WORLD_SIZE * 3.0f);
+    uint64_t farVersion = index.getVersion(FAR_AWAY - glm::vec3(1.0f), FAR_AWAY + glm::vec3(1.0f));
+    uint64_t oldVersion = index.getVersion(oldPosition - glm::vec3(0.01f), oldPosition + glm::vec3(0.01f));
+    uint64_t untouchedVersion = index.getVersion(UNTOUCHED - glm::vec3(1.0f), UNTOUCHED + glm::vec3(1.0f));
+    moved->setLocalPosition(FAR_AWAY);
+    index.markChanged(moved->getEntityItemID());
+    // the regions it left and entered change, the others don't
+    QVERIFY(index.getVersion(FAR_AWAY - glm::vec3(1.0f), FAR_AWAY + glm::vec3(1.0f)) != farVersion);
+    QVERIFY(index.getVersion(oldPosition - glm::vec3(0.01f), oldPosition + glm::vec3(0.01f)) != oldVersion);
+    QCOMPARE(index.getVersion(UNTOUCHED - glm::vec3(1.0f), UNTOUCHED + glm::vec3(1.0f)), untouchedVersion);
+
+    index.findInSphere(FAR_AWAY, 1.0f, candidates);
+    QCOMPARE((int)candidates.size(), 1);
+    QCOMPARE(candidates[0], moved);
+    index.findInSphere(oldPosition, 0.01f, candidates);
+    QVERIFY(!contains(candidates, moved));
+
+    // remove it, then add a new one in the same place
+    index.remove(moved->getEntityItemID());
+    index.findInSphere(FAR_AWAY, 1.0f, candidates);
+    QVERIFY(candidates.empty());
+    QCOMPARE(index.size(), NUM_ENTITIES - 1);
+
+    auto added = makeEntity();
+    added->setLocalPosition(FAR_AWAY);
+    index.add(added);
+    index.findInSphere(FAR_AWAY, 1.0f, candidates);
+    QCOMPARE((int)candidates.size(), 1);
+    QCOMPARE(candidates[0], added);
+
+    // enough additions force a rebuild, after which everything can still be found
+    uint64_t numBuilds = index.getStats().numBuilds;
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        entities.push_back(makeEntity());
+        index.add(entities.back());
+    }
+    index.findInSphere(FAR_AWAY, 1.0f, candidates);
+    QVERIFY(index.getStats().numBuilds > numBuilds);
+    QCOMPARE(index.getStats().numUnindexed, 0);
+    for (int i = 0; i < 100; i++) {
+        const auto& entity = entities[entities.size() - 1 - i];
+        index.findInSphere(entity->getWorldPosition(), 0.01f, candidates);
+        QVERIFY(contains(candidates, entity));
+    }
+
+    index.clear();
+    QCOMPARE(index.size(), 0);
+    index.findInSphere(FAR_AWAY, 1.0f, candidates);
+    QVERIFY(candidates.empty());
+}
+
+static QVector<QUuid> sorted(QVector<QUuid> ids) {
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+// Runs the same queries through an EntityTree with the index on and off, and checks that they agree.
+void EntitySpatialIndexTests::treeQueriesMatchOctree() {
+    const int NUM_ENTITIES = 2000;
+    const int NUM_QUERIES = 200;
+
+    EntityTree tree;
+    tree.createRootElement();
+    QVERIFY(tree.getUseSpatialIndex());
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setPosition(randomPoint());
+        properties.setDimensions(glm::vec3(randomFloat(0.1f, 5.0f), randomFloat(0.1f, 5.0f), randomFloat(0.1f, 5.0f)));
+        QVERIFY(tree.addEntity(EntityItemID(QUuid::createUuid()), properties));
+    }
+    QCOMPARE(tree.getSpatialIndexStats().numEntities, NUM_ENTITIES);
+
+    PickFilter searchFilter(PickFilter::getBitMask(PickFilter::DOMAIN_ENTITIES) |
+                            PickFilter::getBitMask(PickFilter::VISIBLE) | PickFilter::getBitMask(PickFilter::INVISIBLE) |
+                            PickFilter::getBitMask(PickFilter::COLLIDABLE) | PickFilter::getBitMask(PickFilter::NONCOLLIDABLE));
+    const glm::vec3 GRAVITY(0.0f, -9.8f, 0.0f);
+
+    struct Results {
+        QVector<QUuid> inSphere;
+        QVector<QUuid> inBox;
+        EntityItemID alongRay;
+        float rayDistance;
+        EntityItemID alongParabola;
+        float parabolicDistance;
+    };
+    auto runQueries = [&](std::mt19937 generator) {
+        std::swap(generator, randomGenerator);
+        std::vector<Results> results(NUM_QUERIES);
+        for (auto& result : results) {
+            glm::vec3 center = randomPoint();
+            tree.evalEntitiesInSphere(center, randomFloat(1.0f, 50.0f), searchFilter, result.inSphere);
+            result.inSphere = sorted(result.inSphere);
+            tree.evalEntitiesInBox(AABox(center, glm::vec3(randomFloat(1.0f, 50.0f))), searchFilter, result.inBox);
+            result.inBox = sorted(result.inBox);
+
+            OctreeElementPointer element;
+            BoxFace face;
+            glm::vec3 surfaceNormal;
+            QVariantMap extraInfo;
+            result.alongRay = tree.evalRayIntersection(center, randomDirection(), QVector<EntityItemID>(),
+                QVector<EntityItemID>(), searchFilter, element, result.rayDistance, face, surfaceNormal, extraInfo,
+                Octree::Lock);
+
+            glm::vec3 intersection;
+            float distance;
+            PickParabola parabola(center, randomDirection() * randomFloat(5.0f, 50.0f), GRAVITY);
+            result.alongParabola = tree.evalParabolaIntersection(parabola, QVector<EntityItemID>(), QVector<EntityItemID>(),
+                searchFilter, element, intersection, distance, result.parabolicDistance, face, surfaceNormal, extraInfo,
+                Octree::Lock);
+        }
+        std::swap(generator, randomGenerator);
+        return results;
+    };
+
+    std::mt19937 queryGenerator(5678);
+    auto indexed = runQueries(queryGenerator);
+    tree.setUseSpatialIndex(false);
+    QCOMPARE(tree.getSpatialIndexStats().numEntities, 0);
+    auto recursed = runQueries(queryGenerator);
+    tree.setUseSpatialIndex(true);
+    QCOMPARE(tree.getSpatialIndexStats().numEntities, NUM_ENTITIES);
+    auto reindexed = runQueries(queryGenerator);
+
+    int numRayHits = 0;
+    int numParabolaHits = 0;
+    for (int q = 0; q < NUM_QUERIES; q++) {
+        for (const auto* results : { &indexed, &reindexed }) {
+            const Results& result = (*results)[q];
+            QCOMPARE(result.inSphere, recursed[q].inSphere);
+            QCOMPARE(result.inBox, recursed[q].inBox);
+            QCOMPARE(result.alongRay, recursed[q].alongRay);
+            QCOMPARE(result.alongParabola, recursed[q].alongParabola);
+            if (!result.alongRay.isNull()) {
+                QCOMPARE(result.rayDistance, recursed[q].rayDistance);
+            }
+            if (!result.alongParabola.isNull()) {
+                QCOMPARE(result.parabolicDistance, recursed[q].parabolicDistance);
+            }
+        }
+        numRayHits += recursed[q].alongRay.isNull() ? 0 : 1;
+        numParabolaHits += recursed[q].alongParabola.isNull() ? 0 : 1;
+    }
+    // the comparison means little if nothing was hit
+    QVERIFY(numRayHits > 0);
+    QVERIFY(numParabolaHits > 0);
+}
+
+void EntitySpatialIndexTests::benchmarkPicks(int numEntities) {
+    const int NUM_QUERIES = 10000;
+
+    EntitySpatialIndex index;
+    auto entities = makeEntities(index, numEntities);
+    std::vector<AABox> boxes;
+    for (const auto& entity : entities) {
+        bool success;
+        boxes.push_back(entity->getAABox(success));
+    }
+
+    std::vector<EntitySpatialIndex::Ray> rays;
+    std::vector<EntitySpatialIndex::Sphere> spheres;
+    for (int q = 0; q < NUM_QUERIES; q++) {
+        rays.push_back({ randomPoint(), randomDirection() });
+        spheres.push_back({ randomPoint(), 10.0f });
+    }
+
+    // the first query builds the tree
+    std::vector<EntityItemPointer> candidates;
+    index.findInSphere(glm::vec3(0.0f), 1.0f, candidates);
+
+    auto queriesPerSecond = [&](const std::function<void()>& queries, int numQueries) {
+        QElapsedTimer timer;
+        timer.start();
+        queries();
+        return (double)numQueries * NSECS_PER_SECOND / (double)glm::max(timer.nsecsElapsed(), (qint64)1);
+    };
+
+    // testing every box is the baseline the index has to beat
+    const int NUM_LINEAR_QUERIES = 100;
+    int linearHits = 0;
+    double linearRays = queriesPerSecond([&] {
+        for (int q = 0; q < NUM_LINEAR_QUERIES; q++) {
+            glm::vec3 invDirection = 1.0f / rays[q].direction;
+            for (const auto& box : boxes) {
+                float distance;
+                BoxFace face;
+                glm::vec3 normal;
+                linearHits += box.findRayIntersection(rays[q].origin, rays[q].direction, invDirection, distance, face, normal);
+            }
+        }
+    }, NUM_LINEAR_QUERIES);
+
+    double singleRays = queriesPerSecond([&] {
+        std::vector<EntitySpatialIndex::RayCandidate> rayCandidates;
+        for (const auto& ray : rays) {
+            index.findAlongRay(ray.origin, ray.direction, rayCandidates);
+        }
+    }, NUM_QUERIES);
+
+    double batchedRays = queriesPerSecond([&] {
+        std::vector<std::vector<EntitySpatialIndex::RayCandidate>> rayCandidates;
+        index.findAlongRays(rays, rayCandidates);
+    }, NUM_QUERIES);
+
+    double singleSpheres = queriesPerSecond([&] {
+        for (const auto& sphere : spheres) {
+            index.findInSphere(sphere.center, sphere.radius, candidates);
+        }
+    }, NUM_QUERIES);
+
+    double batchedSpheres = queriesPerSecond([&] {
+        std::vector<std::vector<EntityItemPointer>> sphereCandidates;
+        index.findInSpheres(spheres, sphereCandidates);
+    }, NUM_QUERIES);
+
+    qInfo() << numEntities << "entities, queries per second:" << linearRays << "linear rays," << singleRays << "rays,"
+            << batchedRays << "batched rays," << singleSpheres << "spheres," << batchedSpheres << "batched spheres"
+            << "(" << linearHits << "linear hits)";
+    QVERIFY(singleRays > linearRays);
+}
+
+void EntitySpatialIndexTests::benchmarkPicks10k() {
+    benchmarkPicks(10000);
+}
+
+void EntitySpatialIndexTests::benchmarkPicks100k() {
+    benchmarkPicks(100000);
+}
@@ -0,0 +1,33 @@
+//
+//  EntitySpatialIndexTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_EntitySpatialIndexTests_h
+#define hifi_EntitySpatialIndexTests_h
+
+#include <QtTest/QtTest>
+
+class EntitySpatialIndexTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void sphereAndBoxCandidates();
+    void rayCandidates();
+    void batchedMatchesSingle();
+    void followsChanges();
+    void treeQueriesMatchOctree();
+    void benchmarkPicks10k();
+    void benchmarkPicks100k();
+
+private:
+    void benchmarkPicks(int numEntities);
+};
+
+#endif // hifi_EntitySpatialIndexTests_h
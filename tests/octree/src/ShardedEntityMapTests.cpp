@@ -0,0 +1,170 @@
+//
+//  ShardedEntityMapTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ShardedEntityMapTests.h"
+
+#include <atomic>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <ShardedEntityMap.h>
+
+QTEST_MAIN(ShardedEntityMapTests)
+
+static EntityItemPointer makeEntity() {
+    return std::make_shared<EntityItem>(EntityItemID(QUuid::createUuid()));
+}
+
+void ShardedEntityMapTests::insertAndRemove() {
+    ShardedEntityMap map;
+    auto entity = makeEntity();
+    auto id = entity->getEntityItemID();
+
+    QVERIFY(!map.contains(id));
+    QVERIFY(map.insert(id, entity));
+    QCOMPARE(map.value(id), entity);
+    QCOMPARE(map.size(), 1);
+
+    // a second entity with the same ID is refused and doesn't replace the first
+    QVERIFY(!map.insert(id, std::make_shared<EntityItem>(id)));
+    QCOMPARE(map.value(id), entity);
+
+    map.remove(id);
+    QVERIFY(!map.contains(id));
+    QCOMPARE(map.size(), 0);
+}
+
+void ShardedEntityMapTests::snapshotAndReset() {
+    const int NUM_ENTITIES = 1000;
+    ShardedEntityMap map;
+    QHash<EntityItemID, EntityItemPointer> entities;
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        auto entity = makeEntity();
+        entities.insert(entity->getEntityItemID(), entity);
+        map.insert(entity->getEntityItemID(), entity);
+    }
+
+    QCOMPARE(map.size(), NUM_ENTITIES);
+    QCOMPARE(map.snapshot(), entities);
+
+    int visited = 0;
+    map.forEach([&](const EntityItemPointer& entity) {
+        QVERIFY(entities.value(entity->getEntityItemID()) == entity);
+        visited++;
+    });
+    QCOMPARE(visited, NUM_ENTITIES);
+
+    QHash<EntityItemID, EntityItemPointer> kept;
+    for (auto it = entities.constBegin(); it != entities.constEnd() && kept.size() < NUM_ENTITIES / 2; ++it) {
+        kept.insert(it.key(), it.value());
+    }
+    map.reset(kept);
+    QCOMPARE(map.size(), kept.size());
+    QCOMPARE(map.snapshot(), kept);
+
+    map.clear();
+    QCOMPARE(map.size(), 0);
+}
+
+void ShardedEntityMapTests::concurrentReadersAndWriters() {
+    const int NUM_WRITERS = 4;
+    const int ENTITIES_PER_WRITER = 5000;
+    ShardedEntityMap map;
+
+    std::vector<std::vector<EntityItemPointer>> entities(NUM_WRITERS);
+    for (auto& writerEntities : entities) {
+        for (int i = 0; i < ENTITIES_PER_WRITER; i++) {
+            writerEntities.push_back(makeEntity());
+        }
+    }
+
+    std::atomic<bool> writing { true };
+    std::atomic<int> lookups { 0 };
+    auto reader = QtConcurrent::run([&] {
+        while (writing) {
+            for (const auto& writerEntities : entities) {
+                auto entity = writerEntities[lookups % ENTITIES_PER_WRITER];
+                auto found = map.value(entity->getEntityItemID());
+                if (found && found != entity) {
+                    qWarning() << "found the wrong entity";
+                }
+                lookups++;
+            }
+        }
+    });
+
+    std::vector<QFuture<void>> writers;
+    for (int writer = 0; writer < NUM_WRITERS; writer++) {
+        writers.push_back(QtConcurrent::run([&, writer] {
+            for (const auto& entity : entities[writer]) {
+                map.insert(entity->getEntityItemID(), entity);
+            }
+            // remove every other entity again
+            for (int i = 0; i < ENTITIES_PER_WRITER; i += 2) {
+                map.remove(entities[writer][i]->getEntityItemID());
+            }
+        }));
+    }
+    for (auto& future : writers) {
+        future.waitForFinished();
+    }
+    writing = false;
+    reader.waitForFinished();
+
+    QCOMPARE(map.size(), NUM_WRITERS * ENTITIES_PER_WRITER / 2);
+    for (const auto& writerEntities : entities) {
+        for (int i = 0; i < ENTITIES_PER_WRITER; i++) {
+            QCOMPARE(map.contains(writerEntities[i]->getEntityItemID()), i % 2 == 1);
+        }
+    }
+
+    auto stats = map.getLockStats();
+    // the lookups, the inserts and removes, and the size() and contains() checks above
+    quint64 numLocks = lookups + NUM_WRITERS * (ENTITIES_PER_WRITER + ENTITIES_PER_WRITER / 2) +
+        ShardedEntityMap::NUM_SHARDS + NUM_WRITERS * ENTITIES_PER_WRITER;
+    QVERIFY(stats.contendedLocks <= numLocks);
+    qInfo() << "Sharded entity map:" << lookups << "concurrent lookups," << stats.contendedLocks << "of"
+            << numLocks << "lock acquisitions contended";
+}
+
+void ShardedEntityMapTests::takeAllKeepsConcurrentInserts() {
+    const int NUM_ENTITIES = 20000;
+    ShardedEntityMap map;
+
+    std::vector<EntityItemPointer> entities;
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        entities.push_back(makeEntity());
+    }
+
+    auto writer = QtConcurrent::run([&] {
+        for (const auto& entity : entities) {
+            map.insert(entity->getEntityItemID(), entity);
+        }
+    });
+    // every entity ends up either in one of the taken maps or still in the map, exactly once
+    QHash<EntityItemID, EntityItemPointer> taken;
+    while (!writer.isFinished()) {
+        auto someTaken = map.takeAll();
+        for (auto it = someTaken.constBegin(); it != someTaken.constEnd(); ++it) {
+            QVERIFY(!taken.contains(it.key()));
+            taken.insert(it.key(), it.value());
+        }
+    }
+    writer.waitForFinished();
+
+    auto remaining = map.takeAll();
+    QCOMPARE(map.size(), 0);
+    for (const auto& entity : entities) {
+        auto id = entity->getEntityItemID();
+        QVERIFY(taken.contains(id) != remaining.contains(id));
+    }
+    QCOMPARE(taken.size() + remaining.size(), NUM_ENTITIES);
+}
@@ -0,0 +1,27 @@
+//
+//  ShardedEntityMapTests.h
+//  tests/octree/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_ShardedEntityMapTests_h
+#define hifi_ShardedEntityMapTests_h
+
+#include <QtTest/QtTest>
+
+class ShardedEntityMapTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void insertAndRemove();
+    void snapshotAndReset();
+    void concurrentReadersAndWriters();
+    void takeAllKeepsConcurrentInserts();
+};
+
+#endif // hifi_ShardedEntityMapTests_h
@@ -13,9 +13,11 @@
 
 #include <iostream>
 
+#include <ShapeCache.h>
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
+#include <NumericalConstants.h>
 
 QTEST_MAIN(ShapeManagerTests)
 
@@ -244,3 +246,198 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+class CountingTriangleCallback : public btTriangleCallback {
+public:
+    void processTriangle(btVector3* triangle, int partId, int triangleIndex) override { ++numTriangles; }
+    int numTriangles { 0 };
+};
+
+void ShapeManagerTests::cacheCookedShapes() {
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    auto shapeCache = std::make_shared<ShapeCache>(cacheDir.path().toStdString());
+    shapeCache->initialize();
+
+    // a compound of hulls with many points
+    ShapeInfo compoundInfo;
+    ShapeInfo::PointCollection pointCollection;
+    const int NUM_HULLS = 4;
+    const int NUM_POINTS_PER_HULL = 200;
+    for (int i = 0; i < NUM_HULLS; ++i) {
+        ShapeInfo::PointList points;
+        for (int j = 0; j < NUM_POINTS_PER_HULL; ++j) {
+            float angle = (float)j * 0.1f;
+            points.push_back(glm::vec3((float)i + cosf(angle), sinf(angle), (float)(j % 7) * 0.1f));
+        }
+        pointCollection.push_back(points);
+    }
+    compoundInfo.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(3.0f, 1.0f, 1.0f));
+    compoundInfo.setPointCollection(pointCollection);
+    QVERIFY(ShapeCache::shouldCache(compoundInfo));
+
+    // a static mesh grid, offset so that it gets wrapped in a compound
+    const int GRID_SIZE = 30;
+    ShapeInfo meshInfo;
+    meshInfo.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(0.5f * GRID_SIZE, 1.0f, 0.5f * GRID_SIZE));
+    ShapeInfo::PointList gridPoints;
+    for (int z = 0; z <= GRID_SIZE; ++z) {
+        for (int x = 0; x <= GRID_SIZE; ++x) {
+            gridPoints.push_back(glm::vec3((float)x, sinf((float)(x + z)), (float)z));
+        }
+    }
+    meshInfo.setPointCollection(ShapeInfo::PointCollection({ gridPoints }));
+    ShapeInfo::TriangleIndices& indices = meshInfo.getTriangleIndices();
+    for (int z = 0; z < GRID_SIZE; ++z) {
+        for (int x = 0; x < GRID_SIZE; ++x) {
+            int i = z * (GRID_SIZE + 1) + x;
+            indices << i << i + 1 << i + GRID_SIZE + 1 << i + 1 << i + GRID_SIZE + 2 << i + GRID_SIZE + 1;
+        }
+    }
+    meshInfo.setOffset(glm::vec3(1.0f, 0.0f, 0.0f));
+    QVERIFY(ShapeCache::shouldCache(meshInfo));
+
+    // the first time the shapes are cooked and stored
+    const btCollisionShape* cookedCompound = ShapeFactory::createShapeFromInfo(compoundInfo, shapeCache);
+    const btCollisionShape* cookedMesh = ShapeFactory::createShapeFromInfo(meshInfo, shapeCache);
+    QVERIFY(cookedCompound && cookedMesh);
+    QCOMPARE(shapeCache->getNumHits(), (uint64_t)0);
+    QCOMPARE(shapeCache->getNumMisses(), (uint64_t)2);
+    QCOMPARE((int)shapeCache->getNumTotalFiles(), 2);
+
+    // the second time they are read back
+    const btCollisionShape* cachedCompound = ShapeFactory::createShapeFromInfo(compoundInfo, shapeCache);
+    const btCollisionShape* cachedMesh = ShapeFactory::createShapeFromInfo(meshInfo, shapeCache);
+    QVERIFY(cachedCompound && cachedMesh);
+    QCOMPARE(shapeCache->getNumHits(), (uint64_t)2);
+
+    // and match the cooked ones
+    btTransform identity;
+    identity.setIdentity();
+    auto compareAabbs = [&](const btCollisionShape* a, const btCollisionShape* b) {
+        btVector3 minA, maxA, minB, maxB;
+        a->getAabb(identity, minA, maxA);
+        b->getAabb(identity, minB, maxB);
+        QVERIFY((minA - minB).length() < EPSILON);
+        QVERIFY((maxA - maxB).length() < EPSILON);
+    };
+    QCOMPARE(cachedCompound->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    const btCompoundShape* cookedHulls = static_cast<const btCompoundShape*>(cookedCompound);
+    const btCompoundShape* cachedHulls = static_cast<const btCompoundShape*>(cachedCompound);
+    QCOMPARE(cachedHulls->getNumChildShapes(), NUM_HULLS);
+    for (int i = 0; i < NUM_HULLS; ++i) {
+        auto cookedHull = static_cast<const btConvexHullShape*>(cookedHulls->getChildShape(i));
+        auto cachedHull = static_cast<const btConvexHullShape*>(cachedHulls->getChildShape(i));
+        QCOMPARE(cachedHull->getNumPoints(), cookedHull->getNumPoints());
+        QCOMPARE(cachedHull->getMargin(), cookedHull->getMargin());
+    }
+    compareAabbs(cookedCompound, cachedCompound);
+    compareAabbs(cookedMesh, cachedMesh);
+
+    // the BVH that was read back finds the same triangles
+    QCOMPARE(cachedMesh->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    // performRaycast() isn't const
+    auto getMeshShape = [](const btCollisionShape* shape) {
+        auto child = static_cast<const btCompoundShape*>(shape)->getChildShape(0);
+        return const_cast<btBvhTriangleMeshShape*>(static_cast<const btBvhTriangleMeshShape*>(child));
+    };
+    btBvhTriangleMeshShape* cookedMeshShape = getMeshShape(cookedMesh);
+    btBvhTriangleMeshShape* cachedMeshShape = getMeshShape(cachedMesh);
+    for (int i = 0; i < GRID_SIZE; ++i) {
+        btVector3 from((float)i + 0.3f, 10.0f, (float)i + 0.6f);
+        btVector3 to((float)(GRID_SIZE - i) - 0.2f, -10.0f, 0.4f);
+        CountingTriangleCallback cookedHits, cachedHits;
+        cookedMeshShape->performRaycast(&cookedHits, from, to);
+        cachedMeshShape->performRaycast(&cachedHits, from, to);
+        QVERIFY(cookedHits.numTriangles > 0);
+        QCOMPARE(cachedHits.numTriangles, cookedHits.numTriangles);
+    }
+
+    // small shapes aren't worth caching
+    ShapeInfo boxInfo;
+    boxInfo.setBox(glm::vec3(1.0f));
+    QVERIFY(!ShapeCache::shouldCache(boxInfo));
+
+    ShapeFactory::deleteShape(cookedCompound);
+    ShapeFactory::deleteShape(cookedMesh);
+    ShapeFactory::deleteShape(cachedCompound);
+    ShapeFactory::deleteShape(cachedMesh);
+}
+
+static const int NUM_HULLS = 16;
+
+static ShapeInfo makeManyHullInfo() {
+    ShapeInfo::PointCollection pointCollection;
+    const int NUM_POINTS_PER_HULL = 100;
+    for (int i = 0; i < NUM_HULLS; ++i) {
+        ShapeInfo::PointList points;
+        for (int j = 0; j < NUM_POINTS_PER_HULL; ++j) {
+            float angle = (float)j * 0.37f;
+            points.push_back(glm::vec3((float)i + cosf(angle), sinf(angle), (float)(j % 5) * 0.2f));
+        }
+        pointCollection.push_back(points);
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(0.5f * NUM_HULLS, 1.0f, 1.0f));
+    info.setPointCollection(pointCollection);
+    return info;
+}
+
+void ShapeManagerTests::cookShapesAsync() {
+    ShapeManager shapeManager;
+
+    // small shapes are still built right away
+    ShapeInfo boxInfo;
+    boxInfo.setBox(glm::vec3(1.0f));
+    QVERIFY(!ShapeManager::shouldCookAsync(boxInfo));
+    const btCollisionShape* box = shapeManager.requestShape(boxInfo, 1.0f);
+    QVERIFY(box != nullptr);
+    QCOMPARE(shapeManager.getWorkRequestCount(), (uint32_t)0);
+
+    // a compound of many hulls with many points each is cooked on a worker
+    ShapeInfo info = makeManyHullInfo();
+    QVERIFY(ShapeManager::shouldCookAsync(info));
+
+    // requests for the same shape are merged
+    QVERIFY(shapeManager.requestShape(info, 10.0f) == nullptr);
+    QVERIFY(shapeManager.requestShape(info, 1.0f) == nullptr);
+    QCOMPARE(shapeManager.getWorkRequestCount(), (uint32_t)2);
+    QTRY_COMPARE(shapeManager.getWorkDeliveryCount(), (uint32_t)1);
+
+    const btCollisionShape* shape = shapeManager.getShapeByKey(info.getHash());
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    QCOMPARE(static_cast<const btCompoundShape*>(shape)->getNumChildShapes(), NUM_HULLS);
+    QCOMPARE(shapeManager.requestShape(info, 1.0f), shape);
+    QCOMPARE(shapeManager.getNumReferences(info), 2);
+
+    // getShape() still builds hulls right away
+    ShapeInfo otherInfo = info;
+    otherInfo.setOffset(glm::vec3(1.0f, 0.0f, 0.0f));
+    QVERIFY(shapeManager.getShape(otherInfo) != nullptr);
+    QCOMPARE(shapeManager.getWorkDeliveryCount(), (uint32_t)1);
+
+    shapeManager.releaseShape(shape);
+    shapeManager.releaseShape(shape);
+    shapeManager.releaseShape(box);
+}
+
+void ShapeManagerTests::getShapeWhileCooking() {
+    ShapeManager shapeManager;
+    ShapeInfo info = makeManyHullInfo();
+
+    // a worker starts on the shape, then getShape() builds it right away
+    QVERIFY(shapeManager.requestShape(info, 1.0f) == nullptr);
+    const btCollisionShape* shape = shapeManager.getShape(info);
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shapeManager.getNumShapes(), 1);
+
+    // the worker's copy is dropped, and the shape in use keeps its references
+    QTRY_COMPARE(shapeManager.getWorkDeliveryCount(), (uint32_t)1);
+    QCOMPARE(shapeManager.getNumShapes(), 1);
+    QCOMPARE(shapeManager.getShapeByKey(info.getHash()), shape);
+    QCOMPARE(shapeManager.getNumReferences(info), 2);
+
+    shapeManager.releaseShape(shape);
+    shapeManager.releaseShape(shape);
+}
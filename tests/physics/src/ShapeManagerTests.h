@@ -25,6 +25,9 @@ private slots:
     void addCylinderShape();
     void addCapsuleShape();
     void addCompoundShape();
+    void cacheCookedShapes();
+    void cookShapesAsync();
+    void getShapeWhileCooking();
 };
 
 #endif // hifi_ShapeManagerTests_h
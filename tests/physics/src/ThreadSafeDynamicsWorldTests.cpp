@@ -0,0 +1,171 @@
+//
+//  ThreadSafeDynamicsWorldTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "ThreadSafeDynamicsWorldTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+#ifdef HIFI_BULLET_MULTITHREADING
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#endif
+
+#include <BulletTaskScheduler.h>
+#include <NumericalConstants.h>
+#include <ThreadSafeDynamicsWorld.h>
+
+QTEST_MAIN(ThreadSafeDynamicsWorldTests)
+
+const btScalar FIXED_SUBSTEP = btScalar(1.0) / btScalar(90.0);
+const int MAX_SUBSTEPS = 6;
+
+// A headless world of plain rigid bodies (no motion states) dropped in piles on a ground plane,
+// built the way PhysicsEngine::init builds its world.
+class StressWorld {
+public:
+    StressWorld(int numBodies) {
+        _broadphase.reset(new btDbvtBroadphase());
+#ifdef HIFI_BULLET_MULTITHREADING
+        BulletTaskScheduler* scheduler = BulletTaskScheduler::install();
+        _dispatcher.reset(new btCollisionDispatcherMt(&_config));
+        _solverPool.reset(new btConstraintSolverPoolMt(scheduler->getMaxNumThreads()));
+        _solver.reset(new btSequentialImpulseConstraintSolverMt());
+        _world.reset(new ThreadSafeDynamicsWorld(_dispatcher.get(), _broadphase.get(),
+                                                 static_cast<btConstraintSolverPoolMt*>(_solverPool.get()),
+                                                 _solver.get(), &_config));
+#else
+        _dispatcher.reset(new btCollisionDispatcher(&_config));
+        _solver.reset(new btSequentialImpulseConstraintSolver());
+        _world.reset(new ThreadSafeDynamicsWorld(_dispatcher.get(), _broadphase.get(), _solver.get(), &_config));
+#endif
+        _world->setGravity(btVector3(0.0f, -9.8f, 0.0f));
+
+        _ground.reset(new btStaticPlaneShape(btVector3(0.0f, 1.0f, 0.0f), 0.0f));
+        addBody(_ground.get(), 0.0f, btVector3(0.0f, 0.0f, 0.0f));
+
+        // piles of ten, far enough apart that the world splits into many islands
+        _box.reset(new btBoxShape(btVector3(0.5f, 0.5f, 0.5f)));
+        _sphere.reset(new btSphereShape(0.5f));
+        const int PILE_HEIGHT = 10;
+        const float PILE_SPACING = 3.0f;
+        int numPiles = (numBodies + PILE_HEIGHT - 1) / PILE_HEIGHT;
+        int pilesPerRow = (int)ceilf(sqrtf((float)numPiles));
+        for (int i = 0; i < numBodies; i++) {
+            int pile = i / PILE_HEIGHT;
+            int level = i % PILE_HEIGHT;
+            btVector3 position(PILE_SPACING * (float)(pile % pilesPerRow), 0.5f + 1.1f * (float)level,
+                               PILE_SPACING * (float)(pile / pilesPerRow));
+            // jitter the piles so that they topple
+            position += btVector3(0.05f * (float)(level % 3), 0.0f, 0.05f * (float)(level % 2));
+            addBody((i % 2) ? _box.get() : _sphere.get(), 1.0f, position);
+        }
+    }
+
+    ~StressWorld() {
+        for (auto& body : _bodies) {
+            _world->removeRigidBody(body.get());
+        }
+    }
+
+    ThreadSafeDynamicsWorld* getWorld() const { return _world.get(); }
+    const std::vector<std::unique_ptr<btRigidBody>>& getBodies() const { return _bodies; }
+
+private:
+    void addBody(btCollisionShape* shape, btScalar mass, const btVector3& position) {
+        btVector3 inertia(0.0f, 0.0f, 0.0f);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+        btRigidBody::btRigidBodyConstructionInfo info(mass, nullptr, shape, inertia);
+        info.m_startWorldTransform.setOrigin(position);
+        _bodies.emplace_back(new btRigidBody(info));
+        _world->addRigidBody(_bodies.back().get());
+    }
+
+    btDefaultCollisionConfiguration _config;
+    std::unique_ptr<btBroadphaseInterface> _broadphase;
+    std::unique_ptr<btCollisionDispatcher> _dispatcher;
+    std::unique_ptr<btConstraintSolver> _solverPool;
+    std::unique_ptr<btConstraintSolver> _solver;
+    std::unique_ptr<ThreadSafeDynamicsWorld> _world;
+    std::unique_ptr<btCollisionShape> _ground;
+    std::unique_ptr<btCollisionShape> _box;
+    std::unique_ptr<btCollisionShape> _sphere;
+    std::vector<std::unique_ptr<btRigidBody>> _bodies;
+};
+
+void ThreadSafeDynamicsWorldTests::substepCallback() {
+    StressWorld stress(100);
+    ThreadSafeDynamicsWorld* world = stress.getWorld();
+
+    // the callback runs once per substep, after the substep has finished
+    int numCallbacks = 0;
+    int numSubsteps = world->stepSimulationWithSubstepCallback(3.5f * FIXED_SUBSTEP, MAX_SUBSTEPS, FIXED_SUBSTEP, [&] {
+        ++numCallbacks;
+        QCOMPARE(world->getNumSubsteps(), 3);
+    });
+    QCOMPARE(numSubsteps, 3);
+    QCOMPARE(numCallbacks, 3);
+
+    // too long a step is clamped to MAX_SUBSTEPS
+    numCallbacks = 0;
+    world->stepSimulationWithSubstepCallback(20.0f * FIXED_SUBSTEP, MAX_SUBSTEPS, FIXED_SUBSTEP, [&] { ++numCallbacks; });
+    QCOMPARE(numCallbacks, MAX_SUBSTEPS);
+}
+
+void ThreadSafeDynamicsWorldTests::benchmarkStep5k() {
+    const int NUM_BODIES = 5000;
+    const int NUM_STEPS = 180;
+
+    // without BULLET2_MULTITHREADING both runs are single threaded
+#ifdef HIFI_BULLET_MULTITHREADING
+    BulletTaskScheduler* scheduler = BulletTaskScheduler::install();
+    int maxNumThreads = scheduler->getMaxNumThreads();
+#else
+    int maxNumThreads = 1;
+#endif
+
+    int numFallen = 0;
+    auto simulate = [&](int numThreads) {
+#ifdef HIFI_BULLET_MULTITHREADING
+        scheduler->setNumThreads(numThreads);
+#endif
+        StressWorld stress(NUM_BODIES);
+        ThreadSafeDynamicsWorld* world = stress.getWorld();
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < NUM_STEPS; i++) {
+            world->stepSimulationWithSubstepCallback(FIXED_SUBSTEP, MAX_SUBSTEPS, FIXED_SUBSTEP);
+        }
+        qint64 nsecs = timer.nsecsElapsed();
+
+        // nothing may fall through the ground, whatever the number of threads
+        for (const auto& body : stress.getBodies()) {
+            if (!body->isStaticObject() && body->getWorldTransform().getOrigin().getY() < 0.0f) {
+                ++numFallen;
+            }
+        }
+        return nsecs;
+    };
+
+    qint64 serialNsecs = simulate(1);
+    qint64 parallelNsecs = simulate(maxNumThreads);
+    QCOMPARE(numFallen, 0);
+
+    qInfo() << NUM_BODIES << "bodies," << NUM_STEPS << "steps:" << (double)serialNsecs / NSECS_PER_MSEC << "msec with 1 thread,"
+            << (double)parallelNsecs / NSECS_PER_MSEC << "msec with" << maxNumThreads << "threads, speedup"
+            << (double)serialNsecs / (double)std::max(parallelNsecs, (qint64)1);
+}
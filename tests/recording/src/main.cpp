@@ -27,10 +27,20 @@
 #include <Windows.h>
 #endif
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonDocument>
+
 #include <recording/Clip.h>
+#include <recording/Deck.h>
 #include <recording/Frame.h>
+#include <recording/Recorder.h>
+#include <recording/impl/ClipIndex.h>
+#include <recording/impl/FileClipWriter.h>
 
+#include <AvatarData.h>
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
+#include <WarningsSuppression.h>
 
 #include "Constants.h"
 
@@ -101,6 +111,41 @@ void testFilePersist() {
     QVERIFY(readClip->duration() == 5.0f);
 }
 
+// A recording written to a file as it is made reads back the same as the recorded clip
+void testRecorderFile() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    const int NUM_FRAMES = 100;
+    ClipPointer recordedClip;
+    {
+        Recorder recorder;
+        recorder.start(fileName);
+        QVERIFY(recorder.getFilePath() == fileName);
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            recorder.recordFrame(TEST_FRAME_TYPE, QByteArray(16, (char)i));
+        }
+        recorder.stop();
+        recordedClip = recorder.getClip();
+        // destroying the recorder waits for the file to be written
+    }
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip);
+    QVERIFY(readClip->frameCount() == (size_t)NUM_FRAMES);
+    recordedClip->seek(0);
+    readClip->seek(0);
+    for (auto readFrame = readClip->nextFrame(), recordedFrame = recordedClip->nextFrame(); readFrame && recordedFrame;
+        readFrame = readClip->nextFrame(), recordedFrame = recordedClip->nextFrame()) {
+        QVERIFY(readFrame->timeOffset == recordedFrame->timeOffset);
+        QVERIFY(readFrame->data == recordedFrame->data);
+    }
+}
+
 void testClipOrdering() {
     auto writeClip = Clip::newClip();
     // simulate our of order addition of frames
@@ -119,10 +164,211 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+class TestAvatar : public AvatarData {
+public:
+    using AvatarData::setRawJointData;
+};
+
+// A walk cycle of sorts: every joint swings at its own rate, and the leaves move less than the rest
+static void poseAvatar(TestAvatar& avatar, int frame) {
+    const int NUM_JOINTS = 80;
+    QVector<JointData> joints(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        float angle = (i % 4 == 3) ? 0.0f : sinf(frame * 0.05f + i) * 0.5f;
+        joints[i].rotation = glm::angleAxis(angle, glm::normalize(glm::vec3(1.0f, i % 3, i % 5)));
+        joints[i].rotationIsDefaultPose = false;
+        joints[i].translation = glm::vec3(0.0f, 10.0f + i, 2.0f);
+        joints[i].translationIsDefaultPose = i > 0;
+    }
+    avatar.setRawJointData(joints);
+    avatar.setWorldPosition(glm::vec3(frame * 0.01f, 0.0f, 0.0f));
+}
+
+void testAvatarFramePlayback() {
+    const int NUM_FRAMES = 300;
+    const int NUM_AVATARS = 100;
+
+    TestAvatar recordedAvatar;
+    recordedAvatar.setRecordingBasis();
+    std::vector<QByteArray> jsonFrames;
+    std::vector<QByteArray> compactFrames;
+    std::vector<QVector<JointData>> recordedJoints;
+    size_t jsonSize = 0;
+    size_t compactSize = 0;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        poseAvatar(recordedAvatar, i);
+        OVERTE_IGNORE_DEPRECATED_BEGIN
+        jsonFrames.push_back(QJsonDocument(recordedAvatar.toJson()).toBinaryData());
+        OVERTE_IGNORE_DEPRECATED_END
+        compactFrames.push_back(AvatarData::toFrame(recordedAvatar));
+        recordedJoints.push_back(recordedAvatar.getRawJointData());
+        jsonSize += jsonFrames.back().size();
+        compactSize += compactFrames.back().size();
+    }
+    QVERIFY(AvatarData::isCompactFrame(compactFrames[0]));
+    QVERIFY(!AvatarData::isCompactFrame(jsonFrames[0]));
+
+    // compact frames play back the same pose, to within quantization
+    TestAvatar playedAvatar;
+    TestAvatar convertingAvatar;
+    TestAvatar convertedAvatar;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        AvatarData::fromFrame(compactFrames[i], playedAvatar);
+        AvatarData::fromFrame(AvatarData::toCompactFrame(jsonFrames[i], convertingAvatar), convertedAvatar);
+        const auto& played = playedAvatar.getRawJointData();
+        const auto& converted = convertedAvatar.getRawJointData();
+        QVERIFY(played.size() == recordedJoints[i].size());
+        QVERIFY(converted.size() == recordedJoints[i].size());
+        for (int j = 0; j < played.size(); j++) {
+            QVERIFY(played[j].rotationIsDefaultPose == recordedJoints[i][j].rotationIsDefaultPose);
+            QVERIFY(fabsf(glm::dot(played[j].rotation, recordedJoints[i][j].rotation)) > 0.9999f);
+            QVERIFY(fabsf(glm::dot(converted[j].rotation, recordedJoints[i][j].rotation)) > 0.9999f);
+            if (!played[j].translationIsDefaultPose) {
+                QVERIFY(glm::distance(played[j].translation, recordedJoints[i][j].translation) < 0.01f);
+            }
+        }
+    }
+
+    // after a seek, joints wait for the next keyframe instead of applying deltas to the wrong pose
+    TestAvatar seekingAvatar;
+    const int SEEK_FRAME = NUM_FRAMES / 2 + 1;
+    int frame = SEEK_FRAME;
+    while (seekingAvatar.getRawJointData().empty() && frame < NUM_FRAMES) {
+        AvatarData::fromFrame(compactFrames[frame++], seekingAvatar);
+    }
+    QVERIFY(frame > SEEK_FRAME + 1);
+    QVERIFY(frame - SEEK_FRAME < 60);
+    QVERIFY(fabsf(glm::dot(seekingAvatar.getRawJointData()[1].rotation, recordedJoints[frame - 1][1].rotation)) > 0.9999f);
+
+    // a deck seek replays the frames from the keyframe before the position, so the pose is right straight away
+    {
+        const Frame::Time FRAME_INTERVAL = 16;
+        auto avatarFrameType = Frame::registerFrameType(AvatarData::FRAME_NAME);
+        auto clip = Clip::newClip();
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            clip->addFrame(std::make_shared<Frame>(avatarFrameType, (float)(i * FRAME_INTERVAL), compactFrames[i]));
+        }
+        TestAvatar deckAvatar;
+        Frame::registerKeyframeTest(avatarFrameType, &AvatarData::isKeyframe);
+        Frame::registerFrameHandler(avatarFrameType, [&](Frame::ConstPointer frame) {
+            AvatarData::fromFrame(frame->data, deckAvatar);
+        });
+        Deck deck;
+        deck.queueClip(clip);
+        deck.seek(Frame::frameTimeToSeconds(SEEK_FRAME * FRAME_INTERVAL));
+        Frame::clearFrameHandler(avatarFrameType);
+        QVERIFY(!AvatarData::isKeyframe(compactFrames[SEEK_FRAME - 1]));
+        QVERIFY(deckAvatar.getRawJointData().size() == recordedJoints[SEEK_FRAME - 1].size());
+        QVERIFY(fabsf(glm::dot(deckAvatar.getRawJointData()[1].rotation, recordedJoints[SEEK_FRAME - 1][1].rotation)) > 0.9999f);
+        auto nextFrame = clip->nextFrame();
+        QVERIFY(nextFrame && nextFrame->timeOffset == SEEK_FRAME * FRAME_INTERVAL);
+    }
+
+    auto framesPerSecond = [&](const std::vector<QByteArray>& frames) {
+        std::vector<std::unique_ptr<TestAvatar>> avatars;
+        for (int i = 0; i < NUM_AVATARS; i++) {
+            avatars.push_back(std::make_unique<TestAvatar>());
+        }
+        QElapsedTimer timer;
+        timer.start();
+        for (const auto& frame : frames) {
+            for (auto& avatar : avatars) {
+                AvatarData::fromFrame(frame, *avatar);
+            }
+        }
+        return (double)(frames.size() * NUM_AVATARS) * NSECS_PER_SECOND / (double)std::max(timer.nsecsElapsed(), (qint64)1);
+    };
+    double jsonFramesPerSecond = framesPerSecond(jsonFrames);
+    double compactFramesPerSecond = framesPerSecond(compactFrames);
+
+    qInfo() << NUM_AVATARS << "avatars," << NUM_FRAMES << "frames:" << jsonSize << "bytes as JSON," << compactSize
+            << "bytes compact; frames played per second:" << jsonFramesPerSecond << "JSON," << compactFramesPerSecond << "compact";
+    QVERIFY(compactSize < jsonSize);
+    QVERIFY(compactFramesPerSecond > jsonFramesPerSecond);
+}
+
+// Opens and seeks a two hour clip, with and without its index
+void testLongClipSeek() {
+    const int FRAMES_PER_SECOND = 60;
+    const int NUM_FRAMES = 2 * 60 * 60 * FRAMES_PER_SECOND;
+    const int NUM_SEEKS = 1000;
+
+    QTemporaryFile file;
+    QTemporaryFile unindexedFile;
+    QString fileName;
+    QString unindexedFileName;
+    if (file.open() && unindexedFile.open()) {
+        fileName = file.fileName();
+        unindexedFileName = unindexedFile.fileName();
+        file.close();
+        unindexedFile.close();
+    }
+
+    std::vector<Frame::Time> frameTimes;
+    {
+        FileClipWriter writer(fileName);
+        QVERIFY(writer.isOpen());
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            auto frame = std::make_shared<Frame>();
+            frame->type = TEST_FRAME_TYPE;
+            frame->timeOffset = (Frame::Time)((quint64)i * MSECS_PER_SECOND / FRAMES_PER_SECOND);
+            frame->data = QByteArray(64, (char)i);
+            frame->data.append((const char*)&i, sizeof(i));
+            frameTimes.push_back(frame->timeOffset);
+            writer.addFrame(frame);
+        }
+        writer.close();
+        QVERIFY(writer.wait());
+    }
+
+    // The same clip as older versions wrote it, without the footer that locates the index
+    {
+        QFile input(fileName);
+        QFile output(unindexedFileName);
+        QVERIFY(input.open(QFile::ReadOnly) && output.open(QFile::Truncate | QFile::WriteOnly));
+        QByteArray data = input.readAll();
+        data.chop((int)index::footerFrameSize());
+        output.write(data);
+    }
+
+    auto measure = [&](const QString& fileName) {
+        QElapsedTimer timer;
+        timer.start();
+        auto clip = Clip::fromFile(fileName);
+        qint64 openTime = timer.nsecsElapsed();
+        QVERIFY(clip);
+        QVERIFY(clip->frameCount() == (size_t)NUM_FRAMES);
+        QVERIFY(clip->duration() == Frame::frameTimeToSeconds(frameTimes.back()));
+
+        srand(1);
+        timer.restart();
+        for (int i = 0; i < NUM_SEEKS; i++) {
+            Frame::Time time = (Frame::Time)(rand() % (frameTimes.back() + 1));
+            clip->seekFrameTime(time);
+            auto frame = clip->nextFrame();
+            QVERIFY(frame);
+            auto expected = std::lower_bound(frameTimes.begin(), frameTimes.end(), time) - frameTimes.begin();
+            int frameNumber;
+            memcpy(&frameNumber, frame->data.constData() + 64, sizeof(frameNumber));
+            QVERIFY(frame->timeOffset == frameTimes[expected]);
+            QVERIFY(frameNumber == expected);
+        }
+        qint64 seekTime = timer.nsecsElapsed() / NUM_SEEKS;
+
+        qInfo() << fileName << "with" << NUM_FRAMES << "frames: opened in" << openTime / NSECS_PER_MSEC << "ms,"
+                << "seek and read in" << seekTime / NSECS_PER_USEC << "us";
+    };
+    measure(fileName);
+    measure(unindexedFileName);
+}
+
 int main(int, const char**) {
     setupHifiApplication("Recording Test");
 
     testFrameTypeRegistration();
     testFilePersist();
+    testRecorderFile();
     testClipOrdering();
+    testAvatarFramePlayback();
+    testLongClipSeek();
 }
@@ -0,0 +1,535 @@
+//
+//  JoinStormApp.cpp
+//  tools/join-storm/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "JoinStormApp.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <QCommandLineParser>
+#include <QDataStream>
+#include <QFile>
+#include <QLoggingCategory>
+
+#include <glm/gtc/quaternion.hpp>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+#include <AudioConstants.h>
+#include <DomainHandler.h>
+#include <LimitedNodeList.h>
+#include <NetworkLogging.h>
+#include <Node.h>
+#include <NodePermissions.h>
+#include <NodeType.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+using namespace std::chrono;
+
+static const int CHECK_IN_INTERVAL_MSECS = 1000;
+
+// the noise is sent to the mixer as it is, so its agent only offers raw PCM
+static const QString NOISE_CODEC = "pcm";
+// how far from the noise the listeners stand, in meters
+static const float LISTENER_DISTANCE = 2.0f;
+
+JoinStormApp::JoinStormApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Overte domain-server join storm");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption verboseOutput("v", "verbose output");
+    parser.addOption(verboseOutput);
+
+    const QCommandLineOption domainAddressOption("d", "domain-server address", "IP:PORT");
+    parser.addOption(domainAddressOption);
+
+    const QCommandLineOption agentsOption("n", "number of agents to connect", "200");
+    parser.addOption(agentsOption);
+
+    const QCommandLineOption rateOption("r", "agents to connect per second", "50");
+    parser.addOption(rateOption);
+
+    const QCommandLineOption durationOption("t", "seconds to keep checking in once all agents are connecting", "30");
+    parser.addOption(durationOption);
+
+    const QCommandLineOption audioOption("a", "have the agents listen to the audio mixer, and report what it sends them");
+    parser.addOption(audioOption);
+
+    const QCommandLineOption codecOption("codec", "codec the listening agents ask the audio mixer for", "opus");
+    parser.addOption(codecOption);
+
+    const QCommandLineOption noiseOption("noise", "level in dBFS of the noise the first agent sends the audio mixer", "-50");
+    parser.addOption(noiseOption);
+
+    const QCommandLineOption mixerPIDOption("mixer-pid", "process ID of a local audio mixer, to report its CPU use", "PID");
+    parser.addOption(mixerPIDOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    _verbose = parser.isSet(verboseOutput);
+    if (!_verbose) {
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtDebugMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtInfoMsg, false);
+        const_cast<QLoggingCategory*>(&networking())->setEnabled(QtWarningMsg, false);
+    }
+
+    if (parser.isSet(agentsOption)) {
+        _numAgents = std::max(1, parser.value(agentsOption).toInt());
+    }
+    if (parser.isSet(rateOption)) {
+        _joinsPerSecond = std::max(0.1, parser.value(rateOption).toDouble());
+    }
+    if (parser.isSet(durationOption)) {
+        _checkInSeconds = std::max(0, parser.value(durationOption).toInt());
+    }
+    _hasNoiseSource = parser.isSet(noiseOption);
+    if (_hasNoiseSource) {
+        _noiseLevel = std::min(0.0f, parser.value(noiseOption).toFloat());
+    }
+    _listenToAudio = parser.isSet(audioOption) || _hasNoiseSource;
+    if (parser.isSet(codecOption)) {
+        _codec = parser.value(codecOption);
+    }
+    if (parser.isSet(mixerPIDOption)) {
+        _mixerPID = parser.value(mixerPIDOption).toLongLong();
+    }
+
+    _domainServerSockAddr = SockAddr(SocketType::UDP, QHostAddress::LocalHost, DEFAULT_DOMAIN_SERVER_PORT);
+    if (parser.isSet(domainAddressOption)) {
+        QString hostnamePortString = parser.value(domainAddressOption);
+
+        QHostAddress address { hostnamePortString.left(hostnamePortString.indexOf(':')) };
+        quint16 port { (quint16)hostnamePortString.mid(hostnamePortString.indexOf(':') + 1).toUInt() };
+        if (port == 0) {
+            port = DEFAULT_DOMAIN_SERVER_PORT;
+        }
+
+        if (address.isNull()) {
+            qCritical() << "Could not parse an IP address and port combination from" << hostnamePortString;
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+            return;
+        }
+        _domainServerSockAddr = SockAddr(SocketType::UDP, address, port);
+    }
+
+    qDebug() << "Connecting" << _numAgents << "agents to" << _domainServerSockAddr << "at" << _joinsPerSecond << "per second";
+
+    _agents.reserve(_numAgents);
+
+    connect(&_joinTimer, &QTimer::timeout, this, &JoinStormApp::joinNextAgent);
+    _joinTimer.setTimerType(Qt::PreciseTimer);
+    _joinTimer.start(std::max(1, (int)(MSECS_PER_SECOND / _joinsPerSecond)));
+
+    connect(&_checkInTimer, &QTimer::timeout, this, &JoinStormApp::checkIn);
+    _checkInTimer.start(CHECK_IN_INTERVAL_MSECS);
+
+    if (_listenToAudio) {
+        connect(&_audioTimer, &QTimer::timeout, this, &JoinStormApp::sendAudio);
+        _audioTimer.setTimerType(Qt::PreciseTimer);
+        _audioTimer.start((int)AudioConstants::NETWORK_FRAME_MSECS);
+    }
+}
+
+void JoinStormApp::joinNextAgent() {
+    if ((int)_agents.size() >= _numAgents) {
+        _joinTimer.stop();
+        _isMeasuring = true;
+        _measureStartTime = usecTimestampNow();
+        _mixerCPUStartSeconds = getMixerCPUSeconds();
+        QTimer::singleShot(_checkInSeconds * MSECS_PER_SECOND, this, &JoinStormApp::finish);
+        return;
+    }
+
+    auto agent = std::make_unique<Agent>();
+    agent->socket = std::make_unique<udt::Socket>();
+    agent->socket->bind(SocketType::UDP, QHostAddress::AnyIPv4);
+    agent->localSockAddr = SockAddr(SocketType::UDP, QHostAddress::LocalHost, agent->socket->localPort(SocketType::UDP));
+
+    // the noise stands at the origin, and the listeners spread out on a circle around it
+    agent->isNoiseSource = _hasNoiseSource && _agents.empty();
+    if (!agent->isNoiseSource) {
+        const float GOLDEN_ANGLE = 2.39996f;
+        float angle = GOLDEN_ANGLE * _agents.size();
+        agent->position = LISTENER_DISTANCE * glm::vec3(cosf(angle), 0.0f, sinf(angle));
+    }
+
+    Agent* agentPointer = agent.get();
+    agent->socket->setPacketHandler([this, agentPointer](std::unique_ptr<udt::Packet> packet) {
+        processPacket(*agentPointer, std::move(packet));
+    });
+
+    _agents.push_back(std::move(agent));
+    sendCheckIn(*agentPointer);
+}
+
+void JoinStormApp::checkIn() {
+    quint64 now = usecTimestampNow();
+    for (auto& agent : _agents) {
+        // agents keep to their own second, like clients that joined at different times
+        if (now - agent->lastCheckInTime >= (quint64)(CHECK_IN_INTERVAL_MSECS * USECS_PER_MSEC) - USECS_PER_MSEC) {
+            sendCheckIn(*agent);
+        }
+        if (_listenToAudio) {
+            connectToMixer(*agent);
+        }
+    }
+}
+
+void JoinStormApp::sendCheckIn(Agent& agent) {
+    bool isConnected = agent.connectedTime != 0;
+    if (agent.isAwaitingReply && isConnected) {
+        ++_numTimedOutCheckIns;
+    }
+
+    auto packet = NLPacket::create(isConnected ? PacketType::DomainListRequest : PacketType::DomainConnectRequest);
+    QDataStream packetStream(packet.get());
+
+    if (isConnected) {
+        // list requests are sourced, so the domain-server can tell which node they are from
+        packet->writeSourceID(agent.localID);
+    } else {
+        packetStream << QUuid();
+        QByteArray protocolVersionSig = protocolVersionsSignature();
+        packetStream.writeBytes(protocolVersionSig.constData(), protocolVersionSig.size());
+
+        // no hardware address, and a fingerprint of its own for each agent
+        packetStream << QString() << QUuid::createUuid();
+        packetStream << QByteArray();
+        packetStream << LimitedNodeList::ConnectReason::Connect;
+        packetStream << (quint64)0;
+    }
+
+    packetStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
+
+    QList<NodeType_t> interestList { NodeType::AudioMixer, NodeType::AvatarMixer, NodeType::EntityServer,
+                                     NodeType::AssetServer, NodeType::MessagesMixer, NodeType::EntityScriptServer };
+    packetStream << NodeType::Agent << agent.localSockAddr.getType() << agent.localSockAddr
+        << agent.localSockAddr.getType() << agent.localSockAddr << interestList;
+    packetStream << QString();
+
+    if (isConnected) {
+        packetStream << agent.domainListVersion;
+    } else {
+        // anonymous, with an empty signature
+        packetStream << QString() << QString("");
+    }
+
+    quint64 now = usecTimestampNow();
+    if (agent.firstConnectTime == 0) {
+        agent.firstConnectTime = now;
+    }
+    agent.lastCheckInTime = now;
+    agent.isAwaitingReply = true;
+
+    agent.socket->writePacket(*packet, _domainServerSockAddr);
+}
+
+void JoinStormApp::processPacket(Agent& agent, std::unique_ptr<udt::Packet> packet) {
+    auto nlPacket = NLPacket::fromBase(std::move(packet));
+
+    if (nlPacket->getType() == PacketType::DomainList) {
+        processDomainList(agent, *nlPacket);
+    } else if (nlPacket->getType() == PacketType::DomainConnectionDenied) {
+        qWarning() << "Agent on port" << agent.localSockAddr.getPort() << "was denied a connection";
+    } else if (nlPacket->getType() == PacketType::Ping && agent.mixerAuth) {
+        // answering the mixer's pings is how it finds the socket to send the mix to
+        PingType_t pingType;
+        quint64 pingTime;
+        nlPacket->readPrimitive(&pingType);
+        nlPacket->readPrimitive(&pingTime);
+
+        auto replyPacket = NLPacket::create(PacketType::PingReply, sizeof(PingType_t) + sizeof(quint64) + sizeof(quint64));
+        replyPacket->writePrimitive(pingType);
+        replyPacket->writePrimitive(pingTime);
+        replyPacket->writePrimitive(usecTimestampNow());
+        sendToMixer(agent, *replyPacket, nlPacket->getSenderSockAddr());
+    } else if (nlPacket->getType() == PacketType::PingReply && agent.mixerAuth) {
+        if (agent.mixerSockAddr.isNull()) {
+            agent.mixerSockAddr = nlPacket->getSenderSockAddr();
+            connectToMixer(agent);
+        }
+    } else if (nlPacket->getType() == PacketType::SelectedAudioFormat) {
+        agent.codec = nlPacket->readString();
+        agent.hasSelectedCodec = true;
+        if (agent.isNoiseSource && !agent.codec.isEmpty() && agent.codec != NOISE_CODEC) {
+            qWarning() << "The audio mixer picked" << agent.codec << "for the noise rather than" << NOISE_CODEC;
+        }
+    } else if (nlPacket->getType() == PacketType::MixedAudio || nlPacket->getType() == PacketType::SilentAudioFrame) {
+        if (_isMeasuring) {
+            if (nlPacket->getType() == PacketType::MixedAudio) {
+                ++agent.numMixPackets;
+            } else {
+                ++agent.numSilentMixPackets;
+            }
+            agent.numMixBytes += nlPacket->getDataSize();
+        }
+    } else if (_verbose) {
+        qDebug() << "Agent on port" << agent.localSockAddr.getPort() << "got packet" << nlPacket->getType();
+    }
+}
+
+void JoinStormApp::processDomainList(Agent& agent, const NLPacket& packet) {
+    quint64 now = usecTimestampNow();
+
+    QByteArray payload = QByteArray::fromRawData(packet.getPayload(), packet.getPayloadSize());
+    QDataStream packetStream(payload);
+
+    QUuid domainUUID, sessionUUID;
+    NLPacket::LocalID domainLocalID, localID;
+    NodePermissions permissions;
+    bool isAuthenticated, newConnection;
+    quint64 connectRequestTimestamp, pingSendTime, checkInProcessingTime;
+    quint32 domainListVersion, baseDomainListVersion, numDomainListEntries;
+    packetStream >> domainUUID >> domainLocalID >> sessionUUID >> localID >> permissions >> isAuthenticated
+        >> connectRequestTimestamp >> pingSendTime >> checkInProcessingTime >> newConnection
+        >> domainListVersion >> baseDomainListVersion >> numDomainListEntries;
+
+    ++_numDomainListPackets;
+    _numDomainListBytes += packet.getDataSize();
+
+    // time the reply from the first packet of it
+    if (agent.isAwaitingReply) {
+        agent.isAwaitingReply = false;
+        if (agent.connectedTime == 0) {
+            agent.connectedTime = now;
+            _connectLatencies.push_back(now - agent.firstConnectTime);
+            if (_verbose) {
+                qDebug() << "Agent on port" << agent.localSockAddr.getPort() << "connected as" << sessionUUID << "in"
+                         << (now - agent.firstConnectTime) / USECS_PER_MSEC << "ms";
+            }
+        } else {
+            _checkInLatencies.push_back(now - agent.lastCheckInTime);
+        }
+    }
+    agent.localID = localID;
+
+    // keep track of the node list version like a client does, so the domain-server can answer with what changed
+    if (baseDomainListVersion > agent.domainListVersion) {
+        return;
+    }
+    if (domainListVersion != agent.pendingDomainListVersion || baseDomainListVersion != agent.pendingDomainListBaseVersion ||
+        agent.pendingDomainListEntries.size() != numDomainListEntries) {
+        agent.pendingDomainListVersion = domainListVersion;
+        agent.pendingDomainListBaseVersion = baseDomainListVersion;
+        agent.pendingDomainListEntries.assign(numDomainListEntries, false);
+    }
+
+    while (!packetStream.atEnd()) {
+        quint32 entryIndex;
+        bool isRemoved;
+        packetStream >> entryIndex >> isRemoved;
+        if (isRemoved) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+        } else {
+            Node node(QUuid(), NodeType::Unassigned, SockAddr(), SockAddr());
+            QUuid connectionSecret;
+            packetStream >> node >> connectionSecret;
+            if (_listenToAudio && node.getType() == NodeType::AudioMixer && !agent.mixerAuth &&
+                packetStream.status() == QDataStream::Ok) {
+                agent.mixerPublicSockAddr = node.getPublicSocket();
+                agent.mixerLocalSockAddr = node.getLocalSocket();
+                agent.mixerAuth = std::make_unique<HMACAuth>();
+                agent.mixerAuth->setKey(connectionSecret);
+                connectToMixer(agent);
+            }
+        }
+        if (packetStream.status() != QDataStream::Ok) {
+            break;
+        }
+        if (entryIndex < agent.pendingDomainListEntries.size()) {
+            agent.pendingDomainListEntries[entryIndex] = true;
+        }
+    }
+
+    bool isComplete = std::all_of(agent.pendingDomainListEntries.begin(), agent.pendingDomainListEntries.end(),
+                                  [](bool received) { return received; });
+    if (isComplete && (baseDomainListVersion == 0 || domainListVersion > agent.domainListVersion)) {
+        agent.domainListVersion = domainListVersion;
+    }
+}
+
+void JoinStormApp::connectToMixer(Agent& agent) {
+    if (!agent.mixerAuth) {
+        return;
+    }
+
+    if (agent.mixerSockAddr.isNull()) {
+        // ping both of the mixer's sockets, like a client does, and talk to it on the one that answers
+        for (PingType_t pingType : { PingType::Public, PingType::Local }) {
+            auto pingPacket = NLPacket::create(PacketType::Ping, sizeof(PingType_t) + sizeof(quint64) + sizeof(ConnectionID));
+            pingPacket->writePrimitive(pingType);
+            pingPacket->writePrimitive(usecTimestampNow());
+            pingPacket->writePrimitive(INITIAL_CONNECTION_ID);
+            sendToMixer(agent, *pingPacket,
+                        pingType == PingType::Public ? agent.mixerPublicSockAddr : agent.mixerLocalSockAddr);
+        }
+    } else if (!agent.hasSelectedCodec) {
+        auto negotiateFormatPacket = NLPacket::create(PacketType::NegotiateAudioFormat);
+        negotiateFormatPacket->writePrimitive((quint8)1);
+        negotiateFormatPacket->writeString(agent.isNoiseSource ? NOISE_CODEC : _codec);
+        sendToMixer(agent, *negotiateFormatPacket, agent.mixerSockAddr);
+    }
+}
+
+void JoinStormApp::sendAudio() {
+    // keep to the frame rate of a client, catching up on the frames the timer was late for
+    quint64 now = usecTimestampNow();
+    if (_audioStartTime == 0) {
+        _audioStartTime = now;
+    }
+    quint64 numFramesDue = (now - _audioStartTime) / AudioConstants::NETWORK_FRAME_USECS + 1;
+    for (; _numAudioFramesSent < numFramesDue; ++_numAudioFramesSent) {
+        for (auto& agent : _agents) {
+            if (agent->hasSelectedCodec) {
+                sendAudioFrame(*agent);
+            }
+        }
+    }
+}
+
+void JoinStormApp::sendAudioFrame(Agent& agent) {
+    // the listeners are quiet, and send silent frames so the mixer has a stream to place them by
+    auto audioPacket = NLPacket::create(agent.isNoiseSource ? PacketType::MicrophoneAudioNoEcho : PacketType::SilentAudioFrame);
+    audioPacket->writePrimitive(agent.audioSequenceNumber++);
+    audioPacket->writeString(agent.codec);
+    if (agent.isNoiseSource) {
+        audioPacket->writePrimitive((quint8)0);
+    } else {
+        audioPacket->writePrimitive((quint16)AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    }
+
+    const glm::vec3 AVATAR_BOUNDING_BOX_SCALE(1.0f);
+    audioPacket->writePrimitive(agent.position);
+    audioPacket->writePrimitive(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    audioPacket->writePrimitive(agent.position - 0.5f * AVATAR_BOUNDING_BOX_SCALE);
+    audioPacket->writePrimitive(AVATAR_BOUNDING_BOX_SCALE);
+
+    if (agent.isNoiseSource) {
+        AudioConstants::AudioSample samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+        float peak = AudioConstants::MAX_SAMPLE_VALUE * powf(10.0f, _noiseLevel / 20.0f);
+        std::uniform_real_distribution<float> distribution(-peak, peak);
+        for (auto& sample : samples) {
+            sample = (AudioConstants::AudioSample)distribution(_noiseGenerator);
+        }
+        audioPacket->write(reinterpret_cast<const char*>(samples), sizeof(samples));
+    }
+
+    sendToMixer(agent, *audioPacket, agent.mixerSockAddr);
+}
+
+void JoinStormApp::sendToMixer(Agent& agent, const NLPacket& packet, const SockAddr& sockAddr) {
+    packet.writeSourceID(agent.localID);
+    if (!PacketTypeEnum::getNonVerifiedPackets().contains(packet.getType())) {
+        packet.writeVerificationHash(*agent.mixerAuth);
+    }
+    agent.socket->writePacket(packet, sockAddr);
+}
+
+double JoinStormApp::getMixerCPUSeconds() const {
+#ifdef Q_OS_LINUX
+    QFile statFile(QString("/proc/%1/stat").arg(_mixerPID));
+    if (_mixerPID == 0 || !statFile.open(QIODevice::ReadOnly)) {
+        return 0.0;
+    }
+
+    // utime and stime are the 14th and 15th fields; the ones after the command name start at the 3rd
+    QByteArray stat = statFile.readAll();
+    QList<QByteArray> fields = stat.mid(stat.lastIndexOf(')') + 2).split(' ');
+    const int UTIME_INDEX = 14 - 3;
+    const int STIME_INDEX = 15 - 3;
+    if (fields.size() <= STIME_INDEX) {
+        return 0.0;
+    }
+    return (double)(fields[UTIME_INDEX].toULongLong() + fields[STIME_INDEX].toULongLong()) / sysconf(_SC_CLK_TCK);
+#else
+    return 0.0;
+#endif
+}
+
+static quint64 percentile(const std::vector<quint64>& sortedValues, double fraction) {
+    if (sortedValues.empty()) {
+        return 0;
+    }
+    size_t index = std::min(sortedValues.size() - 1, (size_t)(fraction * sortedValues.size()));
+    return sortedValues[index];
+}
+
+static void reportLatencies(const QString& name, std::vector<quint64>& latencies) {
+    std::sort(latencies.begin(), latencies.end());
+    qDebug().noquote() << name << ":" << latencies.size() << "replies, ms p50" << percentile(latencies, 0.5) / USECS_PER_MSEC
+                       << "p90" << percentile(latencies, 0.9) / USECS_PER_MSEC
+                       << "p99" << percentile(latencies, 0.99) / USECS_PER_MSEC
+                       << "max" << (latencies.empty() ? 0 : latencies.back() / USECS_PER_MSEC);
+}
+
+void JoinStormApp::finish() {
+    _checkInTimer.stop();
+
+    int numConnected = (int)std::count_if(_agents.begin(), _agents.end(), [](const std::unique_ptr<Agent>& agent) {
+        return agent->connectedTime != 0;
+    });
+
+    qDebug() << numConnected << "of" << _agents.size() << "agents connected";
+    reportLatencies("Connect requests", _connectLatencies);
+    reportLatencies("List requests", _checkInLatencies);
+    qDebug() << _numTimedOutCheckIns << "list requests went unanswered for a second or more";
+    qDebug() << _numDomainListPackets << "domain list packets," << _numDomainListBytes << "bytes";
+
+    if (_listenToAudio) {
+        double seconds = (double)(usecTimestampNow() - _measureStartTime) / USECS_PER_SECOND;
+        int numListeners = 0;
+        quint64 numMixPackets = 0;
+        quint64 numSilentMixPackets = 0;
+        quint64 numMixBytes = 0;
+        for (auto& agent : _agents) {
+            if (!agent->isNoiseSource && agent->hasSelectedCodec) {
+                ++numListeners;
+                numMixPackets += agent->numMixPackets;
+                numSilentMixPackets += agent->numSilentMixPackets;
+                numMixBytes += agent->numMixBytes;
+            }
+        }
+
+        qDebug() << numListeners << "listeners got mixes from the audio mixer as" << _codec
+                 << (_hasNoiseSource ? QString("with noise at %1 dBFS").arg(_noiseLevel) : QString("in silence"));
+        if (numListeners > 0 && seconds > 0.0) {
+            double listenerSeconds = numListeners * seconds;
+            qDebug() << "Per listener:" << numMixPackets / listenerSeconds << "mix packets/s,"
+                     << numSilentMixPackets / listenerSeconds << "silent packets/s,"
+                     << BITS_IN_BYTE * numMixBytes / listenerSeconds / BYTES_PER_KILOBYTE << "kbps";
+            qDebug() << "Audio mixer egress to the listeners:" << BITS_IN_BYTE * numMixBytes / seconds / BYTES_PER_KILOBYTE
+                     << "kbps";
+        }
+        if (_mixerPID != 0 && seconds > 0.0) {
+            qDebug() << "Audio mixer CPU:" << 100.0 * (getMixerCPUSeconds() - _mixerCPUStartSeconds) / seconds
+                     << "% of a core";
+        }
+    }
+
+    _agents.clear();
+    QCoreApplication::exit(numConnected == _numAgents ? 0 : 1);
+}
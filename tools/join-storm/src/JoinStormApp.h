@@ -0,0 +1,122 @@
+//
+//  JoinStormApp.h
+//  tools/join-storm/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_JoinStormApp_h
+#define hifi_JoinStormApp_h
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QTimer>
+
+#include <glm/glm.hpp>
+
+#include <HMACAuth.h>
+#include <NLPacket.h>
+#include <SockAddr.h>
+#include <udt/Socket.h>
+
+// Connects a crowd of stand-in agents to a domain-server as fast as asked, keeps them checking in, and reports how
+// long the domain-server took to answer. Each agent has its own socket, so the domain-server sees them as separate
+// nodes. The agents don't log in, so the domain needs to let anonymous users connect.
+//
+// With -a, the agents also join the audio mixer as quiet listeners, and the tool reports what the mixer sends them and,
+// given the mixer's process ID, how much CPU the mixer used. With --noise, the first agent sends the mixer quiet noise
+// for the others to hear, as a stand-in for rain, wind or an ambient bed.
+class JoinStormApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    JoinStormApp(int argc, char* argv[]);
+
+private slots:
+    void joinNextAgent();
+    void checkIn();
+    void sendAudio();
+    void finish();
+
+private:
+    struct Agent {
+        std::unique_ptr<udt::Socket> socket;
+        SockAddr localSockAddr;
+
+        quint64 firstConnectTime { 0 };
+        quint64 connectedTime { 0 };
+        NLPacket::LocalID localID { NLPacket::NULL_LOCAL_ID };
+
+        // the node list version the agent has all of, and the entries received of the one it is receiving
+        quint32 domainListVersion { 0 };
+        quint32 pendingDomainListVersion { 0 };
+        quint32 pendingDomainListBaseVersion { 0 };
+        std::vector<bool> pendingDomainListEntries;
+
+        quint64 lastCheckInTime { 0 };
+        bool isAwaitingReply { false };
+
+        // the audio mixer, as listed by the domain-server, and the socket it answered on
+        SockAddr mixerPublicSockAddr;
+        SockAddr mixerLocalSockAddr;
+        SockAddr mixerSockAddr;
+        std::unique_ptr<HMACAuth> mixerAuth;
+        bool hasSelectedCodec { false };
+        QString codec;
+        quint16 audioSequenceNumber { 0 };
+        bool isNoiseSource { false };
+        glm::vec3 position;
+
+        quint64 numMixPackets { 0 };
+        quint64 numMixBytes { 0 };
+        quint64 numSilentMixPackets { 0 };
+    };
+
+    void sendCheckIn(Agent& agent);
+    void processPacket(Agent& agent, std::unique_ptr<udt::Packet> packet);
+    void processDomainList(Agent& agent, const NLPacket& packet);
+    void connectToMixer(Agent& agent);
+    void sendAudioFrame(Agent& agent);
+    void sendToMixer(Agent& agent, const NLPacket& packet, const SockAddr& sockAddr);
+    double getMixerCPUSeconds() const;
+
+    SockAddr _domainServerSockAddr;
+    int _numAgents { 200 };
+    double _joinsPerSecond { 50.0 };
+    int _checkInSeconds { 30 };
+    bool _verbose { false };
+
+    bool _listenToAudio { false };
+    QString _codec { "opus" };
+    bool _hasNoiseSource { false };
+    float _noiseLevel { -50.0f };
+    qint64 _mixerPID { 0 };
+
+    std::vector<std::unique_ptr<Agent>> _agents;
+    QTimer _joinTimer;
+    QTimer _checkInTimer;
+    QTimer _audioTimer;
+    quint64 _audioStartTime { 0 };
+    quint64 _numAudioFramesSent { 0 };
+    std::mt19937 _noiseGenerator;
+
+    // the mixer's sends are counted from when every agent has joined, along with its CPU use
+    bool _isMeasuring { false };
+    quint64 _measureStartTime { 0 };
+    double _mixerCPUStartSeconds { 0.0 };
+
+    // in usecs
+    std::vector<quint64> _connectLatencies;
+    std::vector<quint64> _checkInLatencies;
+    int _numTimedOutCheckIns { 0 };
+    quint64 _numDomainListPackets { 0 };
+    quint64 _numDomainListBytes { 0 };
+};
+
+#endif // hifi_JoinStormApp_h
@@ -0,0 +1,82 @@
+//
+//  RecordingConverterApp.cpp
+//  tools/recording-converter/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#include "RecordingConverterApp.h"
+
+#include <QCommandLineParser>
+#include <QDebug>
+
+#include <AvatarData.h>
+#include <recording/Clip.h>
+#include <recording/Frame.h>
+
+RecordingConverterApp::RecordingConverterApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Overte avatar recording converter");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input recording", "recording.hfr");
+    parser.addOption(inputFilenameOption);
+    const QCommandLineOption outputFilenameOption("o", "output recording", "recording.hfr");
+    parser.addOption(outputFilenameOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    if (!parser.isSet(inputFilenameOption) || !parser.isSet(outputFilenameOption)) {
+        qCritical() << "Both an input and an output recording are required";
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    QString inputFilename = parser.value(inputFilenameOption);
+    auto inputClip = recording::Clip::fromFile(inputFilename);
+    if (!inputClip) {
+        qCritical() << "Failed to read recording" << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+
+    // All avatar frames of a clip go through the same avatar, which keeps what they are deltas against
+    const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+    AvatarData avatar;
+    auto outputClip = recording::Clip::newClip();
+    size_t numConverted = 0;
+    qint64 inputSize = 0;
+    qint64 outputSize = 0;
+    inputClip->seek(0);
+    for (auto frame = inputClip->nextFrame(); frame; frame = inputClip->nextFrame()) {
+        if (frame->type == AVATAR_FRAME_TYPE) {
+            inputSize += frame->data.size();
+            auto converted = std::make_shared<recording::Frame>(*frame);
+            converted->data = AvatarData::toCompactFrame(frame->data, avatar);
+            outputSize += converted->data.size();
+            outputClip->addFrame(converted);
+            numConverted++;
+        } else {
+            outputClip->addFrame(frame);
+        }
+    }
+
+    QString outputFilename = parser.value(outputFilenameOption);
+    recording::Clip::toFile(outputFilename, outputClip);
+    qInfo() << "Converted" << numConverted << "avatar frames from" << inputSize << "to" << outputSize << "bytes";
+}
@@ -0,0 +1,29 @@
+//
+//  RecordingConverterApp.h
+//  tools/recording-converter/src
+//
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//  SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef hifi_RecordingConverterApp_h
+#define hifi_RecordingConverterApp_h
+
+#include <QCoreApplication>
+
+/// Rewrites the avatar frames of a recording recorded as JSON in the compact binary form, so that it plays back faster.
+class RecordingConverterApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    RecordingConverterApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif // hifi_RecordingConverterApp_h